@@ -0,0 +1,286 @@
+#include "core/benchmark.h"
+
+#include <algorithm>
+#include <random>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+
+#include "common/qt/convert_string.h"
+
+#define BENCHMARK_FORMAT_VERSION 1
+#define BENCHMARK_REMOVE_BATCH 1000
+
+namespace fastonosql
+{
+    namespace
+    {
+        QJsonObject latencyToJson(const BenchmarkLatency& lat)
+        {
+            QJsonObject obj;
+            obj["count"] = static_cast<double>(lat.count_);
+            obj["mean_usec"] = lat.mean_;
+            obj["p50_usec"] = lat.p50_;
+            obj["p99_usec"] = lat.p99_;
+            obj["p99.9_usec"] = lat.p999_;
+            obj["max_usec"] = lat.max_;
+            return obj;
+        }
+
+        BenchmarkLatency latencyFromJson(const QJsonObject& obj)
+        {
+            BenchmarkLatency lat;
+            lat.count_ = static_cast<uint64_t>(obj["count"].toDouble());
+            lat.mean_ = obj["mean_usec"].toDouble();
+            lat.p50_ = obj["p50_usec"].toDouble();
+            lat.p99_ = obj["p99_usec"].toDouble();
+            lat.p999_ = obj["p99.9_usec"].toDouble();
+            lat.max_ = obj["max_usec"].toDouble();
+            return lat;
+        }
+
+        // state shared by the client threads
+        struct BenchmarkRun
+        {
+            BenchmarkRun(const BenchmarkConfig& config, const QAtomicInt* interrupt)
+                : config_(config), interrupt_(interrupt), value_(), lock_(), reads_(), writes_(), errors_(0), error_()
+            {
+                std::mt19937 gen(0);
+                std::uniform_int_distribution<int> letter('a', 'z');
+                value_.resize(config_.valueMaxSize_);
+                for(size_t i = 0; i < value_.size(); ++i){
+                    value_[i] = static_cast<char>(letter(gen));
+                }
+            }
+
+            const BenchmarkConfig config_;
+            const QAtomicInt* const interrupt_;
+            std::string value_;
+
+            QMutex lock_;
+            LatencyHistogram reads_;
+            LatencyHistogram writes_;
+            uint64_t errors_;
+            common::Error error_;
+        };
+
+        class BenchmarkTask
+                : public QRunnable
+        {
+        public:
+            BenchmarkTask(BenchmarkClient* client, uint32_t requests, uint32_t seed, BenchmarkRun* run, QSemaphore* done)
+                : client_(client), requests_(requests), seed_(seed), run_(run), done_(done)
+            {
+                setAutoDelete(true);
+            }
+
+            // every request of a batch waits for the whole batch, as in redis-benchmark -P
+            virtual void run()
+            {
+                const BenchmarkConfig& config = run_->config_;
+                std::mt19937 gen(seed_);
+                std::uniform_int_distribution<uint32_t> key(0, config.keySpace_ ? config.keySpace_ - 1 : 0);
+                std::uniform_int_distribution<uint32_t> size(config.valueMinSize_, config.valueMaxSize_);
+                std::uniform_int_distribution<uint32_t> percent(0, 99);
+
+                LatencyHistogram reads, writes;
+                std::vector<BenchmarkRequest> batch;
+                common::Error er;
+                uint32_t left = requests_;
+                while(left && !er && !run_->interrupt_->loadAcquire()){
+                    const uint32_t count = std::min(left, std::max(config.pipeline_, 1U));
+                    batch.resize(count);
+                    for(uint32_t i = 0; i < count; ++i){
+                        BenchmarkRequest& req = batch[i];
+                        req.write_ = percent(gen) >= config.readPercent_;
+                        req.key_ = BENCHMARK_KEY_PREFIX + common::convertToString(key(gen));
+                        req.valueSize_ = req.write_ ? size(gen) : 0;
+                    }
+
+                    const uint64_t start = monotonicNsec();
+                    er = client_->execute(batch, run_->value_);
+                    const uint64_t elapsed = monotonicNsec() - start;
+                    if(!er){
+                        for(uint32_t i = 0; i < count; ++i){
+                            (batch[i].write_ ? writes : reads).record(elapsed);
+                        }
+                    }
+                    left -= count;
+                }
+
+                {
+                    QMutexLocker lock(&run_->lock_);
+                    run_->reads_.add(reads);
+                    run_->writes_.add(writes);
+                    if(er){
+                        run_->errors_ += left + batch.size();
+                        if(!run_->error_){
+                            run_->error_ = er;
+                        }
+                    }
+                }
+                done_->release();
+            }
+
+        private:
+            BenchmarkClient* const client_;
+            const uint32_t requests_;
+            const uint32_t seed_;
+            BenchmarkRun* const run_;
+            QSemaphore* const done_;
+        };
+    }
+
+    BenchmarkConfig::BenchmarkConfig()
+        : clients_(4), requests_(100000), pipeline_(1), keySpace_(10000), valueMinSize_(3), valueMaxSize_(3), readPercent_(50), removeKeys_(true)
+    {
+
+    }
+
+    BenchmarkRequest::BenchmarkRequest()
+        : write_(false), key_(), valueSize_(0)
+    {
+
+    }
+
+    BenchmarkClient::~BenchmarkClient()
+    {
+
+    }
+
+    BenchmarkLatency::BenchmarkLatency()
+        : count_(0), mean_(0), p50_(0), p99_(0), p999_(0), max_(0)
+    {
+
+    }
+
+    BenchmarkLatency::BenchmarkLatency(const LatencyHistogram& hist)
+        : count_(hist.count()), mean_(hist.mean() / 1000.0), p50_(hist.valueAtPercentile(50) / 1000.0),
+          p99_(hist.valueAtPercentile(99) / 1000.0), p999_(hist.valueAtPercentile(99.9) / 1000.0), max_(hist.max() / 1000.0)
+    {
+
+    }
+
+    BenchmarkResult::BenchmarkResult()
+        : server_(), type_(REDIS), start_(0), elapsed_(0), config_(), errors_(0), reads_(), writes_()
+    {
+
+    }
+
+    double BenchmarkResult::throughput() const
+    {
+        return elapsed_ ? (reads_.count_ + writes_.count_) * 1000.0 / elapsed_ : 0;
+    }
+
+    std::string BenchmarkResult::toJson() const
+    {
+        QJsonObject conf;
+        conf["clients"] = static_cast<int>(config_.clients_);
+        conf["requests"] = static_cast<double>(config_.requests_);
+        conf["pipeline"] = static_cast<int>(config_.pipeline_);
+        conf["key_space"] = static_cast<double>(config_.keySpace_);
+        conf["value_min_size"] = static_cast<double>(config_.valueMinSize_);
+        conf["value_max_size"] = static_cast<double>(config_.valueMaxSize_);
+        conf["read_percent"] = static_cast<int>(config_.readPercent_);
+        conf["remove_keys"] = config_.removeKeys_;
+
+        QJsonObject obj;
+        obj["version"] = BENCHMARK_FORMAT_VERSION;
+        obj["server"] = common::convertFromString<QString>(server_);
+        obj["type"] = common::convertFromString<QString>(common::convertToString(type_));
+        obj["start_msec"] = static_cast<double>(start_);
+        obj["elapsed_msec"] = static_cast<double>(elapsed_);
+        obj["errors"] = static_cast<double>(errors_);
+        obj["throughput"] = throughput();
+        obj["config"] = conf;
+        obj["reads"] = latencyToJson(reads_);
+        obj["writes"] = latencyToJson(writes_);
+
+        QByteArray json = QJsonDocument(obj).toJson();
+        return std::string(json.constData(), json.size());
+    }
+
+    bool BenchmarkResult::fromJson(const std::string& json, BenchmarkResult* result)
+    {
+        QJsonDocument doc = QJsonDocument::fromJson(QByteArray(json.data(), json.size()));
+        if(!doc.isObject()){
+            return false;
+        }
+
+        QJsonObject obj = doc.object();
+        if(obj["version"].toInt() != BENCHMARK_FORMAT_VERSION){
+            return false;
+        }
+
+        QJsonObject conf = obj["config"].toObject();
+        result->config_.clients_ = conf["clients"].toInt();
+        result->config_.requests_ = static_cast<uint32_t>(conf["requests"].toDouble());
+        result->config_.pipeline_ = conf["pipeline"].toInt();
+        result->config_.keySpace_ = static_cast<uint32_t>(conf["key_space"].toDouble());
+        result->config_.valueMinSize_ = static_cast<uint32_t>(conf["value_min_size"].toDouble());
+        result->config_.valueMaxSize_ = static_cast<uint32_t>(conf["value_max_size"].toDouble());
+        result->config_.readPercent_ = conf["read_percent"].toInt();
+        result->config_.removeKeys_ = conf["remove_keys"].toBool(true);
+
+        result->server_ = common::convertToString(obj["server"].toString());
+        result->type_ = common::convertFromString<connectionTypes>(common::convertToString(obj["type"].toString()));
+        result->start_ = static_cast<common::time64_t>(obj["start_msec"].toDouble());
+        result->elapsed_ = static_cast<common::time64_t>(obj["elapsed_msec"].toDouble());
+        result->errors_ = static_cast<uint64_t>(obj["errors"].toDouble());
+        result->reads_ = latencyFromJson(obj["reads"].toObject());
+        result->writes_ = latencyFromJson(obj["writes"].toObject());
+        return true;
+    }
+
+    common::Error runBenchmark(const std::vector<BenchmarkClient*>& clients, const BenchmarkConfig& config,
+                               const QAtomicInt* interrupt, BenchmarkResult* result)
+    {
+        if(clients.empty() || config.valueMinSize_ > config.valueMaxSize_ || config.readPercent_ > 100){
+            return common::make_error_value("Invalid benchmark config", common::ErrorValue::E_ERROR);
+        }
+
+        BenchmarkRun run(config, interrupt);
+        QThreadPool pool;
+        pool.setMaxThreadCount(clients.size());
+        QSemaphore done;
+
+        result->config_ = config;
+        result->start_ = common::time::current_mstime();
+        const uint64_t start = monotonicNsec();
+        const uint32_t share = config.requests_ / clients.size();
+        for(size_t i = 0; i < clients.size(); ++i){
+            uint32_t requests = share + (i < config.requests_ % clients.size() ? 1 : 0);
+            pool.start(new BenchmarkTask(clients[i], requests, static_cast<uint32_t>(i + 1), &run, &done));
+        }
+        done.acquire(clients.size());
+
+        result->elapsed_ = (monotonicNsec() - start) / 1000000;
+        result->errors_ = run.errors_;
+        result->reads_ = BenchmarkLatency(run.reads_);
+        result->writes_ = BenchmarkLatency(run.writes_);
+        return run.error_;
+    }
+
+    common::Error removeBenchmarkKeys(BenchmarkClient* client, const BenchmarkConfig& config)
+    {
+        std::vector<std::string> keys;
+        keys.reserve(std::min<uint32_t>(config.keySpace_, BENCHMARK_REMOVE_BATCH));
+        for(uint32_t i = 0; i < config.keySpace_; ++i){
+            keys.push_back(BENCHMARK_KEY_PREFIX + common::convertToString(i));
+            if(keys.size() == BENCHMARK_REMOVE_BATCH || i + 1 == config.keySpace_){
+                common::Error er = client->remove(keys);
+                if(er){
+                    return er;
+                }
+                keys.clear();
+            }
+        }
+
+        return common::Error();
+    }
+}
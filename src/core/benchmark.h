@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <QAtomicInt>
+
+#include "common/time.h"
+
+#include "core/types.h"
+#include "core/latency_histogram.h"
+
+#define BENCHMARK_KEY_PREFIX "fastonosql:benchmark:"
+
+namespace fastonosql
+{
+    struct BenchmarkConfig
+    {
+        BenchmarkConfig();
+
+        uint32_t clients_;      // threads, each with a client of its own
+        uint32_t requests_;     // in all, shared by the clients
+        uint32_t pipeline_;     // requests sent before the first reply is read
+        uint32_t keySpace_;     // keys are BENCHMARK_KEY_PREFIX and a random number below it
+        uint32_t valueMinSize_; // written values are random in size within the range
+        uint32_t valueMaxSize_;
+        uint32_t readPercent_;  // the rest are writes
+        bool removeKeys_;       // every key of the key space is removed after the run
+    };
+
+    struct BenchmarkRequest
+    {
+        BenchmarkRequest();
+
+        bool write_;
+        std::string key_;
+        size_t valueSize_;
+    };
+
+    // Requests of one benchmark thread, made on a connection of its own for the
+    // servers and on the opened database for the embedded engines. A batch is
+    // pipelined where the protocol allows it.
+    class BenchmarkClient
+    {
+    public:
+        virtual ~BenchmarkClient();
+
+        // writes store the first valueSize_ bytes of value
+        virtual common::Error execute(const std::vector<BenchmarkRequest>& batch, const std::string& value) WARN_UNUSED_RESULT = 0;
+        // missing keys aren't an error
+        virtual common::Error remove(const std::vector<std::string>& keys) WARN_UNUSED_RESULT = 0;
+    };
+
+    // percentiles in usec
+    struct BenchmarkLatency
+    {
+        BenchmarkLatency();
+        explicit BenchmarkLatency(const LatencyHistogram& hist);
+
+        uint64_t count_;
+        double mean_;
+        double p50_;
+        double p99_;
+        double p999_;
+        double max_;
+    };
+
+    struct BenchmarkResult
+    {
+        BenchmarkResult();
+
+        double throughput() const; // requests per second
+
+        std::string toJson() const;
+        static bool fromJson(const std::string& json, BenchmarkResult* result);
+
+        std::string server_;
+        connectionTypes type_;
+        common::time64_t start_; // msec since epoch
+        common::time64_t elapsed_; // msec
+        BenchmarkConfig config_;
+        uint64_t errors_;
+        BenchmarkLatency reads_;
+        BenchmarkLatency writes_;
+    };
+
+    // runs the clients on threads of their own until the requests are done or
+    // interrupt is set, the first error of a client stops that client
+    common::Error runBenchmark(const std::vector<BenchmarkClient*>& clients, const BenchmarkConfig& config,
+                               const QAtomicInt* interrupt, BenchmarkResult* result) WARN_UNUSED_RESULT;
+
+    // removes the keys a run with config may have written, in batches
+    common::Error removeBenchmarkKeys(BenchmarkClient* client, const BenchmarkConfig& config) WARN_UNUSED_RESULT;
+}
@@ -0,0 +1,254 @@
+#include "core/client_list.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+
+#define CLIENT_ID_LABEL "id"
+#define CLIENT_ADDR_LABEL "addr"
+#define CLIENT_NAME_LABEL "name"
+#define CLIENT_AGE_LABEL "age"
+#define CLIENT_IDLE_LABEL "idle"
+#define CLIENT_FLAGS_LABEL "flags"
+#define CLIENT_DB_LABEL "db"
+#define CLIENT_QBUF_LABEL "qbuf"
+#define CLIENT_OBL_LABEL "obl"
+#define CLIENT_OLL_LABEL "oll"
+#define CLIENT_OMEM_LABEL "omem"
+#define CLIENT_CMD_LABEL "cmd"
+
+// buffers below it are never outliers, however they compare with the rest
+#define CLIENT_OUTLIER_MIN_BYTES (1024 * 1024)
+#define CLIENT_OUTLIER_FACTOR 10
+
+namespace
+{
+    // upper bounds of the idle buckets but the last
+    const uint64_t idleLimits[fastonosql::ClientListStats::IDLE_BUCKETS_COUNT - 1] = { 1, 10, 60, 600, 3600 };
+
+    // CLIENT_OUTLIER_FACTOR times the 90th percentile, at least CLIENT_OUTLIER_MIN_BYTES
+    uint64_t outlierLimit(std::vector<uint64_t>* values)
+    {
+        if(values->empty()){
+            return CLIENT_OUTLIER_MIN_BYTES;
+        }
+
+        const size_t index = (values->size() - 1) * 9 / 10;
+        std::nth_element(values->begin(), values->begin() + index, values->end());
+        return std::max<uint64_t>((*values)[index] * CLIENT_OUTLIER_FACTOR, CLIENT_OUTLIER_MIN_BYTES);
+    }
+
+    bool moreClients(const fastonosql::ClientGroup& lhs, const fastonosql::ClientGroup& rhs)
+    {
+        return lhs.count_ > rhs.count_;
+    }
+}
+
+namespace fastonosql
+{
+    ClientField::ClientField()
+        : pos_(0), size_(0)
+    {
+
+    }
+
+    ClientInfo::ClientInfo()
+        : id_(0), addr_(), name_(), cmd_(), flags_(), db_(0), age_(0), idle_(0), qbuf_(0), obl_(0), oll_(0), omem_(0)
+    {
+
+    }
+
+    ClientList::ClientList()
+        : text_(), clients_()
+    {
+
+    }
+
+    ClientList::ClientList(const std::string& text)
+        : text_(text), clients_()
+    {
+        clients_.reserve(std::count(text_.begin(), text_.end(), '\n') + 1);
+        InfoLineReader reader(text_.data(), text_.size());
+        InfoSlice line;
+        while(reader.next(&line)){
+            if(line.size_){
+                parseLine(line);
+            }
+        }
+    }
+
+    // "id=3 addr=127.0.0.1:52555 fd=8 name= age=855 idle=0 flags=N db=0 ... cmd=client"
+    void ClientList::parseLine(const InfoSlice& line)
+    {
+        ClientInfo client;
+        const char* pos = line.data_;
+        const char* end = line.data_ + line.size_;
+        while(pos < end){
+            const char* space = static_cast<const char*>(memchr(pos, ' ', end - pos));
+            const char* stop = space ? space : end;
+            const char* eq = static_cast<const char*>(memchr(pos, '=', stop - pos));
+            if(eq){
+                const InfoSlice key(pos, eq - pos);
+                const InfoSlice value(eq + 1, stop - eq - 1);
+                ClientField field;
+                field.pos_ = static_cast<uint32_t>(value.data_ - text_.data());
+                field.size_ = static_cast<uint32_t>(value.size_);
+
+                switch(infoFieldHash(key)){
+                INFO_FIELD_CASE(key, CLIENT_ID_LABEL)
+                    client.id_ = infoToUInt64(value);
+                    break;
+                INFO_FIELD_CASE(key, CLIENT_ADDR_LABEL)
+                    client.addr_ = field;
+                    break;
+                INFO_FIELD_CASE(key, CLIENT_NAME_LABEL)
+                    client.name_ = field;
+                    break;
+                INFO_FIELD_CASE(key, CLIENT_AGE_LABEL)
+                    client.age_ = infoToUInt64(value);
+                    break;
+                INFO_FIELD_CASE(key, CLIENT_IDLE_LABEL)
+                    client.idle_ = infoToUInt64(value);
+                    break;
+                INFO_FIELD_CASE(key, CLIENT_FLAGS_LABEL)
+                    client.flags_ = field;
+                    break;
+                INFO_FIELD_CASE(key, CLIENT_DB_LABEL)
+                    client.db_ = infoToInt(value);
+                    break;
+                INFO_FIELD_CASE(key, CLIENT_QBUF_LABEL)
+                    client.qbuf_ = infoToUInt64(value);
+                    break;
+                INFO_FIELD_CASE(key, CLIENT_OBL_LABEL)
+                    client.obl_ = infoToUInt64(value);
+                    break;
+                INFO_FIELD_CASE(key, CLIENT_OLL_LABEL)
+                    client.oll_ = infoToUInt64(value);
+                    break;
+                INFO_FIELD_CASE(key, CLIENT_OMEM_LABEL)
+                    client.omem_ = infoToUInt64(value);
+                    break;
+                INFO_FIELD_CASE(key, CLIENT_CMD_LABEL)
+                    client.cmd_ = field;
+                    break;
+                default:
+                    break;
+                }
+            }
+            pos = stop + 1;
+        }
+        clients_.push_back(client);
+    }
+
+    const std::vector<ClientInfo>& ClientList::clients() const
+    {
+        return clients_;
+    }
+
+    InfoSlice ClientList::field(const ClientField& field) const
+    {
+        return InfoSlice(text_.data() + field.pos_, field.size_);
+    }
+
+    std::string ClientList::fieldString(const ClientField& field) const
+    {
+        return std::string(text_.data() + field.pos_, field.size_);
+    }
+
+    InfoSlice ClientList::host(const ClientInfo& client) const
+    {
+        InfoSlice addr = field(client.addr_);
+        for(size_t i = addr.size_; i > 0; --i){
+            if(addr.data_[i - 1] == ':'){
+                return InfoSlice(addr.data_, i - 1);
+            }
+        }
+        return addr;
+    }
+
+    ClientGroup::ClientGroup()
+        : key_(), count_(0), qbuf_(0), omem_(0), maxIdle_(0), outliers_(0)
+    {
+
+    }
+
+    ClientListStats::ClientListStats(const ClientList& list)
+        : list_(list), qbufLimit_(0), omemLimit_(0)
+    {
+        memset(idle_, 0, sizeof(idle_));
+
+        const std::vector<ClientInfo>& clients = list_.clients();
+        std::vector<uint64_t> qbufs, omems;
+        qbufs.reserve(clients.size());
+        omems.reserve(clients.size());
+        for(size_t i = 0; i < clients.size(); ++i){
+            const ClientInfo& client = clients[i];
+            qbufs.push_back(client.qbuf_);
+            omems.push_back(client.omem_);
+            idle_[std::upper_bound(idleLimits, idleLimits + ClientListStats::IDLE_BUCKETS_COUNT - 1, client.idle_) - idleLimits]++;
+        }
+
+        qbufLimit_ = outlierLimit(&qbufs);
+        omemLimit_ = outlierLimit(&omems);
+    }
+
+    std::vector<ClientGroup> ClientListStats::groups(ClientGroupBy by) const
+    {
+        typedef std::map<std::string, ClientGroup> groups_t;
+        groups_t groups;
+        const std::vector<ClientInfo>& clients = list_.clients();
+        for(size_t i = 0; i < clients.size(); ++i){
+            const ClientInfo& client = clients[i];
+            InfoSlice key;
+            if(by == CLIENTS_BY_HOST){
+                key = list_.host(client);
+            }
+            else if(by == CLIENTS_BY_NAME){
+                key = list_.field(client.name_);
+            }
+            else{
+                key = list_.field(client.cmd_);
+            }
+
+            ClientGroup& group = groups[std::string(key.data_, key.size_)];
+            group.count_++;
+            group.qbuf_ += client.qbuf_;
+            group.omem_ += client.omem_;
+            group.maxIdle_ = std::max(group.maxIdle_, client.idle_);
+            if(isOutlier(client)){
+                group.outliers_++;
+            }
+        }
+
+        std::vector<ClientGroup> result;
+        result.reserve(groups.size());
+        for(groups_t::iterator it = groups.begin(); it != groups.end(); ++it){
+            it->second.key_ = it->first;
+            result.push_back(it->second);
+        }
+
+        std::sort(result.begin(), result.end(), &moreClients);
+        return result;
+    }
+
+    const size_t* ClientListStats::idleBuckets() const
+    {
+        return idle_;
+    }
+
+    bool ClientListStats::isOutlier(const ClientInfo& client) const
+    {
+        return client.qbuf_ > qbufLimit_ || client.omem_ > omemLimit_;
+    }
+
+    uint64_t ClientListStats::qbufLimit() const
+    {
+        return qbufLimit_;
+    }
+
+    uint64_t ClientListStats::omemLimit() const
+    {
+        return omemLimit_;
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/info_parser.h"
+
+namespace fastonosql
+{
+    // bytes of a client list line, as an offset into the list's text
+    struct ClientField
+    {
+        ClientField();
+
+        uint32_t pos_;
+        uint32_t size_;
+    };
+
+    // one line of CLIENT LIST
+    struct ClientInfo
+    {
+        ClientInfo();
+
+        uint64_t id_;
+        ClientField addr_;
+        ClientField name_;
+        ClientField cmd_;
+        ClientField flags_;
+        int db_;
+        uint64_t age_; // sec
+        uint64_t idle_; // sec
+        uint64_t qbuf_; // bytes
+        uint64_t obl_;
+        uint64_t oll_;
+        uint64_t omem_; // bytes
+    };
+
+    // CLIENT LIST parsed in place: the text is kept whole and the clients
+    // point into it by offset, so a poll costs the text and one vector
+    // whatever the number of clients, and a copy stays valid.
+    class ClientList
+    {
+    public:
+        ClientList();
+        explicit ClientList(const std::string& text);
+
+        const std::vector<ClientInfo>& clients() const;
+        InfoSlice field(const ClientField& field) const;
+        std::string fieldString(const ClientField& field) const;
+        // addr without its port
+        InfoSlice host(const ClientInfo& client) const;
+
+    private:
+        void parseLine(const InfoSlice& line);
+
+        std::string text_;
+        std::vector<ClientInfo> clients_;
+    };
+
+    struct ClientGroup
+    {
+        ClientGroup();
+
+        std::string key_;
+        size_t count_;
+        uint64_t qbuf_;
+        uint64_t omem_;
+        uint64_t maxIdle_;
+        size_t outliers_;
+    };
+
+    enum ClientGroupBy
+    {
+        CLIENTS_BY_HOST = 0,
+        CLIENTS_BY_NAME,
+        CLIENTS_BY_COMMAND
+    };
+
+    // Aggregates of one client list: groups, idle times and the clients
+    // whose query or output buffers stand out from the rest.
+    class ClientListStats
+    {
+    public:
+        enum
+        {
+            IDLE_BUCKETS_COUNT = 6
+        };
+
+        explicit ClientListStats(const ClientList& list);
+
+        std::vector<ClientGroup> groups(ClientGroupBy by) const; // the most clients first
+        // clients idle below 1 sec, 10 sec, 1 min, 10 min, 1 hour and longer
+        const size_t* idleBuckets() const;
+        bool isOutlier(const ClientInfo& client) const;
+        uint64_t qbufLimit() const;
+        uint64_t omemLimit() const;
+
+    private:
+        const ClientList& list_;
+        size_t idle_[IDLE_BUCKETS_COUNT];
+        uint64_t qbufLimit_;
+        uint64_t omemLimit_;
+    };
+}
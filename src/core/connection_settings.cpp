@@ -40,6 +40,7 @@
 #define LOGGING_ROCKSDB_FILE_EXTENSION ".rocksdb"
 #define LOGGING_UNQLITE_FILE_EXTENSION ".unq"
 #define LOGGING_LMDB_FILE_EXTENSION ".lmdb"
+#define HISTORY_DIRECTORY_SUFFIX ".history"
 
 namespace
 {
@@ -149,6 +150,11 @@ namespace fastonosql
         return logDir + hash() + ext;
     }
 
+    std::string IConnectionSettingsBase::historyPath() const
+    {
+        return loggingPath() + HISTORY_DIRECTORY_SUFFIX;
+    }
+
     IConnectionSettingsBase* IConnectionSettingsBase::createFromType(connectionTypes type, const std::string& conName)
     {
 #ifdef BUILD_WITH_REDIS
@@ -339,6 +345,7 @@ namespace fastonosql
                                "<b>--latency</b>          Enter a special mode continuously sampling latency.<br/>"
                                "<b>--latency-history</b>  Like <b>--latency</b> but tracking latency changes over time.<br/>"
                                "                   Default time interval is 15 sec. Change it using <b>-i</b>.<br/>"
+                               "<b>--latency-connections &lt;n&gt;</b> Probe latency over &lt;n&gt; connections at once.<br/>"
                                "<b>--slave</b>            Simulate a slave showing commands received from the master.<br/>"
                                "<b>--rdb &lt;filename&gt;</b>   Transfer an RDB dump from remote server to local file.<br/>"
                                /*"<b>--pipe</b>             Transfer raw Redis protocol from stdin to server.<br/>"
@@ -42,6 +42,8 @@ namespace fastonosql
         std::string hash() const;
 
         std::string loggingPath() const;
+        // directory of the binary info history, loggingPath() is the old text one
+        std::string historyPath() const;
 
         void setConnectionNameAndUpdateHash(const std::string& name);
 
@@ -71,6 +71,9 @@ namespace fastonosql
         /* Scan mode */
         ScanMode,
 
+        /* Intrinsic latency and latency breakdown */
+        IntrinsicLatencyMode,
+
         /* Interactive mode */
         InteractiveMode
     };
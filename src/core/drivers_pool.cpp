@@ -0,0 +1,168 @@
+#include "core/drivers_pool.h"
+
+#include <algorithm>
+
+#include <QEvent>
+#include <QThread>
+#include <QTimer>
+
+#include "common/macros.h"
+
+#include "core/idriver.h"
+
+#define DRIVER_STRAND_BATCH 8
+#define DRIVERS_POOL_MIN_THREADS 2
+
+namespace fastonosql
+{
+    DriverStrand::DriverStrand(IDriver* driver, QThreadPool* pool)
+        : driver_(driver), pool_(pool), lock_(), idle_(), events_(), scheduled_(false), closed_(false)
+    {
+        setAutoDelete(false);
+    }
+
+    DriverStrand::~DriverStrand()
+    {
+        close();
+    }
+
+    void DriverStrand::post(QEvent* ev)
+    {
+        QMutexLocker lock(&lock_);
+        if(closed_){
+            delete ev;
+            return;
+        }
+
+        events_.push_back(ev);
+        if(!scheduled_){
+            scheduled_ = true;
+            pool_->start(this);
+        }
+    }
+
+    void DriverStrand::close()
+    {
+        QMutexLocker lock(&lock_);
+        closed_ = true;
+        for(size_t i = 0; i < events_.size(); ++i){
+            delete events_[i];
+        }
+        events_.clear();
+
+        while(scheduled_){
+            idle_.wait(&lock_);
+        }
+    }
+
+    void DriverStrand::run()
+    {
+        for(int i = 0; i < DRIVER_STRAND_BATCH; ++i){
+            QEvent* ev = NULL;
+            {
+                QMutexLocker lock(&lock_);
+                if(finishRun()){
+                    return;
+                }
+
+                ev = events_.front();
+                events_.pop_front();
+            }
+
+            driver_->customEvent(ev);
+            delete ev;
+        }
+
+        // the rest of the queue waits behind the other strands
+        QMutexLocker lock(&lock_);
+        if(!finishRun()){
+            pool_->start(this);
+        }
+    }
+
+    bool DriverStrand::finishRun()
+    {
+        if(!events_.empty() && !closed_){
+            return false;
+        }
+
+        scheduled_ = false;
+        idle_.wakeAll();
+        return true;
+    }
+
+    DriversPool::BlockingScope::BlockingScope()
+    {
+        DriversPool::instance().pool_.releaseThread();
+    }
+
+    DriversPool::BlockingScope::~BlockingScope()
+    {
+        DriversPool::instance().pool_.reserveThread();
+    }
+
+    DriversPool::DriversPool()
+        : pool_(), timer_(NULL), polls_()
+    {
+        pool_.setMaxThreadCount(std::max(DRIVERS_POOL_MIN_THREADS, QThread::idealThreadCount()));
+
+        timer_ = new QTimer(this);
+        timer_->setSingleShot(true);
+        VERIFY(connect(timer_, &QTimer::timeout, this, &DriversPool::poll));
+    }
+
+    DriversPool::~DriversPool()
+    {
+        pool_.waitForDone();
+    }
+
+    DriverStrand* DriversPool::createStrand(IDriver* driver)
+    {
+        return new DriverStrand(driver, &pool_);
+    }
+
+    void DriversPool::addPolling(IDriver* driver, int msec)
+    {
+        PollInfo inf;
+        inf.interval_ = std::max(msec, 1);
+        inf.due_ = common::time::current_mstime() + inf.interval_;
+        polls_[driver] = inf;
+        scheduleNextPoll();
+    }
+
+    void DriversPool::removePolling(IDriver* driver)
+    {
+        polls_.erase(driver);
+        scheduleNextPoll();
+    }
+
+    void DriversPool::poll()
+    {
+        const common::time64_t now = common::time::current_mstime();
+        for(std::map<IDriver*, PollInfo>::iterator it = polls_.begin(); it != polls_.end(); ++it){
+            PollInfo& inf = it->second;
+            if(inf.due_ <= now){
+                it->first->schedulePoll();
+                inf.due_ = now + inf.interval_;
+            }
+        }
+
+        scheduleNextPoll();
+    }
+
+    void DriversPool::scheduleNextPoll()
+    {
+        if(polls_.empty()){
+            timer_->stop();
+            return;
+        }
+
+        common::time64_t next = polls_.begin()->second.due_;
+        for(std::map<IDriver*, PollInfo>::const_iterator it = polls_.begin(); it != polls_.end(); ++it){
+            next = std::min(next, it->second.due_);
+        }
+
+        const common::time64_t now = common::time::current_mstime();
+        timer_->start(next > now ? static_cast<int>(next - now) : 0);
+    }
+}
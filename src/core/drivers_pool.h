@@ -0,0 +1,94 @@
+#pragma once
+
+#include <deque>
+#include <map>
+
+#include <QObject>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include "common/patterns/singleton_pattern.h"
+#include "common/time.h"
+
+class QEvent;
+class QTimer;
+
+namespace fastonosql
+{
+    class IDriver;
+
+    // Events of one driver, handled one at a time and in order
+    // by whichever thread of the pool is free.
+    class DriverStrand
+            : public QRunnable
+    {
+    public:
+        DriverStrand(IDriver* driver, QThreadPool* pool);
+        virtual ~DriverStrand();
+
+        void post(QEvent* ev);
+        // drops the pending events and waits for the running one
+        void close();
+
+        virtual void run();
+
+    private:
+        bool finishRun();
+
+        IDriver* const driver_;
+        QThreadPool* const pool_;
+        QMutex lock_;
+        QWaitCondition idle_;
+        std::deque<QEvent*> events_;
+        bool scheduled_;
+        bool closed_;
+    };
+
+    // Fixed size executor shared by all drivers, idle connections hold
+    // no thread. Info polling of every driver is driven by one timer.
+    class DriversPool
+            : public QObject, public common::patterns::LazySingleton<DriversPool>
+    {
+        friend class common::patterns::LazySingleton<DriversPool>;
+        Q_OBJECT
+
+    public:
+        // a handler which may wait for long (monitor, subscribe, value search)
+        // lends its thread slot to the other strands while it runs
+        class BlockingScope
+        {
+        public:
+            BlockingScope();
+            ~BlockingScope();
+
+        private:
+            DISALLOW_COPY_AND_ASSIGN(BlockingScope);
+        };
+
+        DriverStrand* createStrand(IDriver* driver);
+
+        void addPolling(IDriver* driver, int msec);
+        void removePolling(IDriver* driver);
+
+    private Q_SLOTS:
+        void poll();
+
+    private:
+        DriversPool();
+        ~DriversPool();
+
+        void scheduleNextPoll();
+
+        struct PollInfo
+        {
+            int interval_;
+            common::time64_t due_;
+        };
+
+        QThreadPool pool_;
+        QTimer* timer_;
+        std::map<IDriver*, PollInfo> polls_;
+    };
+}
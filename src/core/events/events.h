@@ -68,6 +68,27 @@ namespace fastonosql
         typedef common::utils_qt::Event<EventsInfo::ChangeMaxConnectionRequest, QEvent::User + 41> ChangeMaxConnectionRequestEvent;
         typedef common::utils_qt::Event<EventsInfo::ChangeMaxConnectionResponce, QEvent::User + 42> ChangeMaxConnectionResponceEvent;
 
+        typedef common::utils_qt::Event<EventsInfo::BenchmarkInfoRequest, QEvent::User + 43> BenchmarkRequestEvent;
+        typedef common::utils_qt::Event<EventsInfo::BenchmarkInfoResponce, QEvent::User + 44> BenchmarkResponceEvent;
+
+        typedef common::utils_qt::Event<EventsInfo::MonitorRequest, QEvent::User + 45> MonitorRequestEvent;
+        typedef common::utils_qt::Event<EventsInfo::MonitorResponce, QEvent::User + 46> MonitorResponceEvent;
+
+        typedef common::utils_qt::Event<EventsInfo::PubSubRequest, QEvent::User + 47> PubSubRequestEvent;
+        typedef common::utils_qt::Event<EventsInfo::PubSubResponce, QEvent::User + 48> PubSubResponceEvent;
+
+        typedef common::utils_qt::Event<EventsInfo::SlowLogRequest, QEvent::User + 49> SlowLogRequestEvent;
+        typedef common::utils_qt::Event<EventsInfo::SlowLogResponce, QEvent::User + 50> SlowLogResponceEvent;
+
+        typedef common::utils_qt::Event<EventsInfo::ClientListRequest, QEvent::User + 51> ClientListRequestEvent;
+        typedef common::utils_qt::Event<EventsInfo::ClientListResponce, QEvent::User + 52> ClientListResponceEvent;
+
+        typedef common::utils_qt::Event<EventsInfo::ClientKillRequest, QEvent::User + 53> ClientKillRequestEvent;
+        typedef common::utils_qt::Event<EventsInfo::ClientKillResponce, QEvent::User + 54> ClientKillResponceEvent;
+
+        typedef common::utils_qt::Event<EventsInfo::KeyspaceRequest, QEvent::User + 55> KeyspaceRequestEvent;
+        typedef common::utils_qt::Event<EventsInfo::KeyspaceResponce, QEvent::User + 56> KeyspaceResponceEvent;
+
         typedef common::utils_qt::Event<EventsInfo::ProgressInfoResponce, QEvent::User + 100> ProgressResponceEvent;
     }
 }
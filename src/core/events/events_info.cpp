@@ -171,11 +171,27 @@ namespace fastonosql
 
         LoadDatabaseContentRequest::LoadDatabaseContentRequest(initiator_type sender, DataBaseInfoSPtr inf, const std::string& pattern, uint32_t countKeys,
                                                                uint32_t cursor, error_type er)
-            : base_class(sender, er), inf_(inf), pattern_(pattern), countKeys_(countKeys), cursorIn_(cursor)
+            : base_class(sender, er), inf_(inf), pattern_(pattern), patternType_(KeysFilter::GLOB), keysType_(common::Value::TYPE_NULL),
+              valuePattern_(), valueMatchType_(ValueMatcher::SUBSTRING), maxKeysPerSecond_(0), countKeys_(countKeys), cursorIn_(cursor)
         {
 
         }
 
+        KeysFilter LoadDatabaseContentRequest::filter() const
+        {
+            return KeysFilter(pattern_, patternType_, keysType_);
+        }
+
+        ValueMatcher LoadDatabaseContentRequest::valueMatcher() const
+        {
+            return ValueMatcher(valuePattern_, valueMatchType_);
+        }
+
+        bool LoadDatabaseContentRequest::isValueSearch() const
+        {
+            return !valuePattern_.empty();
+        }
+
         LoadDatabaseContentResponce::LoadDatabaseContentResponce(const base_class &request)
             : base_class(request)
         {
@@ -218,25 +234,26 @@ namespace fastonosql
 
         }
 
-        ServerInfoHistoryRequest::ServerInfoHistoryRequest(initiator_type sender, error_type er)
-            : base_class(sender, er)
+        ServerInfoHistoryRequest::ServerInfoHistoryRequest(initiator_type sender, unsigned char property, unsigned char field,
+                                                           error_type er)
+            : base_class(sender, er), property_(property), field_(field), sumFields_(), stat_(InfoHistoryStore::STAT_AVG), from_(0), to_(0), maxPoints_(0)
         {
 
         }
 
         ServerInfoHistoryResponce::ServerInfoHistoryResponce(const base_class &request)
-            : base_class(request)
+            : base_class(request), resolution_(0), first_(0), last_(0), points_()
         {
         }
 
-        ServerInfoHistoryResponce::infos_container_type ServerInfoHistoryResponce::infos() const
+        ServerInfoHistoryResponce::points_container_type ServerInfoHistoryResponce::points() const
         {
-            return infos_;
+            return points_;
         }
 
-        void ServerInfoHistoryResponce::setInfos(const infos_container_type& inf)
+        void ServerInfoHistoryResponce::setPoints(const points_container_type& points)
         {
-            infos_ = inf;
+            points_ = points;
         }
 
         ClearServerHistoryRequest::ClearServerHistoryRequest(initiator_type sender, error_type er)
@@ -251,6 +268,91 @@ namespace fastonosql
 
         }
 
+        BenchmarkInfoRequest::BenchmarkInfoRequest(initiator_type sender, const BenchmarkConfig& config, error_type er)
+            : base_class(sender, er), config_(config)
+        {
+
+        }
+
+        BenchmarkInfoResponce::BenchmarkInfoResponce(const base_class &request)
+            : base_class(request), result_()
+        {
+
+        }
+
+        MonitorRequest::MonitorRequest(initiator_type sender, common::time64_t duration, const std::string& capturePath, error_type er)
+            : base_class(sender, er), duration_(duration), capturePath_(capturePath)
+        {
+
+        }
+
+        MonitorResponce::MonitorResponce(const base_class &request)
+            : base_class(request), last_()
+        {
+
+        }
+
+        PubSubRequest::PubSubRequest(initiator_type sender, const std::vector<std::string>& channels, const std::vector<std::string>& patterns,
+                                     PubSubRingSPtr ring, error_type er)
+            : base_class(sender, er), channels_(channels), patterns_(patterns), ring_(ring)
+        {
+
+        }
+
+        PubSubResponce::PubSubResponce(const base_class &request)
+            : base_class(request), received_(0)
+        {
+
+        }
+
+        SlowLogRequest::SlowLogRequest(initiator_type sender, int64_t afterId, error_type er)
+            : base_class(sender, er), afterId_(afterId)
+        {
+
+        }
+
+        SlowLogResponce::SlowLogResponce(const base_class &request)
+            : base_class(request), entries_(), msec_(0), stats_()
+        {
+
+        }
+
+        ClientListRequest::ClientListRequest(initiator_type sender, error_type er)
+            : base_class(sender, er)
+        {
+
+        }
+
+        ClientListResponce::ClientListResponce(const base_class &request)
+            : base_class(request), list_()
+        {
+
+        }
+
+        ClientKillRequest::ClientKillRequest(initiator_type sender, const std::vector<uint64_t>& ids, error_type er)
+            : base_class(sender, er), ids_(ids)
+        {
+
+        }
+
+        ClientKillResponce::ClientKillResponce(const base_class &request)
+            : base_class(request), killed_(0)
+        {
+
+        }
+
+        KeyspaceRequest::KeyspaceRequest(initiator_type sender, int db, const std::string& enableFlags, error_type er)
+            : base_class(sender, er), db_(db), enableFlags_(enableFlags)
+        {
+
+        }
+
+        KeyspaceResponce::KeyspaceResponce(const base_class &request)
+            : base_class(request), last_(), serverFlags_(), disabled_(false)
+        {
+
+        }
+
         ServerPropertyInfoRequest::ServerPropertyInfoRequest(initiator_type sender, error_type er)
             : base_class(sender, er)
         {
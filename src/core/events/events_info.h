@@ -1,6 +1,15 @@
 #pragma once
 
 #include "core/core_fwd.h"
+#include "core/keys_filter.h"
+#include "core/info_history_store.h"
+#include "core/benchmark.h"
+#include "core/monitor_analyzer.h"
+#include "core/pubsub_ring.h"
+#include "core/slowlog_analyzer.h"
+#include "core/client_list.h"
+#include "core/keyspace_analyzer.h"
+#include "core/value_matcher.h"
 #include "common/qt/utils_qt.h"
 
 namespace fastonosql
@@ -223,8 +232,18 @@ namespace fastonosql
             LoadDatabaseContentRequest(initiator_type sender, DataBaseInfoSPtr inf, const std::string& pattern, uint32_t countKeys,
                                        uint32_t cursor = 0, error_type er = error_type());
 
+            KeysFilter filter() const;
+            // set valuePattern_ to look inside values instead of listing keys
+            ValueMatcher valueMatcher() const;
+            bool isValueSearch() const;
+
             DataBaseInfoSPtr inf_;
             std::string pattern_;
+            KeysFilter::PatternType patternType_;
+            common::Value::Type keysType_;
+            std::string valuePattern_;
+            ValueMatcher::MatchType valueMatchType_;
+            uint32_t maxKeysPerSecond_; // 0 means no limit
             uint32_t countKeys_;
             const uint32_t cursorIn_;
         };
@@ -281,21 +300,36 @@ namespace fastonosql
                 : public EventInfoBase
         {
             typedef EventInfoBase base_class;
-            explicit ServerInfoHistoryRequest(initiator_type sender, error_type er = error_type());
+            ServerInfoHistoryRequest(initiator_type sender, unsigned char property, unsigned char field,
+                                     error_type er = error_type());
+
+            // indexes of the info field as in infoFieldsFromType
+            unsigned char property_;
+            unsigned char field_;
+            std::vector<unsigned char> sumFields_; // more fields of property added to field_
+            InfoHistoryStore::Stat stat_; // used when the range is read from rollups
+            common::time64_t from_; // 0 means unbounded
+            common::time64_t to_;   // 0 means unbounded
+            uint32_t maxPoints_;    // usually the graph width, 0 means all points
         };
 
         struct ServerInfoHistoryResponce
                 : ServerInfoHistoryRequest
         {
             typedef ServerInfoHistoryRequest base_class;
-            typedef std::vector<ServerInfoSnapShoot> infos_container_type;
+            typedef InfoHistoryStore::points_container_type points_container_type;
             explicit ServerInfoHistoryResponce(const base_class &request);
 
-            infos_container_type infos() const;
-            void setInfos(const infos_container_type& inf);
+            points_container_type points() const;
+            void setPoints(const points_container_type& points);
+
+            common::time64_t resolution_; // 0 for raw samples
+            // whole history, for scrolling
+            common::time64_t first_;
+            common::time64_t last_;
 
         private:
-            infos_container_type infos_;
+            points_container_type points_;
         };
 
         struct ClearServerHistoryRequest
@@ -312,6 +346,139 @@ namespace fastonosql
             explicit ClearServerHistoryResponce(const base_class &request);
         };
 
+        struct BenchmarkInfoRequest
+                : public EventInfoBase
+        {
+            typedef EventInfoBase base_class;
+            BenchmarkInfoRequest(initiator_type sender, const BenchmarkConfig& config, error_type er = error_type());
+
+            BenchmarkConfig config_;
+        };
+
+        struct BenchmarkInfoResponce
+                : public BenchmarkInfoRequest
+        {
+            typedef BenchmarkInfoRequest base_class;
+            explicit BenchmarkInfoResponce(const base_class &request);
+
+            BenchmarkResult result_;
+        };
+
+        struct MonitorRequest
+                : public EventInfoBase
+        {
+            typedef EventInfoBase base_class;
+            MonitorRequest(initiator_type sender, common::time64_t duration, const std::string& capturePath, error_type er = error_type());
+
+            common::time64_t duration_; // msec, 0 until stopped
+            std::string capturePath_; // raw lines are appended to it when set
+        };
+
+        struct MonitorResponce
+                : public MonitorRequest
+        {
+            typedef MonitorRequest base_class;
+            explicit MonitorResponce(const base_class &request);
+
+            MonitorSnapShot last_;
+        };
+
+        struct PubSubRequest
+                : public EventInfoBase
+        {
+            typedef EventInfoBase base_class;
+            PubSubRequest(initiator_type sender, const std::vector<std::string>& channels, const std::vector<std::string>& patterns,
+                          PubSubRingSPtr ring, error_type er = error_type());
+
+            std::vector<std::string> channels_; // SUBSCRIBE
+            std::vector<std::string> patterns_; // PSUBSCRIBE
+            PubSubRingSPtr ring_; // filled by the driver until stopped
+        };
+
+        struct PubSubResponce
+                : public PubSubRequest
+        {
+            typedef PubSubRequest base_class;
+            explicit PubSubResponce(const base_class &request);
+
+            uint64_t received_;
+        };
+
+        struct SlowLogRequest
+                : public EventInfoBase
+        {
+            typedef EventInfoBase base_class;
+            SlowLogRequest(initiator_type sender, int64_t afterId, error_type er = error_type());
+
+            int64_t afterId_; // -1 for the whole log
+        };
+
+        struct SlowLogResponce
+                : public SlowLogRequest
+        {
+            typedef SlowLogRequest base_class;
+            explicit SlowLogResponce(const base_class &request);
+
+            std::vector<SlowLogEntry> entries_; // newer than afterId_, oldest first
+            common::time64_t msec_; // when the command stats were taken
+            command_stats_t stats_;
+        };
+
+        struct ClientListRequest
+                : public EventInfoBase
+        {
+            typedef EventInfoBase base_class;
+            explicit ClientListRequest(initiator_type sender, error_type er = error_type());
+        };
+
+        struct ClientListResponce
+                : public ClientListRequest
+        {
+            typedef ClientListRequest base_class;
+            explicit ClientListResponce(const base_class &request);
+
+            ClientList list_;
+        };
+
+        struct ClientKillRequest
+                : public EventInfoBase
+        {
+            typedef EventInfoBase base_class;
+            ClientKillRequest(initiator_type sender, const std::vector<uint64_t>& ids, error_type er = error_type());
+
+            std::vector<uint64_t> ids_;
+        };
+
+        struct ClientKillResponce
+                : public ClientKillRequest
+        {
+            typedef ClientKillRequest base_class;
+            explicit ClientKillResponce(const base_class &request);
+
+            size_t killed_; // clients gone before their kill aren't counted
+        };
+
+        struct KeyspaceRequest
+                : public EventInfoBase
+        {
+            typedef EventInfoBase base_class;
+            KeyspaceRequest(initiator_type sender, int db, const std::string& enableFlags, error_type er = error_type());
+
+            int db_; // -1 for all databases
+            std::string enableFlags_; // notify-keyspace-events set for the stream and restored after it, empty to leave as is
+        };
+
+        struct KeyspaceResponce
+                : public KeyspaceRequest
+        {
+            typedef KeyspaceRequest base_class;
+            explicit KeyspaceResponce(const base_class &request);
+
+            KeyspaceSnapShot last_;
+            std::string serverFlags_; // notify-keyspace-events as found
+            bool disabled_; // the server notifies nothing, the stream wasn't started
+        };
+
         struct ServerPropertyInfoRequest
                 : public EventInfoBase
         {
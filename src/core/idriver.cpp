@@ -6,8 +6,11 @@
 #include <signal.h>
 #endif
 
-#include <QThread>
+#include <algorithm>
+
 #include <QApplication>
+#include <QDir>
+#include <QTimer>
 
 extern "C" {
     #include "sds.h"
@@ -15,9 +18,25 @@ extern "C" {
 
 #include "common/file_system.h"
 #include "common/time.h"
+#include "common/utils.h"
 #include "common/sprintf.h"
+#include "common/qt/convert_string.h"
+
+#include "fasto/qt/logger.h"
 
 #include "core/command_logger.h"
+#include "core/drivers_pool.h"
+#include "core/info_history_store.h"
+#include "core/benchmark.h"
+#include "core/latency_histogram.h"
+
+#define SEARCH_VALUES_PATTERN_3ARGS_SSI "SEARCH VALUES \"%s\" MATCH %s COUNT %u"
+#define VALUES_SEARCH_BATCH 256
+#define VALUES_SEARCH_SLEEP_MSEC 50
+#define CHILDREN_BATCH_SIZE 1024
+#define CHILDREN_FLUSH_MSEC 16
+#define HISTORY_RETENTION_MSEC (30LL * 24 * 60 * 60 * 1000)
+#define LATENCY_HISTORY_DIRECTORY "latency"
 
 namespace
 {
@@ -40,12 +59,12 @@ struct WinsockInit {
     } sig_init;
 #endif
 
-    const char magicNumber = 0x1E;
-    std::string createStamp(common::time64_t time)
-    {
-        return magicNumber + common::convertToString(time) + '\n';
-    }
+    // internal events of the driver strand
+    const QEvent::Type initEventType = static_cast<QEvent::Type>(QEvent::User + 101);
+    const QEvent::Type pollEventType = static_cast<QEvent::Type>(QEvent::User + 102);
 
+    // stamp line of the text history written by older versions
+    const char magicNumber = 0x1E;
     bool getStamp(const common::buffer_type& stamp, common::time64_t& timeOut)
     {
         if(stamp.empty()){
@@ -118,7 +137,7 @@ namespace fastonosql
 
             if (argv == NULL) {
                 common::StringValue *val = common::Value::createStringValue("Invalid argument(s)");
-                FastoObject* child = new FastoObject(cmd, val, cmd->delemitr());
+                FastoObject* child = new(cmd) FastoObject(cmd, val, cmd->delemitr());
                 cmd->addChildren(child);
             }
             else if (argc > 0) {
@@ -137,19 +156,34 @@ namespace fastonosql
     }
 
     IDriver::IDriver(IConnectionSettingsBaseSPtr settings, connectionTypes type)
-        : settings_(settings), interrupt_(false), serverDiscInfo_(), thread_(NULL), timer_info_id_(0), log_file_(NULL), type_(type)
+        : settings_(settings), interrupt_(0), streamStop_(0), serverDiscInfo_(), strand_(NULL), monitoringStrand_(NULL), streamStrand_(NULL), pollPending_(0), watches_(), history_(NULL), latencyHistory_(NULL), history_lock_(), type_(type),
+          pendingChildren_(), readyChildren_(), pendingSince_(0), children_lock_(), flushTimer_(NULL)
     {
-        thread_ = new QThread(this);
-        moveToThread(thread_);
+        // a batch which stops growing is sent on the gui thread, the command
+        // adding it may block in a client library for long
+        flushTimer_ = new QTimer(this);
+        flushTimer_->setSingleShot(true);
+        flushTimer_->setInterval(CHILDREN_FLUSH_MSEC);
+        VERIFY(connect(flushTimer_, &QTimer::timeout, this, &IDriver::flushChildren));
 
-        VERIFY(connect(thread_, &QThread::started, this, &IDriver::init));
-        VERIFY(connect(thread_, &QThread::finished, this, &IDriver::clear));
+        strand_ = DriversPool::instance().createStrand(this);
+        monitoringStrand_ = DriversPool::instance().createStrand(this);
+        streamStrand_ = DriversPool::instance().createStrand(this);
     }
 
     IDriver::~IDriver()
     {
-        delete log_file_;
-        log_file_ = NULL;
+        DriversPool::instance().removePolling(this);
+        delete streamStrand_;
+        streamStrand_ = NULL;
+        delete monitoringStrand_;
+        monitoringStrand_ = NULL;
+        delete strand_;
+        strand_ = NULL;
+        delete history_;
+        history_ = NULL;
+        delete latencyHistory_;
+        latencyHistory_ = NULL;
     }
 
     void IDriver::reply(QObject *reciver, QEvent *ev)
@@ -185,13 +219,68 @@ namespace fastonosql
 
     void IDriver::start()
     {
-        thread_->start();
+        post(new QEvent(initEventType));
+        updatePolling();
     }
 
     void IDriver::stop()
     {
-        thread_->quit();
-        thread_->wait();
+        DriversPool::instance().removePolling(this);
+        stopStream();
+        streamStrand_->close();
+        monitoringStrand_->close();
+        strand_->close();
+    }
+
+    void IDriver::post(QEvent* ev)
+    {
+        strand_->post(ev);
+    }
+
+    void IDriver::postStream(QEvent* ev)
+    {
+        streamStrand_->post(ev);
+    }
+
+    void IDriver::stopStream()
+    {
+        streamStop_.fetchAndStoreOrdered(1);
+    }
+
+    void IDriver::postMonitoring(QEvent* ev)
+    {
+        if(hasMonitoringConnection()){
+            monitoringStrand_->post(ev);
+        }
+        else{
+            post(ev);
+        }
+    }
+
+    void IDriver::schedulePoll()
+    {
+        if(!pollPending_.testAndSetOrdered(0, 1)){
+            return;
+        }
+
+        // samples on their own connection aren't delayed by user commands
+        if(hasMonitoringConnection()){
+            monitoringStrand_->post(new QEvent(pollEventType));
+        }
+        else{
+            post(new QEvent(pollEventType));
+        }
+    }
+
+    bool IDriver::hasMonitoringConnection() const
+    {
+        return false;
+    }
+
+    common::Error IDriver::monitoringServerInfo(ServerInfo** info)
+    {
+        UNUSED(info);
+        return common::make_error_value("Monitoring connection not supported", common::ErrorValue::E_ERROR);
     }
 
     common::Error IDriver::commandByType(CommandKeySPtr command, std::string& cmdstring) const
@@ -238,28 +327,73 @@ namespace fastonosql
 
     void IDriver::interrupt()
     {
-        interrupt_ = true;
+        interrupt_.fetchAndStoreOrdered(1);
     }
 
     void IDriver::init()
     {
-        int interval = settings_->loggingMsTimeInterval();
-        timer_info_id_ = startTimer(interval);
-        DCHECK(timer_info_id_);
         initImpl();
     }
 
-    void IDriver::clear()
-    {
-        killTimer(timer_info_id_);
-        timer_info_id_ = 0;
-    }
-
     void IDriver::customEvent(QEvent *event)
     {
         using namespace events;
         QEvent::Type type = event->type();
-        if (type == static_cast<QEvent::Type>(ConnectRequestEvent::EventType)){            
+        if (type == pollEventType){
+            // may run on the monitoring strand next to a command, interrupt_ isn't touched
+            pollPending_.fetchAndStoreOrdered(0);
+            pollServerInfo();
+            return QObject::customEvent(event);
+        }
+
+        if (type == static_cast<QEvent::Type>(MonitorRequestEvent::EventType)){
+            // runs on the stream strand until stopped, interrupt_ belongs to commands
+            MonitorRequestEvent *ev = static_cast<MonitorRequestEvent*>(event);
+            streamStop_.fetchAndStoreOrdered(0);
+            DriversPool::BlockingScope scope;
+            handleMonitorEvent(ev);
+            return QObject::customEvent(event);
+        }
+
+        if (type == static_cast<QEvent::Type>(PubSubRequestEvent::EventType)){
+            PubSubRequestEvent *ev = static_cast<PubSubRequestEvent*>(event);
+            streamStop_.fetchAndStoreOrdered(0);
+            DriversPool::BlockingScope scope;
+            handlePubSubEvent(ev);
+            return QObject::customEvent(event);
+        }
+
+        if (type == static_cast<QEvent::Type>(KeyspaceRequestEvent::EventType)){
+            KeyspaceRequestEvent *ev = static_cast<KeyspaceRequestEvent*>(event);
+            streamStop_.fetchAndStoreOrdered(0);
+            DriversPool::BlockingScope scope;
+            handleKeyspaceEvent(ev);
+            return QObject::customEvent(event);
+        }
+
+        if (type == static_cast<QEvent::Type>(SlowLogRequestEvent::EventType)){
+            // like the info poll, may run next to a command
+            SlowLogRequestEvent *ev = static_cast<SlowLogRequestEvent*>(event);
+            handleSlowLogEvent(ev);
+            return QObject::customEvent(event);
+        }
+
+        if (type == static_cast<QEvent::Type>(ClientListRequestEvent::EventType)){
+            ClientListRequestEvent *ev = static_cast<ClientListRequestEvent*>(event);
+            handleClientListEvent(ev);
+            return QObject::customEvent(event);
+        }
+
+        if (type == static_cast<QEvent::Type>(ClientKillRequestEvent::EventType)){
+            ClientKillRequestEvent *ev = static_cast<ClientKillRequestEvent*>(event);
+            handleClientKillEvent(ev);
+            return QObject::customEvent(event);
+        }
+
+        if (type == initEventType){
+            init();
+        }
+        else if (type == static_cast<QEvent::Type>(ConnectRequestEvent::EventType)){
             ConnectRequestEvent *ev = static_cast<ConnectRequestEvent*>(event);
             handleConnectEvent(ev);
         }
@@ -269,6 +403,7 @@ namespace fastonosql
         }
         else if (type == static_cast<QEvent::Type>(ProcessConfigArgsRequestEvent::EventType)){
             ProcessConfigArgsRequestEvent *ev = static_cast<ProcessConfigArgsRequestEvent*>(event);
+            DriversPool::BlockingScope scope;
             handleProcessCommandLineArgs(ev);
         }
         else if (type == static_cast<QEvent::Type>(DisconnectRequestEvent::EventType)){
@@ -277,6 +412,7 @@ namespace fastonosql
         }
         else if (type == static_cast<QEvent::Type>(ExecuteRequestEvent::EventType)){
             ExecuteRequestEvent *ev = static_cast<ExecuteRequestEvent*>(event);
+            DriversPool::BlockingScope scope;
             handleExecuteEvent(ev);
         }
         else if (type == static_cast<QEvent::Type>(LoadDatabasesInfoRequestEvent::EventType)){
@@ -295,6 +431,11 @@ namespace fastonosql
             ClearServerHistoryRequestEvent *ev = static_cast<ClearServerHistoryRequestEvent*>(event);
             handleClearServerHistoryRequestEvent(ev);
         }
+        else if (type == static_cast<QEvent::Type>(BenchmarkRequestEvent::EventType)){
+            BenchmarkRequestEvent *ev = static_cast<BenchmarkRequestEvent*>(event);
+            DriversPool::BlockingScope scope;
+            handleBenchmarkRequestEvent(ev);
+        }
         else if (type == static_cast<QEvent::Type>(ServerPropertyInfoRequestEvent::EventType)){
             ServerPropertyInfoRequestEvent *ev = static_cast<ServerPropertyInfoRequestEvent*>(event);
             handleLoadServerPropertyEvent(ev);
@@ -321,7 +462,13 @@ namespace fastonosql
         }
         else if (type == static_cast<QEvent::Type>(LoadDatabaseContentRequestEvent::EventType)){
             LoadDatabaseContentRequestEvent *ev = static_cast<LoadDatabaseContentRequestEvent*>(event);
-            handleLoadDatabaseContentEvent(ev);
+            if(ev->value().isValueSearch()){
+                DriversPool::BlockingScope scope;
+                handleSearchValuesEvent(ev);
+            }
+            else{
+                handleLoadDatabaseContentEvent(ev);
+            }
         }
         else if (type == static_cast<QEvent::Type>(SetDefaultDatabaseRequestEvent::EventType)){
             SetDefaultDatabaseRequestEvent *ev = static_cast<SetDefaultDatabaseRequestEvent*>(event);
@@ -336,49 +483,145 @@ namespace fastonosql
             handleDiscoveryInfoRequestEvent(ev);
         }
 
-        interrupt_ = false;
+        interrupt_.storeRelease(0);
 
         return QObject::customEvent(event);
     }
 
-    void IDriver::timerEvent(QTimerEvent* event)
+    void IDriver::watchInfo(int msec)
     {
-        if(timer_info_id_ == event->timerId() && isConnected() && settings_->loggingEnabled()){
-            if(!log_file_){
-                std::string path = settings_->loggingPath();
-                std::string dir = common::file_system::get_dir_path(path);
-                bool res = common::file_system::create_directory(dir, true);
-                UNUSED(res);
-                if(common::file_system::is_directory(dir) == SUCCESS){
-                    common::file_system::Path p(path);
-                    log_file_ = new common::file_system::File(p);
-                }
-            }
+        watches_.insert(msec);
+        updatePolling();
+    }
 
-            if(log_file_ && !log_file_->isOpened()){
-                bool opened = log_file_->open("ab+");
-                DCHECK(opened);
-            }
+    void IDriver::unwatchInfo(int msec)
+    {
+        std::multiset<int>::iterator it = watches_.find(msec);
+        if(it != watches_.end()){
+            watches_.erase(it);
+        }
+        updatePolling();
+    }
 
-            if(log_file_ && log_file_->isOpened()){
-                common::time64_t time = common::time::current_mstime();
-                std::string stamp = createStamp(time);
-                ServerInfo* info = NULL;
-                common::Error er = serverInfo(&info);
-                if(er && er->isError()){
-                    QObject::timerEvent(event);
-                    return;
-                }
+    // drivers nobody logs or watches aren't polled at all
+    void IDriver::updatePolling()
+    {
+        bool polling = settings_->loggingEnabled();
+        int msec = settings_->loggingMsTimeInterval();
+        if(!watches_.empty()){
+            msec = polling ? std::min(msec, *watches_.begin()) : *watches_.begin();
+            polling = true;
+        }
+
+        if(polling){
+            DriversPool::instance().addPolling(this, msec);
+        }
+        else{
+            DriversPool::instance().removePolling(this);
+        }
+    }
+
+    void IDriver::pollServerInfo()
+    {
+        if(!isConnected()){
+            return;
+        }
+
+        common::time64_t time = common::time::current_mstime();
+        ServerInfo* info = NULL;
+        common::Error er = hasMonitoringConnection() ? monitoringServerInfo(&info) : serverInfo(&info);
+        if(er && er->isError()){
+            return;
+        }
+
+        ServerInfoSnapShoot shot(time, ServerInfoSPtr(info));
+        emit serverInfoSnapShoot(shot);
+
+        if(!settings_->loggingEnabled()){
+            return;
+        }
+
+        er = history()->append(time, info);
+        if(er && er->isError()){
+            LOG_ERROR(er, true);
+        }
+    }
+
+    InfoHistoryStore* IDriver::history()
+    {
+        QMutexLocker lock(&history_lock_);
+        if(!history_){
+            history_ = new InfoHistoryStore(settings_->historyPath(), type_, HISTORY_RETENTION_MSEC);
+            importTextHistory();
+        }
+        return history_;
+    }
+
+    InfoHistoryStore* IDriver::latencyHistory()
+    {
+        QMutexLocker lock(&history_lock_);
+        if(!latencyHistory_){
+            QDir dir(common::convertFromString<QString>(settings_->historyPath()));
+            latencyHistory_ = new InfoHistoryStore(common::convertToString(dir.filePath(LATENCY_HISTORY_DIRECTORY)), latencyHistoryFields(), HISTORY_RETENTION_MSEC);
+        }
+        return latencyHistory_;
+    }
+
+    void IDriver::addLatencyHistory(common::time64_t msec, const LatencyHistogram& window)
+    {
+        if(!settings_->loggingEnabled() || !window.count()){
+            return;
+        }
+
+        common::Error er = latencyHistory()->append(msec, latencyHistoryValues(window));
+        if(er && er->isError()){
+            LOG_ERROR(er, true);
+        }
+    }
+
+    // moves the text history of older versions into the store, once
+    void IDriver::importTextHistory()
+    {
+        std::string path = settings_->loggingPath();
+        if(!common::file_system::is_file_exist(path)){
+            return;
+        }
 
-                ServerInfoSnapShoot shot(time, ServerInfoSPtr(info));
-                emit serverInfoSnapShoot(shot);
+        common::file_system::Path p(path);
+        common::file_system::File readFile(p);
+        if(!readFile.open("rb")){
+            return;
+        }
+
+        common::time64_t curStamp = 0;
+        common::buffer_type dataInfo;
+        while(true){
+            common::buffer_type data;
+            bool res = readFile.readLine(data);
+            bool last = !res || readFile.isEof();
+            common::time64_t tmpStamp = 0;
+            if(last || getStamp(data, tmpStamp)){
+                ServerInfoSPtr info = curStamp ? makeServerInfoFromString(common::convertToString(dataInfo)) : ServerInfoSPtr();
+                if(info){
+                    // unordered records are dropped by the store
+                    common::Error er = history_->append(curStamp, info.get());
+                    UNUSED(er);
+                }
+                curStamp = tmpStamp;
+                dataInfo.clear();
+            }
+            else{
+                dataInfo.insert(dataInfo.end(), data.begin(), data.end());
+            }
 
-                log_file_->write(stamp);
-                log_file_->write(info->toString());
-                log_file_->flush();
+            if(last){
+                break;
             }
         }
-        QObject::timerEvent(event);
+
+        readFile.close();
+        bool rem = common::file_system::remove_file(path);
+        DCHECK(rem);
     }
 
     void IDriver::notifyProgress(QObject *reciver, int value)
@@ -396,6 +639,36 @@ namespace fastonosql
         replyNotImplementedYet<events::ChangeServerPropertyInfoRequestEvent, events::ChangeServerPropertyInfoResponceEvent>(this, ev, "change server property command");
     }
 
+    void IDriver::handleMonitorEvent(events::MonitorRequestEvent* ev)
+    {
+        replyNotImplementedYet<events::MonitorRequestEvent, events::MonitorResponceEvent>(this, ev, "monitor command");
+    }
+
+    void IDriver::handlePubSubEvent(events::PubSubRequestEvent* ev)
+    {
+        replyNotImplementedYet<events::PubSubRequestEvent, events::PubSubResponceEvent>(this, ev, "subscribe command");
+    }
+
+    void IDriver::handleKeyspaceEvent(events::KeyspaceRequestEvent* ev)
+    {
+        replyNotImplementedYet<events::KeyspaceRequestEvent, events::KeyspaceResponceEvent>(this, ev, "keyspace notifications");
+    }
+
+    void IDriver::handleSlowLogEvent(events::SlowLogRequestEvent* ev)
+    {
+        replyNotImplementedYet<events::SlowLogRequestEvent, events::SlowLogResponceEvent>(this, ev, "slowlog command");
+    }
+
+    void IDriver::handleClientListEvent(events::ClientListRequestEvent* ev)
+    {
+        replyNotImplementedYet<events::ClientListRequestEvent, events::ClientListResponceEvent>(this, ev, "client list command");
+    }
+
+    void IDriver::handleClientKillEvent(events::ClientKillRequestEvent* ev)
+    {
+        replyNotImplementedYet<events::ClientKillRequestEvent, events::ClientKillResponceEvent>(this, ev, "client kill command");
+    }
+
     void IDriver::handleShutdownEvent(events::ShutDownRequestEvent* ev)
     {
         replyNotImplementedYet<events::ShutDownRequestEvent, events::ShutDownResponceEvent>(this, ev, "shutdown command");
@@ -430,6 +703,7 @@ namespace fastonosql
 
     IDriver::RootLocker::~RootLocker()
     {
+        parent_->flushChildren();
         events::CommandRootCompleatedEvent::value_type res(this, tstart_, root_);
         reply(reciver_, new events::CommandRootCompleatedEvent(parent_, res));
     }
@@ -450,44 +724,22 @@ namespace fastonosql
     void IDriver::handleLoadServerInfoHistoryEvent(events::ServerInfoHistoryRequestEvent *ev)
     {
         QObject *sender = ev->sender();
-        events::ServerInfoHistoryResponceEvent::value_type res(ev->value());        
+        events::ServerInfoHistoryResponceEvent::value_type res(ev->value());
 
-        std::string path = settings_->loggingPath();
-        common::file_system::Path p(path);
-        common::file_system::File readFile(p);
-        if(readFile.open("rb")){
-            events::ServerInfoHistoryResponceEvent::value_type::infos_container_type tmpInfos;
-
-            common::time64_t curStamp = 0;
-            common::buffer_type dataInfo;
-
-            while(!readFile.isEof()){
-                common::buffer_type data;
-                bool res = readFile.readLine(data);
-                if(!res || readFile.isEof()){
-                    if(curStamp){
-                        tmpInfos.push_back(ServerInfoSnapShoot(curStamp, makeServerInfoFromString(common::convertToString(dataInfo))));
-                    }
-                    break;
-                }
+        InfoHistoryStore* store = history();
+        events::ServerInfoHistoryResponceEvent::value_type::points_container_type points;
+        std::vector<unsigned char> fields(1, res.field_);
+        fields.insert(fields.end(), res.sumFields_.begin(), res.sumFields_.end());
+        common::Error er = store->read(res.property_, fields, res.stat_, res.from_, res.to_, res.maxPoints_, &points, &res.resolution_);
+        if(!er){
+            er = store->bounds(&res.first_, &res.last_);
+        }
 
-                common::time64_t tmpStamp = 0;
-                bool isSt = getStamp(data, tmpStamp);
-                if(isSt){
-                    if(curStamp){
-                        tmpInfos.push_back(ServerInfoSnapShoot(curStamp, makeServerInfoFromString(common::convertToString(dataInfo))));
-                    }
-                    curStamp = tmpStamp;
-                    dataInfo.clear();
-                }
-                else{
-                    dataInfo.insert(dataInfo.end(), data.begin(), data.end());
-                }
-            }
-            res.setInfos(tmpInfos);
+        if(er && er->isError()){
+            res.setErrorInfo(er);
         }
         else{
-           res.setErrorInfo(common::make_error_value("Logging file not found", common::ErrorValue::E_ERROR));
+            res.setPoints(points);
         }
 
         reply(sender, new events::ServerInfoHistoryResponceEvent(this, res));
@@ -498,26 +750,59 @@ namespace fastonosql
         QObject *sender = ev->sender();
         events::ClearServerHistoryResponceEvent::value_type res(ev->value());
 
-        bool ret = false;
-
-        if(log_file_ && log_file_->isOpened()){
-            ret = log_file_->truncate(0);
+        common::Error er = history()->clear();
+        if(!er || !er->isError()){
+            er = latencyHistory()->clear();
+        }
+        if(er && er->isError()){
+            res.setErrorInfo(er);
         }
-        else {
-            std::string path = settings_->loggingPath();
-            if(common::file_system::is_file_exist(path)){
-                ret = common::file_system::remove_file(path);
+
+        reply(sender, new events::ClearServerHistoryResponceEvent(this, res));
+    }
+
+    void IDriver::handleBenchmarkRequestEvent(events::BenchmarkRequestEvent *ev)
+    {
+        QObject *sender = ev->sender();
+        notifyProgress(sender, 0);
+        events::BenchmarkResponceEvent::value_type res(ev->value());
+        res.result_.server_ = common::convertToString(address());
+        res.result_.type_ = type_;
+
+        std::vector<BenchmarkClient*> clients;
+        common::Error er;
+        for(uint32_t i = 0; i < res.config_.clients_; ++i){
+            BenchmarkClient* client = NULL;
+            er = createBenchmarkClient(&client);
+            if(er){
+                break;
             }
-            else{
-                ret = true;
+            clients.push_back(client);
+        }
+        notifyProgress(sender, 25);
+
+        if(!er){
+            er = runBenchmark(clients, res.config_, &interrupt_, &res.result_);
+        }
+        notifyProgress(sender, 75);
+
+        // an interrupted or failed run may have written keys too
+        if(res.config_.removeKeys_ && !clients.empty()){
+            common::Error rer = removeBenchmarkKeys(clients[0], res.config_);
+            if(!er){
+                er = rer;
             }
         }
 
-        if(!ret){
-            res.setErrorInfo(common::make_error_value("Clear file error!", common::ErrorValue::E_ERROR));
+        for(size_t i = 0; i < clients.size(); ++i){
+            delete clients[i];
         }
 
-        reply(sender, new events::ClearServerHistoryResponceEvent(this, res));
+        if(er && er->isError()){
+            res.setErrorInfo(er);
+        }
+        reply(sender, new events::BenchmarkResponceEvent(this, res));
+        notifyProgress(sender, 100);
     }
 
     void IDriver::handleDiscoveryInfoRequestEvent(events::DiscoveryInfoRequestEvent* ev)
@@ -552,6 +837,82 @@ namespace fastonosql
         reply(sender, new events::DiscoveryInfoResponceEvent(this, res));
     }
 
+    void IDriver::handleSearchValuesEvent(events::LoadDatabaseContentRequestEvent* ev)
+    {
+        QObject *sender = ev->sender();
+        notifyProgress(sender, 0);
+            events::LoadDatabaseContentResponceEvent::value_type res(ev->value());
+            const KeysFilter filter = res.filter();
+            const ValueMatcher matcher = res.valueMatcher();
+            char patternResult[1024] = {0};
+            common::SNPrintf(patternResult, sizeof(patternResult), SEARCH_VALUES_PATTERN_3ARGS_SSI, matcher.pattern(), filter.pattern(), res.countKeys_);
+        notifyProgress(sender, 50);
+            LOG_COMMAND(Command(patternResult, common::Value::C_INNER));
+            common::Error er;
+            if(!filter.isValid()){
+                er = common::make_error_value(filter.errorString(), common::ErrorValue::E_ERROR);
+            }
+            else if(!matcher.isValid()){
+                er = common::make_error_value(matcher.errorString(), common::ErrorValue::E_ERROR);
+            }
+            else if(filter.matchType(common::Value::TYPE_STRING)){
+                const uint32_t batch = res.maxKeysPerSecond_ ? std::min<uint32_t>(res.maxKeysPerSecond_, VALUES_SEARCH_BATCH) : VALUES_SEARCH_BATCH;
+                const common::time64_t start = common::time::current_mstime();
+                uint64_t scanned = 0;
+                std::string cursor;
+                do {
+                    if(interrupt_.loadAcquire()){
+                        er.reset(new common::ErrorValue("Interrupted search.", common::ErrorValue::E_INTERRUPTED));
+                        break;
+                    }
+
+                    std::vector<std::string> keys;
+                    std::vector<std::string> values;
+                    std::string next;
+                    er = scanValues(filter, cursor, batch, &keys, &values, &next);
+                    if(er){
+                        break;
+                    }
+
+                    DCHECK(keys.size() == values.size());
+                    events::LoadDatabaseContentResponceEvent::value_type part(ev->value());
+                    for(size_t i = 0; i < keys.size() && res.keys_.size() < res.countKeys_; ++i){
+                        if(filter.match(keys[i]) && matcher.match(values[i])){
+                            NValue val(common::Value::createEmptyValueFromType(common::Value::TYPE_STRING));
+                            NDbKValue found(NKey(keys[i]), val);
+                            part.keys_.push_back(found);
+                            res.keys_.push_back(found);
+                        }
+                    }
+
+                    // matches show up in the browser while the walk goes on
+                    if(!part.keys_.empty()){
+                        reply(sender, new events::LoadDatabaseContentResponceEvent(this, part));
+                    }
+
+                    scanned += keys.size();
+                    cursor = next;
+
+                    // keep the average rate under the cap, sleeping in slices to stay interruptible
+                    if(res.maxKeysPerSecond_){
+                        const common::time64_t due = start + static_cast<common::time64_t>(scanned * 1000 / res.maxKeysPerSecond_);
+                        common::time64_t now = common::time::current_mstime();
+                        while(!interrupt_.loadAcquire() && now < due){
+                            common::utils::msleep(std::min<common::time64_t>(due - now, VALUES_SEARCH_SLEEP_MSEC));
+                            now = common::time::current_mstime();
+                        }
+                    }
+                } while(!cursor.empty() && res.keys_.size() < res.countKeys_);
+            }
+
+            if(er){
+                res.setErrorInfo(er);
+            }
+        notifyProgress(sender, 75);
+            reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
+        notifyProgress(sender, 100);
+    }
+
     void IDriver::addedChildren(FastoObject* child)
     {
         DCHECK(child);
@@ -559,11 +920,73 @@ namespace fastonosql
             return;
         }
 
-        emit addedChild(child);
+        bool started = false;
+        bool ready = false;
+        {
+            QMutexLocker lock(&children_lock_);
+            // a batch has one parent, so the gui inserts it as one row range
+            if(!pendingChildren_.empty() && pendingChildren_.back()->parent() != child->parent()){
+                readyChildren_.push_back(FastoObject::child_batch_type());
+                readyChildren_.back().swap(pendingChildren_);
+                ready = true;
+            }
+
+            const common::time64_t now = common::time::current_mstime();
+            if(pendingChildren_.empty()){
+                pendingSince_ = now;
+                started = true;
+            }
+
+            pendingChildren_.push_back(child);
+            if(pendingChildren_.size() >= CHILDREN_BATCH_SIZE || now - pendingSince_ >= CHILDREN_FLUSH_MSEC){
+                readyChildren_.push_back(FastoObject::child_batch_type());
+                readyChildren_.back().swap(pendingChildren_);
+                ready = true;
+            }
+        }
+
+        if(ready){
+            QMetaObject::invokeMethod(this, "deliverChildren", Qt::QueuedConnection);
+        }
+
+        if(started){
+            QMetaObject::invokeMethod(flushTimer_, "start", Qt::QueuedConnection);
+        }
+    }
+
+    void IDriver::updated(FastoObject* item)
+    {
+        flushChildren();
+        emit itemUpdated(item);
     }
 
-    void IDriver::updated(FastoObject* item, common::Value* val)
+    void IDriver::flushChildren()
     {
-        emit itemUpdated(item, val);
+        {
+            QMutexLocker lock(&children_lock_);
+            if(pendingChildren_.empty()){
+                return;
+            }
+
+            readyChildren_.push_back(FastoObject::child_batch_type());
+            readyChildren_.back().swap(pendingChildren_);
+        }
+
+        QMetaObject::invokeMethod(this, "deliverChildren", Qt::QueuedConnection);
+    }
+
+    void IDriver::deliverChildren()
+    {
+        // the only place batches are emitted, a direct connection from here can
+        // not overtake a batch still waiting in the event queue
+        std::deque<FastoObject::child_batch_type> ready;
+        {
+            QMutexLocker lock(&children_lock_);
+            ready.swap(readyChildren_);
+        }
+
+        for(size_t i = 0; i < ready.size(); ++i){
+            emit childrenAdded(ready[i]);
+        }
     }
 }
@@ -1,27 +1,30 @@
 #pragma once
 
+#include <set>
+#include <deque>
+
 #include <QObject>
+#include <QAtomicInt>
+#include <QMutex>
 
 #include "common/net/net.h"
 
 #include "core/connection_settings.h"
 #include "core/events/events.h"
 
-class QThread;
-
-namespace common
-{
-    namespace file_system
-    {
-        class File;
-    }
-}
+class QTimer;
 
 namespace fastonosql
 {
+    class DriverStrand;
+    class InfoHistoryStore;
+    class LatencyHistogram;
+    class BenchmarkClient;
+
     class IDriver
             : public QObject, private IFastoObjectObserver
     {
+        friend class DriverStrand;
         Q_OBJECT
     public:
         IDriver(IConnectionSettingsBaseSPtr settings, connectionTypes type);
@@ -39,6 +42,19 @@ namespace fastonosql
 
         void start();
         void stop();
+        // events run in order on the shared drivers pool
+        void post(QEvent* ev);
+        // streams (monitor, subscribe) read connections of their own on a strand
+        // of their own, the command connection stays usable meanwhile
+        void postStream(QEvent* ev);
+        void stopStream();
+        // short polls of server state, on the monitoring connection where there is one
+        void postMonitoring(QEvent* ev);
+        // queues an info snapshot unless one is still waiting
+        void schedulePoll();
+        // info is polled for the history log and for every watcher, at the shortest interval
+        void watchInfo(int msec);
+        void unwatchInfo(int msec);
         common::Error commandByType(CommandKeySPtr command, std::string& cmdstring) const WARN_UNUSED_RESULT;
 
         virtual void interrupt();
@@ -48,17 +64,18 @@ namespace fastonosql
         virtual std::string outputDelemitr() const = 0;        
 
     Q_SIGNALS:
-        void addedChild(FastoObject* child);
-        void itemUpdated(FastoObject* item, common::Value* val);
+        void childrenAdded(const FastoObject::child_batch_type& childrens);
+        void itemUpdated(FastoObject* item);
         void serverInfoSnapShoot(ServerInfoSnapShoot shot);
+        void monitorSnapShot(MonitorSnapShot shot);
+        void keyspaceSnapShot(KeyspaceSnapShot shot);
 
     private Q_SLOTS:
-        void init();
-        void clear();
+        // emits the batches in the order they were cut, on the thread of the driver
+        void deliverChildren();
 
     protected:
         virtual void customEvent(QEvent *event);
-        virtual void timerEvent(QTimerEvent* event);        
 
         void notifyProgress(QObject *reciver, int value);
 
@@ -75,6 +92,12 @@ namespace fastonosql
         virtual void handleExportEvent(events::ExportRequestEvent* ev);
         virtual void handleChangePasswordEvent(events::ChangePasswordRequestEvent* ev);
         virtual void handleChangeMaxConnectionEvent(events::ChangeMaxConnectionRequestEvent* ev);
+        virtual void handleMonitorEvent(events::MonitorRequestEvent* ev);
+        virtual void handlePubSubEvent(events::PubSubRequestEvent* ev);
+        virtual void handleSlowLogEvent(events::SlowLogRequestEvent* ev);
+        virtual void handleClientListEvent(events::ClientListRequestEvent* ev);
+        virtual void handleClientKillEvent(events::ClientKillRequestEvent* ev);
+        virtual void handleKeyspaceEvent(events::KeyspaceRequestEvent* ev);
 
         // handle database events
         virtual void handleLoadDatabaseInfosEvent(events::LoadDatabasesInfoRequestEvent* ev) = 0;
@@ -85,7 +108,8 @@ namespace fastonosql
         virtual void handleCommandRequestEvent(events::CommandRequestEvent* ev) = 0;
 
         const IConnectionSettingsBaseSPtr settings_;
-        bool interrupt_;
+        QAtomicInt interrupt_;
+        QAtomicInt streamStop_;
 
         class RootLocker
         {
@@ -109,6 +133,10 @@ namespace fastonosql
         }
 
         void setCurrentDatabaseInfo(DataBaseInfo* inf);
+        // logs a window of latency samples next to the info history
+        void addLatencyHistory(common::time64_t msec, const LatencyHistogram& window);
+        // queues the buffered children for the gui in one batch, from any thread
+        void flushChildren();
 
         common::Error execute(FastoObjectCommand* cmd) WARN_UNUSED_RESULT;
 
@@ -120,16 +148,38 @@ namespace fastonosql
         void handleDiscoveryInfoRequestEvent(events::DiscoveryInfoRequestEvent* ev);
 
         void handleClearServerHistoryRequestEvent(events::ClearServerHistoryRequestEvent *ev);
+        void handleBenchmarkRequestEvent(events::BenchmarkRequestEvent *ev);
+
+        void init();
+        void updatePolling();
+        void pollServerInfo();
+        InfoHistoryStore* history();
+        InfoHistoryStore* latencyHistory();
+        void importTextHistory();
+
+        // walks the keyspace with scanValues and streams matching keys back
+        void handleSearchValuesEvent(events::LoadDatabaseContentRequestEvent* ev);
 
         // notification of execute events
         virtual void addedChildren(FastoObject *child);
-        virtual void updated(FastoObject* item, common::Value* val);
+        virtual void updated(FastoObject* item);
 
         // internal methods
         virtual ServerInfoSPtr makeServerInfoFromString(const std::string& val) = 0;
         virtual common::Error serverInfo(ServerInfo** info) = 0;
         virtual common::Error serverDiscoveryInfo(ServerInfo** sinfo, ServerDiscoveryInfo** dinfo, DataBaseInfo** dbinfo) = 0;
         virtual common::Error currentDataBaseInfo(DataBaseInfo** info) = 0;
+        // info sampling on a connection of its own, run on the monitoring strand;
+        // drivers without one are polled on the command strand with serverInfo
+        virtual bool hasMonitoringConnection() const;
+        virtual common::Error monitoringServerInfo(ServerInfo** info);
+        // next batch of string keys narrowed by the filter prefix (or glob) with their values,
+        // empty cursor starts the walk, empty next ends it
+        virtual common::Error scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                         std::vector<std::string>* keys, std::vector<std::string>* values,
+                                         std::string* next) = 0;
+        // a client for one benchmark thread, see BenchmarkClient
+        virtual common::Error createBenchmarkClient(BenchmarkClient** client) = 0;
         virtual void initImpl() = 0;
         virtual void clearImpl() = 0;
 
@@ -146,9 +196,20 @@ namespace fastonosql
         ServerDiscoveryInfoSPtr serverDiscInfo_;
         DataBaseInfoSPtr currentDatabaseInfo_;
 
-        QThread* thread_;
-        int timer_info_id_;
-        common::file_system::File* log_file_;
+        DriverStrand* strand_;
+        DriverStrand* monitoringStrand_;
+        DriverStrand* streamStrand_;
+        QAtomicInt pollPending_;
+        std::multiset<int> watches_;
+        InfoHistoryStore* history_;
+        InfoHistoryStore* latencyHistory_;
+        QMutex history_lock_;
         const connectionTypes type_;
+
+        FastoObject::child_batch_type pendingChildren_;
+        std::deque<FastoObject::child_batch_type> readyChildren_;
+        common::time64_t pendingSince_;
+        QMutex children_lock_;
+        QTimer* flushTimer_;
     };
 }
@@ -0,0 +1,1231 @@
+#include "core/info_history_store.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+
+#include <QDir>
+#include <QFile>
+
+#include "common/qt/convert_string.h"
+#include "common/sprintf.h"
+
+#define HISTORY_SEGMENT_MAGIC "FNS1"
+#define HISTORY_JOURNAL_MAGIC "FNJ1"
+#define HISTORY_MAGIC_SIZE 4
+#define HISTORY_SEGMENT_SAMPLES 3600
+#define HISTORY_SEGMENT_MSEC (60 * 60 * 1000)
+#define HISTORY_SEGMENT_EXTENSION ".seg"
+#define HISTORY_JOURNAL_NAME "head.jrn"
+
+#define HISTORY_MINUTE_MSEC (60 * 1000)
+#define HISTORY_HOUR_MSEC (60 * 60 * 1000)
+#define HISTORY_MINUTES_NAME "1m"
+#define HISTORY_HOURS_NAME "1h"
+#define HISTORY_MINUTES_SEGMENT_ROWS 1440 // a day
+#define HISTORY_HOURS_SEGMENT_ROWS 720 // a month
+#define HISTORY_MINUTES_RETENTION_MSEC (90LL * 24 * 60 * 60 * 1000)
+#define HISTORY_HOURS_RETENTION_MSEC (2 * 365LL * 24 * 60 * 60 * 1000)
+
+// magic, samples count, first and last time, columns count, time column size
+#define SEGMENT_HEADER_SIZE 30
+// column id, flags, offset and size of the column data
+#define SEGMENT_INDEX_ENTRY_SIZE 11
+
+namespace fastonosql
+{
+    namespace
+    {
+        enum ColumnFlags
+        {
+            COLUMN_INTEGER = 1,
+            COLUMN_DOUBLE = 2,
+            COLUMN_SPARSE = 4 // presence bitmap in front of the values
+        };
+
+        const double missingValue = std::numeric_limits<double>::quiet_NaN();
+        const double maxExactInteger = 9007199254740992.0; // 2^53
+
+        void putFixed(std::string* out, uint64_t v, int size)
+        {
+            for(int i = 0; i < size; ++i){
+                out->push_back(static_cast<char>(v >> (i * 8)));
+            }
+        }
+
+        uint64_t getFixed(const char* data, int size)
+        {
+            uint64_t v = 0;
+            for(int i = 0; i < size; ++i){
+                v |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (i * 8);
+            }
+            return v;
+        }
+
+        void putVarint(std::string* out, uint64_t v)
+        {
+            while(v >= 0x80){
+                out->push_back(static_cast<char>(v | 0x80));
+                v >>= 7;
+            }
+            out->push_back(static_cast<char>(v));
+        }
+
+        bool getVarint(const char** p, const char* end, uint64_t* v)
+        {
+            uint64_t result = 0;
+            for(int shift = 0; shift < 64 && *p < end; shift += 7){
+                unsigned char byte = **p;
+                ++(*p);
+                result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if(!(byte & 0x80)){
+                    *v = result;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        uint64_t zigzag(int64_t v)
+        {
+            return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+        }
+
+        int64_t unzigzag(uint64_t v)
+        {
+            return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+        }
+
+        uint64_t doubleToBits(double v)
+        {
+            uint64_t bits;
+            memcpy(&bits, &v, sizeof(bits));
+            return bits;
+        }
+
+        double bitsToDouble(uint64_t bits)
+        {
+            double v;
+            memcpy(&v, &bits, sizeof(v));
+            return v;
+        }
+
+        bool isMissing(double v)
+        {
+            return v != v;
+        }
+
+        bool isExactInteger(double v)
+        {
+            return floor(v) == v && fabs(v) < maxExactInteger;
+        }
+
+        bool inRange(common::time64_t msec, common::time64_t from, common::time64_t to)
+        {
+            return (!from || msec >= from) && (!to || msec <= to);
+        }
+
+        // regular sampling makes the delta of deltas zero, one byte per sample
+        std::string encodeTimes(const std::vector<common::time64_t>& times)
+        {
+            std::string out;
+            common::time64_t prev = times.empty() ? 0 : times[0];
+            int64_t prevDelta = 0;
+            for(size_t i = 0; i < times.size(); ++i){
+                int64_t delta = times[i] - prev;
+                putVarint(&out, zigzag(delta - prevDelta));
+                prev = times[i];
+                prevDelta = delta;
+            }
+            return out;
+        }
+
+        bool decodeTimes(const char* data, size_t size, common::time64_t first, uint32_t count,
+                         std::vector<common::time64_t>* times)
+        {
+            const char* p = data;
+            const char* end = data + size;
+            times->resize(count);
+            common::time64_t prev = first;
+            int64_t prevDelta = 0;
+            for(uint32_t i = 0; i < count; ++i){
+                uint64_t v = 0;
+                if(!getVarint(&p, end, &v)){
+                    return false;
+                }
+                int64_t delta = prevDelta + unzigzag(v);
+                prev += delta;
+                (*times)[i] = prev;
+                prevDelta = delta;
+            }
+            return true;
+        }
+
+        // counters are integers and grow slowly, gauges with a fraction keep
+        // their high bits between samples, so xor leaves a short varint
+        std::string encodeColumn(const std::vector<double>& values, uint8_t* flags)
+        {
+            bool sparse = false, integer = true;
+            for(size_t i = 0; i < values.size(); ++i){
+                if(isMissing(values[i])){
+                    sparse = true;
+                }
+                else if(!isExactInteger(values[i])){
+                    integer = false;
+                }
+            }
+
+            *flags = (integer ? COLUMN_INTEGER : COLUMN_DOUBLE) | (sparse ? COLUMN_SPARSE : 0);
+
+            std::string out;
+            if(sparse){
+                out.assign((values.size() + 7) / 8, '\0');
+                for(size_t i = 0; i < values.size(); ++i){
+                    if(!isMissing(values[i])){
+                        out[i / 8] |= static_cast<char>(1 << (i % 8));
+                    }
+                }
+            }
+
+            int64_t prev = 0;
+            uint64_t prevBits = 0;
+            for(size_t i = 0; i < values.size(); ++i){
+                if(isMissing(values[i])){
+                    continue;
+                }
+
+                if(integer){
+                    int64_t cur = static_cast<int64_t>(values[i]);
+                    putVarint(&out, zigzag(cur - prev));
+                    prev = cur;
+                }
+                else{
+                    uint64_t bits = doubleToBits(values[i]);
+                    putVarint(&out, bits ^ prevBits);
+                    prevBits = bits;
+                }
+            }
+            return out;
+        }
+
+        bool decodeColumn(const char* data, size_t size, uint8_t flags, uint32_t count, std::vector<double>* values)
+        {
+            const char* p = data;
+            const char* end = data + size;
+            const char* bitmap = NULL;
+            if(flags & COLUMN_SPARSE){
+                size_t bsize = (count + 7) / 8;
+                if(size < bsize){
+                    return false;
+                }
+                bitmap = p;
+                p += bsize;
+            }
+
+            values->assign(count, missingValue);
+            int64_t prev = 0;
+            uint64_t prevBits = 0;
+            for(uint32_t i = 0; i < count; ++i){
+                if(bitmap && !(bitmap[i / 8] & (1 << (i % 8)))){
+                    continue;
+                }
+
+                uint64_t v = 0;
+                if(!getVarint(&p, end, &v)){
+                    return false;
+                }
+
+                if(flags & COLUMN_INTEGER){
+                    prev += unzigzag(v);
+                    (*values)[i] = static_cast<double>(prev);
+                }
+                else{
+                    prevBits ^= v;
+                    (*values)[i] = bitsToDouble(prevBits);
+                }
+            }
+            return true;
+        }
+
+        QString segmentName(common::time64_t first, common::time64_t last)
+        {
+            char buff[64] = {0};
+            common::SNPrintf(buff, sizeof(buff), "%020lld-%020lld" HISTORY_SEGMENT_EXTENSION,
+                             static_cast<long long>(first), static_cast<long long>(last));
+            return QString::fromLatin1(buff);
+        }
+
+        bool parseSegmentName(const QString& name, common::time64_t* first, common::time64_t* last)
+        {
+            long long f = 0, l = 0;
+            if(sscanf(name.toLatin1().constData(), "%lld-%lld", &f, &l) != 2){
+                return false;
+            }
+
+            *first = f;
+            *last = l;
+            return true;
+        }
+
+        QStringList segmentNames(const QDir& dir)
+        {
+            return dir.entryList(QStringList() << "*" HISTORY_SEGMENT_EXTENSION, QDir::Files, QDir::Name);
+        }
+
+        bool readRange(QFile* file, qint64 offset, qint64 size, QByteArray* out)
+        {
+            if(!file->seek(offset)){
+                return false;
+            }
+
+            *out = file->read(size);
+            return out->size() == size;
+        }
+
+        common::Error invalidSegment(const QString& path)
+        {
+            char buff[1024] = {0};
+            common::SNPrintf(buff, sizeof(buff), "Invalid history segment %s", common::convertToString(path).c_str());
+            return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+        }
+
+        // header, column index and time column of a segment
+        common::Error readSegmentHead(QFile* file, const QString& path, QByteArray* index, std::vector<common::time64_t>* times)
+        {
+            QByteArray header = file->read(SEGMENT_HEADER_SIZE);
+            if(header.size() != SEGMENT_HEADER_SIZE || memcmp(header.constData(), HISTORY_SEGMENT_MAGIC, HISTORY_MAGIC_SIZE) != 0){
+                return invalidSegment(path);
+            }
+
+            const char* h = header.constData() + HISTORY_MAGIC_SIZE;
+            uint32_t count = getFixed(h, 4);
+            common::time64_t first = getFixed(h + 4, 8);
+            uint16_t ncols = getFixed(h + 20, 2);
+            uint32_t timesSize = getFixed(h + 22, 4);
+
+            *index = file->read(ncols * SEGMENT_INDEX_ENTRY_SIZE);
+            if(index->size() != ncols * SEGMENT_INDEX_ENTRY_SIZE){
+                return invalidSegment(path);
+            }
+
+            QByteArray timesData;
+            if(!readRange(file, SEGMENT_HEADER_SIZE + index->size(), timesSize, &timesData) ||
+               !decodeTimes(timesData.constData(), timesData.size(), first, count, times)){
+                return invalidSegment(path);
+            }
+            return common::Error();
+        }
+
+        // values of column id, all missing if the field appeared in a later version
+        common::Error readSegmentColumn(QFile* file, const QString& path, const QByteArray& index, uint16_t id,
+                                        uint32_t count, std::vector<double>* values)
+        {
+            for(int i = 0; i < index.size(); i += SEGMENT_INDEX_ENTRY_SIZE){
+                const char* e = index.constData() + i;
+                if(getFixed(e, 2) != id){
+                    continue;
+                }
+
+                QByteArray columnData;
+                if(!readRange(file, getFixed(e + 3, 4), getFixed(e + 7, 4), &columnData) ||
+                   !decodeColumn(columnData.constData(), columnData.size(), getFixed(e + 2, 1), count, values)){
+                    return invalidSegment(path);
+                }
+                return common::Error();
+            }
+
+            values->assign(count, missingValue);
+            return common::Error();
+        }
+
+        common::Error readSegment(const QString& path, uint16_t id, common::time64_t from, common::time64_t to,
+                                  InfoHistoryStore::points_container_type* out)
+        {
+            QFile file(path);
+            if(!file.open(QIODevice::ReadOnly)){
+                return invalidSegment(path);
+            }
+
+            QByteArray index;
+            std::vector<common::time64_t> times;
+            common::Error er = readSegmentHead(&file, path, &index, &times);
+            if(er && er->isError()){
+                return er;
+            }
+
+            std::vector<double> values;
+            er = readSegmentColumn(&file, path, index, id, times.size(), &values);
+            if(er && er->isError()){
+                return er;
+            }
+
+            for(size_t i = 0; i < times.size(); ++i){
+                if(!isMissing(values[i]) && inRange(times[i], from, to)){
+                    out->push_back(std::make_pair(times[i], values[i]));
+                }
+            }
+            return common::Error();
+        }
+    }
+
+    // one resolution of the history: sealed segments in a directory and the
+    // journal of the open one
+    class InfoHistoryStore::Series
+    {
+    public:
+        Series(const std::string& path, const std::vector<uint16_t>& columns, size_t segmentRows,
+               common::time64_t segmentMsec, common::time64_t retentionMsec);
+        ~Series();
+
+        common::Error open();
+        common::Error append(common::time64_t msec, const std::vector<double>& values);
+        common::Error read(uint16_t id, common::time64_t from, common::time64_t to, points_container_type* out);
+        // every column of the samples from msec on, sealed ones included
+        common::Error readRows(common::time64_t from, std::vector<common::time64_t>* times,
+                               std::vector< std::vector<double> >* rows);
+        common::Error clear();
+
+        common::time64_t first() const;
+        common::time64_t last() const;
+
+        const std::vector<common::time64_t>& headTimes() const;
+
+    private:
+        struct Head
+        {
+            std::vector<uint16_t> ids_;
+            std::vector<common::time64_t> times_;
+            std::vector< std::vector<double> > values_; // per column, NaN if missing
+        };
+
+        common::Error openJournal(bool truncate);
+        common::Error loadJournal();
+        common::Error seal(const Head& head);
+        void resetHead();
+        void applyRetention(common::time64_t now);
+
+        const std::string path_;
+        const std::vector<uint16_t> columns_;
+        const size_t segmentRows_;
+        const common::time64_t segmentMsec_;
+        const common::time64_t retentionMsec_;
+
+        QFile* journal_;
+        Head head_;
+        common::time64_t last_;
+    };
+
+    // min, max and average of every field over buckets of width_
+    struct InfoHistoryStore::Rollup
+    {
+        Rollup(const std::string& path, const std::vector<uint16_t>& columns, common::time64_t width,
+               size_t segmentRows, common::time64_t retentionMsec);
+        ~Rollup();
+
+        common::Error add(common::time64_t msec, const std::vector<double>& values);
+        common::Error flush();
+        void reset();
+
+        const common::time64_t width_;
+        const size_t ncols_;
+        Series* series_[STAT_COUNT];
+
+        common::time64_t bucket_; // start of the open bucket, -1 if none
+        common::time64_t time_; // its first sample, the time of its row
+        std::vector<double> min_;
+        std::vector<double> max_;
+        std::vector<double> sum_;
+        std::vector<uint32_t> count_;
+    };
+
+    InfoHistoryStore::Series::Series(const std::string& path, const std::vector<uint16_t>& columns, size_t segmentRows,
+                                     common::time64_t segmentMsec, common::time64_t retentionMsec)
+        : path_(path), columns_(columns), segmentRows_(segmentRows), segmentMsec_(segmentMsec), retentionMsec_(retentionMsec),
+          journal_(NULL), head_(), last_(0)
+    {
+        resetHead();
+    }
+
+    InfoHistoryStore::Series::~Series()
+    {
+        delete journal_;
+        journal_ = NULL;
+    }
+
+    common::Error InfoHistoryStore::Series::open()
+    {
+        QDir dir(common::convertFromString<QString>(path_));
+        if(!dir.mkpath(".")){
+            char buff[1024] = {0};
+            common::SNPrintf(buff, sizeof(buff), "Can't create history directory %s", path_.c_str());
+            return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+        }
+
+        common::Error er = loadJournal();
+        if(er && er->isError()){
+            return er;
+        }
+
+        QStringList names = segmentNames(dir);
+        for(int i = 0; i < names.size(); ++i){
+            common::time64_t first = 0, last = 0;
+            if(parseSegmentName(names[i], &first, &last) && last > last_){
+                last_ = last;
+            }
+        }
+
+        if(!head_.times_.empty() && head_.times_.back() > last_){
+            last_ = head_.times_.back();
+        }
+        return common::Error();
+    }
+
+    common::Error InfoHistoryStore::Series::append(common::time64_t msec, const std::vector<double>& values)
+    {
+        if(msec <= last_){
+            return common::make_error_value("History sample is older than the last stored one", common::ErrorValue::E_ERROR);
+        }
+
+        const size_t ncols = head_.ids_.size();
+        std::string row;
+        putFixed(&row, 8 + ncols * 8, 4);
+        putFixed(&row, msec, 8);
+        head_.times_.push_back(msec);
+        for(size_t i = 0; i < ncols; ++i){
+            head_.values_[i].push_back(values[i]);
+            putFixed(&row, doubleToBits(values[i]), 8);
+        }
+        last_ = msec;
+
+        if(journal_->write(row.data(), row.size()) != static_cast<qint64>(row.size()) || !journal_->flush()){
+            return common::make_error_value("Can't write history journal", common::ErrorValue::E_ERROR);
+        }
+
+        if(head_.times_.size() < segmentRows_ && msec - head_.times_.front() < segmentMsec_){
+            return common::Error();
+        }
+
+        common::Error er = seal(head_);
+        if(er && er->isError()){
+            return er;
+        }
+
+        applyRetention(msec);
+        return openJournal(true);
+    }
+
+    common::Error InfoHistoryStore::Series::read(uint16_t id, common::time64_t from, common::time64_t to, points_container_type* out)
+    {
+        QDir dir(common::convertFromString<QString>(path_));
+        QStringList names = segmentNames(dir);
+        for(int i = 0; i < names.size(); ++i){
+            common::time64_t first = 0, last = 0;
+            if(!parseSegmentName(names[i], &first, &last)){
+                continue;
+            }
+
+            if((to && first > to) || (from && last < from)){
+                continue;
+            }
+
+            common::Error er = readSegment(dir.filePath(names[i]), id, from, to, out);
+            if(er && er->isError()){
+                return er;
+            }
+        }
+
+        for(size_t i = 0; i < head_.ids_.size(); ++i){
+            if(head_.ids_[i] != id){
+                continue;
+            }
+
+            const std::vector<double>& values = head_.values_[i];
+            for(size_t j = 0; j < head_.times_.size(); ++j){
+                if(!isMissing(values[j]) && inRange(head_.times_[j], from, to)){
+                    out->push_back(std::make_pair(head_.times_[j], values[j]));
+                }
+            }
+            break;
+        }
+
+        return common::Error();
+    }
+
+    common::Error InfoHistoryStore::Series::readRows(common::time64_t from, std::vector<common::time64_t>* times,
+                                                     std::vector< std::vector<double> >* rows)
+    {
+        QDir dir(common::convertFromString<QString>(path_));
+        QStringList names = segmentNames(dir);
+        for(int i = 0; i < names.size(); ++i){
+            common::time64_t first = 0, last = 0;
+            if(!parseSegmentName(names[i], &first, &last) || last < from){
+                continue;
+            }
+
+            const QString path = dir.filePath(names[i]);
+            QFile file(path);
+            if(!file.open(QIODevice::ReadOnly)){
+                return invalidSegment(path);
+            }
+
+            QByteArray index;
+            std::vector<common::time64_t> stimes;
+            common::Error er = readSegmentHead(&file, path, &index, &stimes);
+            if(er && er->isError()){
+                return er;
+            }
+
+            std::vector< std::vector<double> > columns(columns_.size());
+            for(size_t j = 0; j < columns_.size(); ++j){
+                er = readSegmentColumn(&file, path, index, columns_[j], stimes.size(), &columns[j]);
+                if(er && er->isError()){
+                    return er;
+                }
+            }
+
+            for(size_t j = 0; j < stimes.size(); ++j){
+                if(stimes[j] < from){
+                    continue;
+                }
+
+                times->push_back(stimes[j]);
+                rows->push_back(std::vector<double>(columns_.size()));
+                for(size_t k = 0; k < columns_.size(); ++k){
+                    rows->back()[k] = columns[k][j];
+                }
+            }
+        }
+
+        for(size_t j = 0; j < head_.times_.size(); ++j){
+            if(head_.times_[j] < from){
+                continue;
+            }
+
+            times->push_back(head_.times_[j]);
+            rows->push_back(std::vector<double>(head_.ids_.size()));
+            for(size_t k = 0; k < head_.ids_.size(); ++k){
+                rows->back()[k] = head_.values_[k][j];
+            }
+        }
+        return common::Error();
+    }
+
+    common::Error InfoHistoryStore::Series::clear()
+    {
+        QDir dir(common::convertFromString<QString>(path_));
+        QStringList names = segmentNames(dir);
+        for(int i = 0; i < names.size(); ++i){
+            if(!dir.remove(names[i])){
+                return common::make_error_value("Can't remove history segment", common::ErrorValue::E_ERROR);
+            }
+        }
+
+        last_ = 0;
+        if(!journal_){
+            dir.remove(HISTORY_JOURNAL_NAME);
+            return common::Error();
+        }
+
+        return openJournal(true);
+    }
+
+    common::time64_t InfoHistoryStore::Series::first() const
+    {
+        QStringList names = segmentNames(QDir(common::convertFromString<QString>(path_)));
+        for(int i = 0; i < names.size(); ++i){
+            common::time64_t first = 0, last = 0;
+            if(parseSegmentName(names[i], &first, &last)){
+                return first;
+            }
+        }
+
+        return head_.times_.empty() ? 0 : head_.times_.front();
+    }
+
+    common::time64_t InfoHistoryStore::Series::last() const
+    {
+        return last_;
+    }
+
+    const std::vector<common::time64_t>& InfoHistoryStore::Series::headTimes() const
+    {
+        return head_.times_;
+    }
+
+    // restarts the journal from an empty head of the current columns
+    common::Error InfoHistoryStore::Series::openJournal(bool truncate)
+    {
+        if(truncate){
+            resetHead();
+        }
+
+        delete journal_;
+        QDir dir(common::convertFromString<QString>(path_));
+        journal_ = new QFile(dir.filePath(HISTORY_JOURNAL_NAME));
+        QIODevice::OpenMode mode = truncate ? QIODevice::WriteOnly | QIODevice::Truncate : QIODevice::WriteOnly | QIODevice::Append;
+        if(!journal_->open(mode)){
+            return common::make_error_value("Can't open history journal", common::ErrorValue::E_ERROR);
+        }
+
+        if(!truncate){
+            return common::Error();
+        }
+
+        std::string header(HISTORY_JOURNAL_MAGIC, HISTORY_MAGIC_SIZE);
+        putFixed(&header, head_.ids_.size(), 2);
+        for(size_t i = 0; i < head_.ids_.size(); ++i){
+            putFixed(&header, head_.ids_[i], 2);
+        }
+
+        if(journal_->write(header.data(), header.size()) != static_cast<qint64>(header.size()) || !journal_->flush()){
+            return common::make_error_value("Can't write history journal", common::ErrorValue::E_ERROR);
+        }
+        return common::Error();
+    }
+
+    // samples of the open segment, a torn last row is cut off and a journal
+    // of other columns (older version) is sealed as it is
+    common::Error InfoHistoryStore::Series::loadJournal()
+    {
+        QDir dir(common::convertFromString<QString>(path_));
+        QFile file(dir.filePath(HISTORY_JOURNAL_NAME));
+        if(!file.open(QIODevice::ReadOnly)){
+            return openJournal(true);
+        }
+
+        QByteArray data = file.readAll();
+        file.close();
+
+        Head head;
+        int good = 0;
+        const char* p = data.constData();
+        if(data.size() >= HISTORY_MAGIC_SIZE + 2 && memcmp(p, HISTORY_JOURNAL_MAGIC, HISTORY_MAGIC_SIZE) == 0){
+            int pos = HISTORY_MAGIC_SIZE;
+            size_t ncols = getFixed(p + pos, 2);
+            pos += 2;
+            if(data.size() >= static_cast<int>(pos + ncols * 2)){
+                for(size_t i = 0; i < ncols; ++i, pos += 2){
+                    head.ids_.push_back(getFixed(p + pos, 2));
+                }
+                head.values_.resize(ncols);
+                good = pos;
+
+                const uint32_t rowSize = 8 + ncols * 8;
+                while(pos + 4 + rowSize <= static_cast<uint32_t>(data.size()) && getFixed(p + pos, 4) == rowSize){
+                    pos += 4;
+                    head.times_.push_back(getFixed(p + pos, 8));
+                    pos += 8;
+                    for(size_t i = 0; i < ncols; ++i, pos += 8){
+                        head.values_[i].push_back(bitsToDouble(getFixed(p + pos, 8)));
+                    }
+                    good = pos;
+                }
+            }
+        }
+
+        if(good && head.ids_ == columns_){
+            head_ = head;
+            if(good < data.size() && !file.resize(good)){
+                return common::make_error_value("Can't repair history journal", common::ErrorValue::E_ERROR);
+            }
+            return openJournal(false);
+        }
+
+        if(!head.times_.empty()){
+            common::Error er = seal(head);
+            if(er && er->isError()){
+                return er;
+            }
+        }
+
+        return openJournal(true);
+    }
+
+    common::Error InfoHistoryStore::Series::seal(const Head& head)
+    {
+        if(head.times_.empty()){
+            return common::Error();
+        }
+
+        const size_t ncols = head.ids_.size();
+        const std::string times = encodeTimes(head.times_);
+        std::string index, columns;
+        uint32_t offset = SEGMENT_HEADER_SIZE + ncols * SEGMENT_INDEX_ENTRY_SIZE + times.size();
+        for(size_t i = 0; i < ncols; ++i){
+            uint8_t flags = 0;
+            std::string column = encodeColumn(head.values_[i], &flags);
+            putFixed(&index, head.ids_[i], 2);
+            putFixed(&index, flags, 1);
+            putFixed(&index, offset, 4);
+            putFixed(&index, column.size(), 4);
+            offset += column.size();
+            columns += column;
+        }
+
+        const common::time64_t first = head.times_.front();
+        const common::time64_t last = head.times_.back();
+        std::string segment(HISTORY_SEGMENT_MAGIC, HISTORY_MAGIC_SIZE);
+        putFixed(&segment, head.times_.size(), 4);
+        putFixed(&segment, first, 8);
+        putFixed(&segment, last, 8);
+        putFixed(&segment, ncols, 2);
+        putFixed(&segment, times.size(), 4);
+        segment += index;
+        segment += times;
+        segment += columns;
+
+        QDir dir(common::convertFromString<QString>(path_));
+        const QString name = dir.filePath(segmentName(first, last));
+        const QString tmp = name + ".tmp";
+        QFile file(tmp);
+        bool written = file.open(QIODevice::WriteOnly | QIODevice::Truncate) &&
+                file.write(segment.data(), segment.size()) == static_cast<qint64>(segment.size()) && file.flush();
+        file.close();
+
+        QFile::remove(name);
+        if(!written || !QFile::rename(tmp, name)){
+            QFile::remove(tmp);
+            return common::make_error_value("Can't write history segment", common::ErrorValue::E_ERROR);
+        }
+        return common::Error();
+    }
+
+    void InfoHistoryStore::Series::resetHead()
+    {
+        head_.ids_ = columns_;
+        head_.times_.clear();
+        head_.values_.assign(columns_.size(), std::vector<double>());
+    }
+
+    void InfoHistoryStore::Series::applyRetention(common::time64_t now)
+    {
+        if(retentionMsec_ <= 0){
+            return;
+        }
+
+        const common::time64_t cutoff = now - retentionMsec_;
+        QDir dir(common::convertFromString<QString>(path_));
+        QStringList names = segmentNames(dir);
+        for(int i = 0; i < names.size(); ++i){
+            common::time64_t first = 0, last = 0;
+            if(!parseSegmentName(names[i], &first, &last)){
+                continue;
+            }
+
+            if(first > cutoff){
+                break;
+            }
+
+            if(last < cutoff){
+                dir.remove(names[i]);
+            }
+        }
+    }
+
+    InfoHistoryStore::Rollup::Rollup(const std::string& path, const std::vector<uint16_t>& columns, common::time64_t width,
+                                     size_t segmentRows, common::time64_t retentionMsec)
+        : width_(width), ncols_(columns.size()), bucket_(-1), time_(0), min_(), max_(), sum_(), count_()
+    {
+        const char* stats[STAT_COUNT] = { "avg", "min", "max" };
+        for(int i = 0; i < STAT_COUNT; ++i){
+            series_[i] = new Series(path + "-" + stats[i], columns, segmentRows, segmentRows * width_, retentionMsec);
+        }
+        reset();
+    }
+
+    InfoHistoryStore::Rollup::~Rollup()
+    {
+        for(int i = 0; i < STAT_COUNT; ++i){
+            delete series_[i];
+            series_[i] = NULL;
+        }
+    }
+
+    common::Error InfoHistoryStore::Rollup::add(common::time64_t msec, const std::vector<double>& values)
+    {
+        const common::time64_t bucket = msec - msec % width_;
+        if(bucket != bucket_){
+            common::Error er = flush();
+            if(er && er->isError()){
+                return er;
+            }
+            bucket_ = bucket;
+            time_ = msec;
+        }
+
+        for(size_t i = 0; i < values.size(); ++i){
+            const double v = values[i];
+            if(isMissing(v)){
+                continue;
+            }
+
+            if(!count_[i] || v < min_[i]){
+                min_[i] = v;
+            }
+            if(!count_[i] || v > max_[i]){
+                max_[i] = v;
+            }
+            sum_[i] += v;
+            ++count_[i];
+        }
+        return common::Error();
+    }
+
+    // closes the open bucket, it is written as a row at the time of its first
+    // sample, so a tier starts where the raw samples do
+    common::Error InfoHistoryStore::Rollup::flush()
+    {
+        if(bucket_ < 0){
+            return common::Error();
+        }
+
+        std::vector<double> rows[STAT_COUNT];
+        for(int i = 0; i < STAT_COUNT; ++i){
+            rows[i].assign(count_.size(), missingValue);
+        }
+
+        for(size_t i = 0; i < count_.size(); ++i){
+            if(count_[i]){
+                rows[STAT_AVG][i] = sum_[i] / count_[i];
+                rows[STAT_MIN][i] = min_[i];
+                rows[STAT_MAX][i] = max_[i];
+            }
+        }
+
+        const common::time64_t time = time_;
+        reset();
+        for(int i = 0; i < STAT_COUNT; ++i){
+            common::Error er = series_[i]->append(time, rows[i]);
+            if(er && er->isError()){
+                return er;
+            }
+        }
+        return common::Error();
+    }
+
+    void InfoHistoryStore::Rollup::reset()
+    {
+        bucket_ = -1;
+        time_ = 0;
+        min_.assign(ncols_, 0);
+        max_.assign(ncols_, 0);
+        sum_.assign(ncols_, 0);
+        count_.assign(ncols_, 0);
+    }
+
+    InfoHistoryStore::InfoHistoryStore(const std::string& path, connectionTypes type, common::time64_t retentionMsec)
+        : path_(path), columns_(), lock_(), opened_(false), raw_(NULL), rollups_()
+    {
+        init(infoFieldsFromType(type), retentionMsec);
+    }
+
+    InfoHistoryStore::InfoHistoryStore(const std::string& path, const std::vector< std::vector<Field> >& fields, common::time64_t retentionMsec)
+        : path_(path), columns_(), lock_(), opened_(false), raw_(NULL), rollups_()
+    {
+        init(fields, retentionMsec);
+    }
+
+    void InfoHistoryStore::init(const std::vector< std::vector<Field> >& fields, common::time64_t retentionMsec)
+    {
+        for(size_t i = 0; i < fields.size(); ++i){
+            for(size_t j = 0; j < fields[i].size(); ++j){
+                if(fields[i][j].isIntegral()){
+                    columns_.push_back(columnId(static_cast<unsigned char>(i), static_cast<unsigned char>(j)));
+                }
+            }
+        }
+
+        QDir dir(common::convertFromString<QString>(path_));
+        raw_ = new Series(path_, columns_, HISTORY_SEGMENT_SAMPLES, HISTORY_SEGMENT_MSEC, retentionMsec);
+        rollups_.push_back(new Rollup(common::convertToString(dir.filePath(HISTORY_MINUTES_NAME)), columns_, HISTORY_MINUTE_MSEC,
+                                      HISTORY_MINUTES_SEGMENT_ROWS, HISTORY_MINUTES_RETENTION_MSEC));
+        rollups_.push_back(new Rollup(common::convertToString(dir.filePath(HISTORY_HOURS_NAME)), columns_, HISTORY_HOUR_MSEC,
+                                      HISTORY_HOURS_SEGMENT_ROWS, HISTORY_HOURS_RETENTION_MSEC));
+    }
+
+    InfoHistoryStore::~InfoHistoryStore()
+    {
+        for(size_t i = 0; i < rollups_.size(); ++i){
+            delete rollups_[i];
+        }
+        rollups_.clear();
+        delete raw_;
+        raw_ = NULL;
+    }
+
+    std::string InfoHistoryStore::path() const
+    {
+        return path_;
+    }
+
+    uint16_t InfoHistoryStore::columnId(unsigned char property, unsigned char field)
+    {
+        return (property << 8) | field;
+    }
+
+    common::Error InfoHistoryStore::append(common::time64_t msec, ServerInfo* info)
+    {
+        std::vector<double> values(columns_.size(), missingValue);
+        for(size_t i = 0; i < columns_.size(); ++i){
+            common::Value* value = info->valueByIndexes(columns_[i] >> 8, columns_[i] & 0xff); //allocate
+            if(value){
+                double d = 0;
+                if(value->getAsDouble(&d)){
+                    values[i] = d;
+                }
+                delete value;
+            }
+        }
+
+        return append(msec, values);
+    }
+
+    common::Error InfoHistoryStore::append(common::time64_t msec, const std::vector<double>& values)
+    {
+        if(values.size() != columns_.size()){
+            return common::make_error_value("Invalid history values count", common::ErrorValue::E_ERROR);
+        }
+
+        QMutexLocker lock(&lock_);
+        common::Error er = open();
+        if(er && er->isError()){
+            return er;
+        }
+
+        er = raw_->append(msec, values);
+        if(er && er->isError()){
+            return er;
+        }
+
+        for(size_t i = 0; i < rollups_.size(); ++i){
+            er = rollups_[i]->add(msec, values);
+            if(er && er->isError()){
+                return er;
+            }
+        }
+        return common::Error();
+    }
+
+    common::Error InfoHistoryStore::read(unsigned char property, unsigned char field, Stat stat, common::time64_t from, common::time64_t to,
+                                         size_t maxPoints, points_container_type* out, common::time64_t* resolution)
+    {
+        return read(property, std::vector<unsigned char>(1, field), stat, from, to, maxPoints, out, resolution);
+    }
+
+    common::Error InfoHistoryStore::read(unsigned char property, const std::vector<unsigned char>& fields, Stat stat, common::time64_t from,
+                                         common::time64_t to, size_t maxPoints, points_container_type* out, common::time64_t* resolution)
+    {
+        DCHECK(!fields.empty());
+        QMutexLocker lock(&lock_);
+        common::Error er = open();
+        if(er && er->isError()){
+            return er;
+        }
+
+        common::time64_t first = 0, last = 0;
+        boundsImpl(&first, &last);
+        const common::time64_t lo = std::max(from, first);
+        const common::time64_t hi = to ? to : last;
+        const common::time64_t span = hi > lo ? hi - lo : 0;
+
+        // the finest tier which has the start of the range, unless the next
+        // one still gives a point per pixel
+        const size_t tiers = rollups_.size() + 1;
+        Series* series = raw_;
+        *resolution = 0;
+        for(size_t i = 0; i < tiers; ++i){
+            Series* cur = i ? rollups_[i - 1]->series_[stat] : raw_;
+            const bool coarsest = i + 1 == tiers;
+            const bool covers = cur->first() && cur->first() <= lo;
+            const bool nextFills = !coarsest && maxPoints && static_cast<size_t>(span / rollups_[i]->width_) >= maxPoints;
+            if(coarsest || (covers && !nextFills)){
+                series = cur;
+                *resolution = i ? rollups_[i - 1]->width_ : 0;
+                break;
+            }
+        }
+
+        points_container_type points;
+        for(size_t i = 0; i < fields.size(); ++i){
+            points_container_type column;
+            er = series->read(columnId(property, fields[i]), from, to, &column);
+            if(er && er->isError()){
+                return er;
+            }
+
+            if(!i){
+                points.swap(column);
+                continue;
+            }
+
+            // columns of one series share the sample times, a missing value drops the sample
+            points_container_type sum;
+            size_t j = 0;
+            for(size_t k = 0; k < points.size() && j < column.size(); ++k){
+                while(j < column.size() && column[j].first < points[k].first){
+                    ++j;
+                }
+
+                if(j < column.size() && column[j].first == points[k].first){
+                    sum.push_back(InfoHistoryStore::point_type(points[k].first, points[k].second + column[j].second));
+                }
+            }
+            points.swap(sum);
+        }
+
+        if(maxPoints && points.size() > maxPoints){
+            *out = largestTriangleThreeBuckets(points, maxPoints);
+        }
+        else{
+            out->swap(points);
+        }
+        return common::Error();
+    }
+
+    common::Error InfoHistoryStore::bounds(common::time64_t* first, common::time64_t* last)
+    {
+        QMutexLocker lock(&lock_);
+        common::Error er = open();
+        if(er && er->isError()){
+            return er;
+        }
+
+        boundsImpl(first, last);
+        return common::Error();
+    }
+
+    common::Error InfoHistoryStore::clear()
+    {
+        QMutexLocker lock(&lock_);
+        common::Error er = raw_->clear();
+        if(er && er->isError()){
+            return er;
+        }
+
+        for(size_t i = 0; i < rollups_.size(); ++i){
+            rollups_[i]->reset();
+            for(int j = 0; j < STAT_COUNT; ++j){
+                er = rollups_[i]->series_[j]->clear();
+                if(er && er->isError()){
+                    return er;
+                }
+            }
+        }
+        return common::Error();
+    }
+
+    // the open buckets of the tiers are rebuilt from the raw samples after
+    // their last row, the raw journal may have been sealed within a bucket
+    common::Error InfoHistoryStore::open()
+    {
+        if(opened_){
+            return common::Error();
+        }
+
+        common::Error er = raw_->open();
+        if(er && er->isError()){
+            return er;
+        }
+
+        for(size_t i = 0; i < rollups_.size(); ++i){
+            Rollup* rollup = rollups_[i];
+            for(int j = 0; j < STAT_COUNT; ++j){
+                er = rollup->series_[j]->open();
+                if(er && er->isError()){
+                    return er;
+                }
+            }
+
+            common::time64_t from = rollup->series_[STAT_AVG]->last();
+            if(from){
+                from += rollup->width_ - from % rollup->width_;
+            }
+            else{
+                // a new tier starts with the journal or the bucket of the newest sample
+                const std::vector<common::time64_t>& head = raw_->headTimes();
+                from = head.empty() ? raw_->last() : head.front();
+                from -= from % rollup->width_;
+            }
+
+            std::vector<common::time64_t> times;
+            std::vector< std::vector<double> > rows;
+            er = raw_->readRows(from, &times, &rows);
+            if(er && er->isError()){
+                return er;
+            }
+
+            for(size_t j = 0; j < times.size(); ++j){
+                er = rollup->add(times[j], rows[j]);
+                if(er && er->isError()){
+                    return er;
+                }
+            }
+        }
+
+        opened_ = true;
+        return common::Error();
+    }
+
+    void InfoHistoryStore::boundsImpl(common::time64_t* first, common::time64_t* last) const
+    {
+        *first = raw_->first();
+        *last = raw_->last();
+        for(size_t i = 0; i < rollups_.size(); ++i){
+            common::time64_t f = rollups_[i]->series_[STAT_AVG]->first();
+            if(f && (!*first || f < *first)){
+                *first = f;
+            }
+        }
+    }
+
+    // Steinarsson's largest triangle three buckets: keeps the first and the last
+    // point and from every bucket between them the point which makes the largest
+    // triangle with the previous pick and the average of the next bucket
+    InfoHistoryStore::points_container_type largestTriangleThreeBuckets(const InfoHistoryStore::points_container_type& points,
+                                                                        size_t threshold)
+    {
+        if(threshold < 3 || points.size() <= threshold){
+            return points;
+        }
+
+        InfoHistoryStore::points_container_type result;
+        result.reserve(threshold);
+        result.push_back(points.front());
+
+        const double every = static_cast<double>(points.size() - 2) / (threshold - 2);
+        size_t a = 0;
+        for(size_t i = 0; i < threshold - 2; ++i){
+            const size_t avgStart = static_cast<size_t>(floor((i + 1) * every)) + 1;
+            const size_t avgEnd = std::min(static_cast<size_t>(floor((i + 2) * every)) + 1, points.size());
+            double avgX = 0, avgY = 0;
+            for(size_t j = avgStart; j < avgEnd; ++j){
+                avgX += points[j].first;
+                avgY += points[j].second;
+            }
+            avgX /= avgEnd - avgStart;
+            avgY /= avgEnd - avgStart;
+
+            const size_t rangeStart = static_cast<size_t>(floor(i * every)) + 1;
+            const size_t rangeEnd = static_cast<size_t>(floor((i + 1) * every)) + 1;
+            const double ax = points[a].first, ay = points[a].second;
+            double maxArea = -1;
+            size_t next = rangeStart;
+            for(size_t j = rangeStart; j < rangeEnd; ++j){
+                double area = fabs((ax - avgX) * (points[j].second - ay) - (ax - points[j].first) * (avgY - ay));
+                if(area > maxArea){
+                    maxArea = area;
+                    next = j;
+                }
+            }
+
+            result.push_back(points[next]);
+            a = next;
+        }
+
+        result.push_back(points.back());
+        return result;
+    }
+}
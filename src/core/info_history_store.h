@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+
+#include <QMutex>
+
+#include "common/time.h"
+
+#include "core/types.h"
+
+namespace fastonosql
+{
+    // Server info history kept as a directory of binary segments. Every integral
+    // info field is a column: timestamps are delta-of-delta encoded, values are
+    // delta (integers) or xor (doubles) encoded varints. A segment starts with
+    // an index of its columns, so reading one field touches the header, the time
+    // column and that field only. Segment file names carry their first and last
+    // sample time and form the time index of the store, old segments are dropped
+    // after the retention period. New samples go to a row journal which is sealed
+    // into a segment when it covers HISTORY_SEGMENT_SAMPLES or HISTORY_SEGMENT_MSEC.
+    // Next to the raw samples the store keeps minute and hour rollups (min, max
+    // and average of every field) with longer retention, so long ranges are read
+    // from a coarser tier.
+    class InfoHistoryStore
+    {
+    public:
+        typedef std::pair<common::time64_t, double> point_type;
+        typedef std::vector<point_type> points_container_type;
+
+        enum Stat
+        {
+            STAT_AVG = 0,
+            STAT_MIN,
+            STAT_MAX,
+            STAT_COUNT
+        };
+
+        InfoHistoryStore(const std::string& path, connectionTypes type, common::time64_t retentionMsec);
+        // a store of values which are not info fields, one column per integral field
+        InfoHistoryStore(const std::string& path, const std::vector< std::vector<Field> >& fields, common::time64_t retentionMsec);
+        ~InfoHistoryStore();
+
+        std::string path() const;
+
+        // samples must come in time order, older ones are rejected
+        common::Error append(common::time64_t msec, ServerInfo* info) WARN_UNUSED_RESULT;
+        // values of the integral fields in the order of the fields
+        common::Error append(common::time64_t msec, const std::vector<double>& values) WARN_UNUSED_RESULT;
+        // values of one field within [from, to] (0 means unbounded) from the coarsest
+        // tier which still has maxPoints in the range, thinned to maxPoints (0 means
+        // all of them); resolution is the bucket width of the tier, 0 for raw samples
+        common::Error read(unsigned char property, unsigned char field, Stat stat, common::time64_t from, common::time64_t to,
+                           size_t maxPoints, points_container_type* out, common::time64_t* resolution) WARN_UNUSED_RESULT;
+        // the same for the sum of several fields of property, added sample by sample before thinning
+        common::Error read(unsigned char property, const std::vector<unsigned char>& fields, Stat stat, common::time64_t from,
+                           common::time64_t to, size_t maxPoints, points_container_type* out, common::time64_t* resolution) WARN_UNUSED_RESULT;
+        // time of the oldest and the newest sample kept
+        common::Error bounds(common::time64_t* first, common::time64_t* last) WARN_UNUSED_RESULT;
+        common::Error clear() WARN_UNUSED_RESULT;
+
+        static uint16_t columnId(unsigned char property, unsigned char field);
+
+    private:
+        DISALLOW_COPY_AND_ASSIGN(InfoHistoryStore);
+
+        class Series;
+        struct Rollup;
+
+        void init(const std::vector< std::vector<Field> >& fields, common::time64_t retentionMsec);
+        common::Error open();
+        void boundsImpl(common::time64_t* first, common::time64_t* last) const;
+
+        const std::string path_;
+        std::vector<uint16_t> columns_;
+
+        QMutex lock_;
+        bool opened_;
+        Series* raw_;
+        std::vector<Rollup*> rollups_;
+    };
+
+    // largest-triangle-three-buckets downsampling, keeps the shape of the line
+    InfoHistoryStore::points_container_type largestTriangleThreeBuckets(const InfoHistoryStore::points_container_type& points,
+                                                                        size_t threshold);
+}
@@ -0,0 +1,117 @@
+#include "core/info_parser.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define INFO_NUMBER_MAX_SIZE 64
+
+namespace fastonosql
+{
+    InfoSlice::InfoSlice()
+        : data_(NULL), size_(0)
+    {
+
+    }
+
+    InfoSlice::InfoSlice(const char* data, size_t size)
+        : data_(data), size_(size)
+    {
+
+    }
+
+    bool InfoSlice::equals(const char* str, size_t size) const
+    {
+        return size_ == size && memcmp(data_, str, size) == 0;
+    }
+
+    void InfoSlice::assignTo(std::string* out) const
+    {
+        out->assign(data_, size_);
+    }
+
+    uint32_t infoFieldHash(const InfoSlice& field)
+    {
+        uint32_t hash = 2166136261U;
+        for(size_t i = 0; i < field.size_; ++i){
+            hash = (hash ^ static_cast<unsigned char>(field.data_[i])) * 16777619U;
+        }
+        return hash;
+    }
+
+    InfoLineReader::InfoLineReader(const char* data, size_t size)
+        : pos_(data), end_(data + size)
+    {
+
+    }
+
+    bool InfoLineReader::next(InfoSlice* line)
+    {
+        if(pos_ >= end_){
+            return false;
+        }
+
+        const char* eol = static_cast<const char*>(memchr(pos_, '\n', end_ - pos_));
+        const char* stop = eol ? eol : end_;
+        const char* last = stop;
+        if(last > pos_ && last[-1] == '\r'){
+            --last;
+        }
+
+        *line = InfoSlice(pos_, last - pos_);
+        pos_ = eol ? eol + 1 : end_;
+        return true;
+    }
+
+    bool splitInfoLine(const InfoSlice& line, InfoSlice* field, InfoSlice* value)
+    {
+        if(!line.size_ || isInfoHeader(line)){
+            return false;
+        }
+
+        const char* delem = static_cast<const char*>(memchr(line.data_, ':', line.size_));
+        if(!delem){
+            return false;
+        }
+
+        *field = InfoSlice(line.data_, delem - line.data_);
+        *value = InfoSlice(delem + 1, line.data_ + line.size_ - delem - 1);
+        return true;
+    }
+
+    bool isInfoHeader(const InfoSlice& line)
+    {
+        return line.size_ && line.data_[0] == '#';
+    }
+
+    uint32_t infoToUInt32(const InfoSlice& value)
+    {
+        return static_cast<uint32_t>(infoToUInt64(value));
+    }
+
+    uint64_t infoToUInt64(const InfoSlice& value)
+    {
+        uint64_t res = 0;
+        for(size_t i = 0; i < value.size_ && value.data_[i] >= '0' && value.data_[i] <= '9'; ++i){
+            res = res * 10 + (value.data_[i] - '0');
+        }
+        return res;
+    }
+
+    int infoToInt(const InfoSlice& value)
+    {
+        if(value.size_ && value.data_[0] == '-'){
+            return -static_cast<int>(infoToUInt32(InfoSlice(value.data_ + 1, value.size_ - 1)));
+        }
+
+        return infoToUInt32(value);
+    }
+
+    // strtod wants a terminated string, numbers are short enough for the stack
+    float infoToFloat(const InfoSlice& value)
+    {
+        char buff[INFO_NUMBER_MAX_SIZE] = {0};
+        size_t size = value.size_ < sizeof(buff) - 1 ? value.size_ : sizeof(buff) - 1;
+        memcpy(buff, value.data_, size);
+        return static_cast<float>(strtod(buff, NULL));
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+namespace fastonosql
+{
+    // Bytes inside an info text, valid as long as the text is.
+    struct InfoSlice
+    {
+        InfoSlice();
+        InfoSlice(const char* data, size_t size);
+
+        bool equals(const char* str, size_t size) const;
+        void assignTo(std::string* out) const;
+
+        const char* data_;
+        size_t size_;
+    };
+
+    // FNV-1a of a label, folds to a constant so that the *_LABEL defines are
+    // case labels of a switch over infoFieldHash. The switch is a perfect hash
+    // checked by the compiler: two labels of one section hashing alike are
+    // duplicate cases and don't build.
+    constexpr uint32_t infoLabelHash(const char* label, uint32_t hash = 2166136261U)
+    {
+        return *label ? infoLabelHash(label + 1, (hash ^ static_cast<unsigned char>(*label)) * 16777619U) : hash;
+    }
+
+    uint32_t infoFieldHash(const InfoSlice& field);
+
+    // lines of an info text, "\r\n" or "\n" terminated, without copying
+    class InfoLineReader
+    {
+    public:
+        InfoLineReader(const char* data, size_t size);
+
+        bool next(InfoSlice* line);
+
+    private:
+        const char* pos_;
+        const char* const end_;
+    };
+
+    // splits "field:value" at the first ':', false for section headers and blank lines
+    bool splitInfoLine(const InfoSlice& line, InfoSlice* field, InfoSlice* value);
+    bool isInfoHeader(const InfoSlice& line);
+
+    uint32_t infoToUInt32(const InfoSlice& value);
+    uint64_t infoToUInt64(const InfoSlice& value);
+    int infoToInt(const InfoSlice& value);
+    float infoToFloat(const InfoSlice& value);
+
+    // feeds every field of one section to section->parseField
+    template<typename T>
+    void parseInfoSection(const std::string& text, T* section)
+    {
+        InfoLineReader reader(text.data(), text.size());
+        InfoSlice line, field, value;
+        while(reader.next(&line)){
+            if(splitInfoLine(line, &field, &value)){
+                section->parseField(infoFieldHash(field), field, value);
+            }
+        }
+    }
+}
+
+// case of a label in a switch over infoFieldHash, the name is compared too
+// so that an unknown field never lands on a known one
+#define INFO_FIELD_CASE(field, label) \
+    case fastonosql::infoLabelHash(label): \
+        if(!(field).equals(label, sizeof(label) - 1)) break;
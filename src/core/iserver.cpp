@@ -52,9 +52,11 @@ namespace
         func(src, &IServer::rootCreated, dsc, &IServer::rootCreated, Qt::UniqueConnection);
         func(src, &IServer::rootCompleated, dsc, &IServer::rootCompleated, Qt::UniqueConnection);
 
-        func(src, &IServer::addedChild, dsc, &IServer::addedChild, Qt::UniqueConnection);
+        func(src, &IServer::childrenAdded, dsc, &IServer::childrenAdded, Qt::UniqueConnection);
         func(src, &IServer::itemUpdated, dsc, &IServer::itemUpdated, Qt::UniqueConnection);
         func(src, &IServer::serverInfoSnapShoot, dsc, &IServer::serverInfoSnapShoot, Qt::UniqueConnection);
+        func(src, &IServer::monitorSnapShot, dsc, &IServer::monitorSnapShot, Qt::UniqueConnection);
+        func(src, &IServer::keyspaceSnapShot, dsc, &IServer::keyspaceSnapShot, Qt::UniqueConnection);
    }
 }
 
@@ -69,9 +71,11 @@ namespace fastonosql
         : drv_(drv), isSuperServer_(isSuperServer)
     {
         if(isSuperServer_){
-            VERIFY(QObject::connect(drv_.get(), &IDriver::addedChild, this, &IServer::addedChild));
+            VERIFY(QObject::connect(drv_.get(), &IDriver::childrenAdded, this, &IServer::childrenAdded));
             VERIFY(QObject::connect(drv_.get(), &IDriver::itemUpdated, this, &IServer::itemUpdated));
             VERIFY(QObject::connect(drv_.get(), &IDriver::serverInfoSnapShoot, this, &IServer::serverInfoSnapShoot));
+            VERIFY(QObject::connect(drv_.get(), &IDriver::monitorSnapShot, this, &IServer::monitorSnapShot));
+            VERIFY(QObject::connect(drv_.get(), &IDriver::keyspaceSnapShot, this, &IServer::keyspaceSnapShot));
         }
     }
 
@@ -84,6 +88,11 @@ namespace fastonosql
         drv_->interrupt();
     }
 
+    void IServer::stopStream()
+    {
+        drv_->stopStream();
+    }
+
     bool IServer::isConnected() const
     {
         return drv_->isConnected();
@@ -145,6 +154,16 @@ namespace fastonosql
         return common::convertFromString<QString>(drv_->outputDelemitr());
     }
 
+    void IServer::watchInfo(int msec)
+    {
+        drv_->watchInfo(msec);
+    }
+
+    void IServer::unwatchInfo(int msec)
+    {
+        drv_->unwatchInfo(msec);
+    }
+
     IDatabaseSPtr IServer::findDatabaseByInfo(DataBaseInfoSPtr inf) const
     {
         DCHECK(inf);
@@ -305,6 +324,49 @@ namespace fastonosql
         notify(ev);
     }
 
+    void IServer::monitor(const EventsInfo::MonitorRequest& req)
+    {
+        emit startedMonitor(req);
+        drv_->postStream(new events::MonitorRequestEvent(this, req));
+    }
+
+    void IServer::subscribe(const EventsInfo::PubSubRequest& req)
+    {
+        emit startedPubSub(req);
+        drv_->postStream(new events::PubSubRequestEvent(this, req));
+    }
+
+    void IServer::slowLog(const EventsInfo::SlowLogRequest& req)
+    {
+        emit startedSlowLog(req);
+        drv_->postMonitoring(new events::SlowLogRequestEvent(this, req));
+    }
+
+    void IServer::clientList(const EventsInfo::ClientListRequest& req)
+    {
+        emit startedClientList(req);
+        drv_->postMonitoring(new events::ClientListRequestEvent(this, req));
+    }
+
+    void IServer::clientKill(const EventsInfo::ClientKillRequest& req)
+    {
+        emit startedClientKill(req);
+        drv_->postMonitoring(new events::ClientKillRequestEvent(this, req));
+    }
+
+    void IServer::keyspaceEvents(const EventsInfo::KeyspaceRequest& req)
+    {
+        emit startedKeyspace(req);
+        drv_->postStream(new events::KeyspaceRequestEvent(this, req));
+    }
+
+    void IServer::benchmark(const EventsInfo::BenchmarkInfoRequest& req)
+    {
+        emit startedBenchmark(req);
+        QEvent *ev = new events::BenchmarkRequestEvent(this, req);
+        notify(ev);
+    }
+
     void IServer::changeProperty(const EventsInfo::ChangeServerPropertyInfoRequest& req)
     {
         emit startedChangeServerProperty(req);
@@ -372,6 +434,34 @@ namespace fastonosql
             ClearServerHistoryResponceEvent *ev = static_cast<ClearServerHistoryResponceEvent*>(event);
             handleClearServerHistoryResponceEvent(ev);
         }
+        else if (type == static_cast<QEvent::Type>(MonitorResponceEvent::EventType)){
+            MonitorResponceEvent *ev = static_cast<MonitorResponceEvent*>(event);
+            handleMonitorResponceEvent(ev);
+        }
+        else if (type == static_cast<QEvent::Type>(PubSubResponceEvent::EventType)){
+            PubSubResponceEvent *ev = static_cast<PubSubResponceEvent*>(event);
+            handlePubSubResponceEvent(ev);
+        }
+        else if (type == static_cast<QEvent::Type>(SlowLogResponceEvent::EventType)){
+            SlowLogResponceEvent *ev = static_cast<SlowLogResponceEvent*>(event);
+            handleSlowLogResponceEvent(ev);
+        }
+        else if (type == static_cast<QEvent::Type>(ClientListResponceEvent::EventType)){
+            ClientListResponceEvent *ev = static_cast<ClientListResponceEvent*>(event);
+            handleClientListResponceEvent(ev);
+        }
+        else if (type == static_cast<QEvent::Type>(ClientKillResponceEvent::EventType)){
+            ClientKillResponceEvent *ev = static_cast<ClientKillResponceEvent*>(event);
+            handleClientKillResponceEvent(ev);
+        }
+        else if (type == static_cast<QEvent::Type>(KeyspaceResponceEvent::EventType)){
+            KeyspaceResponceEvent *ev = static_cast<KeyspaceResponceEvent*>(event);
+            handleKeyspaceResponceEvent(ev);
+        }
+        else if (type == static_cast<QEvent::Type>(BenchmarkResponceEvent::EventType)){
+            BenchmarkResponceEvent *ev = static_cast<BenchmarkResponceEvent*>(event);
+            handleBenchmarkResponceEvent(ev);
+        }
         else if (type == static_cast<QEvent::Type>(ServerPropertyInfoResponceEvent::EventType)){
             ServerPropertyInfoResponceEvent *ev = static_cast<ServerPropertyInfoResponceEvent*>(event);
             handleLoadServerPropertyEvent(ev);
@@ -425,7 +515,7 @@ namespace fastonosql
     {
         EventsInfo::ProgressInfoResponce resp(0);
         emit progressChanged(resp);
-        qApp->postEvent(drv_.get(), ev);
+        drv_->post(ev);
     }
 
     void IServer::handleConnectEvent(events::ConnectResponceEvent* ev)
@@ -617,6 +707,77 @@ namespace fastonosql
         emit finishedClearServerHistory(v);
     }
 
+    void IServer::handleMonitorResponceEvent(events::MonitorResponceEvent* ev)
+    {
+        using namespace events;
+        MonitorResponceEvent::value_type v = ev->value();
+        common::Error er = v.errorInfo();
+        if(er && er->isError()){
+            LOG_ERROR(er, true);
+        }
+        emit finishedMonitor(v);
+    }
+
+    void IServer::handlePubSubResponceEvent(events::PubSubResponceEvent* ev)
+    {
+        using namespace events;
+        PubSubResponceEvent::value_type v = ev->value();
+        common::Error er = v.errorInfo();
+        if(er && er->isError()){
+            LOG_ERROR(er, true);
+        }
+        emit finishedPubSub(v);
+    }
+
+    void IServer::handleSlowLogResponceEvent(events::SlowLogResponceEvent* ev)
+    {
+        using namespace events;
+        SlowLogResponceEvent::value_type v = ev->value();
+        // polled over and over, the panel shows the error instead of the log
+        emit finishedSlowLog(v);
+    }
+
+    void IServer::handleClientListResponceEvent(events::ClientListResponceEvent* ev)
+    {
+        using namespace events;
+        ClientListResponceEvent::value_type v = ev->value();
+        // polled too, like the slow log
+        emit finishedClientList(v);
+    }
+
+    void IServer::handleClientKillResponceEvent(events::ClientKillResponceEvent* ev)
+    {
+        using namespace events;
+        ClientKillResponceEvent::value_type v = ev->value();
+        common::Error er = v.errorInfo();
+        if(er && er->isError()){
+            LOG_ERROR(er, true);
+        }
+        emit finishedClientKill(v);
+    }
+
+    void IServer::handleKeyspaceResponceEvent(events::KeyspaceResponceEvent* ev)
+    {
+        using namespace events;
+        KeyspaceResponceEvent::value_type v = ev->value();
+        common::Error er = v.errorInfo();
+        if(er && er->isError()){
+            LOG_ERROR(er, true);
+        }
+        emit finishedKeyspace(v);
+    }
+
+    void IServer::handleBenchmarkResponceEvent(events::BenchmarkResponceEvent* ev)
+    {
+        using namespace events;
+        BenchmarkResponceEvent::value_type v = ev->value();
+        common::Error er = v.errorInfo();
+        if(er && er->isError()){
+            LOG_ERROR(er, true);
+        }
+        emit finishedBenchmark(v);
+    }
+
     void IServer::handleSetDefaultDatabaseEvent(events::SetDefaultDatabaseResponceEvent* ev)
     {
         using namespace events;
@@ -28,6 +28,8 @@ namespace fastonosql
 
         //sync methods
         void stopCurrentEvent();
+        // ends monitor, subscribe and the like on their own connections
+        void stopStream();
         bool isConnected() const;
         bool isAuthenticated() const;
 
@@ -45,6 +47,9 @@ namespace fastonosql
 
         QString address() const;
         QString outputDelemitr() const;
+        // snapshots come with serverInfoSnapShoot while watched
+        void watchInfo(int msec);
+        void unwatchInfo(int msec);
         IDatabaseSPtr findDatabaseByInfo(DataBaseInfoSPtr inf) const;
         IDatabaseSPtr findDatabaseByName(const std::string& name) const;
 
@@ -87,6 +92,27 @@ namespace fastonosql
         void startedClearServerHistory(const EventsInfo::ClearServerHistoryRequest& req);
         void finishedClearServerHistory(const EventsInfo::ClearServerHistoryResponce& req);
 
+        void startedMonitor(const EventsInfo::MonitorRequest& req);
+        void finishedMonitor(const EventsInfo::MonitorResponce& res);
+
+        void startedPubSub(const EventsInfo::PubSubRequest& req);
+        void finishedPubSub(const EventsInfo::PubSubResponce& res);
+
+        void startedSlowLog(const EventsInfo::SlowLogRequest& req);
+        void finishedSlowLog(const EventsInfo::SlowLogResponce& res);
+
+        void startedClientList(const EventsInfo::ClientListRequest& req);
+        void finishedClientList(const EventsInfo::ClientListResponce& res);
+
+        void startedClientKill(const EventsInfo::ClientKillRequest& req);
+        void finishedClientKill(const EventsInfo::ClientKillResponce& res);
+
+        void startedKeyspace(const EventsInfo::KeyspaceRequest& req);
+        void finishedKeyspace(const EventsInfo::KeyspaceResponce& res);
+
+        void startedBenchmark(const EventsInfo::BenchmarkInfoRequest& req);
+        void finishedBenchmark(const EventsInfo::BenchmarkInfoResponce& res);
+
         void startedLoadServerProperty(const EventsInfo::ServerPropertyInfoRequest& req);
         void finishedLoadServerProperty(const EventsInfo::ServerPropertyInfoResponce& res);
 
@@ -114,9 +140,11 @@ namespace fastonosql
         void finishedLoadDiscoveryInfo(const EventsInfo::DiscoveryInfoResponce& res);
 
    Q_SIGNALS:
-        void addedChild(FastoObject *child);
-        void itemUpdated(FastoObject* item, common::Value* val);
+        void childrenAdded(const FastoObject::child_batch_type& childrens);
+        void itemUpdated(FastoObject* item);
         void serverInfoSnapShoot(ServerInfoSnapShoot shot);
+        void monitorSnapShot(MonitorSnapShot shot);
+        void keyspaceSnapShot(KeyspaceSnapShot shot);
 
     public:
         //async methods
@@ -137,6 +165,13 @@ namespace fastonosql
         void requestHistoryInfo(const EventsInfo::ServerInfoHistoryRequest &req); //signals: startedLoadServerHistoryInfo, finishedLoadServerHistoryInfo
         void clearHistory(const EventsInfo::ClearServerHistoryRequest &req); //signals: startedClearServerHistory, finishedClearServerHistory
         void changeProperty(const EventsInfo::ChangeServerPropertyInfoRequest &req); //signals: startedChangeServerProperty, finishedChangeServerProperty
+        void benchmark(const EventsInfo::BenchmarkInfoRequest &req); //signals: startedBenchmark, finishedBenchmark
+        void monitor(const EventsInfo::MonitorRequest &req); //signals: startedMonitor, monitorSnapShot, finishedMonitor
+        void subscribe(const EventsInfo::PubSubRequest &req); //signals: startedPubSub, finishedPubSub
+        void slowLog(const EventsInfo::SlowLogRequest &req); //signals: startedSlowLog, finishedSlowLog
+        void clientList(const EventsInfo::ClientListRequest &req); //signals: startedClientList, finishedClientList
+        void clientKill(const EventsInfo::ClientKillRequest &req); //signals: startedClientKill, finishedClientKill
+        void keyspaceEvents(const EventsInfo::KeyspaceRequest &req); //signals: startedKeyspace, keyspaceSnapShot, finishedKeyspace
 
     protected:
         virtual void customEvent(QEvent* event);
@@ -174,6 +209,13 @@ namespace fastonosql
         void handleDiscoveryInfoResponceEvent(events::DiscoveryInfoResponceEvent* ev);
 
         void handleClearServerHistoryResponceEvent(events::ClearServerHistoryResponceEvent* ev);
+        void handleBenchmarkResponceEvent(events::BenchmarkResponceEvent* ev);
+        void handleMonitorResponceEvent(events::MonitorResponceEvent* ev);
+        void handlePubSubResponceEvent(events::PubSubResponceEvent* ev);
+        void handleSlowLogResponceEvent(events::SlowLogResponceEvent* ev);
+        void handleClientListResponceEvent(events::ClientListResponceEvent* ev);
+        void handleClientKillResponceEvent(events::ClientKillResponceEvent* ev);
+        void handleKeyspaceResponceEvent(events::KeyspaceResponceEvent* ev);
 
         void processConfigArgs(const EventsInfo::ProcessConfigArgsInfoRequest &req);
         void processDiscoveryInfo(const EventsInfo::DiscoveryInfoRequest &req);
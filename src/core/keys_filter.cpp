@@ -0,0 +1,359 @@
+#include "core/keys_filter.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include <QThreadPool>
+#include <QRunnable>
+#include <QSemaphore>
+
+#define PARALLEL_MATCH_MIN_KEYS 2048
+
+namespace fastonosql
+{
+    namespace
+    {
+        const char globSpecials[] = "*?[\\";
+        const char regexSpecials[] = ".^$|?*+()[]{}\\";
+
+        bool globMatchOne(const char* p, size_t plen, size_t pi, char c, size_t* next)
+        {
+            if(p[pi] == '?'){
+                *next = pi + 1;
+                return true;
+            }
+
+            if(p[pi] == '\\' && pi + 1 < plen){
+                *next = pi + 2;
+                return p[pi + 1] == c;
+            }
+
+            if(p[pi] != '['){
+                *next = pi + 1;
+                return p[pi] == c;
+            }
+
+            size_t i = pi + 1;
+            bool negate = i < plen && p[i] == '^';
+            if(negate){
+                ++i;
+            }
+
+            bool matched = false;
+            while(i < plen && p[i] != ']'){
+                if(p[i] == '\\' && i + 1 < plen){
+                    matched |= p[i + 1] == c;
+                    i += 2;
+                }
+                else if(i + 2 < plen && p[i + 1] == '-' && p[i + 2] != ']'){
+                    unsigned char lo = p[i], hi = p[i + 2], uc = c;
+                    if(lo > hi){
+                        std::swap(lo, hi);
+                    }
+                    matched |= uc >= lo && uc <= hi;
+                    i += 3;
+                }
+                else{
+                    matched |= p[i] == c;
+                    ++i;
+                }
+            }
+
+            *next = i < plen ? i + 1 : i;
+            return negate ? !matched : matched;
+        }
+
+        std::string globPrefix(const std::string& pattern)
+        {
+            std::string prefix;
+            for(size_t i = 0; i < pattern.size(); ++i){
+                char c = pattern[i];
+                if(c == '\\' && i + 1 < pattern.size()){
+                    prefix += pattern[++i];
+                }
+                else if(strchr(globSpecials, c)){
+                    break;
+                }
+                else{
+                    prefix += c;
+                }
+            }
+            return prefix;
+        }
+
+        // literal start of an anchored regex without alternatives
+        std::string regexPrefix(const std::string& pattern)
+        {
+            if(pattern.empty() || pattern[0] != '^' || pattern.find('|') != std::string::npos){
+                return std::string();
+            }
+
+            std::string prefix;
+            for(size_t i = 1; i < pattern.size(); ++i){
+                char c = pattern[i];
+                if(strchr(regexSpecials, c)){
+                    // the last literal is optional or repeated
+                    if((c == '?' || c == '*' || c == '{') && !prefix.empty()){
+                        prefix.resize(prefix.size() - 1);
+                    }
+                    break;
+                }
+                prefix += c;
+            }
+            return prefix;
+        }
+
+        std::string escapeGlob(const std::string& str)
+        {
+            std::string result;
+            for(size_t i = 0; i < str.size(); ++i){
+                if(strchr(globSpecials, str[i])){
+                    result += '\\';
+                }
+                result += str[i];
+            }
+            return result;
+        }
+
+        class MatchTask
+                : public QRunnable
+        {
+        public:
+            MatchTask(const KeysFilter* filter, const std::vector<std::string>* keys, std::vector<char>* flags,
+                      size_t begin, size_t end, QSemaphore* done)
+                : filter_(filter), keys_(keys), flags_(flags), begin_(begin), end_(end), done_(done)
+            {
+                setAutoDelete(true);
+            }
+
+            virtual void run()
+            {
+                for(size_t i = begin_; i < end_; ++i){
+                    (*flags_)[i] = filter_->match((*keys_)[i]);
+                }
+                done_->release();
+            }
+
+        private:
+            const KeysFilter* const filter_;
+            const std::vector<std::string>* const keys_;
+            std::vector<char>* const flags_;
+            const size_t begin_;
+            const size_t end_;
+            QSemaphore* const done_;
+        };
+
+        void matchKeys(const KeysFilter* filter, const std::vector<std::string>& keys, std::vector<char>* flags)
+        {
+            flags->assign(keys.size(), 0);
+            QThreadPool* pool = QThreadPool::globalInstance();
+            size_t tasks = std::max(1, pool->maxThreadCount());
+            if(keys.size() < PARALLEL_MATCH_MIN_KEYS || tasks == 1){
+                for(size_t i = 0; i < keys.size(); ++i){
+                    (*flags)[i] = filter->match(keys[i]);
+                }
+                return;
+            }
+
+            const size_t chunk = (keys.size() + tasks - 1) / tasks;
+            QSemaphore done;
+            size_t started = 0;
+            for(size_t begin = 0; begin < keys.size(); begin += chunk){
+                pool->start(new MatchTask(filter, &keys, flags, begin, std::min(begin + chunk, keys.size()), &done));
+                ++started;
+            }
+            done.acquire(started);
+        }
+    }
+
+    KeysFilter::KeysFilter(const std::string& pattern, PatternType ptype, common::Value::Type type)
+        : pattern_(pattern.empty() ? "*" : pattern), ptype_(ptype), type_(type), prefix_(), regex_()
+    {
+        if(ptype_ == REGEX){
+            regex_.setPattern(QString::fromUtf8(pattern_.c_str(), pattern_.size()));
+            regex_.optimize();
+            prefix_ = regexPrefix(pattern_);
+        }
+        else{
+            prefix_ = globPrefix(pattern_);
+        }
+    }
+
+    std::string KeysFilter::pattern() const
+    {
+        return pattern_;
+    }
+
+    KeysFilter::PatternType KeysFilter::patternType() const
+    {
+        return ptype_;
+    }
+
+    common::Value::Type KeysFilter::type() const
+    {
+        return type_;
+    }
+
+    bool KeysFilter::isValid() const
+    {
+        return ptype_ == GLOB || regex_.isValid();
+    }
+
+    std::string KeysFilter::errorString() const
+    {
+        if(isValid()){
+            return std::string();
+        }
+
+        return regex_.errorString().toStdString();
+    }
+
+    bool KeysFilter::isMatchAll() const
+    {
+        if(ptype_ == REGEX){
+            return pattern_ == ".*" || pattern_ == "^.*" || pattern_ == "^.*$";
+        }
+
+        return pattern_.find_first_not_of('*') == std::string::npos;
+    }
+
+    bool KeysFilter::hasType() const
+    {
+        return type_ != common::Value::TYPE_NULL;
+    }
+
+    std::string KeysFilter::prefix() const
+    {
+        return prefix_;
+    }
+
+    std::string KeysFilter::prefixEnd() const
+    {
+        std::string end = prefix_;
+        while(!end.empty() && static_cast<unsigned char>(end[end.size() - 1]) == 0xff){
+            end.resize(end.size() - 1);
+        }
+
+        if(!end.empty()){
+            end[end.size() - 1] = static_cast<char>(static_cast<unsigned char>(end[end.size() - 1]) + 1);
+        }
+        return end;
+    }
+
+    std::string KeysFilter::glob() const
+    {
+        if(ptype_ == GLOB){
+            return pattern_;
+        }
+
+        return escapeGlob(prefix_) + "*";
+    }
+
+    bool KeysFilter::matchPrefix(const std::string& key) const
+    {
+        return key.compare(0, prefix_.size(), prefix_) == 0;
+    }
+
+    bool KeysFilter::match(const std::string& key) const
+    {
+        if(!matchPrefix(key)){
+            return false;
+        }
+
+        if(ptype_ == REGEX){
+            return regex_.match(QString::fromUtf8(key.c_str(), key.size())).hasMatch();
+        }
+
+        return globMatch(pattern_.c_str(), pattern_.size(), key.c_str(), key.size());
+    }
+
+    bool KeysFilter::matchType(common::Value::Type type) const
+    {
+        return !hasType() || type_ == type;
+    }
+
+    void KeysFilter::filter(std::vector<std::string>* keys) const
+    {
+        if(isMatchAll()){
+            return;
+        }
+
+        std::vector<char> flags;
+        matchKeys(this, *keys, &flags);
+        size_t pos = 0;
+        for(size_t i = 0; i < keys->size(); ++i){
+            if(flags[i]){
+                (*keys)[pos++].swap((*keys)[i]);
+            }
+        }
+        keys->resize(pos);
+    }
+
+    void KeysFilter::filter(std::vector<NDbKValue>* keys) const
+    {
+        std::vector<char> flags(keys->size(), 1);
+        if(!isMatchAll()){
+            std::vector<std::string> names;
+            names.reserve(keys->size());
+            for(size_t i = 0; i < keys->size(); ++i){
+                names.push_back((*keys)[i].keyString());
+            }
+            matchKeys(this, names, &flags);
+        }
+
+        std::vector<NDbKValue> result;
+        result.reserve(keys->size());
+        for(size_t i = 0; i < keys->size(); ++i){
+            if(flags[i] && matchType((*keys)[i].type())){
+                result.push_back((*keys)[i]);
+            }
+        }
+        keys->swap(result);
+    }
+
+    void KeysFilter::collect(std::vector<std::string>* batch, size_t limit, std::vector<std::string>* out) const
+    {
+        filter(batch);
+        for(size_t i = 0; i < batch->size() && out->size() < limit; ++i){
+            out->push_back(std::string());
+            out->back().swap((*batch)[i]);
+        }
+        batch->clear();
+    }
+
+    // Redis style glob: *, ?, [a-z], [^a] and \ escapes
+    bool globMatch(const char* pattern, size_t plen, const char* str, size_t slen)
+    {
+        const size_t npos = static_cast<size_t>(-1);
+        size_t pi = 0, si = 0;
+        size_t star = npos, mark = 0;
+        while(si < slen){
+            if(pi < plen && pattern[pi] == '*'){
+                star = pi++;
+                mark = si;
+                continue;
+            }
+
+            size_t next = 0;
+            if(pi < plen && globMatchOne(pattern, plen, pi, str[si], &next)){
+                pi = next;
+                ++si;
+                continue;
+            }
+
+            if(star == npos){
+                return false;
+            }
+
+            pi = star + 1;
+            si = ++mark;
+        }
+
+        while(pi < plen && pattern[pi] == '*'){
+            ++pi;
+        }
+
+        return pi == plen;
+    }
+}
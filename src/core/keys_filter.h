@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QRegularExpression>
+
+#include "core/types.h"
+
+namespace fastonosql
+{
+    // Key search shared by all drivers: what can be pushed to the server
+    // (glob, type, prefix) and a compiled matcher for the rest.
+    class KeysFilter
+    {
+    public:
+        enum PatternType
+        {
+            GLOB = 0,
+            REGEX
+        };
+
+        explicit KeysFilter(const std::string& pattern = "*", PatternType ptype = GLOB,
+                            common::Value::Type type = common::Value::TYPE_NULL);
+
+        std::string pattern() const;
+        PatternType patternType() const;
+        common::Value::Type type() const; // TYPE_NULL means any type
+
+        bool isValid() const;
+        std::string errorString() const;
+
+        bool isMatchAll() const;
+        bool hasType() const;
+
+        // literal prefix every matching key starts with
+        std::string prefix() const;
+        // first key after all keys with prefix(), empty if unbounded
+        std::string prefixEnd() const;
+        // glob for server side matching, regexes are narrowed by their prefix
+        std::string glob() const;
+
+        bool matchPrefix(const std::string& key) const;
+        bool match(const std::string& key) const;
+        bool matchType(common::Value::Type type) const;
+
+        // keeps only matching keys, big batches are matched on the global thread pool
+        void filter(std::vector<std::string>* keys) const;
+        void filter(std::vector<NDbKValue>* keys) const;
+        // moves matching keys of a scanned batch to out while it has less than limit keys
+        void collect(std::vector<std::string>* batch, size_t limit, std::vector<std::string>* out) const;
+
+    private:
+        std::string pattern_;
+        PatternType ptype_;
+        common::Value::Type type_;
+        std::string prefix_;
+        QRegularExpression regex_;
+    };
+
+    bool globMatch(const char* pattern, size_t plen, const char* str, size_t slen);
+}
@@ -0,0 +1,139 @@
+#include "core/keyspace_analyzer.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+
+#define KEYSPACE_CHANNEL_PREFIX "__keyspace@"
+#define KEYEVENT_CHANNEL_PREFIX "__keyevent@"
+#define KEYSPACE_TOP_CAPACITY 1000
+#define KEYSPACE_REMOVED_MAX 1000
+
+namespace fastonosql
+{
+    namespace
+    {
+        bool rateGreater(const KeyspaceEventRate& lhs, const KeyspaceEventRate& rhs)
+        {
+            return lhs.total_ > rhs.total_;
+        }
+    }
+
+    KeyspaceEvent::KeyspaceEvent()
+        : db_(0), type_(), key_()
+    {
+
+    }
+
+    bool parseKeyspaceEvent(const std::string& channel, const std::string& payload, KeyspaceEvent* event)
+    {
+        const size_t prefixSize = sizeof(KEYSPACE_CHANNEL_PREFIX) - 1;
+        bool keyspace = channel.compare(0, prefixSize, KEYSPACE_CHANNEL_PREFIX) == 0;
+        if(!keyspace && channel.compare(0, prefixSize, KEYEVENT_CHANNEL_PREFIX) != 0){
+            return false;
+        }
+
+        // <prefix><db>__:<rest>
+        std::string::size_type delem = channel.find("__:", prefixSize);
+        if(delem == std::string::npos || delem == prefixSize){
+            return false;
+        }
+
+        event->db_ = atoi(channel.c_str() + prefixSize);
+        if(keyspace){
+            event->key_.assign(channel, delem + 3, std::string::npos);
+            event->type_.assign(payload);
+        }
+        else{
+            event->type_.assign(channel, delem + 3, std::string::npos);
+            event->key_.assign(payload);
+        }
+        return true;
+    }
+
+    bool isKeyspaceRemoval(const std::string& type)
+    {
+        return type == "del" || type == "expired" || type == "evicted" || type == "rename_from";
+    }
+
+    KeyspaceEventRate::KeyspaceEventRate()
+        : type_(), total_(0), perSec_(0)
+    {
+
+    }
+
+    KeyspaceSnapShot::KeyspaceSnapShot()
+        : msec_(0), total_(0), eventsPerSec_(0), expiredPerSec_(0), evictedPerSec_(0), events_(), keys_(), removed_()
+    {
+
+    }
+
+    KeyspaceAnalyzer::Counter::Counter()
+        : total_(0), last_(0)
+    {
+
+    }
+
+    KeyspaceAnalyzer::KeyspaceAnalyzer()
+        : events_(), keys_(KEYSPACE_TOP_CAPACITY), removed_(), total_(0), lastTotal_(0), lastMsec_(0)
+    {
+
+    }
+
+    void KeyspaceAnalyzer::add(const KeyspaceEvent& event)
+    {
+        ++events_[event.type_].total_;
+        keys_.add(event.key_);
+        // a flood of expiries between two snapshots isn't worth the memory,
+        // the views of the rest are refreshed on their next load
+        if(removed_.size() < KEYSPACE_REMOVED_MAX && isKeyspaceRemoval(event.type_)){
+            removed_.push_back(event);
+        }
+        ++total_;
+    }
+
+    double KeyspaceAnalyzer::perSec(Counter* counter, common::time64_t elapsed)
+    {
+        double res = elapsed > 0 ? (counter->total_ - counter->last_) * 1000.0 / elapsed : 0;
+        counter->last_ = counter->total_;
+        return res;
+    }
+
+    KeyspaceSnapShot KeyspaceAnalyzer::snapShot(common::time64_t msec, size_t topCount)
+    {
+        const common::time64_t elapsed = lastMsec_ ? msec - lastMsec_ : 0;
+        KeyspaceSnapShot shot;
+        shot.msec_ = msec;
+        shot.total_ = total_;
+        if(elapsed > 0){
+            shot.eventsPerSec_ = (total_ - lastTotal_) * 1000.0 / elapsed;
+        }
+        lastMsec_ = msec;
+        lastTotal_ = total_;
+
+        shot.events_.reserve(events_.size());
+        for(std::map<std::string, Counter>::iterator it = events_.begin(); it != events_.end(); ++it){
+            KeyspaceEventRate rate;
+            rate.type_ = it->first;
+            rate.total_ = it->second.total_;
+            rate.perSec_ = perSec(&it->second, elapsed);
+            if(it->first == "expired"){
+                shot.expiredPerSec_ = rate.perSec_;
+            }
+            else if(it->first == "evicted"){
+                shot.evictedPerSec_ = rate.perSec_;
+            }
+            shot.events_.push_back(rate);
+        }
+        std::sort(shot.events_.begin(), shot.events_.end(), &rateGreater);
+
+        shot.keys_ = keys_.top(topCount);
+        shot.removed_.swap(removed_);
+        return shot;
+    }
+
+    uint64_t KeyspaceAnalyzer::total() const
+    {
+        return total_;
+    }
+}
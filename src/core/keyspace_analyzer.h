@@ -0,0 +1,84 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/time.h"
+
+#include "core/top_k.h"
+
+namespace fastonosql
+{
+    // one keyspace notification, from either __keyspace@<db>__:<key>
+    // or __keyevent@<db>__:<event> channels
+    struct KeyspaceEvent
+    {
+        KeyspaceEvent();
+
+        int db_;
+        std::string type_; // del, set, expired, evicted, ...
+        std::string key_;
+    };
+
+    // channel and payload of a notification, false for other channels
+    bool parseKeyspaceEvent(const std::string& channel, const std::string& payload, KeyspaceEvent* event);
+    // del, expired, evicted and rename_from leave the key gone
+    bool isKeyspaceRemoval(const std::string& type);
+
+    struct KeyspaceEventRate
+    {
+        KeyspaceEventRate();
+
+        std::string type_;
+        uint64_t total_;
+        double perSec_; // since the previous snapshot
+    };
+
+    struct KeyspaceSnapShot
+    {
+        KeyspaceSnapShot();
+
+        common::time64_t msec_;
+        uint64_t total_;
+        double eventsPerSec_;
+        double expiredPerSec_;
+        double evictedPerSec_;
+        std::vector<KeyspaceEventRate> events_; // the most frequent first
+        std::vector<TopKItem> keys_;
+        std::vector<KeyspaceEvent> removed_; // keys gone since the previous snapshot
+    };
+
+    // Aggregates a notification stream in fixed memory: event types are few
+    // and counted exactly, keys go to space-saving counters. Not thread safe,
+    // it lives on the reading thread.
+    class KeyspaceAnalyzer
+    {
+    public:
+        KeyspaceAnalyzer();
+
+        void add(const KeyspaceEvent& event);
+        KeyspaceSnapShot snapShot(common::time64_t msec, size_t topCount);
+
+        uint64_t total() const;
+
+    private:
+        struct Counter
+        {
+            Counter();
+
+            uint64_t total_;
+            uint64_t last_; // total_ at the previous snapshot
+        };
+
+        double perSec(Counter* counter, common::time64_t elapsed);
+
+        std::map<std::string, Counter> events_;
+        TopK keys_;
+        std::vector<KeyspaceEvent> removed_;
+
+        uint64_t total_;
+        uint64_t lastTotal_;
+        common::time64_t lastMsec_;
+    };
+}
@@ -0,0 +1,180 @@
+#include "core/latency_histogram.h"
+
+#include <chrono>
+
+#define LATENCY_SUB_BUCKET_BITS 8
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BUCKET_BITS)
+#define LATENCY_HALF_BUCKETS (LATENCY_SUB_BUCKETS / 2)
+#define LATENCY_MAX_BITS 40 // 2^40 nsec, about 18 minutes
+#define LATENCY_BUCKETS (LATENCY_SUB_BUCKETS + (LATENCY_MAX_BITS - LATENCY_SUB_BUCKET_BITS) * LATENCY_HALF_BUCKETS)
+
+#define LATENCY_SAMPLES_LABEL "samples"
+#define LATENCY_MIN_LABEL "min_usec"
+#define LATENCY_P50_LABEL "p50_usec"
+#define LATENCY_P99_LABEL "p99_usec"
+#define LATENCY_P999_LABEL "p99.9_usec"
+#define LATENCY_MAX_LABEL "max_usec"
+#define LATENCY_MEAN_LABEL "mean_usec"
+
+namespace fastonosql
+{
+    uint64_t monotonicNsec()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    LatencyHistogram::LatencyHistogram()
+        : counts_(LATENCY_BUCKETS, 0), count_(0), min_(0), max_(0), sum_(0)
+    {
+
+    }
+
+    void LatencyHistogram::record(uint64_t nsec)
+    {
+        const uint64_t limit = (1ULL << LATENCY_MAX_BITS) - 1;
+        if(nsec > limit){
+            nsec = limit;
+        }
+
+        counts_[bucketIndex(nsec)]++;
+        if(!count_ || nsec < min_){
+            min_ = nsec;
+        }
+        if(nsec > max_){
+            max_ = nsec;
+        }
+        count_++;
+        sum_ += nsec;
+    }
+
+    void LatencyHistogram::add(const LatencyHistogram& other)
+    {
+        if(!other.count_){
+            return;
+        }
+
+        for(size_t i = 0; i < counts_.size(); ++i){
+            counts_[i] += other.counts_[i];
+        }
+        if(!count_ || other.min_ < min_){
+            min_ = other.min_;
+        }
+        if(other.max_ > max_){
+            max_ = other.max_;
+        }
+        count_ += other.count_;
+        sum_ += other.sum_;
+    }
+
+    void LatencyHistogram::reset()
+    {
+        counts_.assign(LATENCY_BUCKETS, 0);
+        count_ = 0;
+        min_ = 0;
+        max_ = 0;
+        sum_ = 0;
+    }
+
+    uint64_t LatencyHistogram::count() const
+    {
+        return count_;
+    }
+
+    uint64_t LatencyHistogram::min() const
+    {
+        return min_;
+    }
+
+    uint64_t LatencyHistogram::max() const
+    {
+        return max_;
+    }
+
+    double LatencyHistogram::mean() const
+    {
+        return count_ ? sum_ / count_ : 0;
+    }
+
+    uint64_t LatencyHistogram::valueAtPercentile(double percent) const
+    {
+        if(!count_){
+            return 0;
+        }
+
+        uint64_t rank = static_cast<uint64_t>(percent / 100.0 * count_ + 0.5);
+        if(rank < 1){
+            rank = 1;
+        }
+        if(rank > count_){
+            rank = count_;
+        }
+
+        uint64_t seen = 0;
+        for(size_t i = 0; i < counts_.size(); ++i){
+            seen += counts_[i];
+            if(seen >= rank){
+                uint64_t value = bucketValue(i);
+                if(value > max_){
+                    return max_;
+                }
+                return value < min_ ? min_ : value;
+            }
+        }
+        return max_;
+    }
+
+    size_t LatencyHistogram::bucketIndex(uint64_t nsec)
+    {
+        if(nsec < LATENCY_SUB_BUCKETS){
+            return nsec;
+        }
+
+        int msb = LATENCY_SUB_BUCKET_BITS;
+        while(nsec >> (msb + 1)){
+            ++msb;
+        }
+
+        // top LATENCY_SUB_BUCKET_BITS bits of the value, the highest one is always set
+        const int shift = msb - (LATENCY_SUB_BUCKET_BITS - 1);
+        return LATENCY_SUB_BUCKETS + (shift - 1) * LATENCY_HALF_BUCKETS + ((nsec >> shift) - LATENCY_HALF_BUCKETS);
+    }
+
+    // highest value which falls into the bucket
+    uint64_t LatencyHistogram::bucketValue(size_t index)
+    {
+        if(index < LATENCY_SUB_BUCKETS){
+            return index;
+        }
+
+        const size_t rest = index - LATENCY_SUB_BUCKETS;
+        const int shift = rest / LATENCY_HALF_BUCKETS + 1;
+        const uint64_t sub = rest % LATENCY_HALF_BUCKETS + LATENCY_HALF_BUCKETS;
+        return (sub << shift) + (1ULL << shift) - 1;
+    }
+
+    std::vector< std::vector<Field> > latencyHistoryFields()
+    {
+        std::vector<Field> fields;
+        fields.push_back(Field(LATENCY_SAMPLES_LABEL, common::Value::TYPE_UINTEGER));
+        fields.push_back(Field(LATENCY_MIN_LABEL, common::Value::TYPE_DOUBLE));
+        fields.push_back(Field(LATENCY_P50_LABEL, common::Value::TYPE_DOUBLE));
+        fields.push_back(Field(LATENCY_P99_LABEL, common::Value::TYPE_DOUBLE));
+        fields.push_back(Field(LATENCY_P999_LABEL, common::Value::TYPE_DOUBLE));
+        fields.push_back(Field(LATENCY_MAX_LABEL, common::Value::TYPE_DOUBLE));
+        fields.push_back(Field(LATENCY_MEAN_LABEL, common::Value::TYPE_DOUBLE));
+        return std::vector< std::vector<Field> >(1, fields);
+    }
+
+    std::vector<double> latencyHistoryValues(const LatencyHistogram& hist)
+    {
+        std::vector<double> values;
+        values.push_back(hist.count());
+        values.push_back(hist.min() / 1000.0);
+        values.push_back(hist.valueAtPercentile(50) / 1000.0);
+        values.push_back(hist.valueAtPercentile(99) / 1000.0);
+        values.push_back(hist.valueAtPercentile(99.9) / 1000.0);
+        values.push_back(hist.max() / 1000.0);
+        values.push_back(hist.mean() / 1000.0);
+        return values;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "core/types.h"
+
+namespace fastonosql
+{
+    // nanoseconds of a monotonic clock, only differences are meaningful
+    uint64_t monotonicNsec();
+
+    // Latencies in nanoseconds in log-linear buckets, like HdrHistogram: values
+    // below 256 nsec are exact, above that every power of two is cut
+    // in 128 buckets, so a percentile is off by less than 1%
+    // whatever the magnitude, in a fixed array of counters.
+    class LatencyHistogram
+    {
+    public:
+        LatencyHistogram();
+
+        void record(uint64_t nsec);
+        void add(const LatencyHistogram& other);
+        void reset();
+
+        uint64_t count() const;
+        uint64_t min() const;
+        uint64_t max() const;
+        double mean() const;
+        // smallest recorded value which percent of the samples don't exceed
+        uint64_t valueAtPercentile(double percent) const;
+
+    private:
+        static size_t bucketIndex(uint64_t nsec);
+        static uint64_t bucketValue(size_t index);
+
+        std::vector<uint64_t> counts_;
+        uint64_t count_;
+        uint64_t min_;
+        uint64_t max_;
+        double sum_;
+    };
+
+    // columns of the latency history: samples, min, p50, p99, p99.9, max and mean in usec
+    std::vector< std::vector<Field> > latencyHistoryFields();
+    std::vector<double> latencyHistoryValues(const LatencyHistogram& hist);
+}
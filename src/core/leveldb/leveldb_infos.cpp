@@ -52,32 +52,31 @@ namespace fastonosql
 
     LeveldbServerInfo::Stats::Stats(const std::string& common_text)
     {
-        const std::string &src = common_text;
-        size_t pos = 0;
-        size_t start = 0;
-
-        while((pos = src.find(("\r\n"), start)) != std::string::npos){
-            std::string line = src.substr(start, pos-start);
-            size_t delem = line.find_first_of(':');
-            std::string field = line.substr(0, delem);
-            std::string value = line.substr(delem + 1);
-            if(field == LEVELDB_CAMPACTIONS_LEVEL_LABEL){
-                compactions_level_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == LEVELDB_FILE_SIZE_MB_LABEL){
-                file_size_mb_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == LEVELDB_TIME_SEC_LABEL){
-                time_sec_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == LEVELDB_READ_MB_LABEL){
-                read_mb_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == LEVELDB_WRITE_MB_LABEL){
-                write_mb_ = common::convertFromString<uint32_t>(value);
-            }
-            start = pos + 2;
+        parseInfoSection(common_text, this);
+    }
+
+    bool LeveldbServerInfo::Stats::parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value)
+    {
+        switch(hash){
+        INFO_FIELD_CASE(field, LEVELDB_CAMPACTIONS_LEVEL_LABEL)
+            compactions_level_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, LEVELDB_FILE_SIZE_MB_LABEL)
+            file_size_mb_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, LEVELDB_TIME_SEC_LABEL)
+            time_sec_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, LEVELDB_READ_MB_LABEL)
+            read_mb_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, LEVELDB_WRITE_MB_LABEL)
+            write_mb_ = infoToUInt32(value);
+            return true;
+        default:
+            break;
         }
+        return false;
     }
 
     common::Value* LeveldbServerInfo::Stats::valueByIndex(unsigned char index) const
@@ -144,22 +143,9 @@ namespace fastonosql
             return NULL;
         }
 
+        // the only section, its header line is skipped by the parser
         LeveldbServerInfo* result = new LeveldbServerInfo;
-
-        const std::vector<std::string> headers = DBTraits<LEVELDB>::infoHeaders();
-        std::string word;
-        DCHECK(headers.size() == 1);
-
-        for(int i = 0; i < content.size(); ++i)
-        {
-            word += content[i];
-            if(word == headers[0]){
-                std::string part = content.substr(i + 1);
-                result->stats_ = LeveldbServerInfo::Stats(part);
-                break;
-            }
-        }
-
+        parseInfoSection(content, &result->stats_);
         return result;
     }
 
@@ -4,12 +4,15 @@ extern "C" {
     #include <lmdb.h>
 }
 
+#include <string.h>
+
 #include "common/sprintf.h"
 #include "common/utils.h"
 #include "common/file_system.h"
 #include "fasto/qt/logger.h"
 
 #include "core/command_logger.h"
+#include "core/benchmark.h"
 #include "core/lmdb/lmdb_config.h"
 #include "core/lmdb/lmdb_infos.h"
 
@@ -17,7 +20,8 @@ extern "C" {
 #define GET_KEY_PATTERN_1ARGS_S "GET %s"
 #define SET_KEY_PATTERN_2ARGS_SS "PUT %s %s"
 
-#define GET_KEYS_PATTERN_1ARGS_I "KEYS a z %d"
+#define SEARCH_KEYS_PATTERN_3ARGS_SSI "KEYS \"%s\" \"%s\" %d"
+#define KEYS_SEARCH_BATCH 4096
 #define DELETE_KEY_PATTERN_1ARGS_S "DEL %s"
 #define GET_SERVER_TYPE ""
 #define LMDB_OK 0
@@ -114,6 +118,90 @@ namespace fastonosql
             lmdbConfig config = settings->info();
             return createConnection(config, context);
         }
+
+        // every client thread opens transactions of its own on the shared environment,
+        // lmdb serializes the writers itself
+        class LmdbBenchmarkClient
+                : public BenchmarkClient
+        {
+        public:
+            explicit LmdbBenchmarkClient(lmdb* context)
+                : context_(context)
+            {
+
+            }
+
+            virtual common::Error execute(const std::vector<BenchmarkRequest>& batch, const std::string& value)
+            {
+                for(size_t i = 0; i < batch.size(); ++i){
+                    const BenchmarkRequest& req = batch[i];
+                    MDB_val mkey;
+                    mkey.mv_size = req.key_.size();
+                    mkey.mv_data = (void*)req.key_.c_str();
+                    MDB_val mval;
+
+                    MDB_txn *txn = NULL;
+                    int rc = mdb_txn_begin(context_->env, NULL, req.write_ ? 0 : MDB_RDONLY, &txn);
+                    if(rc == LMDB_OK){
+                        if(req.write_){
+                            mval.mv_size = req.valueSize_;
+                            mval.mv_data = (void*)value.data();
+                            rc = mdb_put(txn, context_->dbir, &mkey, &mval, 0);
+                            if(rc == LMDB_OK){
+                                rc = mdb_txn_commit(txn);
+                            }
+                            else{
+                                mdb_txn_abort(txn);
+                            }
+                        }
+                        else{
+                            rc = mdb_get(txn, context_->dbir, &mkey, &mval);
+                            mdb_txn_abort(txn);
+                        }
+                    }
+
+                    if (rc != LMDB_OK && rc != MDB_NOTFOUND){
+                        char buff[1024] = {0};
+                        common::SNPrintf(buff, sizeof(buff), "Benchmark error: %s", mdb_strerror(rc));
+                        return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                    }
+                }
+
+                return common::Error();
+            }
+
+            virtual common::Error remove(const std::vector<std::string>& keys)
+            {
+                MDB_txn *txn = NULL;
+                int rc = mdb_txn_begin(context_->env, NULL, 0, &txn);
+                for(size_t i = 0; i < keys.size() && (rc == LMDB_OK || rc == MDB_NOTFOUND); ++i){
+                    MDB_val mkey;
+                    mkey.mv_size = keys[i].size();
+                    mkey.mv_data = (void*)keys[i].c_str();
+                    rc = mdb_del(txn, context_->dbir, &mkey, NULL);
+                }
+
+                if(txn){
+                    if(rc == LMDB_OK || rc == MDB_NOTFOUND){
+                        rc = mdb_txn_commit(txn);
+                    }
+                    else{
+                        mdb_txn_abort(txn);
+                    }
+                }
+
+                if (rc != LMDB_OK){
+                    char buff[1024] = {0};
+                    common::SNPrintf(buff, sizeof(buff), "Benchmark error: %s", mdb_strerror(rc));
+                    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                }
+
+                return common::Error();
+            }
+
+        private:
+            lmdb* const context_;
+        };
     }
 
     common::Error testConnection(fastonosql::LmdbConnectionSettings *settings)
@@ -273,7 +361,7 @@ namespace fastonosql
                 common::Error er = info(argc == 2 ? argv[1] : 0, statsout);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue(LmdbServerInfo(statsout).toString());
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -287,7 +375,7 @@ namespace fastonosql
                 common::Error er = get(argv[1], &ret);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue(ret);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -301,7 +389,7 @@ namespace fastonosql
                 common::Error er = dbsize(ret);
                 if(!er){
                     common::FundamentalValue *val = common::Value::createUIntegerValue(ret);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -314,7 +402,7 @@ namespace fastonosql
                 common::Error er = put(argv[1], argv[2]);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -327,7 +415,7 @@ namespace fastonosql
                 common::Error er = del(argv[1]);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("DELETED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -345,7 +433,7 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(keysout[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -357,6 +445,107 @@ namespace fastonosql
             }
         }
 
+        // keys are sorted, so the cursor starts at the filter prefix and stops after it
+        common::Error search(const KeysFilter& filter, uint64_t limit, std::vector<std::string>* ret)
+        {
+            ret->clear();
+            const std::string prefix = filter.prefix();
+
+            MDB_cursor *cursor;
+            MDB_txn *txn = NULL;
+            int rc = mdb_txn_begin(lmdb_->env, NULL, MDB_RDONLY, &txn);
+            if(rc == LMDB_OK){
+                rc = mdb_cursor_open(txn, lmdb_->dbir, &cursor);
+            }
+
+            if(rc != LMDB_OK){
+                mdb_txn_abort(txn);
+                char buff[1024] = {0};
+                common::SNPrintf(buff, sizeof(buff), "Keys function error: %s", mdb_strerror(rc));
+                return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+            }
+
+            MDB_val key;
+            key.mv_size = prefix.size();
+            key.mv_data = (void*)prefix.data();
+            MDB_val data;
+            std::vector<std::string> batch;
+            MDB_cursor_op op = prefix.empty() ? MDB_FIRST : MDB_SET_RANGE;
+            while (ret->size() < limit && (rc = mdb_cursor_get(cursor, &key, &data, op)) == 0) {
+                op = MDB_NEXT;
+                if(key.mv_size < prefix.size() || memcmp(key.mv_data, prefix.data(), prefix.size()) != 0){
+                    break;
+                }
+
+                batch.push_back(std::string((const char*)key.mv_data, key.mv_size));
+                if(batch.size() == KEYS_SEARCH_BATCH){
+                    filter.collect(&batch, limit, ret);
+                }
+            }
+            filter.collect(&batch, limit, ret);
+            mdb_cursor_close(cursor);
+            mdb_txn_abort(txn);
+
+            return common::Error();
+        }
+
+        // keys after cursor with their values, read in one transaction
+        common::Error scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                 std::vector<std::string>* keys, std::vector<std::string>* values, std::string* next)
+        {
+            const std::string prefix = filter.prefix();
+            const std::string& start = cursor.empty() ? prefix : cursor;
+
+            MDB_cursor *mcursor;
+            MDB_txn *txn = NULL;
+            int rc = mdb_txn_begin(lmdb_->env, NULL, MDB_RDONLY, &txn);
+            if(rc == LMDB_OK){
+                rc = mdb_cursor_open(txn, lmdb_->dbir, &mcursor);
+            }
+
+            if(rc != LMDB_OK){
+                mdb_txn_abort(txn);
+                char buff[1024] = {0};
+                common::SNPrintf(buff, sizeof(buff), "Scan values function error: %s", mdb_strerror(rc));
+                return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+            }
+
+            MDB_val key;
+            key.mv_size = start.size();
+            key.mv_data = (void*)start.data();
+            MDB_val data;
+            MDB_cursor_op op = start.empty() ? MDB_FIRST : MDB_SET_RANGE;
+            while (keys->size() < count && (rc = mdb_cursor_get(mcursor, &key, &data, op)) == 0) {
+                op = MDB_NEXT;
+                if(key.mv_size < prefix.size() || memcmp(key.mv_data, prefix.data(), prefix.size()) != 0){
+                    break;
+                }
+
+                std::string skey((const char*)key.mv_data, key.mv_size);
+                if(skey == cursor){
+                    continue;
+                }
+
+                keys->push_back(skey);
+                values->push_back(std::string((const char*)data.mv_data, data.mv_size));
+            }
+            *next = keys->size() == count ? keys->back() : std::string();
+            mdb_cursor_close(mcursor);
+            mdb_txn_abort(txn);
+
+            return common::Error();
+        }
+
+        common::Error createBenchmarkClient(BenchmarkClient** client)
+        {
+            if(!isConnected()){
+                return common::make_error_value("Not connected", common::ErrorValue::E_ERROR);
+            }
+
+            *client = new LmdbBenchmarkClient(lmdb_);
+            return common::Error();
+        }
+
     private:
         common::Error get(const std::string& key, std::string* ret_val)
         {
@@ -604,7 +793,7 @@ namespace fastonosql
         er = execute(cmd);
 
         if(!er){
-            FastoObject::child_container_type ch = root->childrens();
+            const FastoObject::child_container_type& ch = root->childrens();
             if(ch.size()){
                 //*dinfo = makeOwnRedisDiscoveryInfo(ch[0]);
             }
@@ -630,6 +819,17 @@ namespace fastonosql
         return common::Error();
     }
 
+    common::Error LmdbDriver::scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                         std::vector<std::string>* keys, std::vector<std::string>* values, std::string* next)
+    {
+        return impl_->scanValues(filter, cursor, count, keys, values, next);
+    }
+
+    common::Error LmdbDriver::createBenchmarkClient(BenchmarkClient** client)
+    {
+        return impl_->createBenchmarkClient(client);
+    }
+
     void LmdbDriver::handleConnectEvent(events::ConnectRequestEvent *ev)
     {
         QObject *sender = ev->sender();
@@ -680,7 +880,7 @@ namespace fastonosql
                 FastoObjectIPtr outRoot = lock.root_;
                 double step = 100.0f/length;
                 for(size_t n = 0; n < length; ++n){
-                    if(interrupt_){
+                    if(interrupt_.loadAcquire()){
                         er.reset(new common::ErrorValue("Interrupted exec.", common::ErrorValue::E_INTERRUPTED));
                         res.setErrorInfo(er);
                         break;
@@ -756,41 +956,30 @@ namespace fastonosql
         QObject *sender = ev->sender();
         notifyProgress(sender, 0);
             events::LoadDatabaseContentResponceEvent::value_type res(ev->value());
+            const KeysFilter filter = res.filter();
             char patternResult[1024] = {0};
-            common::SNPrintf(patternResult, sizeof(patternResult), GET_KEYS_PATTERN_1ARGS_I, res.countKeys_);
-            FastoObjectIPtr root = FastoObject::createRoot(patternResult);
+            common::SNPrintf(patternResult, sizeof(patternResult), SEARCH_KEYS_PATTERN_3ARGS_SSI, filter.prefix(), filter.prefixEnd(), res.countKeys_);
         notifyProgress(sender, 50);
-            FastoObjectCommand* cmd = createCommand<LmdbCommand>(root, patternResult, common::Value::C_INNER);
-            common::Error er = execute(cmd);
+            LOG_COMMAND(Command(patternResult, common::Value::C_INNER));
+            std::vector<std::string> keys;
+            common::Error er;
+            if(!filter.isValid()){
+                er = common::make_error_value(filter.errorString(), common::ErrorValue::E_ERROR);
+            }
+            else if(filter.matchType(common::Value::TYPE_STRING)){
+                er = impl_->search(filter, res.countKeys_, &keys);
+            }
+
             if(er){
                 res.setErrorInfo(er);
             }
             else{
-                FastoObject::child_container_type rchildrens = cmd->childrens();
-                if(rchildrens.size()){
-                    DCHECK(rchildrens.size() == 1);
-                    FastoObjectArray* array = dynamic_cast<FastoObjectArray*>(rchildrens[0]);
-                    if(!array){
-                        goto done;
-                    }
-                    common::ArrayValue* ar = array->array();
-                    if(!ar){
-                        goto done;
-                    }
-
-                    for(int i = 0; i < ar->size(); ++i)
-                    {
-                        std::string key;
-                        bool isok = ar->getString(i, &key);
-                        if(isok){
-                            NKey k(key);
-                            NDbKValue ress(k, NValue());
-                            res.keys_.push_back(ress);
-                        }
-                    }
+                for(size_t i = 0; i < keys.size(); ++i){
+                    NKey k(keys[i]);
+                    NDbKValue ress(k, NValue());
+                    res.keys_.push_back(ress);
                 }
             }
-    done:
         notifyProgress(sender, 75);
             reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
         notifyProgress(sender, 100);
@@ -1,5 +1,7 @@
 #include "core/memcached/memcached_driver.h"
 
+#include <algorithm>
+
 #include <libmemcached/memcached.h>
 #include <libmemcached/util.h>
 
@@ -11,8 +13,12 @@
 #include "core/memcached/memcached_infos.h"
 
 #include "core/command_logger.h"
+#include "core/benchmark.h"
 
 #define INFO_REQUEST "STATS"
+#define INFO_SETTINGS_REQUEST "STATS SETTINGS"
+#define INFO_SLABS_REQUEST "STATS SLABS"
+#define INFO_ITEMS_REQUEST "STATS ITEMS"
 #define GET_KEYS "STATS ITEMS"
 #define GET_SERVER_TYPE ""
 
@@ -20,8 +26,120 @@
 #define GET_KEY_PATTERN_1ARGS_S "GET %s"
 #define SET_KEY_PATTERN_2ARGS_SS "SET %s 0 0 %s"
 
+namespace
+{
+    // collects "STAT <key> <value>" lines into "<key>:<value>\r\n" text understood by info parsers
+    memcached_return_t stat_printer(const memcached_instance_st* server, const char* key, size_t key_length,
+                                    const char* value, size_t value_length, void* context)
+    {
+        UNUSED(server);
+        std::string* out = static_cast<std::string*>(context);
+        std::string skey(key, key_length);
+        static const std::string items_prefix = MEMCACHED_ITEMS_PREFIX;
+        if(skey.compare(0, items_prefix.size(), items_prefix) == 0){
+            skey.erase(0, items_prefix.size());
+        }
+
+        out->append(skey);
+        out->append(":");
+        out->append(value, value_length);
+        out->append("\r\n");
+        return MEMCACHED_SUCCESS;
+    }
+
+    memcached_return_t dump_key(const memcached_st* ptr, const char* key, size_t key_length, void* context)
+    {
+        UNUSED(ptr);
+        std::vector<std::string>* out = static_cast<std::vector<std::string>*>(context);
+        out->push_back(std::string(key, key_length));
+        return MEMCACHED_SUCCESS;
+    }
+}
+
 namespace fastonosql
 {
+    namespace
+    {
+        // a clone of the command connection, the reads of a batch go out in one multi get,
+        // the text protocol has nothing like it for the writes
+        class MemcachedBenchmarkClient
+                : public BenchmarkClient
+        {
+        public:
+            explicit MemcachedBenchmarkClient(memcached_st* memc)
+                : memc_(memc)
+            {
+
+            }
+
+            virtual ~MemcachedBenchmarkClient()
+            {
+                memcached_free(memc_);
+            }
+
+            virtual common::Error execute(const std::vector<BenchmarkRequest>& batch, const std::string& value)
+            {
+                std::vector<const char*> keys;
+                std::vector<size_t> keys_size;
+                for(size_t i = 0; i < batch.size(); ++i){
+                    const BenchmarkRequest& req = batch[i];
+                    if(!req.write_){
+                        keys.push_back(req.key_.c_str());
+                        keys_size.push_back(req.key_.size());
+                        continue;
+                    }
+
+                    memcached_return_t rc = memcached_set(memc_, req.key_.c_str(), req.key_.size(), value.data(), req.valueSize_, 0, 0);
+                    if (rc != MEMCACHED_SUCCESS){
+                        return makeError(rc);
+                    }
+                }
+
+                if(keys.empty()){
+                    return common::Error();
+                }
+
+                memcached_return_t rc = memcached_mget(memc_, &keys[0], &keys_size[0], keys.size());
+                if (rc != MEMCACHED_SUCCESS){
+                    return makeError(rc);
+                }
+
+                memcached_result_st* result = NULL;
+                while((result = memcached_fetch_result(memc_, NULL, &rc))){
+                    memcached_result_free(result);
+                }
+
+                if (rc != MEMCACHED_END && rc != MEMCACHED_NOTFOUND && rc != MEMCACHED_SUCCESS){
+                    return makeError(rc);
+                }
+
+                return common::Error();
+            }
+
+            virtual common::Error remove(const std::vector<std::string>& keys)
+            {
+                for(size_t i = 0; i < keys.size(); ++i){
+                    memcached_return_t rc = memcached_delete(memc_, keys[i].c_str(), keys[i].size(), 0);
+                    if (rc != MEMCACHED_SUCCESS && rc != MEMCACHED_NOTFOUND){
+                        return makeError(rc);
+                    }
+                }
+
+                return common::Error();
+            }
+
+        private:
+            common::Error makeError(memcached_return_t rc) const
+            {
+                char buff[1024] = {0};
+                common::SNPrintf(buff, sizeof(buff), "Benchmark error: %s", memcached_strerror(memc_, rc));
+                return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+            }
+
+            memcached_st* const memc_;
+        };
+    }
+
     common::Error testConnection(MemcachedConnectionSettings* settings)
     {
         if(!settings){
@@ -58,7 +176,7 @@ namespace fastonosql
     struct MemcachedDriver::pimpl
     {
         pimpl()
-            : memc_(NULL)
+            : memc_(NULL), dumped_()
         {
 
         }
@@ -183,6 +301,79 @@ namespace fastonosql
             return common::Error();
         }
 
+        common::Error stats_raw(const char* args, std::string& statsout)
+        {
+            statsout.clear();
+            memcached_return_t error = memcached_stat_execute(memc_, args, stat_printer, &statsout);
+            if (error != MEMCACHED_SUCCESS){
+                char buff[1024] = {0};
+                common::SNPrintf(buff, sizeof(buff), "Stats %s function error: %s", args, memcached_strerror(memc_, error));
+                return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+            }
+
+            return common::Error();
+        }
+
+        common::Error stats_settings(MemcachedServerInfo::Settings& statsout)
+        {
+            std::string raw;
+            common::Error er = stats_raw("settings", raw);
+            if(!er){
+                statsout = MemcachedServerInfo::Settings(raw);
+            }
+            return er;
+        }
+
+        common::Error stats_slabs(MemcachedServerInfo::Slabs& statsout)
+        {
+            std::string raw;
+            common::Error er = stats_raw("slabs", raw);
+            if(!er){
+                statsout = MemcachedServerInfo::Slabs(raw);
+            }
+            return er;
+        }
+
+        common::Error stats_items(MemcachedServerInfo::Items& statsout)
+        {
+            std::string raw;
+            common::Error er = stats_raw("items", raw);
+            if(!er){
+                statsout = MemcachedServerInfo::Items(raw);
+            }
+            return er;
+        }
+
+        common::Error full_stats(MemcachedServerInfo** info)
+        {
+            MemcachedServerInfo::Common cm;
+            common::Error er = stats(NULL, cm);
+            if(er){
+                return er;
+            }
+
+            MemcachedServerInfo::Settings settings;
+            er = stats_settings(settings);
+            if(er){
+                return er;
+            }
+
+            MemcachedServerInfo::Slabs slabs;
+            er = stats_slabs(slabs);
+            if(er){
+                return er;
+            }
+
+            MemcachedServerInfo::Items items;
+            er = stats_items(items);
+            if(er){
+                return er;
+            }
+
+            *info = new MemcachedServerInfo(cm, settings, slabs, items);
+            return common::Error();
+        }
+
         ~pimpl()
         {
             clear();
@@ -202,7 +393,7 @@ namespace fastonosql
                 common::Error er = get(argv[1], ret);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue(ret);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -215,7 +406,7 @@ namespace fastonosql
                 common::Error er = set(argv[1], argv[4], atoi(argv[2]), atoi(argv[3]));
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -228,7 +419,7 @@ namespace fastonosql
                 common::Error er = add(argv[1], argv[4], atoi(argv[2]), atoi(argv[3]));
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -241,7 +432,7 @@ namespace fastonosql
                 common::Error er = replace(argv[1], argv[4], atoi(argv[2]), atoi(argv[3]));
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -254,7 +445,7 @@ namespace fastonosql
                 common::Error er = append(argv[1], argv[4], atoi(argv[2]), atoi(argv[3]));
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -267,7 +458,7 @@ namespace fastonosql
                 common::Error er = prepend(argv[1], argv[4], atoi(argv[2]), atoi(argv[3]));
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -280,7 +471,7 @@ namespace fastonosql
                 common::Error er = incr(argv[1], common::convertFromString<uint64_t>(argv[2]));
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -293,7 +484,7 @@ namespace fastonosql
                 common::Error er = decr(argv[1], common::convertFromString<uint64_t>(argv[2]));
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -306,7 +497,7 @@ namespace fastonosql
                 common::Error er = del(argv[1], argc == 3 ? atoll(argv[2]) : 0);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("DELETED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -319,7 +510,7 @@ namespace fastonosql
                 common::Error er = flush_all(argc == 2 ? common::convertFromString<time_t>(argv[1]) : 0);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -335,11 +526,22 @@ namespace fastonosql
                     return keys(args);
                 }
 
+                if(args && (strcasecmp(args, "slabs") == 0 || strcasecmp(args, "settings") == 0)){
+                    std::string raw;
+                    common::Error er = stats_raw(args, raw);
+                    if(!er){
+                        common::StringValue *val = common::Value::createStringValue(raw);
+                        FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
+                        out->addChildren(child);
+                    }
+                    return er;
+                }
+
                 MemcachedServerInfo::Common statsout;
                 common::Error er = stats(args, statsout);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue(MemcachedServerInfo(statsout).toString());
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -365,6 +567,86 @@ namespace fastonosql
             }
         }
 
+        // keys can only be dumped all at once, the cursor is a position in that dump
+        // and the values are fetched with one multi get per batch
+        common::Error scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                 std::vector<std::string>* keys, std::vector<std::string>* values, std::string* next)
+        {
+            if(cursor.empty()){
+                std::vector<std::string> dumped;
+                memcached_dump_fn callbacks[1] = { dump_key };
+                memcached_return_t rc = memcached_dump(memc_, callbacks, &dumped, 1);
+                if (rc != MEMCACHED_SUCCESS){
+                    char buff[1024] = {0};
+                    common::SNPrintf(buff, sizeof(buff), "Dump function error: %s", memcached_strerror(memc_, rc));
+                    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                }
+
+                dumped_.clear();
+                for(size_t i = 0; i < dumped.size(); ++i){
+                    if(filter.matchPrefix(dumped[i])){
+                        dumped_.push_back(dumped[i]);
+                    }
+                }
+            }
+
+            const size_t pos = cursor.empty() ? 0 : common::convertFromString<size_t>(cursor);
+            const size_t end = std::min<size_t>(pos + count, dumped_.size());
+            if(pos >= end){
+                next->clear();
+                return common::Error();
+            }
+
+            std::vector<const char*> mkeys;
+            std::vector<size_t> mlens;
+            for(size_t i = pos; i < end; ++i){
+                mkeys.push_back(dumped_[i].c_str());
+                mlens.push_back(dumped_[i].size());
+            }
+
+            memcached_return_t rc = memcached_mget(memc_, &mkeys[0], &mlens[0], mkeys.size());
+            if (rc != MEMCACHED_SUCCESS){
+                char buff[1024] = {0};
+                common::SNPrintf(buff, sizeof(buff), "Mget function error: %s", memcached_strerror(memc_, rc));
+                return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+            }
+
+            // expired keys are simply missing from the answer
+            memcached_result_st* result = NULL;
+            while((result = memcached_fetch_result(memc_, NULL, &rc)) != NULL){
+                keys->push_back(std::string(memcached_result_key_value(result), memcached_result_key_length(result)));
+                values->push_back(std::string(memcached_result_value(result), memcached_result_length(result)));
+                memcached_result_free(result);
+            }
+
+            *next = end < dumped_.size() ? common::convertToString(end) : std::string();
+            return common::Error();
+        }
+
+        // the clone keeps the servers and the SASL data, but none of the connections
+        common::Error createBenchmarkClient(BenchmarkClient** client)
+        {
+            if(!isConnected()){
+                return common::make_error_value("Not connected", common::ErrorValue::E_ERROR);
+            }
+
+            memcached_st* memc = memcached_clone(NULL, memc_);
+            if(!memc){
+                return common::make_error_value("Couldn't clone the connection", common::ErrorValue::E_ERROR);
+            }
+
+            memcached_return_t error = memcached_version(memc);
+            if (error != MEMCACHED_SUCCESS){
+                char buff[1024] = {0};
+                common::SNPrintf(buff, sizeof(buff), "Connect to server error: %s", memcached_strerror(memc, error));
+                memcached_free(memc);
+                return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+            }
+
+            *client = new MemcachedBenchmarkClient(memc);
+            return common::Error();
+        }
+
     private:
         common::Error get(const std::string& key, std::string& ret_val)
         {
@@ -537,6 +819,7 @@ namespace fastonosql
         }
 
         memcached_st* memc_;
+        std::vector<std::string> dumped_;
    };
 
     MemcachedDriver::MemcachedDriver(IConnectionSettingsBaseSPtr settings)
@@ -591,10 +874,13 @@ namespace fastonosql
     common::Error MemcachedDriver::serverInfo(ServerInfo **info)
     {
         LOG_COMMAND(Command(INFO_REQUEST, common::Value::C_INNER));
-        MemcachedServerInfo::Common cm;
-        common::Error err = impl_->stats(NULL, cm);
+        LOG_COMMAND(Command(INFO_SETTINGS_REQUEST, common::Value::C_INNER));
+        LOG_COMMAND(Command(INFO_SLABS_REQUEST, common::Value::C_INNER));
+        LOG_COMMAND(Command(INFO_ITEMS_REQUEST, common::Value::C_INNER));
+        MemcachedServerInfo* minfo = NULL;
+        common::Error err = impl_->full_stats(&minfo);
         if(!err){
-            *info = new MemcachedServerInfo(cm);
+            *info = minfo;
         }
 
         return err;
@@ -613,7 +899,7 @@ namespace fastonosql
         er = execute(cmd);
 
         if(!er){
-            FastoObject::child_container_type ch = root->childrens();
+            const FastoObject::child_container_type& ch = root->childrens();
             if(ch.size()){
                 //*dinfo = makeOwnRedisDiscoveryInfo(ch[0]);
             }
@@ -637,6 +923,17 @@ namespace fastonosql
         return common::Error();
     }
 
+    common::Error MemcachedDriver::scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                              std::vector<std::string>* keys, std::vector<std::string>* values, std::string* next)
+    {
+        return impl_->scanValues(filter, cursor, count, keys, values, next);
+    }
+
+    common::Error MemcachedDriver::createBenchmarkClient(BenchmarkClient** client)
+    {
+        return impl_->createBenchmarkClient(client);
+    }
+
     void MemcachedDriver::handleConnectEvent(events::ConnectRequestEvent *ev)
     {
         QObject *sender = ev->sender();
@@ -688,7 +985,7 @@ namespace fastonosql
                 FastoObjectIPtr outRoot = lock.root_;
                 double step = 100.0f/length;
                 for(size_t n = 0; n < length; ++n){
-                    if(interrupt_){
+                    if(interrupt_.loadAcquire()){
                         er.reset(new common::ErrorValue("Interrupted exec.", common::ErrorValue::E_INTERRUPTED));
                         res.setErrorInfo(er);
                         break;
@@ -772,28 +1069,41 @@ namespace fastonosql
                 res.setErrorInfo(er);
             }
             else{
-                FastoObject::child_container_type rchildrens = cmd->childrens();
+                const FastoObject::child_container_type& rchildrens = cmd->childrens();
                 if(rchildrens.size()){
                     DCHECK(rchildrens.size() == 1);
-                    FastoObjectArray* array = dynamic_cast<FastoObjectArray*>(rchildrens[0]);
-                    if(!array){
+                    FastoObjectArray* ar = dynamic_cast<FastoObjectArray*>(rchildrens[0]);
+                    if(!ar){
                         goto done;
                     }
-                    common::ArrayValue* ar = array->array();
-                    if(!ar){
+
+                    // no key listing on the server side, the whole dump is matched here
+                    const KeysFilter filter = res.filter();
+                    if(!filter.isValid()){
+                        res.setErrorInfo(common::make_error_value(filter.errorString(), common::ErrorValue::E_ERROR));
                         goto done;
                     }
 
+                    if(!filter.matchType(common::Value::TYPE_STRING)){
+                        goto done;
+                    }
+
+                    std::vector<std::string> keys;
                     for(int i = 0; i < ar->size(); ++i)
                     {
                         std::string key;
                         bool isok = ar->getString(i, &key);
                         if(isok){
-                            NKey k(key);
-                            NDbKValue ress(k, NValue());
-                            res.keys_.push_back(ress);
+                            keys.push_back(key);
                         }
                     }
+
+                    filter.filter(&keys);
+                    for(size_t i = 0; i < keys.size() && i < res.countKeys_; ++i){
+                        NKey k(keys[i]);
+                        NDbKValue ress(k, NValue());
+                        res.keys_.push_back(ress);
+                    }
                 }
             }
     done:
@@ -818,14 +1128,13 @@ namespace fastonosql
         notifyProgress(sender, 0);
             events::ServerInfoResponceEvent::value_type res(ev->value());
         notifyProgress(sender, 50);
-            LOG_COMMAND(Command(INFO_REQUEST, common::Value::C_INNER));
-            MemcachedServerInfo::Common cm;
-            common::Error err = impl_->stats(NULL, cm);
+            ServerInfo* info = NULL;
+            common::Error err = serverInfo(&info);
             if(err){
                 res.setErrorInfo(err);
             }
             else{
-                ServerInfoSPtr mem(new MemcachedServerInfo(cm));
+                ServerInfoSPtr mem(info);
                 res.setInfo(mem);
             }
         notifyProgress(sender, 75);
@@ -72,6 +72,10 @@ namespace fastonosql
         virtual common::Error serverInfo(ServerInfo** info);
         virtual common::Error serverDiscoveryInfo(ServerInfo** sinfo, ServerDiscoveryInfo** dinfo, DataBaseInfo** dbinfo);
         virtual common::Error currentDataBaseInfo(DataBaseInfo** info);
+        virtual common::Error scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                         std::vector<std::string>* keys, std::vector<std::string>* values,
+                                         std::string* next);
+        virtual common::Error createBenchmarkClient(BenchmarkClient** client);
 
         virtual void handleConnectEvent(events::ConnectRequestEvent* ev);
         virtual void handleDisconnectEvent(events::DisconnectRequestEvent* ev);
@@ -1,5 +1,7 @@
 #include "core/memcached/memcached_infos.h"
 
+#include <string.h>
+
 #include <ostream>
 #include <sstream>
 
@@ -17,21 +19,95 @@ namespace
         Field(MEMCACHED_RUSAGE_USER_LABEL, common::Value::TYPE_UINTEGER),
         Field(MEMCACHED_RUSAGE_SYSTEM_LABEL, common::Value::TYPE_UINTEGER),
         Field(MEMCACHED_CURR_ITEMS_LABEL, common::Value::TYPE_UINTEGER),
-        Field(MEMCACHED_TOTAL_ITEMS_LABEL, common::Value::TYPE_UINTEGER),
-        Field(MEMCACHED_BYTES_LABEL, common::Value::TYPE_UINTEGER),
+        Field(MEMCACHED_TOTAL_ITEMS_LABEL, common::Value::TYPE_DOUBLE),
+        Field(MEMCACHED_BYTES_LABEL, common::Value::TYPE_DOUBLE),
         Field(MEMCACHED_CURR_CONNECTIONS_LABEL, common::Value::TYPE_UINTEGER),
-        Field(MEMCACHED_TOTAL_CONNECTIONS_LABEL, common::Value::TYPE_UINTEGER),
+        Field(MEMCACHED_TOTAL_CONNECTIONS_LABEL, common::Value::TYPE_DOUBLE),
         Field(MEMCACHED_CONNECTION_STRUCTURES_LABEL, common::Value::TYPE_UINTEGER),
-        Field(MEMCACHED_CMD_GET_LABEL, common::Value::TYPE_UINTEGER),
-        Field(MEMCACHED_CMD_SET_LABEL, common::Value::TYPE_UINTEGER),
-        Field(MEMCACHED_GET_HITS_LABEL, common::Value::TYPE_UINTEGER),
-        Field(MEMCACHED_GET_MISSES_LABEL, common::Value::TYPE_UINTEGER),
-        Field(MEMCACHED_EVICTIONS_LABEL, common::Value::TYPE_UINTEGER),
-        Field(MEMCACHED_BYTES_READ_LABEL, common::Value::TYPE_UINTEGER),
-        Field(MEMCACHED_BYTES_WRITTEN_LABEL, common::Value::TYPE_UINTEGER),
-        Field(MEMCACHED_LIMIT_MAXBYTES_LABEL, common::Value::TYPE_UINTEGER),
-        Field(MEMCACHED_THREADS_LABEL, common::Value::TYPE_UINTEGER)
+        Field(MEMCACHED_CMD_GET_LABEL, common::Value::TYPE_DOUBLE),
+        Field(MEMCACHED_CMD_SET_LABEL, common::Value::TYPE_DOUBLE),
+        Field(MEMCACHED_GET_HITS_LABEL, common::Value::TYPE_DOUBLE),
+        Field(MEMCACHED_GET_MISSES_LABEL, common::Value::TYPE_DOUBLE),
+        Field(MEMCACHED_EVICTIONS_LABEL, common::Value::TYPE_DOUBLE),
+        Field(MEMCACHED_BYTES_READ_LABEL, common::Value::TYPE_DOUBLE),
+        Field(MEMCACHED_BYTES_WRITTEN_LABEL, common::Value::TYPE_DOUBLE),
+        Field(MEMCACHED_LIMIT_MAXBYTES_LABEL, common::Value::TYPE_DOUBLE),
+        Field(MEMCACHED_THREADS_LABEL, common::Value::TYPE_UINTEGER),
+        Field(MEMCACHED_GET_HIT_RATIO_LABEL, common::Value::TYPE_DOUBLE)
     };
+
+    const std::vector<Field> memcachedSettingsFields =
+    {
+        Field(MEMCACHED_MAXBYTES_LABEL, common::Value::TYPE_DOUBLE),
+        Field(MEMCACHED_MAXCONNS_LABEL, common::Value::TYPE_UINTEGER),
+        Field(MEMCACHED_TCPPORT_LABEL, common::Value::TYPE_UINTEGER),
+        Field(MEMCACHED_EVICTIONS_ENABLED_LABEL, common::Value::TYPE_STRING),
+        Field(MEMCACHED_GROWTH_FACTOR_LABEL, common::Value::TYPE_DOUBLE),
+        Field(MEMCACHED_CHUNK_SIZE_LABEL, common::Value::TYPE_UINTEGER),
+        Field(MEMCACHED_NUM_THREADS_LABEL, common::Value::TYPE_UINTEGER),
+        Field(MEMCACHED_ITEM_SIZE_MAX_LABEL, common::Value::TYPE_UINTEGER),
+        Field(MEMCACHED_SLAB_REASSIGN_LABEL, common::Value::TYPE_STRING),
+        Field(MEMCACHED_SLAB_AUTOMOVE_LABEL, common::Value::TYPE_UINTEGER)
+    };
+
+    std::string slabClassFieldName(uint32_t id, const char* field)
+    {
+        return common::convertToString(id) + ":" + field;
+    }
+
+    std::vector<Field> makeMemcachedSlabsFields()
+    {
+        std::vector<Field> fields;
+        fields.push_back(Field(MEMCACHED_ACTIVE_SLABS_LABEL, common::Value::TYPE_UINTEGER));
+        fields.push_back(Field(MEMCACHED_TOTAL_MALLOCED_LABEL, common::Value::TYPE_DOUBLE));
+        for(uint32_t id = 1; id <= MEMCACHED_MAX_SLAB_CLASSES; ++id){
+            fields.push_back(Field(slabClassFieldName(id, MEMCACHED_SLAB_MEM_REQUESTED_LABEL), common::Value::TYPE_DOUBLE));
+            fields.push_back(Field(slabClassFieldName(id, MEMCACHED_SLAB_TOTAL_PAGES_LABEL), common::Value::TYPE_UINTEGER));
+            fields.push_back(Field(slabClassFieldName(id, MEMCACHED_SLAB_USED_CHUNKS_LABEL), common::Value::TYPE_UINTEGER));
+            fields.push_back(Field(slabClassFieldName(id, MEMCACHED_SLAB_GET_HITS_LABEL), common::Value::TYPE_DOUBLE));
+        }
+        return fields;
+    }
+
+    std::vector<Field> makeMemcachedItemsFields()
+    {
+        std::vector<Field> fields;
+        for(uint32_t id = 1; id <= MEMCACHED_MAX_SLAB_CLASSES; ++id){
+            fields.push_back(Field(MEMCACHED_ITEMS_PREFIX + slabClassFieldName(id, MEMCACHED_ITEM_NUMBER_LABEL), common::Value::TYPE_UINTEGER));
+            fields.push_back(Field(MEMCACHED_ITEMS_PREFIX + slabClassFieldName(id, MEMCACHED_ITEM_AGE_LABEL), common::Value::TYPE_UINTEGER));
+            fields.push_back(Field(MEMCACHED_ITEMS_PREFIX + slabClassFieldName(id, MEMCACHED_ITEM_EVICTED_LABEL), common::Value::TYPE_DOUBLE));
+            fields.push_back(Field(MEMCACHED_ITEMS_PREFIX + slabClassFieldName(id, MEMCACHED_ITEM_OUTOFMEMORY_LABEL), common::Value::TYPE_DOUBLE));
+        }
+        return fields;
+    }
+
+    const std::vector<Field> memcachedSlabsFields = makeMemcachedSlabsFields();
+    const std::vector<Field> memcachedItemsFields = makeMemcachedItemsFields();
+
+    // "<id>:<field>:<value>" lines of slabs/items sections come split at the
+    // first ':', the field of the class is cut off the value
+    bool splitClassField(const InfoSlice& field, const InfoSlice& value, uint32_t* id, InfoSlice* cfield, InfoSlice* cvalue)
+    {
+        if(!field.size_){
+            return false;
+        }
+
+        for(size_t i = 0; i < field.size_; ++i){
+            if(field.data_[i] < '0' || field.data_[i] > '9'){
+                return false;
+            }
+        }
+
+        const char* delem = static_cast<const char*>(memchr(value.data_, ':', value.size_));
+        if(!delem){
+            return false;
+        }
+
+        *id = infoToUInt32(field);
+        *cfield = InfoSlice(value.data_, delem - value.data_);
+        *cvalue = InfoSlice(delem + 1, value.data_ + value.size_ - delem - 1);
+        return *id != 0;
+    }
 }
 
 namespace fastonosql
@@ -52,13 +128,13 @@ namespace fastonosql
     template<>
     std::vector<std::string> DBTraits<MEMCACHED>::infoHeaders()
     {
-        return  { MEMCACHED_COMMON_LABEL };
+        return  { MEMCACHED_COMMON_LABEL, MEMCACHED_SETTINGS_LABEL, MEMCACHED_SLABS_LABEL, MEMCACHED_ITEMS_LABEL };
     }
 
     template<>
     std::vector<std::vector<Field> > DBTraits<MEMCACHED>::infoFields()
     {
-        return  { memcachedCommonFields };
+        return  { memcachedCommonFields, memcachedSettingsFields, memcachedSlabsFields, memcachedItemsFields };
     }
 
     MemcachedServerInfo::Common::Common()
@@ -68,83 +144,82 @@ namespace fastonosql
 
     MemcachedServerInfo::Common::Common(const std::string& common_text)
     {
-        const std::string &src = common_text;
-        size_t pos = 0;
-        size_t start = 0;
-
-        while((pos = src.find(("\r\n"), start)) != std::string::npos){
-            std::string line = src.substr(start, pos-start);
-            size_t delem = line.find_first_of(':');
-            std::string field = line.substr(0, delem);
-            std::string value = line.substr(delem + 1);
-            if(field == MEMCACHED_PID_LABEL){
-                pid_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_UPTIME_LABEL){
-                uptime_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_TIME_LABEL){
-                time_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_VERSION_LABEL){
-                version_ = value;
-            }
-            else if(field == MEMCACHED_POINTER_SIZE_LABEL){
-                pointer_size_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_RUSAGE_USER_LABEL){
-                rusage_user_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_RUSAGE_SYSTEM_LABEL){
-                rusage_system_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_CURR_ITEMS_LABEL){
-                curr_items_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_TOTAL_ITEMS_LABEL){
-                total_items_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_BYTES_LABEL){
-                bytes_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_CURR_CONNECTIONS_LABEL){
-                curr_connections_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_TOTAL_CONNECTIONS_LABEL){
-                total_connections_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_CONNECTION_STRUCTURES_LABEL){
-                connection_structures_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_CMD_GET_LABEL){
-                cmd_get_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_CMD_SET_LABEL){
-                cmd_set_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_GET_HITS_LABEL){
-                get_hits_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_GET_MISSES_LABEL){
-                get_misses_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_EVICTIONS_LABEL){
-                evictions_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_BYTES_READ_LABEL){
-                bytes_read_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_BYTES_WRITTEN_LABEL){
-                bytes_written_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_LIMIT_MAXBYTES_LABEL){
-                limit_maxbytes_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == MEMCACHED_THREADS_LABEL){
-                threads_ = common::convertFromString<uint32_t>(value);
-            }
-            start = pos + 2;
+        parseInfoSection(common_text, this);
+    }
+
+    bool MemcachedServerInfo::Common::parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value)
+    {
+        switch(hash){
+        INFO_FIELD_CASE(field, MEMCACHED_PID_LABEL)
+            pid_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_UPTIME_LABEL)
+            uptime_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_TIME_LABEL)
+            time_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_VERSION_LABEL)
+            value.assignTo(&version_);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_POINTER_SIZE_LABEL)
+            pointer_size_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_RUSAGE_USER_LABEL)
+            rusage_user_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_RUSAGE_SYSTEM_LABEL)
+            rusage_system_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_CURR_ITEMS_LABEL)
+            curr_items_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_TOTAL_ITEMS_LABEL)
+            total_items_ = infoToUInt64(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_BYTES_LABEL)
+            bytes_ = infoToUInt64(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_CURR_CONNECTIONS_LABEL)
+            curr_connections_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_TOTAL_CONNECTIONS_LABEL)
+            total_connections_ = infoToUInt64(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_CONNECTION_STRUCTURES_LABEL)
+            connection_structures_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_CMD_GET_LABEL)
+            cmd_get_ = infoToUInt64(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_CMD_SET_LABEL)
+            cmd_set_ = infoToUInt64(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_GET_HITS_LABEL)
+            get_hits_ = infoToUInt64(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_GET_MISSES_LABEL)
+            get_misses_ = infoToUInt64(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_EVICTIONS_LABEL)
+            evictions_ = infoToUInt64(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_BYTES_READ_LABEL)
+            bytes_read_ = infoToUInt64(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_BYTES_WRITTEN_LABEL)
+            bytes_written_ = infoToUInt64(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_LIMIT_MAXBYTES_LABEL)
+            limit_maxbytes_ = infoToUInt64(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_THREADS_LABEL)
+            threads_ = infoToUInt32(value);
+            return true;
+        default:
+            break;
         }
+        return false;
     }
 
     common::Value* MemcachedServerInfo::Common::valueByIndex(unsigned char index) const
@@ -167,33 +242,345 @@ namespace fastonosql
         case 7:
             return new common::FundamentalValue(curr_items_);
         case 8:
-            return new common::FundamentalValue(total_items_);
+            return new common::FundamentalValue(static_cast<double>(total_items_));
         case 9:
-            return new common::FundamentalValue(bytes_);
+            return new common::FundamentalValue(static_cast<double>(bytes_));
         case 10:
             return new common::FundamentalValue(curr_connections_);
         case 11:
-            return new common::FundamentalValue(total_connections_);
+            return new common::FundamentalValue(static_cast<double>(total_connections_));
         case 12:
             return new common::FundamentalValue(connection_structures_);
         case 13:
-            return new common::FundamentalValue(cmd_get_);
+            return new common::FundamentalValue(static_cast<double>(cmd_get_));
         case 14:
-            return new common::FundamentalValue(cmd_set_);
+            return new common::FundamentalValue(static_cast<double>(cmd_set_));
         case 15:
-            return new common::FundamentalValue(get_hits_);
+            return new common::FundamentalValue(static_cast<double>(get_hits_));
         case 16:
-            return new common::FundamentalValue(get_misses_);
+            return new common::FundamentalValue(static_cast<double>(get_misses_));
         case 17:
-            return new common::FundamentalValue(evictions_);
+            return new common::FundamentalValue(static_cast<double>(evictions_));
         case 18:
-            return new common::FundamentalValue(bytes_read_);
+            return new common::FundamentalValue(static_cast<double>(bytes_read_));
         case 19:
-            return new common::FundamentalValue(bytes_written_);
+            return new common::FundamentalValue(static_cast<double>(bytes_written_));
         case 20:
-            return new common::FundamentalValue(limit_maxbytes_);
+            return new common::FundamentalValue(static_cast<double>(limit_maxbytes_));
         case 21:
             return new common::FundamentalValue(threads_);
+        case 22:
+        {
+            uint64_t total = get_hits_ + get_misses_;
+            float ratio = total ? static_cast<float>(get_hits_) / total : 0.0f;
+            return new common::FundamentalValue(ratio);
+        }
+        default:
+            NOTREACHED();
+            break;
+        }
+        return NULL;
+    }
+
+    MemcachedServerInfo::Settings::Settings()
+        : maxbytes_(0), maxconns_(0), tcpport_(0), evictions_(), growth_factor_(0), chunk_size_(0),
+          num_threads_(0), item_size_max_(0), slab_reassign_(), slab_automove_(0)
+    {
+
+    }
+
+    MemcachedServerInfo::Settings::Settings(const std::string& settings_text)
+        : maxbytes_(0), maxconns_(0), tcpport_(0), evictions_(), growth_factor_(0), chunk_size_(0),
+          num_threads_(0), item_size_max_(0), slab_reassign_(), slab_automove_(0)
+    {
+        parseInfoSection(settings_text, this);
+    }
+
+    bool MemcachedServerInfo::Settings::parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value)
+    {
+        switch(hash){
+        INFO_FIELD_CASE(field, MEMCACHED_MAXBYTES_LABEL)
+            maxbytes_ = infoToUInt64(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_MAXCONNS_LABEL)
+            maxconns_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_TCPPORT_LABEL)
+            tcpport_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_EVICTIONS_ENABLED_LABEL)
+            value.assignTo(&evictions_);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_GROWTH_FACTOR_LABEL)
+            growth_factor_ = infoToFloat(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_CHUNK_SIZE_LABEL)
+            chunk_size_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_NUM_THREADS_LABEL)
+            num_threads_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_ITEM_SIZE_MAX_LABEL)
+            item_size_max_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_SLAB_REASSIGN_LABEL)
+            value.assignTo(&slab_reassign_);
+            return true;
+        INFO_FIELD_CASE(field, MEMCACHED_SLAB_AUTOMOVE_LABEL)
+            slab_automove_ = infoToUInt32(value);
+            return true;
+        default:
+            break;
+        }
+        return false;
+    }
+
+    common::Value* MemcachedServerInfo::Settings::valueByIndex(unsigned char index) const
+    {
+        switch (index) {
+        case 0:
+            return new common::FundamentalValue(static_cast<double>(maxbytes_));
+        case 1:
+            return new common::FundamentalValue(maxconns_);
+        case 2:
+            return new common::FundamentalValue(tcpport_);
+        case 3:
+            return new common::StringValue(evictions_);
+        case 4:
+            return new common::FundamentalValue(growth_factor_);
+        case 5:
+            return new common::FundamentalValue(chunk_size_);
+        case 6:
+            return new common::FundamentalValue(num_threads_);
+        case 7:
+            return new common::FundamentalValue(item_size_max_);
+        case 8:
+            return new common::StringValue(slab_reassign_);
+        case 9:
+            return new common::FundamentalValue(slab_automove_);
+        default:
+            NOTREACHED();
+            break;
+        }
+        return NULL;
+    }
+
+    MemcachedServerInfo::SlabClass::SlabClass()
+        : id_(0), chunk_size_(0), chunks_per_page_(0), total_pages_(0), total_chunks_(0),
+          used_chunks_(0), free_chunks_(0), mem_requested_(0), get_hits_(0), cmd_set_(0)
+    {
+
+    }
+
+    MemcachedServerInfo::SlabClass::SlabClass(uint32_t id)
+        : id_(id), chunk_size_(0), chunks_per_page_(0), total_pages_(0), total_chunks_(0),
+          used_chunks_(0), free_chunks_(0), mem_requested_(0), get_hits_(0), cmd_set_(0)
+    {
+
+    }
+
+    MemcachedServerInfo::Slabs::Slabs()
+        : active_slabs_(0), total_malloced_(0), classes_()
+    {
+
+    }
+
+    MemcachedServerInfo::Slabs::Slabs(const std::string& slabs_text)
+        : active_slabs_(0), total_malloced_(0), classes_()
+    {
+        parseInfoSection(slabs_text, this);
+    }
+
+    bool MemcachedServerInfo::Slabs::parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value)
+    {
+        uint32_t id = 0;
+        InfoSlice cfield, cvalue;
+        if(!splitClassField(field, value, &id, &cfield, &cvalue)){
+            switch(hash){
+            INFO_FIELD_CASE(field, MEMCACHED_ACTIVE_SLABS_LABEL)
+                active_slabs_ = infoToUInt32(value);
+                return true;
+            INFO_FIELD_CASE(field, MEMCACHED_TOTAL_MALLOCED_LABEL)
+                total_malloced_ = infoToUInt64(value);
+                return true;
+            default:
+                break;
+            }
+            return false;
+        }
+
+        if(classes_.empty() || classes_.back().id_ != id){
+            classes_.push_back(SlabClass(id));
+        }
+
+        SlabClass& cl = classes_.back();
+        switch(infoFieldHash(cfield)){
+        INFO_FIELD_CASE(cfield, MEMCACHED_SLAB_CHUNK_SIZE_LABEL)
+            cl.chunk_size_ = infoToUInt32(cvalue);
+            return true;
+        INFO_FIELD_CASE(cfield, MEMCACHED_SLAB_CHUNKS_PER_PAGE_LABEL)
+            cl.chunks_per_page_ = infoToUInt32(cvalue);
+            return true;
+        INFO_FIELD_CASE(cfield, MEMCACHED_SLAB_TOTAL_PAGES_LABEL)
+            cl.total_pages_ = infoToUInt32(cvalue);
+            return true;
+        INFO_FIELD_CASE(cfield, MEMCACHED_SLAB_TOTAL_CHUNKS_LABEL)
+            cl.total_chunks_ = infoToUInt32(cvalue);
+            return true;
+        INFO_FIELD_CASE(cfield, MEMCACHED_SLAB_USED_CHUNKS_LABEL)
+            cl.used_chunks_ = infoToUInt32(cvalue);
+            return true;
+        INFO_FIELD_CASE(cfield, MEMCACHED_SLAB_FREE_CHUNKS_LABEL)
+            cl.free_chunks_ = infoToUInt32(cvalue);
+            return true;
+        INFO_FIELD_CASE(cfield, MEMCACHED_SLAB_MEM_REQUESTED_LABEL)
+            cl.mem_requested_ = infoToUInt64(cvalue);
+            return true;
+        INFO_FIELD_CASE(cfield, MEMCACHED_SLAB_GET_HITS_LABEL)
+            cl.get_hits_ = infoToUInt64(cvalue);
+            return true;
+        INFO_FIELD_CASE(cfield, MEMCACHED_SLAB_CMD_SET_LABEL)
+            cl.cmd_set_ = infoToUInt64(cvalue);
+            return true;
+        default:
+            break;
+        }
+        return false;
+    }
+
+    const MemcachedServerInfo::SlabClass* MemcachedServerInfo::Slabs::findClass(uint32_t id) const
+    {
+        for(classes_container_type::const_iterator it = classes_.begin(); it != classes_.end(); ++it){
+            if((*it).id_ == id){
+                return &(*it);
+            }
+        }
+
+        return NULL;
+    }
+
+    common::Value* MemcachedServerInfo::Slabs::valueByIndex(unsigned char index) const
+    {
+        if(index == 0){
+            return new common::FundamentalValue(active_slabs_);
+        }
+        else if(index == 1){
+            return new common::FundamentalValue(static_cast<double>(total_malloced_));
+        }
+
+        unsigned char classIndex = index - MEMCACHED_SLABS_TOTAL_FIELDS_COUNT;
+        uint32_t id = classIndex / MEMCACHED_SLAB_CLASS_FIELDS_COUNT + 1;
+        const SlabClass* cl = findClass(id);
+        if(!cl){
+            return NULL; // class not allocated at the moment of snapshot
+        }
+
+        switch (classIndex % MEMCACHED_SLAB_CLASS_FIELDS_COUNT) {
+        case 0:
+            return new common::FundamentalValue(static_cast<double>(cl->mem_requested_));
+        case 1:
+            return new common::FundamentalValue(cl->total_pages_);
+        case 2:
+            return new common::FundamentalValue(cl->used_chunks_);
+        case 3:
+            return new common::FundamentalValue(static_cast<double>(cl->get_hits_));
+        default:
+            NOTREACHED();
+            break;
+        }
+        return NULL;
+    }
+
+    MemcachedServerInfo::ItemClass::ItemClass()
+        : id_(0), number_(0), age_(0), evicted_(0), evicted_nonzero_(0), outofmemory_(0), reclaimed_(0)
+    {
+
+    }
+
+    MemcachedServerInfo::ItemClass::ItemClass(uint32_t id)
+        : id_(id), number_(0), age_(0), evicted_(0), evicted_nonzero_(0), outofmemory_(0), reclaimed_(0)
+    {
+
+    }
+
+    MemcachedServerInfo::Items::Items()
+        : classes_()
+    {
+
+    }
+
+    MemcachedServerInfo::Items::Items(const std::string& items_text)
+        : classes_()
+    {
+        parseInfoSection(items_text, this);
+    }
+
+    bool MemcachedServerInfo::Items::parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value)
+    {
+        uint32_t id = 0;
+        InfoSlice cfield, cvalue;
+        if(!splitClassField(field, value, &id, &cfield, &cvalue)){
+            return false;
+        }
+
+        if(classes_.empty() || classes_.back().id_ != id){
+            classes_.push_back(ItemClass(id));
+        }
+
+        ItemClass& cl = classes_.back();
+        switch(infoFieldHash(cfield)){
+        INFO_FIELD_CASE(cfield, MEMCACHED_ITEM_NUMBER_LABEL)
+            cl.number_ = infoToUInt32(cvalue);
+            return true;
+        INFO_FIELD_CASE(cfield, MEMCACHED_ITEM_AGE_LABEL)
+            cl.age_ = infoToUInt32(cvalue);
+            return true;
+        INFO_FIELD_CASE(cfield, MEMCACHED_ITEM_EVICTED_LABEL)
+            cl.evicted_ = infoToUInt64(cvalue);
+            return true;
+        INFO_FIELD_CASE(cfield, MEMCACHED_ITEM_EVICTED_NONZERO_LABEL)
+            cl.evicted_nonzero_ = infoToUInt64(cvalue);
+            return true;
+        INFO_FIELD_CASE(cfield, MEMCACHED_ITEM_OUTOFMEMORY_LABEL)
+            cl.outofmemory_ = infoToUInt64(cvalue);
+            return true;
+        INFO_FIELD_CASE(cfield, MEMCACHED_ITEM_RECLAIMED_LABEL)
+            cl.reclaimed_ = infoToUInt64(cvalue);
+            return true;
+        default:
+            break;
+        }
+        return false;
+    }
+
+    const MemcachedServerInfo::ItemClass* MemcachedServerInfo::Items::findClass(uint32_t id) const
+    {
+        for(classes_container_type::const_iterator it = classes_.begin(); it != classes_.end(); ++it){
+            if((*it).id_ == id){
+                return &(*it);
+            }
+        }
+
+        return NULL;
+    }
+
+    common::Value* MemcachedServerInfo::Items::valueByIndex(unsigned char index) const
+    {
+        uint32_t id = index / MEMCACHED_ITEM_CLASS_FIELDS_COUNT + 1;
+        const ItemClass* cl = findClass(id);
+        if(!cl){
+            return NULL;
+        }
+
+        switch (index % MEMCACHED_ITEM_CLASS_FIELDS_COUNT) {
+        case 0:
+            return new common::FundamentalValue(cl->number_);
+        case 1:
+            return new common::FundamentalValue(cl->age_);
+        case 2:
+            return new common::FundamentalValue(static_cast<double>(cl->evicted_));
+        case 3:
+            return new common::FundamentalValue(static_cast<double>(cl->outofmemory_));
         default:
             NOTREACHED();
             break;
@@ -213,11 +600,23 @@ namespace fastonosql
 
     }
 
+    MemcachedServerInfo::MemcachedServerInfo(const Common& common, const Settings& settings, const Slabs& slabs, const Items& items)
+        : ServerInfo(MEMCACHED), common_(common), settings_(settings), slabs_(slabs), items_(items)
+    {
+
+    }
+
     common::Value* MemcachedServerInfo::valueByIndexes(unsigned char property, unsigned char field) const
     {
         switch (property) {
         case 0:
             return common_.valueByIndex(field);
+        case 1:
+            return settings_.valueByIndex(field);
+        case 2:
+            return slabs_.valueByIndex(field);
+        case 3:
+            return items_.valueByIndex(field);
         default:
             NOTREACHED();
             break;
@@ -251,11 +650,88 @@ namespace fastonosql
                     << MEMCACHED_THREADS_LABEL":" << value.threads_ << ("\r\n");
     }
 
+    std::ostream& operator<<(std::ostream& out, const MemcachedServerInfo::Settings& value)
+    {
+        return out << MEMCACHED_MAXBYTES_LABEL":" << value.maxbytes_ << ("\r\n")
+                    << MEMCACHED_MAXCONNS_LABEL":" << value.maxconns_ << ("\r\n")
+                    << MEMCACHED_TCPPORT_LABEL":" << value.tcpport_ << ("\r\n")
+                    << MEMCACHED_EVICTIONS_ENABLED_LABEL":" << value.evictions_ << ("\r\n")
+                    << MEMCACHED_GROWTH_FACTOR_LABEL":" << value.growth_factor_ << ("\r\n")
+                    << MEMCACHED_CHUNK_SIZE_LABEL":" << value.chunk_size_ << ("\r\n")
+                    << MEMCACHED_NUM_THREADS_LABEL":" << value.num_threads_ << ("\r\n")
+                    << MEMCACHED_ITEM_SIZE_MAX_LABEL":" << value.item_size_max_ << ("\r\n")
+                    << MEMCACHED_SLAB_REASSIGN_LABEL":" << value.slab_reassign_ << ("\r\n")
+                    << MEMCACHED_SLAB_AUTOMOVE_LABEL":" << value.slab_automove_ << ("\r\n");
+    }
+
+    std::ostream& operator<<(std::ostream& out, const MemcachedServerInfo::SlabClass& value)
+    {
+        return out << value.id_ << ":" MEMCACHED_SLAB_CHUNK_SIZE_LABEL":" << value.chunk_size_ << ("\r\n")
+                    << value.id_ << ":" MEMCACHED_SLAB_CHUNKS_PER_PAGE_LABEL":" << value.chunks_per_page_ << ("\r\n")
+                    << value.id_ << ":" MEMCACHED_SLAB_TOTAL_PAGES_LABEL":" << value.total_pages_ << ("\r\n")
+                    << value.id_ << ":" MEMCACHED_SLAB_TOTAL_CHUNKS_LABEL":" << value.total_chunks_ << ("\r\n")
+                    << value.id_ << ":" MEMCACHED_SLAB_USED_CHUNKS_LABEL":" << value.used_chunks_ << ("\r\n")
+                    << value.id_ << ":" MEMCACHED_SLAB_FREE_CHUNKS_LABEL":" << value.free_chunks_ << ("\r\n")
+                    << value.id_ << ":" MEMCACHED_SLAB_MEM_REQUESTED_LABEL":" << value.mem_requested_ << ("\r\n")
+                    << value.id_ << ":" MEMCACHED_SLAB_GET_HITS_LABEL":" << value.get_hits_ << ("\r\n")
+                    << value.id_ << ":" MEMCACHED_SLAB_CMD_SET_LABEL":" << value.cmd_set_ << ("\r\n");
+    }
+
+    std::ostream& operator<<(std::ostream& out, const MemcachedServerInfo::Slabs& value)
+    {
+        for(MemcachedServerInfo::Slabs::classes_container_type::const_iterator it = value.classes_.begin(); it != value.classes_.end(); ++it){
+            out << *it;
+        }
+
+        return out << MEMCACHED_ACTIVE_SLABS_LABEL":" << value.active_slabs_ << ("\r\n")
+                    << MEMCACHED_TOTAL_MALLOCED_LABEL":" << value.total_malloced_ << ("\r\n");
+    }
+
+    std::ostream& operator<<(std::ostream& out, const MemcachedServerInfo::ItemClass& value)
+    {
+        return out << value.id_ << ":" MEMCACHED_ITEM_NUMBER_LABEL":" << value.number_ << ("\r\n")
+                    << value.id_ << ":" MEMCACHED_ITEM_AGE_LABEL":" << value.age_ << ("\r\n")
+                    << value.id_ << ":" MEMCACHED_ITEM_EVICTED_LABEL":" << value.evicted_ << ("\r\n")
+                    << value.id_ << ":" MEMCACHED_ITEM_EVICTED_NONZERO_LABEL":" << value.evicted_nonzero_ << ("\r\n")
+                    << value.id_ << ":" MEMCACHED_ITEM_OUTOFMEMORY_LABEL":" << value.outofmemory_ << ("\r\n")
+                    << value.id_ << ":" MEMCACHED_ITEM_RECLAIMED_LABEL":" << value.reclaimed_ << ("\r\n");
+    }
+
+    std::ostream& operator<<(std::ostream& out, const MemcachedServerInfo::Items& value)
+    {
+        for(MemcachedServerInfo::Items::classes_container_type::const_iterator it = value.classes_.begin(); it != value.classes_.end(); ++it){
+            out << *it;
+        }
+
+        return out;
+    }
+
     std::ostream& operator<<(std::ostream& out, const MemcachedServerInfo& value)
     {
         return out << value.toString();
     }
 
+    namespace
+    {
+        // index of a section by its header line, -1 for sections not parsed
+        int memcachedInfoSection(const InfoSlice& header)
+        {
+            switch(infoFieldHash(header)){
+            INFO_FIELD_CASE(header, MEMCACHED_COMMON_LABEL)
+                return 0;
+            INFO_FIELD_CASE(header, MEMCACHED_SETTINGS_LABEL)
+                return 1;
+            INFO_FIELD_CASE(header, MEMCACHED_SLABS_LABEL)
+                return 2;
+            INFO_FIELD_CASE(header, MEMCACHED_ITEMS_LABEL)
+                return 3;
+            default:
+                break;
+            }
+            return -1;
+        }
+    }
+
     MemcachedServerInfo* makeMemcachedServerInfo(const std::string &content)
     {
         if(content.empty()){
@@ -264,37 +740,37 @@ namespace fastonosql
 
         MemcachedServerInfo* result = new MemcachedServerInfo;
 
-        int j = 0;
-        std::string word;
-        size_t pos = 0;
-        const std::vector<std::string> headers = DBTraits<MEMCACHED>::infoHeaders();
+        // one pass over the reply, every line goes to the section of the last header
+        InfoLineReader reader(content.data(), content.size());
+        InfoSlice line, field, value;
+        int section = -1;
+        while(reader.next(&line)){
+            if(isInfoHeader(line)){
+                section = memcachedInfoSection(line);
+                continue;
+            }
 
-        for(int i = 0; i < content.size(); ++i)
-        {
-            char ch = content[i];
-            word += ch;
-            if(word == headers[j]){
-                if(j+1 != headers.size()){
-                    pos = content.find(headers[j+1], pos);
-                }
-                else{
-                    break;
-                }
-
-                if(pos != std::string::npos){
-                    std::string part = content.substr(i + 1, pos - i - 1 );
-                    switch(j)
-                    {
-                    case 0:
-                        result->common_ = MemcachedServerInfo::Common(part);
-                        break;
-                    default:
-                        break;
-                    }
-                    i = pos-1;
-                    ++j;
-                }
-                word.clear();
+            if(section == -1 || !splitInfoLine(line, &field, &value)){
+                continue;
+            }
+
+            const uint32_t hash = infoFieldHash(field);
+            switch(section)
+            {
+            case 0:
+                result->common_.parseField(hash, field, value);
+                break;
+            case 1:
+                result->settings_.parseField(hash, field, value);
+                break;
+            case 2:
+                result->slabs_.parseField(hash, field, value);
+                break;
+            case 3:
+                result->items_.parseField(hash, field, value);
+                break;
+            default:
+                break;
             }
         }
 
@@ -305,7 +781,8 @@ namespace fastonosql
     std::string MemcachedServerInfo::toString() const
     {
         std::stringstream str;
-        str << MEMCACHED_COMMON_LABEL"\r\n" << common_;
+        str << MEMCACHED_COMMON_LABEL"\r\n" << common_ << MEMCACHED_SETTINGS_LABEL"\r\n" << settings_
+            << MEMCACHED_SLABS_LABEL"\r\n" << slabs_ << MEMCACHED_ITEMS_LABEL"\r\n" << items_;
         return str.str();
     }
 
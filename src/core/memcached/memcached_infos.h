@@ -1,8 +1,12 @@
 #pragma once
 
 #include "core/types.h"
+#include "core/info_parser.h"
 
 #define MEMCACHED_COMMON_LABEL "# Common"
+#define MEMCACHED_SETTINGS_LABEL "# Settings"
+#define MEMCACHED_SLABS_LABEL "# Slabs"
+#define MEMCACHED_ITEMS_LABEL "# Items"
 
 #define MEMCACHED_PID_LABEL "pid"
 #define MEMCACHED_UPTIME_LABEL "uptime"
@@ -26,6 +30,48 @@
 #define MEMCACHED_BYTES_WRITTEN_LABEL "bytes_written"
 #define MEMCACHED_LIMIT_MAXBYTES_LABEL "limit_maxbytes"
 #define MEMCACHED_THREADS_LABEL "threads"
+#define MEMCACHED_GET_HIT_RATIO_LABEL "get_hit_ratio"
+
+//Settings
+#define MEMCACHED_MAXBYTES_LABEL "maxbytes"
+#define MEMCACHED_MAXCONNS_LABEL "maxconns"
+#define MEMCACHED_TCPPORT_LABEL "tcpport"
+#define MEMCACHED_EVICTIONS_ENABLED_LABEL "evictions"
+#define MEMCACHED_GROWTH_FACTOR_LABEL "growth_factor"
+#define MEMCACHED_CHUNK_SIZE_LABEL "chunk_size"
+#define MEMCACHED_NUM_THREADS_LABEL "num_threads"
+#define MEMCACHED_ITEM_SIZE_MAX_LABEL "item_size_max"
+#define MEMCACHED_SLAB_REASSIGN_LABEL "slab_reassign"
+#define MEMCACHED_SLAB_AUTOMOVE_LABEL "slab_automove"
+
+//Slabs
+#define MEMCACHED_ACTIVE_SLABS_LABEL "active_slabs"
+#define MEMCACHED_TOTAL_MALLOCED_LABEL "total_malloced"
+#define MEMCACHED_SLAB_CHUNK_SIZE_LABEL "chunk_size"
+#define MEMCACHED_SLAB_CHUNKS_PER_PAGE_LABEL "chunks_per_page"
+#define MEMCACHED_SLAB_TOTAL_PAGES_LABEL "total_pages"
+#define MEMCACHED_SLAB_TOTAL_CHUNKS_LABEL "total_chunks"
+#define MEMCACHED_SLAB_USED_CHUNKS_LABEL "used_chunks"
+#define MEMCACHED_SLAB_FREE_CHUNKS_LABEL "free_chunks"
+#define MEMCACHED_SLAB_MEM_REQUESTED_LABEL "mem_requested"
+#define MEMCACHED_SLAB_GET_HITS_LABEL "get_hits"
+#define MEMCACHED_SLAB_CMD_SET_LABEL "cmd_set"
+
+//Items
+#define MEMCACHED_ITEMS_PREFIX "items:"
+#define MEMCACHED_ITEM_NUMBER_LABEL "number"
+#define MEMCACHED_ITEM_AGE_LABEL "age"
+#define MEMCACHED_ITEM_EVICTED_LABEL "evicted"
+#define MEMCACHED_ITEM_EVICTED_NONZERO_LABEL "evicted_nonzero"
+#define MEMCACHED_ITEM_OUTOFMEMORY_LABEL "outofmemory"
+#define MEMCACHED_ITEM_RECLAIMED_LABEL "reclaimed"
+
+// slab class ids are 1..63 in memcached (MAX_NUMBER_OF_SLAB_CLASSES - 1),
+// every class exposes a fixed set of graphable fields after the section totals
+#define MEMCACHED_MAX_SLAB_CLASSES 63
+#define MEMCACHED_SLAB_CLASS_FIELDS_COUNT 4
+#define MEMCACHED_SLABS_TOTAL_FIELDS_COUNT 2
+#define MEMCACHED_ITEM_CLASS_FIELDS_COUNT 4
 
 namespace fastonosql
 {
@@ -39,6 +85,7 @@ namespace fastonosql
             Common();
             explicit Common(const std::string& common_text);
             common::Value* valueByIndex(unsigned char index) const;
+            bool parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value);
 
             uint32_t pid_;
             uint32_t uptime_;
@@ -48,24 +95,106 @@ namespace fastonosql
             uint32_t rusage_user_;
             uint32_t rusage_system_;
             uint32_t curr_items_;
-            uint32_t total_items_;
-            uint32_t bytes_;
+            uint64_t total_items_;
+            uint64_t bytes_;
             uint32_t curr_connections_;
-            uint32_t total_connections_;
+            uint64_t total_connections_;
             uint32_t connection_structures_;
-            uint32_t cmd_get_;
-            uint32_t cmd_set_;
-            uint32_t get_hits_;
-            uint32_t get_misses_;
-            uint32_t evictions_;
-            uint32_t bytes_read_;
-            uint32_t bytes_written_;
-            uint32_t limit_maxbytes_;
+            uint64_t cmd_get_;
+            uint64_t cmd_set_;
+            uint64_t get_hits_;
+            uint64_t get_misses_;
+            uint64_t evictions_;
+            uint64_t bytes_read_;
+            uint64_t bytes_written_;
+            uint64_t limit_maxbytes_;
             uint32_t threads_;
         } common_;
 
+        struct Settings
+                : FieldByIndex
+        {
+            Settings();
+            explicit Settings(const std::string& settings_text);
+            common::Value* valueByIndex(unsigned char index) const;
+            bool parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value);
+
+            uint64_t maxbytes_;
+            uint32_t maxconns_;
+            uint32_t tcpport_;
+            std::string evictions_;
+            float growth_factor_;
+            uint32_t chunk_size_;
+            uint32_t num_threads_;
+            uint32_t item_size_max_;
+            std::string slab_reassign_;
+            uint32_t slab_automove_;
+        } settings_;
+
+        struct SlabClass
+        {
+            SlabClass();
+            explicit SlabClass(uint32_t id);
+
+            uint32_t id_;
+            uint32_t chunk_size_;
+            uint32_t chunks_per_page_;
+            uint32_t total_pages_;
+            uint32_t total_chunks_;
+            uint32_t used_chunks_;
+            uint32_t free_chunks_;
+            uint64_t mem_requested_;
+            uint64_t get_hits_;
+            uint64_t cmd_set_;
+        };
+
+        struct Slabs
+                : FieldByIndex
+        {
+            typedef std::vector<SlabClass> classes_container_type;
+
+            Slabs();
+            explicit Slabs(const std::string& slabs_text);
+            common::Value* valueByIndex(unsigned char index) const;
+            bool parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value);
+            const SlabClass* findClass(uint32_t id) const;
+
+            uint32_t active_slabs_;
+            uint64_t total_malloced_;
+            classes_container_type classes_;
+        } slabs_;
+
+        struct ItemClass
+        {
+            ItemClass();
+            explicit ItemClass(uint32_t id);
+
+            uint32_t id_;
+            uint32_t number_;
+            uint32_t age_;
+            uint64_t evicted_;
+            uint64_t evicted_nonzero_;
+            uint64_t outofmemory_;
+            uint64_t reclaimed_;
+        };
+
+        struct Items
+                : FieldByIndex
+        {
+            typedef std::vector<ItemClass> classes_container_type;
+
+            Items();
+            explicit Items(const std::string& items_text);
+            common::Value* valueByIndex(unsigned char index) const;
+            bool parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value);
+            const ItemClass* findClass(uint32_t id) const;
+
+            classes_container_type classes_;
+        } items_;
+
         MemcachedServerInfo();
         explicit MemcachedServerInfo(const Common& common);
+        MemcachedServerInfo(const Common& common, const Settings& settings, const Slabs& slabs, const Items& items);
         virtual common::Value* valueByIndexes(unsigned char property, unsigned char field) const;
         virtual std::string toString() const;
         virtual uint32_t version() const;
@@ -0,0 +1,175 @@
+#include "core/monitor_analyzer.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "common/macros.h"
+
+#define MONITOR_RING_SIZE 10000
+#define MONITOR_TOP_CAPACITY 1000
+
+namespace fastonosql
+{
+    MonitorEntry::MonitorEntry()
+        : time_(0), db_(0), client_(), command_(), key_(), line_()
+    {
+
+    }
+
+    std::string monitorKeyPrefix(const std::string& key)
+    {
+        std::string::size_type pos = key.find_last_of(":./|");
+        if(pos == std::string::npos){
+            return key;
+        }
+
+        return key.substr(0, pos + 1);
+    }
+
+    bool isKeylessCommand(const std::string& command)
+    {
+        static const char* const keyless[] = { "auth", "client", "cluster", "command", "config", "debug", "echo",
+                                               "eval", "evalsha", "info", "latency", "ping", "psubscribe",
+                                               "publish", "script", "select", "slowlog", "subscribe" };
+        for(size_t i = 0; i < SIZEOFMASS(keyless); ++i){
+            if(command == keyless[i]){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // only the command and its first argument are decoded (sdscatrepr escapes)
+    bool parseMonitorLine(const char* text, size_t size, MonitorEntry* entry)
+    {
+        const char* end = text + size;
+        const char* p = static_cast<const char*>(memchr(text, ' ', size));
+        if(!p || end - p < 2 || p[1] != '['){
+            return false;
+        }
+
+        entry->time_ = strtod(text, NULL);
+        p += 2;
+        const char* close = static_cast<const char*>(memchr(p, ']', end - p));
+        if(!close){
+            return false;
+        }
+
+        const char* space = static_cast<const char*>(memchr(p, ' ', close - p));
+        entry->db_ = atoi(p);
+        entry->client_.assign(space ? space + 1 : p, close);
+
+        entry->command_.clear();
+        entry->key_.clear();
+        p = close + 1;
+        for(int index = 0; index < 2; ++index){
+            while(p < end && *p == ' '){
+                ++p;
+            }
+            if(p >= end || *p != '"'){
+                break;
+            }
+
+            std::string& arg = index ? entry->key_ : entry->command_;
+            for(++p; p < end && *p != '"'; ++p){
+                if(*p != '\\' || p + 1 >= end){
+                    arg += *p;
+                    continue;
+                }
+
+                switch(*++p){
+                case 'n': arg += '\n'; break;
+                case 'r': arg += '\r'; break;
+                case 't': arg += '\t'; break;
+                case 'a': arg += '\a'; break;
+                case 'b': arg += '\b'; break;
+                case 'x':
+                    if(end - p > 2){
+                        char hex[3] = { p[1], p[2], 0 };
+                        arg += static_cast<char>(strtol(hex, NULL, 16));
+                        p += 2;
+                    }
+                    break;
+                default: arg += *p; break;
+                }
+            }
+            ++p;
+        }
+
+        std::transform(entry->command_.begin(), entry->command_.end(), entry->command_.begin(), ::tolower);
+        if(isKeylessCommand(entry->command_)){
+            entry->key_.clear();
+        }
+        entry->line_.assign(text, size);
+        return !entry->command_.empty();
+    }
+
+    MonitorSnapShot::MonitorSnapShot()
+        : msec_(0), total_(0), opsPerSec_(0), commands_(), keys_(), prefixes_(), clients_(), recent_()
+    {
+
+    }
+
+    MonitorAnalyzer::MonitorAnalyzer()
+        : ring_(MONITOR_RING_SIZE), head_(0), size_(0), commands_(MONITOR_TOP_CAPACITY), keys_(MONITOR_TOP_CAPACITY),
+          prefixes_(MONITOR_TOP_CAPACITY), clients_(MONITOR_TOP_CAPACITY), total_(0), lastTotal_(0), lastMsec_(0)
+    {
+
+    }
+
+    void MonitorAnalyzer::add(const MonitorEntry& entry)
+    {
+        // slots keep their string buffers, a full ring doesn't allocate
+        MonitorEntry& slot = ring_[head_];
+        slot.time_ = entry.time_;
+        slot.db_ = entry.db_;
+        slot.client_.assign(entry.client_);
+        slot.command_.assign(entry.command_);
+        slot.key_.assign(entry.key_);
+        slot.line_.assign(entry.line_);
+        head_ = (head_ + 1) % ring_.size();
+        if(size_ < ring_.size()){
+            ++size_;
+        }
+
+        commands_.add(entry.command_);
+        clients_.add(entry.client_);
+        if(!entry.key_.empty()){
+            keys_.add(entry.key_);
+            prefixes_.add(monitorKeyPrefix(entry.key_));
+        }
+        ++total_;
+    }
+
+    MonitorSnapShot MonitorAnalyzer::snapShot(common::time64_t msec, size_t topCount, size_t recentCount)
+    {
+        MonitorSnapShot shot;
+        shot.msec_ = msec;
+        shot.total_ = total_;
+        if(lastMsec_ && msec > lastMsec_){
+            shot.opsPerSec_ = (total_ - lastTotal_) * 1000.0 / (msec - lastMsec_);
+        }
+        lastMsec_ = msec;
+        lastTotal_ = total_;
+
+        shot.commands_ = commands_.top(topCount);
+        shot.keys_ = keys_.top(topCount);
+        shot.prefixes_ = prefixes_.top(topCount);
+        shot.clients_ = clients_.top(topCount);
+
+        const size_t count = std::min(recentCount, size_);
+        shot.recent_.reserve(count);
+        for(size_t i = count; i > 0; --i){
+            shot.recent_.push_back(ring_[(head_ + ring_.size() - i) % ring_.size()]);
+        }
+        return shot;
+    }
+
+    uint64_t MonitorAnalyzer::total() const
+    {
+        return total_;
+    }
+}
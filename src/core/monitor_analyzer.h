@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/time.h"
+
+#include "core/top_k.h"
+
+namespace fastonosql
+{
+    // one command of a monitored stream
+    struct MonitorEntry
+    {
+        MonitorEntry();
+
+        double time_; // sec since epoch, as the server stamped it
+        int db_;
+        std::string client_;
+        std::string command_; // lower case
+        std::string key_; // empty for commands without one
+        std::string line_;
+    };
+
+    // commands whose first argument isn't a key
+    bool isKeylessCommand(const std::string& command);
+    // 1339518083.107412 [0 127.0.0.1:60866] "set" "key" "value", as MONITOR
+    // sends it; text is NUL terminated
+    bool parseMonitorLine(const char* text, size_t size, MonitorEntry* entry);
+    // key up to its last ':' (or '.', '/', '|'), the whole key when it has none
+    std::string monitorKeyPrefix(const std::string& key);
+
+    struct MonitorSnapShot
+    {
+        MonitorSnapShot();
+
+        common::time64_t msec_;
+        uint64_t total_;
+        double opsPerSec_; // since the previous snapshot
+        std::vector<TopKItem> commands_;
+        std::vector<TopKItem> keys_;
+        std::vector<TopKItem> prefixes_;
+        std::vector<TopKItem> clients_;
+        std::vector<MonitorEntry> recent_; // the newest last
+    };
+
+    // Aggregates a monitored stream in fixed memory: the newest entries
+    // are kept in a ring, commands, keys, key prefixes and clients in
+    // space-saving counters. Not thread safe, it lives on the reading thread.
+    class MonitorAnalyzer
+    {
+    public:
+        MonitorAnalyzer();
+
+        void add(const MonitorEntry& entry);
+        MonitorSnapShot snapShot(common::time64_t msec, size_t topCount, size_t recentCount);
+
+        uint64_t total() const;
+
+    private:
+        std::vector<MonitorEntry> ring_;
+        size_t head_; // next slot to write
+        size_t size_;
+
+        TopK commands_;
+        TopK keys_;
+        TopK prefixes_;
+        TopK clients_;
+
+        uint64_t total_;
+        uint64_t lastTotal_;
+        common::time64_t lastMsec_;
+    };
+}
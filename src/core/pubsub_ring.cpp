@@ -0,0 +1,115 @@
+#include "core/pubsub_ring.h"
+
+#include <algorithm>
+
+namespace
+{
+    bool busierChannel(const fastonosql::PubSubChannelRate& lhs, const fastonosql::PubSubChannelRate& rhs)
+    {
+        if(lhs.perSec_ != rhs.perSec_){
+            return lhs.perSec_ > rhs.perSec_;
+        }
+        return lhs.total_ > rhs.total_;
+    }
+}
+
+namespace fastonosql
+{
+    PubSubMessage::PubSubMessage()
+        : msec_(0), pattern_(), channel_(), payload_()
+    {
+
+    }
+
+    PubSubRing::PubSubRing(int capacity)
+        : slots_(std::max(capacity, 1) + 1), head_(0), tail_(0), dropped_(0)
+    {
+
+    }
+
+    // the slot is filled before the release store of tail_ publishes it
+    bool PubSubRing::push(const PubSubMessage& msg)
+    {
+        const int tail = tail_.loadAcquire();
+        const int next = (tail + 1) % static_cast<int>(slots_.size());
+        if(next == head_.loadAcquire()){
+            dropped_.fetchAndAddRelaxed(1);
+            return false;
+        }
+
+        slots_[tail] = msg;
+        tail_.storeRelease(next);
+        return true;
+    }
+
+    size_t PubSubRing::pop(std::vector<PubSubMessage>* out, size_t maxCount)
+    {
+        int head = head_.loadAcquire();
+        const int tail = tail_.loadAcquire();
+        size_t count = 0;
+        while(head != tail && count < maxCount){
+            out->push_back(PubSubMessage());
+            std::swap(out->back(), slots_[head]);
+            head = (head + 1) % static_cast<int>(slots_.size());
+            head_.storeRelease(head);
+            ++count;
+        }
+        return count;
+    }
+
+    int PubSubRing::dropped() const
+    {
+        return dropped_.load();
+    }
+
+    PubSubChannelRate::PubSubChannelRate()
+        : channel_(), total_(0), perSec_(0)
+    {
+
+    }
+
+    PubSubChannelStats::Counter::Counter()
+        : total_(0), sinceTick_(0)
+    {
+
+    }
+
+    PubSubChannelStats::PubSubChannelStats()
+        : channels_(), lastTick_(0)
+    {
+
+    }
+
+    void PubSubChannelStats::add(const PubSubMessage& msg)
+    {
+        Counter& counter = channels_[msg.channel_];
+        counter.total_++;
+        counter.sinceTick_++;
+    }
+
+    std::vector<PubSubChannelRate> PubSubChannelStats::tick(common::time64_t msec)
+    {
+        const common::time64_t elapsed = lastTick_ && msec > lastTick_ ? msec - lastTick_ : 0;
+        lastTick_ = msec;
+
+        std::vector<PubSubChannelRate> rates;
+        rates.reserve(channels_.size());
+        for(std::map<std::string, Counter>::iterator it = channels_.begin(); it != channels_.end(); ++it){
+            PubSubChannelRate rate;
+            rate.channel_ = it->first;
+            rate.total_ = it->second.total_;
+            rate.perSec_ = elapsed ? it->second.sinceTick_ * 1000.0 / elapsed : 0;
+            it->second.sinceTick_ = 0;
+            rates.push_back(rate);
+        }
+
+        std::sort(rates.begin(), rates.end(), &busierChannel);
+        return rates;
+    }
+
+    void PubSubChannelStats::clear()
+    {
+        channels_.clear();
+        lastTick_ = 0;
+    }
+}
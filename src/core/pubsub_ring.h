@@ -0,0 +1,77 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <QAtomicInt>
+
+#include "common/smart_ptr.h"
+#include "common/time.h"
+
+namespace fastonosql
+{
+    struct PubSubMessage
+    {
+        PubSubMessage();
+
+        common::time64_t msec_; // when it was read
+        std::string pattern_; // empty unless it came through PSUBSCRIBE
+        std::string channel_;
+        std::string payload_;
+    };
+
+    // Bounded single producer, single consumer queue without locks: the
+    // stream thread pushes, the viewer pops. A full ring drops the new
+    // message and counts it, so a slow viewer never holds up the reader.
+    class PubSubRing
+    {
+    public:
+        explicit PubSubRing(int capacity);
+
+        bool push(const PubSubMessage& msg); // producer only
+        size_t pop(std::vector<PubSubMessage>* out, size_t maxCount); // consumer only, appends to out
+
+        int dropped() const;
+
+    private:
+        std::vector<PubSubMessage> slots_; // one is always left free
+        QAtomicInt head_; // next to pop
+        QAtomicInt tail_; // next to push
+        QAtomicInt dropped_;
+    };
+
+    typedef common::shared_ptr<PubSubRing> PubSubRingSPtr;
+
+    struct PubSubChannelRate
+    {
+        PubSubChannelRate();
+
+        std::string channel_;
+        uint64_t total_;
+        double perSec_; // over the last tick
+    };
+
+    // per channel message counts, ticked by the viewer
+    class PubSubChannelStats
+    {
+    public:
+        PubSubChannelStats();
+
+        void add(const PubSubMessage& msg);
+        std::vector<PubSubChannelRate> tick(common::time64_t msec); // busiest first
+        void clear();
+
+    private:
+        struct Counter
+        {
+            Counter();
+
+            uint64_t total_;
+            uint64_t sinceTick_;
+        };
+
+        std::map<std::string, Counter> channels_;
+        common::time64_t lastTick_;
+    };
+}
@@ -46,6 +46,8 @@ namespace fastonosql
                 } else if (!strcmp(argv[i],"--latency-history")) {
                     cfg.latency_mode = 1;
                     cfg.latency_history = 1;
+                } else if (!strcmp(argv[i],"--latency-connections") && !lastarg) {
+                    cfg.latency_connections = atoi(argv[++i]);
                 } else if (!strcmp(argv[i],"--slave")) {
                     cfg.slave_mode = 1;
                 } else if (!strcmp(argv[i],"--stat")) {
@@ -74,6 +76,9 @@ namespace fastonosql
                 else if (!strcmp(argv[i],"-d") && !lastarg) {
                     cfg.mb_delim_ = argv[++i];
                 }
+                else if (!strcmp(argv[i],"--command-timeout") && !lastarg) {
+                    cfg.command_timeout = atoi(argv[++i]);
+                }
                 /*else if (!strcmp(argv[i],"-v") || !strcmp(argv[i], "--version")) {
                     sds version = cliVersion();
                     printf("redis-cli %s\n", version);
@@ -130,6 +135,7 @@ namespace fastonosql
         pubsub_mode = other.pubsub_mode;
         latency_mode = other.latency_mode;
         latency_history = other.latency_history;
+        latency_connections = other.latency_connections;
         cluster_mode = other.cluster_mode;
         cluster_reissue_command = other.cluster_reissue_command;
         slave_mode = other.slave_mode;
@@ -152,6 +158,7 @@ namespace fastonosql
         eval = strdupornull(other.eval); //
 
         last_cmd_type = other.last_cmd_type;
+        command_timeout = other.command_timeout;
 
         RemoteConfig::operator=(other);
     }
@@ -167,6 +174,7 @@ namespace fastonosql
         pubsub_mode = 0;
         latency_mode = 0;
         latency_history = 0;
+        latency_connections = 1;
         cluster_mode = 0;
         slave_mode = 0;
         getrdb_mode = 0;
@@ -181,6 +189,7 @@ namespace fastonosql
         auth = NULL;
         eval = NULL;
         last_cmd_type = -1;
+        command_timeout = 0;
     }
 
     redisConfig::~redisConfig()
@@ -231,6 +240,10 @@ namespace common
                 argv.push_back("--latency");
             }
         }
+        if(conf.latency_connections > 1){
+            argv.push_back("--latency-connections");
+            argv.push_back(convertToString(conf.latency_connections));
+        }
 
         if(conf.slave_mode){
             argv.push_back("--slave");
@@ -247,7 +260,6 @@ namespace common
         }
         if(conf.intrinsic_latency_mode){
             argv.push_back("--intrinsic-latency");
-            argv.push_back(convertToString(conf.intrinsic_latency_mode));
             argv.push_back(convertToString(conf.intrinsic_latency_duration));
         }
 
@@ -268,6 +280,11 @@ namespace common
             argv.push_back("-c");
         }
 
+        if(conf.command_timeout){
+            argv.push_back("--command-timeout");
+            argv.push_back(convertToString(conf.command_timeout));
+        }
+
         std::string result;
         for(int i = 0; i < argv.size(); ++i){
             result+= argv[i];
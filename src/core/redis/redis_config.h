@@ -24,6 +24,7 @@ namespace fastonosql
         int pubsub_mode;
         int latency_mode;
         int latency_history;
+        int latency_connections; // parallel probes of latency mode
         int cluster_mode;
         int cluster_reissue_command;
         int slave_mode;
@@ -38,6 +39,7 @@ namespace fastonosql
         char *auth;
         char *eval;
         int last_cmd_type;
+        int command_timeout; // msec to wait for a reply, 0 waits until interrupted
 
     protected:
         void copy(const redisConfig& other);
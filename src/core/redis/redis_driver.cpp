@@ -22,10 +22,21 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <limits.h>
+
+#include <algorithm>
+#include <map>
+
+#include <QFile>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QMutexLocker>
+
 #ifdef OS_POSIX
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #endif
 
 extern "C" {
@@ -41,13 +52,21 @@ extern "C" {
 #include "common/file_system.h"
 #include "common/string_util.h"
 #include "common/sprintf.h"
+#include "common/qt/convert_string.h"
 #include "fasto/qt/logger.h"
 
 #include "core/command_logger.h"
 #include "core/redis/redis_infos.h"
+#include "core/redis/redis_latency.h"
+#include "core/latency_histogram.h"
+#include "core/benchmark.h"
+#include "core/monitor_analyzer.h"
+#include "core/keyspace_analyzer.h"
 
 #define HIREDIS_VERSION STRINGIZE(HIREDIS_MAJOR) "." STRINGIZE(HIREDIS_MINOR) "." STRINGIZE(HIREDIS_PATCH)
 #define REDIS_CLI_KEEPALIVE_INTERVAL 15 /* seconds */
+#define REPLY_POLL_SLICE_MSEC 100
+#define MONITORING_TIMEOUT_SEC 5
 #define CLI_HELP_COMMAND 1
 #define CLI_HELP_GROUP 2
 
@@ -55,6 +74,13 @@ extern "C" {
 #define SYNC_REQUEST "SYNC"
 #define FIND_BIG_KEYS_REQUEST "FIND_BIG_KEYS"
 #define LATENCY_REQUEST "LATENCY"
+#define INTRINSIC_LATENCY_REQUEST "INTRINSIC LATENCY"
+#define COMMANDSTATS_REQUEST "INFO commandstats"
+#define LATENCY_LATEST_REQUEST "LATENCY LATEST"
+#define SLOWLOG_LATEST_REQUEST "SLOWLOG GET 10"
+#define SLOWLOG_POLL_REQUEST "SLOWLOG GET 128"
+#define SLOWLOG_LEN_REQUEST "SLOWLOG LEN"
+#define CLIENT_LIST_REQUEST "CLIENT LIST"
 #define GET_DATABASES "CONFIG GET databases"
 #define SET_DEFAULT_DATABASE "SELECT "
 #define DELETE_KEY_PATTERN_1ARGS_S "DEL %s"
@@ -64,6 +90,20 @@ extern "C" {
 #define GET_KEY_SET_PATTERN_1ARGS_S "SMEMBERS %s"
 #define GET_KEY_ZSET_PATTERN_1ARGS_S "ZRANGE %s 0 -1"
 #define GET_KEY_HASH_PATTERN_1ARGS_S "HGETALL %s"
+#define GET_KEY_STREAM_PATTERN_1ARGS_S "XRANGE %s - +"
+
+#define GET_KEY_PAGE_PATTERN_3ARGS_SLL "GETRANGE %s %lld %lld"
+#define GET_KEY_LIST_PAGE_PATTERN_3ARGS_SLL "LRANGE %s %lld %lld"
+#define GET_KEY_SET_PAGE_PATTERN_3ARGS_SSI "SSCAN %s %s COUNT %d"
+#define GET_KEY_ZSET_PAGE_PATTERN_3ARGS_SSI "ZSCAN %s %s COUNT %d"
+#define GET_KEY_HASH_PAGE_PATTERN_3ARGS_SSI "HSCAN %s %s COUNT %d"
+#define GET_KEY_STREAM_PAGE_PATTERN_3ARGS_SSI "XRANGE %s %s + COUNT %d"
+#define GET_KEY_STREAM_GROUPS_PATTERN_1ARGS_S "XINFO GROUPS %s"
+#define GET_KEY_STREAM_PENDING_PATTERN_2ARGS_SS "XPENDING %s %s"
+
+#define LOAD_PAGE_SIZE 1000
+#define LOAD_STRING_PAGE_BYTES 65536
+#define LOAD_MAX_CURSORS_KEYS 64
 
 #define SET_KEY_PATTERN_2ARGS_SS "SET %s %s"
 #define SET_KEY_LIST_PATTERN_2ARGS_SS "LPUSH %s %s"
@@ -75,6 +115,7 @@ extern "C" {
 #define PERSIST_KEY_1ARGS_S "PERSIST %s"
 
 #define GET_KEYS_PATTERN_3ARGS_ISI "SCAN %d MATCH %s COUNT %d"
+#define GET_KEYS_TYPE_PATTERN_4ARGS_ISIS "SCAN %d MATCH %s COUNT %d TYPE %s"
 
 #define GET_SERVER_TYPE "CLUSTER NODES"
 #define SHUTDOWN "shutdown"
@@ -83,19 +124,33 @@ extern "C" {
 #define SET_MAX_CONNECTIONS_1ARGS_I "CONFIG SET maxclients %d"
 #define GET_PROPERTY_SERVER "CONFIG GET *"
 #define STAT_MODE_REQUEST "STAT"
+#define MONITOR_REQUEST "MONITOR"
+#define MONITOR_SNAPSHOT_MSEC 500
+#define MONITOR_TOP_COUNT 20
+#define MONITOR_RECENT_COUNT 100
+#define PUBSUB_MESSAGE_REPLY "message"
+#define PUBSUB_PMESSAGE_REPLY "pmessage"
+#define KEYSPACE_GET_FLAGS_REQUEST "CONFIG GET notify-keyspace-events"
+#define KEYSPACE_SET_FLAGS_PATTERN_1ARGS_B "CONFIG SET notify-keyspace-events %b"
+#define KEYSPACE_EVENT_CLASSES "A$eghlmnstxzd"
+#define KEYSPACE_SNAPSHOT_MSEC 500
+#define KEYSPACE_TOP_COUNT 20
 #define SCAN_MODE_REQUEST "SCAN"
 #define RDM_REQUEST "RDM"
 #define BACKUP "SAVE"
 
 #define LATENCY_SAMPLE_RATE 10 /* milliseconds. */
 #define LATENCY_HISTORY_DEFAULT_INTERVAL 15000 /* milliseconds. */
+#define INTRINSIC_LATENCY_DEFAULT_DURATION 5 /* seconds. */
+#define INTRINSIC_LATENCY_CHECK_RUNS 100000
 
 #define RTYPE_STRING 0
 #define RTYPE_LIST   1
 #define RTYPE_SET    2
 #define RTYPE_HASH   3
 #define RTYPE_ZSET   4
-#define RTYPE_NONE   5
+#define RTYPE_STREAM 5
+#define RTYPE_NONE   6
 
 #define ANET_OK 0
 #define ANET_ERR -1
@@ -206,6 +261,26 @@ namespace
         }
     } rInit;
 
+    std::string convertToStringRType(common::Value::Type type)
+    {
+        switch(type){
+        case common::Value::TYPE_STRING:
+            return "string";
+        case common::Value::TYPE_ARRAY:
+            return "list";
+        case common::Value::TYPE_SET:
+            return "set";
+        case common::Value::TYPE_HASH:
+            return "hash";
+        case common::Value::TYPE_ZSET:
+            return "zset";
+        case fastonosql::TYPE_STREAM:
+            return "stream";
+        default:
+            return std::string();
+        }
+    }
+
     common::Value::Type convertFromStringRType(const std::string& type)
     {
         if(type.empty()){
@@ -227,6 +302,9 @@ namespace
         else if(type == "zset") {
             return common::Value::TYPE_ZSET;
         }
+        else if(type == "stream") {
+            return fastonosql::TYPE_STREAM;
+        }
         else {
             return common::Value::TYPE_NULL;
         }
@@ -256,6 +334,8 @@ namespace fastonosql
                 return RTYPE_HASH;
             } else if(!strcmp(type, "zset")) {
                 return RTYPE_ZSET;
+            } else if(!strcmp(type, "stream")) {
+                return RTYPE_STREAM;
             } else if(!strcmp(type, "none")) {
                 return RTYPE_NONE;
             } else {
@@ -265,6 +345,151 @@ namespace fastonosql
                 return -1;
             }
         }
+
+        const char* sizeCommand(common::Value::Type type)
+        {
+            switch(type){
+            case common::Value::TYPE_STRING:
+                return "STRLEN ";
+            case common::Value::TYPE_ARRAY:
+                return "LLEN ";
+            case common::Value::TYPE_SET:
+                return "SCARD ";
+            case common::Value::TYPE_ZSET:
+                return "ZCARD ";
+            case common::Value::TYPE_HASH:
+                return "HLEN ";
+            case TYPE_STREAM:
+                return "XLEN ";
+            default:
+                return NULL;
+            }
+        }
+
+        bool isPagedType(common::Value::Type type)
+        {
+            return sizeCommand(type) != NULL;
+        }
+
+        bool isScanType(common::Value::Type type)
+        {
+            return type == common::Value::TYPE_SET || type == common::Value::TYPE_ZSET || type == common::Value::TYPE_HASH;
+        }
+
+        // pages reachable only through a cursor given by the previous page
+        bool isCursorType(common::Value::Type type)
+        {
+            return isScanType(type) || type == TYPE_STREAM;
+        }
+
+        std::string firstCursor(common::Value::Type type)
+        {
+            return type == TYPE_STREAM ? "-" : "0";
+        }
+
+        // smallest stream id after "ms-seq", XRANGE has no exclusive start before 6.2
+        std::string nextStreamId(const std::string& id)
+        {
+            size_t pos = id.find('-');
+            if(pos == std::string::npos){
+                return id + "-1";
+            }
+
+            unsigned long long ms = strtoull(id.c_str(), NULL, 10);
+            unsigned long long seq = strtoull(id.c_str() + pos + 1, NULL, 10);
+            if(seq == ULLONG_MAX){
+                ++ms;
+                seq = 0;
+            }
+            else{
+                ++seq;
+            }
+
+            char buff[64] = {0};
+            common::SNPrintf(buff, sizeof(buff), "%llu-%llu", ms, seq);
+            return buff;
+        }
+
+        bool isStreamRangeCommand(const char* command)
+        {
+            return !strcasecmp(command, "xrange") || !strcasecmp(command, "xrevrange");
+        }
+
+        std::string pageCommand(common::Value::Type type, const std::string& key, uint32_t page, const std::string& cursor)
+        {
+            char patternResult[1024] = {0};
+            if(type == common::Value::TYPE_STRING){
+                long long begin = static_cast<long long>(page) * LOAD_STRING_PAGE_BYTES;
+                common::SNPrintf(patternResult, sizeof(patternResult), GET_KEY_PAGE_PATTERN_3ARGS_SLL, key, begin, begin + LOAD_STRING_PAGE_BYTES - 1);
+            }
+            else if(type == common::Value::TYPE_ARRAY){
+                long long begin = static_cast<long long>(page) * LOAD_PAGE_SIZE;
+                common::SNPrintf(patternResult, sizeof(patternResult), GET_KEY_LIST_PAGE_PATTERN_3ARGS_SLL, key, begin, begin + LOAD_PAGE_SIZE - 1);
+            }
+            else if(type == common::Value::TYPE_SET){
+                common::SNPrintf(patternResult, sizeof(patternResult), GET_KEY_SET_PAGE_PATTERN_3ARGS_SSI, key, cursor, LOAD_PAGE_SIZE);
+            }
+            else if(type == common::Value::TYPE_ZSET){
+                common::SNPrintf(patternResult, sizeof(patternResult), GET_KEY_ZSET_PAGE_PATTERN_3ARGS_SSI, key, cursor, LOAD_PAGE_SIZE);
+            }
+            else if(type == TYPE_STREAM){
+                common::SNPrintf(patternResult, sizeof(patternResult), GET_KEY_STREAM_PAGE_PATTERN_3ARGS_SSI, key, cursor, LOAD_PAGE_SIZE);
+            }
+            else{
+                common::SNPrintf(patternResult, sizeof(patternResult), GET_KEY_HASH_PAGE_PATTERN_3ARGS_SSI, key, cursor, LOAD_PAGE_SIZE);
+            }
+            return patternResult;
+        }
+
+        // elements (bytes for strings) in a page reply, *SCAN and stream replies also give the next cursor
+        size_t pageReplySize(FastoObjectCommand* cmd, common::Value::Type type, std::string* cursor)
+        {
+            *cursor = "0";
+            const FastoObject::child_container_type& rchildrens = cmd->childrens();
+            if(rchildrens.size() != 1){
+                return 0;
+            }
+
+            if(type == common::Value::TYPE_STRING){
+                return rchildrens[0]->toString().size();
+            }
+
+            if(type == TYPE_STREAM){
+                StreamValue* stream = dynamic_cast<StreamValue*>(rchildrens[0]->value());
+                if(!stream || !stream->size()){
+                    return 0;
+                }
+
+                *cursor = nextStreamId(stream->lastId());
+                return stream->size();
+            }
+
+            FastoObjectArray* array = dynamic_cast<FastoObjectArray*>(rchildrens[0]);
+            if(!array){
+                return 0;
+            }
+
+            if(!isScanType(type)){
+                return array->size();
+            }
+
+            if(!array->getString(0, cursor)){
+                *cursor = "0";
+                return 0;
+            }
+
+            const FastoObject::child_container_type& echildrens = array->childrens();
+            if(echildrens.size() != 1){
+                return 0;
+            }
+
+            FastoObjectArray* elements = dynamic_cast<FastoObjectArray*>(echildrens[0]);
+            if(!elements){
+                return 0;
+            }
+
+            return elements->size();
+        }
     }
 
     namespace
@@ -333,6 +558,77 @@ namespace fastonosql
             SSHInfo sinfo = settings->sshInfo();
             return createConnection(config, sinfo, context);
         }
+
+        // a connection of its own, the whole batch is sent before the first reply is read
+        class RedisBenchmarkClient
+                : public BenchmarkClient
+        {
+        public:
+            explicit RedisBenchmarkClient(redisContext* context)
+                : context_(context)
+            {
+
+            }
+
+            virtual ~RedisBenchmarkClient()
+            {
+                redisFree(context_);
+            }
+
+            virtual common::Error execute(const std::vector<BenchmarkRequest>& batch, const std::string& value)
+            {
+                for(size_t i = 0; i < batch.size(); ++i){
+                    const BenchmarkRequest& req = batch[i];
+                    const char* argv[3] = { req.write_ ? "SET" : "GET", req.key_.c_str(), value.data() };
+                    size_t argvlen[3] = { 3, req.key_.size(), req.valueSize_ };
+                    redisAppendCommandArgv(context_, req.write_ ? 3 : 2, argv, argvlen);
+                }
+
+                common::Error er;
+                for(size_t i = 0; i < batch.size(); ++i){
+                    redisReply* reply = NULL;
+                    if(redisGetReply(context_, (void**)&reply) != REDIS_OK){
+                        char buff[512] = {0};
+                        common::SNPrintf(buff, sizeof(buff), "Benchmark error: %s", context_->errstr);
+                        return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                    }
+
+                    if(reply->type == REDIS_REPLY_ERROR && !er){
+                        er = common::make_error_value(std::string(reply->str, reply->len), common::ErrorValue::E_ERROR);
+                    }
+                    freeReplyObject(reply);
+                }
+
+                return er;
+            }
+
+            virtual common::Error remove(const std::vector<std::string>& keys)
+            {
+                std::vector<const char*> argv(1, "DEL");
+                std::vector<size_t> argvlen(1, 3);
+                for(size_t i = 0; i < keys.size(); ++i){
+                    argv.push_back(keys[i].c_str());
+                    argvlen.push_back(keys[i].size());
+                }
+
+                redisReply* reply = static_cast<redisReply*>(redisCommandArgv(context_, argv.size(), &argv[0], &argvlen[0]));
+                if(!reply){
+                    char buff[512] = {0};
+                    common::SNPrintf(buff, sizeof(buff), "Benchmark error: %s", context_->errstr);
+                    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                }
+
+                common::Error er;
+                if(reply->type == REDIS_REPLY_ERROR){
+                    er = common::make_error_value(std::string(reply->str, reply->len), common::ErrorValue::E_ERROR);
+                }
+                freeReplyObject(reply);
+                return er;
+            }
+
+        private:
+            redisContext* const context_;
+        };
     }
 
     common::Error testConnection(RedisConnectionSettings* settings)
@@ -384,104 +680,1060 @@ namespace fastonosql
     struct RedisDriver::pimpl
     {
         pimpl(RedisDriver* parent)
-            : parent_(parent), context_(NULL), isAuth_(false)
+            : parent_(parent), context_(NULL), connected_(0), isAuth_(false), monitoring_context_(NULL), monitoring_lock_(),
+              monitoring_config_(), monitoring_reset_(false), slowlog_len_(-1)
+        {
+
+        }
+
+        ~pimpl()
+        {
+            if(context_){
+                redisFree(context_);
+                context_ = NULL;
+            }
+
+            QMutexLocker lock(&monitoring_lock_);
+            if(monitoring_context_){
+                redisFree(monitoring_context_);
+                monitoring_context_ = NULL;
+            }
+        }
+
+        RedisDriver* parent_;
+        redisContext *context_;
+        // follows context_ for the monitoring strand, which must not read it
+        QAtomicInt connected_;
+        redisConfig config_;
+        SSHInfo sinfo_;
+        bool isAuth_;
+        std::map<std::string, std::vector<std::string> > scan_cursors_; // by "<db>:<key>", a name is reused across databases
+
+        // INFO sampling connection, used on the monitoring strand and freed on disconnect,
+        // both under monitoring_lock_; it and the extra connections follow the command
+        // one through monitoring_config_
+        redisContext* monitoring_context_;
+        QMutex monitoring_lock_;
+        redisConfig monitoring_config_;
+        SSHInfo monitoring_sinfo_;
+        bool monitoring_reset_;
+        long long slowlog_len_; // SLOWLOG LEN at the previous poll, -1 unknown
+
+        void resetMonitoring()
+        {
+            QMutexLocker lock(&monitoring_lock_);
+            monitoring_config_ = config_;
+            monitoring_sinfo_ = sinfo_;
+            monitoring_reset_ = true;
+        }
+
+        // the INFO sampling connection, (re)opened as the command one changes;
+        // called with monitoring_lock_ held
+        common::Error monitoringConnection() WARN_UNUSED_RESULT
+        {
+            const redisConfig config = monitoring_config_;
+            const SSHInfo sinfo = monitoring_sinfo_;
+            const bool reset = monitoring_reset_;
+            monitoring_reset_ = false;
+
+            if(reset){
+                slowlog_len_ = -1;
+            }
+
+            if(reset && monitoring_context_){
+                redisFree(monitoring_context_);
+                monitoring_context_ = NULL;
+            }
+
+            if(!monitoring_context_){
+                redisContext* context = NULL;
+                common::Error er = createConnection(config, sinfo, &context);
+                if(er){
+                    return er;
+                }
+
+                // a sample is dropped rather than waited for
+                struct timeval timeout;
+                timeout.tv_sec = MONITORING_TIMEOUT_SEC;
+                timeout.tv_usec = 0;
+                redisSetTimeout(context, timeout);
+
+                if(config.auth){
+                    redisReply* reply = static_cast<redisReply*>(redisCommand(context, "AUTH %s", config.auth));
+                    bool authed = reply && reply->type != REDIS_REPLY_ERROR;
+                    if(reply){
+                        freeReplyObject(reply);
+                    }
+
+                    if(!authed){
+                        redisFree(context);
+                        return common::make_error_value("Monitoring connection AUTH failed", common::ErrorValue::E_ERROR);
+                    }
+                }
+                monitoring_context_ = context;
+            }
+
+            return common::Error();
+        }
+
+        // a failed command leaves the monitoring connection in an unknown state, it is reopened next time
+        common::Error monitoringCommand(const char* command, redisReply** reply) WARN_UNUSED_RESULT
+        {
+            common::Error er = monitoringConnection();
+            if(er){
+                return er;
+            }
+
+            *reply = static_cast<redisReply*>(redisCommand(monitoring_context_, command));
+            if(!*reply){
+                char buff[512] = {0};
+                common::SNPrintf(buff, sizeof(buff), "Monitoring %s error: %s", command, monitoring_context_->errstr);
+                redisFree(monitoring_context_);
+                monitoring_context_ = NULL;
+                return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+            }
+
+            return common::Error();
+        }
+
+        common::Error monitoringInfo(ServerInfo** info) WARN_UNUSED_RESULT
+        {
+            QMutexLocker lock(&monitoring_lock_);
+            redisReply* reply = NULL;
+            common::Error er = monitoringCommand(INFO_REQUEST, &reply);
+            if(er){
+                return er;
+            }
+
+            if(reply->type == REDIS_REPLY_STRING){
+                *info = makeRedisServerInfo(std::string(reply->str, reply->len));
+            }
+            freeReplyObject(reply);
+
+            if(*info == NULL){
+                return common::make_error_value("Invalid " INFO_REQUEST " command output", common::ErrorValue::E_ERROR);
+            }
+
+            return common::Error();
+        }
+
+        // entries newer than afterId, oldest first; more than SLOWLOG_POLL_REQUEST
+        // returns between two polls are lost. A log which got shorter was reset
+        // (SLOWLOG RESET or a restart, which also starts the ids over), as is one
+        // whose newest id is below afterId; the whole log is returned then
+        common::Error monitoringSlowLog(int64_t afterId, std::vector<SlowLogEntry>* entries) WARN_UNUSED_RESULT
+        {
+            QMutexLocker lock(&monitoring_lock_);
+            redisReply* reply = NULL;
+            common::Error er = monitoringCommand(SLOWLOG_LEN_REQUEST, &reply);
+            if(er){
+                return er;
+            }
+
+            if(reply->type == REDIS_REPLY_INTEGER){
+                if(isSlowLogShrunk(reply->integer, slowlog_len_)){
+                    afterId = -1;
+                }
+                slowlog_len_ = reply->integer;
+            }
+            freeReplyObject(reply);
+
+            reply = NULL;
+            er = monitoringCommand(SLOWLOG_POLL_REQUEST, &reply);
+            if(er){
+                return er;
+            }
+
+            if(reply->type == REDIS_REPLY_ERROR){
+                er = common::make_error_value(std::string(reply->str, reply->len), common::ErrorValue::E_ERROR);
+            }
+            else if(reply->type != REDIS_REPLY_ARRAY){
+                er = common::make_error_value("Invalid " SLOWLOG_POLL_REQUEST " command output", common::ErrorValue::E_ERROR);
+            }
+            else{
+                parseSlowLogEntries(reply, afterId, entries);
+            }
+            freeReplyObject(reply);
+            return er;
+        }
+
+        common::Error monitoringClientList(ClientList* list) WARN_UNUSED_RESULT
+        {
+            QMutexLocker lock(&monitoring_lock_);
+            redisReply* reply = NULL;
+            common::Error er = monitoringCommand(CLIENT_LIST_REQUEST, &reply);
+            if(er){
+                return er;
+            }
+
+            if(reply->type == REDIS_REPLY_STRING){
+                *list = ClientList(std::string(reply->str, reply->len));
+            }
+            else if(reply->type == REDIS_REPLY_ERROR){
+                er = common::make_error_value(std::string(reply->str, reply->len), common::ErrorValue::E_ERROR);
+            }
+            else{
+                er = common::make_error_value("Invalid " CLIENT_LIST_REQUEST " command output", common::ErrorValue::E_ERROR);
+            }
+            freeReplyObject(reply);
+            return er;
+        }
+
+        // pipelined, the filter form skips the monitoring connection itself (SKIPME yes)
+        common::Error monitoringClientKill(const std::vector<uint64_t>& ids, size_t* killed) WARN_UNUSED_RESULT
+        {
+            QMutexLocker lock(&monitoring_lock_);
+            common::Error er = monitoringConnection();
+            if(er){
+                return er;
+            }
+
+            for(size_t i = 0; i < ids.size(); ++i){
+                redisAppendCommand(monitoring_context_, "CLIENT KILL ID %llu", static_cast<unsigned long long>(ids[i]));
+            }
+
+            for(size_t i = 0; i < ids.size(); ++i){
+                void* r = NULL;
+                if(redisGetReply(monitoring_context_, &r) == REDIS_ERR){
+                    char buff[512] = {0};
+                    common::SNPrintf(buff, sizeof(buff), "Monitoring CLIENT KILL error: %s", monitoring_context_->errstr);
+                    redisFree(monitoring_context_);
+                    monitoring_context_ = NULL;
+                    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                }
+
+                redisReply* reply = static_cast<redisReply*>(r);
+                if(reply->type == REDIS_REPLY_INTEGER){
+                    *killed += reply->integer;
+                }
+                else if(reply->type == REDIS_REPLY_ERROR && !er){
+                    er = common::make_error_value(std::string(reply->str, reply->len), common::ErrorValue::E_ERROR);
+                }
+                freeReplyObject(reply);
+            }
+            return er;
+        }
+
+        common::Error monitoringCommandStats(command_stats_t* stats) WARN_UNUSED_RESULT
+        {
+            QMutexLocker lock(&monitoring_lock_);
+            redisReply* reply = NULL;
+            common::Error er = monitoringCommand(COMMANDSTATS_REQUEST, &reply);
+            if(er){
+                return er;
+            }
+
+            if(reply->type == REDIS_REPLY_STRING){
+                const redis_command_stats_t redisStats = makeRedisCommandStats(std::string(reply->str, reply->len));
+                for(redis_command_stats_t::const_iterator it = redisStats.begin(); it != redisStats.end(); ++it){
+                    CommandStat& stat = (*stats)[it->first];
+                    stat.calls_ = it->second.calls_;
+                    stat.usec_ = it->second.usec_;
+                }
+            }
+            else if(reply->type == REDIS_REPLY_ERROR){
+                er = common::make_error_value(std::string(reply->str, reply->len), common::ErrorValue::E_ERROR);
+            }
+            else{
+                er = common::make_error_value("Invalid " COMMANDSTATS_REQUEST " command output", common::ErrorValue::E_ERROR);
+            }
+            freeReplyObject(reply);
+            return er;
+        }
+
+        /*------------------------------------------------------------------------------
+         * Latency and latency history modes
+         *--------------------------------------------------------------------------- */
+
+        // one more connection (latency probe, benchmark, streams), authenticated like the command one;
+        // streams open it on their own strand, so the settings come from the monitoring snapshot
+        common::Error extraConnection(redisContext** context) WARN_UNUSED_RESULT
         {
+            redisConfig config;
+            SSHInfo sinfo;
+            {
+                QMutexLocker lock(&monitoring_lock_);
+                config = monitoring_config_;
+                sinfo = monitoring_sinfo_;
+            }
+
+            common::Error er = createConnection(config, sinfo, context);
+            if(er){
+                return er;
+            }
+
+            if(config.auth){
+                redisReply* reply = static_cast<redisReply*>(redisCommand(*context, "AUTH %s", config.auth));
+                bool authed = reply && reply->type != REDIS_REPLY_ERROR;
+                if(reply){
+                    freeReplyObject(reply);
+                }
+
+                if(!authed){
+                    redisFree(*context);
+                    *context = NULL;
+                    return common::make_error_value("AUTH failed on an extra connection", common::ErrorValue::E_ERROR);
+                }
+            }
+
+            return common::Error();
+        }
+
+        common::Error latencyContextError(redisContext* context) WARN_UNUSED_RESULT
+        {
+            char buff[512] = {0};
+            common::SNPrintf(buff, sizeof(buff), "Latency probe error: %s", context->errstr);
+            return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+        }
+
+        // PING on every connection at once, each reply is timed from its own send
+        // and read as soon as its socket has data, so connections don't wait for
+        // each other
+        common::Error latencyRound(const std::vector<redisContext*>& contexts, std::vector<uint64_t>* latencies) WARN_UNUSED_RESULT
+        {
+            std::vector<uint64_t> sent(contexts.size(), 0);
+            for(size_t i = 0; i < contexts.size(); ++i){
+                redisAppendCommand(contexts[i], "PING");
+                sent[i] = monotonicNsec();
+                int done = 0;
+                while(!done){
+                    if(redisBufferWrite(contexts[i], &done) == REDIS_ERR){
+                        return latencyContextError(contexts[i]);
+                    }
+                }
+            }
+
+            std::vector<bool> pending(contexts.size(), true);
+            size_t left = contexts.size();
+            while(left){
+                if(parent_->interrupt_.loadAcquire()){
+                    return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+                }
+
+                std::vector<bool> readable(contexts.size(), false);
+                bool ready = false;
+                for(size_t i = 0; i < contexts.size(); ++i){
+                    if(pending[i] && contexts[i]->channel && libssh2_poll_channel_read(contexts[i]->channel, 0)){
+                        readable[i] = ready = true;
+                    }
+                }
+
+                if(!ready){
+                    std::vector<struct pollfd> pfds;
+                    std::vector<size_t> owners;
+                    for(size_t i = 0; i < contexts.size(); ++i){
+                        if(!pending[i]){
+                            continue;
+                        }
+
+                        struct pollfd pfd;
+                        pfd.fd = contexts[i]->fd;
+                        pfd.events = POLLIN;
+                        pfd.revents = 0;
+                        pfds.push_back(pfd);
+                        owners.push_back(i);
+                    }
+#ifdef OS_WIN
+                    int res = WSAPoll(&pfds[0], pfds.size(), REPLY_POLL_SLICE_MSEC);
+#else
+                    int res = poll(&pfds[0], pfds.size(), REPLY_POLL_SLICE_MSEC);
+#endif
+                    if(res < 0 && errno != EINTR){
+                        char buff[256] = {0};
+                        common::SNPrintf(buff, sizeof(buff), "Wait for reply error: %s", strerror(errno));
+                        return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                    }
+
+                    for(size_t j = 0; res > 0 && j < pfds.size(); ++j){
+                        if(pfds[j].revents){
+                            readable[owners[j]] = true;
+                        }
+                    }
+                }
+
+                for(size_t i = 0; i < contexts.size(); ++i){
+                    if(!readable[i]){
+                        continue;
+                    }
+
+                    if(redisBufferRead(contexts[i]) == REDIS_ERR){
+                        return latencyContextError(contexts[i]);
+                    }
+
+                    const uint64_t now = monotonicNsec();
+                    void* reply = NULL;
+                    if(redisGetReplyFromReader(contexts[i], &reply) == REDIS_ERR){
+                        return latencyContextError(contexts[i]);
+                    }
+
+                    if(reply){
+                        latencies->push_back(now - sent[i]);
+                        freeReplyObject(reply);
+                        pending[i] = false;
+                        --left;
+                    }
+                }
+            }
+
+            return common::Error();
+        }
+
+        // samples go to a window histogram which is logged to the latency history
+        // every interval; --latency shows all samples so far, --latency-history
+        // a row per window
+        common::Error latencySamples(FastoObjectCommand* cmd, const std::vector<redisContext*>& contexts) WARN_UNUSED_RESULT
+        {
+            const common::time64_t window_interval =
+                    config_.interval ? config_.interval/1000 :
+                                      LATENCY_HISTORY_DEFAULT_INTERVAL;
+            common::time64_t window_start = common::time::current_mstime();
+            LatencyHistogram window, total;
+            std::vector<uint64_t> latencies;
+            FastoObject* child = NULL;
+
+            while(!parent_->interrupt_.loadAcquire()) {
+                latencies.clear();
+                common::Error er = latencyRound(contexts, &latencies);
+                if(er){
+                    // replies left unread would desync the command connection
+                    common::Error rer = cliConnect(1);
+                    if(rer){
+                        LOG_ERROR(rer, true);
+                    }
+                    parent_->addLatencyHistory(common::time::current_mstime(), window);
+                    return er;
+                }
+
+                for(size_t i = 0; i < latencies.size(); ++i){
+                    window.record(latencies[i]);
+                    total.record(latencies[i]);
+                }
+
+                const LatencyHistogram& shown = config_.latency_history ? window : total;
+                char buff[1024];
+                common::SNPrintf(buff, sizeof(buff), "p50: %.1f us, p99: %.1f us, p99.9: %.1f us, max: %.1f us, min: %.1f us (%llu samples, %d connections)",
+                                 shown.valueAtPercentile(50) / 1000.0, shown.valueAtPercentile(99) / 1000.0,
+                                 shown.valueAtPercentile(99.9) / 1000.0, shown.max() / 1000.0, shown.min() / 1000.0,
+                                 static_cast<unsigned long long>(shown.count()), static_cast<int>(contexts.size()));
+                common::Value *val = common::Value::createStringValue(buff);
+
+                if(!child){
+                    child = new(cmd) FastoObject(cmd, val, config_.mb_delim_);
+                    cmd->addChildren(child);
+                }
+                else{
+                    child->setValue(val);
+                }
+
+                common::time64_t curTime = common::time::current_mstime();
+                if(curTime - window_start > window_interval){
+                    parent_->addLatencyHistory(curTime, window);
+                    window.reset();
+                    window_start = curTime;
+                    if(config_.latency_history){
+                        child = NULL;
+                    }
+                }
+
+                common::utils::msleep(LATENCY_SAMPLE_RATE);
+            }
+
+            parent_->addLatencyHistory(common::time::current_mstime(), window);
+            return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+        }
+
+        common::Error latencyMode(FastoObject* out) WARN_UNUSED_RESULT
+        {
+            DCHECK(out);
+            if(!out){
+                return common::make_error_value("Invalid input argument", common::ErrorValue::E_ERROR);
+            }
+
+            FastoObjectCommand* cmd = createCommand<RedisCommand>(out, "PING", common::Value::C_INNER);
+            DCHECK(cmd);
+            if(!cmd){
+                return common::make_error_value("Invalid createCommand input argument", common::ErrorValue::E_ERROR);
+            }
+
+            if (!context_){
+                return common::make_error_value("Not connected", common::Value::E_ERROR);
+            }
+
+            std::vector<redisContext*> contexts(1, context_);
+            common::Error er;
+            for(int i = 1; i < config_.latency_connections && !er; ++i){
+                redisContext* context = NULL;
+                er = extraConnection(&context);
+                if(!er){
+                    contexts.push_back(context);
+                }
+            }
+
+            if(!er){
+                er = latencySamples(cmd, contexts);
+            }
+
+            for(size_t i = 1; i < contexts.size(); ++i){
+                redisFree(contexts[i]);
+            }
+            return er;
+        }
+
+        /*------------------------------------------------------------------------------
+         * Intrinsic latency and latency breakdown mode
+         *--------------------------------------------------------------------------- */
+
+        // the longest this thread is kept from running, measured like
+        // redis-cli --intrinsic-latency: a busy loop reading the clock
+        common::Error intrinsicLatency(int seconds, LatencyHistogram* hist) WARN_UNUSED_RESULT
+        {
+            const uint64_t end = monotonicNsec() + seconds * 1000000000ULL;
+            uint64_t last = monotonicNsec();
+            uint64_t runs = 0;
+            while(last < end){
+                if(++runs % INTRINSIC_LATENCY_CHECK_RUNS == 0 && parent_->interrupt_.loadAcquire()){
+                    return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+                }
+
+                const uint64_t now = monotonicNsec();
+                hist->record(now - last);
+                last = now;
+            }
+
+            return common::Error();
+        }
+
+        common::Error commandStats(redisContext* context, redis_command_stats_t* stats) WARN_UNUSED_RESULT
+        {
+            redisReply* reply = static_cast<redisReply*>(redisCommand(context, COMMANDSTATS_REQUEST));
+            if(!reply){
+                return latencyContextError(context);
+            }
+
+            common::Error er;
+            if(reply->type == REDIS_REPLY_STRING){
+                *stats = makeRedisCommandStats(std::string(reply->str, reply->len));
+            }
+            else if(reply->type == REDIS_REPLY_ERROR){
+                er = common::make_error_value(std::string(reply->str, reply->len), common::ErrorValue::E_ERROR);
+            }
+            else{
+                er = common::make_error_value("Invalid " COMMANDSTATS_REQUEST " command output", common::ErrorValue::E_ERROR);
+            }
+            freeReplyObject(reply);
+            return er;
+        }
+
+        void addLatencyRow(FastoObjectCommand* cmd, const std::string& text)
+        {
+            FastoObject* child = new(cmd) FastoObject(cmd, common::Value::createStringValue(text), config_.mb_delim_);
+            cmd->addChildren(child);
+        }
+
+        // latency events of the server's latency monitor, the largest spike in msec
+        void latencyMonitorRows(FastoObjectCommand* cmd, redisContext* context, long long* maxSpike)
+        {
+            *maxSpike = 0;
+            redisReply* reply = static_cast<redisReply*>(redisCommand(context, LATENCY_LATEST_REQUEST));
+            if(!reply){
+                return;
+            }
+
+            char buff[1024] = {0};
+            if(reply->type == REDIS_REPLY_ERROR){
+                common::SNPrintf(buff, sizeof(buff), "latency monitor: %s", std::string(reply->str, reply->len));
+                addLatencyRow(cmd, buff);
+            }
+            else if(reply->type == REDIS_REPLY_ARRAY && !reply->elements){
+                addLatencyRow(cmd, "latency monitor: no events (see latency-monitor-threshold)");
+            }
+            else{
+                const std::vector<RedisLatencyEvent> events = parseLatencyLatest(reply);
+                for(size_t i = 0; i < events.size(); ++i){
+                    *maxSpike = std::max(*maxSpike, events[i].max_);
+                    common::SNPrintf(buff, sizeof(buff), "latency monitor: %s latest %lld ms, max %lld ms",
+                                     events[i].name_, events[i].latest_, events[i].max_);
+                    addLatencyRow(cmd, buff);
+                }
+            }
+            freeReplyObject(reply);
+        }
+
+        // the slowest of the recent slowlog entries, its duration in usec
+        void slowlogRow(FastoObjectCommand* cmd, redisContext* context, long long* slowest)
+        {
+            *slowest = 0;
+            redisReply* reply = static_cast<redisReply*>(redisCommand(context, SLOWLOG_LATEST_REQUEST));
+            if(!reply){
+                return;
+            }
+
+            RedisSlowLogSummary summary;
+            if(parseSlowLogSummary(reply, &summary)){
+                *slowest = summary.slowest_;
+                char buff[1024] = {0};
+                if(summary.entries_){
+                    common::SNPrintf(buff, sizeof(buff), "slowlog: slowest of the last %d entries %lld us (%s)",
+                                     static_cast<int>(summary.entries_), summary.slowest_, summary.command_);
+                }
+                else{
+                    common::SNPrintf(buff, sizeof(buff), "slowlog: empty");
+                }
+                addLatencyRow(cmd, buff);
+            }
+            freeReplyObject(reply);
+        }
+
+        // Tells client machine, network and server apart: the scheduler latency
+        // of this machine, the round trip of PING on a connection of its own
+        // (through the SSH tunnel if there is one), the server time of those PINGs
+        // from INFO commandstats, and the latency monitor and slowlog of the server.
+        common::Error intrinsicLatencyMode(FastoObject* out) WARN_UNUSED_RESULT
+        {
+            DCHECK(out);
+            if(!out){
+                return common::make_error_value("Invalid input argument", common::ErrorValue::E_ERROR);
+            }
+
+            FastoObjectCommand* cmd = createCommand<RedisCommand>(out, "PING", common::Value::C_INNER);
+            DCHECK(cmd);
+            if(!cmd){
+                return common::make_error_value("Invalid createCommand input argument", common::ErrorValue::E_ERROR);
+            }
+
+            const int duration = config_.intrinsic_latency_duration > 0 ? config_.intrinsic_latency_duration : INTRINSIC_LATENCY_DEFAULT_DURATION;
+            char buff[1024] = {0};
+
+            LatencyHistogram intrinsic;
+            common::Error er = intrinsicLatency(duration, &intrinsic);
+            if(er){
+                return er;
+            }
+
+            common::SNPrintf(buff, sizeof(buff), "intrinsic (this machine): max %.1f us, p99.9 %.1f us, p99 %.1f us in %d sec",
+                             intrinsic.max() / 1000.0, intrinsic.valueAtPercentile(99.9) / 1000.0,
+                             intrinsic.valueAtPercentile(99) / 1000.0, duration);
+            addLatencyRow(cmd, buff);
+
+            const uint64_t connectStart = monotonicNsec();
+            redisContext* context = NULL;
+            er = extraConnection(&context);
+            if(er){
+                return er;
+            }
+            const uint64_t connectTime = monotonicNsec() - connectStart;
+
+            if(sinfo_.isValid()){
+                common::SNPrintf(buff, sizeof(buff), "connect: %.2f ms through SSH tunnel %s:%d",
+                                 connectTime / 1000000.0, sinfo_.hostName_, sinfo_.port_);
+            }
+            else{
+                common::SNPrintf(buff, sizeof(buff), "connect: %.2f ms", connectTime / 1000000.0);
+            }
+            addLatencyRow(cmd, buff);
+
+            redis_command_stats_t before, after;
+            common::Error ser = commandStats(context, &before);
+
+            LatencyHistogram rtt;
+            std::vector<redisContext*> contexts(1, context);
+            std::vector<uint64_t> latencies;
+            const common::time64_t end = common::time::current_mstime() + duration * 1000;
+            while(!er && common::time::current_mstime() < end){
+                latencies.clear();
+                er = latencyRound(contexts, &latencies);
+                for(size_t i = 0; i < latencies.size(); ++i){
+                    rtt.record(latencies[i]);
+                }
+                common::utils::msleep(LATENCY_SAMPLE_RATE);
+            }
+
+            if(er){
+                redisFree(context);
+                return er;
+            }
+
+            if(!ser){
+                ser = commandStats(context, &after);
+            }
+
+            const double rttMedian = rtt.valueAtPercentile(50) / 1000.0;
+            common::SNPrintf(buff, sizeof(buff), "round trip: p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us (%llu pings)",
+                             rttMedian, rtt.valueAtPercentile(99) / 1000.0, rtt.valueAtPercentile(99.9) / 1000.0,
+                             rtt.max() / 1000.0, static_cast<unsigned long long>(rtt.count()));
+            addLatencyRow(cmd, buff);
+
+            double serverPing = -1;
+            if(ser){
+                common::SNPrintf(buff, sizeof(buff), "server: " COMMANDSTATS_REQUEST " failed: %s", ser->description());
+                addLatencyRow(cmd, buff);
+            }
+            else{
+                serverPing = serverUsecPerCall(before, after, "ping");
+                const double serverAll = serverUsecPerCall(before, after, std::string());
+                common::SNPrintf(buff, sizeof(buff), "server: %.2f us per PING, %.2f us per command of all clients",
+                                 serverPing, serverAll);
+                addLatencyRow(cmd, buff);
+
+                if(serverPing >= 0){
+                    common::SNPrintf(buff, sizeof(buff), "network and client: %.1f us of the median round trip",
+                                     std::max(rttMedian - serverPing, 0.0));
+                    addLatencyRow(cmd, buff);
+                }
+            }
+
+            long long monitorSpike = 0, slowest = 0;
+            latencyMonitorRows(cmd, context, &monitorSpike);
+            slowlogRow(cmd, context, &slowest);
+            redisFree(context);
+
+            // the spikes of the round trip go to whoever has spikes of that size
+            const double spike = rtt.max() / 1000.0 - rttMedian;
+            const char* culprit = "the network";
+            if(intrinsic.max() / 1000.0 >= spike / 2){
+                culprit = "this machine (scheduler latency)";
+            }
+            else if(monitorSpike * 1000.0 >= spike || slowest >= spike){
+                culprit = "the server (latency monitor or slowlog)";
+            }
+            else if(serverPing >= 0 && serverPing >= rttMedian / 2){
+                culprit = "the server";
+            }
+            common::SNPrintf(buff, sizeof(buff), "verdict: round trip spikes of %.1f us most likely come from %s", spike, culprit);
+            addLatencyRow(cmd, buff);
+
+            return common::Error();
+        }
+
+        /*------------------------------------------------------------------------------
+         * Streams on connections of their own
+         *--------------------------------------------------------------------------- */
+
+        common::Error streamContextError(redisContext* context) WARN_UNUSED_RESULT
+        {
+            char buff[512] = {0};
+            common::SNPrintf(buff, sizeof(buff), "Stream connection error: %s", context->errstr);
+            return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+        }
+
+        // next pushed reply, NULL when none came within a poll slice
+        common::Error streamReply(redisContext* context, redisReply** reply) WARN_UNUSED_RESULT
+        {
+            void* r = NULL;
+            *reply = NULL;
+            if(redisGetReplyFromReader(context, &r) == REDIS_ERR){
+                return streamContextError(context);
+            }
+
+            if(!r){
+                bool readable = context->channel && libssh2_poll_channel_read(context->channel, 0);
+                if(!readable){
+                    struct pollfd pfd;
+                    pfd.fd = context->fd;
+                    pfd.events = POLLIN;
+                    pfd.revents = 0;
+#ifdef OS_WIN
+                    int res = WSAPoll(&pfd, 1, REPLY_POLL_SLICE_MSEC);
+#else
+                    int res = poll(&pfd, 1, REPLY_POLL_SLICE_MSEC);
+#endif
+                    if(res < 0 && errno != EINTR){
+                        char buff[256] = {0};
+                        common::SNPrintf(buff, sizeof(buff), "Wait for reply error: %s", strerror(errno));
+                        return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                    }
+                    readable = res > 0;
+                }
+
+                if(!readable){
+                    return common::Error();
+                }
+
+                if(redisBufferRead(context) == REDIS_ERR || redisGetReplyFromReader(context, &r) == REDIS_ERR){
+                    return streamContextError(context);
+                }
+            }
+
+            *reply = static_cast<redisReply*>(r);
+            return common::Error();
+        }
+
+        common::Error streamCommand(redisContext* context, const char* command) WARN_UNUSED_RESULT
+        {
+            redisAppendCommand(context, command);
+            return streamFlush(context);
+        }
+
+        common::Error streamFlush(redisContext* context) WARN_UNUSED_RESULT
+        {
+            int done = 0;
+            while(!done){
+                if(redisBufferWrite(context, &done) == REDIS_ERR){
+                    return streamContextError(context);
+                }
+            }
+            return common::Error();
+        }
+
+        // MONITOR is parsed and aggregated right on the stream strand, the analyzer
+        // keeps a fixed ring of lines and top counters, so a busy server costs
+        // no memory growth; snapshots go out every MONITOR_SNAPSHOT_MSEC
+        common::Error monitorStream(const EventsInfo::MonitorRequest& req, MonitorSnapShot* last) WARN_UNUSED_RESULT
+        {
+            QFile capture(common::convertFromString<QString>(req.capturePath_));
+            if(!req.capturePath_.empty() && !capture.open(QIODevice::WriteOnly | QIODevice::Append)){
+                char buff[512] = {0};
+                common::SNPrintf(buff, sizeof(buff), "Couldn't open capture file %s", req.capturePath_);
+                return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+            }
+
+            redisContext* context = NULL;
+            common::Error er = extraConnection(&context);
+            if(er){
+                return er;
+            }
+
+            er = streamCommand(context, MONITOR_REQUEST);
+            MonitorAnalyzer analyzer;
+            MonitorEntry entry;
+            const common::time64_t start = common::time::current_mstime();
+            common::time64_t nextShot = start + MONITOR_SNAPSHOT_MSEC;
+            while(!er && !parent_->streamStop_.loadAcquire()){
+                const common::time64_t now = common::time::current_mstime();
+                if(req.duration_ && now - start >= req.duration_){
+                    break;
+                }
+
+                if(now >= nextShot){
+                    emit parent_->monitorSnapShot(analyzer.snapShot(now, MONITOR_TOP_COUNT, MONITOR_RECENT_COUNT));
+                    nextShot = now + MONITOR_SNAPSHOT_MSEC;
+                }
+
+                redisReply* reply = NULL;
+                er = streamReply(context, &reply);
+                if(!reply){
+                    continue;
+                }
+
+                if(reply->type == REDIS_REPLY_ERROR){
+                    er = common::make_error_value(std::string(reply->str, reply->len), common::ErrorValue::E_ERROR);
+                }
+                else if(reply->type == REDIS_REPLY_STATUS && parseMonitorLine(reply->str, reply->len, &entry)){
+                    analyzer.add(entry);
+                    if(capture.isOpen()){
+                        capture.write(reply->str, reply->len);
+                        capture.write("\n", 1);
+                    }
+                }
+                freeReplyObject(reply);
+            }
+
+            *last = analyzer.snapShot(common::time::current_mstime(), MONITOR_TOP_COUNT, MONITOR_RECENT_COUNT);
+            redisFree(context);
+            return er;
+        }
+
+        common::Error streamSubscribe(redisContext* context, const char* command, const std::vector<std::string>& names) WARN_UNUSED_RESULT
+        {
+            if(names.empty()){
+                return common::Error();
+            }
+
+            std::vector<const char*> argv(1, command);
+            std::vector<size_t> argvlen(1, strlen(command));
+            for(size_t i = 0; i < names.size(); ++i){
+                argv.push_back(names[i].data());
+                argvlen.push_back(names[i].size());
+            }
+
+            redisAppendCommandArgv(context, argv.size(), &argv[0], &argvlen[0]);
+            return streamFlush(context);
+        }
+
+        // messages go to the request's ring as they come, the subscribe
+        // confirmations are skipped; a full ring drops rather than waits
+        common::Error pubSubStream(const EventsInfo::PubSubRequest& req, uint64_t* received) WARN_UNUSED_RESULT
+        {
+            if(!req.ring_ || (req.channels_.empty() && req.patterns_.empty())){
+                return common::make_error_value("Nothing to subscribe to", common::ErrorValue::E_ERROR);
+            }
+
+            redisContext* context = NULL;
+            common::Error er = extraConnection(&context);
+            if(er){
+                return er;
+            }
+
+            er = streamSubscribe(context, "SUBSCRIBE", req.channels_);
+            if(!er){
+                er = streamSubscribe(context, "PSUBSCRIBE", req.patterns_);
+            }
+
+            PubSubMessage msg;
+            while(!er && !parent_->streamStop_.loadAcquire()){
+                redisReply* reply = NULL;
+                er = streamReply(context, &reply);
+                if(!reply){
+                    continue;
+                }
+
+                if(reply->type == REDIS_REPLY_ERROR){
+                    er = common::make_error_value(std::string(reply->str, reply->len), common::ErrorValue::E_ERROR);
+                }
+                else if(reply->type == REDIS_REPLY_ARRAY && reply->elements >= 3 && reply->element[0]->type == REDIS_REPLY_STRING){
+                    redisReply* kind = reply->element[0];
+                    const bool pattern = reply->elements == 4 && !strcmp(kind->str, PUBSUB_PMESSAGE_REPLY);
+                    if(pattern || !strcmp(kind->str, PUBSUB_MESSAGE_REPLY)){
+                        redisReply* channel = reply->element[pattern ? 2 : 1];
+                        redisReply* payload = reply->element[pattern ? 3 : 2];
+                        msg.msec_ = common::time::current_mstime();
+                        if(pattern){
+                            msg.pattern_.assign(reply->element[1]->str, reply->element[1]->len);
+                        }
+                        else{
+                            msg.pattern_.clear();
+                        }
+                        msg.channel_.assign(channel->str, channel->len);
+                        msg.payload_.assign(payload->str, payload->len);
+                        req.ring_->push(msg);
+                        ++*received;
+                    }
+                }
+                freeReplyObject(reply);
+            }
+
+            redisFree(context);
+            return er;
+        }
+
+        common::Error keyspaceReplyError(redisContext* context, redisReply* reply, const char* command) WARN_UNUSED_RESULT
+        {
+            if(!reply){
+                return streamContextError(context);
+            }
+
+            if(reply->type == REDIS_REPLY_ERROR){
+                return common::make_error_value(std::string(reply->str, reply->len), common::ErrorValue::E_ERROR);
+            }
+
+            char buff[256] = {0};
+            common::SNPrintf(buff, sizeof(buff), "Invalid %s command output", command);
+            return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+        }
+
+        common::Error keyspaceFlags(redisContext* context, std::string* flags) WARN_UNUSED_RESULT
+        {
+            redisReply* reply = static_cast<redisReply*>(redisCommand(context, KEYSPACE_GET_FLAGS_REQUEST));
+            common::Error er;
+            if(reply && reply->type == REDIS_REPLY_ARRAY && reply->elements == 2 && reply->element[1]->type == REDIS_REPLY_STRING){
+                flags->assign(reply->element[1]->str, reply->element[1]->len);
+            }
+            else{
+                er = keyspaceReplyError(context, reply, KEYSPACE_GET_FLAGS_REQUEST);
+            }
 
+            if(reply){
+                freeReplyObject(reply);
+            }
+            return er;
         }
 
-        ~pimpl()
+        common::Error setKeyspaceFlags(redisContext* context, const std::string& flags) WARN_UNUSED_RESULT
         {
-            if(context_){
-                redisFree(context_);
-                context_ = NULL;
+            redisReply* reply = static_cast<redisReply*>(redisCommand(context, KEYSPACE_SET_FLAGS_PATTERN_1ARGS_B, flags.data(), flags.size()));
+            common::Error er;
+            if(!reply || reply->type != REDIS_REPLY_STATUS){
+                er = keyspaceReplyError(context, reply, "CONFIG SET notify-keyspace-events");
             }
-        }
-
-        RedisDriver* parent_;
-        redisContext *context_;
-        redisConfig config_;
-        SSHInfo sinfo_;
-        bool isAuth_;
 
-        /*------------------------------------------------------------------------------
-         * Latency and latency history modes
-         *--------------------------------------------------------------------------- */
+            if(reply){
+                freeReplyObject(reply);
+            }
+            return er;
+        }
 
-        common::Error latencyMode(FastoObject* out) WARN_UNUSED_RESULT
+        // Keyspace notifications on a connection of their own. enableFlags_ is set
+        // for the stream only, the flags found are put back when it stops. With
+        // both K and E on every change comes twice, the __keyevent@ channel is read
+        // then; snapshots go out every KEYSPACE_SNAPSHOT_MSEC like the monitor ones.
+        common::Error keyspaceStream(EventsInfo::KeyspaceResponce* res) WARN_UNUSED_RESULT
         {
-            DCHECK(out);
-            if(!out){
-                return common::make_error_value("Invalid input argument", common::ErrorValue::E_ERROR);
+            redisContext* context = NULL;
+            common::Error er = extraConnection(&context);
+            if(er){
+                return er;
             }
 
-            FastoObjectCommand* cmd = createCommand<RedisCommand>(out, "PING", common::Value::C_INNER);
-            DCHECK(cmd);
-            if(!cmd){
-                return common::make_error_value("Invalid createCommand input argument", common::ErrorValue::E_ERROR);
+            er = keyspaceFlags(context, &res->serverFlags_);
+            std::string flags = res->serverFlags_;
+            const bool changed = !er && !res->enableFlags_.empty() && res->enableFlags_ != flags;
+            if(changed){
+                er = setKeyspaceFlags(context, res->enableFlags_);
+                flags = res->enableFlags_;
             }
 
-            common::time64_t start;
-            uint64_t min = 0, max = 0, tot = 0, count = 0;
-            uint64_t history_interval =
-                    config_.interval ? config_.interval/1000 :
-                                      LATENCY_HISTORY_DEFAULT_INTERVAL;
-            double avg;
-            common::time64_t history_start = common::time::current_mstime();
-
-            if (!context_){
-                return common::make_error_value("Not connected", common::Value::E_ERROR);
+            const bool keyevent = flags.find('E') != std::string::npos;
+            if(!er && ((!keyevent && flags.find('K') == std::string::npos) || flags.find_first_of(KEYSPACE_EVENT_CLASSES) == std::string::npos)){
+                res->disabled_ = true;
+                redisFree(context);
+                return common::Error();
             }
 
-            FastoObject* child = NULL;
-            const std::string command = cmd->inputCommand();
+            std::string pattern = keyevent ? "__keyevent@" : "__keyspace@";
+            pattern += res->db_ < 0 ? "*" : common::convertToString(res->db_);
+            pattern += "__:*";
+            if(!er){
+                er = streamSubscribe(context, "PSUBSCRIBE", std::vector<std::string>(1, pattern));
+            }
 
-            while(!parent_->interrupt_) {
-                start = common::time::current_mstime();
-                redisReply *reply = (redisReply*)redisCommand(context_, command.c_str());
-                if (reply == NULL) {
-                    return common::make_error_value("I/O error", common::Value::E_ERROR);
+            KeyspaceAnalyzer analyzer;
+            KeyspaceEvent event;
+            std::string channel, payload;
+            common::time64_t nextShot = common::time::current_mstime() + KEYSPACE_SNAPSHOT_MSEC;
+            while(!er && !parent_->streamStop_.loadAcquire()){
+                const common::time64_t now = common::time::current_mstime();
+                if(now >= nextShot){
+                    emit parent_->keyspaceSnapShot(analyzer.snapShot(now, KEYSPACE_TOP_COUNT));
+                    nextShot = now + KEYSPACE_SNAPSHOT_MSEC;
                 }
 
-                common::time64_t curTime = common::time::current_mstime();
+                redisReply* reply = NULL;
+                er = streamReply(context, &reply);
+                if(!reply){
+                    continue;
+                }
 
-                uint64_t latency = curTime - start;
-                freeReplyObject(reply);
-                count++;
-                if (count == 1) {
-                    min = max = tot = latency;
-                    avg = (double) latency;
-                } else {
-                    if (latency < min) min = latency;
-                    if (latency > max) max = latency;
-                    tot += latency;
-                    avg = (double) tot/count;
+                if(reply->type == REDIS_REPLY_ERROR){
+                    er = common::make_error_value(std::string(reply->str, reply->len), common::ErrorValue::E_ERROR);
+                }
+                else if(reply->type == REDIS_REPLY_ARRAY && reply->elements == 4 && reply->element[0]->type == REDIS_REPLY_STRING
+                        && !strcmp(reply->element[0]->str, PUBSUB_PMESSAGE_REPLY)){
+                    channel.assign(reply->element[2]->str, reply->element[2]->len);
+                    payload.assign(reply->element[3]->str, reply->element[3]->len);
+                    if(parseKeyspaceEvent(channel, payload, &event)){
+                        analyzer.add(event);
+                    }
                 }
+                freeReplyObject(reply);
+            }
 
-                char buff[1024];
-                common::SNPrintf(buff, sizeof(buff), "min: %lld, max: %lld, avg: %.2f (%lld samples)",
-                                    min, max, avg, count);
-                common::Value *val = common::Value::createStringValue(buff);
+            res->last_ = analyzer.snapShot(common::time::current_mstime(), KEYSPACE_TOP_COUNT);
+            redisFree(context);
 
-                if(!child){
-                    child = new FastoObject(cmd, val, config_.mb_delim_);
-                    cmd->addChildren(child);
-                    continue;
+            // the subscribed connection takes no other commands
+            if(changed){
+                redisContext* restore = NULL;
+                common::Error rer = extraConnection(&restore);
+                if(!rer){
+                    rer = setKeyspaceFlags(restore, res->serverFlags_);
+                    redisFree(restore);
                 }
 
-                if(config_.latency_history && curTime - history_start > history_interval){
-                    child = new FastoObject(cmd, val, config_.mb_delim_);
-                    cmd->addChildren(child);
-                    history_start = curTime;
-                    min = max = tot = count = 0;
-                }
-                else{
-                    child->setValue(val);
+                if(!er){
+                    er = rer;
                 }
-
-                common::utils::msleep(LATENCY_SAMPLE_RATE);
             }
-
-            return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+            return er;
         }
 
         /*------------------------------------------------------------------------------
@@ -568,7 +1820,7 @@ namespace fastonosql
                     break;
                 }
 
-                if (parent_->interrupt_){
+                if (parent_->interrupt_.loadAcquire()){
                     return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
                 }
             }
@@ -606,7 +1858,7 @@ namespace fastonosql
             /* Write to file. */
             if (!strcmp(config_.rdb_filename,"-")) {
                 val = new common::ArrayValue;
-                FastoObject* child = new FastoObject(cmd, val, config_.mb_delim_);
+                FastoObject* child = new(cmd) FastoObject(cmd, val, config_.mb_delim_);
                 cmd->addChildren(child);
             }
             else{
@@ -724,7 +1976,9 @@ namespace fastonosql
 
             /* Pipeline TYPE commands */
             for(i=0;i<keys->elements;i++) {
-                redisAppendCommand(context_, "TYPE %s", keys->element[i]->str);
+                if(redisAppendCommand(context_, "TYPE %s", keys->element[i]->str) != REDIS_OK){
+                    return cliAppendError();
+                }
             }
 
             /* Retrieve types */
@@ -761,7 +2015,7 @@ namespace fastonosql
                                 unsigned long long *sizes) WARN_UNUSED_RESULT
         {
             redisReply *reply;
-            const char *sizecmds[] = {"STRLEN","LLEN","SCARD","HLEN","ZCARD"};
+            const char *sizecmds[] = {"STRLEN","LLEN","SCARD","HLEN","ZCARD","XLEN"};
             unsigned int i;
 
             /* Pipeline size commands */
@@ -770,8 +2024,9 @@ namespace fastonosql
                 if(types[i]==RTYPE_NONE)
                     continue;
 
-                redisAppendCommand(context_, "%s %s", sizecmds[types[i]],
-                    keys->element[i]->str);
+                if(redisAppendCommand(context_, "%s %s", sizecmds[types[i]], keys->element[i]->str) != REDIS_OK){
+                    return cliAppendError();
+                }
             }
 
             /* Retreive sizes */
@@ -820,12 +2075,12 @@ namespace fastonosql
                 return common::make_error_value("Invalid createCommand input argument", common::ErrorValue::E_ERROR);
             }
 
-            unsigned long long biggest[5] = {0}, counts[5] = {0}, totalsize[5] = {0};
+            unsigned long long biggest[RTYPE_NONE] = {0}, counts[RTYPE_NONE] = {0}, totalsize[RTYPE_NONE] = {0};
             unsigned long long sampled = 0, totlen=0, *sizes=NULL, it=0;
             long long total_keys;
-            sds maxkeys[5] = {0};
-            const char *typeName[] = {"string","list","set","hash","zset"};
-            const char *typeunit[] = {"bytes","items","members","fields","members"};
+            sds maxkeys[RTYPE_NONE] = {0};
+            const char *typeName[] = {"string","list","set","hash","zset","stream"};
+            const char *typeunit[] = {"bytes","items","members","fields","members","entries"};
             redisReply *reply, *keys;
             unsigned int arrsize=0, i;
             int type, *types=NULL;
@@ -952,7 +2207,7 @@ namespace fastonosql
                     common::SNPrintf(buff, sizeof(buff), "Biggest %6s found '%s' has %llu %s", typeName[i], maxkeys[i],
                        biggest[i], typeunit[i]);
                     common::StringValue *val = common::Value::createStringValue(buff);
-                    FastoObject* obj = new FastoObject(cmd, val, config_.mb_delim_);
+                    FastoObject* obj = new(cmd) FastoObject(cmd, val, config_.mb_delim_);
                     cmd->addChildren(obj);
                 }
             }
@@ -964,7 +2219,7 @@ namespace fastonosql
                    sampled ? 100 * (double)counts[i]/sampled : 0,
                    counts[i] ? (double)totalsize[i]/counts[i] : 0);
                 common::StringValue *val = common::Value::createStringValue(buff);
-                FastoObject* obj = new FastoObject(cmd, val, config_.mb_delim_);
+                FastoObject* obj = new(cmd) FastoObject(cmd, val, config_.mb_delim_);
                 cmd->addChildren(obj);
             }
 
@@ -1054,7 +2309,7 @@ namespace fastonosql
             const std::string command = cmd->inputCommand();
             long requests = 0;
 
-            while(!parent_->interrupt_) {
+            while(!parent_->interrupt_.loadAcquire()) {
                 char buf[64];
                 int j;
 
@@ -1134,7 +2389,7 @@ namespace fastonosql
                 }
 
                 common::StringValue *val = common::Value::createStringValue(result);
-                FastoObject* obj = new FastoObject(cmd, val, config_.mb_delim_);
+                FastoObject* obj = new(cmd) FastoObject(cmd, val, config_.mb_delim_);
                 cmd->addChildren(obj);
 
                 freeReplyObject(reply);
@@ -1183,7 +2438,7 @@ namespace fastonosql
                     cur = strtoull(reply->element[0]->str,NULL,10);
                     for (j = 0; j < reply->element[1]->elements; j++){
                         common::StringValue *val = common::Value::createStringValue(reply->element[1]->element[j]->str);
-                        FastoObject* obj = new FastoObject(cmd, val, config_.mb_delim_);
+                        FastoObject* obj = new(cmd) FastoObject(cmd, val, config_.mb_delim_);
                         cmd->addChildren(obj);
                     }
                 }
@@ -1242,6 +2497,7 @@ namespace fastonosql
 
             if (context_ == NULL || force) {
                 if (context_ != NULL){
+                    connected_.storeRelease(0);
                     redisFree(context_);
                     context_ = NULL;
                 }
@@ -1253,6 +2509,8 @@ namespace fastonosql
                 }
 
                 context_ = context;
+                connected_.storeRelease(1);
+                resetMonitoring();
 
                 /* Set aggressive KEEP_ALIVE socket option in the Redis context socket
                  * in order to prevent timeouts caused by the execution of long
@@ -1285,6 +2543,121 @@ namespace fastonosql
             return common::Error();
         }
 
+        // waits for reply bytes in short slices, so interrupt() and the
+        // command timeout are noticed while the server stays silent
+        common::Error waitReadable(common::time64_t deadline) WARN_UNUSED_RESULT
+        {
+            while(true){
+                if(parent_->interrupt_.loadAcquire()){
+                    return common::make_error_value("Interrupted.", common::ErrorValue::E_INTERRUPTED);
+                }
+
+                if(context_->channel && libssh2_poll_channel_read(context_->channel, 0)){
+                    return common::Error();
+                }
+
+                // rows of a quiet monitor or subscribe are shown while waiting
+                parent_->flushChildren();
+
+                int wait = REPLY_POLL_SLICE_MSEC;
+                if(deadline){
+                    common::time64_t now = common::time::current_mstime();
+                    if(now >= deadline){
+                        char buff[128] = {0};
+                        common::SNPrintf(buff, sizeof(buff), "Command timed out after %d msec.", config_.command_timeout);
+                        return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                    }
+                    wait = std::min<common::time64_t>(wait, deadline - now);
+                }
+
+                struct pollfd pfd;
+                pfd.fd = context_->fd;
+                pfd.events = POLLIN;
+                pfd.revents = 0;
+#ifdef OS_WIN
+                int res = WSAPoll(&pfd, 1, wait);
+#else
+                int res = poll(&pfd, 1, wait);
+#endif
+                if(res > 0){
+                    return common::Error();
+                }
+
+                if(res < 0 && errno != EINTR){
+                    char buff[256] = {0};
+                    common::SNPrintf(buff, sizeof(buff), "Wait for reply error: %s", strerror(errno));
+                    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                }
+            }
+        }
+
+        // redisGetReply in steps: only complete replies are taken from the reader,
+        // the socket is read when waitReadable says so. A reply abandoned on
+        // interrupt or timeout would desync the connection, so it is reopened.
+        common::Error cliGetReply(void** reply) WARN_UNUSED_RESULT
+        {
+            *reply = NULL;
+            if (context_ == NULL){
+                return common::make_error_value("Not connected", common::Value::E_ERROR);
+            }
+
+            int done = 0;
+            while(!done){
+                if(redisBufferWrite(context_, &done) == REDIS_ERR){
+                    return cliContextReplyError();
+                }
+            }
+
+            const common::time64_t deadline = config_.command_timeout ? common::time::current_mstime() + config_.command_timeout : 0;
+            while(true){
+                if(redisGetReplyFromReader(context_, reply) == REDIS_ERR){
+                    return cliContextReplyError();
+                }
+
+                if(*reply){
+                    return common::Error();
+                }
+
+                common::Error er = waitReadable(deadline);
+                if(er){
+                    common::Error rer = cliConnect(1);
+                    if(rer){
+                        LOG_ERROR(rer, true);
+                    }
+                    return er;
+                }
+
+                if(redisBufferRead(context_) == REDIS_ERR){
+                    return cliContextReplyError();
+                }
+            }
+        }
+
+        common::Error cliContextReplyError() WARN_UNUSED_RESULT
+        {
+            /* Filter cases where we should reconnect */
+            if (context_->err == REDIS_ERR_IO && errno == ECONNRESET){
+                return common::make_error_value("Needed reconnect.", common::ErrorValue::E_ERROR);
+            }
+            if (context_->err == REDIS_ERR_EOF){
+                return common::make_error_value("Needed reconnect.", common::ErrorValue::E_ERROR);
+            }
+
+            return cliPrintContextError();
+        }
+
+        // a failed append leaves the context in error with the commands queued
+        // before it unsent, the connection is reopened so their replies are never awaited
+        common::Error cliAppendError() WARN_UNUSED_RESULT
+        {
+            common::Error er = cliPrintContextError();
+            common::Error rer = cliConnect(1);
+            if(rer){
+                LOG_ERROR(rer, true);
+            }
+            return er;
+        }
+
         common::Error cliPrintContextError() WARN_UNUSED_RESULT
         {
             if (context_ == NULL){
@@ -1296,6 +2669,8 @@ namespace fastonosql
             return common::make_error_value(buff, common::ErrorValue::E_ERROR);
         }
 
+        // elements are kept inline in the array, nested arrays are filled before
+        // they are added so views never see a half built one
         common::Error cliFormatReplyRaw(FastoObjectArray* ar, redisReply *r) WARN_UNUSED_RESULT
         {
             DCHECK(ar);
@@ -1306,41 +2681,32 @@ namespace fastonosql
             switch (r->type) {
                 case REDIS_REPLY_NIL:
                 {
-                    common::Value* val = common::Value::createNullValue();
-                    ar->append(val);
-
+                    ar->append(common::Value::TYPE_NULL, NULL, 0);
                     break;
                 }
                 case REDIS_REPLY_ERROR:
                 {
-                    common::ErrorValue* val = common::Value::createErrorValue(std::string(r->str, r->len), common::ErrorValue::E_NONE, common::logging::L_WARNING);
-                    ar->append(val);
+                    ar->append(common::Value::TYPE_ERROR, r->str, r->len);
                     break;
                 }
                 case REDIS_REPLY_STATUS:
                 case REDIS_REPLY_STRING:
                 {
-                    common::StringValue *val = common::Value::createStringValue(std::string(r->str, r->len));
-                    ar->append(val);
+                    ar->append(common::Value::TYPE_STRING, r->str, r->len);
                     break;
                 }
                 case REDIS_REPLY_INTEGER:
                 {
-                    common::FundamentalValue *val = common::Value::createIntegerValue(r->integer);
-                    ar->append(val);
+                    ar->appendInteger(r->integer);
                     break;
                 }
                 case REDIS_REPLY_ARRAY:
                 {
-                    common::ArrayValue* arv = common::Value::createArrayValue();
-                    FastoObjectArray* child = new FastoObjectArray(ar, arv, config_.mb_delim_);
+                    FastoObjectArray* child = new(ar) FastoObjectArray(ar, config_.mb_delim_);
+                    common::Error er = cliFormatArray(child, r);
                     ar->addChildren(child);
-
-                    for (size_t i = 0; i < r->elements; ++i) {
-                        common::Error er = cliFormatReplyRaw(child, r->element[i]);
-                        if(er){
-                            return er;
-                        }
+                    if(er){
+                        return er;
                     }
                     break;
                 }
@@ -1348,8 +2714,20 @@ namespace fastonosql
                 {
                     char tmp2[128] = {0};
                     common::SNPrintf(tmp2, sizeof(tmp2), "Unknown reply type: %d", r->type);
-                    common::ErrorValue* val = common::Value::createErrorValue(tmp2, common::ErrorValue::E_NONE, common::logging::L_WARNING);
-                    ar->append(val);
+                    ar->append(common::Value::TYPE_ERROR, tmp2, strlen(tmp2));
+                }
+            }
+
+            return common::Error();
+        }
+
+        common::Error cliFormatArray(FastoObjectArray* ar, redisReply *r) WARN_UNUSED_RESULT
+        {
+            ar->reserve(r->elements);
+            for (size_t i = 0; i < r->elements; ++i) {
+                common::Error er = cliFormatReplyRaw(ar, r->element[i]);
+                if(er){
+                    return er;
                 }
             }
 
@@ -1367,48 +2745,39 @@ namespace fastonosql
             switch (r->type) {
                 case REDIS_REPLY_NIL:
                 {
-                    common::Value *val = common::Value::createNullValue();
-                    obj = new FastoObject(out, val, config_.mb_delim_);
+                    obj = new(out) FastoObject(out, common::Value::TYPE_NULL, NULL, 0, config_.mb_delim_);
                     out->addChildren(obj);
-
                     break;
                 }
                 case REDIS_REPLY_ERROR:
                 {
-                    common::ErrorValue* val = common::Value::createErrorValue(r->str, common::ErrorValue::E_NONE, common::logging::L_WARNING);
                     if(strcasestr(r->str, "NOAUTH")){ //"NOAUTH Authentication required."
                         isAuth_ = false;
                     }
-                    obj = new FastoObject(out, val, config_.mb_delim_);
+                    obj = new(out) FastoObject(out, common::Value::TYPE_ERROR, r->str, r->len, config_.mb_delim_);
                     out->addChildren(obj);
                     break;
                 }
                 case REDIS_REPLY_STATUS:
                 case REDIS_REPLY_STRING:
                 {
-                    common::StringValue *val = common::Value::createStringValue(r->str);
-                    obj = new FastoObject(out, val, config_.mb_delim_);
+                    obj = new(out) FastoObject(out, common::Value::TYPE_STRING, r->str, r->len, config_.mb_delim_);
                     out->addChildren(obj);
                     break;
                 }
                 case REDIS_REPLY_INTEGER:
                 {
-                    common::FundamentalValue *val = common::Value::createIntegerValue(r->integer);
-                    obj = new FastoObject(out, val, config_.mb_delim_);
+                    obj = new(out) FastoObject(out, r->integer, config_.mb_delim_);
                     out->addChildren(obj);
                     break;
                 }
                 case REDIS_REPLY_ARRAY:
                 {
-                    common::ArrayValue* arv = common::Value::createArrayValue();
-                    FastoObjectArray* child = new FastoObjectArray(out, arv, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, config_.mb_delim_);
+                    common::Error er = cliFormatArray(child, r);
                     out->addChildren(child);
-
-                    for (size_t i = 0; i < r->elements; ++i) {
-                        common::Error er = cliFormatReplyRaw(child, r->element[i]);
-                        if(er){
-                            return er;
-                        }
+                    if(er){
+                        return er;
                     }
                     break;
                 }
@@ -1417,7 +2786,7 @@ namespace fastonosql
                     char tmp2[128] = {0};
                     common::SNPrintf(tmp2, sizeof(tmp2), "Unknown reply type: %d", r->type);
                     common::ErrorValue* val = common::Value::createErrorValue(tmp2, common::ErrorValue::E_NONE, common::logging::L_WARNING);
-                    obj = new FastoObject(out, val, config_.mb_delim_);
+                    obj = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(obj);
                 }
             }
@@ -1425,6 +2794,57 @@ namespace fastonosql
             return common::Error();
         }
 
+        // XRANGE/XREVRANGE replies go straight into the columns of a StreamValue,
+        // anything not shaped as [id, [field, value, ...]] entries is formatted as usual
+        common::Error cliFormatStreamReply(FastoObject* out, redisReply *r) WARN_UNUSED_RESULT
+        {
+            DCHECK(out);
+            if(!out){
+                return common::make_error_value("Invalid input argument", common::ErrorValue::E_ERROR);
+            }
+
+            if(r->type != REDIS_REPLY_ARRAY){
+                return cliFormatReplyRaw(out, r);
+            }
+
+            for(size_t i = 0; i < r->elements; ++i){
+                redisReply* entry = r->element[i];
+                if(entry->type != REDIS_REPLY_ARRAY || entry->elements != 2 || entry->element[0]->type != REDIS_REPLY_STRING){
+                    return cliFormatReplyRaw(out, r);
+                }
+
+                redisReply* fields = entry->element[1];
+                if(fields->type == REDIS_REPLY_NIL){
+                    continue;
+                }
+
+                if(fields->type != REDIS_REPLY_ARRAY || fields->elements % 2){
+                    return cliFormatReplyRaw(out, r);
+                }
+            }
+
+            StreamValue* stream = new StreamValue;
+            stream->reserve(r->elements);
+            for(size_t i = 0; i < r->elements; ++i){
+                redisReply* entry = r->element[i];
+                stream->appendEntry(entry->element[0]->str, entry->element[0]->len);
+                redisReply* fields = entry->element[1];
+                if(fields->type != REDIS_REPLY_ARRAY){
+                    continue;
+                }
+
+                for(size_t j = 0; j + 1 < fields->elements; j += 2){
+                    redisReply* field = fields->element[j];
+                    redisReply* value = fields->element[j + 1];
+                    stream->appendField(field->str, field->len, value->str, value->len);
+                }
+            }
+
+            FastoObject* obj = new(out) FastoObject(out, stream, config_.mb_delim_);
+            out->addChildren(obj);
+            return common::Error();
+        }
+
         common::Error cliOutputCommandHelp(FastoObject* out, struct commandHelp *help, int group) WARN_UNUSED_RESULT
         {
             DCHECK(out);
@@ -1435,13 +2855,13 @@ namespace fastonosql
             char buff[1024] = {0};
             common::SNPrintf(buff, sizeof(buff), "name: %s %s\r\n  summary: %s\r\n  since: %s", help->name, help->params, help->summary, help->since);
             common::StringValue *val =common::Value::createStringValue(buff);
-            FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+            FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
             out->addChildren(child);
             if (group) {
                 char buff2[1024] = {0};
                 common::SNPrintf(buff2, sizeof(buff2), "  group: %s", commandGroups[help->group]);
                 val = common::Value::createStringValue(buff2);
-                FastoObject* gchild = new FastoObject(out, val, config_.mb_delim_);
+                FastoObject* gchild = new(out) FastoObject(out, val, config_.mb_delim_);
                 out->addChildren(gchild);
             }
 
@@ -1460,7 +2880,7 @@ namespace fastonosql
                                                                         "      \"help <command>\" for help on <command>\r\n"
                                                                         "      \"help <tab>\" to get a list of possible help topics\r\n"
                                                                         "      \"quit\" to exit");
-            FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+            FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
             out->addChildren(child);
 
             return common::Error();
@@ -1524,7 +2944,7 @@ namespace fastonosql
             return common::Error();
         }
 
-        common::Error cliReadReply(FastoObject* out) WARN_UNUSED_RESULT
+        common::Error cliReadReply(FastoObject* out, bool stream = false) WARN_UNUSED_RESULT
         {
             DCHECK(out);
             if(!out){
@@ -1532,16 +2952,9 @@ namespace fastonosql
             }
 
             void *_reply = NULL;
-            if (redisGetReply(context_, &_reply) != REDIS_OK) {
-                /* Filter cases where we should reconnect */
-                if (context_->err == REDIS_ERR_IO && errno == ECONNRESET){
-                    return common::make_error_value("Needed reconnect.", common::ErrorValue::E_ERROR);
-                }
-                if (context_->err == REDIS_ERR_EOF){
-                    return common::make_error_value("Needed reconnect.", common::ErrorValue::E_ERROR);
-                }
-
-                return cliPrintContextError(); /* avoid compiler warning */
+            common::Error rer = cliGetReply(&_reply);
+            if (rer) {
+                return rer;
             }
 
             redisReply *reply = static_cast<redisReply*>(_reply);
@@ -1564,7 +2977,7 @@ namespace fastonosql
                 char redir[512] = {0};
                 common::SNPrintf(redir, sizeof(redir), "-> Redirected to slot [%d] located at %s:%d", slot, config_.hostip_, config_.hostport_);
                 common::StringValue *val = common::Value::createStringValue(redir);
-                FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                 out->addChildren(child);
                 config_.cluster_reissue_command = 1;
 
@@ -1572,7 +2985,7 @@ namespace fastonosql
                 return common::Error();
             }
 
-            common::Error er = cliFormatReplyRaw(out, reply);
+            common::Error er = stream ? cliFormatStreamReply(out, reply) : cliFormatReplyRaw(out, reply);
             freeReplyObject(reply);
             return er;
         }
@@ -1602,74 +3015,176 @@ namespace fastonosql
             }
 
             if (!strcasecmp(command, "monitor")) config_.monitor_mode = 1;
-            if (!strcasecmp(command, "subscribe") || !strcasecmp(command,"psubscribe")) config_.pubsub_mode = 1;
+            // a subscribed connection takes no other commands, the Pub/Sub viewer reads one of its own
+            if (!strcasecmp(command, "subscribe") || !strcasecmp(command,"psubscribe")) {
+                return common::make_error_value("Subscribing would tie up the console connection, use the Pub/Sub viewer instead.", common::ErrorValue::E_ERROR);
+            }
             if (!strcasecmp(command, "sync") || !strcasecmp(command,"psync")) config_.slave_mode = 1;
 
             redisAppendCommandArgv(context_, argc, (const char**)argv, NULL);
+            // ends with an interrupt, the connection is reopened by then
             while (config_.monitor_mode) {
                 common::Error er = cliReadReply(out);
                 if (er){
+                    config_.monitor_mode = 0;
                     return er;
                 }
             }
 
-            if (config_.pubsub_mode) {
-                while (1) {
-                    common::Error er = cliReadReply(out);
-                    if (er){
-                        return er;
-                    }
-                }
+            if (config_.slave_mode) {
+                common::Error er = slaveMode(out);
+                config_.slave_mode = 0;
+                return er;  /* Error = slaveMode lost connection to master */
+            }
+
+            common::Error er = cliReadReply(out, isStreamRangeCommand(command));
+            if (er) {
+                return er;
+            }
+            else {
+                /* Store database number when SELECT was successfully executed. */
+                if (!strcasecmp(command, "select") && argc == 2) {
+                    config_.dbnum = atoi(argv[1]);
+                }
+                else if (!strcasecmp(command, "auth") && argc == 2) {
+                    er = cliSelect();
+                    if(er){
+                        return er;
+                    }
+                }
+            }
+            if (config_.interval){
+                common::utils::usleep(config_.interval);
+            }
+
+            return common::Error();
+        }
+
+        static bool isPipeLineCommand(const char *command)
+        {
+            if(!command){
+                return false;
+            }
+
+            bool skip = strcasecmp(command, "quit") == 0
+                        || strcasecmp(command, "exit") == 0
+                        || strcasecmp(command, "connect") == 0
+                        || strcasecmp(command, "help") == 0
+                        || strcasecmp(command, "?") == 0
+                        || strcasecmp(command, "shutdown") == 0
+                        || strcasecmp(command, "monitor") == 0
+                        || strcasecmp(command, "subscribe") == 0
+                        || strcasecmp(command, "psubscribe") == 0
+                        || strcasecmp(command, "sync") == 0
+                        || strcasecmp(command, "psync") == 0;
+
+            return !skip;
+        }
+
+        common::Error createBenchmarkClient(BenchmarkClient** client) WARN_UNUSED_RESULT
+        {
+            if (context_ == NULL){
+                return common::make_error_value("Not connected", common::Value::E_ERROR);
+            }
+
+            redisContext* context = NULL;
+            common::Error er = extraConnection(&context);
+            if(er){
+                return er;
+            }
+
+            if(config_.dbnum){
+                redisReply* reply = static_cast<redisReply*>(redisCommand(context, "SELECT %d", config_.dbnum));
+                bool selected = reply && reply->type != REDIS_REPLY_ERROR;
+                if(reply){
+                    freeReplyObject(reply);
+                }
+
+                if(!selected){
+                    redisFree(context);
+                    return common::make_error_value("Benchmark connection SELECT failed", common::ErrorValue::E_ERROR);
+                }
+            }
+
+            *client = new RedisBenchmarkClient(context);
+            return common::Error();
+        }
+
+        // SCAN narrows by the glob, then GET is pipelined for the whole batch;
+        // keys of other types answer WRONGTYPE and are skipped
+        common::Error scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                 std::vector<std::string>* keys, std::vector<std::string>* values, std::string* next) WARN_UNUSED_RESULT
+        {
+            if (context_ == NULL){
+                return common::make_error_value("Not connected", common::Value::E_ERROR);
+            }
+
+            const std::string glob = filter.glob();
+            if(redisAppendCommand(context_, "SCAN %s MATCH %b COUNT %u",
+                                  cursor.empty() ? "0" : cursor.c_str(), glob.data(), glob.size(), count) != REDIS_OK){
+                return cliAppendError();
+            }
+
+            void* scanReply = NULL;
+            common::Error er = cliGetReply(&scanReply);
+            if(er){
+                return er;
+            }
+
+            redisReply* reply = static_cast<redisReply*>(scanReply);
+
+            if(reply->type == REDIS_REPLY_ERROR){
+                char buff[1024] = {0};
+                common::SNPrintf(buff, sizeof(buff), "SCAN error: %s", reply->str);
+                freeReplyObject(reply);
+                return common::make_error_value(buff, common::Value::E_ERROR);
+            }
+
+            if(reply->type != REDIS_REPLY_ARRAY || reply->elements != 2){
+                freeReplyObject(reply);
+                return common::make_error_value("Invalid reply from SCAN!", common::Value::E_ERROR);
             }
 
-            if (config_.slave_mode) {
-                common::Error er = slaveMode(out);
-                config_.slave_mode = 0;
-                return er;  /* Error = slaveMode lost connection to master */
+            std::vector<std::string> names;
+            redisReply* rkeys = reply->element[1];
+            names.reserve(rkeys->elements);
+            for(size_t i = 0; i < rkeys->elements; ++i){
+                names.push_back(std::string(rkeys->element[i]->str, rkeys->element[i]->len));
             }
 
-            common::Error er = cliReadReply(out);
-            if (er) {
-                return er;
+            *next = reply->element[0]->str;
+            if(*next == "0"){
+                next->clear();
             }
-            else {
-                /* Store database number when SELECT was successfully executed. */
-                if (!strcasecmp(command, "select") && argc == 2) {
-                    config_.dbnum = atoi(argv[1]);
-                }
-                else if (!strcasecmp(command, "auth") && argc == 2) {
-                    er = cliSelect();
-                    if(er){
-                        return er;
-                    }
-                }
+            freeReplyObject(reply);
+
+            if(filter.patternType() == KeysFilter::REGEX){
+                filter.filter(&names);
             }
-            if (config_.interval){
-                common::utils::usleep(config_.interval);
+
+            for(size_t i = 0; i < names.size(); ++i){
+                if(redisAppendCommand(context_, "GET %b", names[i].data(), names[i].size()) != REDIS_OK){
+                    return cliAppendError();
+                }
             }
 
-            return common::Error();
-        }
+            for(size_t i = 0; i < names.size(); ++i){
+                void* valueReply = NULL;
+                er = cliGetReply(&valueReply);
+                if(er){
+                    return er;
+                }
 
-        static bool isPipeLineCommand(const char *command)
-        {
-            if(!command){
-                return false;
-            }
+                redisReply* value = static_cast<redisReply*>(valueReply);
 
-            bool skip = strcasecmp(command, "quit") == 0
-                        || strcasecmp(command, "exit") == 0
-                        || strcasecmp(command, "connect") == 0
-                        || strcasecmp(command, "help") == 0
-                        || strcasecmp(command, "?") == 0
-                        || strcasecmp(command, "shutdown") == 0
-                        || strcasecmp(command, "monitor") == 0
-                        || strcasecmp(command, "subscribe") == 0
-                        || strcasecmp(command, "psubscribe") == 0
-                        || strcasecmp(command, "sync") == 0
-                        || strcasecmp(command, "psync") == 0;
+                if(value->type == REDIS_REPLY_STRING){
+                    keys->push_back(names[i]);
+                    values->push_back(std::string(value->str, value->len));
+                }
+                freeReplyObject(value);
+            }
 
-            return !skip;
+            return common::Error();
         }
 
         common::Error executeAsPipeline(std::vector<FastoObjectCommandIPtr> cmds) WARN_UNUSED_RESULT
@@ -1706,7 +3221,7 @@ namespace fastonosql
 
                     if (argv == NULL) {
                         common::StringValue *val = common::Value::createStringValue("Invalid argument(s)");
-                        FastoObject* child = new FastoObject(cmd.get(), val, config_.mb_delim_);
+                        FastoObject* child = new(cmd.get()) FastoObject(cmd.get(), val, config_.mb_delim_);
                         cmd->addChildren(child);
                     }
                     else if (argc > 0){
@@ -1761,7 +3276,7 @@ namespace fastonosql
 
     bool RedisDriver::isConnected() const
     {
-        return impl_->context_;
+        return impl_->connected_.loadAcquire() != 0;
     }
 
     bool RedisDriver::isAuthenticated() const
@@ -1792,7 +3307,7 @@ namespace fastonosql
         FastoObjectCommand* cmd = createCommand<RedisCommand>(root, INFO_REQUEST, common::Value::C_INNER);
         common::Error res = execute(cmd);
         if(!res){
-            FastoObject::child_container_type ch = root->childrens();
+            const FastoObject::child_container_type& ch = root->childrens();
             if(ch.size()){
                 *info = makeRedisServerInfo(ch[0]);
             }
@@ -1805,6 +3320,16 @@ namespace fastonosql
         return res;
     }
 
+    bool RedisDriver::hasMonitoringConnection() const
+    {
+        return true;
+    }
+
+    common::Error RedisDriver::monitoringServerInfo(ServerInfo** info)
+    {
+        return impl_->monitoringInfo(info);
+    }
+
     common::Error RedisDriver::serverDiscoveryInfo(ServerInfo **sinfo, ServerDiscoveryInfo **dinfo, DataBaseInfo **dbinfo)
     {
         ServerInfo *lsinfo = NULL;
@@ -1837,7 +3362,7 @@ namespace fastonosql
             return common::Error(); //not error serverInfo is valid
         }
 
-        FastoObject::child_container_type ch = cmd->childrens();
+        const FastoObject::child_container_type& ch = cmd->childrens();
         if(ch.size()){
             FastoObject* obj = ch[0];
             if(obj){
@@ -1859,6 +3384,17 @@ namespace fastonosql
         return er;
     }
 
+    common::Error RedisDriver::scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                          std::vector<std::string>* keys, std::vector<std::string>* values, std::string* next)
+    {
+        return impl_->scanValues(filter, cursor, count, keys, values, next);
+    }
+
+    common::Error RedisDriver::createBenchmarkClient(BenchmarkClient** client)
+    {
+        return impl_->createBenchmarkClient(client);
+    }
+
     void RedisDriver::handleConnectEvent(events::ConnectRequestEvent *ev)
     {
         QObject *sender = ev->sender();
@@ -1886,6 +3422,11 @@ namespace fastonosql
             latencyMode(ev);
         }
 
+        /* Intrinsic latency mode */
+        if (impl_->config_.intrinsic_latency_mode) {
+            intrinsicLatencyMode(ev);
+        }
+
         /* Slave mode */
         if (impl_->config_.slave_mode) {
             slaveMode(ev);
@@ -2016,6 +3557,92 @@ namespace fastonosql
         notifyProgress(sender, 100);
     }
 
+    void RedisDriver::handleMonitorEvent(events::MonitorRequestEvent* ev)
+    {
+        QObject *sender = ev->sender();
+        notifyProgress(sender, 0);
+        events::MonitorResponceEvent::value_type res(ev->value());
+        notifyProgress(sender, 25);
+        common::Error er = impl_->monitorStream(res, &res.last_);
+        if(er){
+            res.setErrorInfo(er);
+        }
+        notifyProgress(sender, 75);
+        reply(sender, new events::MonitorResponceEvent(this, res));
+        notifyProgress(sender, 100);
+    }
+
+    void RedisDriver::handleSlowLogEvent(events::SlowLogRequestEvent* ev)
+    {
+        QObject *sender = ev->sender();
+        events::SlowLogResponceEvent::value_type res(ev->value());
+        common::Error er = impl_->monitoringSlowLog(res.afterId_, &res.entries_);
+        if(!er){
+            res.msec_ = common::time::current_mstime();
+            er = impl_->monitoringCommandStats(&res.stats_);
+        }
+
+        if(er){
+            res.setErrorInfo(er);
+        }
+        reply(sender, new events::SlowLogResponceEvent(this, res));
+    }
+
+    void RedisDriver::handleClientListEvent(events::ClientListRequestEvent* ev)
+    {
+        QObject *sender = ev->sender();
+        events::ClientListResponceEvent::value_type res(ev->value());
+        common::Error er = impl_->monitoringClientList(&res.list_);
+        if(er){
+            res.setErrorInfo(er);
+        }
+        reply(sender, new events::ClientListResponceEvent(this, res));
+    }
+
+    void RedisDriver::handleClientKillEvent(events::ClientKillRequestEvent* ev)
+    {
+        QObject *sender = ev->sender();
+        notifyProgress(sender, 0);
+        events::ClientKillResponceEvent::value_type res(ev->value());
+        common::Error er = impl_->monitoringClientKill(res.ids_, &res.killed_);
+        if(er){
+            res.setErrorInfo(er);
+        }
+        notifyProgress(sender, 75);
+        reply(sender, new events::ClientKillResponceEvent(this, res));
+        notifyProgress(sender, 100);
+    }
+
+    void RedisDriver::handlePubSubEvent(events::PubSubRequestEvent* ev)
+    {
+        QObject *sender = ev->sender();
+        notifyProgress(sender, 0);
+        events::PubSubResponceEvent::value_type res(ev->value());
+        notifyProgress(sender, 25);
+        common::Error er = impl_->pubSubStream(res, &res.received_);
+        if(er){
+            res.setErrorInfo(er);
+        }
+        notifyProgress(sender, 75);
+        reply(sender, new events::PubSubResponceEvent(this, res));
+        notifyProgress(sender, 100);
+    }
+
+    void RedisDriver::handleKeyspaceEvent(events::KeyspaceRequestEvent* ev)
+    {
+        QObject *sender = ev->sender();
+        notifyProgress(sender, 0);
+        events::KeyspaceResponceEvent::value_type res(ev->value());
+        notifyProgress(sender, 25);
+        common::Error er = impl_->keyspaceStream(&res);
+        if(er){
+            res.setErrorInfo(er);
+        }
+        notifyProgress(sender, 75);
+        reply(sender, new events::KeyspaceResponceEvent(this, res));
+        notifyProgress(sender, 100);
+    }
+
     common::Error RedisDriver::interacteveMode(events::ProcessConfigArgsRequestEvent *ev)
     {
         QObject *sender = ev->sender();
@@ -2050,6 +3677,27 @@ namespace fastonosql
         return er;
     }
 
+    common::Error RedisDriver::intrinsicLatencyMode(events::ProcessConfigArgsRequestEvent* ev)
+    {
+        QObject *sender = ev->sender();
+        notifyProgress(sender, 0);
+        events::EnterModeEvent::value_type resEv(this, IntrinsicLatencyMode);
+        reply(sender, new events::EnterModeEvent(this, resEv));
+
+        RootLocker lock = make_locker(sender, INTRINSIC_LATENCY_REQUEST);
+
+        FastoObjectIPtr obj = lock.root_;
+        common::Error er = impl_->intrinsicLatencyMode(obj.get());
+        if(er){
+            LOG_ERROR(er, true);
+        }
+
+        events::LeaveModeEvent::value_type resEv2(this, IntrinsicLatencyMode);
+        reply(sender, new events::LeaveModeEvent(this, resEv2));
+        notifyProgress(sender, 100);
+        return er;
+    }
+
     common::Error RedisDriver::slaveMode(events::ProcessConfigArgsRequestEvent* ev)
     {
         QObject* sender = ev->sender();
@@ -2170,7 +3818,7 @@ namespace fastonosql
                 FastoObjectIPtr outRoot = lock.root_;
                 double step = 100.0f/length;
                 for(size_t n = 0; n < length; ++n){
-                    if(interrupt_){
+                    if(interrupt_.loadAcquire()){
                         er.reset(new common::ErrorValue("Interrupted exec.", common::ErrorValue::E_INTERRUPTED));
                         res.setErrorInfo(er);
                         break;
@@ -2197,7 +3845,7 @@ namespace fastonosql
                         else{
                             std::string cmdcom = cmd->inputCmd();
                             std::transform(cmdcom.begin(), cmdcom.end(), cmdcom.begin(), ::tolower);
-                            FastoObject::child_container_type rchildrens = cmd->childrens();
+                            const FastoObject::child_container_type& rchildrens = cmd->childrens();
                             if(cmdcom == "auth"){
                                 if(rchildrens.size() == 1){
                                     FastoObject* obj = dynamic_cast<FastoObject*>(rchildrens[0]);
@@ -2226,6 +3874,18 @@ namespace fastonosql
         QObject *sender = ev->sender();
         notifyProgress(sender, 0);
             events::CommandResponceEvent::value_type res(ev->value());
+            CommandLoadKey* loadc = dynamic_cast<CommandLoadKey*>(res.cmd_.get());
+            if(loadc && isPagedType(loadc->key().type())){
+        notifyProgress(sender, 25);
+                common::Error er = loadValuePages(sender, loadc);
+                if(er){
+                    res.setErrorInfo(er);
+                }
+                reply(sender, new events::CommandResponceEvent(this, res));
+                notifyProgress(sender, 100);
+                return;
+            }
+
             std::string cmdtext;
             common::Error er = commandByType(res.cmd_, cmdtext);
             if(er){
@@ -2255,10 +3915,20 @@ namespace fastonosql
         notifyProgress(sender, 50);
 
         if(impl_->context_){
+            impl_->connected_.storeRelease(0);
             redisFree(impl_->context_);
             impl_->context_ = NULL;
         }
 
+        {
+            // a sample in flight finishes first, the next one opens a new connection
+            QMutexLocker lock(&impl_->monitoring_lock_);
+            if(impl_->monitoring_context_){
+                redisFree(impl_->monitoring_context_);
+                impl_->monitoring_context_ = NULL;
+            }
+        }
+
             reply(sender, new events::DisconnectResponceEvent(this, res));
         notifyProgress(sender, 100);
     }
@@ -2276,14 +3946,10 @@ namespace fastonosql
                 res.setErrorInfo(er);
             }
             else{
-                FastoObject::child_container_type rchildrens = cmd->childrens();
+                const FastoObject::child_container_type& rchildrens = cmd->childrens();
                 if(rchildrens.size()){
                     DCHECK(rchildrens.size() == 1);
-                    FastoObjectArray* array = dynamic_cast<FastoObjectArray*>(rchildrens[0]);
-                    if(!array){
-                        goto done;
-                    }
-                    common::ArrayValue* ar = array->array();
+                    FastoObjectArray* ar = dynamic_cast<FastoObjectArray*>(rchildrens[0]);
                     if(!ar){
                         goto done;
                     }
@@ -2323,17 +3989,34 @@ namespace fastonosql
         QObject *sender = ev->sender();
         notifyProgress(sender, 0);
             events::LoadDatabaseContentResponceEvent::value_type res(ev->value());
+            const KeysFilter filter = res.filter();
+            // SCAN TYPE needs 6.0, older servers are filtered by the pipelined TYPE replies
+            ServerInfoSPtr sinfo = serverInfo();
+            const std::string rtype = convertToStringRType(filter.type());
+            const bool serverType = filter.hasType() && !rtype.empty() && sinfo && sinfo->version() >= PROJECT_VERSION_CHECK(6,0,0);
             char patternResult[1024] = {0};
-            common::SNPrintf(patternResult, sizeof(patternResult), GET_KEYS_PATTERN_3ARGS_ISI, res.cursorIn_, res.pattern_, res.countKeys_);
+            if(serverType){
+                common::SNPrintf(patternResult, sizeof(patternResult), GET_KEYS_TYPE_PATTERN_4ARGS_ISIS, res.cursorIn_, filter.glob(), res.countKeys_, rtype);
+            }
+            else{
+                common::SNPrintf(patternResult, sizeof(patternResult), GET_KEYS_PATTERN_3ARGS_ISI, res.cursorIn_, filter.glob(), res.countKeys_);
+            }
             FastoObjectIPtr root = FastoObject::createRoot(patternResult);
         notifyProgress(sender, 50);
-            FastoObjectCommand* cmd = createCommand<RedisCommand>(root, patternResult, common::Value::C_INNER);
-            common::Error er = execute(cmd);
+            common::Error er;
+            if(!filter.isValid()){
+                er = common::make_error_value(filter.errorString(), common::ErrorValue::E_ERROR);
+            }
+            else{
+                FastoObjectCommand* cmd = createCommand<RedisCommand>(root, patternResult, common::Value::C_INNER);
+                er = execute(cmd);
+            }
+
             if(er){
                 res.setErrorInfo(er);
             }
             else{
-                FastoObject::child_container_type rchildrens = cmd->childrens();
+                const FastoObject::child_container_type& rchildrens = cmd->childrens();
                 if(rchildrens.size()){
                     DCHECK(rchildrens.size() == 1);
                     FastoObjectArray* array = dynamic_cast<FastoObjectArray*>(rchildrens[0]);
@@ -2341,46 +4024,59 @@ namespace fastonosql
                         goto done;
                     }
 
-                    common::ArrayValue* arm = array->array();
-                    if(!arm->size()){
+                    if(!array->size()){
                         goto done;
                     }
 
                     std::string cursor;
-                    bool isok = arm->getString(0, &cursor);
+                    bool isok = array->getString(0, &cursor);
                     if(!isok){
                        goto done;
                     }
 
                     res.cursorOut_ = common::convertFromString<uint32_t>(cursor);
 
-                    rchildrens = array->childrens();
-                    if(!rchildrens.size()){
+                    const FastoObject::child_container_type& kchildrens = array->childrens();
+                    if(!kchildrens.size()){
                         goto done;
                     }
 
-                    FastoObject* obj = rchildrens[0];
-                    FastoObjectArray* arr = dynamic_cast<FastoObjectArray*>(obj);
-                    if(!arr){
+                    FastoObject* obj = kchildrens[0];
+                    FastoObjectArray* ar = dynamic_cast<FastoObjectArray*>(obj);
+                    if(!ar){
                         goto done;
                     }
 
-                    common::ArrayValue* ar = arr->array();
-                    std::vector<FastoObjectCommandIPtr> cmds;
-                    cmds.reserve(ar->size() * 2);
+                    std::vector<std::string> names;
+                    names.reserve(ar->size());
                     for(int i = 0; i < ar->size(); ++i){
                         std::string key;
                         bool isok = ar->getString(i, &key);
                         DCHECK(isok);
                         if(isok){
-                            NKey k(key);
-                            NDbKValue ress(k, NValue());
-                            cmds.push_back(createCommandFast("TYPE " + ress.keyString(), common::Value::C_INNER));
-                            cmds.push_back(createCommandFast("TTL " + ress.keyString(), common::Value::C_INNER));
-                            res.keys_.push_back(ress);
+                            names.push_back(key);
                         }
                     }
 
+                    // MATCH already applied the glob, regexes are matched here
+                    if(filter.patternType() == KeysFilter::REGEX){
+                        filter.filter(&names);
+                    }
+
+                    if(names.empty()){
+                        goto done;
+                    }
+
+                    std::vector<FastoObjectCommandIPtr> cmds;
+                    cmds.reserve(names.size() * 2);
+                    for(size_t i = 0; i < names.size(); ++i){
+                        NKey k(names[i]);
+                        NDbKValue ress(k, NValue());
+                        cmds.push_back(createCommandFast("TYPE " + ress.keyString(), common::Value::C_INNER));
+                        cmds.push_back(createCommandFast("TTL " + ress.keyString(), common::Value::C_INNER));
+                        res.keys_.push_back(ress);
+                    }
+
                     er = impl_->executeAsPipeline(cmds);
                     if(er){
                        goto done;
@@ -2388,14 +4084,14 @@ namespace fastonosql
 
                     for(int i = 0; i < res.keys_.size(); ++i){
                         FastoObjectIPtr cmdType = cmds[i*2];
-                        FastoObject::child_container_type tchildrens = cmdType->childrens();
+                        const FastoObject::child_container_type& tchildrens = cmdType->childrens();
                         if(tchildrens.size()){
                             DCHECK(tchildrens.size() == 1);
                             if(tchildrens.size() == 1){
                                 FastoObject* type = tchildrens[0];
                                 std::string typeRedis = type->toString();
                                 common::Value::Type ctype = convertFromStringRType(typeRedis);
-                                common::Value* emptyval = common::Value::createEmptyValueFromType(ctype);
+                                common::Value* emptyval = createEmptyValueFromType(ctype);
                                 common::ValueSPtr v = make_value(emptyval);
                                 NValue val(v);
                                 res.keys_[i].setValue(val);
@@ -2403,19 +4099,51 @@ namespace fastonosql
                         }
 
                         FastoObjectIPtr cmdType2 = cmds[i*2+1];
-                        tchildrens = cmdType2->childrens();
-                        if(tchildrens.size()){
-                            DCHECK(tchildrens.size() == 1);
-                            if(tchildrens.size() == 1){
-                                FastoObject* fttl = tchildrens[0];
-                                common::Value* vttl = fttl->value();
-                                int32_t ttl = 0;
-                                if(vttl->getAsInteger(&ttl)){
+                        const FastoObject::child_container_type& ttlchildrens = cmdType2->childrens();
+                        if(ttlchildrens.size()){
+                            DCHECK(ttlchildrens.size() == 1);
+                            if(ttlchildrens.size() == 1){
+                                FastoObject* fttl = ttlchildrens[0];
+                                int ttl = 0;
+                                if(fttl->getAsInteger(&ttl)){
                                     res.keys_[i].setTTL(ttl);
                                 }
                             }
                         }
                     }
+
+                    if(filter.hasType() && !serverType){
+                        std::vector<NDbKValue> typed;
+                        for(size_t i = 0; i < res.keys_.size(); ++i){
+                            if(filter.matchType(res.keys_[i].type())){
+                                typed.push_back(res.keys_[i]);
+                            }
+                        }
+                        res.keys_.swap(typed);
+                    }
+
+                    std::vector<FastoObjectCommandIPtr> scmds;
+                    std::vector<size_t> sindexes;
+                    for(size_t i = 0; i < res.keys_.size(); ++i){
+                        const char* scmd = sizeCommand(res.keys_[i].type());
+                        if(scmd){
+                            scmds.push_back(createCommandFast(scmd + res.keys_[i].keyString(), common::Value::C_INNER));
+                            sindexes.push_back(i);
+                        }
+                    }
+
+                    if(!scmds.empty()){
+                        common::Error ser = impl_->executeAsPipeline(scmds);
+                        for(size_t i = 0; !ser && i < scmds.size(); ++i){
+                            const FastoObject::child_container_type& schildrens = scmds[i]->childrens();
+                            if(schildrens.size() == 1){
+                                int size = 0;
+                                if(schildrens[0]->getAsInteger(&size)){
+                                    res.keys_[sindexes[i]].setSize(size);
+                                }
+                            }
+                        }
+                    }
                 }
             }
     done:
@@ -2460,7 +4188,7 @@ namespace fastonosql
                 res.setErrorInfo(er);
             }
             else{
-                FastoObject::child_container_type ch = cmd->childrens();
+                const FastoObject::child_container_type& ch = cmd->childrens();
                 if(ch.size()){
                     DCHECK(ch.size() == 1);
                     ServerInfoSPtr red(makeRedisServerInfo(ch[0]));
@@ -2485,7 +4213,7 @@ namespace fastonosql
                 res.setErrorInfo(er);
             }
             else{
-                FastoObject::child_container_type ch = cmd->childrens();
+                const FastoObject::child_container_type& ch = cmd->childrens();
                 if(ch.size()){
                     DCHECK(ch.size() == 1);
                     FastoObjectArray* array = dynamic_cast<FastoObjectArray*>(ch[0]);
@@ -2521,6 +4249,131 @@ namespace fastonosql
         notifyProgress(sender, 100);
     }
 
+    common::Error RedisDriver::loadValuePages(QObject* sender, CommandLoadKey* command)
+    {
+        const NDbKValue key = command->key();
+        const std::string key_str = key.keyString();
+        const common::Value::Type t = key.type();
+        const bool all = command->page() == LOAD_ALL_PAGES;
+        const uint32_t page = all ? 0 : command->page();
+        const bool scan = isCursorType(t);
+        const std::string first = firstCursor(t);
+
+        // *SCAN and stream pages can only be reached through cursors of the previous ones
+        const std::string cursors_key = common::convertToString(impl_->config_.dbnum) + ":" + key_str;
+        if(scan && impl_->scan_cursors_.size() >= LOAD_MAX_CURSORS_KEYS && impl_->scan_cursors_.find(cursors_key) == impl_->scan_cursors_.end()){
+            impl_->scan_cursors_.clear();
+        }
+
+        std::vector<std::string> dummy;
+        std::vector<std::string>& cursors = scan ? impl_->scan_cursors_[cursors_key] : dummy;
+        if(scan && (page == 0 || cursors.empty())){
+            cursors.assign(1, first);
+        }
+
+        uint32_t start = page;
+        if(scan && start >= cursors.size()){
+            start = cursors.size() - 1;
+        }
+
+        RootLocker lock = make_locker(sender, pageCommand(t, key_str, page, scan && page < cursors.size() ? cursors[page] : first));
+        FastoObjectIPtr root = lock.root_;
+        int64_t loaded = 0;
+        for(uint32_t i = start; all || i <= page; ++i){
+            if(interrupt_.loadAcquire()){
+                common::Error er;
+                er.reset(new common::ErrorValue("Interrupted load.", common::ErrorValue::E_INTERRUPTED));
+                return er;
+            }
+
+            const std::string cmdtext = pageCommand(t, key_str, i, scan ? cursors[i] : std::string());
+            // pages before the requested one are only walked for their cursors
+            FastoObjectIPtr skipped = i < page ? FastoObject::createRoot(cmdtext) : root;
+            FastoObjectCommand* cmd = createCommand<RedisCommand>(skipped, cmdtext, common::Value::C_INNER);
+            common::Error er = execute(cmd);
+            if(er){
+                return er;
+            }
+
+            std::string next;
+            size_t count = pageReplySize(cmd, t, &next);
+            loaded += count;
+            if(scan){
+                cursors.resize(i + 1);
+                cursors.push_back(next);
+                if(next == "0" || (t == TYPE_STREAM && count < LOAD_PAGE_SIZE)){
+                    command->setLastPage(true);
+                    break;
+                }
+            }
+            else if(count < (t == common::Value::TYPE_STRING ? LOAD_STRING_PAGE_BYTES : LOAD_PAGE_SIZE)){
+                command->setLastPage(true);
+                break;
+            }
+
+            if(all && key.size() > 0){
+                notifyProgress(sender, std::min<int64_t>(99, 25 + loaded * 75 / key.size()));
+            }
+        }
+
+        if(t == TYPE_STREAM && page == 0){
+            return loadStreamGroups(root, key_str);
+        }
+
+        return common::Error();
+    }
+
+    common::Error RedisDriver::loadStreamGroups(FastoObjectIPtr root, const std::string& key)
+    {
+        char patternResult[1024] = {0};
+        common::SNPrintf(patternResult, sizeof(patternResult), GET_KEY_STREAM_GROUPS_PATTERN_1ARGS_S, key);
+        FastoObjectCommand* cmd = createCommand<RedisCommand>(root, patternResult, common::Value::C_INNER);
+        common::Error er = execute(cmd);
+        if(er){
+            return er;
+        }
+
+        const FastoObject::child_container_type& rchildrens = cmd->childrens();
+        if(rchildrens.size() != 1){
+            return common::Error();
+        }
+
+        // every group is a flat "name" value "consumers" value ... array
+        std::vector<std::string> groups;
+        const FastoObject::child_container_type& infos = rchildrens[0]->childrens();
+        for(size_t i = 0; i < infos.size(); ++i){
+            FastoObjectArray* ar = dynamic_cast<FastoObjectArray*>(infos[i]);
+            if(!ar){
+                continue;
+            }
+
+            for(size_t j = 0; j + 1 < ar->size(); j += 2){
+                std::string field;
+                std::string name;
+                if(ar->getString(j, &field) && field == "name" && ar->getString(j + 1, &name)){
+                    groups.push_back(name);
+                    break;
+                }
+            }
+        }
+
+        for(size_t i = 0; i < groups.size(); ++i){
+            if(interrupt_.loadAcquire()){
+                er.reset(new common::ErrorValue("Interrupted load.", common::ErrorValue::E_INTERRUPTED));
+                return er;
+            }
+
+            common::SNPrintf(patternResult, sizeof(patternResult), GET_KEY_STREAM_PENDING_PATTERN_2ARGS_SS, key, groups[i]);
+            FastoObjectCommand* pending = createCommand<RedisCommand>(root, patternResult, common::Value::C_INNER);
+            er = execute(pending);
+            if(er){
+                return er;
+            }
+        }
+
+        return common::Error();
+    }
+
     common::Error RedisDriver::commandDeleteImpl(CommandDeleteKey* command, std::string& cmdstring) const
     {
         char patternResult[1024] = {0};
@@ -2547,6 +4400,9 @@ namespace fastonosql
         else if(key.type() == common::Value::TYPE_HASH){
             common::SNPrintf(patternResult, sizeof(patternResult), GET_KEY_HASH_PATTERN_1ARGS_S, key.keyString());
         }
+        else if(key.type() == TYPE_STREAM){
+            common::SNPrintf(patternResult, sizeof(patternResult), GET_KEY_STREAM_PATTERN_1ARGS_S, key.keyString());
+        }
         else{
             common::SNPrintf(patternResult, sizeof(patternResult), GET_KEY_PATTERN_1ARGS_S, key.keyString());
         }
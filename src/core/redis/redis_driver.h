@@ -291,6 +291,22 @@ namespace fastonosql
                     "Forget about all watched keys", PROJECT_VERSION_GENERATE(2,2,0), UNDEFINED_EXAMPLE_STR, 0, 0),
         CommandInfo("WATCH", "key [key ...]",
                     "Watch the given keys to determine execution of the MULTI/EXEC block", PROJECT_VERSION_GENERATE(2,2,0), UNDEFINED_EXAMPLE_STR, 1, 0),
+        CommandInfo("XADD", "<key> <ID> <field> <value> [field value ...]",
+                    "Appends a new entry to a stream", PROJECT_VERSION_GENERATE(5,0,0), UNDEFINED_EXAMPLE_STR, 4, 0),
+        CommandInfo("XDEL", "<key> <ID> [ID ...]",
+                    "Removes the specified entries from the stream", PROJECT_VERSION_GENERATE(5,0,0), UNDEFINED_EXAMPLE_STR, 2, 0),
+        CommandInfo("XINFO", "<CONSUMERS key groupname|GROUPS key|STREAM key>",
+                    "Get information on streams and consumer groups", PROJECT_VERSION_GENERATE(5,0,0), UNDEFINED_EXAMPLE_STR, 2, 1),
+        CommandInfo("XLEN", "<key>",
+                    "Return the number of entries in a stream", PROJECT_VERSION_GENERATE(5,0,0), UNDEFINED_EXAMPLE_STR, 1, 0),
+        CommandInfo("XPENDING", "<key> <group> [start end count] [consumer]",
+                    "Return information and entries from a stream consumer group pending entries list", PROJECT_VERSION_GENERATE(5,0,0), UNDEFINED_EXAMPLE_STR, 2, 4),
+        CommandInfo("XRANGE", "<key> <start> <end> [COUNT count]",
+                    "Return a range of elements in a stream, with IDs matching the specified IDs interval", PROJECT_VERSION_GENERATE(5,0,0), UNDEFINED_EXAMPLE_STR, 3, 2),
+        CommandInfo("XREVRANGE", "<key> <end> <start> [COUNT count]",
+                    "Return a range of elements in a stream, with IDs matching the specified IDs interval, in reverse order", PROJECT_VERSION_GENERATE(5,0,0), UNDEFINED_EXAMPLE_STR, 3, 2),
+        CommandInfo("XTRIM", "<key> MAXLEN [~] <count>",
+                    "Trims the stream to a given number of items", PROJECT_VERSION_GENERATE(5,0,0), UNDEFINED_EXAMPLE_STR, 3, 1),
         CommandInfo("ZADD", "<key> <score> <member> [score member ...]",
                     "Add one or more members to a sorted set, or update its score if it already exists", PROJECT_VERSION_GENERATE(1,2,0), UNDEFINED_EXAMPLE_STR, 3, 0),
         CommandInfo("ZCARD", "<key>",
@@ -421,6 +437,12 @@ namespace fastonosql
         virtual common::Error serverInfo(ServerInfo** info);
         virtual common::Error serverDiscoveryInfo(ServerInfo** sinfo, ServerDiscoveryInfo** dinfo, DataBaseInfo** dbinfo);
         virtual common::Error currentDataBaseInfo(DataBaseInfo** info);
+        virtual bool hasMonitoringConnection() const;
+        virtual common::Error monitoringServerInfo(ServerInfo** info);
+        virtual common::Error scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                         std::vector<std::string>* keys, std::vector<std::string>* values,
+                                         std::string* next);
+        virtual common::Error createBenchmarkClient(BenchmarkClient** client);
 
         virtual void handleConnectEvent(events::ConnectRequestEvent* ev);
         virtual void handleDisconnectEvent(events::DisconnectRequestEvent* ev);
@@ -435,6 +457,12 @@ namespace fastonosql
         virtual void handleExportEvent(events::ExportRequestEvent* ev);
         virtual void handleChangePasswordEvent(events::ChangePasswordRequestEvent* ev);
         virtual void handleChangeMaxConnectionEvent(events::ChangeMaxConnectionRequestEvent* ev);
+        virtual void handleMonitorEvent(events::MonitorRequestEvent* ev);
+        virtual void handlePubSubEvent(events::PubSubRequestEvent* ev);
+        virtual void handleKeyspaceEvent(events::KeyspaceRequestEvent* ev);
+        virtual void handleSlowLogEvent(events::SlowLogRequestEvent* ev);
+        virtual void handleClientListEvent(events::ClientListRequestEvent* ev);
+        virtual void handleClientKillEvent(events::ClientKillRequestEvent* ev);
 
         virtual common::Error commandDeleteImpl(CommandDeleteKey* command, std::string& cmdstring) const WARN_UNUSED_RESULT;
         virtual common::Error commandLoadImpl(CommandLoadKey* command, std::string& cmdstring) const WARN_UNUSED_RESULT;
@@ -447,12 +475,15 @@ namespace fastonosql
         virtual void handleCommandRequestEvent(events::CommandRequestEvent* ev);
 
         ServerInfoSPtr makeServerInfoFromString(const std::string& val);
+        common::Error loadValuePages(QObject* sender, CommandLoadKey* command) WARN_UNUSED_RESULT;
+        common::Error loadStreamGroups(FastoObjectIPtr root, const std::string& key) WARN_UNUSED_RESULT;
 
         struct pimpl;
         pimpl* const impl_;
 
         common::Error interacteveMode(events::ProcessConfigArgsRequestEvent* ev);
         common::Error latencyMode(events::ProcessConfigArgsRequestEvent* ev);
+        common::Error intrinsicLatencyMode(events::ProcessConfigArgsRequestEvent* ev);
         common::Error slaveMode(events::ProcessConfigArgsRequestEvent* ev);
         common::Error getRDBMode(events::ProcessConfigArgsRequestEvent* ev);
         common::Error findBigKeysMode(events::ProcessConfigArgsRequestEvent* ev);
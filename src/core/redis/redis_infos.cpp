@@ -1,5 +1,7 @@
 #include "core/redis/redis_infos.h"
 
+#include <string.h>
+
 #include <ostream>
 #include <sstream>
 
@@ -93,7 +95,8 @@ namespace
        Field(REDIS_BACKLOG_ACTIVE_LABEL, common::Value::TYPE_UINTEGER),
        Field(REDIS_BACKLOG_SIZE_LABEL, common::Value::TYPE_UINTEGER),
        Field(REDIS_BACKLOG_FIRST_BYTE_OFFSET_LABEL, common::Value::TYPE_UINTEGER),
-       Field(REDIS_BACKLOG_HISTEN_LABEL, common::Value::TYPE_UINTEGER)
+       Field(REDIS_BACKLOG_HISTEN_LABEL, common::Value::TYPE_UINTEGER),
+       Field(REDIS_MASTER_LAST_IO_SECONDS_AGO_LABEL, common::Value::TYPE_INTEGER)
     };
 
     const std::vector<Field> redisCpuFields =
@@ -188,61 +191,64 @@ namespace fastonosql
         arch_bits_(0), multiplexing_api_(), gcc_version_() ,process_id_(0),
         run_id_(), tcp_port_(0), uptime_in_seconds_(0), uptime_in_days_(0), hz_(0), lru_clock_(0)
     {
-        const std::string &src = server_text;
-        size_t pos = 0;
-        size_t start = 0;
-        while((pos = src.find("\r\n", start)) != std::string::npos){
-            std::string line = src.substr(start, pos-start);
-            size_t delem = line.find_first_of(':');
-            std::string field = line.substr(0, delem);
-            std::string value = line.substr(delem + 1);
-            if(field == REDIS_VERSION_LABEL){
-                redis_version_ = value;
-            }
-            else if(field == REDIS_GIT_SHA1_LABEL){
-                redis_git_sha1_ = value;
-            }
-            else if(field == REDIS_GIT_DIRTY_LABEL){
-                redis_git_dirty_ = value;
-            }
-            else if(field == REDIS_MODE_LABEL){
-                redis_mode_ = value;
-            }
-            else if(field == REDIS_OS_LABEL){
-                os_ = value;
-            }
-            else if(field == REDIS_ARCH_BITS_LABEL){
-                arch_bits_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_MULTIPLEXING_API_LABEL){
-                multiplexing_api_ = value;
-            }
-            else if(field == REDIS_GCC_VERSION_LABEL){
-                gcc_version_ = value;                
-            }
-            else if(field == REDIS_PROCESS_ID_LABEL){;
-                process_id_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_RUN_ID_LABEL){
-                run_id_ = value;
-            }
-            else if(field == REDIS_TCP_PORT_LABEL){
-                tcp_port_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_UPTIME_IN_SECONDS_LABEL){
-                uptime_in_seconds_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_UPTIME_IN_DAYS_LABEL){
-                uptime_in_days_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_HZ_LABEL){
-                hz_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_LRU_CLOCK_LABEL){
-                lru_clock_ = common::convertFromString<uint32_t>(value);
-            }
-            start = pos + 2;
+        parseInfoSection(server_text, this);
+    }
+
+    bool RedisServerInfo::Server::parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value)
+    {
+        switch(hash){
+        INFO_FIELD_CASE(field, REDIS_VERSION_LABEL)
+            value.assignTo(&redis_version_);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_GIT_SHA1_LABEL)
+            value.assignTo(&redis_git_sha1_);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_GIT_DIRTY_LABEL)
+            value.assignTo(&redis_git_dirty_);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_BUILD_ID_LABEL)
+            value.assignTo(&redis_build_id_);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_MODE_LABEL)
+            value.assignTo(&redis_mode_);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_OS_LABEL)
+            value.assignTo(&os_);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_ARCH_BITS_LABEL)
+            arch_bits_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_MULTIPLEXING_API_LABEL)
+            value.assignTo(&multiplexing_api_);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_GCC_VERSION_LABEL)
+            value.assignTo(&gcc_version_);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_PROCESS_ID_LABEL)
+            process_id_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_RUN_ID_LABEL)
+            value.assignTo(&run_id_);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_TCP_PORT_LABEL)
+            tcp_port_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_UPTIME_IN_SECONDS_LABEL)
+            uptime_in_seconds_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_UPTIME_IN_DAYS_LABEL)
+            uptime_in_days_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_HZ_LABEL)
+            hz_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_LRU_CLOCK_LABEL)
+            lru_clock_ = infoToUInt32(value);
+            return true;
+        default:
+            break;
         }
+        return false;
     }
 
     common::Value* RedisServerInfo::Server::valueByIndex(unsigned char index) const
@@ -297,28 +303,28 @@ namespace fastonosql
         : connected_clients_(0), client_longest_output_list_(0),
         client_biggest_input_buf_(0), blocked_clients_(0)
     {
-        const std::string &src = client_text;
-        size_t pos = 0;
-        size_t start = 0;
-        while((pos = src.find(("\r\n"), start)) != std::string::npos){
-            std::string line = src.substr(start, pos-start);
-            size_t delem = line.find_first_of(':');
-            std::string field = line.substr(0, delem);
-            std::string value = line.substr(delem + 1);
-            if(field == REDIS_CONNECTED_CLIENTS_LABEL){
-                connected_clients_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_CLIENT_LONGEST_OUTPUT_LIST_LABEL){
-                client_longest_output_list_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_CLIENT_BIGGEST_INPUT_BUF_LABEL){
-                client_biggest_input_buf_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_BLOCKED_CLIENTS_LABEL){
-                blocked_clients_ = common::convertFromString<uint32_t>(value);
-            }
-            start = pos + 2;
+        parseInfoSection(client_text, this);
+    }
+
+    bool RedisServerInfo::Clients::parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value)
+    {
+        switch(hash){
+        INFO_FIELD_CASE(field, REDIS_CONNECTED_CLIENTS_LABEL)
+            connected_clients_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_CLIENT_LONGEST_OUTPUT_LIST_LABEL)
+            client_longest_output_list_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_CLIENT_BIGGEST_INPUT_BUF_LABEL)
+            client_biggest_input_buf_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_BLOCKED_CLIENTS_LABEL)
+            blocked_clients_ = infoToUInt32(value);
+            return true;
+        default:
+            break;
         }
+        return false;
     }
 
     common::Value* RedisServerInfo::Clients::valueByIndex(unsigned char index) const
@@ -351,40 +357,40 @@ namespace fastonosql
         : used_memory_(0), used_memory_human_(), used_memory_rss_(0), used_memory_peak_(0),
           used_memory_peak_human_(), used_memory_lua_(0),mem_fragmentation_ratio_(0), mem_allocator_()
     {
-        const std::string &src = memory_text;
-        size_t pos = 0;
-        size_t start = 0;
-        while((pos = src.find(("\r\n"), start)) != std::string::npos){
-            std::string line = src.substr(start, pos-start);
-            size_t delem = line.find_first_of(':');
-            std::string field = line.substr(0, delem);
-            std::string value = line.substr(delem + 1);
-            if(field == REDIS_USED_MEMORY_LABEL){
-                used_memory_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_USED_MEMORY_HUMAN_LABEL){
-                used_memory_human_ = value;
-            }
-            else if(field == REDIS_USED_MEMORY_RSS_LABEL){
-                used_memory_rss_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_USED_MEMORY_PEAK_LABEL){
-                used_memory_peak_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_USED_MEMORY_PEAK_HUMAN_LABEL){
-                used_memory_peak_human_ = value;
-            }
-            else if(field == REDIS_USED_MEMORY_LUA_LABEL){
-                used_memory_lua_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_MEM_FRAGMENTATION_RATIO_LABEL){
-                mem_fragmentation_ratio_ = common::convertFromString<float>(value);
-            }
-            else if(field == REDIS_MEM_ALLOCATOR_LABEL){
-                mem_allocator_ = value;
-            }
-            start = pos + 2;
+        parseInfoSection(memory_text, this);
+    }
+
+    bool RedisServerInfo::Memory::parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value)
+    {
+        switch(hash){
+        INFO_FIELD_CASE(field, REDIS_USED_MEMORY_LABEL)
+            used_memory_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_USED_MEMORY_HUMAN_LABEL)
+            value.assignTo(&used_memory_human_);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_USED_MEMORY_RSS_LABEL)
+            used_memory_rss_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_USED_MEMORY_PEAK_LABEL)
+            used_memory_peak_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_USED_MEMORY_PEAK_HUMAN_LABEL)
+            value.assignTo(&used_memory_peak_human_);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_USED_MEMORY_LUA_LABEL)
+            used_memory_lua_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_MEM_FRAGMENTATION_RATIO_LABEL)
+            mem_fragmentation_ratio_ = infoToFloat(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_MEM_ALLOCATOR_LABEL)
+            value.assignTo(&mem_allocator_);
+            return true;
+        default:
+            break;
         }
+        return false;
     }
 
     common::Value* RedisServerInfo::Memory::valueByIndex(unsigned char index) const
@@ -430,58 +436,58 @@ namespace fastonosql
           aof_enabled_(0), aof_rewrite_in_progress_(0), aof_rewrite_scheduled_(0),
           aof_last_rewrite_time_sec_(0), aof_current_rewrite_time_sec_(0), aof_last_bgrewrite_status_(), aof_last_write_status_()
     {
-        const std::string &src = persistence_text;
-        size_t pos = 0;
-        size_t start = 0;
-        while((pos = src.find(("\r\n"), start)) != std::string::npos){
-            std::string line = src.substr(start, pos-start);
-            size_t delem = line.find_first_of(':');
-            std::string field = line.substr(0, delem);
-            std::string value = line.substr(delem + 1);
-            if(field == REDIS_LOADING_LABEL){
-                loading_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_RDB_CHANGES_SINCE_LAST_SAVE_LABEL){
-                rdb_changes_since_last_save_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_RDB_DGSAVE_IN_PROGRESS_LABEL){
-                rdb_bgsave_in_progress_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_RDB_LAST_SAVE_TIME_LABEL){
-                rdb_last_save_time_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_RDB_LAST_DGSAVE_STATUS_LABEL){
-                rdb_last_bgsave_status_ = value;
-            }
-            else if(field == REDIS_RDB_LAST_DGSAVE_TIME_SEC_LABEL){
-                rdb_last_bgsave_time_sec_ = common::convertFromString<int>(value);
-            }
-            else if(field == REDIS_RDB_CURRENT_DGSAVE_TIME_SEC_LABEL){
-                rdb_current_bgsave_time_sec_ = common::convertFromString<int>(value);
-            }
-            else if(field == REDIS_AOF_ENABLED_LABEL){
-                aof_enabled_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_AOF_REWRITE_IN_PROGRESS_LABEL){
-                aof_rewrite_in_progress_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_AOF_REWRITE_SHEDULED_LABEL){
-                aof_rewrite_scheduled_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_AOF_LAST_REWRITE_TIME_SEC_LABEL){
-                aof_last_rewrite_time_sec_ = common::convertFromString<int>(value);
-            }
-            else if(field == REDIS_AOF_CURRENT_REWRITE_TIME_SEC_LABEL){
-                aof_current_rewrite_time_sec_ = common::convertFromString<int>(value);
-            }
-            else if(field == REDIS_AOF_LAST_DGREWRITE_STATUS_LABEL){
-                aof_last_bgrewrite_status_ = value;
-            }
-            else if(field == REDIS_AOF_LAST_WRITE_STATUS_LABEL){
-                aof_last_write_status_ = value;
-            }
-            start = pos + 2;
+        parseInfoSection(persistence_text, this);
+    }
+
+    bool RedisServerInfo::Persistence::parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value)
+    {
+        switch(hash){
+        INFO_FIELD_CASE(field, REDIS_LOADING_LABEL)
+            loading_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_RDB_CHANGES_SINCE_LAST_SAVE_LABEL)
+            rdb_changes_since_last_save_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_RDB_DGSAVE_IN_PROGRESS_LABEL)
+            rdb_bgsave_in_progress_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_RDB_LAST_SAVE_TIME_LABEL)
+            rdb_last_save_time_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_RDB_LAST_DGSAVE_STATUS_LABEL)
+            value.assignTo(&rdb_last_bgsave_status_);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_RDB_LAST_DGSAVE_TIME_SEC_LABEL)
+            rdb_last_bgsave_time_sec_ = infoToInt(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_RDB_CURRENT_DGSAVE_TIME_SEC_LABEL)
+            rdb_current_bgsave_time_sec_ = infoToInt(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_AOF_ENABLED_LABEL)
+            aof_enabled_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_AOF_REWRITE_IN_PROGRESS_LABEL)
+            aof_rewrite_in_progress_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_AOF_REWRITE_SHEDULED_LABEL)
+            aof_rewrite_scheduled_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_AOF_LAST_REWRITE_TIME_SEC_LABEL)
+            aof_last_rewrite_time_sec_ = infoToInt(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_AOF_CURRENT_REWRITE_TIME_SEC_LABEL)
+            aof_current_rewrite_time_sec_ = infoToInt(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_AOF_LAST_DGREWRITE_STATUS_LABEL)
+            value.assignTo(&aof_last_bgrewrite_status_);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_AOF_LAST_WRITE_STATUS_LABEL)
+            value.assignTo(&aof_last_write_status_);
+            return true;
+        default:
+            break;
         }
+        return false;
     }
 
     common::Value* RedisServerInfo::Persistence::valueByIndex(unsigned char index) const
@@ -541,58 +547,58 @@ namespace fastonosql
           keyspace_misses_(0), pubsub_channels_(0),
           pubsub_patterns_(0), latest_fork_usec_(0)
     {
-        const std::string &src = stats_text;
-        size_t pos = 0;
-        size_t start = 0;
-        while((pos = src.find(("\r\n"), start)) != std::string::npos){
-            std::string line = src.substr(start, pos-start);
-            size_t delem = line.find_first_of(':');
-            std::string field = line.substr(0, delem);
-            std::string value = line.substr(delem + 1);
-            if(field == REDIS_TOTAL_CONNECTIONS_RECEIVED_LABEL){
-                total_connections_received_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_TOTAL_COMMANDS_PROCESSED_LABEL){
-                total_commands_processed_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_INSTANTANEOUS_OPS_PER_SEC_LABEL){
-                instantaneous_ops_per_sec_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_REJECTED_CONNECTIONS_LABEL){
-                rejected_connections_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_SYNC_FULL_LABEL){
-                sync_full_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_SYNC_PARTIAL_OK_LABEL){
-                sync_partial_ok_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_SYNC_PARTIAL_ERR_LABEL){
-                sync_partial_err_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_EXPIRED_KEYS_LABEL){
-                expired_keys_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_EVICTED_KEYS_LABEL){
-                evicted_keys_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_KEYSPACE_HITS_LABEL){
-                keyspace_hits_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_KEYSPACE_MISSES_LABEL){
-                keyspace_misses_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_PUBSUB_CHANNELS_LABEL){
-                pubsub_channels_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_PUBSUB_PATTERNS_LABEL){
-                pubsub_patterns_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_LATEST_FORK_USEC_LABEL){
-                latest_fork_usec_ = common::convertFromString<uint32_t>(value);
-            }
-            start = pos + 2;
+        parseInfoSection(stats_text, this);
+    }
+
+    bool RedisServerInfo::Stats::parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value)
+    {
+        switch(hash){
+        INFO_FIELD_CASE(field, REDIS_TOTAL_CONNECTIONS_RECEIVED_LABEL)
+            total_connections_received_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_TOTAL_COMMANDS_PROCESSED_LABEL)
+            total_commands_processed_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_INSTANTANEOUS_OPS_PER_SEC_LABEL)
+            instantaneous_ops_per_sec_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_REJECTED_CONNECTIONS_LABEL)
+            rejected_connections_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_SYNC_FULL_LABEL)
+            sync_full_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_SYNC_PARTIAL_OK_LABEL)
+            sync_partial_ok_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_SYNC_PARTIAL_ERR_LABEL)
+            sync_partial_err_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_EXPIRED_KEYS_LABEL)
+            expired_keys_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_EVICTED_KEYS_LABEL)
+            evicted_keys_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_KEYSPACE_HITS_LABEL)
+            keyspace_hits_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_KEYSPACE_MISSES_LABEL)
+            keyspace_misses_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_PUBSUB_CHANNELS_LABEL)
+            pubsub_channels_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_PUBSUB_PATTERNS_LABEL)
+            pubsub_patterns_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_LATEST_FORK_USEC_LABEL)
+            latest_fork_usec_ = infoToUInt32(value);
+            return true;
+        default:
+            break;
         }
+        return false;
     }
 
     common::Value* RedisServerInfo::Stats::valueByIndex(unsigned char index) const
@@ -637,7 +643,7 @@ namespace fastonosql
         : role_(), connected_slaves_(0),
           master_repl_offset_(0), backlog_active_(0),
           backlog_size_(0), backlog_first_byte_offset_(0),
-          backlog_histen_(0)
+          backlog_histen_(0), master_last_io_seconds_ago_(0)
     {
 
     }
@@ -646,40 +652,42 @@ namespace fastonosql
         : role_(), connected_slaves_(0),
           master_repl_offset_(0), backlog_active_(0),
           backlog_size_(0), backlog_first_byte_offset_(0),
-          backlog_histen_(0)
+          backlog_histen_(0), master_last_io_seconds_ago_(0)
     {
-        const std::string &src = replication_text;
-        size_t pos = 0;
-        size_t start = 0;
+        parseInfoSection(replication_text, this);
+    }
 
-        while((pos = src.find(("\r\n"), start)) != std::string::npos){
-            std::string line = src.substr(start, pos-start);
-            size_t delem = line.find_first_of(':');
-            std::string field = line.substr(0, delem);
-            std::string value = line.substr(delem + 1);
-            if(field == REDIS_ROLE_LABEL){
-                role_ = value;
-            }
-            else if(field == REDIS_CONNECTED_SLAVES_LABEL){
-                connected_slaves_ = common::convertFromString<uint32_t>(value);
-            }            
-            else if(field == REDIS_MASTER_REPL_OFFSET_LABEL){
-                master_repl_offset_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_BACKLOG_ACTIVE_LABEL){
-                backlog_active_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_BACKLOG_SIZE_LABEL){
-                backlog_size_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_BACKLOG_FIRST_BYTE_OFFSET_LABEL){
-                backlog_first_byte_offset_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == REDIS_BACKLOG_HISTEN_LABEL){
-                backlog_histen_ = common::convertFromString<uint32_t>(value);
-            }
-            start = pos + 2;
+    bool RedisServerInfo::Replication::parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value)
+    {
+        switch(hash){
+        INFO_FIELD_CASE(field, REDIS_ROLE_LABEL)
+            value.assignTo(&role_);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_CONNECTED_SLAVES_LABEL)
+            connected_slaves_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_MASTER_REPL_OFFSET_LABEL)
+            master_repl_offset_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_BACKLOG_ACTIVE_LABEL)
+            backlog_active_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_BACKLOG_SIZE_LABEL)
+            backlog_size_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_BACKLOG_FIRST_BYTE_OFFSET_LABEL)
+            backlog_first_byte_offset_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_BACKLOG_HISTEN_LABEL)
+            backlog_histen_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_MASTER_LAST_IO_SECONDS_AGO_LABEL)
+            master_last_io_seconds_ago_ = infoToInt(value);
+            return true;
+        default:
+            break;
         }
+        return false;
     }
 
     common::Value* RedisServerInfo::Replication::valueByIndex(unsigned char index) const
@@ -699,6 +707,8 @@ namespace fastonosql
             return new common::FundamentalValue(backlog_first_byte_offset_);
         case 6:
             return new common::FundamentalValue(backlog_histen_);
+        case 7:
+            return new common::FundamentalValue(master_last_io_seconds_ago_);
         default:
             NOTREACHED();
             break;
@@ -715,28 +725,28 @@ namespace fastonosql
     RedisServerInfo::Cpu::Cpu(const std::string &cpu_text)
         : used_cpu_sys_(0), used_cpu_user_(0), used_cpu_sys_children_(0), used_cpu_user_children_(0)
     {
-        const std::string &src = cpu_text;
-        size_t pos = 0;
-        size_t start = 0;
-        while((pos = src.find(("\r\n"), start)) != std::string::npos){
-            std::string line = src.substr(start, pos-start);
-            size_t delem = line.find_first_of(':');
-            std::string field = line.substr(0, delem);
-            std::string value = line.substr(delem + 1);
-            if(field == (REDIS_USED_CPU_SYS_LABEL)){
-                used_cpu_sys_ = common::convertFromString<float>(value);
-            }
-            else if(field == REDIS_USED_CPU_USER_LABEL){
-                used_cpu_user_ = common::convertFromString<float>(value);
-            }
-            else if(field == REDIS_USED_CPU_SYS_CHILDREN_LABEL){
-                used_cpu_sys_children_ = common::convertFromString<float>(value);
-            }
-            else if(field == REDIS_USED_CPU_USER_CHILDREN_LABEL){
-                used_cpu_user_children_ = common::convertFromString<float>(value);
-            }
-            start = pos + 2;
+        parseInfoSection(cpu_text, this);
+    }
+
+    bool RedisServerInfo::Cpu::parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value)
+    {
+        switch(hash){
+        INFO_FIELD_CASE(field, REDIS_USED_CPU_SYS_LABEL)
+            used_cpu_sys_ = infoToFloat(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_USED_CPU_USER_LABEL)
+            used_cpu_user_ = infoToFloat(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_USED_CPU_SYS_CHILDREN_LABEL)
+            used_cpu_sys_children_ = infoToFloat(value);
+            return true;
+        INFO_FIELD_CASE(field, REDIS_USED_CPU_USER_CHILDREN_LABEL)
+            used_cpu_user_children_ = infoToFloat(value);
+            return true;
+        default:
+            break;
         }
+        return false;
     }
 
     common::Value* RedisServerInfo::Cpu::valueByIndex(unsigned char index) const
@@ -884,7 +894,8 @@ namespace fastonosql
                     << REDIS_BACKLOG_ACTIVE_LABEL":" << value.backlog_active_ << ("\r\n")
                     << REDIS_BACKLOG_SIZE_LABEL":" << value.backlog_size_ << ("\r\n")
                     << REDIS_BACKLOG_FIRST_BYTE_OFFSET_LABEL":" << value.backlog_first_byte_offset_ << ("\r\n")
-                    << REDIS_BACKLOG_HISTEN_LABEL":" << value.backlog_histen_ << ("\r\n");
+                    << REDIS_BACKLOG_HISTEN_LABEL":" << value.backlog_histen_ << ("\r\n")
+                    << REDIS_MASTER_LAST_IO_SECONDS_AGO_LABEL":" << value.master_last_io_seconds_ago_ << ("\r\n");
     }
 
     std::ostream& operator<<(std::ostream& out, const RedisServerInfo::Cpu& value)
@@ -915,6 +926,33 @@ namespace fastonosql
         return out << value.toString();
     }
 
+    namespace
+    {
+        // index of a section by its header line, -1 for sections not parsed
+        int redisInfoSection(const InfoSlice& header)
+        {
+            switch(infoFieldHash(header)){
+            INFO_FIELD_CASE(header, REDIS_SERVER_LABEL)
+                return 0;
+            INFO_FIELD_CASE(header, REDIS_CLIENTS_LABEL)
+                return 1;
+            INFO_FIELD_CASE(header, REDIS_MEMORY_LABEL)
+                return 2;
+            INFO_FIELD_CASE(header, REDIS_PERSISTENCE_LABEL)
+                return 3;
+            INFO_FIELD_CASE(header, REDIS_STATS_LABEL)
+                return 4;
+            INFO_FIELD_CASE(header, REDIS_REPLICATION_LABEL)
+                return 5;
+            INFO_FIELD_CASE(header, REDIS_CPU_LABEL)
+                return 6;
+            default:
+                break;
+            }
+            return -1;
+        }
+    }
+
     RedisServerInfo* makeRedisServerInfo(const std::string &content)
     {
         if(content.empty()){
@@ -922,56 +960,47 @@ namespace fastonosql
         }
 
         RedisServerInfo* result = new RedisServerInfo;
-        int j = 0;
-        std::string word;
-        size_t pos = 0;
-        const std::vector<std::string> headers = DBTraits<REDIS>::infoHeaders();
 
-        for(int i = 0; i < content.size(); ++i)
-        {
-            char ch = content[i];
-            word += ch;
-            if(word == headers[j]){
-                if(j+1 != headers.size()){
-                    pos = content.find(headers[j+1], pos);
-                }
-                else{
-                    break;
-                }
+        // one pass over the reply, every line goes to the section of the last header
+        InfoLineReader reader(content.data(), content.size());
+        InfoSlice line, field, value;
+        int section = -1;
+        while(reader.next(&line)){
+            if(isInfoHeader(line)){
+                section = redisInfoSection(line);
+                continue;
+            }
 
-                if(pos != std::string::npos)
-                {
-                    std::string part = content.substr(i + 1, pos - i - 1 );
-                    switch(j)
-                    {
-                    case 0:
-                        result->server_ = RedisServerInfo::Server(part);
-                        break;
-                    case 1:
-                        result->clients_ = RedisServerInfo::Clients(part);
-                        break;
-                    case 2:
-                        result->memory_ = RedisServerInfo::Memory(part);
-                        break;
-                    case 3:
-                        result->persistence_ = RedisServerInfo::Persistence(part);
-                        break;
-                    case 4:
-                        result->stats_ = RedisServerInfo::Stats(part);
-                        break;
-                    case 5:
-                        result->replication_ = RedisServerInfo::Replication(part);
-                        break;
-                    case 6:
-                        result->cpu_ = RedisServerInfo::Cpu(part);
-                        break;
-                    default:
-                        break;
-                    }
-                    i = pos-1;
-                    ++j;
-                }
-                word.clear();
+            if(section == -1 || !splitInfoLine(line, &field, &value)){
+                continue;
+            }
+
+            const uint32_t hash = infoFieldHash(field);
+            switch(section)
+            {
+            case 0:
+                result->server_.parseField(hash, field, value);
+                break;
+            case 1:
+                result->clients_.parseField(hash, field, value);
+                break;
+            case 2:
+                result->memory_.parseField(hash, field, value);
+                break;
+            case 3:
+                result->persistence_.parseField(hash, field, value);
+                break;
+            case 4:
+                result->stats_.parseField(hash, field, value);
+                break;
+            case 5:
+                result->replication_.parseField(hash, field, value);
+                break;
+            case 6:
+                result->cpu_.parseField(hash, field, value);
+                break;
+            default:
+                break;
             }
         }
 
@@ -1113,6 +1142,51 @@ namespace fastonosql
         return common::Error();
     }
 
+    RedisCommandStat::RedisCommandStat()
+        : calls_(0), usec_(0)
+    {
+
+    }
+
+    redis_command_stats_t makeRedisCommandStats(const std::string& text)
+    {
+        redis_command_stats_t stats;
+        const size_t prefixSize = sizeof(REDIS_COMMANDSTATS_PREFIX) - 1;
+
+        InfoLineReader reader(text.data(), text.size());
+        InfoSlice line, field, value;
+        while(reader.next(&line)){
+            if(!splitInfoLine(line, &field, &value) || field.size_ <= prefixSize ||
+               memcmp(field.data_, REDIS_COMMANDSTATS_PREFIX, prefixSize) != 0){
+                continue;
+            }
+
+            RedisCommandStat stat;
+            const char* pos = value.data_;
+            const char* end = value.data_ + value.size_;
+            while(pos < end){
+                const char* comma = static_cast<const char*>(memchr(pos, ',', end - pos));
+                const char* stop = comma ? comma : end;
+                const char* eq = static_cast<const char*>(memchr(pos, '=', stop - pos));
+                if(eq){
+                    InfoSlice key(pos, eq - pos);
+                    InfoSlice number(eq + 1, stop - eq - 1);
+                    if(key.equals("calls", 5)){
+                        stat.calls_ = infoToUInt64(number);
+                    }
+                    else if(key.equals("usec", 4)){
+                        stat.usec_ = infoToUInt64(number);
+                    }
+                }
+                pos = stop + 1;
+            }
+
+            stats[std::string(field.data_ + prefixSize, field.size_ - prefixSize)] = stat;
+        }
+
+        return stats;
+    }
+
     RedisDataBaseInfo::RedisDataBaseInfo(const std::string& name, bool isDefault, size_t size, const keys_cont_type& keys)
         : DataBaseInfo(name, isDefault, REDIS, size, keys)
     {
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <map>
 #include <vector>
 
 #include "common/types.h"
 #include "global/global.h"
 #include "core/types.h"
+#include "core/info_parser.h"
 
 #define REDIS_SERVER_LABEL "# Server"
 #define REDIS_CLIENTS_LABEL "# Clients"
@@ -14,6 +16,7 @@
 #define REDIS_REPLICATION_LABEL "# Replication"
 #define REDIS_CPU_LABEL "# CPU"
 #define REDIS_KEYSPACE_LABEL "# Keyspace"
+#define REDIS_COMMANDSTATS_PREFIX "cmdstat_"
 
 //Server
 #define REDIS_VERSION_LABEL "redis_version"
@@ -89,6 +92,7 @@
 #define REDIS_BACKLOG_SIZE_LABEL "repl_backlog_size"
 #define REDIS_BACKLOG_FIRST_BYTE_OFFSET_LABEL "repl_backlog_first_byte_offset"
 #define REDIS_BACKLOG_HISTEN_LABEL "repl_backlog_histlen"
+#define REDIS_MASTER_LAST_IO_SECONDS_AGO_LABEL "master_last_io_seconds_ago"
 
 //CPU
 #define REDIS_USED_CPU_SYS_LABEL "used_cpu_sys"
@@ -120,6 +124,7 @@ namespace fastonosql
             Server();
             explicit Server(const std::string& server_text);
             common::Value* valueByIndex(unsigned char index) const;
+            bool parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value);
 
             std::string redis_version_;
             std::string redis_git_sha1_;
@@ -145,6 +150,7 @@ namespace fastonosql
             Clients();
             explicit Clients(const std::string& client_text);
             common::Value* valueByIndex(unsigned char index) const;
+            bool parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value);
 
             uint32_t connected_clients_;
             uint32_t client_longest_output_list_;
@@ -158,6 +164,7 @@ namespace fastonosql
             Memory();
             explicit Memory(const std::string& memory_text);
             common::Value* valueByIndex(unsigned char index) const;
+            bool parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value);
 
             uint32_t used_memory_;
             std::string used_memory_human_;
@@ -175,6 +182,7 @@ namespace fastonosql
             Persistence();
             explicit Persistence(const std::string& persistence_text);
             common::Value* valueByIndex(unsigned char index) const;
+            bool parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value);
 
             uint32_t loading_;
             uint32_t rdb_changes_since_last_save_;
@@ -198,6 +206,7 @@ namespace fastonosql
             Stats();
             explicit Stats(const std::string& stats_text);
             common::Value* valueByIndex(unsigned char index) const;
+            bool parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value);
 
             uint32_t total_connections_received_;
             uint32_t total_commands_processed_;
@@ -221,6 +230,7 @@ namespace fastonosql
             Replication();
             explicit Replication(const std::string& replication_text);
             common::Value* valueByIndex(unsigned char index) const;
+            bool parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value);
 
             std::string role_;
             uint32_t connected_slaves_;
@@ -229,6 +239,7 @@ namespace fastonosql
             uint32_t backlog_size_; //
             uint32_t backlog_first_byte_offset_; //
             uint32_t backlog_histen_; //
+            int master_last_io_seconds_ago_; // slaves only, -1 while the link is down
         } replication_;
 
         struct Cpu
@@ -237,6 +248,7 @@ namespace fastonosql
             Cpu();
             explicit Cpu(const std::string& cpu_text);
             common::Value* valueByIndex(unsigned char index) const;
+            bool parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value);
 
             float used_cpu_sys_;
             float used_cpu_user_;
@@ -268,6 +280,18 @@ namespace fastonosql
     ServerDiscoveryInfo* makeOwnRedisDiscoveryInfo(FastoObject* root);
     common::Error makeAllDiscoveryInfo(const common::net::hostAndPort& parentHost, const std::string& text, std::vector<ServerDiscoveryInfoSPtr>& infos);
 
+    // one "cmdstat_<name>:calls=<n>,usec=<n>,usec_per_call=<x>" line of INFO commandstats
+    struct RedisCommandStat
+    {
+        RedisCommandStat();
+
+        uint64_t calls_;
+        uint64_t usec_;
+    };
+
+    typedef std::map<std::string, RedisCommandStat> redis_command_stats_t;
+    redis_command_stats_t makeRedisCommandStats(const std::string& text);
+
     class RedisDataBaseInfo
             : public DataBaseInfo
     {
@@ -0,0 +1,146 @@
+#include "core/redis/redis_latency.h"
+
+#include <algorithm>
+
+#include <hiredis/hiredis.h>
+
+#include "core/monitor_analyzer.h"
+
+namespace fastonosql
+{
+    RedisLatencyEvent::RedisLatencyEvent()
+        : name_(), latest_(0), max_(0)
+    {
+
+    }
+
+    std::vector<RedisLatencyEvent> parseLatencyLatest(const redisReply* reply)
+    {
+        std::vector<RedisLatencyEvent> events;
+        if(!reply || reply->type != REDIS_REPLY_ARRAY){
+            return events;
+        }
+
+        for(size_t i = 0; i < reply->elements; ++i){
+            const redisReply* ev = reply->element[i];
+            if(ev->type != REDIS_REPLY_ARRAY || ev->elements < 4 || ev->element[0]->type != REDIS_REPLY_STRING ||
+               ev->element[2]->type != REDIS_REPLY_INTEGER || ev->element[3]->type != REDIS_REPLY_INTEGER){
+                continue;
+            }
+
+            RedisLatencyEvent event;
+            event.name_.assign(ev->element[0]->str, ev->element[0]->len);
+            event.latest_ = ev->element[2]->integer;
+            event.max_ = ev->element[3]->integer;
+            events.push_back(event);
+        }
+
+        return events;
+    }
+
+    RedisSlowLogSummary::RedisSlowLogSummary()
+        : entries_(0), slowest_(0), command_()
+    {
+
+    }
+
+    bool parseSlowLogSummary(const redisReply* reply, RedisSlowLogSummary* summary)
+    {
+        if(!reply || !summary || reply->type != REDIS_REPLY_ARRAY){
+            return false;
+        }
+
+        *summary = RedisSlowLogSummary();
+        summary->entries_ = reply->elements;
+        for(size_t i = 0; i < reply->elements; ++i){
+            const redisReply* entry = reply->element[i];
+            if(!isSlowLogItem(entry) || entry->element[2]->integer <= summary->slowest_){
+                continue;
+            }
+
+            summary->slowest_ = entry->element[2]->integer;
+            const redisReply* args = entry->element[3];
+            summary->command_ = args->elements && args->element[0]->type == REDIS_REPLY_STRING ?
+                        std::string(args->element[0]->str, args->element[0]->len) : std::string();
+        }
+
+        return true;
+    }
+
+    bool isSlowLogItem(const redisReply* item)
+    {
+        return item->type == REDIS_REPLY_ARRAY && item->elements >= 4 &&
+                item->element[0]->type == REDIS_REPLY_INTEGER && item->element[1]->type == REDIS_REPLY_INTEGER &&
+                item->element[2]->type == REDIS_REPLY_INTEGER && item->element[3]->type == REDIS_REPLY_ARRAY;
+    }
+
+    bool isSlowLogShrunk(long long len, long long prevLen)
+    {
+        return prevLen >= 0 && len < prevLen;
+    }
+
+    void parseSlowLogEntries(const redisReply* reply, int64_t afterId, std::vector<SlowLogEntry>* entries)
+    {
+        if(!reply || reply->type != REDIS_REPLY_ARRAY){
+            return;
+        }
+
+        // SLOWLOG GET is newest first
+        if(reply->elements && isSlowLogItem(reply->element[0]) && reply->element[0]->element[0]->integer < afterId){
+            afterId = -1;
+        }
+
+        for(size_t i = reply->elements; i > 0; --i){
+            const redisReply* item = reply->element[i - 1];
+            if(!isSlowLogItem(item) || item->element[0]->integer <= afterId){
+                continue;
+            }
+
+            SlowLogEntry entry;
+            entry.id_ = item->element[0]->integer;
+            entry.time_ = item->element[1]->integer;
+            entry.usec_ = item->element[2]->integer;
+            const redisReply* args = item->element[3];
+            for(size_t j = 0; j < args->elements; ++j){
+                if(args->element[j]->type != REDIS_REPLY_STRING){
+                    continue;
+                }
+
+                const std::string arg(args->element[j]->str, args->element[j]->len);
+                if(j == 0){
+                    entry.command_ = arg;
+                    std::transform(entry.command_.begin(), entry.command_.end(), entry.command_.begin(), ::tolower);
+                }
+                else if(j == 1 && !isKeylessCommand(entry.command_)){
+                    entry.key_ = arg;
+                }
+                entry.args_ += j ? " " + arg : arg;
+            }
+
+            // redis 4 added the client address
+            if(item->elements > 4 && item->element[4]->type == REDIS_REPLY_STRING){
+                entry.client_.assign(item->element[4]->str, item->element[4]->len);
+            }
+            entries->push_back(entry);
+        }
+    }
+
+    double serverUsecPerCall(const redis_command_stats_t& before, const redis_command_stats_t& after, const std::string& command)
+    {
+        uint64_t calls = 0, usec = 0;
+        for(redis_command_stats_t::const_iterator it = after.begin(); it != after.end(); ++it){
+            if(!command.empty() && it->first != command){
+                continue;
+            }
+
+            redis_command_stats_t::const_iterator prev = before.find(it->first);
+            const RedisCommandStat old = prev != before.end() ? prev->second : RedisCommandStat();
+            if(it->second.calls_ >= old.calls_ && it->second.usec_ >= old.usec_){
+                calls += it->second.calls_ - old.calls_;
+                usec += it->second.usec_ - old.usec_;
+            }
+        }
+
+        return calls ? static_cast<double>(usec) / calls : -1;
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/redis/redis_infos.h"
+#include "core/slowlog_analyzer.h"
+
+struct redisReply;
+
+namespace fastonosql
+{
+    // one event of LATENCY LATEST, times in msec
+    struct RedisLatencyEvent
+    {
+        RedisLatencyEvent();
+
+        std::string name_;
+        long long latest_;
+        long long max_;
+    };
+
+    // events of a LATENCY LATEST array, malformed ones are skipped
+    std::vector<RedisLatencyEvent> parseLatencyLatest(const redisReply* reply);
+
+    struct RedisSlowLogSummary
+    {
+        RedisSlowLogSummary();
+
+        size_t entries_;
+        long long slowest_; // usec, 0 for an empty log
+        std::string command_; // of the slowest entry
+    };
+
+    // the slowest entry of a SLOWLOG GET array, false for other replies
+    bool parseSlowLogSummary(const redisReply* reply, RedisSlowLogSummary* summary);
+
+    // id, time, duration and arguments, since redis 4 the client address follows
+    bool isSlowLogItem(const redisReply* item);
+    // a log which got shorter since the previous SLOWLOG LEN was reset (SLOWLOG RESET
+    // or a restart, which also starts the ids over); prevLen is -1 when unknown
+    bool isSlowLogShrunk(long long len, long long prevLen);
+    // entries newer than afterId of a SLOWLOG GET array, oldest first; a log whose
+    // newest id is below afterId was reset, all of its entries are returned then
+    void parseSlowLogEntries(const redisReply* reply, int64_t afterId, std::vector<SlowLogEntry>* entries);
+
+    // server time spent per call between two INFO commandstats, of one command
+    // or of all of them when command is empty; -1 if there were no calls
+    double serverUsecPerCall(const redis_command_stats_t& before, const redis_command_stats_t& after, const std::string& command);
+}
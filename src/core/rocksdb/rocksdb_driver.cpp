@@ -1,12 +1,14 @@
 #include "core/rocksdb/rocksdb_driver.h"
 
 #include <rocksdb/db.h>
+#include <rocksdb/write_batch.h>
 
 #include "common/sprintf.h"
 #include "common/utils.h"
 #include "fasto/qt/logger.h"
 
 #include "core/command_logger.h"
+#include "core/benchmark.h"
 
 #include "core/rocksdb/rocksdb_config.h"
 #include "core/rocksdb/rocksdb_infos.h"
@@ -15,7 +17,8 @@
 #define GET_KEY_PATTERN_1ARGS_S "GET %s"
 #define SET_KEY_PATTERN_2ARGS_SS "PUT %s %s"
 
-#define GET_KEYS_PATTERN_1ARGS_I "KEYS a z %d"
+#define SEARCH_KEYS_PATTERN_3ARGS_SSI "KEYS \"%s\" \"%s\" %d"
+#define KEYS_SEARCH_BATCH 4096
 #define DELETE_KEY_PATTERN_1ARGS_S "DEL %s"
 #define GET_SERVER_TYPE ""
 #define ROCKSDB_HEADER_STATS    "\n** Compaction Stats [default] **\n"\
@@ -56,6 +59,61 @@ namespace fastonosql
             rocksdbConfig config = settings->info();
             return createConnection(config, context);
         }
+
+        // rocksdb::DB is safe for concurrent use, the clients share the opened one
+        class RocksdbBenchmarkClient
+                : public BenchmarkClient
+        {
+        public:
+            explicit RocksdbBenchmarkClient(rocksdb::DB* context)
+                : context_(context)
+            {
+
+            }
+
+            virtual common::Error execute(const std::vector<BenchmarkRequest>& batch, const std::string& value)
+            {
+                for(size_t i = 0; i < batch.size(); ++i){
+                    const BenchmarkRequest& req = batch[i];
+                    rocksdb::Status st;
+                    if(req.write_){
+                        st = context_->Put(rocksdb::WriteOptions(), req.key_, rocksdb::Slice(value.data(), req.valueSize_));
+                    }
+                    else{
+                        std::string ret;
+                        st = context_->Get(rocksdb::ReadOptions(), req.key_, &ret);
+                    }
+
+                    if (!st.ok() && !st.IsNotFound()){
+                        char buff[1024] = {0};
+                        common::SNPrintf(buff, sizeof(buff), "Benchmark error: %s", st.ToString());
+                        return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                    }
+                }
+
+                return common::Error();
+            }
+
+            virtual common::Error remove(const std::vector<std::string>& keys)
+            {
+                rocksdb::WriteBatch batch;
+                for(size_t i = 0; i < keys.size(); ++i){
+                    batch.Delete(keys[i]);
+                }
+
+                rocksdb::Status st = context_->Write(rocksdb::WriteOptions(), &batch);
+                if (!st.ok()){
+                    char buff[1024] = {0};
+                    common::SNPrintf(buff, sizeof(buff), "Benchmark error: %s", st.ToString());
+                    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                }
+
+                return common::Error();
+            }
+
+        private:
+            rocksdb::DB* const context_;
+        };
     }
 
     common::Error testConnection(RocksdbConnectionSettings* settings)
@@ -212,7 +270,7 @@ namespace fastonosql
                 common::Error er = info(argc == 2 ? argv[1] : 0, statsout);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue(RocksdbServerInfo(statsout).toString());
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -226,7 +284,7 @@ namespace fastonosql
                 common::Error er = get(argv[1], &ret);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue(ret);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -240,7 +298,7 @@ namespace fastonosql
                 common::Error er = dbsize(ret);
                 if(!er){
                     common::FundamentalValue *val = common::Value::createUIntegerValue(ret);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -263,7 +321,7 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(keysout[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -276,7 +334,7 @@ namespace fastonosql
                 common::Error er = merge(argv[1], argv[2]);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -289,7 +347,7 @@ namespace fastonosql
                 common::Error er = put(argv[1], argv[2]);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -302,7 +360,7 @@ namespace fastonosql
                 common::Error er = del(argv[1]);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("DELETED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -320,7 +378,7 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(keysout[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -332,6 +390,86 @@ namespace fastonosql
             }
         }
 
+        // walks only the keys starting with the filter prefix, matching them in batches
+        common::Error search(const KeysFilter& filter, uint64_t limit, std::vector<std::string>* ret)
+        {
+            ret->clear();
+            const std::string prefix = filter.prefix();
+
+            rocksdb::ReadOptions ro;
+            ro.fill_cache = false;
+            rocksdb::Iterator* it = rocksdb_->NewIterator(ro);
+            std::vector<std::string> batch;
+            for (it->Seek(prefix); it->Valid() && ret->size() < limit; it->Next()) {
+                rocksdb::Slice key = it->key();
+                if(!key.starts_with(prefix)){
+                    break;
+                }
+
+                batch.push_back(key.ToString());
+                if(batch.size() == KEYS_SEARCH_BATCH){
+                    filter.collect(&batch, limit, ret);
+                }
+            }
+            filter.collect(&batch, limit, ret);
+
+            rocksdb::Status st = it->status();
+            delete it;
+
+            if (!st.ok()){
+                char buff[1024] = {0};
+                common::SNPrintf(buff, sizeof(buff), "Keys function error: %s", st.ToString());
+                return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+            }
+            return common::Error();
+        }
+
+        // keys after cursor with their values, the iterator hands out both at once
+        common::Error scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                 std::vector<std::string>* keys, std::vector<std::string>* values, std::string* next)
+        {
+            const std::string prefix = filter.prefix();
+
+            rocksdb::ReadOptions ro;
+            ro.fill_cache = false;
+            rocksdb::Iterator* it = rocksdb_->NewIterator(ro);
+            it->Seek(cursor.empty() ? prefix : cursor);
+            if(!cursor.empty() && it->Valid() && it->key() == cursor){
+                it->Next();
+            }
+
+            for (; it->Valid() && keys->size() < count; it->Next()) {
+                rocksdb::Slice key = it->key();
+                if(!key.starts_with(prefix)){
+                    break;
+                }
+
+                keys->push_back(key.ToString());
+                values->push_back(it->value().ToString());
+            }
+            *next = keys->size() == count ? keys->back() : std::string();
+
+            rocksdb::Status st = it->status();
+            delete it;
+
+            if (!st.ok()){
+                char buff[1024] = {0};
+                common::SNPrintf(buff, sizeof(buff), "Scan values function error: %s", st.ToString());
+                return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+            }
+            return common::Error();
+        }
+
+        common::Error createBenchmarkClient(BenchmarkClient** client)
+        {
+            if(!isConnected()){
+                return common::make_error_value("Not connected", common::ErrorValue::E_ERROR);
+            }
+
+            *client = new RocksdbBenchmarkClient(rocksdb_);
+            return common::Error();
+        }
+
     private:
         common::Error get(const std::string& key, std::string* ret_val)
         {
@@ -560,7 +698,7 @@ namespace fastonosql
         er = execute(cmd);
 
         if(!er){
-            FastoObject::child_container_type ch = root->childrens();
+            const FastoObject::child_container_type& ch = root->childrens();
             if(ch.size()){
                 //*dinfo = makeOwnRedisDiscoveryInfo(ch[0]);
             }
@@ -587,6 +725,17 @@ namespace fastonosql
         return common::Error();
     }
 
+    common::Error RocksdbDriver::scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                            std::vector<std::string>* keys, std::vector<std::string>* values, std::string* next)
+    {
+        return impl_->scanValues(filter, cursor, count, keys, values, next);
+    }
+
+    common::Error RocksdbDriver::createBenchmarkClient(BenchmarkClient** client)
+    {
+        return impl_->createBenchmarkClient(client);
+    }
+
     void RocksdbDriver::handleConnectEvent(events::ConnectRequestEvent *ev)
     {
         QObject *sender = ev->sender();
@@ -637,7 +786,7 @@ namespace fastonosql
                 FastoObjectIPtr outRoot = lock.root_;
                 double step = 100.0f/length;
                 for(size_t n = 0; n < length; ++n){
-                    if(interrupt_){
+                    if(interrupt_.loadAcquire()){
                         er.reset(new common::ErrorValue("Interrupted exec.", common::ErrorValue::E_INTERRUPTED));
                         res.setErrorInfo(er);
                         break;
@@ -713,41 +862,30 @@ namespace fastonosql
         QObject *sender = ev->sender();
         notifyProgress(sender, 0);
             events::LoadDatabaseContentResponceEvent::value_type res(ev->value());
+            const KeysFilter filter = res.filter();
             char patternResult[1024] = {0};
-            common::SNPrintf(patternResult, sizeof(patternResult), GET_KEYS_PATTERN_1ARGS_I, res.countKeys_);
-            FastoObjectIPtr root = FastoObject::createRoot(patternResult);
+            common::SNPrintf(patternResult, sizeof(patternResult), SEARCH_KEYS_PATTERN_3ARGS_SSI, filter.prefix(), filter.prefixEnd(), res.countKeys_);
         notifyProgress(sender, 50);
-            FastoObjectCommand* cmd = createCommand<RocksdbCommand>(root, patternResult, common::Value::C_INNER);
-            common::Error er = execute(cmd);
+            LOG_COMMAND(Command(patternResult, common::Value::C_INNER));
+            std::vector<std::string> keys;
+            common::Error er;
+            if(!filter.isValid()){
+                er = common::make_error_value(filter.errorString(), common::ErrorValue::E_ERROR);
+            }
+            else if(filter.matchType(common::Value::TYPE_STRING)){
+                er = impl_->search(filter, res.countKeys_, &keys);
+            }
+
             if(er){
                 res.setErrorInfo(er);
             }
             else{
-                FastoObject::child_container_type rchildrens = cmd->childrens();
-                if(rchildrens.size()){
-                    DCHECK(rchildrens.size() == 1);
-                    FastoObjectArray* array = dynamic_cast<FastoObjectArray*>(rchildrens[0]);
-                    if(!array){
-                        goto done;
-                    }
-                    common::ArrayValue* ar = array->array();
-                    if(!ar){
-                        goto done;
-                    }
-
-                    for(int i = 0; i < ar->size(); ++i)
-                    {
-                        std::string key;
-                        bool isok = ar->getString(i, &key);
-                        if(isok){
-                            NKey k(key);
-                            NDbKValue ress(k, NValue());
-                            res.keys_.push_back(ress);
-                        }
-                    }
+                for(size_t i = 0; i < keys.size(); ++i){
+                    NKey k(keys[i]);
+                    NDbKValue ress(k, NValue());
+                    res.keys_.push_back(ress);
                 }
             }
-    done:
         notifyProgress(sender, 75);
             reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
         notifyProgress(sender, 100);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/types.h"
+#include "core/info_parser.h"
 
 #define ROCKSDB_STATS_LABEL "# Stats"
 
@@ -23,6 +24,7 @@ namespace fastonosql
             Stats();
             explicit Stats(const std::string& common_text);
             common::Value* valueByIndex(unsigned char index) const;
+            bool parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value);
 
             uint32_t compactions_level_;
             uint32_t file_size_mb_;
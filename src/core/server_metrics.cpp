@@ -0,0 +1,221 @@
+#include "core/server_metrics.h"
+
+#include <limits>
+
+#ifdef BUILD_WITH_REDIS
+#include "core/redis/redis_infos.h"
+#endif
+#ifdef BUILD_WITH_MEMCACHED
+#include "core/memcached/memcached_infos.h"
+#endif
+#ifdef BUILD_WITH_SSDB
+#include "core/ssdb/ssdb_infos.h"
+#endif
+
+namespace fastonosql
+{
+    namespace
+    {
+        const double unknownValue = std::numeric_limits<double>::quiet_NaN();
+
+        // a restarted server starts its counters over, such intervals give no rate
+        double ratePerSec(double cur, double prev, common::time64_t msec)
+        {
+            if(msec <= 0 || cur < prev){
+                return unknownValue;
+            }
+
+            return (cur - prev) * 1000 / msec;
+        }
+
+        // hit rate of the last interval, of the whole uptime if nothing was read since
+        double hitRate(double hits, double misses, double prevHits, double prevMisses, bool hasPrev)
+        {
+            if(hasPrev && hits >= prevHits && misses >= prevMisses){
+                double reads = (hits - prevHits) + (misses - prevMisses);
+                if(reads > 0){
+                    return (hits - prevHits) / reads;
+                }
+            }
+
+            if(hits + misses > 0){
+                return hits / (hits + misses);
+            }
+            return unknownValue;
+        }
+
+        // indexes of an info field in infoFieldsFromType
+        bool findInfoField(connectionTypes type, const std::string& name, unsigned char* property, unsigned char* field)
+        {
+            const std::vector< std::vector<Field> > fields = infoFieldsFromType(type);
+            for(size_t i = 0; i < fields.size(); ++i){
+                for(size_t j = 0; j < fields[i].size(); ++j){
+                    if(fields[i][j].name_ == name){
+                        *property = i;
+                        *field = j;
+                        return true;
+                    }
+                }
+            }
+
+            NOTREACHED();
+            return false;
+        }
+
+        bool findInfoFields(connectionTypes type, const char* const* names, size_t count, unsigned char* property, std::vector<unsigned char>* fields)
+        {
+            fields->clear();
+            for(size_t i = 0; i < count; ++i){
+                unsigned char prop = 0, field = 0;
+                if(!findInfoField(type, names[i], &prop, &field)){
+                    return false;
+                }
+
+                // the history sums columns of one property
+                if(i && prop != *property){
+                    NOTREACHED();
+                    return false;
+                }
+
+                *property = prop;
+                fields->push_back(field);
+            }
+            return !fields->empty();
+        }
+
+        template<typename T>
+        const T* infoCast(const ServerInfoSnapShoot& shot)
+        {
+            if(!shot.isValid()){
+                return NULL;
+            }
+
+            return dynamic_cast<const T*>(shot.info_.get());
+        }
+    }
+
+    ServerMetrics::ServerMetrics()
+        : opsPerSec_(unknownValue), usedMemory_(unknownValue), hitRate_(unknownValue),
+          connectedClients_(unknownValue), replicationLag_(unknownValue)
+    {
+
+    }
+
+    bool ServerMetrics::isKnown(double value)
+    {
+        return value == value;
+    }
+
+    ServerMetrics makeServerMetrics(const ServerInfoSnapShoot& cur, const ServerInfoSnapShoot& prev)
+    {
+        ServerMetrics res;
+        if(!cur.isValid()){
+            return res;
+        }
+
+        const common::time64_t msec = prev.isValid() ? cur.msec_ - prev.msec_ : 0;
+        connectionTypes type = cur.info_->type();
+#ifdef BUILD_WITH_REDIS
+        if(type == REDIS){
+            const RedisServerInfo* info = infoCast<RedisServerInfo>(cur);
+            const RedisServerInfo* pinfo = infoCast<RedisServerInfo>(prev);
+            if(!info){
+                return res;
+            }
+
+            res.opsPerSec_ = info->stats_.instantaneous_ops_per_sec_;
+            res.usedMemory_ = info->memory_.used_memory_;
+            res.connectedClients_ = info->clients_.connected_clients_;
+            res.hitRate_ = hitRate(info->stats_.keyspace_hits_, info->stats_.keyspace_misses_,
+                                   pinfo ? pinfo->stats_.keyspace_hits_ : 0, pinfo ? pinfo->stats_.keyspace_misses_ : 0, pinfo);
+            if(info->replication_.role_ == "slave"){
+                if(info->replication_.master_last_io_seconds_ago_ >= 0){
+                    res.replicationLag_ = info->replication_.master_last_io_seconds_ago_;
+                }
+            }
+            else{
+                res.replicationLag_ = 0;
+            }
+            return res;
+        }
+#endif
+#ifdef BUILD_WITH_MEMCACHED
+        if(type == MEMCACHED){
+            const MemcachedServerInfo* info = infoCast<MemcachedServerInfo>(cur);
+            const MemcachedServerInfo* pinfo = infoCast<MemcachedServerInfo>(prev);
+            if(!info){
+                return res;
+            }
+
+            if(pinfo){
+                res.opsPerSec_ = ratePerSec(static_cast<double>(info->common_.cmd_get_) + info->common_.cmd_set_,
+                                            static_cast<double>(pinfo->common_.cmd_get_) + pinfo->common_.cmd_set_, msec);
+            }
+            res.usedMemory_ = info->common_.bytes_;
+            res.connectedClients_ = info->common_.curr_connections_;
+            res.hitRate_ = hitRate(info->common_.get_hits_, info->common_.get_misses_,
+                                   pinfo ? pinfo->common_.get_hits_ : 0, pinfo ? pinfo->common_.get_misses_ : 0, pinfo);
+            return res;
+        }
+#endif
+#ifdef BUILD_WITH_SSDB
+        if(type == SSDB){
+            const SsdbServerInfo* info = infoCast<SsdbServerInfo>(cur);
+            const SsdbServerInfo* pinfo = infoCast<SsdbServerInfo>(prev);
+            if(!info){
+                return res;
+            }
+
+            if(pinfo){
+                res.opsPerSec_ = ratePerSec(info->common_.total_calls_, pinfo->common_.total_calls_, msec);
+            }
+            res.connectedClients_ = info->common_.links_;
+            return res;
+        }
+#endif
+        return res;
+    }
+
+    bool opsHistoryFields(connectionTypes type, unsigned char* property, std::vector<unsigned char>* fields, bool* counter)
+    {
+        if(!property || !fields || !counter){
+            return false;
+        }
+
+#ifdef BUILD_WITH_REDIS
+        if(type == REDIS){
+            static const char* const names[] = { REDIS_INSTANTANEOUS_OPS_PER_SEC_LABEL };
+            *counter = false;
+            return findInfoFields(type, names, SIZEOFMASS(names), property, fields);
+        }
+#endif
+#ifdef BUILD_WITH_MEMCACHED
+        if(type == MEMCACHED){
+            // the counters of makeServerMetrics
+            static const char* const names[] = { MEMCACHED_CMD_GET_LABEL, MEMCACHED_CMD_SET_LABEL };
+            *counter = true;
+            return findInfoFields(type, names, SIZEOFMASS(names), property, fields);
+        }
+#endif
+#ifdef BUILD_WITH_SSDB
+        if(type == SSDB){
+            static const char* const names[] = { SSDB_TOTAL_CALLS_LABEL };
+            *counter = true;
+            return findInfoFields(type, names, SIZEOFMASS(names), property, fields);
+        }
+#endif
+        return false;
+    }
+
+    InfoHistoryStore::points_container_type opsPerSecFromCounter(const InfoHistoryStore::points_container_type& points)
+    {
+        InfoHistoryStore::points_container_type res;
+        for(size_t i = 1; i < points.size(); ++i){
+            double rate = ratePerSec(points[i].second, points[i - 1].second, points[i].first - points[i - 1].first);
+            if(ServerMetrics::isKnown(rate)){
+                res.push_back(InfoHistoryStore::point_type(points[i].first, rate));
+            }
+        }
+        return res;
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "core/types.h"
+#include "core/info_history_store.h"
+
+namespace fastonosql
+{
+    // Headline numbers of a server for the dashboard, NaN where
+    // the server type doesn't report the metric.
+    struct ServerMetrics
+    {
+        ServerMetrics();
+
+        static bool isKnown(double value);
+
+        double opsPerSec_;
+        double usedMemory_; // bytes
+        double hitRate_; // 0..1
+        double connectedClients_;
+        double replicationLag_; // seconds since the master was heard of, 0 on masters
+    };
+
+    // counters are turned into rates against the previous snapshot, which may be empty
+    ServerMetrics makeServerMetrics(const ServerInfoSnapShoot& cur, const ServerInfoSnapShoot& prev);
+
+    // info fields the ops/sec history is read from, summed as the live rate is;
+    // counter fields have to go through opsPerSecFromCounter
+    bool opsHistoryFields(connectionTypes type, unsigned char* property, std::vector<unsigned char>* fields, bool* counter);
+    InfoHistoryStore::points_container_type opsPerSecFromCounter(const InfoHistoryStore::points_container_type& points);
+}
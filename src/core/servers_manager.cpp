@@ -46,6 +46,9 @@ namespace fastonosql
         : syncServers_(SettingsManager::instance().syncTabs())
     {
         qRegisterMetaType<ServerInfoSnapShoot>("ServerInfoSnapShoot");
+        qRegisterMetaType<MonitorSnapShot>("MonitorSnapShot");
+        qRegisterMetaType<KeyspaceSnapShot>("KeyspaceSnapShot");
+        qRegisterMetaType<FastoObject::child_batch_type>("FastoObject::child_batch_type");
     }
 
     ServersManager::~ServersManager()
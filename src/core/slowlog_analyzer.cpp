@@ -0,0 +1,197 @@
+#include "core/slowlog_analyzer.h"
+
+#include <algorithm>
+
+#define SLOWLOG_STORE_SIZE 10000
+#define SLOWLOG_STATS_SAMPLES 360
+
+namespace
+{
+    uint64_t percentile(std::vector<uint64_t>* values, double percent)
+    {
+        if(values->empty()){
+            return 0;
+        }
+
+        const size_t index = static_cast<size_t>((values->size() - 1) * percent / 100.0);
+        std::nth_element(values->begin(), values->begin() + index, values->end());
+        return (*values)[index];
+    }
+
+    bool moreTime(const fastonosql::SlowLogGroup& lhs, const fastonosql::SlowLogGroup& rhs)
+    {
+        return lhs.totalUsec_ > rhs.totalUsec_;
+    }
+
+    bool busierCommand(const fastonosql::CommandTrend& lhs, const fastonosql::CommandTrend& rhs)
+    {
+        return lhs.callsPerSec_ > rhs.callsPerSec_;
+    }
+}
+
+namespace fastonosql
+{
+    SlowLogEntry::SlowLogEntry()
+        : id_(-1), time_(0), usec_(0), command_(), key_(), args_(), client_()
+    {
+
+    }
+
+    std::string slowLogKeyPattern(const std::string& key)
+    {
+        std::string pattern;
+        pattern.reserve(key.size());
+        for(size_t i = 0; i < key.size(); ++i){
+            if(key[i] < '0' || key[i] > '9'){
+                pattern += key[i];
+            }
+            else if(pattern.empty() || pattern[pattern.size() - 1] != '*'){
+                pattern += '*';
+            }
+        }
+        return pattern;
+    }
+
+    CommandStat::CommandStat()
+        : calls_(0), usec_(0)
+    {
+
+    }
+
+    SlowLogGroup::SlowLogGroup()
+        : command_(), pattern_(), count_(0), totalUsec_(0), p50Usec_(0), p99Usec_(0), maxUsec_(0),
+          callsPerSec_(-1), usecPerCall_(-1)
+    {
+
+    }
+
+    CommandTrend::CommandTrend()
+        : command_(), callsPerSec_(0), usecPerCall_(-1), windowUsecPerCall_(-1)
+    {
+
+    }
+
+    SlowLogAnalyzer::SlowLogAnalyzer()
+        : entries_(), lastId_(-1), samples_()
+    {
+
+    }
+
+    // a reset slow log starts its ids over, so the last id is taken as is
+    void SlowLogAnalyzer::addEntries(const std::vector<SlowLogEntry>& entries)
+    {
+        if(entries.empty()){
+            return;
+        }
+
+        entries_.insert(entries_.end(), entries.begin(), entries.end());
+        while(entries_.size() > SLOWLOG_STORE_SIZE){
+            entries_.pop_front();
+        }
+        lastId_ = entries.back().id_;
+    }
+
+    void SlowLogAnalyzer::addCommandStats(common::time64_t msec, const command_stats_t& stats)
+    {
+        samples_.push_back(stats_sample_t(msec, stats));
+        while(samples_.size() > SLOWLOG_STATS_SAMPLES){
+            samples_.pop_front();
+        }
+    }
+
+    void SlowLogAnalyzer::clear()
+    {
+        entries_.clear();
+        lastId_ = -1;
+        samples_.clear();
+    }
+
+    int64_t SlowLogAnalyzer::lastId() const
+    {
+        return lastId_;
+    }
+
+    const std::deque<SlowLogEntry>& SlowLogAnalyzer::entries() const
+    {
+        return entries_;
+    }
+
+    std::vector<SlowLogGroup> SlowLogAnalyzer::groups() const
+    {
+        typedef std::map<std::pair<std::string, std::string>, std::vector<uint64_t> > durations_t;
+        durations_t durations;
+        for(std::deque<SlowLogEntry>::const_iterator it = entries_.begin(); it != entries_.end(); ++it){
+            durations[std::make_pair(it->command_, slowLogKeyPattern(it->key_))].push_back(it->usec_);
+        }
+
+        std::vector<SlowLogGroup> groups;
+        groups.reserve(durations.size());
+        for(durations_t::iterator it = durations.begin(); it != durations.end(); ++it){
+            std::vector<uint64_t>& values = it->second;
+            SlowLogGroup group;
+            group.command_ = it->first.first;
+            group.pattern_ = it->first.second;
+            group.count_ = values.size();
+            for(size_t i = 0; i < values.size(); ++i){
+                group.totalUsec_ += values[i];
+                group.maxUsec_ = std::max(group.maxUsec_, values[i]);
+            }
+            group.p50Usec_ = percentile(&values, 50);
+            group.p99Usec_ = percentile(&values, 99);
+            if(samples_.size() > 1){
+                rates(group.command_, samples_.size() - 2, samples_.size() - 1, &group.callsPerSec_, &group.usecPerCall_);
+            }
+            groups.push_back(group);
+        }
+
+        std::sort(groups.begin(), groups.end(), &moreTime);
+        return groups;
+    }
+
+    std::vector<CommandTrend> SlowLogAnalyzer::trends() const
+    {
+        std::vector<CommandTrend> trends;
+        if(samples_.size() < 2){
+            return trends;
+        }
+
+        const command_stats_t& last = samples_.back().second;
+        trends.reserve(last.size());
+        for(command_stats_t::const_iterator it = last.begin(); it != last.end(); ++it){
+            CommandTrend trend;
+            trend.command_ = it->first;
+            if(!rates(it->first, samples_.size() - 2, samples_.size() - 1, &trend.callsPerSec_, &trend.usecPerCall_)){
+                continue;
+            }
+
+            double callsPerSec = 0;
+            rates(it->first, 0, samples_.size() - 1, &callsPerSec, &trend.windowUsecPerCall_);
+            trends.push_back(trend);
+        }
+
+        std::sort(trends.begin(), trends.end(), &busierCommand);
+        return trends;
+    }
+
+    // counters going back (CONFIG RESETSTAT) make the span unknown
+    bool SlowLogAnalyzer::rates(const std::string& command, size_t from, size_t to, double* callsPerSec, double* usecPerCall) const
+    {
+        const stats_sample_t& before = samples_[from];
+        const stats_sample_t& after = samples_[to];
+        command_stats_t::const_iterator now = after.second.find(command);
+        if(now == after.second.end() || after.first <= before.first){
+            return false;
+        }
+
+        command_stats_t::const_iterator prev = before.second.find(command);
+        const CommandStat old = prev != before.second.end() ? prev->second : CommandStat();
+        if(now->second.calls_ < old.calls_ || now->second.usec_ < old.usec_){
+            return false;
+        }
+
+        const uint64_t calls = now->second.calls_ - old.calls_;
+        *callsPerSec = calls * 1000.0 / (after.first - before.first);
+        *usecPerCall = calls ? static_cast<double>(now->second.usec_ - old.usec_) / calls : -1;
+        return true;
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "common/time.h"
+
+namespace fastonosql
+{
+    // one entry of the server's slow log
+    struct SlowLogEntry
+    {
+        SlowLogEntry();
+
+        int64_t id_;
+        common::time64_t time_; // sec since epoch
+        uint64_t usec_;
+        std::string command_; // lower case
+        std::string key_; // empty for commands without one
+        std::string args_; // the command line as logged
+        std::string client_;
+    };
+
+    // key with its digit runs folded, "user:42:name" is "user:*:name"
+    std::string slowLogKeyPattern(const std::string& key);
+
+    // cumulative calls and server time of one command
+    struct CommandStat
+    {
+        CommandStat();
+
+        uint64_t calls_;
+        uint64_t usec_;
+    };
+
+    typedef std::map<std::string, CommandStat> command_stats_t;
+
+    // slow entries of one command on one key pattern, joined with the command's rates
+    struct SlowLogGroup
+    {
+        SlowLogGroup();
+
+        std::string command_;
+        std::string pattern_;
+        size_t count_;
+        uint64_t totalUsec_;
+        uint64_t p50Usec_;
+        uint64_t p99Usec_;
+        uint64_t maxUsec_;
+        double callsPerSec_; // -1 unknown
+        double usecPerCall_; // -1 unknown
+    };
+
+    struct CommandTrend
+    {
+        CommandTrend();
+
+        std::string command_;
+        double callsPerSec_; // between the last two samples
+        double usecPerCall_;
+        double windowUsecPerCall_; // over all the kept samples
+    };
+
+    // Slow log entries polled incrementally by id, kept in a bounded store,
+    // and samples of the command stats for their rates over a bounded window.
+    class SlowLogAnalyzer
+    {
+    public:
+        SlowLogAnalyzer();
+
+        void addEntries(const std::vector<SlowLogEntry>& entries); // oldest first
+        void addCommandStats(common::time64_t msec, const command_stats_t& stats);
+        void clear();
+
+        int64_t lastId() const; // -1 before the first entry
+        const std::deque<SlowLogEntry>& entries() const; // oldest first
+
+        std::vector<SlowLogGroup> groups() const; // the most total time first
+        std::vector<CommandTrend> trends() const; // the busiest first
+
+    private:
+        typedef std::pair<common::time64_t, command_stats_t> stats_sample_t;
+
+        bool rates(const std::string& command, size_t from, size_t to, double* callsPerSec, double* usecPerCall) const;
+
+        std::deque<SlowLogEntry> entries_;
+        int64_t lastId_;
+        std::deque<stats_sample_t> samples_;
+    };
+}
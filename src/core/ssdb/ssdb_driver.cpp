@@ -1,26 +1,35 @@
 #include "core/ssdb/ssdb_driver.h"
 
+#include <algorithm>
+#include <list>
+
 #include "common/sprintf.h"
 #include "common/utils.h"
 #include "fasto/qt/logger.h"
 
 #include "core/command_logger.h"
+#include "core/benchmark.h"
 
 #include "core/ssdb/ssdb_config.h"
 #include "core/ssdb/ssdb_infos.h"
 
 #include <SSDB.h>
+#include <util/bytes.h>
 
 #define INFO_REQUEST "INFO"
-#define GET_KEYS_PATTERN_1ARGS_I "KEYS a z %d"
+#define GET_KEYS_PATTERN_1ARGS_I "SCAN \"\" \"\" %d"
+#define SEARCH_KEYS_PATTERN_3ARGS_SSI "KEYS \"%s\" \"%s\" %d"
 #define DELETE_KEY_PATTERN_1ARGS_S "DEL %s"
+#define DELETE_KEY_HASH_PATTERN_1ARGS_S "HCLEAR %s"
+#define DELETE_KEY_ZSET_PATTERN_1ARGS_S "ZCLEAR %s"
+#define DELETE_KEY_QUEUE_PATTERN_1ARGS_S "QCLEAR %s"
 #define GET_SERVER_TYPE ""
 
 #define GET_KEY_PATTERN_1ARGS_S "GET %s"
 #define GET_KEY_LIST_PATTERN_1ARGS_S "LRANGE %s 0 -1"
 #define GET_KEY_SET_PATTERN_1ARGS_S "SMEMBERS %s"
 #define GET_KEY_ZSET_PATTERN_1ARGS_S "ZRANGE %s 0 -1"
-#define GET_KEY_HASH_PATTERN_1ARGS_S "HGET %s"
+#define GET_KEY_HASH_PATTERN_1ARGS_S "HSCAN %s \"\" \"\" -1"
 
 #define SET_KEY_PATTERN_2ARGS_SS "SET %s %s"
 #define SET_KEY_LIST_PATTERN_2ARGS_SS "LPUSH %s %s"
@@ -28,6 +37,12 @@
 #define SET_KEY_ZSET_PATTERN_2ARGS_SS "ZADD %s %s"
 #define SET_KEY_HASH_PATTERN_2ARGS_SS "HMSET %s %s"
 
+#define MULTI_WRITE_CHUNK_PAIRS 512
+#define KEYS_SEARCH_BATCH 1000
+
+#define LOAD_PAGE_SIZE 100
+#define PAGES_CACHE_SIZE 64
+
 namespace fastonosql
 {
     namespace
@@ -56,6 +71,356 @@ namespace fastonosql
             SSHInfo sinfo = settings->sshInfo();
             return createConnection(config, sinfo, context);
         }
+
+        // Pipelined replies are read straight from the link buffer.
+        class ReplyCollector
+                : public ssdb::PipelineHandler
+        {
+        public:
+            ReplyCollector()
+                : code_("ok")
+            {
+
+            }
+
+            virtual bool handle(size_t index, const std::vector<Bytes>& resp)
+            {
+                if(resp[0] != Bytes("ok") && resp[0] != Bytes("not_found")){
+                    code_ = resp[0].String();
+                    return false;
+                }
+
+                return collect(index, resp);
+            }
+
+            ssdb::Status status() const
+            {
+                return ssdb::Status(code_);
+            }
+
+        protected:
+            virtual bool collect(size_t index, const std::vector<Bytes>& resp)
+            {
+                UNUSED(index);
+                UNUSED(resp);
+                return true;
+            }
+
+        private:
+            std::string code_;
+        };
+
+        class ListReplyCollector
+                : public ReplyCollector
+        {
+        public:
+            explicit ListReplyCollector(common::ArrayValue* ar)
+                : ar_(ar)
+            {
+
+            }
+
+        protected:
+            virtual bool collect(size_t index, const std::vector<Bytes>& resp)
+            {
+                UNUSED(index);
+                for(size_t i = 1; i < resp.size(); ++i){
+                    ar_->append(common::Value::createStringValue(std::string(resp[i].data(), resp[i].size())));
+                }
+                return true;
+            }
+
+        private:
+            common::ArrayValue* const ar_;
+        };
+
+        class KeyValueReplyCollector
+                : public ReplyCollector
+        {
+        public:
+            explicit KeyValueReplyCollector(std::vector<NDbKValue>* keys)
+                : keys_(keys)
+            {
+
+            }
+
+        protected:
+            virtual bool collect(size_t index, const std::vector<Bytes>& resp)
+            {
+                UNUSED(index);
+                for(size_t i = 1; i + 1 < resp.size(); i += 2){
+                    NKey key(std::string(resp[i].data(), resp[i].size()));
+                    NValue val(common::Value::createStringValue(std::string(resp[i + 1].data(), resp[i + 1].size())));
+                    keys_->push_back(NDbKValue(key, val));
+                }
+                return true;
+            }
+
+        private:
+            std::vector<NDbKValue>* const keys_;
+        };
+
+        class StringsReplyCollector
+                : public ReplyCollector
+        {
+        public:
+            explicit StringsReplyCollector(std::vector<std::vector<std::string> >* lists)
+                : lists_(lists)
+            {
+
+            }
+
+        protected:
+            virtual bool collect(size_t index, const std::vector<Bytes>& resp)
+            {
+                std::vector<std::string>& list = (*lists_)[index];
+                list.reserve(resp.size() - 1);
+                for(size_t i = 1; i < resp.size(); ++i){
+                    list.push_back(std::string(resp[i].data(), resp[i].size()));
+                }
+                return true;
+            }
+
+        private:
+            std::vector<std::vector<std::string> >* const lists_;
+        };
+
+        class SizeReplyCollector
+                : public ReplyCollector
+        {
+        public:
+            explicit SizeReplyCollector(std::vector<int64_t>* sizes)
+                : sizes_(sizes)
+            {
+
+            }
+
+        protected:
+            virtual bool collect(size_t index, const std::vector<Bytes>& resp)
+            {
+                (*sizes_)[index] = resp.size() > 1 ? resp[1].Int64() : 0;
+                return true;
+            }
+
+        private:
+            std::vector<int64_t>* const sizes_;
+        };
+
+        typedef std::vector<std::string> page_type;
+
+        // Bounded LRU of loaded collection pages, also remembers where each
+        // page starts so the next one doesn't need a scan from the beginning.
+        class PagesCache
+        {
+        public:
+            explicit PagesCache(size_t max_pages)
+                : max_pages_(max_pages)
+            {
+
+            }
+
+            bool find(const std::string& id, uint32_t page, page_type* items)
+            {
+                pages_container_type::iterator it = pages_.find(page_key(id, page));
+                if(it == pages_.end()){
+                    return false;
+                }
+
+                lru_.splice(lru_.begin(), lru_, it->second.second);
+                touch(id);
+                *items = it->second.first;
+                return true;
+            }
+
+            bool cursor(const std::string& id, uint32_t page, page_type* cursor) const
+            {
+                if(page == 0){
+                    cursor->clear();
+                    return true;
+                }
+
+                cursors_container_type::const_iterator it = cursors_.find(id);
+                if(it == cursors_.end()){
+                    return false;
+                }
+
+                std::map<uint32_t, page_type>::const_iterator cit = it->second.first.find(page);
+                if(cit == it->second.first.end()){
+                    return false;
+                }
+
+                *cursor = cit->second;
+                return true;
+            }
+
+            void insert(const std::string& id, uint32_t page, const page_type& items, const page_type& next)
+            {
+                cursors_container_type::iterator cit = cursors_.find(id);
+                if(cit == cursors_.end()){
+                    if(cursors_.size() >= max_pages_){
+                        const std::string lru = ids_.back();
+                        remove(lru);
+                    }
+                    ids_.push_front(id);
+                    cit = cursors_.insert(std::make_pair(id, std::make_pair(std::map<uint32_t, page_type>(), ids_.begin()))).first;
+                }
+                else{
+                    ids_.splice(ids_.begin(), ids_, cit->second.second);
+                }
+                cit->second.first[page + 1] = next;
+
+                const page_key key(id, page);
+                pages_container_type::iterator it = pages_.find(key);
+                if(it != pages_.end()){
+                    lru_.erase(it->second.second);
+                    pages_.erase(it);
+                }
+
+                while(pages_.size() >= max_pages_){
+                    pages_.erase(lru_.back());
+                    lru_.pop_back();
+                }
+
+                lru_.push_front(key);
+                pages_[key] = std::make_pair(items, lru_.begin());
+            }
+
+            void remove(const std::string& id)
+            {
+                cursors_container_type::iterator cit = cursors_.find(id);
+                if(cit != cursors_.end()){
+                    ids_.erase(cit->second.second);
+                    cursors_.erase(cit);
+                }
+                for(pages_container_type::iterator it = pages_.lower_bound(page_key(id, 0));
+                    it != pages_.end() && it->first.first == id;){
+                    lru_.erase(it->second.second);
+                    pages_.erase(it++);
+                }
+            }
+
+        private:
+            typedef std::pair<std::string, uint32_t> page_key;
+            typedef std::list<page_key> lru_container_type;
+            typedef std::map<page_key, std::pair<page_type, lru_container_type::iterator> > pages_container_type;
+            // cursors of a collection outlive its pages, they go with the least recently used collection
+            typedef std::list<std::string> ids_container_type;
+            typedef std::map<std::string, std::pair<std::map<uint32_t, page_type>, ids_container_type::iterator> > cursors_container_type;
+
+            void touch(const std::string& id)
+            {
+                cursors_container_type::iterator cit = cursors_.find(id);
+                if(cit != cursors_.end()){
+                    ids_.splice(ids_.begin(), ids_, cit->second.second);
+                }
+            }
+
+            const size_t max_pages_;
+            lru_container_type lru_;
+            pages_container_type pages_;
+            ids_container_type ids_;
+            cursors_container_type cursors_;
+        };
+
+        bool isPagedType(common::Value::Type type)
+        {
+            return type == common::Value::TYPE_HASH || type == common::Value::TYPE_ZSET || type == common::Value::TYPE_ARRAY;
+        }
+
+        // hash, zset and queue with the same name can coexist
+        std::string pageId(common::Value::Type type, const std::string& name)
+        {
+            char prefix = type == common::Value::TYPE_HASH ? 'h' : (type == common::Value::TYPE_ZSET ? 'z' : 'q');
+            return std::string(1, prefix) + ":" + name;
+        }
+
+        // range starts are exclusive in ssdb, step right before the prefix
+        std::string rangeStart(const std::string& prefix)
+        {
+            if(prefix.empty()){
+                return prefix;
+            }
+
+            std::string start = prefix;
+            unsigned char last = start[start.size() - 1];
+            if(!last){
+                start.resize(start.size() - 1);
+            }
+            else{
+                start[start.size() - 1] = static_cast<char>(last - 1);
+                start += '\xff';
+            }
+            return start;
+        }
+
+        std::string requestText(const std::vector<std::string>& req)
+        {
+            std::string text;
+            for(size_t i = 0; i < req.size(); ++i){
+                if(i){
+                    text += ' ';
+                }
+                text += req[i].empty() ? "\"\"" : req[i];
+            }
+            return text;
+        }
+
+        // a connection of its own, a batch goes out in one pipeline
+        class SsdbBenchmarkClient
+                : public BenchmarkClient
+        {
+        public:
+            explicit SsdbBenchmarkClient(ssdb::Client* ssdb)
+                : ssdb_(ssdb)
+            {
+
+            }
+
+            virtual ~SsdbBenchmarkClient()
+            {
+                delete ssdb_;
+            }
+
+            virtual common::Error execute(const std::vector<BenchmarkRequest>& batch, const std::string& value)
+            {
+                std::vector<std::vector<std::string> > reqs(batch.size());
+                for(size_t i = 0; i < batch.size(); ++i){
+                    const BenchmarkRequest& req = batch[i];
+                    std::vector<std::string>& cmd = reqs[i];
+                    cmd.push_back(req.write_ ? "set" : "get");
+                    cmd.push_back(req.key_);
+                    if(req.write_){
+                        cmd.push_back(value.substr(0, req.valueSize_));
+                    }
+                }
+
+                ReplyCollector collector;
+                ssdb::Status st = ssdb_->pipeline(reqs, &collector);
+                if (st.ok()){
+                    st = collector.status();
+                }
+                if (st.error()){
+                    char buff[1024] = {0};
+                    common::SNPrintf(buff, sizeof(buff), "Benchmark error: %s", st.code());
+                    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                }
+                return common::Error();
+            }
+
+            virtual common::Error remove(const std::vector<std::string>& keys)
+            {
+                ssdb::Status st = ssdb_->multi_del(keys);
+                if (st.error()){
+                    char buff[1024] = {0};
+                    common::SNPrintf(buff, sizeof(buff), "Benchmark error: %s", st.code());
+                    return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                }
+                return common::Error();
+            }
+
+        private:
+            ssdb::Client* const ssdb_;
+        };
     }
 
     common::Error testConnection(SsdbConnectionSettings* settings)
@@ -74,7 +439,7 @@ namespace fastonosql
     struct SsdbDriver::pimpl
     {
         pimpl()
-            : ssdb_(NULL)
+            : ssdb_(NULL), pages_(PAGES_CACHE_SIZE)
         {
 
         }
@@ -182,7 +547,7 @@ namespace fastonosql
                 common::Error er = get(argv[1], &ret);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue(ret);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -195,7 +560,7 @@ namespace fastonosql
                 common::Error er = set(argv[1], argv[2]);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -209,7 +574,7 @@ namespace fastonosql
                 common::Error er = dbsize(ret);
                 if(!er){
                     common::FundamentalValue *val = common::Value::createUIntegerValue(ret);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -222,7 +587,7 @@ namespace fastonosql
                 common::Error er = auth(argv[1]);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("OK");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -235,7 +600,7 @@ namespace fastonosql
                 common::Error er = setx(argv[1], argv[2], atoi(argv[3]));
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -248,7 +613,7 @@ namespace fastonosql
                 common::Error er = del(argv[1]);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("DELETED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -262,7 +627,7 @@ namespace fastonosql
                 common::Error er = incr(argv[1], atoll(argv[2]), &ret);
                 if(!er){
                     common::FundamentalValue *val = common::Value::createIntegerValue(ret);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -280,7 +645,7 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(keysout[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -298,7 +663,7 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(keysout[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -316,7 +681,7 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(keysout[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -339,7 +704,7 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(keysout[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -357,25 +722,21 @@ namespace fastonosql
                 common::Error er = multi_del(keysget);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("DELETED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
             }
             else if(strcasecmp(argv[0], "multi_set") == 0){
-                if(argc < 2 || argc % 2){
-                    return common::make_error_value("Invalid multi_del input argument", common::ErrorValue::E_ERROR);
+                if(argc < 3 || (argc % 2 == 0)){
+                    return common::make_error_value("Invalid multi_set input argument", common::ErrorValue::E_ERROR);
                 }
 
-                std::map<std::string, std::string> keysset;
-                for(int i = 1; i < argc; i += 2){
-                    keysset[argv[i]] = argv[i + 1];
-                }
-
-                common::Error er = multi_set(keysset);
+                std::vector<std::string> pairs(argv + 1, argv + argc);
+                common::Error er = multi_write("multi_set", NULL, pairs);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -389,7 +750,7 @@ namespace fastonosql
                 common::Error er = hget(argv[1], argv[2], &ret);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue(ret);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -402,7 +763,7 @@ namespace fastonosql
                 common::Error er = hset(argv[1], argv[2], argv[3]);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -415,7 +776,7 @@ namespace fastonosql
                 common::Error er = hdel(argv[1], argv[2]);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("DELETED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -429,21 +790,36 @@ namespace fastonosql
                 common::Error er = hincr(argv[1], argv[2], atoll(argv[3]), &res);
                 if(!er){
                     common::FundamentalValue *val = common::Value::createIntegerValue(res);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
             }
             else if(strcasecmp(argv[0], "hsize") == 0){
-                if(argc != 2){
+                if(argc < 2){
                     return common::make_error_value("Invalid hsize input argument", common::ErrorValue::E_ERROR);
                 }
 
-                int64_t res = 0;
-                common::Error er = hsize(argv[1], &res);
+                if(argc == 2){
+                    int64_t res = 0;
+                    common::Error er = hsize(argv[1], &res);
+                    if(!er){
+                        common::FundamentalValue *val = common::Value::createIntegerValue(res);
+                        FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
+                        out->addChildren(child);
+                    }
+                    return er;
+                }
+
+                std::vector<std::string> names(argv + 1, argv + argc);
+                std::vector<int64_t> sizes;
+                common::Error er = multi_size("hsize", names, &sizes);
                 if(!er){
-                    common::FundamentalValue *val = common::Value::createIntegerValue(res);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    common::ArrayValue* ar = common::Value::createArrayValue();
+                    for(size_t i = 0; i < sizes.size(); ++i){
+                        ar->append(common::Value::createIntegerValue(sizes[i]));
+                    }
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -457,7 +833,7 @@ namespace fastonosql
                 common::Error er = hclear(argv[1], &res);
                 if(!er){
                     common::FundamentalValue *val = common::Value::createIntegerValue(res);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -475,7 +851,7 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(keysout[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -485,17 +861,17 @@ namespace fastonosql
                     return common::make_error_value("Invalid hscan input argument", common::ErrorValue::E_ERROR);
                 }
 
-                std::vector<std::string> keysout;
-                common::Error er = hscan(argv[1], argv[2], argv[3], atoll(argv[4]), &keysout);
-                if(!er){
-                    common::ArrayValue* ar = common::Value::createArrayValue();
-                    for(int i = 0; i < keysout.size(); ++i){
-                        common::StringValue *val = common::Value::createStringValue(keysout[i]);
-                        ar->append(val);
-                    }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
-                    out->addChildren(child);
+                std::vector<std::string> req(argv, argv + argc);
+                req[0] = "hscan";
+                common::ArrayValue* ar = common::Value::createArrayValue();
+                common::Error er = list_request(req, ar);
+                if(er){
+                    delete ar;
+                    return er;
                 }
+
+                FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
+                out->addChildren(child);
                 return er;
             }
             else if(strcasecmp(argv[0], "hrscan") == 0){
@@ -503,17 +879,17 @@ namespace fastonosql
                     return common::make_error_value("Invalid hrscan input argument", common::ErrorValue::E_ERROR);
                 }
 
-                std::vector<std::string> keysout;
-                common::Error er = hrscan(argv[1], argv[2], argv[3], atoll(argv[4]), &keysout);
-                if(!er){
-                    common::ArrayValue* ar = common::Value::createArrayValue();
-                    for(int i = 0; i < keysout.size(); ++i){
-                        common::StringValue *val = common::Value::createStringValue(keysout[i]);
-                        ar->append(val);
-                    }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
-                    out->addChildren(child);
+                std::vector<std::string> req(argv, argv + argc);
+                req[0] = "hrscan";
+                common::ArrayValue* ar = common::Value::createArrayValue();
+                common::Error er = list_request(req, ar);
+                if(er){
+                    delete ar;
+                    return er;
                 }
+
+                FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
+                out->addChildren(child);
                 return er;
             }
             else if(strcasecmp(argv[0], "multi_hget") == 0){
@@ -534,25 +910,22 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(keysout[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
             }
             else if(strcasecmp(argv[0], "multi_hset") == 0){
-                if(argc < 2 || (argc % 2 == 0)){
+                if(argc < 4 || argc % 2){
                     return common::make_error_value("Invalid multi_hset input argument", common::ErrorValue::E_ERROR);
                 }
 
-                std::map<std::string, std::string> keys;
-                for(int i = 2; i < argc; i += 2){
-                    keys[argv[i]] = argv[i + 1];
-                }
-
-                common::Error er = multi_hset(argv[1], keys);
+                std::string name = argv[1];
+                std::vector<std::string> pairs(argv + 2, argv + argc);
+                common::Error er = multi_write("multi_hset", &name, pairs);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -566,7 +939,7 @@ namespace fastonosql
                 common::Error er = zget(argv[1], argv[2], &ret);
                 if(!er){
                     common::FundamentalValue *val = common::Value::createIntegerValue(ret);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -579,7 +952,7 @@ namespace fastonosql
                 common::Error er = zset(argv[1], argv[2], atoll(argv[3]));
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -592,7 +965,7 @@ namespace fastonosql
                 common::Error er = zdel(argv[1], argv[2]);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("DELETED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -606,21 +979,36 @@ namespace fastonosql
                 common::Error er = zincr(argv[1], argv[2], atoll(argv[3]), &ret);
                 if(!er){
                     common::FundamentalValue *val = common::Value::createIntegerValue(ret);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
             }
             else if(strcasecmp(argv[0], "zsize") == 0){
-                if(argc != 2){
+                if(argc < 2){
                     return common::make_error_value("Invalid zsize input argument", common::ErrorValue::E_ERROR);
                 }
 
-                int64_t res = 0;
-                common::Error er = zsize(argv[1], &res);
+                if(argc == 2){
+                    int64_t res = 0;
+                    common::Error er = zsize(argv[1], &res);
+                    if(!er){
+                        common::FundamentalValue *val = common::Value::createIntegerValue(res);
+                        FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
+                        out->addChildren(child);
+                    }
+                    return er;
+                }
+
+                std::vector<std::string> names(argv + 1, argv + argc);
+                std::vector<int64_t> sizes;
+                common::Error er = multi_size("zsize", names, &sizes);
                 if(!er){
-                    common::FundamentalValue *val = common::Value::createIntegerValue(res);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    common::ArrayValue* ar = common::Value::createArrayValue();
+                    for(size_t i = 0; i < sizes.size(); ++i){
+                        ar->append(common::Value::createIntegerValue(sizes[i]));
+                    }
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -634,7 +1022,7 @@ namespace fastonosql
                 common::Error er = zclear(argv[1], &res);
                 if(!er){
                     common::FundamentalValue *val = common::Value::createIntegerValue(res);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -648,7 +1036,7 @@ namespace fastonosql
                 common::Error er = zrank(argv[1], argv[2], &res);
                 if(!er){
                     common::FundamentalValue *val = common::Value::createIntegerValue(res);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -662,7 +1050,7 @@ namespace fastonosql
                 common::Error er = zrrank(argv[1], argv[2], &res);
                 if(!er){
                     common::FundamentalValue *val = common::Value::createIntegerValue(res);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -680,7 +1068,7 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(res[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -698,7 +1086,7 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(res[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -718,7 +1106,7 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(res[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -728,19 +1116,17 @@ namespace fastonosql
                     return common::make_error_value("Invalid zscan input argument", common::ErrorValue::E_ERROR);
                 }
 
-                std::vector<std::string> res;
-                int64_t st = atoll(argv[3]);
-                int64_t end = atoll(argv[4]);
-                common::Error er = zscan(argv[1], argv[2], &st, &end, atoll(argv[5]), &res);
-                if(!er){
-                    common::ArrayValue* ar = common::Value::createArrayValue();
-                    for(int i = 0; i < res.size(); ++i){
-                        common::StringValue *val = common::Value::createStringValue(res[i]);
-                        ar->append(val);
-                    }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
-                    out->addChildren(child);
+                std::vector<std::string> req(argv, argv + argc);
+                req[0] = "zscan";
+                common::ArrayValue* ar = common::Value::createArrayValue();
+                common::Error er = list_request(req, ar);
+                if(er){
+                    delete ar;
+                    return er;
                 }
+
+                FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
+                out->addChildren(child);
                 return er;
             }
             else if(strcasecmp(argv[0], "zrscan") == 0){
@@ -748,19 +1134,17 @@ namespace fastonosql
                     return common::make_error_value("Invalid zrscan input argument", common::ErrorValue::E_ERROR);
                 }
 
-                std::vector<std::string> res;
-                int64_t st = atoll(argv[3]);
-                int64_t end = atoll(argv[4]);
-                common::Error er = zrscan(argv[1], argv[2], &st, &end, atoll(argv[5]), &res);
-                if(!er){
-                    common::ArrayValue* ar = common::Value::createArrayValue();
-                    for(int i = 0; i < res.size(); ++i){
-                        common::StringValue *val = common::Value::createStringValue(res[i]);
-                        ar->append(val);
-                    }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
-                    out->addChildren(child);
+                std::vector<std::string> req(argv, argv + argc);
+                req[0] = "zrscan";
+                common::ArrayValue* ar = common::Value::createArrayValue();
+                common::Error er = list_request(req, ar);
+                if(er){
+                    delete ar;
+                    return er;
                 }
+
+                FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
+                out->addChildren(child);
                 return er;
             }
             else if(strcasecmp(argv[0], "multi_zget") == 0){
@@ -781,25 +1165,22 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(res[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
             }
             else if(strcasecmp(argv[0], "multi_zset") == 0){
-                if(argc < 2 || (argc % 2 == 0)){
+                if(argc < 4 || argc % 2){
                     return common::make_error_value("Invalid zrscan input argument", common::ErrorValue::E_ERROR);
                 }
 
-                std::map<std::string, int64_t> keysget;
-                for(int i = 2; i < argc; i += 2){
-                    keysget[argv[i]] = atoll(argv[i+1]);
-                }
-
-                common::Error er = multi_zset(argv[1], keysget);
+                std::string name = argv[1];
+                std::vector<std::string> pairs(argv + 2, argv + argc);
+                common::Error er = multi_write("multi_zset", &name, pairs);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -817,7 +1198,7 @@ namespace fastonosql
                 common::Error er = multi_zdel(argv[1], keysget);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("DELETED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -831,7 +1212,7 @@ namespace fastonosql
                 common::Error er = info(argc == 2 ? argv[1] : 0, statsout);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue(SsdbServerInfo(statsout).toString());
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -845,7 +1226,7 @@ namespace fastonosql
                 common::Error er = qpop(argv[1], &ret);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue(ret);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -858,7 +1239,32 @@ namespace fastonosql
                 common::Error er = qpush(argv[1], argv[2]);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
+                    out->addChildren(child);
+                }
+                return er;
+            }
+            else if(strcasecmp(argv[0], "qsize") == 0){
+                if(argc < 2){
+                    return common::make_error_value("Invalid qsize input argument", common::ErrorValue::E_ERROR);
+                }
+
+                std::vector<std::string> names(argv + 1, argv + argc);
+                std::vector<int64_t> sizes;
+                common::Error er = multi_size("qsize", names, &sizes);
+                if(!er){
+                    if(argc == 2){
+                        common::FundamentalValue *val = common::Value::createIntegerValue(sizes[0]);
+                        FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
+                        out->addChildren(child);
+                        return er;
+                    }
+
+                    common::ArrayValue* ar = common::Value::createArrayValue();
+                    for(size_t i = 0; i < sizes.size(); ++i){
+                        ar->append(common::Value::createIntegerValue(sizes[i]));
+                    }
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -879,7 +1285,7 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(keysout[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -893,7 +1299,7 @@ namespace fastonosql
                 common::Error er = qclear(argv[1], &res);
                 if(!er){
                     common::FundamentalValue *val = common::Value::createIntegerValue(res);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -905,6 +1311,22 @@ namespace fastonosql
             }
         }
 
+        common::Error createBenchmarkClient(BenchmarkClient** client)
+        {
+            if(!isConnected()){
+                return common::make_error_value("Not connected", common::ErrorValue::E_ERROR);
+            }
+
+            ssdb::Client* context = NULL;
+            common::Error er = createConnection(config_, sinfo_, &context);
+            if(er){
+                return er;
+            }
+
+            *client = new SsdbBenchmarkClient(context);
+            return common::Error();
+        }
+
     private:
 
         common::Error auth(const std::string& password)
@@ -1039,6 +1461,307 @@ namespace fastonosql
             return common::Error();
         }
 
+        common::Error pipeline(const std::vector<std::vector<std::string> >& reqs, ReplyCollector* collector)
+        {
+            ssdb::Status st = ssdb_->pipeline(reqs, collector);
+            if (st.ok()){
+                st = collector->status();
+            }
+            if (st.error()){
+                char buff[1024] = {0};
+                common::SNPrintf(buff, sizeof(buff), "pipeline function error: %s", st.code());
+                return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+            }
+            return common::Error();
+        }
+
+        common::Error list_request(const std::vector<std::string>& req, page_type* ret)
+        {
+            std::vector<std::vector<std::string> > reqs(1, req);
+            std::vector<page_type> lists(1);
+            StringsReplyCollector collector(&lists);
+            common::Error er = pipeline(reqs, &collector);
+            if(!er){
+                ret->swap(lists[0]);
+            }
+            return er;
+        }
+
+    public:
+        // hashes, zsets and queues with their sizes, two round trips
+        common::Error collections(const KeysFilter& filter, uint64_t limit, std::vector<NDbKValue>* ret)
+        {
+            static const char* list_cmds[] = { "hlist", "zlist", "qlist" };
+            static const char* size_cmds[] = { "hsize", "zsize", "qsize" };
+            static const common::Value::Type types[] = { common::Value::TYPE_HASH, common::Value::TYPE_ZSET, common::Value::TYPE_ARRAY };
+
+            std::vector<std::vector<std::string> > reqs;
+            std::vector<size_t> kinds;
+            const uint64_t count = filter.isMatchAll() ? limit : std::max<uint64_t>(limit, KEYS_SEARCH_BATCH);
+            for(size_t i = 0; i < SIZEOFMASS(list_cmds); ++i){
+                if(!filter.matchType(types[i])){
+                    continue;
+                }
+
+                std::vector<std::string> req;
+                req.push_back(list_cmds[i]);
+                req.push_back(rangeStart(filter.prefix()));
+                req.push_back(filter.prefixEnd());
+                req.push_back(common::convertToString(count));
+                LOG_COMMAND(Command(requestText(req), common::Value::C_INNER));
+                reqs.push_back(req);
+                kinds.push_back(i);
+            }
+
+            if(reqs.empty()){
+                return common::Error();
+            }
+
+            std::vector<page_type> names(reqs.size());
+            StringsReplyCollector collector(&names);
+            common::Error er = pipeline(reqs, &collector);
+            if(er){
+                return er;
+            }
+
+            std::vector<std::vector<std::string> > sreqs;
+            std::vector<NDbKValue> keys;
+            for(size_t k = 0; k < names.size(); ++k){
+                const size_t i = kinds[k];
+                filter.filter(&names[k]);
+                for(size_t j = 0; j < names[k].size() && keys.size() < limit; ++j){
+                    std::vector<std::string> req;
+                    req.push_back(size_cmds[i]);
+                    req.push_back(names[k][j]);
+                    sreqs.push_back(req);
+
+                    NValue val(common::Value::createEmptyValueFromType(types[i]));
+                    keys.push_back(NDbKValue(NKey(names[k][j]), val));
+                }
+            }
+
+            std::vector<int64_t> sizes(sreqs.size(), -1);
+            SizeReplyCollector scollector(&sizes);
+            er = pipeline(sreqs, &scollector);
+            if(er){
+                return er;
+            }
+
+            for(size_t i = 0; i < keys.size(); ++i){
+                keys[i].setSize(sizes[i]);
+                ret->push_back(keys[i]);
+            }
+            return common::Error();
+        }
+
+        std::vector<std::string> page_request(common::Value::Type type, const std::string& name, uint32_t page, const page_type& cursor) const
+        {
+            std::vector<std::string> req;
+            if(type == common::Value::TYPE_HASH){
+                req.push_back("hscan");
+                req.push_back(name);
+                req.push_back(cursor.empty() ? std::string() : cursor[0]);
+                req.push_back(std::string());
+                req.push_back(common::convertToString(LOAD_PAGE_SIZE));
+            }
+            else if(type == common::Value::TYPE_ZSET){
+                req.push_back("zscan");
+                req.push_back(name);
+                req.push_back(cursor.empty() ? std::string() : cursor[0]);
+                req.push_back(cursor.empty() ? std::string() : cursor[1]);
+                req.push_back(std::string());
+                req.push_back(common::convertToString(LOAD_PAGE_SIZE));
+            }
+            else{
+                int64_t begin = static_cast<int64_t>(page) * LOAD_PAGE_SIZE;
+                req.push_back("qslice");
+                req.push_back(name);
+                req.push_back(common::convertToString(begin));
+                req.push_back(common::convertToString(begin + LOAD_PAGE_SIZE - 1));
+            }
+            return req;
+        }
+
+        // hscan/zscan continue after the last pair of previous page, qslice by offset
+        page_type next_cursor(common::Value::Type type, const page_type& cursor, const page_type& items) const
+        {
+            if(type == common::Value::TYPE_ARRAY || items.size() < 2){
+                return cursor;
+            }
+
+            page_type next;
+            next.push_back(items[items.size() - 2]);
+            if(type == common::Value::TYPE_ZSET){
+                next.push_back(items[items.size() - 1]);
+            }
+            return next;
+        }
+
+        common::Error load_page(common::Value::Type type, const std::string& name, uint32_t page, std::string* cmdtext, common::ArrayValue* ret)
+        {
+            const std::string id = pageId(type, name);
+            if(page == 0){
+                pages_.remove(id);
+            }
+
+            page_type items;
+            if(pages_.find(id, page, &items)){
+                *cmdtext = page_text(type, name, page);
+            }
+            else{
+                uint32_t start = page;
+                page_type cursor;
+                if(type != common::Value::TYPE_ARRAY){
+                    while(!pages_.cursor(id, start, &cursor)){
+                        --start;
+                    }
+                }
+
+                for(uint32_t i = start; i <= page; ++i){
+                    std::vector<std::string> req = page_request(type, name, i, cursor);
+                    *cmdtext = requestText(req);
+                    LOG_COMMAND(Command(*cmdtext, common::Value::C_INNER));
+
+                    items.clear();
+                    common::Error er = list_request(req, &items);
+                    if(er){
+                        return er;
+                    }
+
+                    page_type next = next_cursor(type, cursor, items);
+                    pages_.insert(id, i, items, next);
+                    cursor = next;
+                }
+            }
+
+            for(size_t i = 0; i < items.size(); ++i){
+                ret->append(common::Value::createStringValue(items[i]));
+            }
+            return common::Error();
+        }
+
+        std::string page_text(common::Value::Type type, const std::string& name, uint32_t page) const
+        {
+            page_type cursor;
+            if(type != common::Value::TYPE_ARRAY && !pages_.cursor(pageId(type, name), page, &cursor)){
+                cursor.clear();
+            }
+            return requestText(page_request(type, name, page, cursor));
+        }
+
+        void invalidate(const NDbKValue& key)
+        {
+            pages_.remove(pageId(key.type(), key.keyString()));
+        }
+
+        common::Error list_request(const std::vector<std::string>& req, common::ArrayValue* ret)
+        {
+            std::vector<std::vector<std::string> > reqs(1, req);
+            ListReplyCollector collector(ret);
+            return pipeline(reqs, &collector);
+        }
+
+        // key names in [prefix, prefixEnd] batch by batch, matched on the client
+        common::Error search(const KeysFilter& filter, uint64_t limit, std::vector<NDbKValue>* ret)
+        {
+            const std::string end = filter.prefixEnd();
+            std::string start = rangeStart(filter.prefix());
+            std::vector<std::string> found;
+            while(found.size() < limit){
+                std::vector<std::string> batch;
+                common::Error er = keys(start, end, KEYS_SEARCH_BATCH, &batch);
+                if(er){
+                    return er;
+                }
+
+                if(batch.empty()){
+                    break;
+                }
+
+                const bool last = batch.size() < KEYS_SEARCH_BATCH;
+                start = batch.back();
+                filter.collect(&batch, limit, &found);
+                if(last){
+                    break;
+                }
+            }
+
+            for(size_t i = 0; i < found.size(); ++i){
+                NValue val(common::Value::createEmptyValueFromType(common::Value::TYPE_STRING));
+                ret->push_back(NDbKValue(NKey(found[i]), val));
+            }
+            return common::Error();
+        }
+
+        // scan answers with keys and values together, the cursor is the last key (exclusive start)
+        common::Error scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                 std::vector<std::string>* keys, std::vector<std::string>* values, std::string* next)
+        {
+            const std::string start = cursor.empty() ? rangeStart(filter.prefix()) : cursor;
+            std::vector<std::string> kvs;
+            common::Error er = scan(start, filter.prefixEnd(), count, &kvs);
+            if(er){
+                return er;
+            }
+
+            for(size_t i = 0; i + 1 < kvs.size(); i += 2){
+                keys->push_back(kvs[i]);
+                values->push_back(kvs[i + 1]);
+            }
+            *next = keys->size() == count ? keys->back() : std::string();
+            return common::Error();
+        }
+
+        common::Error scan_values(const std::string &key_start, const std::string &key_end, uint64_t limit, std::vector<NDbKValue> *ret)
+        {
+            std::vector<std::string> req;
+            req.push_back("scan");
+            req.push_back(key_start);
+            req.push_back(key_end);
+            req.push_back(common::convertToString(limit));
+
+            std::vector<std::vector<std::string> > reqs(1, req);
+            KeyValueReplyCollector collector(ret);
+            return pipeline(reqs, &collector);
+        }
+
+    private:
+        common::Error multi_size(const std::string& cmd, const std::vector<std::string>& names, std::vector<int64_t>* ret)
+        {
+            std::vector<std::vector<std::string> > reqs;
+            reqs.reserve(names.size());
+            for(size_t i = 0; i < names.size(); ++i){
+                std::vector<std::string> req;
+                req.push_back(cmd);
+                req.push_back(names[i]);
+                reqs.push_back(req);
+            }
+
+            ret->assign(names.size(), 0);
+            SizeReplyCollector collector(ret);
+            return pipeline(reqs, &collector);
+        }
+
+        // splits big multi_* writes into pipelined packets of MULTI_WRITE_CHUNK_PAIRS pairs
+        common::Error multi_write(const std::string& cmd, const std::string* name, const std::vector<std::string>& pairs)
+        {
+            std::vector<std::vector<std::string> > reqs;
+            for(size_t i = 0; i < pairs.size(); i += MULTI_WRITE_CHUNK_PAIRS * 2){
+                size_t end = std::min<size_t>(i + MULTI_WRITE_CHUNK_PAIRS * 2, pairs.size());
+                std::vector<std::string> req;
+                req.reserve(end - i + 2);
+                req.push_back(cmd);
+                if(name){
+                    req.push_back(*name);
+                }
+                req.insert(req.end(), pairs.begin() + i, pairs.begin() + end);
+                reqs.push_back(req);
+            }
+
+            ReplyCollector collector;
+            return pipeline(reqs, &collector);
+        }
+
         /******************** hash *************************/
 
         common::Error hget(const std::string& name, const std::string& key, std::string *val)
@@ -1407,6 +2130,7 @@ namespace fastonosql
         }
 
         ssdb::Client* ssdb_;
+        PagesCache pages_;
     };
 
     SsdbDriver::SsdbDriver(IConnectionSettingsBaseSPtr settings)
@@ -1435,7 +2159,19 @@ namespace fastonosql
     {
         char patternResult[1024] = {0};
         NDbKValue key = command->key();
-        common::SNPrintf(patternResult, sizeof(patternResult), DELETE_KEY_PATTERN_1ARGS_S, key.keyString());
+        common::Value::Type t = key.type();
+        if(t == common::Value::TYPE_HASH){
+            common::SNPrintf(patternResult, sizeof(patternResult), DELETE_KEY_HASH_PATTERN_1ARGS_S, key.keyString());
+        }
+        else if(t == common::Value::TYPE_ZSET){
+            common::SNPrintf(patternResult, sizeof(patternResult), DELETE_KEY_ZSET_PATTERN_1ARGS_S, key.keyString());
+        }
+        else if(t == common::Value::TYPE_ARRAY){
+            common::SNPrintf(patternResult, sizeof(patternResult), DELETE_KEY_QUEUE_PATTERN_1ARGS_S, key.keyString());
+        }
+        else{
+            common::SNPrintf(patternResult, sizeof(patternResult), DELETE_KEY_PATTERN_1ARGS_S, key.keyString());
+        }
         cmdstring = patternResult;
 
         return common::Error();
@@ -1558,7 +2294,7 @@ namespace fastonosql
         er = execute(cmd);
 
         if(!er){
-            FastoObject::child_container_type ch = root->childrens();
+            const FastoObject::child_container_type& ch = root->childrens();
             if(ch.size()){
                 //*dinfo = makeOwnRedisDiscoveryInfo(ch[0]);
             }
@@ -1585,6 +2321,17 @@ namespace fastonosql
         return common::Error();
     }
 
+    common::Error SsdbDriver::scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                         std::vector<std::string>* keys, std::vector<std::string>* values, std::string* next)
+    {
+        return impl_->scanValues(filter, cursor, count, keys, values, next);
+    }
+
+    common::Error SsdbDriver::createBenchmarkClient(BenchmarkClient** client)
+    {
+        return impl_->createBenchmarkClient(client);
+    }
+
     void SsdbDriver::handleConnectEvent(events::ConnectRequestEvent *ev)
     {
         QObject *sender = ev->sender();
@@ -1636,7 +2383,7 @@ namespace fastonosql
                 FastoObjectIPtr outRoot = lock.root_;
                 double step = 100.0f/length;
                 for(size_t n = 0; n < length; ++n){
-                    if(interrupt_){
+                    if(interrupt_.loadAcquire()){
                         er.reset(new common::ErrorValue("Interrupted exec.", common::ErrorValue::E_INTERRUPTED));
                         res.setErrorInfo(er);
                         break;
@@ -1675,6 +2422,57 @@ namespace fastonosql
         QObject *sender = ev->sender();
         notifyProgress(sender, 0);
             events::CommandResponceEvent::value_type res(ev->value());
+            CommandLoadKey* loadc = dynamic_cast<CommandLoadKey*>(res.cmd_.get());
+            if(loadc && isPagedType(loadc->key().type())){
+                const NDbKValue key = loadc->key();
+                const bool all = loadc->page() == LOAD_ALL_PAGES;
+                // hscan/zscan pages hold key, value pairs
+                const size_t page_items = key.type() == common::Value::TYPE_ARRAY ? LOAD_PAGE_SIZE : LOAD_PAGE_SIZE * 2;
+                uint32_t page = all ? 0 : loadc->page();
+        notifyProgress(sender, 25);
+                RootLocker lock = make_locker(sender, impl_->page_text(key.type(), key.keyString(), page));
+                int64_t loaded = 0;
+                while(true){
+                    if(interrupt_.loadAcquire()){
+                        common::Error er;
+                        er.reset(new common::ErrorValue("Interrupted load.", common::ErrorValue::E_INTERRUPTED));
+                        res.setErrorInfo(er);
+                        break;
+                    }
+
+                    std::string cmdtext;
+                    common::ArrayValue* ar = common::Value::createArrayValue();
+                    common::Error er = impl_->load_page(key.type(), key.keyString(), page, &cmdtext, ar);
+                    if(er){
+                        delete ar;
+                        res.setErrorInfo(er);
+                        break;
+                    }
+
+                    const size_t count = ar->size();
+                    FastoObjectCommand* cmd = createCommand<SsdbCommand>(lock.root_, cmdtext, common::Value::C_INNER);
+                    FastoObjectArray* child = new(cmd) FastoObjectArray(cmd, ar, impl_->config_.mb_delim_);
+                    cmd->addChildren(child);
+                    if(!all || count < page_items){
+                        loadc->setLastPage(count < page_items);
+                        break;
+                    }
+
+                    ++page;
+                    loaded += LOAD_PAGE_SIZE;
+                    if(key.size() > 0){
+                        notifyProgress(sender, std::min<int64_t>(99, 25 + loaded * 75 / key.size()));
+                    }
+                }
+                reply(sender, new events::CommandResponceEvent(this, res));
+                notifyProgress(sender, 100);
+                return;
+            }
+
+            if(res.cmd_ && res.cmd_->type() != CommandKey::C_LOAD){
+                impl_->invalidate(res.cmd_->key());
+            }
+
             std::string cmdtext;
             common::Error er = commandByType(res.cmd_, cmdtext);
             if(er){
@@ -1713,40 +2511,29 @@ namespace fastonosql
         notifyProgress(sender, 0);
             events::LoadDatabaseContentResponceEvent::value_type res(ev->value());
             char patternResult[1024] = {0};
-            common::SNPrintf(patternResult, sizeof(patternResult), GET_KEYS_PATTERN_1ARGS_I, res.countKeys_);
-            FastoObjectIPtr root = FastoObject::createRoot(patternResult);
+            const KeysFilter filter = res.filter();
         notifyProgress(sender, 50);
-            FastoObjectCommand* cmd = createCommand<SsdbCommand>(root, patternResult, common::Value::C_INNER);
-            common::Error er = execute(cmd);
-            if(er){
-                res.setErrorInfo(er);
+            common::Error er;
+            if(!filter.isValid()){
+                er = common::make_error_value(filter.errorString(), common::ErrorValue::E_ERROR);
+            }
+            else if(filter.isMatchAll() && !filter.hasType()){
+                common::SNPrintf(patternResult, sizeof(patternResult), GET_KEYS_PATTERN_1ARGS_I, res.countKeys_);
+                LOG_COMMAND(Command(patternResult, common::Value::C_INNER));
+                er = impl_->scan_values(std::string(), std::string(), res.countKeys_, &res.keys_);
+            }
+            else if(filter.matchType(common::Value::TYPE_STRING)){
+                common::SNPrintf(patternResult, sizeof(patternResult), SEARCH_KEYS_PATTERN_3ARGS_SSI, rangeStart(filter.prefix()), filter.prefixEnd(), res.countKeys_);
+                LOG_COMMAND(Command(patternResult, common::Value::C_INNER));
+                er = impl_->search(filter, res.countKeys_, &res.keys_);
             }
-            else{
-                FastoObject::child_container_type rchildrens = cmd->childrens();
-                if(rchildrens.size()){
-                    DCHECK(rchildrens.size() == 1);
-                    FastoObjectArray* array = dynamic_cast<FastoObjectArray*>(rchildrens[0]);
-                    if(!array){
-                        goto done;
-                    }
-                    common::ArrayValue* ar = array->array();
-                    if(!ar){
-                        goto done;
-                    }
 
-                    for(int i = 0; i < ar->size(); ++i)
-                    {
-                        std::string key;
-                        bool isok = ar->getString(i, &key);
-                        if(isok){
-                            NKey k(key);
-                            NDbKValue ress(k, NValue());
-                            res.keys_.push_back(ress);
-                        }
-                    }
-                }
+            if(!er && res.keys_.size() < res.countKeys_){
+                er = impl_->collections(filter, res.countKeys_ - res.keys_.size(), &res.keys_);
+            }
+            if(er){
+                res.setErrorInfo(er);
             }
-    done:
         notifyProgress(sender, 75);
             reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
         notifyProgress(sender, 100);
@@ -54,32 +54,31 @@ namespace fastonosql
 
     SsdbServerInfo::Common::Common(const std::string& common_text)
     {
-        const std::string &src = common_text;
-        size_t pos = 0;
-        size_t start = 0;
-
-        while((pos = src.find(("\r\n"), start)) != std::string::npos){
-            std::string line = src.substr(start, pos-start);
-            size_t delem = line.find_first_of(':');
-            std::string field = line.substr(0, delem);
-            std::string value = line.substr(delem + 1);
-            if(field == SSDB_VERSION_LABEL){
-                version_ = value;
-            }
-            else if(field == SSDB_LINKS_LABEL){
-                links_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == SSDB_TOTAL_CALLS_LABEL){
-                total_calls_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == SSDB_DBSIZE_LABEL){
-                dbsize_ = common::convertFromString<uint32_t>(value);
-            }
-            else if(field == SSDB_BINLOGS_LABEL){
-                binlogs_ = value;
-            }
-            start = pos + 2;
+        parseInfoSection(common_text, this);
+    }
+
+    bool SsdbServerInfo::Common::parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value)
+    {
+        switch(hash){
+        INFO_FIELD_CASE(field, SSDB_VERSION_LABEL)
+            value.assignTo(&version_);
+            return true;
+        INFO_FIELD_CASE(field, SSDB_LINKS_LABEL)
+            links_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, SSDB_TOTAL_CALLS_LABEL)
+            total_calls_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, SSDB_DBSIZE_LABEL)
+            dbsize_ = infoToUInt32(value);
+            return true;
+        INFO_FIELD_CASE(field, SSDB_BINLOGS_LABEL)
+            value.assignTo(&binlogs_);
+            return true;
+        default:
+            break;
         }
+        return false;
     }
 
     common::Value* SsdbServerInfo::Common::valueByIndex(unsigned char index) const
@@ -146,20 +145,9 @@ namespace fastonosql
             return NULL;
         }
 
+        // the only section, its header line is skipped by the parser
         SsdbServerInfo* result = new SsdbServerInfo;
-        const std::vector<std::string> headers = DBTraits<SSDB>::infoHeaders();
-        std::string word;
-        DCHECK(headers.size() == 1);
-
-        for(int i = 0; i < content.size(); ++i){
-            word += content[i];
-            if(word == headers[0]){
-                std::string part = content.substr(i + 1);
-                result->common_ = SsdbServerInfo::Common(part);
-                break;
-            }
-        }
-
+        parseInfoSection(content, &result->common_);
         return result;
     }
 
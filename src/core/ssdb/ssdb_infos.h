@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/types.h"
+#include "core/info_parser.h"
 
 #define SSDB_COMMON_LABEL "# Common"
 
@@ -22,6 +23,7 @@ namespace fastonosql
             Common();
             explicit Common(const std::string& common_text);
             common::Value* valueByIndex(unsigned char index) const;
+            bool parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value);
 
             std::string version_;
             uint32_t links_;
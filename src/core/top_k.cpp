@@ -0,0 +1,125 @@
+#include "core/top_k.h"
+
+#include <algorithm>
+
+namespace fastonosql
+{
+    namespace
+    {
+        bool countGreater(const TopKItem& lhs, const TopKItem& rhs)
+        {
+            return lhs.count_ > rhs.count_;
+        }
+    }
+
+    TopKItem::TopKItem()
+        : key_(), count_(0), error_(0)
+    {
+
+    }
+
+    TopKItem::TopKItem(const std::string& key, uint64_t count, uint64_t error)
+        : key_(key), count_(count), error_(error)
+    {
+
+    }
+
+    TopK::TopK(size_t capacity)
+        : capacity_(capacity ? capacity : 1), counters_(), heap_(), total_(0)
+    {
+        heap_.reserve(capacity_);
+    }
+
+    void TopK::add(const std::string& key, uint64_t count)
+    {
+        total_ += count;
+
+        counters_type::iterator it = counters_.find(key);
+        if(it != counters_.end()){
+            it->second.count_ += count;
+            siftDown(it->second.pos_);
+            return;
+        }
+
+        Counter counter = { count, 0, heap_.size() };
+        if(heap_.size() < capacity_){
+            heap_.push_back(counters_.insert(std::make_pair(key, counter)).first);
+            siftUp(counter.pos_);
+            return;
+        }
+
+        // the smallest counter is at the root and only grows
+        counter.error_ = heap_[0]->second.count_;
+        counter.count_ += counter.error_;
+        counter.pos_ = 0;
+        counters_.erase(heap_[0]);
+        heap_[0] = counters_.insert(std::make_pair(key, counter)).first;
+        siftDown(0);
+    }
+
+    void TopK::clear()
+    {
+        heap_.clear();
+        counters_.clear();
+        total_ = 0;
+    }
+
+    uint64_t TopK::total() const
+    {
+        return total_;
+    }
+
+    std::vector<TopKItem> TopK::top(size_t n) const
+    {
+        std::vector<TopKItem> res;
+        res.reserve(heap_.size());
+        for(size_t i = 0; i < heap_.size(); ++i){
+            res.push_back(TopKItem(heap_[i]->first, heap_[i]->second.count_, heap_[i]->second.error_));
+        }
+
+        n = std::min(n, res.size());
+        std::partial_sort(res.begin(), res.begin() + n, res.end(), countGreater);
+        res.resize(n);
+        return res;
+    }
+
+    void TopK::siftUp(size_t pos)
+    {
+        counters_type::iterator it = heap_[pos];
+        while(pos){
+            const size_t parent = (pos - 1) / 2;
+            if(heap_[parent]->second.count_ <= it->second.count_){
+                break;
+            }
+            place(heap_[parent], pos);
+            pos = parent;
+        }
+        place(it, pos);
+    }
+
+    void TopK::siftDown(size_t pos)
+    {
+        counters_type::iterator it = heap_[pos];
+        while(true){
+            size_t child = pos * 2 + 1;
+            if(child >= heap_.size()){
+                break;
+            }
+            if(child + 1 < heap_.size() && heap_[child + 1]->second.count_ < heap_[child]->second.count_){
+                ++child;
+            }
+            if(it->second.count_ <= heap_[child]->second.count_){
+                break;
+            }
+            place(heap_[child], pos);
+            pos = child;
+        }
+        place(it, pos);
+    }
+
+    void TopK::place(counters_type::iterator it, size_t pos)
+    {
+        heap_[pos] = it;
+        it->second.pos_ = pos;
+    }
+}
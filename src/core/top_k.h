@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace fastonosql
+{
+    struct TopKItem
+    {
+        TopKItem();
+        TopKItem(const std::string& key, uint64_t count, uint64_t error);
+
+        std::string key_;
+        uint64_t count_;
+        uint64_t error_; // count_ may overestimate the key by this much
+    };
+
+    // Space-saving counters: the most frequent keys of an unbounded stream
+    // in capacity counters. A key seen more than total / capacity times is
+    // always kept; when all counters are taken the smallest one is handed
+    // over to the new key and its count becomes the new key's error.
+    // The counters form a min-heap, so both updates cost O(log capacity).
+    class TopK
+    {
+    public:
+        explicit TopK(size_t capacity);
+
+        void add(const std::string& key, uint64_t count = 1);
+        void clear();
+
+        uint64_t total() const;
+        // n largest counters, the largest first
+        std::vector<TopKItem> top(size_t n) const;
+
+    private:
+        struct Counter
+        {
+            uint64_t count_;
+            uint64_t error_;
+            size_t pos_; // in heap_
+        };
+        typedef std::map<std::string, Counter> counters_type;
+
+        void siftUp(size_t pos);
+        void siftDown(size_t pos);
+        void place(counters_type::iterator it, size_t pos);
+
+        const size_t capacity_;
+        counters_type counters_;
+        std::vector<counters_type::iterator> heap_; // the smallest count first
+        uint64_t total_;
+    };
+}
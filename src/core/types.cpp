@@ -36,7 +36,7 @@ namespace fastonosql
     }
 
     NDbKValue::NDbKValue(const NKey& key, NValue value)
-        : key_(key), value_(value)
+        : key_(key), value_(value), size_(-1)
     {
 
     }
@@ -70,6 +70,16 @@ namespace fastonosql
         value_ = value;
     }
 
+    int64_t NDbKValue::size() const
+    {
+        return size_;
+    }
+
+    void NDbKValue::setSize(int64_t size)
+    {
+        size_ = size;
+    }
+
     std::string NDbKValue::keyString() const
     {
         return key_.key_;
@@ -298,14 +308,13 @@ namespace fastonosql
     {
         ServerPropertyInfo inf;
 
-        common::ArrayValue* ar = array->array();
-        if(ar){
-            for(int i = 0; i < ar->size(); i+=2){
+        if(array){
+            for(size_t i = 0; i + 1 < array->size(); i+=2){
                 std::string c1;
                 std::string c2;
-                bool res = ar->getString(i, &c1);
+                bool res = array->getString(i, &c1);
                 DCHECK(res);
-                res = ar->getString(i+1, &c2);
+                res = array->getString(i+1, &c2);
                 DCHECK(res);
                 inf.propertyes_.push_back(std::make_pair(c1, c2));
             }
@@ -391,10 +400,25 @@ namespace fastonosql
 
     }
 
-    CommandLoadKey::CommandLoadKey(const NDbKValue &key)
-        : CommandKey(key, C_LOAD)
+    CommandLoadKey::CommandLoadKey(const NDbKValue &key, uint32_t page)
+        : CommandKey(key, C_LOAD), page_(page), lastPage_(false)
+    {
+
+    }
+
+    uint32_t CommandLoadKey::page() const
+    {
+        return page_;
+    }
+
+    bool CommandLoadKey::isLastPage() const
     {
+        return lastPage_;
+    }
 
+    void CommandLoadKey::setLastPage(bool last)
+    {
+        lastPage_ = last;
     }
 
     CommandCreateKey::CommandCreateKey(const NDbKValue& dbv)
@@ -11,6 +11,7 @@
 #define UNDEFINED_EXAMPLE_STR "Unspecified"
 #define UNDEFINED_STR_IN_PROGRESS "Undefined in progress"
 #define INFINITE_COMMAND_ARGS UINT8_MAX
+#define LOAD_ALL_PAGES UINT32_MAX
 
 namespace fastonosql
 {
@@ -57,11 +58,16 @@ namespace fastonosql
         void setTTL(int32_t ttl);
         void setValue(NValue value);
 
+        // count of elements in collection, -1 if unknown
+        int64_t size() const;
+        void setSize(int64_t size);
+
         std::string keyString() const;
 
     private:
         NKey key_;
         NValue value_;
+        int64_t size_;
     };
 
     class ServerDiscoveryInfo
@@ -225,7 +231,16 @@ namespace fastonosql
             : public CommandKey
     {
     public:
-        explicit CommandLoadKey(const NDbKValue& key);
+        explicit CommandLoadKey(const NDbKValue& key, uint32_t page = 0);
+        uint32_t page() const;
+
+        // set by the driver when the value has no pages after the loaded one
+        bool isLastPage() const;
+        void setLastPage(bool last);
+
+    private:
+        const uint32_t page_;
+        bool lastPage_;
     };
 
     class CommandCreateKey
@@ -263,7 +278,7 @@ namespace fastonosql
         }
 
         common::CommandValue* cmd = common::Value::createCommand(input, ct);
-        FastoObjectCommand* fs = new Command(parent, cmd, parent->delemitr());
+        FastoObjectCommand* fs = new(parent) Command(parent, cmd, parent->delemitr());
         parent->addChildren(fs);
         return fs;
     }
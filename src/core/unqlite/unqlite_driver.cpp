@@ -4,11 +4,15 @@ extern "C" {
     #include <unqlite.h>
 }
 
+#include <QMutex>
+#include <QMutexLocker>
+
 #include "common/sprintf.h"
 #include "common/utils.h"
 #include "fasto/qt/logger.h"
 
 #include "core/command_logger.h"
+#include "core/benchmark.h"
 
 #include "core/unqlite/unqlite_config.h"
 #include "core/unqlite/unqlite_infos.h"
@@ -17,7 +21,8 @@ extern "C" {
 #define GET_KEY_PATTERN_1ARGS_S "GET %s"
 #define SET_KEY_PATTERN_2ARGS_SS "PUT %s %s"
 
-#define GET_KEYS_PATTERN_1ARGS_I "KEYS a z %d"
+#define SEARCH_KEYS_PATTERN_3ARGS_SSI "KEYS \"%s\" \"%s\" %d"
+#define KEYS_SEARCH_BATCH 4096
 #define DELETE_KEY_PATTERN_1ARGS_S "DEL %s"
 #define GET_SERVER_TYPE ""
 
@@ -69,6 +74,62 @@ namespace fastonosql
             unqliteConfig config = settings->info();
             return createConnection(config, context);
         }
+
+        // the handle isn't safe for concurrent use in every unqlite build,
+        // the clients take turns on it
+        class UnqliteBenchmarkClient
+                : public BenchmarkClient
+        {
+        public:
+            UnqliteBenchmarkClient(unqlite* context, QMutex* lock)
+                : context_(context), lock_(lock)
+            {
+
+            }
+
+            virtual common::Error execute(const std::vector<BenchmarkRequest>& batch, const std::string& value)
+            {
+                QMutexLocker lock(lock_);
+                for(size_t i = 0; i < batch.size(); ++i){
+                    const BenchmarkRequest& req = batch[i];
+                    int rc = UNQLITE_OK;
+                    if(req.write_){
+                        rc = unqlite_kv_store(context_, req.key_.c_str(), req.key_.size(), value.data(), req.valueSize_);
+                    }
+                    else{
+                        std::string ret;
+                        rc = unqlite_kv_fetch_callback(context_, req.key_.c_str(), req.key_.size(), getDataCallback, &ret);
+                    }
+
+                    if (rc != UNQLITE_OK && rc != UNQLITE_NOTFOUND){
+                        char buff[1024] = {0};
+                        common::SNPrintf(buff, sizeof(buff), "Benchmark error: %s", getUnqliteError(context_));
+                        return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                    }
+                }
+
+                return common::Error();
+            }
+
+            virtual common::Error remove(const std::vector<std::string>& keys)
+            {
+                QMutexLocker lock(lock_);
+                for(size_t i = 0; i < keys.size(); ++i){
+                    int rc = unqlite_kv_delete(context_, keys[i].c_str(), keys[i].size());
+                    if (rc != UNQLITE_OK && rc != UNQLITE_NOTFOUND){
+                        char buff[1024] = {0};
+                        common::SNPrintf(buff, sizeof(buff), "Benchmark error: %s", getUnqliteError(context_));
+                        return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+                    }
+                }
+
+                return common::Error();
+            }
+
+        private:
+            unqlite* const context_;
+            QMutex* const lock_;
+        };
     }
 
     common::Error testConnection(fastonosql::UnqliteConnectionSettings *settings)
@@ -87,7 +148,7 @@ namespace fastonosql
     struct UnqliteDriver::pimpl
     {
         pimpl()
-            : unqlite_(NULL)
+            : unqlite_(NULL), benchmark_lock_()
         {
 
         }
@@ -216,7 +277,7 @@ namespace fastonosql
                 common::Error er = info(argc == 2 ? argv[1] : 0, statsout);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue(UnqliteServerInfo(statsout).toString());
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -230,7 +291,7 @@ namespace fastonosql
                 common::Error er = get(argv[1], &ret);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue(ret);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -244,7 +305,7 @@ namespace fastonosql
                 common::Error er = dbsize(ret);
                 if(!er){
                     common::FundamentalValue *val = common::Value::createUIntegerValue(ret);
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -257,7 +318,7 @@ namespace fastonosql
                 common::Error er = put(argv[1], argv[2]);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("STORED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -270,7 +331,7 @@ namespace fastonosql
                 common::Error er = del(argv[1]);
                 if(!er){
                     common::StringValue *val = common::Value::createStringValue("DELETED");
-                    FastoObject* child = new FastoObject(out, val, config_.mb_delim_);
+                    FastoObject* child = new(out) FastoObject(out, val, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -288,7 +349,7 @@ namespace fastonosql
                         common::StringValue *val = common::Value::createStringValue(keysout[i]);
                         ar->append(val);
                     }
-                    FastoObjectArray* child = new FastoObjectArray(out, ar, config_.mb_delim_);
+                    FastoObjectArray* child = new(out) FastoObjectArray(out, ar, config_.mb_delim_);
                     out->addChildren(child);
                 }
                 return er;
@@ -300,6 +361,94 @@ namespace fastonosql
             }
         }
 
+        // the hash engine has no key order, every key goes through the matcher in batches
+        common::Error search(const KeysFilter& filter, uint64_t limit, std::vector<std::string>* ret)
+        {
+            ret->clear();
+
+            unqlite_kv_cursor *pCur;
+            int rc = unqlite_kv_cursor_init(unqlite_, &pCur);
+            if(rc != UNQLITE_OK){
+                char buff[1024] = {0};
+                common::SNPrintf(buff, sizeof(buff), "Keys function error: %s", getUnqliteError(unqlite_));
+                return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+            }
+
+            std::vector<std::string> batch;
+            unqlite_kv_cursor_first_entry(pCur);
+            while(unqlite_kv_cursor_valid_entry(pCur) && limit > ret->size()){
+                std::string key;
+                unqlite_kv_cursor_key_callback(pCur, getDataCallback, &key);
+                if(filter.matchPrefix(key)){
+                    batch.push_back(key);
+                    if(batch.size() == KEYS_SEARCH_BATCH){
+                        filter.collect(&batch, limit, ret);
+                    }
+                }
+
+                unqlite_kv_cursor_next_entry(pCur);
+            }
+            filter.collect(&batch, limit, ret);
+            unqlite_kv_cursor_release(unqlite_, pCur);
+
+            return common::Error();
+        }
+
+        // keys after cursor with their values, records aren't ordered so only the prefix is checked
+        common::Error scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                 std::vector<std::string>* keys, std::vector<std::string>* values, std::string* next)
+        {
+            unqlite_kv_cursor *pCur;
+            int rc = unqlite_kv_cursor_init(unqlite_, &pCur);
+            if(rc != UNQLITE_OK){
+                char buff[1024] = {0};
+                common::SNPrintf(buff, sizeof(buff), "Scan values function error: %s", getUnqliteError(unqlite_));
+                return common::make_error_value(buff, common::ErrorValue::E_ERROR);
+            }
+
+            if(cursor.empty()){
+                unqlite_kv_cursor_first_entry(pCur);
+            }
+            else if(unqlite_kv_cursor_seek(pCur, cursor.c_str(), cursor.size(), UNQLITE_CURSOR_MATCH_EXACT) == UNQLITE_OK){
+                unqlite_kv_cursor_next_entry(pCur);
+            }
+            else{
+                // the cursor key was removed meanwhile, nothing to resume from
+                unqlite_kv_cursor_release(unqlite_, pCur);
+                next->clear();
+                return common::Error();
+            }
+
+            std::string last;
+            uint32_t walked = 0;
+            while(unqlite_kv_cursor_valid_entry(pCur) && walked < count){
+                unqlite_kv_cursor_key_callback(pCur, getDataCallback, &last);
+                ++walked;
+                if(filter.matchPrefix(last)){
+                    std::string value;
+                    unqlite_kv_cursor_data_callback(pCur, getDataCallback, &value);
+                    keys->push_back(last);
+                    values->push_back(value);
+                }
+
+                unqlite_kv_cursor_next_entry(pCur);
+            }
+            *next = walked == count ? last : std::string();
+            unqlite_kv_cursor_release(unqlite_, pCur);
+
+            return common::Error();
+        }
+
+        common::Error createBenchmarkClient(BenchmarkClient** client)
+        {
+            if(!isConnected()){
+                return common::make_error_value("Not connected", common::ErrorValue::E_ERROR);
+            }
+
+            *client = new UnqliteBenchmarkClient(unqlite_, &benchmark_lock_);
+            return common::Error();
+        }
+
     private:
         common::Error get(const std::string& key, std::string* ret_val)
         {
@@ -379,6 +528,7 @@ namespace fastonosql
         }
 
         unqlite* unqlite_;
+        QMutex benchmark_lock_;
     };
 
     UnqliteDriver::UnqliteDriver(IConnectionSettingsBaseSPtr settings)
@@ -502,7 +652,7 @@ namespace fastonosql
         er = execute(cmd);
 
         if(!er){
-            FastoObject::child_container_type ch = root->childrens();
+            const FastoObject::child_container_type& ch = root->childrens();
             if(ch.size()){
                 //*dinfo = makeOwnRedisDiscoveryInfo(ch[0]);
             }
@@ -528,6 +678,17 @@ namespace fastonosql
         return common::Error();
     }
 
+    common::Error UnqliteDriver::scanValues(const KeysFilter& filter, const std::string& cursor, uint32_t count,
+                                            std::vector<std::string>* keys, std::vector<std::string>* values, std::string* next)
+    {
+        return impl_->scanValues(filter, cursor, count, keys, values, next);
+    }
+
+    common::Error UnqliteDriver::createBenchmarkClient(BenchmarkClient** client)
+    {
+        return impl_->createBenchmarkClient(client);
+    }
+
     void UnqliteDriver::handleConnectEvent(events::ConnectRequestEvent *ev)
     {
         QObject *sender = ev->sender();
@@ -578,7 +739,7 @@ namespace fastonosql
                 FastoObjectIPtr outRoot = lock.root_;
                 double step = 100.0f/length;
                 for(size_t n = 0; n < length; ++n){
-                    if(interrupt_){
+                    if(interrupt_.loadAcquire()){
                         er.reset(new common::ErrorValue("Interrupted exec.", common::ErrorValue::E_INTERRUPTED));
                         res.setErrorInfo(er);
                         break;
@@ -654,41 +815,30 @@ namespace fastonosql
         QObject *sender = ev->sender();
         notifyProgress(sender, 0);
             events::LoadDatabaseContentResponceEvent::value_type res(ev->value());
+            const KeysFilter filter = res.filter();
             char patternResult[1024] = {0};
-            common::SNPrintf(patternResult, sizeof(patternResult), GET_KEYS_PATTERN_1ARGS_I, res.countKeys_);
-            FastoObjectIPtr root = FastoObject::createRoot(patternResult);
+            common::SNPrintf(patternResult, sizeof(patternResult), SEARCH_KEYS_PATTERN_3ARGS_SSI, filter.prefix(), filter.prefixEnd(), res.countKeys_);
         notifyProgress(sender, 50);
-            FastoObjectCommand* cmd = createCommand<UnqliteCommand>(root, patternResult, common::Value::C_INNER);
-            common::Error er = execute(cmd);
+            LOG_COMMAND(Command(patternResult, common::Value::C_INNER));
+            std::vector<std::string> keys;
+            common::Error er;
+            if(!filter.isValid()){
+                er = common::make_error_value(filter.errorString(), common::ErrorValue::E_ERROR);
+            }
+            else if(filter.matchType(common::Value::TYPE_STRING)){
+                er = impl_->search(filter, res.countKeys_, &keys);
+            }
+
             if(er){
                 res.setErrorInfo(er);
             }
             else{
-                FastoObject::child_container_type rchildrens = cmd->childrens();
-                if(rchildrens.size()){
-                    DCHECK(rchildrens.size() == 1);
-                    FastoObjectArray* array = dynamic_cast<FastoObjectArray*>(rchildrens[0]);
-                    if(!array){
-                        goto done;
-                    }
-                    common::ArrayValue* ar = array->array();
-                    if(!ar){
-                        goto done;
-                    }
-
-                    for(int i = 0; i < ar->size(); ++i)
-                    {
-                        std::string key;
-                        bool isok = ar->getString(i, &key);
-                        if(isok){
-                            NKey k(key);
-                            NDbKValue ress(k, NValue());
-                            res.keys_.push_back(ress);
-                        }
-                    }
+                for(size_t i = 0; i < keys.size(); ++i){
+                    NKey k(keys[i]);
+                    NDbKValue ress(k, NValue());
+                    res.keys_.push_back(ress);
                 }
             }
-    done:
         notifyProgress(sender, 75);
             reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
         notifyProgress(sender, 100);
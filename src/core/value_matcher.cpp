@@ -0,0 +1,256 @@
+#include "core/value_matcher.h"
+
+#include <string.h>
+
+namespace fastonosql
+{
+    namespace
+    {
+        const char regexSpecials[] = ".^$|?*+()[]{}\\";
+
+        // a quantifier applies to the whole utf-8 sequence before it
+        void dropLastChar(std::string* run)
+        {
+            while(!run->empty() && (static_cast<unsigned char>((*run)[run->size() - 1]) & 0xC0) == 0x80){
+                run->resize(run->size() - 1);
+            }
+
+            if(!run->empty()){
+                run->resize(run->size() - 1);
+            }
+        }
+
+        void flushRun(std::string* run, std::string* best)
+        {
+            if(run->size() > best->size()){
+                best->swap(*run);
+            }
+            run->clear();
+        }
+
+        size_t skipClass(const std::string& pattern, size_t i)
+        {
+            ++i;
+            if(i < pattern.size() && pattern[i] == '^'){
+                ++i;
+            }
+            if(i < pattern.size() && pattern[i] == ']'){
+                ++i;
+            }
+
+            while(i < pattern.size() && pattern[i] != ']'){
+                if(pattern[i] == '\\'){
+                    ++i;
+                }
+                ++i;
+            }
+            return i;
+        }
+
+        // last character of the escape at i with its operand: \x41, \x{41},
+        // \101, \1, \cX, \pL, \p{Lu}, \k<name>, \g{-1} ...
+        size_t skipEscape(const std::string& pattern, size_t i)
+        {
+            const char e = pattern[i];
+            const size_t next = i + 1;
+            if(next >= pattern.size()){
+                return i;
+            }
+
+            const char open = pattern[next];
+            if(strchr("xogkpPN", e) && (open == '{' || open == '<' || open == '\'')){
+                const char close = open == '{' ? '}' : open == '<' ? '>' : '\'';
+                size_t end = pattern.find(close, next + 1);
+                return end == std::string::npos ? pattern.size() : end;
+            }
+
+            if(e == 'c' || e == 'p' || e == 'P'){
+                return next;
+            }
+
+            // \x takes two hex digits at most, \0 two more octal ones; backreferences
+            // and octals after \1..\9 are ambiguous, all their digits are skipped
+            const char* digits = NULL;
+            size_t count = pattern.size();
+            if(e == 'x'){
+                digits = "0123456789abcdefABCDEF";
+                count = 2;
+            }
+            else if(e == '0'){
+                digits = "01234567";
+                count = 2;
+            }
+            else if(e == 'g' || (e >= '1' && e <= '9')){
+                digits = "0123456789";
+            }
+            else{
+                return i;
+            }
+
+            size_t end = next;
+            if(e == 'g' && (pattern[end] == '-' || pattern[end] == '+')){
+                ++end;
+            }
+            while(end < pattern.size() && count && strchr(digits, pattern[end])){
+                ++end;
+                --count;
+            }
+            return end - 1;
+        }
+
+        // longest run of characters outside of groups the regex must contain,
+        // alternatives, inline options and \Q...\E quoting give up on prefiltering
+        std::string regexLiteral(const std::string& pattern)
+        {
+            if(pattern.find('|') != std::string::npos || pattern.find("(?") != std::string::npos ||
+               pattern.find("\\Q") != std::string::npos){
+                return std::string();
+            }
+
+            std::string best, run;
+            int depth = 0;
+            for(size_t i = 0; i < pattern.size(); ++i){
+                char c = pattern[i];
+                if(c == '\\' && i + 1 < pattern.size()){
+                    char e = pattern[++i];
+                    if(!depth && strchr(regexSpecials, e)){
+                        run += e;
+                    }
+                    else{
+                        // \d, \w and friends, the operands of \x41 or \1 aren't literals either
+                        flushRun(&run, &best);
+                        i = skipEscape(pattern, i);
+                    }
+                }
+                else if(c == '['){
+                    flushRun(&run, &best);
+                    i = skipClass(pattern, i);
+                }
+                else if(c == '('){
+                    flushRun(&run, &best);
+                    ++depth;
+                }
+                else if(c == ')'){
+                    flushRun(&run, &best);
+                    if(depth){
+                        --depth;
+                    }
+                }
+                else if(depth){
+                    continue;
+                }
+                else if(c == '?' || c == '*' || c == '{'){
+                    dropLastChar(&run);
+                    flushRun(&run, &best);
+                    if(c == '{'){
+                        i = pattern.find('}', i);
+                        if(i == std::string::npos){
+                            break;
+                        }
+                    }
+                }
+                else if(strchr(regexSpecials, c)){
+                    flushRun(&run, &best);
+                }
+                else{
+                    run += c;
+                }
+            }
+            flushRun(&run, &best);
+            return best;
+        }
+    }
+
+    ValueMatcher::ValueMatcher(const std::string& pattern, MatchType mtype)
+        : pattern_(pattern), mtype_(mtype), literal_(), regex_()
+    {
+        if(mtype_ == REGEX){
+            regex_.setPattern(QString::fromUtf8(pattern_.c_str(), pattern_.size()));
+            regex_.optimize();
+            literal_ = regexLiteral(pattern_);
+        }
+        else{
+            literal_ = pattern_;
+        }
+    }
+
+    std::string ValueMatcher::pattern() const
+    {
+        return pattern_;
+    }
+
+    ValueMatcher::MatchType ValueMatcher::matchType() const
+    {
+        return mtype_;
+    }
+
+    bool ValueMatcher::isEmpty() const
+    {
+        return pattern_.empty();
+    }
+
+    bool ValueMatcher::isValid() const
+    {
+        return mtype_ == SUBSTRING || regex_.isValid();
+    }
+
+    std::string ValueMatcher::errorString() const
+    {
+        if(isValid()){
+            return std::string();
+        }
+
+        return regex_.errorString().toStdString();
+    }
+
+    std::string ValueMatcher::literal() const
+    {
+        return literal_;
+    }
+
+    bool ValueMatcher::match(const char* data, size_t size) const
+    {
+        if(!literal_.empty() && !findLiteral(data, size, literal_.data(), literal_.size())){
+            return false;
+        }
+
+        if(mtype_ == SUBSTRING){
+            return true;
+        }
+
+        return regex_.match(QString::fromUtf8(data, size)).hasMatch();
+    }
+
+    bool ValueMatcher::match(const std::string& value) const
+    {
+        return match(value.data(), value.size());
+    }
+
+    // memchr jumps to the candidates, it is vectorized by every libc we build with
+    const char* findLiteral(const char* data, size_t size, const char* literal, size_t lsize)
+    {
+        if(!lsize){
+            return data;
+        }
+
+        if(lsize > size){
+            return NULL;
+        }
+
+        const char* const end = data + size - lsize + 1;
+        const char* p = data;
+        while(p < end){
+            p = static_cast<const char*>(memchr(p, literal[0], end - p));
+            if(!p){
+                return NULL;
+            }
+
+            if(memcmp(p + 1, literal + 1, lsize - 1) == 0){
+                return p;
+            }
+            ++p;
+        }
+
+        return NULL;
+    }
+}
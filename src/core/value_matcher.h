@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+
+#include <QRegularExpression>
+
+namespace fastonosql
+{
+    // Substring or regex search inside raw values. Every value is first
+    // scanned with memchr for a literal the pattern can't match without,
+    // the regex engine only runs on the values which pass.
+    class ValueMatcher
+    {
+    public:
+        enum MatchType
+        {
+            SUBSTRING = 0,
+            REGEX
+        };
+
+        explicit ValueMatcher(const std::string& pattern = std::string(), MatchType mtype = SUBSTRING);
+
+        std::string pattern() const;
+        MatchType matchType() const;
+
+        bool isEmpty() const;
+        bool isValid() const;
+        std::string errorString() const;
+
+        // bytes every matching value contains, empty if nothing is known
+        std::string literal() const;
+
+        bool match(const char* data, size_t size) const;
+        bool match(const std::string& value) const;
+
+    private:
+        std::string pattern_;
+        MatchType mtype_;
+        std::string literal_;
+        QRegularExpression regex_;
+    };
+
+    const char* findLiteral(const char* data, size_t size, const char* literal, size_t lsize);
+}
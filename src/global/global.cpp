@@ -1,59 +1,339 @@
 #include "global/global.h"
 
+#include <algorithm>
+#include <string.h>
+
+#include <QMutex>
+
 #include "common/string_util.h"
+#include "common/sprintf.h"
 
 namespace fastonosql
 {
+    namespace
+    {
+        // small trees stay small, big replies quickly reach the max block
+        const size_t arena_first_block_size = 4 * 1024;
+        const size_t arena_block_size = 64 * 1024;
+        // keeps nodes and ranges aligned for any member
+        const size_t node_alignment = 16;
+
+        const std::string emptyDelemitr;
+
+        // views read values on the gui thread while setValue swaps them
+        QMutex valueLock;
+
+        size_t alignedSize(size_t size)
+        {
+            return (size + node_alignment - 1) & ~(node_alignment - 1);
+        }
+
+        const std::string& nullString()
+        {
+            static const std::string nil = common::scoped_ptr<common::Value>(common::Value::createNullValue())->toString();
+            return nil;
+        }
+
+        FastoInlineValue makeInline(FastoObjectArena* arena, common::Value::Type type, const char* data, size_t size)
+        {
+            FastoInlineValue result;
+            result.type_ = type;
+            result.size_ = static_cast<uint32_t>(size);
+            result.string_ = size ? arena->copy(data, size) : NULL;
+            return result;
+        }
+
+        FastoInlineValue makeInline(long long integer)
+        {
+            FastoInlineValue result;
+            result.type_ = common::Value::TYPE_INTEGER;
+            result.size_ = 0;
+            result.integer_ = integer;
+            return result;
+        }
+
+        std::string inlineToString(const FastoInlineValue& value)
+        {
+            if(value.type_ == common::Value::TYPE_INTEGER){
+                char buff[32] = {0};
+                common::SNPrintf(buff, sizeof(buff), "%lld", value.integer_);
+                return buff;
+            }
+
+            if(value.type_ == common::Value::TYPE_NULL){
+                return nullString();
+            }
+
+            return std::string(value.string_ ? value.string_ : "", value.size_);
+        }
+    }
+
+    FastoObjectArena::FastoObjectArena()
+        : blocks_(), pos_(NULL), left_(0), next_block_size_(arena_first_block_size), strings_(), valued_()
+    {
+
+    }
+
+    FastoObjectArena::~FastoObjectArena()
+    {
+        for(size_t i = 0; i < valued_.size(); ++i){
+            delete valued_[i]->value_;
+        }
+
+        for(size_t i = 0; i < strings_.size(); ++i){
+            delete strings_[i];
+        }
+
+        for(size_t i = 0; i < blocks_.size(); ++i){
+            delete [] blocks_[i];
+        }
+    }
+
+    char* FastoObjectArena::bump(size_t size)
+    {
+        if(size > arena_block_size / 4){
+            // big ranges and strings get their own block, the current one stays in use
+            char* block = new char[size];
+            blocks_.push_back(block);
+            return block;
+        }
+
+        if(size > left_){
+            left_ = std::max(next_block_size_, size);
+            pos_ = new char[left_];
+            blocks_.push_back(pos_);
+            next_block_size_ = std::min(next_block_size_ * 2, arena_block_size);
+        }
+
+        char* result = pos_;
+        pos_ += size;
+        left_ -= size;
+        return result;
+    }
+
+    void* FastoObjectArena::allocate(size_t size)
+    {
+        // strings leave pos_ unaligned
+        const size_t skip = alignedSize(reinterpret_cast<size_t>(pos_)) - reinterpret_cast<size_t>(pos_);
+        if(skip <= left_){
+            pos_ += skip;
+            left_ -= skip;
+        }
+        else{
+            left_ = 0;
+        }
+
+        return bump(alignedSize(size));
+    }
+
+    const char* FastoObjectArena::copy(const char* data, size_t size)
+    {
+        char* result = bump(size);
+        memcpy(result, data, size);
+        return result;
+    }
+
+    const std::string* FastoObjectArena::intern(const std::string& str)
+    {
+        for(size_t i = 0; i < strings_.size(); ++i){
+            if(*strings_[i] == str){
+                return strings_[i];
+            }
+        }
+
+        strings_.push_back(new std::string(str));
+        return strings_.back();
+    }
+
+    void FastoObjectArena::track(FastoObject* node)
+    {
+        valued_.push_back(node);
+    }
+
+    FastoObject::child_container_type::child_container_type()
+        : items_(NULL), size_(0), capacity_(0)
+    {
+
+    }
+
+    size_t FastoObject::child_container_type::size() const
+    {
+        return size_;
+    }
+
+    bool FastoObject::child_container_type::empty() const
+    {
+        return size_ == 0;
+    }
+
+    FastoObject* FastoObject::child_container_type::operator[](size_t index) const
+    {
+        DCHECK(index < size_);
+        return items_[index];
+    }
+
+    FastoObject::child_container_type::const_iterator FastoObject::child_container_type::begin() const
+    {
+        return items_;
+    }
+
+    FastoObject::child_container_type::const_iterator FastoObject::child_container_type::end() const
+    {
+        return items_ + size_;
+    }
+
     FastoObject::FastoObject(FastoObject* parent, common::Value* val, const std::string& delemitr)
-        : observer_(NULL), value_(val), parent_(parent), childrens_(), delemitr_(delemitr)
+        : observer_(NULL), value_(val), scalar_(), arena_(parent ? parent->arena_ : new FastoObjectArena),
+          parent_(parent), childrens_(), delemitr_(&emptyDelemitr)
     {
         DCHECK(val);
+        init(delemitr);
     }
 
-    FastoObject::~FastoObject()
+    FastoObject::FastoObject(FastoObject* parent, common::Value::Type type, const char* data, size_t size, const std::string& delemitr)
+        : observer_(NULL), value_(NULL), scalar_(), arena_(parent ? parent->arena_ : new FastoObjectArena),
+          parent_(parent), childrens_(), delemitr_(&emptyDelemitr)
+    {
+        scalar_ = makeInline(arena_, type, data, size);
+        init(delemitr);
+    }
+
+    FastoObject::FastoObject(FastoObject* parent, long long integer, const std::string& delemitr)
+        : observer_(NULL), value_(NULL), scalar_(makeInline(integer)), arena_(parent ? parent->arena_ : new FastoObjectArena),
+          parent_(parent), childrens_(), delemitr_(&emptyDelemitr)
+    {
+        init(delemitr);
+    }
+
+    void FastoObject::init(const std::string& delemitr)
     {
-        for(int i = 0; i < childrens_.size(); ++i){
-            FastoObject* item = childrens_[i];
-            delete item;
+        if(parent_ && value_){
+            arena_->track(this);
+        }
+
+        if(delemitr.empty()){
+            return;
+        }
+
+        if(parent_ && parent_->delemitr() == delemitr){
+            delemitr_ = parent_->delemitr_;
+        }
+        else{
+            delemitr_ = arena_->intern(delemitr);
         }
-        childrens_.clear();
+    }
+
+    FastoObject::~FastoObject()
+    {
+        // only roots are destroyed, the rest of the tree goes with the arena
+        DCHECK(!parent_);
+        delete value_;
+        delete arena_;
+    }
+
+    void* FastoObject::operator new(size_t size)
+    {
+        return ::operator new(size);
+    }
+
+    void* FastoObject::operator new(size_t size, FastoObject* parent)
+    {
+        DCHECK(parent);
+        return parent->arena_->allocate(size);
+    }
+
+    void FastoObject::operator delete(void* ptr)
+    {
+        ::operator delete(ptr);
+    }
+
+    void FastoObject::operator delete(void* ptr, FastoObject* parent)
+    {
+        UNUSED(ptr);
+        UNUSED(parent);
     }
 
     common::Value::Type FastoObject::type() const
     {
-        if(!value_){
-            return common::Value::TYPE_NULL;
+        QMutexLocker lock(&valueLock);
+        if(value_){
+            return value_->type();
         }
 
-        return value_->type();
+        return scalar_.type_;
+    }
+
+    std::string FastoObject::valueString(const std::string& delemitr) const
+    {
+        QMutexLocker lock(&valueLock);
+        if(value_){
+            return convertToString(value_, delemitr);
+        }
+
+        return inlineToString(scalar_);
     }
 
     std::string FastoObject::toString() const
     {
-        return convertToString(value_.get(), delemitr());
+        return valueString(delemitr());
+    }
+
+    bool FastoObject::getAsInteger(int* out) const
+    {
+        if(value_){
+            return value_->getAsInteger(out);
+        }
+
+        if(scalar_.type_ != common::Value::TYPE_INTEGER){
+            return false;
+        }
+
+        *out = static_cast<int>(scalar_.integer_);
+        return true;
     }
 
     FastoObject* FastoObject::createRoot(const std::string &text, IFastoObjectObserver* observer)
     {
-        FastoObject* root =  new FastoObject(NULL, common::Value::createStringValue(text), std::string());
+        FastoObject* root = new FastoObject(NULL, common::Value::createStringValue(text), std::string());
         root->observer_ = observer;
         return root;
     }
 
-    FastoObject::child_container_type FastoObject::childrens() const
+    const FastoObject::child_container_type& FastoObject::childrens() const
     {
         return childrens_;
     }
 
     void FastoObject::addChildren(FastoObject* child)
     {
-        if(child){
-            DCHECK(child->parent_ == this);
-            childrens_.push_back(child);
-            if(observer_){
-                observer_->addedChildren(child);
-                child->observer_ = observer_;
+        if(!child){
+            return;
+        }
+
+        DCHECK(child->parent_ == this);
+        if(childrens_.size_ == childrens_.capacity_){
+            const uint32_t capacity = childrens_.capacity_ ? childrens_.capacity_ * 2 : 4;
+            FastoObject** items = static_cast<FastoObject**>(arena_->allocate(capacity * sizeof(FastoObject*)));
+            if(childrens_.size_){
+                memcpy(items, childrens_.items_, childrens_.size_ * sizeof(FastoObject*));
             }
+            childrens_.items_ = items;
+            childrens_.capacity_ = capacity;
+        }
+
+        childrens_.items_[childrens_.size_++] = child;
+        if(observer_){
+            child->attached(observer_);
+        }
+    }
+
+    void FastoObject::attached(IFastoObjectObserver* observer)
+    {
+        // children added before this node was attached are reported after it
+        observer->addedChildren(this);
+        observer_ = observer;
+        for(uint32_t i = 0; i < childrens_.size_; ++i){
+            childrens_.items_[i]->attached(observer);
         }
     }
 
@@ -62,30 +342,44 @@ namespace fastonosql
         return parent_;
     }
 
-    void FastoObject::clear()
+    const std::string& FastoObject::delemitr() const
     {
-        for (child_container_type::const_iterator it = childrens_.begin(); it != childrens_.end(); ++it){
-            FastoObject* child = (*it);
-            delete child;
-        }
-        childrens_.clear();
+        return *delemitr_;
     }
 
-    std::string FastoObject::delemitr() const
+    FastoObjectArena* FastoObject::arena() const
     {
-        return delemitr_;
+        return arena_;
     }
 
     common::Value* FastoObject::value() const
     {
-        return value_.get();
+        return value_;
     }
 
     void FastoObject::setValue(common::Value* val)
     {
-        value_.reset(val);
+        DCHECK(val);
+        if(!val){
+            return;
+        }
+
+        common::Value* old = NULL;
+        {
+            QMutexLocker lock(&valueLock);
+            old = value_;
+            value_ = val;
+        }
+
+        if(old){
+            delete old;
+        }
+        else if(parent_){
+            arena_->track(this);
+        }
+
         if(observer_){
-            observer_->updated(this, val);
+            observer_->updated(this);
         }
     }
 
@@ -102,11 +396,12 @@ namespace fastonosql
 
     common::CommandValue* FastoObjectCommand::cmd() const
     {
-        return dynamic_cast<common::CommandValue*>(value_.get());
+        return dynamic_cast<common::CommandValue*>(value_);
     }
 
-    std::string FastoObjectCommand::toString() const
+    std::string FastoObjectCommand::valueString(const std::string& delemitr) const
     {
+        UNUSED(delemitr);
         return std::string();
     }
 
@@ -200,32 +495,276 @@ namespace fastonosql
         return input;
     }
 
-    FastoObjectArray::FastoObjectArray(FastoObject* parent, common::ArrayValue* ar, const std::string& delemitr)
-        : FastoObject(parent, ar, delemitr)
+    FastoObjectArray::FastoObjectArray(FastoObject* parent, const std::string& delemitr)
+        : FastoObject(parent, common::Value::TYPE_ARRAY, NULL, 0, delemitr), elements_(NULL), size_(0), capacity_(0)
     {
 
     }
 
-    void FastoObjectArray::append(common::Value* in_value)
+    FastoObjectArray::FastoObjectArray(FastoObject* parent, common::ArrayValue* ar, const std::string& delemitr)
+        : FastoObject(parent, common::Value::TYPE_ARRAY, NULL, 0, delemitr), elements_(NULL), size_(0), capacity_(0)
     {
-        common::ArrayValue* ar = dynamic_cast<common::ArrayValue*>(value_.get());
+        DCHECK(ar);
         if(!ar){
-            NOTREACHED();
             return;
         }
 
-        ar->append(in_value);
+        reserve(ar->size());
+        for(common::ArrayValue::const_iterator it = ar->begin(); it != ar->end(); ++it){
+            common::Value* val = *it;
+            const common::Value::Type type = val->type();
+            int integer = 0;
+            if(type == common::Value::TYPE_INTEGER && val->getAsInteger(&integer)){
+                appendInteger(integer);
+            }
+            else if(type == common::Value::TYPE_NULL){
+                append(type, NULL, 0);
+            }
+            else{
+                const std::string str = val->toString();
+                append(type, str.c_str(), str.size());
+            }
+        }
+        delete ar;
+    }
+
+    void FastoObjectArray::reserve(size_t size)
+    {
+        if(size <= capacity_){
+            return;
+        }
+
+        FastoInlineValue* elements = static_cast<FastoInlineValue*>(arena_->allocate(size * sizeof(FastoInlineValue)));
+        if(size_){
+            memcpy(elements, elements_, size_ * sizeof(FastoInlineValue));
+        }
+        elements_ = elements;
+        capacity_ = size;
     }
 
-    std::string FastoObjectArray::toString() const
+    FastoInlineValue* FastoObjectArray::push()
     {
-        common::ArrayValue* ar = array();
-        return convertToString(ar, delemitr());
+        if(size_ == capacity_){
+            reserve(capacity_ ? capacity_ * 2 : 4);
+        }
+
+        return &elements_[size_++];
+    }
+
+    void FastoObjectArray::append(common::Value::Type type, const char* data, size_t size)
+    {
+        *push() = makeInline(arena_, type, data, size);
     }
 
-    common::ArrayValue* FastoObjectArray::array() const
+    void FastoObjectArray::appendInteger(long long integer)
     {
-        return dynamic_cast<common::ArrayValue*>(value_.get());
+        *push() = makeInline(integer);
+    }
+
+    std::string FastoObjectArray::valueString(const std::string& delemitr) const
+    {
+        std::string result;
+        for(size_t i = 0; i < size_; ++i){
+            std::string val = inlineToString(elements_[i]);
+            if(val.empty()){
+                continue;
+            }
+
+            result += val;
+            if(i != size_ - 1){
+                result += delemitr;
+            }
+        }
+        return result;
+    }
+
+    size_t FastoObjectArray::size() const
+    {
+        return size_;
+    }
+
+    common::Value::Type FastoObjectArray::elementType(size_t index) const
+    {
+        DCHECK(index < size_);
+        return elements_[index].type_;
+    }
+
+    bool FastoObjectArray::getString(size_t index, std::string* out) const
+    {
+        if(index >= size_ || elements_[index].type_ != common::Value::TYPE_STRING){
+            return false;
+        }
+
+        *out = inlineToString(elements_[index]);
+        return true;
+    }
+
+    std::string FastoObjectArray::elementToString(size_t index) const
+    {
+        if(index >= size_){
+            return std::string();
+        }
+
+        return inlineToString(elements_[index]);
+    }
+
+    std::string typeToString(common::Value::Type type)
+    {
+        if(type == TYPE_STREAM){
+            return "stream";
+        }
+
+        return common::Value::toString(type);
+    }
+
+    common::Value* createEmptyValueFromType(common::Value::Type type)
+    {
+        if(type == TYPE_STREAM){
+            return new StreamValue;
+        }
+
+        return common::Value::createEmptyValueFromType(type);
+    }
+
+    StreamValue::StreamValue()
+        : common::Value(TYPE_STREAM)
+    {
+
+    }
+
+    StreamValue::~StreamValue()
+    {
+
+    }
+
+    void StreamValue::reserve(size_t entries)
+    {
+        ids_ends_.reserve(entries);
+        fields_ends_.reserve(entries);
+    }
+
+    void StreamValue::appendEntry(const char* id, size_t len)
+    {
+        ids_.append(id, len);
+        ids_ends_.push_back(ids_.size());
+        fields_ends_.push_back(fields_.size());
+    }
+
+    void StreamValue::appendField(const char* field, size_t flen, const char* value, size_t vlen)
+    {
+        DCHECK(!fields_ends_.empty());
+        if(fields_ends_.empty()){
+            return;
+        }
+
+        const std::string name(field, flen);
+        std::map<std::string, uint32_t>::const_iterator it = names_index_.find(name);
+        uint32_t ref = 0;
+        if(it == names_index_.end()){
+            ref = names_.size();
+            names_.push_back(name);
+            names_index_[name] = ref;
+        }
+        else{
+            ref = it->second;
+        }
+
+        fields_.push_back(ref);
+        fields_ends_.back() = fields_.size();
+        values_.append(value, vlen);
+        values_ends_.push_back(values_.size());
+    }
+
+    size_t StreamValue::size() const
+    {
+        return ids_ends_.size();
+    }
+
+    std::string StreamValue::id(size_t index) const
+    {
+        if(index >= ids_ends_.size()){
+            return std::string();
+        }
+
+        const uint32_t begin = index ? ids_ends_[index - 1] : 0;
+        return ids_.substr(begin, ids_ends_[index] - begin);
+    }
+
+    std::string StreamValue::lastId() const
+    {
+        if(ids_ends_.empty()){
+            return std::string();
+        }
+
+        return id(ids_ends_.size() - 1);
+    }
+
+    size_t StreamValue::firstField(size_t index) const
+    {
+        return index ? fields_ends_[index - 1] : 0;
+    }
+
+    size_t StreamValue::fieldsCount(size_t index) const
+    {
+        if(index >= fields_ends_.size()){
+            return 0;
+        }
+
+        return fields_ends_[index] - firstField(index);
+    }
+
+    std::string StreamValue::field(size_t index, size_t pos) const
+    {
+        if(pos >= fieldsCount(index)){
+            return std::string();
+        }
+
+        return names_[fields_[firstField(index) + pos]];
+    }
+
+    std::string StreamValue::value(size_t index, size_t pos) const
+    {
+        if(pos >= fieldsCount(index)){
+            return std::string();
+        }
+
+        const size_t i = firstField(index) + pos;
+        const uint32_t begin = i ? values_ends_[i - 1] : 0;
+        return values_.substr(begin, values_ends_[i] - begin);
+    }
+
+    std::string StreamValue::entryToString(size_t index, const std::string& delemitr) const
+    {
+        std::string result;
+        const size_t count = fieldsCount(index);
+        for(size_t i = 0; i < count; ++i){
+            result += field(index, i) + " " + value(index, i);
+            if(i != count - 1){
+                result += delemitr;
+            }
+        }
+        return result;
+    }
+
+    std::string StreamValue::toString() const
+    {
+        return common::convertToString(const_cast<StreamValue*>(this), " ");
+    }
+
+    StreamValue* StreamValue::deepCopy() const
+    {
+        return new StreamValue(*this);
+    }
+
+    bool StreamValue::equals(const Value* other) const
+    {
+        const StreamValue* stream = dynamic_cast<const StreamValue*>(other);
+        if(!stream){
+            return false;
+        }
+
+        return ids_ == stream->ids_ && ids_ends_ == stream->ids_ends_ && fields_ends_ == stream->fields_ends_ &&
+                fields_ == stream->fields_ && names_ == stream->names_ && values_ == stream->values_ && values_ends_ == stream->values_ends_;
     }
 }
 
@@ -240,7 +779,7 @@ namespace common
             if(!str.empty()){
                 result += str + obj->delemitr();
             }
-            FastoObject::child_container_type childrens = obj->childrens();
+            const FastoObject::child_container_type& childrens = obj->childrens();
             for(FastoObject::child_container_type::const_iterator it = childrens.begin(); it != childrens.end(); ++it ){
                 result += convertToString(*it);
             }
@@ -268,6 +807,9 @@ namespace common
         else if(t == common::Value::TYPE_HASH){
             return convertToString(dynamic_cast<HashValue*>(value), delemitr);
         }
+        else if(t == fastonosql::TYPE_STREAM){
+            return convertToString(dynamic_cast<fastonosql::StreamValue*>(value), delemitr);
+        }
         else{
             return value->toString();
         }
@@ -363,4 +905,20 @@ namespace common
         }
         return result;
     }
+
+    std::string convertToString(fastonosql::StreamValue* stream, const std::string& delemitr)
+    {
+        if(!stream){
+            return std::string();
+        }
+
+        std::string result;
+        for(size_t i = 0; i < stream->size(); ++i){
+            result += stream->id(i) + " " + stream->entryToString(i, " ");
+            if(i != stream->size() - 1){
+                result += delemitr;
+            }
+        }
+        return result;
+    }
 }
@@ -1,44 +1,131 @@
 #pragma once
 
+#include <map>
+
 #include "common/value.h"
 #include "common/convert2string.h"
 
 namespace fastonosql
 {
     class IFastoObjectObserver;
+    class FastoObject;
+
+    // Bump allocator holding every node, child range and inline string of one
+    // result tree, the blocks are released together with the root.
+    class FastoObjectArena
+    {
+    public:
+        FastoObjectArena();
+        ~FastoObjectArena();
+
+        void* allocate(size_t size);
+        const char* copy(const char* data, size_t size);
+        // one copy of each distinct string for the whole tree
+        const std::string* intern(const std::string& str);
+        // nodes holding a heap value, the values are deleted with the arena
+        void track(FastoObject* node);
+
+    private:
+        DISALLOW_COPY_AND_ASSIGN(FastoObjectArena);
+
+        char* bump(size_t size);
+
+        std::vector<char*> blocks_;
+        char* pos_;
+        size_t left_;
+        size_t next_block_size_;
+        std::vector<std::string*> strings_;
+        std::vector<FastoObject*> valued_;
+    };
+
+    // scalar reply kept inline, strings point into the arena of the tree
+    struct FastoInlineValue
+    {
+        common::Value::Type type_;
+        uint32_t size_;
+        union
+        {
+            long long integer_;
+            const char* string_;
+        };
+    };
+
     class FastoObject
             : public common::intrusive_ptr_base<FastoObject>
     {
-	public:
-        typedef std::vector<FastoObject*> child_container_type;
+    public:
+        // contiguous range in the arena, grows by moving to a bigger one
+        class child_container_type
+        {
+        public:
+            typedef FastoObject* const* const_iterator;
+
+            child_container_type();
+
+            size_t size() const;
+            bool empty() const;
+            FastoObject* operator[](size_t index) const;
+            const_iterator begin() const;
+            const_iterator end() const;
+
+        private:
+            friend class FastoObject;
+
+            FastoObject** items_;
+            uint32_t size_;
+            uint32_t capacity_;
+        };
+
+        // batches of new nodes passed to the views
+        typedef std::vector<FastoObject*> child_batch_type;
 
         FastoObject(FastoObject* parent, common::Value* val, const std::string& delemitr = std::string());
+        // scalar replies stored inline: strings, statuses, errors and nils
+        FastoObject(FastoObject* parent, common::Value::Type type, const char* data, size_t size, const std::string& delemitr);
+        FastoObject(FastoObject* parent, long long integer, const std::string& delemitr);
         virtual ~FastoObject();
 
+        // nodes without a parent are roots on the heap owning the arena of their
+        // tree, children must be created with new(parent); their destructors
+        // never run, everything they hold is released with the arena
+        static void* operator new(size_t size);
+        static void* operator new(size_t size, FastoObject* parent);
+        static void operator delete(void* ptr);
+        static void operator delete(void* ptr, FastoObject* parent);
+
         common::Value::Type type() const;
-        virtual std::string toString() const;
+        virtual std::string valueString(const std::string& delemitr) const;
+        std::string toString() const;
+        bool getAsInteger(int* out) const;
 
         static FastoObject* createRoot(const std::string& text, IFastoObjectObserver* observer = NULL);
 
-        child_container_type childrens() const;
+        const child_container_type& childrens() const;
         void addChildren(FastoObject* child);
         FastoObject* parent() const;
-        void clear();
-        std::string delemitr() const;
+        const std::string& delemitr() const;
+        FastoObjectArena* arena() const;
 
+        // NULL for scalars kept inline
         common::Value* value() const;
         void setValue(common::Value* val);
 
     protected:
         IFastoObjectObserver* observer_;
-        common::scoped_ptr<common::Value> value_;
+        common::Value* value_;
+        FastoInlineValue scalar_;
+        FastoObjectArena* const arena_;
 
     private:
         DISALLOW_COPY_AND_ASSIGN(FastoObject);
+        friend class FastoObjectArena;
+
+        void init(const std::string& delemitr);
+        void attached(IFastoObjectObserver* observer);
 
         FastoObject* const parent_;
-		child_container_type childrens_;
-        const std::string delemitr_;
+        child_container_type childrens_;
+        const std::string* delemitr_;
     };
 
     class FastoObjectCommand
@@ -47,7 +134,7 @@ namespace fastonosql
     public:
         virtual ~FastoObjectCommand();
         common::CommandValue* cmd() const;
-        virtual std::string toString() const;
+        virtual std::string valueString(const std::string& delemitr) const;
 
         virtual std::string inputCmd() const;
         virtual std::string inputArgs() const;
@@ -65,24 +152,89 @@ namespace fastonosql
     std::pair<std::string, std::string> getKeyValueFromLine(const std::string& input);
     std::string getFirstWordFromLine(const std::string& input);
 
+    // elements are inline values in one range of the arena, nested arrays are
+    // children; fill it before adding it to its parent, views read it unlocked
     class FastoObjectArray
             : public FastoObject
     {
     public:
+        FastoObjectArray(FastoObject* parent, const std::string& delemitr);
+        // takes the elements of ar and deletes it
         FastoObjectArray(FastoObject* parent, common::ArrayValue* ar, const std::string& delemitr);
 
-        // Appends a Value to the end of the list.
-        void append(common::Value* in_value);
+        void reserve(size_t size);
+        void append(common::Value::Type type, const char* data, size_t size);
+        void appendInteger(long long integer);
+
+        virtual std::string valueString(const std::string& delemitr) const;
+
+        size_t size() const;
+        common::Value::Type elementType(size_t index) const;
+        // strings only, as common::ArrayValue::getString
+        bool getString(size_t index, std::string* out) const;
+        std::string elementToString(size_t index) const;
+
+    private:
+        FastoInlineValue* push();
+
+        FastoInlineValue* elements_;
+        uint32_t size_;
+        uint32_t capacity_;
+    };
+
+    // Redis streams, not part of common::Value::Type; name and empty values of
+    // a type go through the functions below, which know about it
+    const common::Value::Type TYPE_STREAM = static_cast<common::Value::Type>(64);
+
+    std::string typeToString(common::Value::Type type);
+    common::Value* createEmptyValueFromType(common::Value::Type type);
+
+    // Stream entries stored column by column: ids and values in flat buffers,
+    // field names interned once per stream.
+    class StreamValue
+            : public common::Value
+    {
+    public:
+        StreamValue();
+        virtual ~StreamValue();
+
+        void reserve(size_t entries);
+        void appendEntry(const char* id, size_t len);
+        void appendField(const char* field, size_t flen, const char* value, size_t vlen);
+
+        size_t size() const;
+        std::string id(size_t index) const;
+        std::string lastId() const;
+        size_t fieldsCount(size_t index) const;
+        std::string field(size_t index, size_t pos) const;
+        std::string value(size_t index, size_t pos) const;
+        std::string entryToString(size_t index, const std::string& delemitr) const;
+
         virtual std::string toString() const;
+        virtual StreamValue* deepCopy() const;
+        virtual bool equals(const Value* other) const;
+
+    private:
+        size_t firstField(size_t index) const;
+
+        std::string ids_;
+        std::vector<uint32_t> ids_ends_;
+        std::vector<uint32_t> fields_ends_;
+
+        std::vector<std::string> names_;
+        std::map<std::string, uint32_t> names_index_;
+        std::vector<uint32_t> fields_;
 
-        common::ArrayValue* array() const;
+        std::string values_;
+        std::vector<uint32_t> values_ends_;
     };
 
     class IFastoObjectObserver
     {
     public:
         virtual void addedChildren(FastoObject* child) = 0;
-        virtual void updated(FastoObject* item, common::Value* val) = 0;
+        // the new value is read from item, views do it under the value lock
+        virtual void updated(FastoObject* item) = 0;
     };
 
     typedef common::intrusive_ptr<FastoObject> FastoObjectIPtr;
@@ -98,4 +250,5 @@ namespace common
     std::string convertToString(common::SetValue* set, const std::string& delemitr);
     std::string convertToString(common::ZSetValue* zset, const std::string& delemitr);
     std::string convertToString(common::HashValue* hash, const std::string& delemitr);
+    std::string convertToString(fastonosql::StreamValue* stream, const std::string& delemitr);
 }
@@ -0,0 +1,294 @@
+#include "gui/dashboard_table_model.h"
+
+#include <limits>
+
+#include <QPolygonF>
+
+#include "common/qt/utils_qt.h"
+#include "common/qt/convert_string.h"
+
+#include "core/iserver.h"
+
+#include "gui/gui_factory.h"
+
+#include "translations/global.h"
+
+namespace fastonosql
+{
+    namespace
+    {
+        QString bytesText(double bytes)
+        {
+            const char* units[] = { "B", "KB", "MB", "GB", "TB" };
+            size_t unit = 0;
+            while(bytes >= 1024 && unit + 1 < SIZEOFMASS(units)){
+                bytes /= 1024;
+                ++unit;
+            }
+            return QString("%1 %2").arg(bytes, 0, 'f', unit ? 1 : 0).arg(units[unit]);
+        }
+
+        double metricValue(const ServerMetrics& metrics, int col)
+        {
+            switch(col){
+            case DashboardTableItem::eOpsPerSec:
+                return metrics.opsPerSec_;
+            case DashboardTableItem::eMemory:
+                return metrics.usedMemory_;
+            case DashboardTableItem::eHitRate:
+                return metrics.hitRate_;
+            case DashboardTableItem::eClients:
+                return metrics.connectedClients_;
+            case DashboardTableItem::eReplicationLag:
+                return metrics.replicationLag_;
+            default:
+                break;
+            }
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        QString metricText(double value, int col)
+        {
+            if(!ServerMetrics::isKnown(value)){
+                return QString();
+            }
+
+            switch(col){
+            case DashboardTableItem::eMemory:
+                return bytesText(value);
+            case DashboardTableItem::eHitRate:
+                return QString("%1%").arg(value * 100, 0, 'f', 1);
+            case DashboardTableItem::eReplicationLag:
+                return QString("%1 s").arg(value);
+            default:
+                break;
+            }
+            return QString::number(value, 'f', 0);
+        }
+    }
+
+    DashboardTableItem::DashboardTableItem(IServerSPtr server)
+        : server_(server), state_(), failed_(false), last_(), metrics_(), opsHistory_()
+    {
+
+    }
+
+    DashboardTableModel::DashboardTableModel(QObject* parent)
+        : TableModel(parent)
+    {
+
+    }
+
+    DashboardTableModel::~DashboardTableModel()
+    {
+
+    }
+
+    QVariant DashboardTableModel::data(const QModelIndex& index, int role) const
+    {
+        QVariant result;
+
+        if (!index.isValid())
+            return result;
+
+        DashboardTableItem *node = common::utils_qt::item<DashboardTableItem*>(index);
+
+        if (!node)
+            return result;
+
+        int col = index.column();
+
+        if(role == Qt::DecorationRole && col == DashboardTableItem::eName){
+            return GuiFactory::instance().icon(node->server_->type());
+        }
+
+        if(role == Qt::TextColorRole && col == DashboardTableItem::eState && node->failed_){
+            return QColor(Qt::red);
+        }
+
+        if(role == Qt::TextAlignmentRole && col >= DashboardTableItem::eOpsPerSec && col < DashboardTableItem::eOpsHistory){
+            return static_cast<int>(Qt::AlignRight | Qt::AlignVCenter);
+        }
+
+        if(role == SparklineRole && col == DashboardTableItem::eOpsHistory){
+            QPolygonF line;
+            for(size_t i = 0; i < node->opsHistory_.size(); ++i){
+                line << QPointF(node->opsHistory_[i].first, node->opsHistory_[i].second);
+            }
+            return line;
+        }
+
+        if (role == Qt::DisplayRole || role == SortRole) {
+            if (col == DashboardTableItem::eName) {
+                result = node->server_->name();
+            }
+            else if (col == DashboardTableItem::eAddress) {
+                result = node->server_->address();
+            }
+            else if (col == DashboardTableItem::eState) {
+                result = node->state_;
+            }
+            else if (col == DashboardTableItem::eOpsHistory) {
+                if(role == SortRole && !node->opsHistory_.empty()){
+                    result = node->opsHistory_.back().second;
+                }
+            }
+            else {
+                double value = metricValue(node->metrics_, col);
+                if(role == SortRole){
+                    // unknown values sort below every number
+                    result = ServerMetrics::isKnown(value) ? value : -1.0;
+                }
+                else{
+                    result = metricText(value, col);
+                }
+            }
+        }
+        return result;
+    }
+
+    Qt::ItemFlags DashboardTableModel::flags(const QModelIndex& index) const
+    {
+        Qt::ItemFlags result = 0;
+        if (index.isValid()) {
+            result = Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+        }
+        return result;
+    }
+
+    QVariant DashboardTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+    {
+        using namespace translations;
+        if (role != Qt::DisplayRole)
+            return QVariant();
+
+        if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+            if (section == DashboardTableItem::eName) {
+                return trName;
+            }
+            else if (section == DashboardTableItem::eAddress) {
+                return trAddress;
+            }
+            else if (section == DashboardTableItem::eState) {
+                return trState;
+            }
+            else if (section == DashboardTableItem::eOpsPerSec) {
+                return trOpsPerSec;
+            }
+            else if (section == DashboardTableItem::eMemory) {
+                return trMemory;
+            }
+            else if (section == DashboardTableItem::eHitRate) {
+                return trHitRate;
+            }
+            else if (section == DashboardTableItem::eClients) {
+                return trClients;
+            }
+            else if (section == DashboardTableItem::eReplicationLag) {
+                return trReplicationLag;
+            }
+            else if (section == DashboardTableItem::eOpsHistory) {
+                return trHistory;
+            }
+        }
+
+        return TableModel::headerData(section, orientation, role);
+    }
+
+    int DashboardTableModel::columnCount(const QModelIndex& parent) const
+    {
+        return DashboardTableItem::eCountColumns;
+    }
+
+    void DashboardTableModel::addServer(IServerSPtr server)
+    {
+        insertItem(new DashboardTableItem(server));
+    }
+
+    void DashboardTableModel::setState(IServer* server, const QString& state, bool failed)
+    {
+        int row = findServer(server);
+        if(row == -1){
+            return;
+        }
+
+        DashboardTableItem *it = dynamic_cast<DashboardTableItem*>(data_[row]);
+        it->state_ = state;
+        it->failed_ = failed;
+        emit dataChanged(index(row, DashboardTableItem::eState), index(row, DashboardTableItem::eState));
+    }
+
+    void DashboardTableModel::addSnapShoot(IServer* server, const ServerInfoSnapShoot& shot)
+    {
+        int row = findServer(server);
+        if(row == -1 || !shot.isValid()){
+            return;
+        }
+
+        DashboardTableItem *it = dynamic_cast<DashboardTableItem*>(data_[row]);
+        if(it->last_.isValid() && shot.msec_ <= it->last_.msec_){
+            return;
+        }
+
+        it->metrics_ = makeServerMetrics(shot, it->last_);
+        it->last_ = shot;
+        if(ServerMetrics::isKnown(it->metrics_.opsPerSec_)){
+            it->opsHistory_.push_back(InfoHistoryStore::point_type(shot.msec_, it->metrics_.opsPerSec_));
+            trimHistory(it);
+        }
+        emit dataChanged(index(row, DashboardTableItem::eOpsPerSec), index(row, DashboardTableItem::eOpsHistory));
+    }
+
+    void DashboardTableModel::setOpsHistory(IServer* server, const InfoHistoryStore::points_container_type& points)
+    {
+        int row = findServer(server);
+        if(row == -1){
+            return;
+        }
+
+        DashboardTableItem *it = dynamic_cast<DashboardTableItem*>(data_[row]);
+        std::deque<InfoHistoryStore::point_type> history(points.begin(), points.end());
+        common::time64_t last = history.empty() ? 0 : history.back().first;
+        for(size_t i = 0; i < it->opsHistory_.size(); ++i){
+            if(it->opsHistory_[i].first > last){
+                history.push_back(it->opsHistory_[i]);
+            }
+        }
+        it->opsHistory_.swap(history);
+        trimHistory(it);
+        emit dataChanged(index(row, DashboardTableItem::eOpsHistory), index(row, DashboardTableItem::eOpsHistory));
+    }
+
+    void DashboardTableModel::clear()
+    {
+        beginResetModel();
+        for(int i = 0; i < data_.size(); ++i){
+            delete data_[i];
+        }
+        data_.clear();
+        endResetModel();
+    }
+
+    int DashboardTableModel::findServer(IServer* server) const
+    {
+        for(int i = 0; i < data_.size(); ++i){
+            DashboardTableItem *it = dynamic_cast<DashboardTableItem*>(data_[i]);
+            if(it->server_.get() == server){
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void DashboardTableModel::trimHistory(DashboardTableItem* item)
+    {
+        if(item->opsHistory_.empty()){
+            return;
+        }
+
+        const common::time64_t from = item->opsHistory_.back().first - DASHBOARD_HISTORY_SPAN_MSEC;
+        while(!item->opsHistory_.empty() && item->opsHistory_.front().first < from){
+            item->opsHistory_.pop_front();
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <deque>
+
+#include "fasto/qt/gui/base/table_model.h"
+
+#include "core/core_fwd.h"
+#include "core/server_metrics.h"
+
+#define DASHBOARD_HISTORY_SPAN_MSEC (60 * 60 * 1000)
+
+namespace fastonosql
+{
+    struct DashboardTableItem
+            : public fasto::qt::gui::TableItem
+    {
+        enum eColumn
+        {
+            eName = 0,
+            eAddress,
+            eState,
+            eOpsPerSec,
+            eMemory,
+            eHitRate,
+            eClients,
+            eReplicationLag,
+            eOpsHistory,
+            eCountColumns
+        };
+
+        explicit DashboardTableItem(IServerSPtr server);
+
+        IServerSPtr server_;
+        QString state_;
+        bool failed_;
+        ServerInfoSnapShoot last_;
+        ServerMetrics metrics_;
+        std::deque<InfoHistoryStore::point_type> opsHistory_;
+    };
+
+    class DashboardTableModel
+            : public fasto::qt::gui::TableModel
+    {
+        Q_OBJECT
+    public:
+        enum
+        {
+            SortRole = Qt::UserRole + 1, // raw numbers of the metric columns
+            SparklineRole // QPolygonF of the ops history
+        };
+
+        explicit DashboardTableModel(QObject* parent = 0);
+        ~DashboardTableModel();
+
+        virtual QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+        virtual Qt::ItemFlags flags(const QModelIndex& index) const;
+        virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+
+        virtual int columnCount(const QModelIndex& parent = QModelIndex()) const;
+
+        void addServer(IServerSPtr server);
+        void setState(IServer* server, const QString& state, bool failed);
+        void addSnapShoot(IServer* server, const ServerInfoSnapShoot& shot);
+        // history loaded when the dashboard opens, live samples go on top of it
+        void setOpsHistory(IServer* server, const InfoHistoryStore::points_container_type& points);
+        void clear();
+
+    private:
+        int findServer(IServer* server) const;
+        static void trimHistory(DashboardTableItem* item);
+    };
+}
@@ -0,0 +1,326 @@
+#include "gui/dialogs/benchmark_dialog.h"
+
+#include <QCheckBox>
+#include <QDialogButtonBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QGridLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTableWidget>
+#include <QVBoxLayout>
+#include <QEvent>
+
+#include "common/qt/convert_string.h"
+
+#include "core/iserver.h"
+
+#include "gui/gui_factory.h"
+
+#include "translations/global.h"
+
+#define BENCHMARK_MAX_CLIENTS 256
+#define BENCHMARK_MAX_PIPELINE 1024
+#define BENCHMARK_MAX_VALUE_SIZE (1024 * 1024)
+
+namespace
+{
+    enum
+    {
+        eResult = 0,
+        eBaseline,
+        eChange,
+        eColumnsCount
+    };
+
+    // rows of the results table, in the order of the labels in retranslateUi
+    std::vector<double> resultValues(const fastonosql::BenchmarkResult& res)
+    {
+        std::vector<double> values;
+        values.push_back(res.throughput());
+        values.push_back(res.errors_);
+
+        const fastonosql::BenchmarkLatency* lats[] = { &res.reads_, &res.writes_ };
+        for(size_t i = 0; i < SIZEOFMASS(lats); ++i){
+            values.push_back(lats[i]->count_);
+            values.push_back(lats[i]->mean_);
+            values.push_back(lats[i]->p50_);
+            values.push_back(lats[i]->p99_);
+            values.push_back(lats[i]->p999_);
+            values.push_back(lats[i]->max_);
+        }
+        return values;
+    }
+
+    QString changeText(double value, double base)
+    {
+        if(!base){
+            return QString();
+        }
+
+        const double change = (value - base) * 100.0 / base;
+        return QString("%1%2%").arg(change > 0 ? "+" : "").arg(change, 0, 'f', 1);
+    }
+}
+
+namespace fastonosql
+{
+    BenchmarkDialog::BenchmarkDialog(IServerSPtr server, QWidget* parent)
+        : QDialog(parent, Qt::WindowMinMaxButtonsHint | Qt::WindowCloseButtonHint), server_(server),
+          result_(), hasResult_(false), baseline_(), hasBaseline_(false)
+    {
+        CHECK(server_);
+        setWindowIcon(GuiFactory::instance().icon(server_->type()));
+
+        const BenchmarkConfig defaults;
+        QGridLayout* configLayout = new QGridLayout;
+        clients_ = addField(&clientsLabel_, 1, BENCHMARK_MAX_CLIENTS, defaults.clients_);
+        requests_ = addField(&requestsLabel_, 1, INT32_MAX, defaults.requests_);
+        pipeline_ = addField(&pipelineLabel_, 1, BENCHMARK_MAX_PIPELINE, defaults.pipeline_);
+        keySpace_ = addField(&keySpaceLabel_, 1, INT32_MAX, defaults.keySpace_);
+        valueMinSize_ = addField(&valueSizeLabel_, 0, BENCHMARK_MAX_VALUE_SIZE, defaults.valueMinSize_);
+        valueMaxSize_ = new QSpinBox;
+        valueMaxSize_->setRange(0, BENCHMARK_MAX_VALUE_SIZE);
+        valueMaxSize_->setValue(defaults.valueMaxSize_);
+        readPercent_ = addField(&readPercentLabel_, 0, 100, defaults.readPercent_);
+        readPercent_->setSuffix("%");
+        removeKeys_ = new QCheckBox;
+        removeKeys_->setChecked(defaults.removeKeys_);
+
+        configLayout->addWidget(clientsLabel_, 0, 0);
+        configLayout->addWidget(clients_, 0, 1);
+        configLayout->addWidget(requestsLabel_, 0, 2);
+        configLayout->addWidget(requests_, 0, 3);
+        configLayout->addWidget(pipelineLabel_, 1, 0);
+        configLayout->addWidget(pipeline_, 1, 1);
+        configLayout->addWidget(keySpaceLabel_, 1, 2);
+        configLayout->addWidget(keySpace_, 1, 3);
+        configLayout->addWidget(valueSizeLabel_, 2, 0);
+        QHBoxLayout* sizeLayout = new QHBoxLayout;
+        sizeLayout->addWidget(valueMinSize_);
+        sizeLayout->addWidget(valueMaxSize_);
+        configLayout->addLayout(sizeLayout, 2, 1);
+        configLayout->addWidget(readPercentLabel_, 2, 2);
+        configLayout->addWidget(readPercent_, 2, 3);
+        configLayout->addWidget(removeKeys_, 3, 0, 1, 4);
+
+        QHBoxLayout* buttonsLayout = new QHBoxLayout;
+        startButton_ = new QPushButton;
+        VERIFY(connect(startButton_, &QPushButton::clicked, this, &BenchmarkDialog::start));
+        stopButton_ = new QPushButton;
+        stopButton_->setEnabled(false);
+        VERIFY(connect(stopButton_, &QPushButton::clicked, this, &BenchmarkDialog::stop));
+        exportButton_ = new QPushButton;
+        exportButton_->setEnabled(false);
+        VERIFY(connect(exportButton_, &QPushButton::clicked, this, &BenchmarkDialog::exportResult));
+        baselineButton_ = new QPushButton;
+        VERIFY(connect(baselineButton_, &QPushButton::clicked, this, &BenchmarkDialog::loadBaseline));
+        buttonsLayout->addWidget(startButton_);
+        buttonsLayout->addWidget(stopButton_);
+        buttonsLayout->addStretch(1);
+        buttonsLayout->addWidget(exportButton_);
+        buttonsLayout->addWidget(baselineButton_);
+
+        statusLabel_ = new QLabel;
+        results_ = new QTableWidget(resultValues(result_).size(), eColumnsCount);
+        results_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        results_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
+        QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+        VERIFY(connect(buttonBox, &QDialogButtonBox::rejected, this, &BenchmarkDialog::reject));
+
+        QVBoxLayout* mainLayout = new QVBoxLayout;
+        mainLayout->addLayout(configLayout);
+        mainLayout->addLayout(buttonsLayout);
+        mainLayout->addWidget(statusLabel_);
+        mainLayout->addWidget(results_);
+        mainLayout->addWidget(buttonBox);
+        setLayout(mainLayout);
+        setMinimumSize(QSize(width, height));
+
+        VERIFY(connect(server.get(), &IServer::startedBenchmark, this, &BenchmarkDialog::startBenchmark));
+        VERIFY(connect(server.get(), &IServer::finishedBenchmark, this, &BenchmarkDialog::finishBenchmark));
+        retranslateUi();
+    }
+
+    QSpinBox* BenchmarkDialog::addField(QLabel** label, int min, int max, int value)
+    {
+        *label = new QLabel;
+        QSpinBox* box = new QSpinBox;
+        box->setRange(min, max);
+        box->setValue(value);
+        return box;
+    }
+
+    void BenchmarkDialog::startBenchmark(const EventsInfo::BenchmarkInfoRequest& req)
+    {
+        startButton_->setEnabled(false);
+        stopButton_->setEnabled(true);
+        statusLabel_->setText(tr("Running %1 requests...").arg(req.config_.requests_));
+    }
+
+    void BenchmarkDialog::finishBenchmark(const EventsInfo::BenchmarkInfoResponce& res)
+    {
+        startButton_->setEnabled(true);
+        stopButton_->setEnabled(false);
+
+        common::Error er = res.errorInfo();
+        if(er && er->isError()){
+            statusLabel_->setText(common::convertFromString<QString>(er->description()));
+        }
+        else{
+            statusLabel_->setText(tr("Done in %1 msec").arg(res.result_.elapsed_));
+        }
+
+        // an interrupted or failed run still shows what it measured
+        if(res.result_.reads_.count_ || res.result_.writes_.count_){
+            result_ = res.result_;
+            hasResult_ = true;
+            exportButton_->setEnabled(true);
+            updateResults();
+        }
+    }
+
+    void BenchmarkDialog::start()
+    {
+        BenchmarkConfig config;
+        config.clients_ = clients_->value();
+        config.requests_ = requests_->value();
+        config.pipeline_ = pipeline_->value();
+        config.keySpace_ = keySpace_->value();
+        config.valueMinSize_ = qMin(valueMinSize_->value(), valueMaxSize_->value());
+        config.valueMaxSize_ = qMax(valueMinSize_->value(), valueMaxSize_->value());
+        config.readPercent_ = readPercent_->value();
+        config.removeKeys_ = removeKeys_->isChecked();
+
+        DataBaseInfoSPtr db = server_->currentDatabaseInfo();
+        const QString dbname = db ? common::convertFromString<QString>(db->name()) : tr("the default database");
+        QString question = tr("The benchmark writes up to %1 keys named %2<number> to %3 on %4 (%5).")
+                .arg(config.keySpace_).arg(BENCHMARK_KEY_PREFIX).arg(dbname).arg(server_->name()).arg(server_->address());
+        if(config.removeKeys_){
+            question += " " + tr("They are removed after the run, together with any earlier values of the same names.");
+        }
+        else{
+            question += " " + tr("They are left in the database after the run.");
+        }
+        question += "\n\n" + tr("Continue?");
+
+        const QMessageBox::StandardButton answer = QMessageBox::question(this, windowTitle(), question,
+                                                                         QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
+        if(answer != QMessageBox::Yes){
+            return;
+        }
+
+        EventsInfo::BenchmarkInfoRequest req(this, config);
+        server_->benchmark(req);
+    }
+
+    void BenchmarkDialog::stop()
+    {
+        server_->stopCurrentEvent();
+    }
+
+    void BenchmarkDialog::exportResult()
+    {
+        using namespace translations;
+        QString filepath = QFileDialog::getSaveFileName(this, trExport, QString(), tr("Benchmark results (*.json)"));
+        if(filepath.isNull()){
+            return;
+        }
+
+        QFile file(filepath);
+        const std::string json = result_.toJson();
+        if(!file.open(QIODevice::WriteOnly) || file.write(json.data(), json.size()) != static_cast<qint64>(json.size())){
+            QMessageBox::critical(this, trError, tr("Couldn't write %1").arg(filepath));
+        }
+    }
+
+    // the baseline config is taken over, so the next run is comparable with it
+    void BenchmarkDialog::loadBaseline()
+    {
+        using namespace translations;
+        QString filepath = QFileDialog::getOpenFileName(this, tr("Load baseline"), QString(), tr("Benchmark results (*.json)"));
+        if(filepath.isNull()){
+            return;
+        }
+
+        QFile file(filepath);
+        BenchmarkResult baseline;
+        if(!file.open(QIODevice::ReadOnly)){
+            QMessageBox::critical(this, trError, tr("Couldn't read %1").arg(filepath));
+            return;
+        }
+
+        const QByteArray json = file.readAll();
+        if(!BenchmarkResult::fromJson(std::string(json.constData(), json.size()), &baseline)){
+            QMessageBox::critical(this, trError, tr("%1 isn't a benchmark result").arg(filepath));
+            return;
+        }
+
+        baseline_ = baseline;
+        hasBaseline_ = true;
+        clients_->setValue(baseline_.config_.clients_);
+        requests_->setValue(baseline_.config_.requests_);
+        pipeline_->setValue(baseline_.config_.pipeline_);
+        keySpace_->setValue(baseline_.config_.keySpace_);
+        valueMinSize_->setValue(baseline_.config_.valueMinSize_);
+        valueMaxSize_->setValue(baseline_.config_.valueMaxSize_);
+        readPercent_->setValue(baseline_.config_.readPercent_);
+        removeKeys_->setChecked(baseline_.config_.removeKeys_);
+        updateResults();
+    }
+
+    void BenchmarkDialog::updateResults()
+    {
+        const std::vector<double> values = resultValues(result_);
+        const std::vector<double> bases = resultValues(baseline_);
+        for(size_t i = 0; i < values.size(); ++i){
+            results_->setItem(i, eResult, new QTableWidgetItem(hasResult_ ? QString::number(values[i], 'f', 2) : QString()));
+            results_->setItem(i, eBaseline, new QTableWidgetItem(hasBaseline_ ? QString::number(bases[i], 'f', 2) : QString()));
+            results_->setItem(i, eChange, new QTableWidgetItem(hasResult_ && hasBaseline_ ? changeText(values[i], bases[i]) : QString()));
+        }
+    }
+
+    void BenchmarkDialog::changeEvent(QEvent* e)
+    {
+        if(e->type() == QEvent::LanguageChange){
+            retranslateUi();
+        }
+        QDialog::changeEvent(e);
+    }
+
+    void BenchmarkDialog::retranslateUi()
+    {
+        using namespace translations;
+        setWindowTitle(tr("%1 benchmark").arg(server_->name()));
+
+        clientsLabel_->setText(trClients);
+        requestsLabel_->setText(tr("Requests:"));
+        pipelineLabel_->setText(tr("Pipeline:"));
+        keySpaceLabel_->setText(tr("Key space:"));
+        valueSizeLabel_->setText(tr("Value size (min, max):"));
+        readPercentLabel_->setText(tr("Reads:"));
+        removeKeys_->setText(tr("Remove the benchmark keys after the run"));
+
+        startButton_->setText(tr("Start"));
+        stopButton_->setText(trStop);
+        exportButton_->setText(trExport);
+        baselineButton_->setText(tr("Load baseline..."));
+
+        QStringList columns;
+        columns << tr("Result") << tr("Baseline") << tr("Change");
+        results_->setHorizontalHeaderLabels(columns);
+
+        QStringList rows;
+        rows << tr("Requests/sec") << tr("Errors");
+        const QString kinds[] = { tr("Reads"), tr("Writes") };
+        for(size_t i = 0; i < SIZEOFMASS(kinds); ++i){
+            rows << kinds[i] << tr("%1 mean, usec").arg(kinds[i]) << tr("%1 p50, usec").arg(kinds[i])
+                 << tr("%1 p99, usec").arg(kinds[i]) << tr("%1 p99.9, usec").arg(kinds[i]) << tr("%1 max, usec").arg(kinds[i]);
+        }
+        results_->setVerticalHeaderLabels(rows);
+    }
+}
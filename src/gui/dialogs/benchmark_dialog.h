@@ -0,0 +1,75 @@
+#pragma once
+
+#include <QDialog>
+
+class QCheckBox;
+class QLabel;
+class QSpinBox;
+class QPushButton;
+class QTableWidget;
+
+#include "core/events/events_info.h"
+
+namespace fastonosql
+{
+    // Load generator against one server, the results can be exported as JSON
+    // and a previous export loaded as the baseline to compare a run with.
+    class BenchmarkDialog
+            : public QDialog
+    {
+        Q_OBJECT
+    public:
+        explicit BenchmarkDialog(IServerSPtr server, QWidget* parent = 0);
+
+        enum
+        {
+            height = 480,
+            width = 640
+        };
+
+    private Q_SLOTS:
+        void startBenchmark(const EventsInfo::BenchmarkInfoRequest& req);
+        void finishBenchmark(const EventsInfo::BenchmarkInfoResponce& res);
+
+        void start();
+        void stop();
+        void exportResult();
+        void loadBaseline();
+
+    protected:
+        virtual void changeEvent(QEvent* e);
+
+    private:
+        void retranslateUi();
+        void updateResults();
+        QSpinBox* addField(QLabel** label, int min, int max, int value);
+
+        QLabel* clientsLabel_;
+        QSpinBox* clients_;
+        QLabel* requestsLabel_;
+        QSpinBox* requests_;
+        QLabel* pipelineLabel_;
+        QSpinBox* pipeline_;
+        QLabel* keySpaceLabel_;
+        QSpinBox* keySpace_;
+        QLabel* valueSizeLabel_;
+        QSpinBox* valueMinSize_;
+        QSpinBox* valueMaxSize_;
+        QLabel* readPercentLabel_;
+        QSpinBox* readPercent_;
+        QCheckBox* removeKeys_;
+
+        QPushButton* startButton_;
+        QPushButton* stopButton_;
+        QPushButton* exportButton_;
+        QPushButton* baselineButton_;
+        QLabel* statusLabel_;
+        QTableWidget* results_;
+
+        const IServerSPtr server_;
+        BenchmarkResult result_;
+        bool hasResult_;
+        BenchmarkResult baseline_;
+        bool hasBaseline_;
+    };
+}
@@ -0,0 +1,367 @@
+#include "gui/dialogs/clients_dialog.h"
+
+#include <algorithm>
+
+#include <QColor>
+#include <QComboBox>
+#include <QDialogButtonBox>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTabWidget>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+#include <QEvent>
+
+#include "common/qt/convert_string.h"
+
+#include "core/iserver.h"
+
+#include "gui/gui_factory.h"
+
+#include "translations/global.h"
+
+#define CLIENTS_DEFAULT_INTERVAL_SEC 5
+#define CLIENTS_MAX_INTERVAL_SEC 3600
+#define CLIENTS_MAX_IDLE_SEC (7 * 24 * 60 * 60)
+#define CLIENTS_VIEW_ROWS 1000
+
+namespace
+{
+    enum
+    {
+        eGroupKey = 0,
+        eGroupCount,
+        eGroupQbuf,
+        eGroupOmem,
+        eGroupMaxIdle,
+        eGroupOutliers,
+        eGroupColumnsCount
+    };
+
+    enum
+    {
+        eClientId = 0,
+        eClientAddr,
+        eClientName,
+        eClientCommand,
+        eClientAge,
+        eClientIdle,
+        eClientQbuf,
+        eClientOmem,
+        eClientFlags,
+        eClientColumnsCount
+    };
+
+    QTableWidgetItem* numberItem(uint64_t value)
+    {
+        return new QTableWidgetItem(QString::number(value));
+    }
+
+    QTableWidgetItem* textItem(const fastonosql::InfoSlice& slice)
+    {
+        return new QTableWidgetItem(QString::fromUtf8(slice.data_, slice.size_));
+    }
+
+    bool containsText(const fastonosql::InfoSlice& slice, const QString& text)
+    {
+        return text.isEmpty() || QString::fromUtf8(slice.data_, slice.size_).contains(text, Qt::CaseInsensitive);
+    }
+
+    // the clients holding the most buffer memory come first
+    struct MoreBuffers
+    {
+        bool operator()(const fastonosql::ClientInfo* lhs, const fastonosql::ClientInfo* rhs) const
+        {
+            return lhs->qbuf_ + lhs->omem_ > rhs->qbuf_ + rhs->omem_;
+        }
+    };
+}
+
+namespace fastonosql
+{
+    ClientsDialog::ClientsDialog(IServerSPtr server, QWidget* parent)
+        : QDialog(parent, Qt::WindowMinMaxButtonsHint | Qt::WindowCloseButtonHint), server_(server), list_(), pending_(false)
+    {
+        CHECK(server_);
+        setWindowIcon(GuiFactory::instance().icon(server_->type()));
+
+        QHBoxLayout* intervalLayout = new QHBoxLayout;
+        intervalLabel_ = new QLabel;
+        interval_ = new QSpinBox;
+        interval_->setRange(1, CLIENTS_MAX_INTERVAL_SEC);
+        interval_->setValue(CLIENTS_DEFAULT_INTERVAL_SEC);
+        VERIFY(connect(interval_, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, &ClientsDialog::changeInterval));
+        statusLabel_ = new QLabel;
+        intervalLayout->addWidget(intervalLabel_);
+        intervalLayout->addWidget(interval_);
+        intervalLayout->addWidget(statusLabel_, 1);
+
+        idle_ = new QTableWidget(1, ClientListStats::IDLE_BUCKETS_COUNT);
+        idle_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        idle_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+        idle_->setMaximumHeight(idle_->horizontalHeader()->sizeHint().height() + idle_->verticalHeader()->sizeHint().height() * 2);
+
+        QWidget* groupsPage = new QWidget;
+        QVBoxLayout* groupsLayout = new QVBoxLayout;
+        QHBoxLayout* groupByLayout = new QHBoxLayout;
+        groupByLabel_ = new QLabel;
+        groupBy_ = new QComboBox;
+        groupBy_->addItem(QString(), CLIENTS_BY_HOST);
+        groupBy_->addItem(QString(), CLIENTS_BY_NAME);
+        groupBy_->addItem(QString(), CLIENTS_BY_COMMAND);
+        VERIFY(connect(groupBy_, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &ClientsDialog::updateGroups));
+        groupByLayout->addWidget(groupByLabel_);
+        groupByLayout->addWidget(groupBy_);
+        groupByLayout->addStretch(1);
+        groups_ = new QTableWidget(0, eGroupColumnsCount);
+        groups_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        groups_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+        groupsLayout->addLayout(groupByLayout);
+        groupsLayout->addWidget(groups_);
+        groupsPage->setLayout(groupsLayout);
+
+        clients_ = new QTableWidget(0, eClientColumnsCount);
+        clients_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        clients_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+        clients_->verticalHeader()->hide();
+
+        tabs_ = new QTabWidget;
+        tabs_->addTab(groupsPage, QString());
+        tabs_->addTab(clients_, QString());
+
+        QHBoxLayout* killLayout = new QHBoxLayout;
+        killLabel_ = new QLabel;
+        killHost_ = new QLineEdit;
+        killName_ = new QLineEdit;
+        killCommand_ = new QLineEdit;
+        killIdleLabel_ = new QLabel;
+        killIdle_ = new QSpinBox;
+        killIdle_->setRange(0, CLIENTS_MAX_IDLE_SEC);
+        killButton_ = new QPushButton;
+        VERIFY(connect(killButton_, &QPushButton::clicked, this, &ClientsDialog::killMatching));
+        killLayout->addWidget(killLabel_);
+        killLayout->addWidget(killHost_);
+        killLayout->addWidget(killName_);
+        killLayout->addWidget(killCommand_);
+        killLayout->addWidget(killIdleLabel_);
+        killLayout->addWidget(killIdle_);
+        killLayout->addWidget(killButton_);
+
+        QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+        VERIFY(connect(buttonBox, &QDialogButtonBox::rejected, this, &ClientsDialog::reject));
+
+        QVBoxLayout* mainLayout = new QVBoxLayout;
+        mainLayout->addLayout(intervalLayout);
+        mainLayout->addWidget(idle_);
+        mainLayout->addWidget(tabs_, 1);
+        mainLayout->addLayout(killLayout);
+        mainLayout->addWidget(buttonBox);
+        setLayout(mainLayout);
+        setMinimumSize(QSize(width, height));
+
+        pollTimer_ = new QTimer(this);
+        pollTimer_->setInterval(CLIENTS_DEFAULT_INTERVAL_SEC * 1000);
+        VERIFY(connect(pollTimer_, &QTimer::timeout, this, &ClientsDialog::poll));
+
+        VERIFY(connect(server.get(), &IServer::finishedClientList, this, &ClientsDialog::finishClientList));
+        VERIFY(connect(server.get(), &IServer::finishedClientKill, this, &ClientsDialog::finishClientKill));
+        retranslateUi();
+
+        pollTimer_->start();
+        poll();
+    }
+
+    void ClientsDialog::poll()
+    {
+        if(pending_){
+            return;
+        }
+
+        pending_ = true;
+        EventsInfo::ClientListRequest req(this);
+        server_->clientList(req);
+    }
+
+    void ClientsDialog::changeInterval(int sec)
+    {
+        pollTimer_->setInterval(sec * 1000);
+    }
+
+    void ClientsDialog::finishClientList(const EventsInfo::ClientListResponce& res)
+    {
+        if(res.initiator() != this){
+            return;
+        }
+
+        pending_ = false;
+        common::Error er = res.errorInfo();
+        if(er && er->isError()){
+            statusLabel_->setText(common::convertFromString<QString>(er->description()));
+            return;
+        }
+
+        list_ = res.list_;
+        updateGroups();
+        updateClients();
+    }
+
+    void ClientsDialog::finishClientKill(const EventsInfo::ClientKillResponce& res)
+    {
+        if(res.initiator() != this){
+            return;
+        }
+
+        killButton_->setEnabled(true);
+        statusLabel_->setText(tr("%1 of %2 clients killed").arg(res.killed_).arg(res.ids_.size()));
+    }
+
+    void ClientsDialog::updateGroups()
+    {
+        const ClientListStats stats(list_);
+        const ClientGroupBy by = static_cast<ClientGroupBy>(groupBy_->currentData().toInt());
+        const std::vector<ClientGroup> groups = stats.groups(by);
+        groups_->setRowCount(groups.size());
+        for(size_t i = 0; i < groups.size(); ++i){
+            const ClientGroup& group = groups[i];
+            groups_->setItem(i, eGroupKey, new QTableWidgetItem(common::convertFromString<QString>(group.key_)));
+            groups_->setItem(i, eGroupCount, numberItem(group.count_));
+            groups_->setItem(i, eGroupQbuf, numberItem(group.qbuf_));
+            groups_->setItem(i, eGroupOmem, numberItem(group.omem_));
+            groups_->setItem(i, eGroupMaxIdle, numberItem(group.maxIdle_));
+            groups_->setItem(i, eGroupOutliers, numberItem(group.outliers_));
+        }
+
+        const size_t* buckets = stats.idleBuckets();
+        for(int i = 0; i < ClientListStats::IDLE_BUCKETS_COUNT; ++i){
+            idle_->setItem(0, i, numberItem(buckets[i]));
+        }
+
+        statusLabel_->setText(tr("%1 clients, outliers above %2 bytes of qbuf or %3 bytes of omem")
+                              .arg(list_.clients().size()).arg(stats.qbufLimit()).arg(stats.omemLimit()));
+    }
+
+    void ClientsDialog::updateClients()
+    {
+        const ClientListStats stats(list_);
+        const std::vector<ClientInfo>& clients = list_.clients();
+        std::vector<const ClientInfo*> rows;
+        rows.reserve(clients.size());
+        for(size_t i = 0; i < clients.size(); ++i){
+            rows.push_back(&clients[i]);
+        }
+
+        const size_t count = std::min<size_t>(rows.size(), CLIENTS_VIEW_ROWS);
+        std::partial_sort(rows.begin(), rows.begin() + count, rows.end(), MoreBuffers());
+        clients_->setRowCount(count);
+        for(size_t i = 0; i < count; ++i){
+            const ClientInfo& client = *rows[i];
+            clients_->setItem(i, eClientId, numberItem(client.id_));
+            clients_->setItem(i, eClientAddr, textItem(list_.field(client.addr_)));
+            clients_->setItem(i, eClientName, textItem(list_.field(client.name_)));
+            clients_->setItem(i, eClientCommand, textItem(list_.field(client.cmd_)));
+            clients_->setItem(i, eClientAge, numberItem(client.age_));
+            clients_->setItem(i, eClientIdle, numberItem(client.idle_));
+            clients_->setItem(i, eClientQbuf, numberItem(client.qbuf_));
+            clients_->setItem(i, eClientOmem, numberItem(client.omem_));
+            clients_->setItem(i, eClientFlags, textItem(list_.field(client.flags_)));
+            if(stats.isOutlier(client)){
+                for(int j = 0; j < eClientColumnsCount; ++j){
+                    clients_->item(i, j)->setBackground(QColor(255, 200, 200));
+                }
+            }
+        }
+    }
+
+    bool ClientsDialog::matchesKillFilter(const ClientInfo& client) const
+    {
+        return client.idle_ >= static_cast<uint64_t>(killIdle_->value()) &&
+               containsText(list_.host(client), killHost_->text()) &&
+               containsText(list_.field(client.name_), killName_->text()) &&
+               containsText(list_.field(client.cmd_), killCommand_->text());
+    }
+
+    // the last polled list is matched, clients since gone are skipped by the server
+    void ClientsDialog::killMatching()
+    {
+        if(killHost_->text().isEmpty() && killName_->text().isEmpty() && killCommand_->text().isEmpty() && !killIdle_->value()){
+            return;
+        }
+
+        std::vector<uint64_t> ids;
+        const std::vector<ClientInfo>& clients = list_.clients();
+        for(size_t i = 0; i < clients.size(); ++i){
+            if(matchesKillFilter(clients[i])){
+                ids.push_back(clients[i].id_);
+            }
+        }
+
+        if(ids.empty()){
+            statusLabel_->setText(tr("No clients match"));
+            return;
+        }
+
+        int answer = QMessageBox::question(this, tr("Kill clients"), tr("Kill %1 of %2 clients?").arg(ids.size()).arg(clients.size()),
+                                           QMessageBox::Yes | QMessageBox::No, QMessageBox::No);
+        if(answer != QMessageBox::Yes){
+            return;
+        }
+
+        killButton_->setEnabled(false);
+        EventsInfo::ClientKillRequest req(this, ids);
+        server_->clientKill(req);
+    }
+
+    void ClientsDialog::changeEvent(QEvent* e)
+    {
+        if(e->type() == QEvent::LanguageChange){
+            retranslateUi();
+        }
+        QDialog::changeEvent(e);
+    }
+
+    void ClientsDialog::retranslateUi()
+    {
+        using namespace translations;
+        setWindowTitle(tr("%1 clients").arg(server_->name()));
+
+        intervalLabel_->setText(trRefreshInterval);
+        interval_->setSuffix(tr(" sec"));
+
+        QStringList idle;
+        idle << tr("Idle < 1 sec") << tr("< 10 sec") << tr("< 1 min") << tr("< 10 min") << tr("< 1 hour") << tr(">= 1 hour");
+        idle_->setHorizontalHeaderLabels(idle);
+        idle_->setVerticalHeaderLabels(QStringList() << trClients);
+
+        tabs_->setTabText(0, tr("Groups"));
+        tabs_->setTabText(1, trClients);
+
+        groupByLabel_->setText(tr("Group by:"));
+        groupBy_->setItemText(CLIENTS_BY_HOST, tr("Address"));
+        groupBy_->setItemText(CLIENTS_BY_NAME, tr("Name"));
+        groupBy_->setItemText(CLIENTS_BY_COMMAND, tr("Command"));
+
+        QStringList groups;
+        groups << QString() << trClients << tr("qbuf") << tr("omem") << tr("Max idle, sec") << tr("Outliers");
+        groups_->setHorizontalHeaderLabels(groups);
+
+        QStringList clients;
+        clients << tr("Id") << tr("Address") << tr("Name") << tr("Command") << tr("Age, sec") << tr("Idle, sec")
+                << tr("qbuf") << tr("omem") << tr("Flags");
+        clients_->setHorizontalHeaderLabels(clients);
+
+        killLabel_->setText(tr("Kill by"));
+        killHost_->setPlaceholderText(tr("Address"));
+        killName_->setPlaceholderText(tr("Name"));
+        killCommand_->setPlaceholderText(tr("Command"));
+        killIdleLabel_->setText(tr("idle at least"));
+        killIdle_->setSuffix(tr(" sec"));
+        killButton_->setText(tr("Kill..."));
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QDialog>
+
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QSpinBox;
+class QTabWidget;
+class QTableWidget;
+class QTimer;
+
+#include "core/events/events_info.h"
+
+namespace fastonosql
+{
+    // CLIENT LIST of one server polled on the monitoring connection: groups,
+    // idle times, buffer outliers, and a kill of the clients a filter matches.
+    class ClientsDialog
+            : public QDialog
+    {
+        Q_OBJECT
+    public:
+        explicit ClientsDialog(IServerSPtr server, QWidget* parent = 0);
+
+        enum
+        {
+            height = 600,
+            width = 900
+        };
+
+    private Q_SLOTS:
+        void finishClientList(const EventsInfo::ClientListResponce& res);
+        void finishClientKill(const EventsInfo::ClientKillResponce& res);
+
+        void poll();
+        void changeInterval(int sec);
+        void updateGroups();
+        void killMatching();
+
+    protected:
+        virtual void changeEvent(QEvent* e);
+
+    private:
+        void retranslateUi();
+        void updateClients();
+        bool matchesKillFilter(const ClientInfo& client) const;
+
+        QLabel* intervalLabel_;
+        QSpinBox* interval_;
+        QLabel* statusLabel_;
+        QTableWidget* idle_;
+        QLabel* groupByLabel_;
+        QComboBox* groupBy_;
+        QTabWidget* tabs_;
+        QTableWidget* groups_;
+        QTableWidget* clients_;
+
+        QLabel* killLabel_;
+        QLineEdit* killHost_;
+        QLineEdit* killName_;
+        QLineEdit* killCommand_;
+        QLabel* killIdleLabel_;
+        QSpinBox* killIdle_;
+        QPushButton* killButton_;
+        QTimer* pollTimer_;
+
+        const IServerSPtr server_;
+        ClientList list_;
+        bool pending_;
+    };
+}
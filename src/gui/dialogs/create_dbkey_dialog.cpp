@@ -38,7 +38,7 @@ namespace fastonosql
         std::vector<common::Value::Type> types = supportedTypesFromType(type);
         for(int i = 0; i < types.size(); ++i){
             common::Value::Type t = types[i];
-            QString type = common::convertFromString<QString>(common::Value::toString(t));
+            QString type = common::convertFromString<QString>(typeToString(t));
             typesCombo_->addItem(GuiFactory::instance().icon(t), type, t);
         }
 
@@ -0,0 +1,268 @@
+#include "gui/dialogs/dashboard_dialog.h"
+
+#include <QDialogButtonBox>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QSpinBox>
+#include <QEvent>
+#include <QPainter>
+#include <QSortFilterProxyModel>
+#include <QStyledItemDelegate>
+
+#include "common/qt/convert_string.h"
+#include "common/time.h"
+
+#include "core/iserver.h"
+#include "core/idriver.h"
+#include "core/servers_manager.h"
+#include "core/settings_manager.h"
+#include "core/server_metrics.h"
+
+#include "gui/dashboard_table_model.h"
+#include "gui/fasto_table_view.h"
+#include "gui/gui_factory.h"
+
+#include "translations/global.h"
+
+#define DASHBOARD_DEFAULT_INTERVAL_MSEC 1000
+#define DASHBOARD_MIN_INTERVAL_MSEC 100
+#define DASHBOARD_MAX_INTERVAL_MSEC 60000
+#define SPARKLINE_POINTS 120
+
+namespace
+{
+    // ops history of a row drawn over the cell, scaled to its own range
+    class SparklineDelegate
+            : public QStyledItemDelegate
+    {
+    public:
+        explicit SparklineDelegate(QObject *parent = 0)
+            : QStyledItemDelegate(parent)
+        {
+
+        }
+
+        void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+        {
+            QStyledItemDelegate::paint(painter, option, index);
+
+            const QPolygonF line = index.data(fastonosql::DashboardTableModel::SparklineRole).value<QPolygonF>();
+            if(line.size() < 2){
+                return;
+            }
+
+            const QRectF bounds = line.boundingRect();
+            const QRectF area = QRectF(option.rect).adjusted(2, 2, -2, -2);
+            const qreal dx = bounds.width() > 0 ? area.width() / bounds.width() : 0;
+            const qreal dy = bounds.height() > 0 ? area.height() / bounds.height() : 0;
+
+            QPolygonF points;
+            for(int i = 0; i < line.size(); ++i){
+                qreal x = area.left() + (line[i].x() - bounds.left()) * dx;
+                qreal y = dy ? area.bottom() - (line[i].y() - bounds.top()) * dy : area.center().y();
+                points << QPointF(x, y);
+            }
+
+            painter->save();
+            painter->setRenderHint(QPainter::Antialiasing);
+            painter->setPen(option.state & QStyle::State_Selected ? option.palette.highlightedText().color() : option.palette.highlight().color());
+            painter->drawPolyline(points);
+            painter->restore();
+        }
+    };
+}
+
+namespace fastonosql
+{
+    DashboardDialog::DashboardDialog(QWidget* parent)
+        : QDialog(parent, Qt::WindowMinMaxButtonsHint | Qt::WindowCloseButtonHint), servers_(), watchInterval_(DASHBOARD_DEFAULT_INTERVAL_MSEC)
+    {
+        QVBoxLayout *mainlayout = new QVBoxLayout;
+
+        QHBoxLayout* intervalLayout = new QHBoxLayout;
+        intervalLabel_ = new QLabel;
+        interval_ = new QSpinBox;
+        interval_->setRange(DASHBOARD_MIN_INTERVAL_MSEC, DASHBOARD_MAX_INTERVAL_MSEC);
+        interval_->setSingleStep(DASHBOARD_MIN_INTERVAL_MSEC);
+        interval_->setValue(watchInterval_);
+        interval_->setSuffix(" ms");
+        typedef void (QSpinBox::*valc)(int);
+        VERIFY(connect(interval_, static_cast<valc>(&QSpinBox::valueChanged), this, &DashboardDialog::changeInterval));
+        intervalLayout->addWidget(intervalLabel_);
+        intervalLayout->addWidget(interval_);
+        intervalLayout->addStretch(1);
+
+        model_ = new DashboardTableModel(this);
+        proxy_ = new QSortFilterProxyModel(this);
+        proxy_->setSourceModel(model_);
+        proxy_->setSortRole(DashboardTableModel::SortRole);
+        proxy_->setDynamicSortFilter(true);
+
+        table_ = new FastoTableView;
+        table_->setModel(proxy_);
+        table_->setSortingEnabled(true);
+        table_->sortByColumn(DashboardTableItem::eOpsPerSec, Qt::DescendingOrder);
+        table_->setItemDelegateForColumn(DashboardTableItem::eOpsHistory, new SparklineDelegate(this));
+
+        QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+        VERIFY(connect(buttonBox, &QDialogButtonBox::rejected, this, &DashboardDialog::reject));
+
+        mainlayout->addLayout(intervalLayout);
+        mainlayout->addWidget(table_);
+        mainlayout->addWidget(buttonBox);
+        setLayout(mainlayout);
+        setMinimumSize(QSize(width, height));
+
+        // every server connects and is polled on the drivers pool concurrently
+        SettingsManager::ConnectionSettingsContainerType connections = SettingsManager::instance().connections();
+        for(size_t i = 0; i < connections.size(); ++i){
+            IConnectionSettingsBaseSPtr settings = connections[i];
+            connectionTypes type = settings->connectionType();
+            if(type != REDIS && type != MEMCACHED && type != SSDB){
+                continue;
+            }
+
+            IServerSPtr server = ServersManager::instance().createServer(settings);
+            if(!server){
+                continue;
+            }
+
+            VERIFY(connect(server.get(), &IServer::finishedConnect, this, &DashboardDialog::finishConnect));
+            VERIFY(connect(server.get(), &IServer::finishedLoadServerHistoryInfo, this, &DashboardDialog::finishLoadServerHistoryInfo));
+            VERIFY(connect(server.get(), &IServer::serverInfoSnapShoot, this, &DashboardDialog::snapShotAdd));
+            servers_.push_back(server);
+            model_->addServer(server);
+            server->watchInfo(watchInterval_);
+
+            if(server->isConnected()){
+                model_->setState(server.get(), tr("Connected"), false);
+                requestOpsHistory(server);
+            }
+            else{
+                model_->setState(server.get(), translations::trTryToConnect, false);
+                EventsInfo::ConnectInfoRequest req(this);
+                server->connect(req);
+            }
+        }
+
+        retranslateUi();
+    }
+
+    DashboardDialog::~DashboardDialog()
+    {
+        for(size_t i = 0; i < servers_.size(); ++i){
+            IServerSPtr server = servers_[i];
+            server->unwatchInfo(watchInterval_);
+            ServersManager::instance().closeServer(server);
+        }
+    }
+
+    void DashboardDialog::finishConnect(const EventsInfo::ConnectInfoResponce& res)
+    {
+        IServer *serv = qobject_cast<IServer *>(sender());
+        DCHECK(serv);
+        if(!serv){
+            return;
+        }
+
+        common::Error er = res.errorInfo();
+        if(er && er->isError()){
+            model_->setState(serv, common::convertFromString<QString>(er->description()), true);
+            return;
+        }
+
+        model_->setState(serv, tr("Connected"), false);
+        for(size_t i = 0; i < servers_.size(); ++i){
+            if(servers_[i].get() == serv){
+                requestOpsHistory(servers_[i]);
+                break;
+            }
+        }
+    }
+
+    void DashboardDialog::finishLoadServerHistoryInfo(const EventsInfo::ServerInfoHistoryResponce& res)
+    {
+        if(res.initiator() != this){
+            return;
+        }
+
+        common::Error er = res.errorInfo();
+        if(er && er->isError()){
+            return;
+        }
+
+        IServer *serv = qobject_cast<IServer *>(sender());
+        DCHECK(serv);
+        if(!serv){
+            return;
+        }
+
+        unsigned char property = 0;
+        std::vector<unsigned char> fields;
+        bool counter = false;
+        if(!opsHistoryFields(serv->type(), &property, &fields, &counter)){
+            return;
+        }
+
+        EventsInfo::ServerInfoHistoryResponce::points_container_type points = res.points();
+        model_->setOpsHistory(serv, counter ? opsPerSecFromCounter(points) : points);
+    }
+
+    void DashboardDialog::snapShotAdd(ServerInfoSnapShoot snapshot)
+    {
+        IServer *serv = qobject_cast<IServer *>(sender());
+        if(!serv){
+            return;
+        }
+
+        model_->addSnapShoot(serv, snapshot);
+    }
+
+    void DashboardDialog::changeInterval(int msec)
+    {
+        for(size_t i = 0; i < servers_.size(); ++i){
+            servers_[i]->unwatchInfo(watchInterval_);
+            servers_[i]->watchInfo(msec);
+        }
+        watchInterval_ = msec;
+    }
+
+    void DashboardDialog::changeEvent(QEvent* e)
+    {
+        if(e->type() == QEvent::LanguageChange){
+            retranslateUi();
+        }
+
+        QDialog::changeEvent(e);
+    }
+
+    void DashboardDialog::retranslateUi()
+    {
+        using namespace translations;
+        setWindowTitle(trDashboard);
+        intervalLabel_->setText(trRefreshInterval + ":");
+    }
+
+    // sparklines start from the logged history, if the connection keeps one
+    void DashboardDialog::requestOpsHistory(IServerSPtr server)
+    {
+        if(!server->driver()->settings()->loggingEnabled()){
+            return;
+        }
+
+        unsigned char property = 0;
+        std::vector<unsigned char> fields;
+        bool counter = false;
+        if(!opsHistoryFields(server->type(), &property, &fields, &counter)){
+            return;
+        }
+
+        EventsInfo::ServerInfoHistoryRequest req(this, property, fields[0]);
+        req.sumFields_.assign(fields.begin() + 1, fields.end());
+        req.from_ = common::time::current_mstime() - DASHBOARD_HISTORY_SPAN_MSEC;
+        req.maxPoints_ = SPARKLINE_POINTS;
+        server->requestHistoryInfo(req);
+    }
+}
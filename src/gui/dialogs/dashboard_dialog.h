@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QDialog>
+
+class QLabel;
+class QSpinBox;
+class QSortFilterProxyModel;
+
+#include "core/events/events_info.h"
+
+namespace fastonosql
+{
+    class FastoTableView;
+    class DashboardTableModel;
+
+    // Live metrics of every configured Redis, Memcached and SSDB server.
+    // The servers are polled on the shared drivers pool, so a large fleet
+    // costs no more threads than a single connection.
+    class DashboardDialog
+            : public QDialog
+    {
+        Q_OBJECT
+    public:
+        explicit DashboardDialog(QWidget* parent = 0);
+        ~DashboardDialog();
+
+        enum
+        {
+            height = 480,
+            width = 960
+        };
+
+    private Q_SLOTS:
+        void finishConnect(const EventsInfo::ConnectInfoResponce& res);
+        void finishLoadServerHistoryInfo(const EventsInfo::ServerInfoHistoryResponce& res);
+        void snapShotAdd(ServerInfoSnapShoot snapshot);
+        void changeInterval(int msec);
+
+    protected:
+        virtual void changeEvent(QEvent* e);
+
+    private:
+        void retranslateUi();
+        void requestOpsHistory(IServerSPtr server);
+
+        QLabel* intervalLabel_;
+        QSpinBox* interval_;
+        FastoTableView* table_;
+        DashboardTableModel* model_;
+        QSortFilterProxyModel* proxy_;
+
+        std::vector<IServerSPtr> servers_;
+        int watchInterval_;
+    };
+}
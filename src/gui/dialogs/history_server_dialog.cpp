@@ -4,6 +4,11 @@
 #include <QSplitter>
 #include <QComboBox>
 #include <QPushButton>
+#include <QScrollBar>
+#include <QLabel>
+#include <QTimer>
+
+#include "common/time.h"
 
 #include "fasto/qt/gui/base/graph_widget.h"
 #include "gui/gui_factory.h"
@@ -12,10 +17,18 @@
 
 #include "translations/global.h"
 
+#define REQUEST_DELAY_MSEC 100
+
 namespace fastonosql
 {
+    namespace
+    {
+        const int spansSec[] = { 0, 60 * 60, 6 * 60 * 60, 24 * 60 * 60, 7 * 24 * 60 * 60, 30 * 24 * 60 * 60 };
+    }
+
     ServerHistoryDialog::ServerHistoryDialog(IServerSPtr server, QWidget* parent)
-        : QDialog(parent, Qt::WindowMinMaxButtonsHint | Qt::WindowCloseButtonHint ), server_(server)
+        : QDialog(parent, Qt::WindowMinMaxButtonsHint | Qt::WindowCloseButtonHint ), points_(), resolutionMsec_(0),
+          first_(0), last_(0), requestFrom_(0), requestTo_(0), server_(server)
     {
         using namespace translations;
         CHECK(server_);
@@ -43,18 +56,53 @@ namespace fastonosql
         VERIFY(connect(serverInfoFields_, static_cast<curc>(&QComboBox::currentIndexChanged), this, &ServerHistoryDialog::refreshGraph ));
 
         const std::vector<std::string> headers = infoHeadersFromType(server_->type());
-        for(int i = 0; i < headers.size(); ++i){
+        for(size_t i = 0; i < headers.size(); ++i){
             serverInfoGroupsNames_->addItem(common::convertFromString<QString>(headers[i]));
         }
+
+        // texts are set in retranslateUi
+        aggregation_ = new QComboBox;
+        for(int i = 0; i < InfoHistoryStore::STAT_COUNT; ++i){
+            aggregation_->addItem(QString());
+        }
+        span_ = new QComboBox;
+        for(int i = 0; i < SIZEOFMASS(spansSec); ++i){
+            span_->addItem(QString(), spansSec[i]);
+        }
+        resolution_ = new QLabel;
+        VERIFY(connect(aggregation_, static_cast<curc>(&QComboBox::currentIndexChanged), this, &ServerHistoryDialog::scheduleRequest));
+        VERIFY(connect(span_, static_cast<curc>(&QComboBox::currentIndexChanged), this, &ServerHistoryDialog::changeSpan));
+
         QVBoxLayout *setingsLayout = new QVBoxLayout;
         setingsLayout->addWidget(clearHistory_);
         setingsLayout->addWidget(serverInfoGroupsNames_);
         setingsLayout->addWidget(serverInfoFields_);
+        setingsLayout->addWidget(aggregation_);
+        setingsLayout->addWidget(span_);
+        setingsLayout->addWidget(resolution_);
+        setingsLayout->addStretch(1);
         settingsGraph_->setLayout(setingsLayout);
 
-        splitter->addWidget(graphWidget_);
+        pan_ = new QScrollBar(Qt::Horizontal);
+        pan_->setEnabled(false);
+        VERIFY(connect(pan_, &QScrollBar::valueChanged, this, &ServerHistoryDialog::scheduleRequest));
+
+        QWidget* graph = new QWidget;
+        QVBoxLayout *graphLayout = new QVBoxLayout;
+        graphLayout->setContentsMargins(0, 0, 0, 0);
+        graphLayout->addWidget(graphWidget_);
+        graphLayout->addWidget(pan_);
+        graph->setLayout(graphLayout);
+
+        splitter->addWidget(graph);
         setLayout(mainL);
 
+        // panning and resizing ask for one range once they settle
+        requestTimer_ = new QTimer(this);
+        requestTimer_->setSingleShot(true);
+        requestTimer_->setInterval(REQUEST_DELAY_MSEC);
+        VERIFY(connect(requestTimer_, &QTimer::timeout, this, &ServerHistoryDialog::requestHistoryInfo));
+
         glassWidget_ = new fasto::qt::gui::GlassWidget(GuiFactory::instance().pathToLoadingGif(), trLoading, 0.5, QColor(111, 111, 100), this);
         VERIFY(connect(server.get(), &IServer::startedLoadServerHistoryInfo, this, &ServerHistoryDialog::startLoadServerHistoryInfo));
         VERIFY(connect(server.get(), &IServer::finishedLoadServerHistoryInfo, this, &ServerHistoryDialog::finishLoadServerHistoryInfo));
@@ -66,7 +114,9 @@ namespace fastonosql
 
     void ServerHistoryDialog::startLoadServerHistoryInfo(const EventsInfo::ServerInfoHistoryRequest& req)
     {
-        glassWidget_->start();
+        if(points_.empty()){
+            glassWidget_->start();
+        }
     }
 
     void ServerHistoryDialog::finishLoadServerHistoryInfo(const EventsInfo::ServerInfoHistoryResponce& res)
@@ -77,8 +127,20 @@ namespace fastonosql
             return;
         }
 
-        infos_ = res.infos();
+        // answers to the requests made while panning are dropped
+        unsigned char property = 0, field = 0;
+        if(!currentField(&property, &field) || property != res.property_ || field != res.field_ ||
+           res.stat_ != aggregation_->currentIndex() || res.from_ != requestFrom_ || res.to_ != requestTo_){
+            return;
+        }
+
+        points_ = res.points();
+        resolutionMsec_ = res.resolution_;
+        first_ = res.first_;
+        last_ = res.last_;
+        updatePan();
         reset();
+        retranslateUi();
     }
 
     void ServerHistoryDialog::startClearServerHistory(const EventsInfo::ClearServerHistoryRequest& req)
@@ -98,8 +160,39 @@ namespace fastonosql
 
     void ServerHistoryDialog::snapShotAdd(ServerInfoSnapShoot snapshot)
     {
-        infos_.push_back(snapshot);
-        reset();
+        unsigned char property = 0, field = 0;
+        if(!snapshot.isValid() || !currentField(&property, &field)){
+            return;
+        }
+
+        if(!isFollowing()){
+            return;
+        }
+
+        // a coarser tier only changes when a bucket is closed
+        if(resolutionMsec_){
+            if(snapshot.msec_ - last_ >= resolutionMsec_){
+                scheduleRequest();
+            }
+            return;
+        }
+
+        common::Value* value = snapshot.info_->valueByIndexes(property, field); //allocate
+        if(value){
+            double graphY = 0;
+            if(value->getAsDouble(&graphY)){
+                points_.push_back(std::make_pair(snapshot.msec_, graphY));
+                last_ = snapshot.msec_;
+                const common::time64_t span = spanMsec();
+                size_t outdated = 0;
+                while(span && outdated < points_.size() && points_[outdated].first < last_ - span){
+                    ++outdated;
+                }
+                points_.erase(points_.begin(), points_.begin() + outdated);
+                reset();
+            }
+        }
+        delete value;
     }
 
     void ServerHistoryDialog::clearHistory()
@@ -132,27 +225,28 @@ namespace fastonosql
             return;
         }
 
-        unsigned char serverIndex = serverInfoGroupsNames_->currentIndex();
-        QVariant var = serverInfoFields_->itemData(index);
-        unsigned char indexIn = qvariant_cast<unsigned char>(var);
-        fasto::qt::gui::GraphWidget::nodes_container_type nodes;
-        for(EventsInfo::ServerInfoHistoryResponce::infos_container_type::iterator it = infos_.begin(); it != infos_.end(); ++it){
-            EventsInfo::ServerInfoHistoryResponce::infos_container_type::value_type val = *it;
-            if(!val.isValid()){
-                continue;
-            }
+        points_.clear();
+        reset();
+        if(isVisible()){
+            requestHistoryInfo();
+        }
+    }
 
-            common::Value* value = val.info_->valueByIndexes(serverIndex, indexIn); //allocate
-            if(value){
-                qreal graphY = 0.0f;
-                if(value->getAsDouble(&graphY)){
-                    nodes.push_back(std::make_pair(val.msec_, graphY));
-                }
-            }
-            delete value;
+    void ServerHistoryDialog::changeSpan(int index)
+    {
+        if(index == -1){
+            return;
         }
 
-        graphWidget_->setNodes(nodes);
+        pan_->setValue(pan_->maximum());
+        scheduleRequest();
+    }
+
+    void ServerHistoryDialog::scheduleRequest()
+    {
+        if(isVisible()){
+            requestTimer_->start();
+        }
     }
 
     void ServerHistoryDialog::changeEvent(QEvent* e)
@@ -170,9 +264,21 @@ namespace fastonosql
         requestHistoryInfo();
     }
 
+    // the graph gets a point per pixel
+    void ServerHistoryDialog::resizeEvent(QResizeEvent* e)
+    {
+        QDialog::resizeEvent(e);
+        scheduleRequest();
+    }
+
     void ServerHistoryDialog::reset()
     {
-        refreshGraph(serverInfoFields_->currentIndex());
+        fasto::qt::gui::GraphWidget::nodes_container_type nodes;
+        for(size_t i = 0; i < points_.size(); ++i){
+            nodes.push_back(std::make_pair(points_[i].first, points_[i].second));
+        }
+
+        graphWidget_->setNodes(nodes);
     }
 
     void ServerHistoryDialog::retranslateUi()
@@ -180,11 +286,96 @@ namespace fastonosql
         using namespace translations;
         setWindowTitle(tr("%1 history").arg(server_->name()));
         clearHistory_->setText(trClearHistory);
+
+        aggregation_->setItemText(InfoHistoryStore::STAT_AVG, tr("Average"));
+        aggregation_->setItemText(InfoHistoryStore::STAT_MIN, tr("Minimum"));
+        aggregation_->setItemText(InfoHistoryStore::STAT_MAX, tr("Maximum"));
+
+        span_->setItemText(0, tr("All"));
+        span_->setItemText(1, tr("Last hour"));
+        span_->setItemText(2, tr("Last 6 hours"));
+        span_->setItemText(3, tr("Last day"));
+        span_->setItemText(4, tr("Last week"));
+        span_->setItemText(5, tr("Last month"));
+
+        QString resolution = tr("samples");
+        if(resolutionMsec_ && resolutionMsec_ % (60 * 60 * 1000) == 0){
+            resolution = tr("%1 h").arg(resolutionMsec_ / (60 * 60 * 1000));
+        }
+        else if(resolutionMsec_){
+            resolution = tr("%1 min").arg(resolutionMsec_ / (60 * 1000));
+        }
+        resolution_->setText(tr("Resolution: %1").arg(resolution));
     }
 
+    // the scroll bar moves the start of the window in seconds, at its end
+    // the window follows new samples
+    void ServerHistoryDialog::updatePan()
+    {
+        const common::time64_t span = spanMsec();
+        const bool following = isFollowing();
+        int maximum = 0;
+        if(span && last_ - first_ > span){
+            maximum = (last_ - first_ - span) / 1000;
+        }
+
+        pan_->blockSignals(true);
+        pan_->setRange(0, maximum);
+        pan_->setPageStep(span / 1000);
+        pan_->setSingleStep(std::max<int>(1, span / 10000));
+        if(following){
+            pan_->setValue(maximum);
+        }
+        pan_->setEnabled(maximum > 0);
+        pan_->blockSignals(false);
+    }
+
+    common::time64_t ServerHistoryDialog::spanMsec() const
+    {
+        return static_cast<common::time64_t>(span_->currentData().toInt()) * 1000;
+    }
+
+    bool ServerHistoryDialog::isFollowing() const
+    {
+        return pan_->value() == pan_->maximum();
+    }
+
+    // only the selected field is read from the history
     void ServerHistoryDialog::requestHistoryInfo()
     {
-        EventsInfo::ServerInfoHistoryRequest req(this);
+        unsigned char property = 0, field = 0;
+        if(!currentField(&property, &field)){
+            return;
+        }
+
+        EventsInfo::ServerInfoHistoryRequest req(this, property, field);
+        req.stat_ = static_cast<InfoHistoryStore::Stat>(aggregation_->currentIndex());
+        req.maxPoints_ = graphWidget_->width();
+
+        const common::time64_t span = spanMsec();
+        if(span && !isFollowing()){
+            req.from_ = first_ + static_cast<common::time64_t>(pan_->value()) * 1000;
+            req.to_ = req.from_ + span;
+        }
+        else if(span){
+            req.from_ = (last_ ? last_ : common::time::current_mstime()) - span;
+        }
+
+        requestTimer_->stop();
+        requestFrom_ = req.from_;
+        requestTo_ = req.to_;
         server_->requestHistoryInfo(req);
     }
+
+    bool ServerHistoryDialog::currentField(unsigned char* property, unsigned char* field) const
+    {
+        int index = serverInfoFields_->currentIndex();
+        if(serverInfoGroupsNames_->currentIndex() == -1 || index == -1){
+            return false;
+        }
+
+        *property = serverInfoGroupsNames_->currentIndex();
+        *field = qvariant_cast<unsigned char>(serverInfoFields_->itemData(index));
+        return true;
+    }
 }
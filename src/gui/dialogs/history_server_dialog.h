@@ -4,6 +4,9 @@
 
 class QComboBox;
 class QPushButton;
+class QScrollBar;
+class QLabel;
+class QTimer;
 
 #include "core/events/events_info.h"
 
@@ -42,25 +45,42 @@ namespace fastonosql
 
         void refreshInfoFields(int index);
         void refreshGraph(int index);
+        void changeSpan(int index);
+        void scheduleRequest();
+        void requestHistoryInfo();
 
     protected:
         virtual void changeEvent(QEvent* e);
         virtual void showEvent(QShowEvent* e);
+        virtual void resizeEvent(QResizeEvent* e);
 
     private:
         void reset();
         void retranslateUi();
-        void requestHistoryInfo();
+        void updatePan();
+        bool currentField(unsigned char* property, unsigned char* field) const;
+        common::time64_t spanMsec() const;
+        bool isFollowing() const;
 
         QWidget* settingsGraph_;
         QPushButton* clearHistory_;
         QComboBox* serverInfoGroupsNames_;
         QComboBox* serverInfoFields_;
+        QComboBox* aggregation_;
+        QComboBox* span_;
+        QLabel* resolution_;
 
         fasto::qt::gui::GraphWidget* graphWidget_;
+        QScrollBar* pan_;
+        QTimer* requestTimer_;
 
         fasto::qt::gui::GlassWidget* glassWidget_;
-        EventsInfo::ServerInfoHistoryResponce::infos_container_type infos_;
+        EventsInfo::ServerInfoHistoryResponce::points_container_type points_;
+        common::time64_t resolutionMsec_;
+        common::time64_t first_;
+        common::time64_t last_;
+        common::time64_t requestFrom_;
+        common::time64_t requestTo_;
         const IServerSPtr server_;
     };
 }
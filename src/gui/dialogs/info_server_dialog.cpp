@@ -116,6 +116,30 @@ namespace
                                                             "Limit max bytes: %21<br/>"
                                                             "Threads: %22");
 
+    const QString memcachedTextSettingsTemplate = QObject::tr("<h2>Settings:</h2><br/>"
+                                                            "Max bytes: %1<br/>"
+                                                            "Max connections: %2<br/>"
+                                                            "Tcp port: %3<br/>"
+                                                            "Evictions: %4<br/>"
+                                                            "Growth factor: %5<br/>"
+                                                            "Chunk size: %6<br/>"
+                                                            "Threads: %7<br/>"
+                                                            "Item size max: %8<br/>"
+                                                            "Slab reassign: %9<br/>"
+                                                            "Slab automove: %10");
+
+    const QString memcachedTextSlabsTemplate = QObject::tr("<h2>Slabs:</h2><br/>"
+                                                            "Active slabs: %1<br/>"
+                                                            "Total malloced: %2<br/>"
+                                                            "<table>"
+                                                            "<tr><th>Class</th><th>Chunk size</th><th>Pages</th><th>Used chunks</th>"
+                                                            "<th>Mem requested</th><th>Get hits</th><th>Items</th><th>Evicted</th></tr>"
+                                                            "%3"
+                                                            "</table>");
+
+    const QString memcachedTextSlabRowTemplate = QObject::tr("<tr><td>%1</td><td>%2</td><td>%3</td><td>%4</td>"
+                                                             "<td>%5</td><td>%6</td><td>%7</td><td>%8</td></tr>");
+
     const QString ssdbTextServerTemplate = QObject::tr("<h2>Common:</h2><br/>"
                                                             "Version: %1<br/>"
                                                             "Links: %2<br/>"
@@ -413,9 +437,39 @@ namespace fastonosql
                 .arg(com.limit_maxbytes_)
                 .arg(com.threads_);
 
-        //QString textHard = memcachedTextHardwareTemplate;
+        MemcachedServerInfo::Settings set = serv.settings_;
+        QString textSettings = memcachedTextSettingsTemplate.arg(set.maxbytes_)
+                .arg(set.maxconns_)
+                .arg(set.tcpport_)
+                .arg(convertFromString<QString>(set.evictions_))
+                .arg(set.growth_factor_)
+                .arg(set.chunk_size_)
+                .arg(set.num_threads_)
+                .arg(set.item_size_max_)
+                .arg(convertFromString<QString>(set.slab_reassign_))
+                .arg(set.slab_automove_);
+
+        QString slabRows;
+        const MemcachedServerInfo::Slabs& slabs = serv.slabs_;
+        for(MemcachedServerInfo::Slabs::classes_container_type::const_iterator it = slabs.classes_.begin(); it != slabs.classes_.end(); ++it){
+            const MemcachedServerInfo::SlabClass& cl = *it;
+            const MemcachedServerInfo::ItemClass* items = serv.items_.findClass(cl.id_);
+            slabRows += memcachedTextSlabRowTemplate.arg(cl.id_)
+                    .arg(cl.chunk_size_)
+                    .arg(cl.total_pages_)
+                    .arg(cl.used_chunks_)
+                    .arg(cl.mem_requested_)
+                    .arg(cl.get_hits_)
+                    .arg(items ? items->number_ : 0)
+                    .arg(items ? items->evicted_ : 0);
+        }
+
+        QString textSlabs = memcachedTextSlabsTemplate.arg(slabs.active_slabs_)
+                .arg(slabs.total_malloced_)
+                .arg(slabRows);
+
         serverTextInfo_->setText(textServ);
-        //hardwareTextInfo_->setText(textHard);
+        hardwareTextInfo_->setText(textSettings + textSlabs);
     }
 #endif
 
@@ -0,0 +1,235 @@
+#include "gui/dialogs/keyspace_dialog.h"
+
+#include <QCheckBox>
+#include <QDialogButtonBox>
+#include <QGridLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTabWidget>
+#include <QTableWidget>
+#include <QVBoxLayout>
+#include <QEvent>
+
+#include "common/qt/convert_string.h"
+
+#include "core/iserver.h"
+
+#include "gui/gui_factory.h"
+
+#include "translations/global.h"
+
+// every event class, on the __keyevent@ channels only
+#define KEYSPACE_ENABLE_FLAGS "EA"
+#define KEYSPACE_MAX_DB 15
+
+namespace
+{
+    enum
+    {
+        eType = 0,
+        eTotal,
+        ePerSec,
+        eEventsColumnsCount
+    };
+
+    enum
+    {
+        eKey = 0,
+        eCount,
+        eError,
+        eKeysColumnsCount
+    };
+}
+
+namespace fastonosql
+{
+    KeyspaceDialog::KeyspaceDialog(IServerSPtr server, QWidget* parent)
+        : QDialog(parent, Qt::WindowMinMaxButtonsHint | Qt::WindowCloseButtonHint), server_(server), running_(false)
+    {
+        CHECK(server_);
+        setWindowIcon(GuiFactory::instance().icon(server_->type()));
+
+        QGridLayout* configLayout = new QGridLayout;
+        dbLabel_ = new QLabel;
+        db_ = new QSpinBox;
+        db_->setRange(-1, KEYSPACE_MAX_DB);
+        db_->setValue(-1);
+        enable_ = new QCheckBox;
+        configLayout->addWidget(dbLabel_, 0, 0);
+        configLayout->addWidget(db_, 0, 1);
+        configLayout->addWidget(enable_, 1, 0, 1, 2);
+
+        QHBoxLayout* buttonsLayout = new QHBoxLayout;
+        startButton_ = new QPushButton;
+        VERIFY(connect(startButton_, &QPushButton::clicked, this, &KeyspaceDialog::start));
+        stopButton_ = new QPushButton;
+        stopButton_->setEnabled(false);
+        VERIFY(connect(stopButton_, &QPushButton::clicked, this, &KeyspaceDialog::stop));
+        statusLabel_ = new QLabel;
+        buttonsLayout->addWidget(startButton_);
+        buttonsLayout->addWidget(stopButton_);
+        buttonsLayout->addWidget(statusLabel_, 1);
+
+        tabs_ = new QTabWidget;
+        events_ = addTable(eEventsColumnsCount);
+        keys_ = addTable(eKeysColumnsCount);
+
+        QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+        VERIFY(connect(buttonBox, &QDialogButtonBox::rejected, this, &KeyspaceDialog::reject));
+
+        QVBoxLayout* mainLayout = new QVBoxLayout;
+        mainLayout->addLayout(configLayout);
+        mainLayout->addLayout(buttonsLayout);
+        mainLayout->addWidget(tabs_);
+        mainLayout->addWidget(buttonBox);
+        setLayout(mainLayout);
+        setMinimumSize(QSize(width, height));
+
+        VERIFY(connect(server.get(), &IServer::startedKeyspace, this, &KeyspaceDialog::startKeyspace));
+        VERIFY(connect(server.get(), &IServer::keyspaceSnapShot, this, &KeyspaceDialog::snapShot));
+        VERIFY(connect(server.get(), &IServer::finishedKeyspace, this, &KeyspaceDialog::finishKeyspace));
+        retranslateUi();
+    }
+
+    QTableWidget* KeyspaceDialog::addTable(int columns)
+    {
+        QTableWidget* table = new QTableWidget(0, columns);
+        table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+        tabs_->addTab(table, QString());
+        return table;
+    }
+
+    // the flags set for the stream are put back only when it stops
+    void KeyspaceDialog::reject()
+    {
+        if(running_){
+            server_->stopStream();
+        }
+        QDialog::reject();
+    }
+
+    void KeyspaceDialog::startKeyspace(const EventsInfo::KeyspaceRequest& req)
+    {
+        UNUSED(req);
+
+        running_ = true;
+        startButton_->setEnabled(false);
+        stopButton_->setEnabled(true);
+        statusLabel_->setText(tr("Listening..."));
+    }
+
+    void KeyspaceDialog::snapShot(const KeyspaceSnapShot& shot)
+    {
+        statusLabel_->setText(tr("%1 events, %2/sec, expired %3/sec, evicted %4/sec").arg(shot.total_)
+                              .arg(shot.eventsPerSec_, 0, 'f', 1).arg(shot.expiredPerSec_, 0, 'f', 1).arg(shot.evictedPerSec_, 0, 'f', 1));
+
+        events_->setRowCount(shot.events_.size());
+        for(size_t i = 0; i < shot.events_.size(); ++i){
+            const KeyspaceEventRate& rate = shot.events_[i];
+            events_->setItem(i, eType, new QTableWidgetItem(common::convertFromString<QString>(rate.type_)));
+            events_->setItem(i, eTotal, new QTableWidgetItem(QString::number(rate.total_)));
+            events_->setItem(i, ePerSec, new QTableWidgetItem(QString::number(rate.perSec_, 'f', 1)));
+        }
+
+        keys_->setRowCount(shot.keys_.size());
+        for(size_t i = 0; i < shot.keys_.size(); ++i){
+            const TopKItem& item = shot.keys_[i];
+            keys_->setItem(i, eKey, new QTableWidgetItem(common::convertFromString<QString>(item.key_)));
+            keys_->setItem(i, eCount, new QTableWidgetItem(QString::number(item.count_)));
+            keys_->setItem(i, eError, new QTableWidgetItem(QString::number(item.error_)));
+        }
+    }
+
+    void KeyspaceDialog::finishKeyspace(const EventsInfo::KeyspaceResponce& res)
+    {
+        running_ = false;
+        startButton_->setEnabled(true);
+        stopButton_->setEnabled(false);
+
+        common::Error er = res.errorInfo();
+        if(er && er->isError()){
+            statusLabel_->setText(common::convertFromString<QString>(er->description()));
+            return;
+        }
+
+        if(!res.disabled_){
+            snapShot(res.last_);
+            return;
+        }
+
+        statusLabel_->setText(tr("Keyspace notifications are off"));
+        if(res.initiator() != this){
+            return;
+        }
+
+        int answer = QMessageBox::question(this, windowTitle(), tr("Keyspace notifications are off on %1 (notify-keyspace-events is \"%2\"). "
+                                                                   "Set it to \"%3\" while listening? Every write then publishes a message.")
+                                           .arg(server_->name()).arg(common::convertFromString<QString>(res.serverFlags_)).arg(KEYSPACE_ENABLE_FLAGS),
+                                           QMessageBox::Yes, QMessageBox::No, QMessageBox::NoButton);
+        if(answer != QMessageBox::Yes){
+            return;
+        }
+
+        enable_->setChecked(true);
+        EventsInfo::KeyspaceRequest req(this, res.db_, KEYSPACE_ENABLE_FLAGS);
+        server_->keyspaceEvents(req);
+    }
+
+    void KeyspaceDialog::start()
+    {
+        std::string flags;
+        if(enable_->isChecked()){
+            int answer = QMessageBox::question(this, windowTitle(), tr("Set notify-keyspace-events to \"%1\" on %2 while listening? "
+                                                                       "Every write then publishes a message, the previous value is restored on stop.")
+                                               .arg(KEYSPACE_ENABLE_FLAGS).arg(server_->name()),
+                                               QMessageBox::Yes, QMessageBox::No, QMessageBox::NoButton);
+            if(answer != QMessageBox::Yes){
+                return;
+            }
+            flags = KEYSPACE_ENABLE_FLAGS;
+        }
+
+        EventsInfo::KeyspaceRequest req(this, db_->value(), flags);
+        server_->keyspaceEvents(req);
+    }
+
+    void KeyspaceDialog::stop()
+    {
+        server_->stopStream();
+    }
+
+    void KeyspaceDialog::changeEvent(QEvent* e)
+    {
+        if(e->type() == QEvent::LanguageChange){
+            retranslateUi();
+        }
+        QDialog::changeEvent(e);
+    }
+
+    void KeyspaceDialog::retranslateUi()
+    {
+        using namespace translations;
+        setWindowTitle(tr("%1 keyspace events").arg(server_->name()));
+
+        dbLabel_->setText(tr("Database:"));
+        db_->setSpecialValueText(tr("All"));
+        enable_->setText(tr("Turn on notifications of every event while listening"));
+        startButton_->setText(tr("Start"));
+        stopButton_->setText(trStop);
+
+        tabs_->setTabText(0, tr("Events"));
+        tabs_->setTabText(1, tr("Hot keys"));
+
+        QStringList events;
+        events << tr("Event") << tr("Total") << tr("Per sec");
+        events_->setHorizontalHeaderLabels(events);
+
+        QStringList keys;
+        keys << tr("Key") << tr("Count") << tr("Overestimate");
+        keys_->setHorizontalHeaderLabels(keys);
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QDialog>
+
+class QLabel;
+class QSpinBox;
+class QCheckBox;
+class QPushButton;
+class QTabWidget;
+class QTableWidget;
+
+#include "core/events/events_info.h"
+
+namespace fastonosql
+{
+    // Live keyspace notifications of one server: rates per event type, hot
+    // keys and the expiry and eviction rates. Notifications can be turned on
+    // for the stream, the server's setting is restored when it stops.
+    class KeyspaceDialog
+            : public QDialog
+    {
+        Q_OBJECT
+    public:
+        explicit KeyspaceDialog(IServerSPtr server, QWidget* parent = 0);
+
+        enum
+        {
+            height = 480,
+            width = 640
+        };
+
+    public Q_SLOTS:
+        virtual void reject();
+
+    private Q_SLOTS:
+        void startKeyspace(const EventsInfo::KeyspaceRequest& req);
+        void snapShot(const KeyspaceSnapShot& shot);
+        void finishKeyspace(const EventsInfo::KeyspaceResponce& res);
+
+        void start();
+        void stop();
+
+    protected:
+        virtual void changeEvent(QEvent* e);
+
+    private:
+        void retranslateUi();
+        QTableWidget* addTable(int columns);
+
+        QLabel* dbLabel_;
+        QSpinBox* db_;
+        QCheckBox* enable_;
+
+        QPushButton* startButton_;
+        QPushButton* stopButton_;
+        QLabel* statusLabel_;
+
+        QTabWidget* tabs_;
+        QTableWidget* events_;
+        QTableWidget* keys_;
+
+        const IServerSPtr server_;
+        bool running_;
+    };
+}
@@ -6,14 +6,37 @@
 #include <QMessageBox>
 #include <QLabel>
 #include <QSpinBox>
+#include <QCheckBox>
+#include <QComboBox>
+
+#include "common/qt/convert_string.h"
 
 #include "gui/gui_factory.h"
 #include "translations/global.h"
 
 namespace fastonosql
 {
-    LoadContentDbDialog::LoadContentDbDialog(const QString &title, connectionTypes type, QWidget* parent)
-        : QDialog(parent), type_(type)
+    namespace
+    {
+        std::vector<common::Value::Type> searchableTypes(connectionTypes type)
+        {
+            std::vector<common::Value::Type> types;
+            types.push_back(common::Value::TYPE_STRING);
+            if(type == REDIS || type == SSDB){
+                types.push_back(common::Value::TYPE_ARRAY);
+                types.push_back(common::Value::TYPE_ZSET);
+                types.push_back(common::Value::TYPE_HASH);
+            }
+            if(type == REDIS){
+                types.push_back(common::Value::TYPE_SET);
+                types.push_back(TYPE_STREAM);
+            }
+            return types;
+        }
+    }
+
+    LoadContentDbDialog::LoadContentDbDialog(const QString &title, connectionTypes type, QWidget* parent, bool searchValues)
+        : QDialog(parent), type_(type), searchValues_(searchValues), valueEdit_(NULL), valueRegexCheckBox_(NULL), rateSpinEdit_(NULL)
     {
         setWindowIcon(GuiFactory::instance().icon(type_));
         setWindowTitle(title);
@@ -40,8 +63,46 @@ namespace fastonosql
         patternEdit_->setFixedWidth(80);
         patternEdit_->setText("*");
         patternLayout->addWidget(patternEdit_);
+        regexCheckBox_ = new QCheckBox(tr("Regular expression"));
+        patternLayout->addWidget(regexCheckBox_);
         mainLayout->addLayout(patternLayout);
 
+        QHBoxLayout* typeLayout = new QHBoxLayout;
+        typeLayout->addWidget(new QLabel(tr("Type:")));
+        typesCombo_ = new QComboBox;
+        typesCombo_->addItem(tr("Any"), common::Value::TYPE_NULL);
+        std::vector<common::Value::Type> types = searchableTypes(type_);
+        for(size_t i = 0; i < types.size(); ++i){
+            common::Value::Type t = types[i];
+            typesCombo_->addItem(GuiFactory::instance().icon(t), common::convertFromString<QString>(typeToString(t)), t);
+        }
+        typeLayout->addWidget(typesCombo_);
+        mainLayout->addLayout(typeLayout);
+
+        if(searchValues_){
+            // only string values are searched
+            typesCombo_->setCurrentIndex(typesCombo_->findData(common::Value::TYPE_STRING));
+            typesCombo_->setEnabled(false);
+
+            QHBoxLayout* valueLayout = new QHBoxLayout;
+            valueLayout->addWidget(new QLabel(tr("Value contains:")));
+            valueEdit_ = new QLineEdit;
+            valueLayout->addWidget(valueEdit_);
+            valueRegexCheckBox_ = new QCheckBox(tr("Regular expression"));
+            valueLayout->addWidget(valueRegexCheckBox_);
+            mainLayout->addLayout(valueLayout);
+
+            QHBoxLayout* rateLayout = new QHBoxLayout;
+            rateLayout->addWidget(new QLabel(tr("Keys per second:")));
+            rateSpinEdit_ = new QSpinBox;
+            rateSpinEdit_->setRange(0, max_keys_per_second);
+            rateSpinEdit_->setSingleStep(defaults_keys_per_second);
+            rateSpinEdit_->setSpecialValueText(tr("Unlimited"));
+            rateSpinEdit_->setValue(defaults_keys_per_second);
+            rateLayout->addWidget(rateSpinEdit_);
+            mainLayout->addLayout(rateLayout);
+        }
+
         mainLayout->addWidget(buttonBox);
 
         setMinimumSize(QSize(min_width, min_height));
@@ -58,6 +119,31 @@ namespace fastonosql
         return patternEdit_->text();
     }
 
+    KeysFilter::PatternType LoadContentDbDialog::patternType() const
+    {
+        return regexCheckBox_->isChecked() ? KeysFilter::REGEX : KeysFilter::GLOB;
+    }
+
+    common::Value::Type LoadContentDbDialog::keysType() const
+    {
+        return static_cast<common::Value::Type>(typesCombo_->currentData().toInt());
+    }
+
+    QString LoadContentDbDialog::valuePattern() const
+    {
+        return valueEdit_ ? valueEdit_->text() : QString();
+    }
+
+    ValueMatcher::MatchType LoadContentDbDialog::valueMatchType() const
+    {
+        return valueRegexCheckBox_ && valueRegexCheckBox_->isChecked() ? ValueMatcher::REGEX : ValueMatcher::SUBSTRING;
+    }
+
+    uint32_t LoadContentDbDialog::maxKeysPerSecond() const
+    {
+        return rateSpinEdit_ ? rateSpinEdit_->value() : 0;
+    }
+
     void LoadContentDbDialog::accept()
     {
         using namespace translations;
@@ -68,6 +154,29 @@ namespace fastonosql
             return;
         }
 
+        KeysFilter filter(common::convertToString(pattern), patternType());
+        if(!filter.isValid()){
+            QMessageBox::warning(this, trError, QObject::tr("Invalid regular expression: %1").arg(common::convertFromString<QString>(filter.errorString())));
+            patternEdit_->setFocus();
+            return;
+        }
+
+        if(searchValues_){
+            QString value = valuePattern();
+            if(value.isEmpty()){
+                QMessageBox::warning(this, trError, QObject::tr("Invalid value pattern!"));
+                valueEdit_->setFocus();
+                return;
+            }
+
+            ValueMatcher matcher(common::convertToString(value), valueMatchType());
+            if(!matcher.isValid()){
+                QMessageBox::warning(this, trError, QObject::tr("Invalid regular expression: %1").arg(common::convertFromString<QString>(matcher.errorString())));
+                valueEdit_->setFocus();
+                return;
+            }
+        }
+
         QDialog::accept();
     }
 }
@@ -3,9 +3,13 @@
 #include <QDialog>
 
 #include "core/connection_types.h"
+#include "core/keys_filter.h"
+#include "core/value_matcher.h"
 
 class QLineEdit;
 class QSpinBox;
+class QCheckBox;
+class QComboBox;
 
 namespace fastonosql
 {
@@ -21,20 +25,34 @@ namespace fastonosql
             min_key_on_page = 1,
             max_key_on_page = 1000,
             defaults_key = 100,
-            step_keys_on_page = defaults_key
+            step_keys_on_page = defaults_key,
+            max_keys_per_second = 1000000,
+            defaults_keys_per_second = 1000
         };
 
-        explicit LoadContentDbDialog(const QString& title, connectionTypes type, QWidget* parent = 0);
+        // searchValues adds the value pattern and the scan rate cap
+        explicit LoadContentDbDialog(const QString& title, connectionTypes type, QWidget* parent = 0, bool searchValues = false);
         uint32_t count() const;
         QString pattern() const;
+        KeysFilter::PatternType patternType() const;
+        common::Value::Type keysType() const;
+        QString valuePattern() const;
+        ValueMatcher::MatchType valueMatchType() const;
+        uint32_t maxKeysPerSecond() const;
 
     public Q_SLOTS:
         virtual void accept();
 
     private:
         const connectionTypes type_;
+        const bool searchValues_;
 
         QLineEdit* patternEdit_;
+        QCheckBox* regexCheckBox_;
+        QComboBox* typesCombo_;
         QSpinBox* countSpinEdit_;
+        QLineEdit* valueEdit_;
+        QCheckBox* valueRegexCheckBox_;
+        QSpinBox* rateSpinEdit_;
     };
 }
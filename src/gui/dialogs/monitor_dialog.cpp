@@ -0,0 +1,220 @@
+#include "gui/dialogs/monitor_dialog.h"
+
+#include <QDialogButtonBox>
+#include <QFileDialog>
+#include <QGridLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTabWidget>
+#include <QTableWidget>
+#include <QVBoxLayout>
+#include <QEvent>
+
+#include "common/qt/convert_string.h"
+
+#include "core/iserver.h"
+
+#include "gui/gui_factory.h"
+
+#include "translations/global.h"
+
+#define MONITOR_MAX_DURATION_SEC (24 * 60 * 60)
+
+namespace
+{
+    enum
+    {
+        eName = 0,
+        eCount,
+        eError,
+        eColumnsCount
+    };
+
+    void fillTopTable(QTableWidget* table, const std::vector<fastonosql::TopKItem>& items)
+    {
+        table->setRowCount(items.size());
+        for(size_t i = 0; i < items.size(); ++i){
+            const fastonosql::TopKItem& item = items[i];
+            table->setItem(i, eName, new QTableWidgetItem(common::convertFromString<QString>(item.key_)));
+            table->setItem(i, eCount, new QTableWidgetItem(QString::number(item.count_)));
+            table->setItem(i, eError, new QTableWidgetItem(QString::number(item.error_)));
+        }
+    }
+}
+
+namespace fastonosql
+{
+    MonitorDialog::MonitorDialog(IServerSPtr server, QWidget* parent)
+        : QDialog(parent, Qt::WindowMinMaxButtonsHint | Qt::WindowCloseButtonHint), server_(server), running_(false)
+    {
+        CHECK(server_);
+        setWindowIcon(GuiFactory::instance().icon(server_->type()));
+
+        QGridLayout* configLayout = new QGridLayout;
+        durationLabel_ = new QLabel;
+        duration_ = new QSpinBox;
+        duration_->setRange(0, MONITOR_MAX_DURATION_SEC);
+        duration_->setValue(60);
+        captureLabel_ = new QLabel;
+        capturePath_ = new QLineEdit;
+        browseButton_ = new QPushButton("...");
+        VERIFY(connect(browseButton_, &QPushButton::clicked, this, &MonitorDialog::browseCapture));
+        configLayout->addWidget(durationLabel_, 0, 0);
+        configLayout->addWidget(duration_, 0, 1, 1, 2);
+        configLayout->addWidget(captureLabel_, 1, 0);
+        configLayout->addWidget(capturePath_, 1, 1);
+        configLayout->addWidget(browseButton_, 1, 2);
+
+        QHBoxLayout* buttonsLayout = new QHBoxLayout;
+        startButton_ = new QPushButton;
+        VERIFY(connect(startButton_, &QPushButton::clicked, this, &MonitorDialog::start));
+        stopButton_ = new QPushButton;
+        stopButton_->setEnabled(false);
+        VERIFY(connect(stopButton_, &QPushButton::clicked, this, &MonitorDialog::stop));
+        statusLabel_ = new QLabel;
+        buttonsLayout->addWidget(startButton_);
+        buttonsLayout->addWidget(stopButton_);
+        buttonsLayout->addWidget(statusLabel_, 1);
+
+        tabs_ = new QTabWidget;
+        commands_ = addTopTable();
+        keys_ = addTopTable();
+        prefixes_ = addTopTable();
+        clients_ = addTopTable();
+        recent_ = new QTableWidget(0, 1);
+        recent_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        recent_->horizontalHeader()->setStretchLastSection(true);
+        recent_->horizontalHeader()->hide();
+        tabs_->addTab(recent_, QString());
+
+        QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+        VERIFY(connect(buttonBox, &QDialogButtonBox::rejected, this, &MonitorDialog::reject));
+
+        QVBoxLayout* mainLayout = new QVBoxLayout;
+        mainLayout->addLayout(configLayout);
+        mainLayout->addLayout(buttonsLayout);
+        mainLayout->addWidget(tabs_);
+        mainLayout->addWidget(buttonBox);
+        setLayout(mainLayout);
+        setMinimumSize(QSize(width, height));
+
+        VERIFY(connect(server.get(), &IServer::startedMonitor, this, &MonitorDialog::startMonitor));
+        VERIFY(connect(server.get(), &IServer::monitorSnapShot, this, &MonitorDialog::snapShot));
+        VERIFY(connect(server.get(), &IServer::finishedMonitor, this, &MonitorDialog::finishMonitor));
+        retranslateUi();
+    }
+
+    QTableWidget* MonitorDialog::addTopTable()
+    {
+        QTableWidget* table = new QTableWidget(0, eColumnsCount);
+        table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+        tabs_->addTab(table, QString());
+        return table;
+    }
+
+    // MONITOR costs the server on every command, don't leave it running behind a closed dialog
+    void MonitorDialog::reject()
+    {
+        if(running_){
+            server_->stopStream();
+        }
+        QDialog::reject();
+    }
+
+    void MonitorDialog::startMonitor(const EventsInfo::MonitorRequest& req)
+    {
+        UNUSED(req);
+
+        running_ = true;
+        startButton_->setEnabled(false);
+        stopButton_->setEnabled(true);
+        statusLabel_->setText(tr("Monitoring..."));
+    }
+
+    void MonitorDialog::snapShot(const MonitorSnapShot& shot)
+    {
+        statusLabel_->setText(tr("%1 commands, %2 ops/sec").arg(shot.total_).arg(shot.opsPerSec_, 0, 'f', 1));
+        fillTopTable(commands_, shot.commands_);
+        fillTopTable(keys_, shot.keys_);
+        fillTopTable(prefixes_, shot.prefixes_);
+        fillTopTable(clients_, shot.clients_);
+
+        recent_->setRowCount(shot.recent_.size());
+        for(size_t i = 0; i < shot.recent_.size(); ++i){
+            recent_->setItem(i, 0, new QTableWidgetItem(common::convertFromString<QString>(shot.recent_[i].line_)));
+        }
+    }
+
+    void MonitorDialog::finishMonitor(const EventsInfo::MonitorResponce& res)
+    {
+        running_ = false;
+        startButton_->setEnabled(true);
+        stopButton_->setEnabled(false);
+
+        snapShot(res.last_);
+        common::Error er = res.errorInfo();
+        if(er && er->isError()){
+            statusLabel_->setText(common::convertFromString<QString>(er->description()));
+        }
+    }
+
+    void MonitorDialog::start()
+    {
+        const common::time64_t duration = static_cast<common::time64_t>(duration_->value()) * 1000;
+        EventsInfo::MonitorRequest req(this, duration, common::convertToString(capturePath_->text()));
+        server_->monitor(req);
+    }
+
+    void MonitorDialog::stop()
+    {
+        server_->stopStream();
+    }
+
+    void MonitorDialog::browseCapture()
+    {
+        QString filepath = QFileDialog::getSaveFileName(this, tr("Capture to"), capturePath_->text(), tr("Text files (*.txt *.log)"));
+        if(!filepath.isNull()){
+            capturePath_->setText(filepath);
+        }
+    }
+
+    void MonitorDialog::changeEvent(QEvent* e)
+    {
+        if(e->type() == QEvent::LanguageChange){
+            retranslateUi();
+        }
+        QDialog::changeEvent(e);
+    }
+
+    void MonitorDialog::retranslateUi()
+    {
+        using namespace translations;
+        setWindowTitle(tr("%1 monitor").arg(server_->name()));
+
+        durationLabel_->setText(tr("Duration:"));
+        duration_->setSuffix(tr(" sec"));
+        duration_->setSpecialValueText(tr("Until stopped"));
+        captureLabel_->setText(tr("Capture to:"));
+        capturePath_->setPlaceholderText(tr("No capture"));
+        startButton_->setText(tr("Start"));
+        stopButton_->setText(trStop);
+
+        tabs_->setTabText(0, tr("Commands"));
+        tabs_->setTabText(1, tr("Keys"));
+        tabs_->setTabText(2, tr("Key prefixes"));
+        tabs_->setTabText(3, trClients);
+        tabs_->setTabText(4, tr("Recent"));
+
+        QStringList columns;
+        columns << QString() << tr("Count") << tr("Overestimate");
+        QTableWidget* tables[] = { commands_, keys_, prefixes_, clients_ };
+        for(size_t i = 0; i < SIZEOFMASS(tables); ++i){
+            columns[eName] = tabs_->tabText(i);
+            tables[i]->setHorizontalHeaderLabels(columns);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QDialog>
+
+class QLabel;
+class QSpinBox;
+class QLineEdit;
+class QPushButton;
+class QTabWidget;
+class QTableWidget;
+
+#include "core/events/events_info.h"
+
+namespace fastonosql
+{
+    // Live MONITOR of one server aggregated into top commands, keys,
+    // key prefixes and clients; the raw lines can be captured to a file.
+    class MonitorDialog
+            : public QDialog
+    {
+        Q_OBJECT
+    public:
+        explicit MonitorDialog(IServerSPtr server, QWidget* parent = 0);
+
+        enum
+        {
+            height = 480,
+            width = 640
+        };
+
+    public Q_SLOTS:
+        virtual void reject();
+
+    private Q_SLOTS:
+        void startMonitor(const EventsInfo::MonitorRequest& req);
+        void snapShot(const MonitorSnapShot& shot);
+        void finishMonitor(const EventsInfo::MonitorResponce& res);
+
+        void start();
+        void stop();
+        void browseCapture();
+
+    protected:
+        virtual void changeEvent(QEvent* e);
+
+    private:
+        void retranslateUi();
+        QTableWidget* addTopTable();
+
+        QLabel* durationLabel_;
+        QSpinBox* duration_;
+        QLabel* captureLabel_;
+        QLineEdit* capturePath_;
+        QPushButton* browseButton_;
+
+        QPushButton* startButton_;
+        QPushButton* stopButton_;
+        QLabel* statusLabel_;
+
+        QTabWidget* tabs_;
+        QTableWidget* commands_;
+        QTableWidget* keys_;
+        QTableWidget* prefixes_;
+        QTableWidget* clients_;
+        QTableWidget* recent_;
+
+        const IServerSPtr server_;
+        bool running_;
+    };
+}
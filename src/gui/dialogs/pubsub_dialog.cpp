@@ -0,0 +1,330 @@
+#include "gui/dialogs/pubsub_dialog.h"
+
+#include <QDateTime>
+#include <QDialogButtonBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLabel>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QSplitter>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+#include <QEvent>
+
+#include "common/qt/convert_string.h"
+
+#include "core/iserver.h"
+
+#include "gui/gui_factory.h"
+
+#include "translations/global.h"
+
+#define PUBSUB_RING_SIZE 65536
+#define PUBSUB_CAPTURE_SIZE 10000
+#define PUBSUB_VIEW_ROWS 500
+#define PUBSUB_DRAIN_MSEC 500
+
+namespace
+{
+    enum
+    {
+        eChannel = 0,
+        eTotal,
+        eRate,
+        eRatesColumnsCount
+    };
+
+    enum
+    {
+        eTime = 0,
+        eMessageChannel,
+        ePayload,
+        eMessagesColumnsCount
+    };
+
+    // names with glob characters go to PSUBSCRIBE
+    bool isChannelPattern(const std::string& name)
+    {
+        return name.find_first_of("*?[") != std::string::npos;
+    }
+
+    bool matchesFilter(const fastonosql::PubSubMessage& msg, const std::string& filter)
+    {
+        return filter.empty() || msg.channel_.find(filter) != std::string::npos || msg.payload_.find(filter) != std::string::npos;
+    }
+
+    QString messageTime(common::time64_t msec)
+    {
+        return QDateTime::fromMSecsSinceEpoch(msec).toString("hh:mm:ss.zzz");
+    }
+}
+
+namespace fastonosql
+{
+    PubSubDialog::PubSubDialog(IServerSPtr server, QWidget* parent)
+        : QDialog(parent, Qt::WindowMinMaxButtonsHint | Qt::WindowCloseButtonHint), server_(server),
+          ring_(), stats_(), capture_(), drained_(), received_(0), running_(false)
+    {
+        CHECK(server_);
+        setWindowIcon(GuiFactory::instance().icon(server_->type()));
+
+        QHBoxLayout* channelsLayout = new QHBoxLayout;
+        channelsLabel_ = new QLabel;
+        channels_ = new QLineEdit;
+        startButton_ = new QPushButton;
+        VERIFY(connect(startButton_, &QPushButton::clicked, this, &PubSubDialog::start));
+        stopButton_ = new QPushButton;
+        stopButton_->setEnabled(false);
+        VERIFY(connect(stopButton_, &QPushButton::clicked, this, &PubSubDialog::stop));
+        channelsLayout->addWidget(channelsLabel_);
+        channelsLayout->addWidget(channels_, 1);
+        channelsLayout->addWidget(startButton_);
+        channelsLayout->addWidget(stopButton_);
+
+        QHBoxLayout* viewLayout = new QHBoxLayout;
+        filterLabel_ = new QLabel;
+        filter_ = new QLineEdit;
+        VERIFY(connect(filter_, &QLineEdit::textChanged, this, &PubSubDialog::updateMessages));
+        pauseButton_ = new QPushButton;
+        pauseButton_->setCheckable(true);
+        VERIFY(connect(pauseButton_, &QPushButton::toggled, this, &PubSubDialog::updateMessages));
+        exportButton_ = new QPushButton;
+        VERIFY(connect(exportButton_, &QPushButton::clicked, this, &PubSubDialog::exportMessages));
+        viewLayout->addWidget(filterLabel_);
+        viewLayout->addWidget(filter_, 1);
+        viewLayout->addWidget(pauseButton_);
+        viewLayout->addWidget(exportButton_);
+
+        statusLabel_ = new QLabel;
+        rates_ = new QTableWidget(0, eRatesColumnsCount);
+        rates_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        rates_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+        messages_ = new QTableWidget(0, eMessagesColumnsCount);
+        messages_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        messages_->horizontalHeader()->setStretchLastSection(true);
+
+        QSplitter* splitter = new QSplitter(Qt::Vertical);
+        splitter->addWidget(rates_);
+        splitter->addWidget(messages_);
+
+        QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+        VERIFY(connect(buttonBox, &QDialogButtonBox::rejected, this, &PubSubDialog::reject));
+
+        QVBoxLayout* mainLayout = new QVBoxLayout;
+        mainLayout->addLayout(channelsLayout);
+        mainLayout->addLayout(viewLayout);
+        mainLayout->addWidget(statusLabel_);
+        mainLayout->addWidget(splitter, 1);
+        mainLayout->addWidget(buttonBox);
+        setLayout(mainLayout);
+        setMinimumSize(QSize(width, height));
+
+        drainTimer_ = new QTimer(this);
+        drainTimer_->setInterval(PUBSUB_DRAIN_MSEC);
+        VERIFY(connect(drainTimer_, &QTimer::timeout, this, &PubSubDialog::drain));
+
+        VERIFY(connect(server.get(), &IServer::startedPubSub, this, &PubSubDialog::startPubSub));
+        VERIFY(connect(server.get(), &IServer::finishedPubSub, this, &PubSubDialog::finishPubSub));
+        retranslateUi();
+    }
+
+    void PubSubDialog::reject()
+    {
+        if(running_){
+            server_->stopStream();
+        }
+        QDialog::reject();
+    }
+
+    void PubSubDialog::startPubSub(const EventsInfo::PubSubRequest& req)
+    {
+        if(req.ring_ != ring_){
+            return;
+        }
+
+        running_ = true;
+        startButton_->setEnabled(false);
+        stopButton_->setEnabled(true);
+        drainTimer_->start();
+    }
+
+    void PubSubDialog::finishPubSub(const EventsInfo::PubSubResponce& res)
+    {
+        if(res.ring_ != ring_){
+            return;
+        }
+
+        running_ = false;
+        startButton_->setEnabled(true);
+        stopButton_->setEnabled(false);
+        drainTimer_->stop();
+        drain();
+
+        common::Error er = res.errorInfo();
+        if(er && er->isError()){
+            statusLabel_->setText(common::convertFromString<QString>(er->description()));
+        }
+    }
+
+    void PubSubDialog::start()
+    {
+        std::vector<std::string> channels, patterns;
+        const QStringList names = channels_->text().split(' ', QString::SkipEmptyParts);
+        for(int i = 0; i < names.size(); ++i){
+            const std::string name = common::convertToString(names[i]);
+            (isChannelPattern(name) ? patterns : channels).push_back(name);
+        }
+
+        if(channels.empty() && patterns.empty()){
+            return;
+        }
+
+        ring_ = PubSubRingSPtr(new PubSubRing(PUBSUB_RING_SIZE));
+        stats_.clear();
+        capture_.clear();
+        received_ = 0;
+        EventsInfo::PubSubRequest req(this, channels, patterns, ring_);
+        server_->subscribe(req);
+    }
+
+    void PubSubDialog::stop()
+    {
+        server_->stopStream();
+    }
+
+    // a paused view still counts rates, only the capture stands still
+    void PubSubDialog::drain()
+    {
+        if(!ring_){
+            return;
+        }
+
+        drained_.clear();
+        ring_->pop(&drained_, PUBSUB_RING_SIZE);
+        const bool paused = pauseButton_->isChecked();
+        for(size_t i = 0; i < drained_.size(); ++i){
+            stats_.add(drained_[i]);
+            if(!paused){
+                capture_.push_back(PubSubMessage());
+                std::swap(capture_.back(), drained_[i]);
+            }
+        }
+        received_ += drained_.size();
+
+        while(capture_.size() > PUBSUB_CAPTURE_SIZE){
+            capture_.pop_front();
+        }
+
+        const std::vector<PubSubChannelRate> rates = stats_.tick(common::time::current_mstime());
+        rates_->setRowCount(rates.size());
+        for(size_t i = 0; i < rates.size(); ++i){
+            rates_->setItem(i, eChannel, new QTableWidgetItem(common::convertFromString<QString>(rates[i].channel_)));
+            rates_->setItem(i, eTotal, new QTableWidgetItem(QString::number(rates[i].total_)));
+            rates_->setItem(i, eRate, new QTableWidgetItem(QString::number(rates[i].perSec_, 'f', 1)));
+        }
+
+        if(!paused && !drained_.empty()){
+            updateMessages();
+        }
+        updateStatus();
+    }
+
+    void PubSubDialog::updateMessages()
+    {
+        const std::string filter = common::convertToString(filter_->text());
+        std::vector<const PubSubMessage*> rows;
+        for(std::deque<PubSubMessage>::const_reverse_iterator it = capture_.rbegin();
+            it != capture_.rend() && rows.size() < PUBSUB_VIEW_ROWS; ++it){
+            if(matchesFilter(*it, filter)){
+                rows.push_back(&*it);
+            }
+        }
+
+        messages_->setRowCount(rows.size());
+        for(size_t i = 0; i < rows.size(); ++i){
+            const PubSubMessage* msg = rows[rows.size() - i - 1];
+            messages_->setItem(i, eTime, new QTableWidgetItem(messageTime(msg->msec_)));
+            messages_->setItem(i, eMessageChannel, new QTableWidgetItem(common::convertFromString<QString>(msg->channel_)));
+            messages_->setItem(i, ePayload, new QTableWidgetItem(common::convertFromString<QString>(msg->payload_)));
+        }
+        messages_->scrollToBottom();
+    }
+
+    void PubSubDialog::updateStatus()
+    {
+        statusLabel_->setText(tr("%1 received, %2 dropped, %3 captured").arg(received_)
+                              .arg(ring_ ? ring_->dropped() : 0).arg(capture_.size()));
+    }
+
+    // the filtered capture, as a JSON array
+    void PubSubDialog::exportMessages()
+    {
+        using namespace translations;
+        QString filepath = QFileDialog::getSaveFileName(this, trExport, QString(), tr("Messages (*.json)"));
+        if(filepath.isNull()){
+            return;
+        }
+
+        const std::string filter = common::convertToString(filter_->text());
+        QJsonArray messages;
+        for(std::deque<PubSubMessage>::const_iterator it = capture_.begin(); it != capture_.end(); ++it){
+            if(!matchesFilter(*it, filter)){
+                continue;
+            }
+
+            QJsonObject obj;
+            obj["msec"] = static_cast<double>(it->msec_);
+            if(!it->pattern_.empty()){
+                obj["pattern"] = common::convertFromString<QString>(it->pattern_);
+            }
+            obj["channel"] = common::convertFromString<QString>(it->channel_);
+            obj["payload"] = common::convertFromString<QString>(it->payload_);
+            messages.append(obj);
+        }
+
+        QFile file(filepath);
+        const QByteArray json = QJsonDocument(messages).toJson();
+        if(!file.open(QIODevice::WriteOnly) || file.write(json) != json.size()){
+            QMessageBox::critical(this, trError, tr("Couldn't write %1").arg(filepath));
+        }
+    }
+
+    void PubSubDialog::changeEvent(QEvent* e)
+    {
+        if(e->type() == QEvent::LanguageChange){
+            retranslateUi();
+        }
+        QDialog::changeEvent(e);
+    }
+
+    void PubSubDialog::retranslateUi()
+    {
+        using namespace translations;
+        setWindowTitle(tr("%1 Pub/Sub").arg(server_->name()));
+
+        channelsLabel_->setText(tr("Channels:"));
+        channels_->setPlaceholderText(tr("Space separated, names with * ? [ are patterns"));
+        startButton_->setText(tr("Subscribe"));
+        stopButton_->setText(trStop);
+        filterLabel_->setText(tr("Filter:"));
+        pauseButton_->setText(tr("Pause"));
+        exportButton_->setText(trExport);
+
+        QStringList rates;
+        rates << tr("Channel") << tr("Messages") << tr("Messages/sec");
+        rates_->setHorizontalHeaderLabels(rates);
+
+        QStringList messages;
+        messages << tr("Time") << tr("Channel") << tr("Payload");
+        messages_->setHorizontalHeaderLabels(messages);
+        updateStatus();
+    }
+}
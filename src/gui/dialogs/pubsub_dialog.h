@@ -0,0 +1,73 @@
+#pragma once
+
+#include <deque>
+
+#include <QDialog>
+
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QTableWidget;
+class QTimer;
+
+#include "core/events/events_info.h"
+
+namespace fastonosql
+{
+    // Subscribes on a connection of its own and shows per channel rates and
+    // the latest messages; a bounded capture of them can be exported.
+    class PubSubDialog
+            : public QDialog
+    {
+        Q_OBJECT
+    public:
+        explicit PubSubDialog(IServerSPtr server, QWidget* parent = 0);
+
+        enum
+        {
+            height = 480,
+            width = 640
+        };
+
+    public Q_SLOTS:
+        virtual void reject();
+
+    private Q_SLOTS:
+        void startPubSub(const EventsInfo::PubSubRequest& req);
+        void finishPubSub(const EventsInfo::PubSubResponce& res);
+
+        void start();
+        void stop();
+        void drain();
+        void updateMessages();
+        void exportMessages();
+
+    protected:
+        virtual void changeEvent(QEvent* e);
+
+    private:
+        void retranslateUi();
+        void updateStatus();
+
+        QLabel* channelsLabel_;
+        QLineEdit* channels_;
+        QPushButton* startButton_;
+        QPushButton* stopButton_;
+        QPushButton* pauseButton_;
+        QPushButton* exportButton_;
+        QLabel* filterLabel_;
+        QLineEdit* filter_;
+        QLabel* statusLabel_;
+        QTableWidget* rates_;
+        QTableWidget* messages_;
+        QTimer* drainTimer_;
+
+        const IServerSPtr server_;
+        PubSubRingSPtr ring_;
+        PubSubChannelStats stats_;
+        std::deque<PubSubMessage> capture_; // the newest last
+        std::vector<PubSubMessage> drained_;
+        uint64_t received_;
+        bool running_;
+    };
+}
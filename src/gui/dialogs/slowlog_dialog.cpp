@@ -0,0 +1,251 @@
+#include "gui/dialogs/slowlog_dialog.h"
+
+#include <algorithm>
+
+#include <QDateTime>
+#include <QDialogButtonBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QSpinBox>
+#include <QTabWidget>
+#include <QTableWidget>
+#include <QTimer>
+#include <QVBoxLayout>
+#include <QEvent>
+
+#include "common/qt/convert_string.h"
+
+#include "core/iserver.h"
+
+#include "gui/gui_factory.h"
+
+#include "translations/global.h"
+
+#define SLOWLOG_DEFAULT_INTERVAL_SEC 5
+#define SLOWLOG_MAX_INTERVAL_SEC 3600
+#define SLOWLOG_VIEW_ROWS 500
+
+namespace
+{
+    enum
+    {
+        eGroupCommand = 0,
+        eGroupPattern,
+        eGroupCount,
+        eGroupTotal,
+        eGroupP50,
+        eGroupP99,
+        eGroupMax,
+        eGroupCalls,
+        eGroupUsecPerCall,
+        eGroupColumnsCount
+    };
+
+    enum
+    {
+        eCommand = 0,
+        eCommandCalls,
+        eCommandUsecPerCall,
+        eCommandWindowUsecPerCall,
+        eCommandTrend,
+        eCommandColumnsCount
+    };
+
+    enum
+    {
+        eEntryId = 0,
+        eEntryTime,
+        eEntryUsec,
+        eEntryClient,
+        eEntryArgs,
+        eEntryColumnsCount
+    };
+
+    QTableWidgetItem* numberItem(double value, int precision = 0)
+    {
+        return new QTableWidgetItem(value < 0 ? QString() : QString::number(value, 'f', precision));
+    }
+
+    // server time per call against the window, "+25%" is slower
+    QString trendText(double value, double base)
+    {
+        if(value < 0 || base <= 0){
+            return QString();
+        }
+
+        const double change = (value - base) * 100.0 / base;
+        return QString("%1%2%").arg(change > 0 ? "+" : "").arg(change, 0, 'f', 1);
+    }
+}
+
+namespace fastonosql
+{
+    SlowLogDialog::SlowLogDialog(IServerSPtr server, QWidget* parent)
+        : QDialog(parent, Qt::WindowMinMaxButtonsHint | Qt::WindowCloseButtonHint), server_(server), analyzer_(), pending_(false)
+    {
+        CHECK(server_);
+        setWindowIcon(GuiFactory::instance().icon(server_->type()));
+
+        QHBoxLayout* intervalLayout = new QHBoxLayout;
+        intervalLabel_ = new QLabel;
+        interval_ = new QSpinBox;
+        interval_->setRange(1, SLOWLOG_MAX_INTERVAL_SEC);
+        interval_->setValue(SLOWLOG_DEFAULT_INTERVAL_SEC);
+        VERIFY(connect(interval_, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this, &SlowLogDialog::changeInterval));
+        statusLabel_ = new QLabel;
+        intervalLayout->addWidget(intervalLabel_);
+        intervalLayout->addWidget(interval_);
+        intervalLayout->addWidget(statusLabel_, 1);
+
+        tabs_ = new QTabWidget;
+        groups_ = addTable(eGroupColumnsCount);
+        commands_ = addTable(eCommandColumnsCount);
+        entries_ = addTable(eEntryColumnsCount);
+        entries_->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+        entries_->horizontalHeader()->setStretchLastSection(true);
+
+        QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+        VERIFY(connect(buttonBox, &QDialogButtonBox::rejected, this, &SlowLogDialog::reject));
+
+        QVBoxLayout* mainLayout = new QVBoxLayout;
+        mainLayout->addLayout(intervalLayout);
+        mainLayout->addWidget(tabs_);
+        mainLayout->addWidget(buttonBox);
+        setLayout(mainLayout);
+        setMinimumSize(QSize(width, height));
+
+        pollTimer_ = new QTimer(this);
+        pollTimer_->setInterval(SLOWLOG_DEFAULT_INTERVAL_SEC * 1000);
+        VERIFY(connect(pollTimer_, &QTimer::timeout, this, &SlowLogDialog::poll));
+
+        VERIFY(connect(server.get(), &IServer::finishedSlowLog, this, &SlowLogDialog::finishSlowLog));
+        retranslateUi();
+
+        pollTimer_->start();
+        poll();
+    }
+
+    QTableWidget* SlowLogDialog::addTable(int columns)
+    {
+        QTableWidget* table = new QTableWidget(0, columns);
+        table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+        table->verticalHeader()->hide();
+        tabs_->addTab(table, QString());
+        return table;
+    }
+
+    // a poll still on its way isn't doubled by a short interval or a slow server
+    void SlowLogDialog::poll()
+    {
+        if(pending_){
+            return;
+        }
+
+        pending_ = true;
+        EventsInfo::SlowLogRequest req(this, analyzer_.lastId());
+        server_->slowLog(req);
+    }
+
+    void SlowLogDialog::changeInterval(int sec)
+    {
+        pollTimer_->setInterval(sec * 1000);
+    }
+
+    void SlowLogDialog::finishSlowLog(const EventsInfo::SlowLogResponce& res)
+    {
+        if(res.initiator() != this){
+            return;
+        }
+
+        pending_ = false;
+        common::Error er = res.errorInfo();
+        if(er && er->isError()){
+            statusLabel_->setText(common::convertFromString<QString>(er->description()));
+            return;
+        }
+
+        analyzer_.addEntries(res.entries_);
+        analyzer_.addCommandStats(res.msec_, res.stats_);
+        statusLabel_->setText(tr("%1 slow entries, last polled %2").arg(analyzer_.entries().size())
+                              .arg(QDateTime::fromMSecsSinceEpoch(res.msec_).toString("hh:mm:ss")));
+        updateTables();
+    }
+
+    void SlowLogDialog::updateTables()
+    {
+        const std::vector<SlowLogGroup> groups = analyzer_.groups();
+        groups_->setRowCount(groups.size());
+        for(size_t i = 0; i < groups.size(); ++i){
+            const SlowLogGroup& group = groups[i];
+            groups_->setItem(i, eGroupCommand, new QTableWidgetItem(common::convertFromString<QString>(group.command_)));
+            groups_->setItem(i, eGroupPattern, new QTableWidgetItem(common::convertFromString<QString>(group.pattern_)));
+            groups_->setItem(i, eGroupCount, numberItem(group.count_));
+            groups_->setItem(i, eGroupTotal, numberItem(group.totalUsec_));
+            groups_->setItem(i, eGroupP50, numberItem(group.p50Usec_));
+            groups_->setItem(i, eGroupP99, numberItem(group.p99Usec_));
+            groups_->setItem(i, eGroupMax, numberItem(group.maxUsec_));
+            groups_->setItem(i, eGroupCalls, numberItem(group.callsPerSec_, 1));
+            groups_->setItem(i, eGroupUsecPerCall, numberItem(group.usecPerCall_, 2));
+        }
+
+        const std::vector<CommandTrend> trends = analyzer_.trends();
+        commands_->setRowCount(trends.size());
+        for(size_t i = 0; i < trends.size(); ++i){
+            const CommandTrend& trend = trends[i];
+            commands_->setItem(i, eCommand, new QTableWidgetItem(common::convertFromString<QString>(trend.command_)));
+            commands_->setItem(i, eCommandCalls, numberItem(trend.callsPerSec_, 1));
+            commands_->setItem(i, eCommandUsecPerCall, numberItem(trend.usecPerCall_, 2));
+            commands_->setItem(i, eCommandWindowUsecPerCall, numberItem(trend.windowUsecPerCall_, 2));
+            commands_->setItem(i, eCommandTrend, new QTableWidgetItem(trendText(trend.usecPerCall_, trend.windowUsecPerCall_)));
+        }
+
+        // the newest first
+        const std::deque<SlowLogEntry>& entries = analyzer_.entries();
+        const size_t count = std::min<size_t>(entries.size(), SLOWLOG_VIEW_ROWS);
+        entries_->setRowCount(count);
+        for(size_t i = 0; i < count; ++i){
+            const SlowLogEntry& entry = entries[entries.size() - i - 1];
+            entries_->setItem(i, eEntryId, numberItem(entry.id_));
+            entries_->setItem(i, eEntryTime, new QTableWidgetItem(QDateTime::fromTime_t(entry.time_).toString("yyyy-MM-dd hh:mm:ss")));
+            entries_->setItem(i, eEntryUsec, numberItem(entry.usec_));
+            entries_->setItem(i, eEntryClient, new QTableWidgetItem(common::convertFromString<QString>(entry.client_)));
+            entries_->setItem(i, eEntryArgs, new QTableWidgetItem(common::convertFromString<QString>(entry.args_)));
+        }
+    }
+
+    void SlowLogDialog::changeEvent(QEvent* e)
+    {
+        if(e->type() == QEvent::LanguageChange){
+            retranslateUi();
+        }
+        QDialog::changeEvent(e);
+    }
+
+    void SlowLogDialog::retranslateUi()
+    {
+        using namespace translations;
+        setWindowTitle(tr("%1 slow log").arg(server_->name()));
+
+        intervalLabel_->setText(trRefreshInterval);
+        interval_->setSuffix(tr(" sec"));
+
+        tabs_->setTabText(0, tr("Slow groups"));
+        tabs_->setTabText(1, tr("Commands"));
+        tabs_->setTabText(2, tr("Slow entries"));
+
+        QStringList groups;
+        groups << tr("Command") << tr("Key pattern") << tr("Count") << tr("Total, usec") << tr("p50, usec")
+               << tr("p99, usec") << tr("Max, usec") << tr("Calls/sec") << tr("usec/call");
+        groups_->setHorizontalHeaderLabels(groups);
+
+        QStringList commands;
+        commands << tr("Command") << tr("Calls/sec") << tr("usec/call") << tr("usec/call, window") << tr("Trend");
+        commands_->setHorizontalHeaderLabels(commands);
+
+        QStringList entries;
+        entries << tr("Id") << tr("Time") << tr("usec") << tr("Client") << tr("Command");
+        entries_->setHorizontalHeaderLabels(entries);
+    }
+}
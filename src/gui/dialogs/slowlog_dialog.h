@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QDialog>
+
+class QLabel;
+class QSpinBox;
+class QTabWidget;
+class QTableWidget;
+class QTimer;
+
+#include "core/events/events_info.h"
+
+namespace fastonosql
+{
+    // Slow log of one server polled by id, grouped by command and key
+    // pattern, next to the command rates and server time per call.
+    class SlowLogDialog
+            : public QDialog
+    {
+        Q_OBJECT
+    public:
+        explicit SlowLogDialog(IServerSPtr server, QWidget* parent = 0);
+
+        enum
+        {
+            height = 480,
+            width = 800
+        };
+
+    private Q_SLOTS:
+        void finishSlowLog(const EventsInfo::SlowLogResponce& res);
+
+        void poll();
+        void changeInterval(int sec);
+
+    protected:
+        virtual void changeEvent(QEvent* e);
+
+    private:
+        void retranslateUi();
+        void updateTables();
+        QTableWidget* addTable(int columns);
+
+        QLabel* intervalLabel_;
+        QSpinBox* interval_;
+        QLabel* statusLabel_;
+        QTabWidget* tabs_;
+        QTableWidget* groups_;
+        QTableWidget* commands_;
+        QTableWidget* entries_;
+        QTimer* pollTimer_;
+
+        const IServerSPtr server_;
+        SlowLogAnalyzer analyzer_;
+        bool pending_;
+    };
+}
@@ -7,6 +7,7 @@
 #include <QLineEdit>
 #include <QSpinBox>
 #include <QLabel>
+#include <QCheckBox>
 #include <QScrollBar>
 #include <QSplitter>
 #include <QStyledItemDelegate>
@@ -99,6 +100,10 @@ namespace fastonosql
         VERIFY(connect(searchBox_, &QLineEdit::textChanged, this, &ViewKeysDialog::searchLineChanged));
         searchLayout->addWidget(searchBox_);
 
+        regexCheckBox_ = new QCheckBox(tr("Regex"));
+        VERIFY(connect(regexCheckBox_, &QCheckBox::toggled, this, &ViewKeysDialog::searchModeChanged));
+        searchLayout->addWidget(regexCheckBox_);
+
         countSpinEdit_ = new QSpinBox;
         countSpinEdit_->setRange(min_key_on_page, max_key_on_page);
         countSpinEdit_->setSingleStep(step_keys_on_page);
@@ -251,9 +256,11 @@ namespace fastonosql
         }
 
         DCHECK(cursorStack_[0] == 0);
+        const KeysFilter::PatternType ptype = regexCheckBox_->isChecked() ? KeysFilter::REGEX : KeysFilter::GLOB;
         if(forward){
             EventsInfo::LoadDatabaseContentRequest req(this, db_->info(),
                                                        common::convertToString(pattern), countSpinEdit_->value(), cursorStack_[curPos_]);
+            req.patternType_ = ptype;
             db_->loadContent(req);
             ++curPos_;
         }
@@ -261,6 +268,7 @@ namespace fastonosql
             if(curPos_ > 0){
                 EventsInfo::LoadDatabaseContentRequest req(this, db_->info(),
                                                            common::convertToString(pattern), countSpinEdit_->value(), cursorStack_[--curPos_]);
+                req.patternType_ = ptype;
                 db_->loadContent(req);
             }
         }
@@ -274,6 +282,12 @@ namespace fastonosql
         updateControls();
     }
 
+    void ViewKeysDialog::searchModeChanged(bool regex)
+    {
+        UNUSED(regex);
+        searchLineChanged(searchBox_->text());
+    }
+
     void ViewKeysDialog::leftPageClicked()
     {
         search(false);
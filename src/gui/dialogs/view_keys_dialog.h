@@ -7,6 +7,7 @@
 class QLineEdit;
 class QSpinBox;
 class QLabel;
+class QCheckBox;
 
 namespace fastonosql
 {
@@ -40,6 +41,7 @@ namespace fastonosql
         void executeCommand(CommandKeySPtr cmd);
 
         void searchLineChanged(const QString& text);
+        void searchModeChanged(bool regex);
         void leftPageClicked();
         void rightPageClicked();
 
@@ -55,6 +57,7 @@ namespace fastonosql
         std::vector<uint32_t> cursorStack_;
         uint32_t curPos_;
         QLineEdit* searchBox_;
+        QCheckBox* regexCheckBox_;
         QLabel* keyCountLabel_;
         QSpinBox* countSpinEdit_;
 
@@ -148,11 +148,28 @@ namespace fastonosql
         return db_;
     }
 
-    void ExplorerDatabaseItem::loadContent(const std::string& pattern, uint32_t countKeys)
+    void ExplorerDatabaseItem::loadContent(const std::string& pattern, uint32_t countKeys,
+                                           KeysFilter::PatternType ptype, common::Value::Type type)
     {
         IDatabaseSPtr dbs = db();
         if(dbs){
             EventsInfo::LoadDatabaseContentRequest req(this, dbs->info(), pattern, countKeys);
+            req.patternType_ = ptype;
+            req.keysType_ = type;
+            dbs->loadContent(req);
+        }
+    }
+
+    void ExplorerDatabaseItem::searchValues(const std::string& pattern, KeysFilter::PatternType ptype, const std::string& value,
+                                            ValueMatcher::MatchType vtype, uint32_t countKeys, uint32_t maxKeysPerSecond)
+    {
+        IDatabaseSPtr dbs = db();
+        if(dbs){
+            EventsInfo::LoadDatabaseContentRequest req(this, dbs->info(), pattern, countKeys);
+            req.patternType_ = ptype;
+            req.valuePattern_ = value;
+            req.valueMatchType_ = vtype;
+            req.maxKeysPerSecond_ = maxKeysPerSecond;
             dbs->loadContent(req);
         }
     }
@@ -181,11 +198,11 @@ namespace fastonosql
         }
     }
 
-    void ExplorerDatabaseItem::loadValue(const NDbKValue& key)
+    void ExplorerDatabaseItem::loadValue(const NDbKValue& key, uint32_t page)
     {
         IDatabaseSPtr dbs = db();
         if(dbs){
-            CommandKeySPtr cmd(new CommandLoadKey(key));
+            CommandKeySPtr cmd(new CommandLoadKey(key, page));
             EventsInfo::CommandRequest req(this, dbs->info(), cmd);
             dbs->executeCommand(req);
         }
@@ -202,7 +219,7 @@ namespace fastonosql
     }
 
     ExplorerKeyItem::ExplorerKeyItem(const NDbKValue& key, ExplorerDatabaseItem* parent)
-        : IExplorerTreeItem(parent), key_(key)
+        : IExplorerTreeItem(parent), key_(key), page_(0), lastPage_(false)
     {
     }
 
@@ -253,10 +270,40 @@ namespace fastonosql
     {
         ExplorerDatabaseItem* par = parent();
         if(par){
-            par->loadValue(key_);
+            page_ = 0;
+            lastPage_ = false;
+            par->loadValue(key_, page_);
         }
     }
 
+    void ExplorerKeyItem::loadNextPageFromDb()
+    {
+        ExplorerDatabaseItem* par = parent();
+        if(par && !lastPage_){
+            par->loadValue(key_, ++page_);
+        }
+    }
+
+    void ExplorerKeyItem::loadFullValueFromDb()
+    {
+        ExplorerDatabaseItem* par = parent();
+        if(par){
+            page_ = 0;
+            par->loadValue(key_, LOAD_ALL_PAGES);
+        }
+    }
+
+    bool ExplorerKeyItem::hasNextPage() const
+    {
+        return !lastPage_;
+    }
+
+    // a page shorter than the driver's page size ends the value
+    void ExplorerKeyItem::setLastPage(bool last)
+    {
+        lastPage_ = last;
+    }
+
     ExplorerTreeModel::ExplorerTreeModel(QObject *parent)
         : TreeModel(parent)
     {
@@ -302,6 +349,18 @@ namespace fastonosql
                     return QString("<b>Db size:</b> %1 keys<br/>").arg(db->sizeDB());
                 }
             }
+            else if(t == IExplorerTreeItem::eKey){
+                ExplorerKeyItem* key = dynamic_cast<ExplorerKeyItem*>(node);
+                if(key){
+                    NDbKValue dbv = key->key();
+                    QString ktype = common::convertFromString<QString>(typeToString(dbv.type()));
+                    if(dbv.size() >= 0){
+                        return QString("<b>Type:</b> %1<br/>"
+                                       "<b>Size:</b> %2<br/>").arg(ktype).arg(dbv.size());
+                    }
+                    return QString("<b>Type:</b> %1<br/>").arg(ktype);
+                }
+            }
         }
 
         if(role == Qt::DecorationRole && col == ExplorerServerItem::eName ){
@@ -542,6 +601,24 @@ namespace fastonosql
         }
     }
 
+    void ExplorerTreeModel::setLastPage(IServer* server, DataBaseInfoSPtr db, const NDbKValue &key, bool last)
+    {
+        ExplorerServerItem *parent = findServerItem(server);
+        if(!parent){
+            return;
+        }
+
+        ExplorerDatabaseItem *dbs = findDatabaseItem(parent, db);
+        if(!dbs){
+            return;
+        }
+
+        ExplorerKeyItem *keyit = findKeyItem(dbs, key);
+        if(keyit){
+            keyit->setLastPage(last);
+        }
+    }
+
     ExplorerClusterItem* ExplorerTreeModel::findClusterItem(IClusterSPtr cl)
     {
         fasto::qt::gui::TreeItem *parent = dynamic_cast<fasto::qt::gui::TreeItem*>(root_);
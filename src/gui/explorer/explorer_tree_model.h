@@ -81,13 +81,16 @@ namespace fastonosql
         virtual IServerSPtr server() const;
         IDatabaseSPtr db() const;
 
-        void loadContent(const std::string& pattern, uint32_t countKeys);
+        void loadContent(const std::string& pattern, uint32_t countKeys,
+                         KeysFilter::PatternType ptype = KeysFilter::GLOB, common::Value::Type type = common::Value::TYPE_NULL);
+        void searchValues(const std::string& pattern, KeysFilter::PatternType ptype, const std::string& value,
+                          ValueMatcher::MatchType vtype, uint32_t countKeys, uint32_t maxKeysPerSecond);
         void setDefault();
 
         DataBaseInfoSPtr info() const;
 
         void removeKey(const NDbKValue& key);
-        void loadValue(const NDbKValue& key);
+        void loadValue(const NDbKValue& key, uint32_t page = 0);
         void createKey(const NDbKValue& key);
 
     private:
@@ -110,9 +113,16 @@ namespace fastonosql
 
         void removeFromDb();
         void loadValueFromDb();
+        void loadNextPageFromDb();
+        void loadFullValueFromDb();
+
+        bool hasNextPage() const;
+        void setLastPage(bool last);
 
     private:
         NDbKValue key_;
+        uint32_t page_;
+        bool lastPage_;
     };
 
     class ExplorerTreeModel
@@ -140,6 +150,7 @@ namespace fastonosql
 
         void addKey(IServer* server, DataBaseInfoSPtr db, const NDbKValue &dbv);
         void removeKey(IServer* server, DataBaseInfoSPtr db, const NDbKValue &key);
+        void setLastPage(IServer* server, DataBaseInfoSPtr db, const NDbKValue &key, bool last);
 
     private:
         ExplorerClusterItem* findClusterItem(IClusterSPtr cl);
@@ -12,6 +12,12 @@
 #include "gui/dialogs/info_server_dialog.h"
 #include "gui/dialogs/property_server_dialog.h"
 #include "gui/dialogs/history_server_dialog.h"
+#include "gui/dialogs/benchmark_dialog.h"
+#include "gui/dialogs/monitor_dialog.h"
+#include "gui/dialogs/pubsub_dialog.h"
+#include "gui/dialogs/slowlog_dialog.h"
+#include "gui/dialogs/clients_dialog.h"
+#include "gui/dialogs/keyspace_dialog.h"
 #include "gui/dialogs/load_contentdb_dialog.h"
 #include "gui/dialogs/create_dbkey_dialog.h"
 #include "gui/dialogs/view_keys_dialog.h"
@@ -27,6 +33,33 @@
 
 namespace fastonosql
 {
+    namespace
+    {
+        // elements (bytes for strings) above which full load is confirmed
+        const int64_t fullLoadWarnSize = 10000;
+        const int64_t fullLoadWarnBytes = 1024 * 1024;
+
+        // values which drivers load page by page
+        bool isPagedValue(ExplorerKeyItem* key)
+        {
+            IServerSPtr server = key->server();
+            if(!server){
+                return false;
+            }
+
+            common::Value::Type t = key->key().type();
+            bool collection = t == common::Value::TYPE_HASH || t == common::Value::TYPE_ZSET || t == common::Value::TYPE_ARRAY;
+            if(server->type() == REDIS){
+                return collection || t == common::Value::TYPE_SET || t == common::Value::TYPE_STRING || t == TYPE_STREAM;
+            }
+            else if(server->type() == SSDB){
+                return collection;
+            }
+
+            return false;
+        }
+    }
+
     ExplorerTreeView::ExplorerTreeView(QWidget* parent)
         : QTreeView(parent)
     {
@@ -62,6 +95,24 @@ namespace fastonosql
         clearHistoryServerAction_ = new QAction(this);
         VERIFY(connect(clearHistoryServerAction_, &QAction::triggered, this, &ExplorerTreeView::clearHistory));
 
+        benchmarkServerAction_ = new QAction(this);
+        VERIFY(connect(benchmarkServerAction_, &QAction::triggered, this, &ExplorerTreeView::openBenchmarkDialog));
+
+        monitorServerAction_ = new QAction(this);
+        VERIFY(connect(monitorServerAction_, &QAction::triggered, this, &ExplorerTreeView::openMonitorDialog));
+
+        pubSubServerAction_ = new QAction(this);
+        VERIFY(connect(pubSubServerAction_, &QAction::triggered, this, &ExplorerTreeView::openPubSubDialog));
+
+        slowLogServerAction_ = new QAction(this);
+        VERIFY(connect(slowLogServerAction_, &QAction::triggered, this, &ExplorerTreeView::openSlowLogDialog));
+
+        clientsServerAction_ = new QAction(this);
+        VERIFY(connect(clientsServerAction_, &QAction::triggered, this, &ExplorerTreeView::openClientsDialog));
+
+        keyspaceServerAction_ = new QAction(this);
+        VERIFY(connect(keyspaceServerAction_, &QAction::triggered, this, &ExplorerTreeView::openKeyspaceDialog));
+
         closeServerAction_ = new QAction(this);
         VERIFY(connect(closeServerAction_, &QAction::triggered, this, &ExplorerTreeView::closeServerConnection));
 
@@ -80,6 +131,9 @@ namespace fastonosql
         loadContentAction_ = new QAction(this);
         VERIFY(connect(loadContentAction_, &QAction::triggered, this, &ExplorerTreeView::loadContentDb));
 
+        searchValuesAction_ = new QAction(this);
+        VERIFY(connect(searchValuesAction_, &QAction::triggered, this, &ExplorerTreeView::searchValuesDb));
+
         setDefaultDbAction_ = new QAction(this);
         VERIFY(connect(setDefaultDbAction_, &QAction::triggered, this, &ExplorerTreeView::setDefaultDb));
 
@@ -92,6 +146,15 @@ namespace fastonosql
         getValueAction_ = new QAction(this);
         VERIFY(connect(getValueAction_, &QAction::triggered, this, &ExplorerTreeView::getValue));
 
+        getNextPageAction_ = new QAction(this);
+        VERIFY(connect(getNextPageAction_, &QAction::triggered, this, &ExplorerTreeView::getNextPage));
+
+        getFullValueAction_ = new QAction(this);
+        VERIFY(connect(getFullValueAction_, &QAction::triggered, this, &ExplorerTreeView::getFullValue));
+
+        stopLoadValueAction_ = new QAction(this);
+        VERIFY(connect(stopLoadValueAction_, &QAction::triggered, this, &ExplorerTreeView::stopLoadValue));
+
         deleteKeyAction_ = new QAction(this);
         VERIFY(connect(deleteKeyAction_, &QAction::triggered, this, &ExplorerTreeView::deleteKey));
 
@@ -218,6 +281,18 @@ namespace fastonosql
 
                 menu.addAction(historyServerAction_);
                 menu.addAction(clearHistoryServerAction_);
+                benchmarkServerAction_->setEnabled(isAuth);
+                menu.addAction(benchmarkServerAction_);
+                monitorServerAction_->setEnabled(isAuth && server->type() == REDIS);
+                menu.addAction(monitorServerAction_);
+                pubSubServerAction_->setEnabled(isAuth && server->type() == REDIS);
+                menu.addAction(pubSubServerAction_);
+                slowLogServerAction_->setEnabled(isAuth && server->type() == REDIS);
+                menu.addAction(slowLogServerAction_);
+                clientsServerAction_->setEnabled(isAuth && server->type() == REDIS);
+                menu.addAction(clientsServerAction_);
+                keyspaceServerAction_->setEnabled(isAuth && server->type() == REDIS);
+                menu.addAction(keyspaceServerAction_);
                 closeServerAction_->setEnabled(!isClusterMember);
                 menu.addAction(closeServerAction_);
 
@@ -238,6 +313,8 @@ namespace fastonosql
                 menu.addAction(loadContentAction_);
                 bool isDefault = db && db->isDefault();
                 loadContentAction_->setEnabled(isDefault);
+                menu.addAction(searchValuesAction_);
+                searchValuesAction_->setEnabled(isDefault);
 
                 menu.addAction(createKeyAction_);
                 createKeyAction_->setEnabled(isDefault);
@@ -251,8 +328,15 @@ namespace fastonosql
                 menu.exec(menuPoint);
             }
             else if(node->type() == IExplorerTreeItem::eKey){
+                ExplorerKeyItem *key = dynamic_cast<ExplorerKeyItem*>(node);
                 QMenu menu(this);
                 menu.addAction(getValueAction_);
+                if(key && isPagedValue(key)){
+                    menu.addAction(getNextPageAction_);
+                    getNextPageAction_->setEnabled(key->hasNextPage());
+                    menu.addAction(getFullValueAction_);
+                    menu.addAction(stopLoadValueAction_);
+                }
                 menu.addAction(deleteKeyAction_);
                 menu.exec(menuPoint);
             }
@@ -422,6 +506,132 @@ namespace fastonosql
         histDialog.exec();
     }
 
+    void ExplorerTreeView::openBenchmarkDialog()
+    {
+        QModelIndex sel = selectedIndex();
+        if(!sel.isValid()){
+            return;
+        }
+
+        ExplorerServerItem *node = common::utils_qt::item<ExplorerServerItem*>(sel);
+        if(!node){
+            return;
+        }
+
+        IServerSPtr server = node->server();
+        if(!server){
+            return;
+        }
+
+        BenchmarkDialog benchDialog(server, this);
+        benchDialog.exec();
+    }
+
+    void ExplorerTreeView::openMonitorDialog()
+    {
+        QModelIndex sel = selectedIndex();
+        if(!sel.isValid()){
+            return;
+        }
+
+        ExplorerServerItem *node = common::utils_qt::item<ExplorerServerItem*>(sel);
+        if(!node){
+            return;
+        }
+
+        IServerSPtr server = node->server();
+        if(!server){
+            return;
+        }
+
+        MonitorDialog monitorDialog(server, this);
+        monitorDialog.exec();
+    }
+
+    void ExplorerTreeView::openPubSubDialog()
+    {
+        QModelIndex sel = selectedIndex();
+        if(!sel.isValid()){
+            return;
+        }
+
+        ExplorerServerItem *node = common::utils_qt::item<ExplorerServerItem*>(sel);
+        if(!node){
+            return;
+        }
+
+        IServerSPtr server = node->server();
+        if(!server){
+            return;
+        }
+
+        PubSubDialog pubSubDialog(server, this);
+        pubSubDialog.exec();
+    }
+
+    void ExplorerTreeView::openSlowLogDialog()
+    {
+        QModelIndex sel = selectedIndex();
+        if(!sel.isValid()){
+            return;
+        }
+
+        ExplorerServerItem *node = common::utils_qt::item<ExplorerServerItem*>(sel);
+        if(!node){
+            return;
+        }
+
+        IServerSPtr server = node->server();
+        if(!server){
+            return;
+        }
+
+        SlowLogDialog slowLogDialog(server, this);
+        slowLogDialog.exec();
+    }
+
+    void ExplorerTreeView::openClientsDialog()
+    {
+        QModelIndex sel = selectedIndex();
+        if(!sel.isValid()){
+            return;
+        }
+
+        ExplorerServerItem *node = common::utils_qt::item<ExplorerServerItem*>(sel);
+        if(!node){
+            return;
+        }
+
+        IServerSPtr server = node->server();
+        if(!server){
+            return;
+        }
+
+        ClientsDialog clientsDialog(server, this);
+        clientsDialog.exec();
+    }
+
+    void ExplorerTreeView::openKeyspaceDialog()
+    {
+        QModelIndex sel = selectedIndex();
+        if(!sel.isValid()){
+            return;
+        }
+
+        ExplorerServerItem *node = common::utils_qt::item<ExplorerServerItem*>(sel);
+        if(!node){
+            return;
+        }
+
+        IServerSPtr server = node->server();
+        if(!server){
+            return;
+        }
+
+        KeyspaceDialog keyspaceDialog(server, this);
+        keyspaceDialog.exec();
+    }
+
     void ExplorerTreeView::clearHistory()
     {
         QModelIndex sel = selectedIndex();
@@ -568,7 +778,26 @@ namespace fastonosql
             LoadContentDbDialog loadDb(QString("Load %1 content").arg(node->name()), node->server()->type(), this);
             int result = loadDb.exec();
             if(result == QDialog::Accepted){
-                node->loadContent(common::convertToString(loadDb.pattern()), loadDb.count());
+                node->loadContent(common::convertToString(loadDb.pattern()), loadDb.count(), loadDb.patternType(), loadDb.keysType());
+            }
+        }
+    }
+
+    void ExplorerTreeView::searchValuesDb()
+    {
+        QModelIndex sel = selectedIndex();
+        if(!sel.isValid()){
+            return;
+        }
+
+        ExplorerDatabaseItem *node = common::utils_qt::item<ExplorerDatabaseItem*>(sel);
+        if(node){
+            LoadContentDbDialog searchDb(QString("Search %1 values").arg(node->name()), node->server()->type(), this, true);
+            int result = searchDb.exec();
+            if(result == QDialog::Accepted){
+                node->searchValues(common::convertToString(searchDb.pattern()), searchDb.patternType(),
+                                   common::convertToString(searchDb.valuePattern()), searchDb.valueMatchType(),
+                                   searchDb.count(), searchDb.maxKeysPerSecond());
             }
         }
     }
@@ -631,6 +860,65 @@ namespace fastonosql
         }
     }
 
+    void ExplorerTreeView::getNextPage()
+    {
+        QModelIndex sel = selectedIndex();
+        if(!sel.isValid()){
+            return;
+        }
+
+        ExplorerKeyItem *node = common::utils_qt::item<ExplorerKeyItem*>(sel);
+        if(node){
+            node->loadNextPageFromDb();
+        }
+    }
+
+    void ExplorerTreeView::getFullValue()
+    {
+        QModelIndex sel = selectedIndex();
+        if(!sel.isValid()){
+            return;
+        }
+
+        ExplorerKeyItem *node = common::utils_qt::item<ExplorerKeyItem*>(sel);
+        if(!node){
+            return;
+        }
+
+        NDbKValue key = node->key();
+        int64_t limit = key.type() == common::Value::TYPE_STRING ? fullLoadWarnBytes : fullLoadWarnSize;
+        if(key.size() < 0 || key.size() > limit){
+            QString size = key.size() < 0 ? QString("unknown") : QString::number(key.size());
+            int answer = QMessageBox::question(this, trLoadFullValue, QString("Size of \"%1\" is %2, loading it whole may take a long time and a lot of memory. "
+                                                                           "Loading can be stopped between pages. Continue?").arg(node->name()).arg(size),
+                                               QMessageBox::Yes, QMessageBox::No, QMessageBox::NoButton);
+
+            if (answer != QMessageBox::Yes){
+                return;
+            }
+        }
+
+        node->loadFullValueFromDb();
+    }
+
+    void ExplorerTreeView::stopLoadValue()
+    {
+        QModelIndex sel = selectedIndex();
+        if(!sel.isValid()){
+            return;
+        }
+
+        ExplorerKeyItem *node = common::utils_qt::item<ExplorerKeyItem*>(sel);
+        if(!node){
+            return;
+        }
+
+        IServerSPtr server = node->server();
+        if(server){
+            server->stopCurrentEvent();
+        }
+    }
+
     void ExplorerTreeView::deleteKey()
     {
         QModelIndex sel = selectedIndex();
@@ -768,6 +1056,36 @@ namespace fastonosql
         else if(key->type() == CommandKey::C_CREATE){            
             mod->addKey(serv, res.inf_, dbv);
         }
+        else if(key->type() == CommandKey::C_LOAD){
+            CommandLoadKey* load = dynamic_cast<CommandLoadKey*>(key.get());
+            if(load){
+                mod->setLastPage(serv, res.inf_, dbv, load->isLastPage());
+            }
+        }
+    }
+
+    // keys deleted, expired or evicted behind the tree's back while keyspace events are read
+    void ExplorerTreeView::keyspaceSnapShot(const KeyspaceSnapShot& shot)
+    {
+        IServer* serv = qobject_cast<IServer *>(sender());
+        DCHECK(serv);
+        if(!serv){
+            return;
+        }
+
+        ExplorerTreeModel* mod = qobject_cast<ExplorerTreeModel*>(model());
+        DCHECK(mod);
+        if(!mod){
+            return;
+        }
+
+        for(size_t i = 0; i < shot.removed_.size(); ++i){
+            const KeyspaceEvent& event = shot.removed_[i];
+            IDatabaseSPtr db = serv->findDatabaseByName(common::convertToString(event.db_));
+            if(db){
+                mod->removeKey(serv, db->info(), NDbKValue(NKey(event.key_), NValue()));
+            }
+        }
     }
 
     void ExplorerTreeView::changeEvent(QEvent* e)
@@ -802,6 +1120,7 @@ namespace fastonosql
         VERIFY(connect(server, &IServer::finishedLoadDatabaseContent, this, &ExplorerTreeView::finishLoadDatabaseContent));
         VERIFY(connect(server, &IServer::startedExecuteCommand, this, &ExplorerTreeView::startExecuteCommand));
         VERIFY(connect(server, &IServer::finishedExecuteCommand, this, &ExplorerTreeView::finishExecuteCommand));
+        VERIFY(connect(server, &IServer::keyspaceSnapShot, this, &ExplorerTreeView::keyspaceSnapShot));
     }
 
     void ExplorerTreeView::unsyncWithServer(IServer* server)
@@ -818,6 +1137,7 @@ namespace fastonosql
         VERIFY(disconnect(server, &IServer::finishedLoadDatabaseContent, this, &ExplorerTreeView::finishLoadDatabaseContent));
         VERIFY(disconnect(server, &IServer::startedExecuteCommand, this, &ExplorerTreeView::startExecuteCommand));
         VERIFY(disconnect(server, &IServer::finishedExecuteCommand, this, &ExplorerTreeView::finishExecuteCommand));
+        VERIFY(disconnect(server, &IServer::keyspaceSnapShot, this, &ExplorerTreeView::keyspaceSnapShot));
     }
 
     void ExplorerTreeView::retranslateUi()
@@ -833,6 +1153,12 @@ namespace fastonosql
         setMaxClientConnection_->setText(trSetMaxNumberOfClients);
         historyServerAction_->setText(trHistory);
         clearHistoryServerAction_->setText(trClearHistory);
+        benchmarkServerAction_->setText(trBenchmark);
+        monitorServerAction_->setText(trMonitor);
+        pubSubServerAction_->setText(trPubSub);
+        slowLogServerAction_->setText(trSlowLog);
+        clientsServerAction_->setText(trClients);
+        keyspaceServerAction_->setText(trKeyspaceEvents);
         closeServerAction_->setText(trClose);
         closeClusterAction_->setText(trClose);
         backupAction_->setText(trBackup);
@@ -840,10 +1166,14 @@ namespace fastonosql
         shutdownAction_->setText(trShutdown);
 
         loadContentAction_->setText(trLoadContOfDataBases);
+        searchValuesAction_->setText(trSearchValues);
         createKeyAction_->setText(trCreateKey);
         viewKeysAction_->setText(trViewKeysDialog);
         setDefaultDbAction_->setText(trSetDefault);
         getValueAction_->setText(trValue);
+        getNextPageAction_->setText(trLoadNextPage);
+        getFullValueAction_->setText(trLoadFullValue);
+        stopLoadValueAction_->setText(trStop);
         deleteKeyAction_->setText(trDelete);
     }
 
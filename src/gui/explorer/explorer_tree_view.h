@@ -38,6 +38,12 @@ namespace fastonosql
         void openSetPasswordServerDialog();
         void openMaxClientSetDialog();
         void openHistoryServerDialog();
+        void openBenchmarkDialog();
+        void openMonitorDialog();
+        void openPubSubDialog();
+        void openSlowLogDialog();
+        void openClientsDialog();
+        void openKeyspaceDialog();
         void clearHistory();
         void closeServerConnection();
         void closeClusterConnection();
@@ -47,10 +53,14 @@ namespace fastonosql
         void shutdownServer();
 
         void loadContentDb();
+        void searchValuesDb();
         void setDefaultDb();
         void createKey();
         void viewKeys();
         void getValue();
+        void getNextPage();
+        void getFullValue();
+        void stopLoadValue();
         void deleteKey();
 
         void startLoadDatabases(const EventsInfo::LoadDatabasesInfoRequest& req);
@@ -65,6 +75,8 @@ namespace fastonosql
         void startExecuteCommand(const EventsInfo::CommandRequest& req);
         void finishExecuteCommand(const EventsInfo::CommandResponce& res);
 
+        void keyspaceSnapShot(const KeyspaceSnapShot& shot);
+
     protected:
         virtual void changeEvent(QEvent* );
         virtual void mouseDoubleClickEvent(QMouseEvent* );
@@ -80,10 +92,14 @@ namespace fastonosql
         QAction* openConsoleAction_;
         QAction* loadDatabaseAction_;
         QAction* loadContentAction_;
+        QAction* searchValuesAction_;
         QAction* setDefaultDbAction_;
         QAction* createKeyAction_;
         QAction* viewKeysAction_;
         QAction* getValueAction_;
+        QAction* getNextPageAction_;
+        QAction* getFullValueAction_;
+        QAction* stopLoadValueAction_;
         QAction* deleteKeyAction_;
         QAction* infoServerAction_;
         QAction* propertyServerAction_;
@@ -91,6 +107,12 @@ namespace fastonosql
         QAction* setMaxClientConnection_;
         QAction* historyServerAction_;
         QAction* clearHistoryServerAction_;
+        QAction* benchmarkServerAction_;
+        QAction* monitorServerAction_;
+        QAction* pubSubServerAction_;
+        QAction* slowLogServerAction_;
+        QAction* clientsServerAction_;
+        QAction* keyspaceServerAction_;
         QAction* closeServerAction_;
         QAction* closeClusterAction_;
         QAction* importAction_;
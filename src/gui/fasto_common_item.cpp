@@ -11,7 +11,13 @@
 namespace fastonosql
 {
     FastoCommonItem::FastoCommonItem(const QString& key, NValue value, bool isReadOnly, TreeItem *parent, void* internalPointer)
-        : TreeItem(parent, internalPointer), key_(key), value_(value), isReadOnly_(isReadOnly)
+        : TreeItem(parent, internalPointer), key_(key), value_(value), object_(NULL), isReadOnly_(isReadOnly)
+    {
+
+    }
+
+    FastoCommonItem::FastoCommonItem(const QString& key, FastoObject* object, bool isReadOnly, TreeItem* parent)
+        : TreeItem(parent, object), key_(key), value_(), object_(object), isReadOnly_(isReadOnly)
     {
 
     }
@@ -23,13 +29,15 @@ namespace fastonosql
 
     QString FastoCommonItem::value() const
     {
-        if(!value_){
-            return QString();
+        if(value_){
+            return common::convertFromString<QString>(common::convertToString(value_.get(), " "));
+        }
+
+        if(object_){
+            return common::convertFromString<QString>(object_->valueString(" "));
         }
 
-        common::Value* val = value_.get();
-        std::string valstr = common::convertToString(val, " ");
-        return common::convertFromString<QString>(valstr);
+        return QString();
     }
 
     void FastoCommonItem::setValue(NValue val)
@@ -39,11 +47,20 @@ namespace fastonosql
 
     common::Value::Type FastoCommonItem::type() const
     {
-        if(!value_){
-            return common::Value::TYPE_NULL;
+        if(value_){
+            return value_->type();
+        }
+
+        if(object_){
+            return object_->type();
         }
 
-        return value_->type();
+        return common::Value::TYPE_NULL;
+    }
+
+    FastoObject* FastoCommonItem::object() const
+    {
+        return object_;
     }
 
     bool FastoCommonItem::isReadOnly() const
@@ -58,8 +75,7 @@ namespace fastonosql
         }
 
         if(!item->childrenCount()){
-            std::string res = common::json::parseJson(common::convertToString(item->value()));
-            return common::convertFromString<QString>(res);
+            return toJson(item->value());
         }
 
         QString value;
@@ -95,16 +111,7 @@ namespace fastonosql
         }
 
         if(!item->childrenCount()){
-            QString val = item->value();
-            std::string sval = common::convertToString(val);
-
-            std::string hexstr;
-            common::HexEDcoder hex;
-            common::Error er = hex.encode(sval, hexstr);
-            if(er){
-                return QString();
-            }
-            return common::convertFromString<QString>(hexstr);
+            return toHex(item->value());
         }
 
         QString value;
@@ -122,7 +129,7 @@ namespace fastonosql
         }
 
         if(!item->childrenCount()){
-            return item->value().replace(delemitr, ",");
+            return toCsv(item->value(), delemitr);
         }
 
         QString value;
@@ -143,17 +150,7 @@ namespace fastonosql
         }
 
         if(!item->childrenCount()){
-            QString val = item->value();
-            std::string sval = common::convertToString(val);
-            std::string out;
-            common::CompressEDcoder enc;
-            common::Error er = enc.decode(sval, out);
-            if(er){
-                return QString();
-            }
-            else{
-                return common::convertFromString<QString>(out);
-            }
+            return fromGzip(item->value());
         }
 
         QString value;
@@ -171,22 +168,7 @@ namespace fastonosql
         }
 
         if(!item->childrenCount()){
-            std::string sval = common::convertToString(item->value());
-
-            common::HexEDcoder hex;
-            std::string hexstr;
-            common::Error er = hex.decode(sval, hexstr);
-            if(er){
-                return QString();
-            }
-
-            common::MsgPackEDcoder msg;
-            std::string upack;
-            er = msg.decode(hexstr, upack);
-            if(er){
-                return QString();
-            }
-            return common::convertFromString<QString>(upack);
+            return fromHexMsgPack(item->value());
         }
 
         QString value;
@@ -196,4 +178,63 @@ namespace fastonosql
 
         return value;
     }
+
+    QString toJson(const QString& value)
+    {
+        std::string res = common::json::parseJson(common::convertToString(value));
+        return common::convertFromString<QString>(res);
+    }
+
+    QString toHex(const QString& value)
+    {
+        std::string sval = common::convertToString(value);
+
+        std::string hexstr;
+        common::HexEDcoder hex;
+        common::Error er = hex.encode(sval, hexstr);
+        if(er){
+            return QString();
+        }
+        return common::convertFromString<QString>(hexstr);
+    }
+
+    QString toCsv(const QString& value, const QString& delemitr)
+    {
+        QString result = value;
+        return result.replace(delemitr, ",");
+    }
+
+    QString fromGzip(const QString& value)
+    {
+        std::string sval = common::convertToString(value);
+        std::string out;
+        common::CompressEDcoder enc;
+        common::Error er = enc.decode(sval, out);
+        if(er){
+            return QString();
+        }
+        else{
+            return common::convertFromString<QString>(out);
+        }
+    }
+
+    QString fromHexMsgPack(const QString& value)
+    {
+        std::string sval = common::convertToString(value);
+
+        common::HexEDcoder hex;
+        std::string hexstr;
+        common::Error er = hex.decode(sval, hexstr);
+        if(er){
+            return QString();
+        }
+
+        common::MsgPackEDcoder msg;
+        std::string upack;
+        er = msg.decode(hexstr, upack);
+        if(er){
+            return QString();
+        }
+        return common::convertFromString<QString>(upack);
+    }
 }
@@ -19,10 +19,14 @@ namespace fastonosql
             eCountColumns = 3
         };
         FastoCommonItem(const QString& key, NValue value, bool isReadOnly, TreeItem* parent, void* internalPointer);
+        // reads the value of object until setValue, object must outlive the item;
+        // object values are read under the value lock of the result tree
+        FastoCommonItem(const QString& key, FastoObject* object, bool isReadOnly, TreeItem* parent);
 
         QString key() const;
         QString value() const;        
         common::Value::Type type() const;
+        FastoObject* object() const;
 
         bool isReadOnly() const;
 
@@ -31,6 +35,7 @@ namespace fastonosql
     private:
         QString key_;
         NValue value_;
+        FastoObject* object_;
         bool isReadOnly_;
     };
 
@@ -41,5 +46,12 @@ namespace fastonosql
 
     QString fromGzip(FastoCommonItem* item);
     QString fromHexMsgPack(FastoCommonItem* item);
+
+    // the same for one leaf value
+    QString toJson(const QString& value);
+    QString toHex(const QString& value);
+    QString toCsv(const QString& value, const QString& delemitr);
+    QString fromGzip(const QString& value);
+    QString fromHexMsgPack(const QString& value);
 }
 
@@ -1,5 +1,7 @@
 #include "gui/fasto_common_model.h"
 
+#include <algorithm>
+
 #include "gui/fasto_common_item.h"
 #include "gui/gui_factory.h"
 
@@ -7,10 +9,32 @@
 #include "common/qt/convert_string.h"
 #include "translations/global.h"
 
+#define FETCH_ROWS_COUNT 256
+
+namespace
+{
+    using namespace fastonosql;
+
+    FastoCommonItem* createItem(fasto::qt::gui::TreeItem* parent, const std::string& key, bool readOnly, FastoObject* item)
+    {
+        // rows read values from the result tree kept by OutputWidget::root_
+        FastoCommonItem* result = new FastoCommonItem(common::convertFromString<QString>(key), item, readOnly, parent);
+        StreamValue* stream = item->type() == TYPE_STREAM ? dynamic_cast<StreamValue*>(item->value()) : NULL;
+        if(stream){
+            // one row per entry, built from the columns
+            for(size_t i = 0; i < stream->size(); ++i){
+                NValue entry = common::make_value(common::Value::createStringValue(stream->entryToString(i, item->delemitr())));
+                result->addChildren(new FastoCommonItem(common::convertFromString<QString>(stream->id(i)), entry, true, result, NULL));
+            }
+        }
+        return result;
+    }
+}
+
 namespace fastonosql
 {
     FastoCommonModel::FastoCommonModel(QObject* parent)
-        : TreeModel(parent)
+        : TreeModel(parent), root_(NULL), childrens_(), items_()
     {
 
     }
@@ -50,7 +74,7 @@ namespace fastonosql
                 result = node->value();
             }
             else if (col == FastoCommonItem::eType) {
-                result = common::convertFromString<QString>(common::Value::toString(node->type()));
+                result = common::convertFromString<QString>(typeToString(node->type()));
             }
         }
 
@@ -129,6 +153,26 @@ namespace fastonosql
         return FastoCommonItem::eCountColumns;
     }
 
+    bool FastoCommonModel::hasChildren(const QModelIndex& parent) const
+    {
+        FastoCommonItem* item = itemByIndex(parent);
+        if(!item){
+            return false;
+        }
+
+        return item->childrenCount() || pendingCount(item);
+    }
+
+    bool FastoCommonModel::canFetchMore(const QModelIndex& parent) const
+    {
+        return pendingCount(itemByIndex(parent)) != 0;
+    }
+
+    void FastoCommonModel::fetchMore(const QModelIndex& parent)
+    {
+        fetchItems(itemByIndex(parent), FETCH_ROWS_COUNT);
+    }
+
     void FastoCommonModel::changeValue(const NDbKValue& value)
     {
         QModelIndex ind = index(0, 0);
@@ -161,4 +205,144 @@ namespace fastonosql
             }
         }
     }
+
+    void FastoCommonModel::setRootObject(FastoObject* root)
+    {
+        childrens_.clear();
+        items_.clear();
+        root_ = root ? createItem(NULL, std::string(), true, root) : NULL;
+        if(root_){
+            items_.insert(root, root_);
+        }
+        setRoot(root_);
+    }
+
+    void FastoCommonModel::appendObjects(const FastoObject::child_batch_type& objects)
+    {
+        FastoObject::child_batch_type shown;
+        std::vector<FastoCommonItem*> parents;
+        for(size_t i = 0; i < objects.size(); ++i){
+            FastoObject* child = objects[i];
+            DCHECK(child->parent());
+
+            FastoObjectCommand* command = dynamic_cast<FastoObjectCommand*>(child);
+            if(command){
+                continue;
+            }
+
+            FastoObject* parentObj = child->parent();
+            command = dynamic_cast<FastoObjectCommand*>(parentObj);
+            if(command){
+                parentObj = command->parent();
+            }
+            else if(!dynamic_cast<FastoObjectArray*>(parentObj)){
+                NOTREACHED();
+                continue;
+            }
+
+            childrens_[parentObj].push_back(child);
+            shown.push_back(child);
+
+            FastoCommonItem* par = items_.value(parentObj, NULL);
+            if(par && std::find(parents.begin(), parents.end(), par) == parents.end()){
+                parents.push_back(par);
+            }
+        }
+
+        if(!shown.empty()){
+            emit objectsAppended(shown);
+        }
+
+        // the first rows of a shown parent come right away, the rest when a view fetches them
+        for(size_t i = 0; i < parents.size(); ++i){
+            const size_t count = parents[i]->childrenCount();
+            if(count < FETCH_ROWS_COUNT){
+                fetchItems(parents[i], FETCH_ROWS_COUNT - count);
+            }
+        }
+    }
+
+    void FastoCommonModel::updateObject(FastoObject* object)
+    {
+        FastoCommonItem* item = items_.value(object, NULL);
+        fasto::qt::gui::TreeItem* par = item ? item->parent() : NULL;
+        if(par){
+            const int row = par->indexOf(item);
+            emit dataChanged(createIndex(row, FastoCommonItem::eValue, item), createIndex(row, FastoCommonItem::eType, item));
+        }
+
+        emit objectUpdated(object);
+    }
+
+    FastoCommonItem* FastoCommonModel::itemByIndex(const QModelIndex& index) const
+    {
+        if(!index.isValid()){
+            return root_;
+        }
+
+        return common::utils_qt::item<FastoCommonItem*>(index);
+    }
+
+    size_t FastoCommonModel::pendingCount(FastoCommonItem* item) const
+    {
+        FastoObject* obj = item ? item->object() : NULL;
+        if(!obj){
+            return 0;
+        }
+
+        QHash<FastoObject*, FastoObject::child_batch_type>::const_iterator it = childrens_.constFind(obj);
+        if(it == childrens_.constEnd()){
+            return 0;
+        }
+
+        const size_t shown = item->childrenCount();
+        return it.value().size() > shown ? it.value().size() - shown : 0;
+    }
+
+    void FastoCommonModel::fetchItems(FastoCommonItem* item, size_t count)
+    {
+        const size_t pending = std::min(pendingCount(item), count);
+        if(!pending){
+            return;
+        }
+
+        const FastoObject::child_batch_type& objects = childrens_.constFind(item->object()).value();
+        const size_t first = item->childrenCount();
+        std::vector<FastoCommonItem*> batch;
+        batch.reserve(pending);
+        for(size_t i = first; i < first + pending; ++i){
+            FastoObject* child = objects[i];
+            FastoObjectCommand* command = dynamic_cast<FastoObjectCommand*>(child->parent());
+            FastoCommonItem* comChild = NULL;
+            if(command){
+                comChild = createItem(item, getFirstWordFromLine(command->inputArgs()), command->isReadOnly(), child);
+            }
+            else{
+                comChild = createItem(item, std::string(), true, child);
+            }
+            items_.insert(child, comChild);
+            batch.push_back(comChild);
+        }
+        insertItems(item, batch);
+    }
+
+    void FastoCommonModel::insertItems(fasto::qt::gui::TreeItem* parent, const std::vector<FastoCommonItem*>& items)
+    {
+        if(!parent || items.empty()){
+            return;
+        }
+
+        QModelIndex parentIndex;
+        fasto::qt::gui::TreeItem* grand = parent->parent();
+        if(grand){
+            parentIndex = createIndex(grand->indexOf(parent), 0, parent);
+        }
+
+        const int first = parent->childrenCount();
+        beginInsertRows(parentIndex, first, first + static_cast<int>(items.size()) - 1);
+        for(size_t i = 0; i < items.size(); ++i){
+            parent->addChildren(items[i]);
+        }
+        endInsertRows();
+    }
 }
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <QHash>
+
 #include "fasto/qt/gui/base/tree_model.h"
 
 #include "core/types.h"
 
 namespace fastonosql
 {
+    class FastoCommonItem;
+
+    // Rows of a result tree: the delivered nodes are kept as plain pointers by
+    // parent and items are made only for the rows the views fetch.
     class FastoCommonModel
             : public fasto::qt::gui::TreeModel
     {
@@ -20,11 +26,33 @@ namespace fastonosql
         virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
 
         virtual int columnCount(const QModelIndex& parent) const;
+        virtual bool hasChildren(const QModelIndex& parent = QModelIndex()) const;
+        virtual bool canFetchMore(const QModelIndex& parent) const;
+        virtual void fetchMore(const QModelIndex& parent);
 
         void changeValue(const NDbKValue& value);
 
+        void setRootObject(FastoObject* root);
+        // command replies go under the parent of the command, nested arrays under the array
+        void appendObjects(const FastoObject::child_batch_type& objects);
+        void updateObject(FastoObject* object);
+
     Q_SIGNALS:
         void changedValue(CommandKeySPtr cmd);
+        // shown nodes in the order they came, commands left out
+        void objectsAppended(const FastoObject::child_batch_type& objects);
+        void objectUpdated(FastoObject* object);
+
+    private:
+        FastoCommonItem* itemByIndex(const QModelIndex& index) const;
+        size_t pendingCount(FastoCommonItem* item) const;
+        void fetchItems(FastoCommonItem* item, size_t count);
+        // appends all items to parent with one row insert notification
+        void insertItems(fasto::qt::gui::TreeItem* parent, const std::vector<FastoCommonItem*>& items);
+
+        FastoCommonItem* root_;
+        QHash<FastoObject*, FastoObject::child_batch_type> childrens_;
+        QHash<FastoObject*, FastoCommonItem*> items_;
     };
 }
 
@@ -13,12 +13,16 @@
 #include "common/qt/utils_qt.h"
 
 #include "gui/fasto_common_item.h"
+#include "gui/fasto_common_model.h"
 #include "gui/gui_factory.h"
 #include "gui/fasto_hex_edit.h"
+#include "gui/fasto_lines_view.h"
 #include "fasto/qt/gui/fasto_scintilla.h"
 
 #include "translations/global.h"
 
+#define EDITOR_MAX_LINES 10000
+
 namespace fastonosql
 {
     FastoEditor::FastoEditor(QWidget* parent)
@@ -237,9 +241,12 @@ namespace fastonosql
 
         editor_ = new FastoHexEdit;
         VERIFY(connect(editor_, &FastoHexEdit::textChanged, this, &FastoEditorOutput::textChanged));
+        lines_ = new FastoLinesView(delemitr);
+        lines_->hide();
 
         QVBoxLayout *mainL = new QVBoxLayout;
         mainL->addWidget(editor_);
+        mainL->addWidget(lines_);
         mainL->setContentsMargins(0, 0, 0, 0);
         setLayout(mainL);
     }
@@ -262,6 +269,11 @@ namespace fastonosql
             VERIFY(disconnect(model_, &QAbstractItemModel::columnsInserted, this, &FastoEditorOutput::columnsInserted));
             VERIFY(disconnect(model_, &QAbstractItemModel::modelReset, this, &FastoEditorOutput::reset));
             VERIFY(disconnect(model_, &QAbstractItemModel::layoutChanged, this, &FastoEditorOutput::layoutChanged));
+            FastoCommonModel* common = qobject_cast<FastoCommonModel*>(model_);
+            if(common){
+                VERIFY(disconnect(common, &FastoCommonModel::objectsAppended, this, &FastoEditorOutput::appendObjects));
+                VERIFY(disconnect(common, &FastoCommonModel::objectUpdated, this, &FastoEditorOutput::updateObject));
+            }
         }
 
         model_ = model;
@@ -287,6 +299,12 @@ namespace fastonosql
             VERIFY(connect(model_, &QAbstractItemModel::columnsInserted, this, &FastoEditorOutput::columnsInserted));
             VERIFY(connect(model_, &QAbstractItemModel::modelReset, this, &FastoEditorOutput::reset));
             VERIFY(connect(model_, &QAbstractItemModel::layoutChanged, this, &FastoEditorOutput::layoutChanged));
+            // lines follow the nodes of the result, not the fetched rows
+            FastoCommonModel* common = qobject_cast<FastoCommonModel*>(model_);
+            if(common){
+                VERIFY(connect(common, &FastoCommonModel::objectsAppended, this, &FastoEditorOutput::appendObjects));
+                VERIFY(connect(common, &FastoCommonModel::objectUpdated, this, &FastoEditorOutput::updateObject));
+            }
         }
 
         reset();
@@ -300,7 +318,21 @@ namespace fastonosql
     void FastoEditorOutput::viewChanged(int viewMethod)
     {
         viewMethod_ = viewMethod;
-        layoutChanged();
+        lines_->setViewMethod(viewMethod_);
+        updateText();
+    }
+
+    void FastoEditorOutput::appendObjects(const FastoObject::child_batch_type& objects)
+    {
+        lines_->appendObjects(objects);
+        updateText();
+    }
+
+    void FastoEditorOutput::updateObject(FastoObject* object)
+    {
+        UNUSED(object);
+        lines_->refresh();
+        updateText();
     }
 
     void FastoEditorOutput::modelDestroyed()
@@ -310,7 +342,7 @@ namespace fastonosql
 
     void FastoEditorOutput::dataChanged(QModelIndex first, QModelIndex last)
     {
-        layoutChanged();
+
     }
 
     void FastoEditorOutput::headerDataChanged()
@@ -320,7 +352,7 @@ namespace fastonosql
 
     void FastoEditorOutput::rowsInserted(QModelIndex index, int r, int c)
     {
-        layoutChanged();
+
     }
 
     void FastoEditorOutput::rowsAboutToBeRemoved(QModelIndex index, int r, int c)
@@ -350,7 +382,8 @@ namespace fastonosql
 
     void FastoEditorOutput::reset()
     {
-        layoutChanged();
+        lines_->clear();
+        updateText();
     }
 
     QModelIndex FastoEditorOutput::selectedItem(int column) const
@@ -381,62 +414,63 @@ namespace fastonosql
         return editor_->text();
     }
 
-    void FastoEditorOutput::layoutChanged()
+    bool FastoEditorOutput::isVirtual() const
     {
-        editor_->clear();
-        if(!model_){
-            return;
+        return !lines_->isHidden();
+    }
+
+    bool FastoEditorOutput::find(const QString& text, bool forward, Qt::CaseSensitivity cs)
+    {
+        if(isVirtual()){
+            return lines_->find(text, forward, cs);
         }
 
-        QModelIndex index = model_->index(0, 0);
-        if(!index.isValid()){
-            return;
+        QTextDocument::FindFlags flags = 0;
+        if(!forward){
+            flags |= QTextDocument::FindBackward;
+        }
+        if(cs == Qt::CaseSensitive){
+            flags |= QTextDocument::FindCaseSensitively;
         }
 
-        FastoCommonItem* child = common::utils_qt::item<FastoCommonItem*>(index);
-        if(!child){
-            return;
+        if(editor_->find(text, flags)){
+            return true;
         }
 
-        FastoCommonItem* root = dynamic_cast<FastoCommonItem*>(child->parent());
-        if(!root){
+        // wrap around once
+        QTextCursor cursor = editor_->textCursor();
+        cursor.movePosition(forward ? QTextCursor::Start : QTextCursor::End);
+        editor_->setTextCursor(cursor);
+        return editor_->find(text, flags);
+    }
+
+    void FastoEditorOutput::layoutChanged()
+    {
+        updateText();
+    }
+
+    void FastoEditorOutput::updateText()
+    {
+        // past the limit only the visible lines get formatted, nodes keep coming without a rebuild
+        if(lines_->linesCount() > EDITOR_MAX_LINES){
+            if(!isVirtual()){
+                lines_->show();
+                editor_->hide();
+                editor_->clear();
+            }
             return;
         }
 
-        QString result;
-        for(int i = 0; i < root->childrenCount(); ++i){
-            FastoCommonItem* child = dynamic_cast<FastoCommonItem*>(root->child(i));
-            if(!child){
-                continue;
-            }
+        lines_->hide();
+        editor_->show();
 
-            if(viewMethod_ == JSON){
-                QString json = toJson(child);
-                result += common::escapedText(json);
-            }
-            else if(viewMethod_ == CSV){
-                QString csv = toCsv(child, delemitr_);
-                result += common::escapedText(csv);
-            }
-            else if(viewMethod_ == RAW){
-                QString raw = toRaw(child);
-                result += common::escapedText(raw);
-            }
-            else if(viewMethod_ == HEX){
-                result += toRaw(child);
-            }
-            else if(viewMethod_ == MSGPACK){
-                QString msgp = fromHexMsgPack(child);
-                result += common::escapedText(msgp);
-            }
-            else if(viewMethod_ == GZIP){
-                QString gzip = fromGzip(child);
-                result += common::escapedText(gzip);
-            }
+        QStringList result;
+        for(int i = 0; i < lines_->linesCount(); ++i){
+            result.append(viewMethod_ == HEX ? lines_->lineValue(i) : lines_->line(i));
         }
 
         editor_->setMode(viewMethod_ == HEX ? FastoHexEdit::HEX_MODE : FastoHexEdit::TEXT_MODE );
-        editor_->setData(result.toLocal8Bit());
+        editor_->setData(result.join("\n").toLocal8Bit());
     }
 
     FastoEditorShell::FastoEditorShell(bool showAutoCompl, QWidget* parent)
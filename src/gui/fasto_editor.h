@@ -3,6 +3,8 @@
 #include <QModelIndex>
 #include <QWidget>
 
+#include "global/global.h"
+
 #define JSON 0
 #define CSV 1
 #define RAW 2
@@ -32,6 +34,7 @@ namespace fasto
 namespace fastonosql
 {
     class FastoHexEdit;
+    class FastoLinesView;
 
     class FastoEditor
         : public QWidget
@@ -104,6 +107,9 @@ namespace fastonosql
         bool setData(const QModelIndex& index, const QVariant& value);
         int viewMethod() const;
         QString text() const;
+        // big results are painted line by line and can't be edited
+        bool isVirtual() const;
+        bool find(const QString& text, bool forward, Qt::CaseSensitivity cs);
 
     Q_SIGNALS:
         void textChanged();
@@ -113,6 +119,8 @@ namespace fastonosql
         void viewChanged(int viewMethod);
 
     private Q_SLOTS:
+        void appendObjects(const FastoObject::child_batch_type& objects);
+        void updateObject(FastoObject* object);
         void modelDestroyed();
         void dataChanged(QModelIndex first, QModelIndex last);
         void headerDataChanged();
@@ -126,7 +134,10 @@ namespace fastonosql
         void layoutChanged();
 
     private:
+        void updateText();
+
         FastoHexEdit *editor_;
+        FastoLinesView* lines_;
         QAbstractItemModel* model_;
         int viewMethod_;
         const QString delemitr_;
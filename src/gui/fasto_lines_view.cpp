@@ -0,0 +1,296 @@
+#include "gui/fasto_lines_view.h"
+
+#include <algorithm>
+
+#include <QApplication>
+#include <QClipboard>
+#include <QKeyEvent>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QScrollBar>
+
+#include "common/qt/convert_string.h"
+#include "common/qt/utils_qt.h"
+
+#include "gui/fasto_common_item.h"
+#include "gui/fasto_editor.h"
+
+#define LINES_CACHE_SIZE 1024
+#define TEXT_MARGIN 4
+
+namespace
+{
+    const QColor selectedColor = QColor(0x6d, 0x9e, 0xff, 0xff);
+
+    int objectLines(fastonosql::FastoObject* obj)
+    {
+        if(dynamic_cast<fastonosql::FastoObjectCommand*>(obj)){
+            return 0;
+        }
+
+        fastonosql::FastoObjectArray* array = dynamic_cast<fastonosql::FastoObjectArray*>(obj);
+        if(array){
+            return array->size();
+        }
+
+        // streams are filled before they are shown and never replaced
+        fastonosql::StreamValue* stream = obj->type() == fastonosql::TYPE_STREAM ? dynamic_cast<fastonosql::StreamValue*>(obj->value()) : NULL;
+        if(stream){
+            return stream->size();
+        }
+
+        return 1;
+    }
+}
+
+namespace fastonosql
+{
+    FastoLinesView::FastoLinesView(const QString& delemitr, QWidget* parent)
+        : base_class(parent), delemitr_(delemitr), blocks_(), count_(0),
+          viewMethod_(JSON), current_(-1), maxWidth_(0), cache_()
+    {
+        setFocusPolicy(Qt::StrongFocus);
+    }
+
+    void FastoLinesView::clear()
+    {
+        blocks_.clear();
+        count_ = 0;
+        current_ = -1;
+        maxWidth_ = 0;
+        cache_.clear();
+        verticalScrollBar()->setValue(0);
+        horizontalScrollBar()->setValue(0);
+        updateScrollBars();
+        viewport()->update();
+    }
+
+    void FastoLinesView::appendObjects(const FastoObject::child_batch_type& objects)
+    {
+        for(size_t i = 0; i < objects.size(); ++i){
+            const int count = objectLines(objects[i]);
+            if(count){
+                LinesBlock block = { objects[i], count_ };
+                blocks_.push_back(block);
+                count_ += count;
+            }
+        }
+
+        updateScrollBars();
+        viewport()->update();
+    }
+
+    void FastoLinesView::setViewMethod(int viewMethod)
+    {
+        if(viewMethod == viewMethod_){
+            return;
+        }
+
+        viewMethod_ = viewMethod;
+        maxWidth_ = 0;
+        cache_.clear();
+        viewport()->update();
+    }
+
+    void FastoLinesView::refresh()
+    {
+        count_ = 0;
+        for(size_t i = 0; i < blocks_.size(); ++i){
+            blocks_[i].first_ = count_;
+            count_ += objectLines(blocks_[i].object_);
+        }
+
+        if(current_ >= count_){
+            current_ = -1;
+        }
+
+        cache_.clear();
+        updateScrollBars();
+        viewport()->update();
+    }
+
+    int FastoLinesView::linesCount() const
+    {
+        return count_;
+    }
+
+    QString FastoLinesView::lineValue(int index) const
+    {
+        if(index < 0 || index >= count_){
+            return QString();
+        }
+
+        // blocks emptied by refresh share first_ with the next one, upper_bound skips them
+        std::vector<LinesBlock>::const_iterator it = std::upper_bound(blocks_.begin(), blocks_.end(), index, &FastoLinesView::lineBefore);
+        DCHECK(it != blocks_.begin());
+        --it;
+
+        FastoObject* obj = it->object_;
+        const size_t pos = index - it->first_;
+        FastoObjectArray* array = dynamic_cast<FastoObjectArray*>(obj);
+        if(array){
+            return common::convertFromString<QString>(array->elementToString(pos));
+        }
+
+        StreamValue* stream = obj->type() == TYPE_STREAM ? dynamic_cast<StreamValue*>(obj->value()) : NULL;
+        if(stream){
+            return common::convertFromString<QString>(stream->entryToString(pos, obj->delemitr()));
+        }
+
+        return common::convertFromString<QString>(obj->valueString(" "));
+    }
+
+    QString FastoLinesView::line(int index)
+    {
+        if(index < 0 || index >= count_){
+            return QString();
+        }
+
+        QHash<int, QString>::const_iterator it = cache_.find(index);
+        if(it != cache_.end()){
+            return it.value();
+        }
+
+        if(cache_.size() >= LINES_CACHE_SIZE){
+            cache_.clear();
+        }
+
+        QString text = format(index);
+        cache_.insert(index, text);
+        return text;
+    }
+
+    bool FastoLinesView::find(const QString& text, bool forward, Qt::CaseSensitivity cs)
+    {
+        const int count = count_;
+        if(text.isEmpty() || !count){
+            return false;
+        }
+
+        // lines are formatted one by one until the first hit, they don't go to the cache
+        int index = current_;
+        for(int i = 0; i < count; ++i){
+            index = forward ? index + 1 : index - 1;
+            if(index >= count){
+                index = 0;
+            }
+            else if(index < 0){
+                index = count - 1;
+            }
+
+            if(format(index).contains(text, cs)){
+                current_ = index;
+                if(index < verticalScrollBar()->value() || index >= verticalScrollBar()->value() + pageLines()){
+                    verticalScrollBar()->setValue(index - pageLines() / 2);
+                }
+                viewport()->update();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void FastoLinesView::paintEvent(QPaintEvent* event)
+    {
+        UNUSED(event);
+
+        QPainter painter(viewport());
+        const int lineH = lineHeight();
+        const int first = verticalScrollBar()->value();
+        const int last = std::min(count_, first + pageLines() + 1);
+        const int xPos = TEXT_MARGIN - horizontalScrollBar()->value();
+        const int width = viewport()->width();
+
+        int widest = maxWidth_;
+        for(int i = first, yPos = TEXT_MARGIN; i < last; ++i, yPos += lineH){
+            QString text = line(i);
+            if(i == current_){
+                painter.fillRect(0, yPos, width, lineH, selectedColor);
+            }
+            painter.drawText(QRect(xPos, yPos, width - xPos, lineH), Qt::AlignLeft | Qt::AlignVCenter, text);
+            widest = std::max(widest, fontMetrics().width(text));
+        }
+
+        // the widest line seen so far sizes the horizontal scroll
+        if(widest != maxWidth_){
+            maxWidth_ = widest;
+            updateScrollBars();
+        }
+    }
+
+    void FastoLinesView::resizeEvent(QResizeEvent* event)
+    {
+        base_class::resizeEvent(event);
+        updateScrollBars();
+    }
+
+    void FastoLinesView::mousePressEvent(QMouseEvent* event)
+    {
+        if(event->button() == Qt::LeftButton){
+            int index = verticalScrollBar()->value() + (event->pos().y() - TEXT_MARGIN) / lineHeight();
+            current_ = index < linesCount() ? index : -1;
+            viewport()->update();
+        }
+
+        base_class::mousePressEvent(event);
+    }
+
+    void FastoLinesView::keyPressEvent(QKeyEvent* event)
+    {
+        if(event->matches(QKeySequence::Copy) && current_ != -1){
+            QApplication::clipboard()->setText(line(current_));
+            return;
+        }
+
+        base_class::keyPressEvent(event);
+    }
+
+    bool FastoLinesView::lineBefore(int index, const LinesBlock& block)
+    {
+        return index < block.first_;
+    }
+
+    void FastoLinesView::updateScrollBars()
+    {
+        const int page = pageLines();
+        verticalScrollBar()->setPageStep(page);
+        verticalScrollBar()->setRange(0, std::max(0, count_ - page));
+
+        const int width = viewport()->width() - TEXT_MARGIN * 2;
+        horizontalScrollBar()->setPageStep(width);
+        horizontalScrollBar()->setRange(0, std::max(0, maxWidth_ - width));
+    }
+
+    QString FastoLinesView::format(int index) const
+    {
+        QString text = lineValue(index);
+        if(viewMethod_ == JSON){
+            text = toJson(text);
+        }
+        else if(viewMethod_ == CSV){
+            text = toCsv(text, delemitr_);
+        }
+        else if(viewMethod_ == HEX){
+            text = toHex(text);
+        }
+        else if(viewMethod_ == MSGPACK){
+            text = fromHexMsgPack(text);
+        }
+        else if(viewMethod_ == GZIP){
+            text = fromGzip(text);
+        }
+
+        return common::escapedText(text);
+    }
+
+    int FastoLinesView::lineHeight() const
+    {
+        return fontMetrics().height();
+    }
+
+    int FastoLinesView::pageLines() const
+    {
+        return std::max(1, (viewport()->height() - TEXT_MARGIN * 2) / lineHeight());
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include <QAbstractScrollArea>
+#include <QHash>
+
+#include "global/global.h"
+
+namespace fastonosql
+{
+    // Read only output of huge results: one line per scalar, array element
+    // or stream entry; new nodes only add their lines at the end, only the
+    // lines inside the viewport are formatted and painted.
+    class FastoLinesView
+            : public QAbstractScrollArea
+    {
+        Q_OBJECT
+    public:
+        typedef QAbstractScrollArea base_class;
+        FastoLinesView(const QString& delemitr, QWidget* parent = 0);
+
+        void clear();
+        void appendObjects(const FastoObject::child_batch_type& objects);
+        void setViewMethod(int viewMethod);
+        // values of shown nodes changed, lines are counted and formatted again
+        void refresh();
+
+        int linesCount() const;
+        // value of the line as it is, line() formats it for the view method
+        QString lineValue(int index) const;
+        QString line(int index);
+
+        bool find(const QString& text, bool forward, Qt::CaseSensitivity cs);
+
+    protected:
+        virtual void paintEvent(QPaintEvent* event);
+        virtual void resizeEvent(QResizeEvent* event);
+        virtual void mousePressEvent(QMouseEvent* event);
+        virtual void keyPressEvent(QKeyEvent* event);
+
+    private:
+        struct LinesBlock
+        {
+            FastoObject* object_;
+            int first_;
+        };
+
+        static bool lineBefore(int index, const LinesBlock& block);
+        void updateScrollBars();
+        QString format(int index) const;
+        int lineHeight() const;
+        int pageLines() const;
+
+        const QString delemitr_;
+        std::vector<LinesBlock> blocks_;
+        int count_;
+        int viewMethod_;
+        int current_;
+        int maxWidth_;
+        QHash<int, QString> cache_;
+    };
+}
@@ -14,7 +14,9 @@ namespace fastonosql
         horizontalHeader()->setDefaultAlignment(Qt::AlignLeft);
 
         horizontalHeader()->resizeSections(QHeaderView::Stretch);
-        verticalHeader()->resizeSections(QHeaderView::Stretch);
+        // fixed rows don't measure every row of big results
+        verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+        verticalHeader()->setDefaultSectionSize(fontMetrics().height() + 4);
 
         setSelectionMode(QAbstractItemView::ExtendedSelection);
         setSelectionBehavior(QAbstractItemView::SelectItems);
@@ -35,7 +37,6 @@ namespace fastonosql
     void FastoTableView::resizeEvent(QResizeEvent *event)
     {
         horizontalHeader()->resizeSections(QHeaderView::Stretch);
-        verticalHeader()->resizeSections(QHeaderView::Stretch);
         QTableView::resizeEvent(event);
     }
 }
@@ -4,6 +4,7 @@
 #include <QRadioButton>
 #include <QEvent>
 #include <QPushButton>
+#include <QLineEdit>
 #include <QSplitter>
 #include <QDebug>
 
@@ -34,6 +35,8 @@ namespace fastonosql
         saveChangeButton_->setIcon(GuiFactory::instance().saveIcon());
         saveChangeButton_->setEnabled(false);
 
+        findLine_ = new QLineEdit;
+
         VERIFY(connect(jsonRadioButton_, &QRadioButton::toggled, this, &FastoTextView::viewChanged));
         VERIFY(connect(csvRadioButton_, &QRadioButton::toggled, this, &FastoTextView::viewChanged));
         VERIFY(connect(rawRadioButton_, &QRadioButton::toggled, this, &FastoTextView::viewChanged));
@@ -42,6 +45,7 @@ namespace fastonosql
         VERIFY(connect(gzipRadioButton_, &QRadioButton::toggled, this, &FastoTextView::viewChanged));
         VERIFY(connect(saveChangeButton_, &QPushButton::clicked, this, &FastoTextView::saveChanges));
         VERIFY(connect(editor_, &FastoEditorOutput::textChanged, this, &FastoTextView::textChange));
+        VERIFY(connect(findLine_, &QLineEdit::returnPressed, this, &FastoTextView::findNext));
 
         QHBoxLayout* radLaout = new QHBoxLayout;
         radLaout->addWidget(jsonRadioButton_);
@@ -50,6 +54,7 @@ namespace fastonosql
         radLaout->addWidget(hexRadioButton_);
         radLaout->addWidget(msgPackRadioButton_);
         radLaout->addWidget(gzipRadioButton_);
+        radLaout->addWidget(findLine_);
 
         mainL->addLayout(radLaout);
         mainL->addWidget(editor_);
@@ -83,13 +88,19 @@ namespace fastonosql
     void FastoTextView::textChange()
     {
         QModelIndex index = editor_->selectedItem(1); //eValue
-        bool isEnabled = index.isValid()
+        bool isEnabled = !editor_->isVirtual()
+                && index.isValid()
                 && (index.flags() & Qt::ItemIsEditable)
                 && index.data() != editor_->text().simplified();
 
         saveChangeButton_->setEnabled(isEnabled);
     }
 
+    void FastoTextView::findNext()
+    {
+        editor_->find(findLine_->text(), true, Qt::CaseInsensitive);
+    }
+
     void FastoTextView::viewChanged(bool checked)
     {
         if (!checked){
@@ -146,5 +157,6 @@ namespace fastonosql
         msgPackRadioButton_->setText(trMsgPack);
         gzipRadioButton_->setText(trGzip);
         saveChangeButton_->setText(trSave);
+        findLine_->setPlaceholderText(trSearch);
     }
 }
@@ -4,6 +4,7 @@
 
 class QRadioButton;
 class QPushButton;
+class QLineEdit;
 class QAbstractItemModel;
 
 namespace fastonosql
@@ -23,6 +24,7 @@ namespace fastonosql
         void viewChanged(bool checked);
         void textChange();
         void saveChanges();
+        void findNext();
 
     protected:
         virtual void changeEvent(QEvent *);
@@ -38,5 +40,6 @@ namespace fastonosql
         QRadioButton* msgPackRadioButton_;
         QRadioButton* gzipRadioButton_;
         QPushButton* saveChangeButton_;
+        QLineEdit* findLine_;
     };
 }
@@ -12,6 +12,8 @@ namespace fastonosql
     {
         setSelectionMode(QAbstractItemView::ExtendedSelection);
         setSelectionBehavior(QAbstractItemView::SelectRows);
+        // lets the view lay out only the visible rows of big results
+        setUniformRowHeights(true);
 
         header()->resizeSections(QHeaderView::Stretch);
 
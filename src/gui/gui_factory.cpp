@@ -3,6 +3,8 @@
 #include <QApplication>
 #include <QStyle>
 
+#include "global/global.h"
+
 #include "core/settings_manager.h"
 
 namespace fastonosql
@@ -156,7 +158,7 @@ namespace fastonosql
 
     const QIcon& GuiFactory::modeIcon(ConnectionMode mode) const
     {
-        if(mode == LatencyMode){
+        if(mode == LatencyMode || mode == IntrinsicLatencyMode){
             static QIcon i(":" PROJECT_NAME_LOWERCASE "/images/64x64/latency_mode.png");
             return i;
         }
@@ -213,6 +215,7 @@ namespace fastonosql
             return by;
         case common::Value::TYPE_SET:
         case common::Value::TYPE_ARRAY:
+        case TYPE_STREAM:
             static QIcon a(":" PROJECT_NAME_LOWERCASE "/images/64x64/array.png");
             return a;
         case common::Value::TYPE_HASH:
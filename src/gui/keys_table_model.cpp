@@ -21,7 +21,7 @@ namespace fastonosql
 
     QString KeyTableItem::typeText() const
     {
-        return common::convertFromString<QString>(common::Value::toString(key_.type()));
+        return common::convertFromString<QString>(typeToString(key_.type()));
     }
 
     int32_t KeyTableItem::TTL() const
@@ -30,6 +30,11 @@ namespace fastonosql
         return key.ttl_sec_;
     }
 
+    int64_t KeyTableItem::size() const
+    {
+        return key_.size();
+    }
+
     common::Value::Type KeyTableItem::type() const
     {
         return key_.type();
@@ -85,6 +90,12 @@ namespace fastonosql
             else if (col == KeyTableItem::kType) {
                 result = node->typeText();
             }
+            else if (col == KeyTableItem::kSize) {
+                int64_t size = node->size();
+                if(size >= 0){
+                    result = static_cast<qlonglong>(size);
+                }
+            }
             else if (col == KeyTableItem::kTTL) {
                 result = node->TTL();
             }
@@ -146,6 +157,9 @@ namespace fastonosql
             else if (section == KeyTableItem::kType) {
                 return trType;
             }
+            else if (section == KeyTableItem::kSize) {
+                return trSize;
+            }
             else if (section == KeyTableItem::kTTL) {
                 return trTTL;
             }
@@ -14,8 +14,9 @@ namespace fastonosql
         {
             kKey = 0,
             kType = 1,
-            kTTL = 2,
-            kCountColumns = 3
+            kSize = 2,
+            kTTL = 3,
+            kCountColumns = 4
         };
 
         explicit KeyTableItem(const NDbKValue& key);
@@ -23,6 +24,7 @@ namespace fastonosql
         QString key() const;
         QString typeText() const;
         int32_t TTL() const;
+        int64_t size() const;
         common::Value::Type type() const;
 
         NDbKValue dbv() const;
@@ -40,6 +40,7 @@
 #include "gui/widgets/main_widget.h"
 #include "gui/explorer/explorer_tree_view.h"
 #include "gui/dialogs/encode_decode_dialog.h"
+#include "gui/dialogs/dashboard_dialog.h"
 
 namespace
 {
@@ -190,6 +191,10 @@ namespace fastonosql
         VERIFY(connect(encodeDecodeDialogAction_, &QAction::triggered, this, &MainWindow::openEncodeDecodeDialog));
         tools->addAction(encodeDecodeDialogAction_);
 
+        dashboardDialogAction_ = new QAction(this);
+        VERIFY(connect(dashboardDialogAction_, &QAction::triggered, this, &MainWindow::openDashboardDialog));
+        tools->addAction(dashboardDialogAction_);
+
         //window menu
         QMenu *window = new QMenu(this);
         windowAction_ = menuBar()->addMenu(window);
@@ -346,6 +351,12 @@ namespace fastonosql
         dlg.exec();
     }
 
+    void MainWindow::openDashboardDialog()
+    {
+        DashboardDialog dlg(this);
+        dlg.exec();
+    }
+
     void MainWindow::openRecentConnection()
     {
         QAction *action = qobject_cast<QAction *>(sender());
@@ -646,6 +657,7 @@ namespace fastonosql
         fileAction_->setText(trFile);
         toolsAction_->setText(trTools);
         encodeDecodeDialogAction_->setText(trEncodeDecode);
+        dashboardDialogAction_->setText(trDashboard);
         preferencesAction_->setText(trPreferences);
         checkUpdateAction_->setText(trCheckUpdate);
         editAction_->setText(trEdit);
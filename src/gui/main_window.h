@@ -45,6 +45,7 @@ namespace fastonosql
         void reportBug();
         void enterLeaveFullScreen();
         void openEncodeDecodeDialog();
+        void openDashboardDialog();
         void openRecentConnection();
 
         void loadConnection();
@@ -90,6 +91,7 @@ namespace fastonosql
         QAction* checkUpdateAction_;
         QAction* toolsAction_;
         QAction* encodeDecodeDialogAction_;
+        QAction* dashboardDialogAction_;
         QAction* helpAction_;
         QAction* explorerAction_;
         QAction* logsAction_;
@@ -9,7 +9,6 @@
 #include "gui/fasto_table_view.h"
 #include "gui/fasto_tree_view.h"
 #include "gui/fasto_common_model.h"
-#include "gui/fasto_common_item.h"
 
 #include "gui/gui_factory.h"
 #include "fasto/qt/gui/icon_label.h"
@@ -24,15 +23,6 @@
 
 namespace fastonosql
 {
-    namespace
-    {
-        FastoCommonItem* createItem(fasto::qt::gui::TreeItem* parent, const std::string& key, bool readOnly, fastonosql::FastoObject* item)
-        {
-            NValue val = common::make_value(item->value()->deepCopy());
-            return new FastoCommonItem(common::convertFromString<QString>(key), val, readOnly, parent, item);
-        }
-    }
-
     OutputWidget::OutputWidget(IServerSPtr server, QWidget* parent)
         : QWidget(parent), server_(server)
     {
@@ -85,9 +75,8 @@ namespace fastonosql
 
     void OutputWidget::rootCreate(const EventsInfo::CommandRootCreatedInfo& res)
     {
-        FastoObject* rootObj = res.root_.get();
-        fastonosql::FastoCommonItem* root = createItem(NULL, std::string(), true, rootObj);
-        commonModel_->setRoot(root);
+        commonModel_->setRootObject(res.root_.get());
+        root_ = res.root_;
     }
 
     void OutputWidget::rootCompleate(const EventsInfo::CommandRootCompleatedInfo& res)
@@ -119,93 +108,14 @@ namespace fastonosql
         }
     }
 
-    void OutputWidget::addChild(FastoObject* child)
+    void OutputWidget::addChildren(const FastoObject::child_batch_type& childrens)
     {
-        DCHECK(child->parent());
-
-        FastoObjectCommand* command = dynamic_cast<FastoObjectCommand*>(child);
-        if(command){
-            return;
-        }
-
-        command = dynamic_cast<FastoObjectCommand*>(child->parent());
-        if(command){
-
-            void* parentinner = command->parent();
-
-            QModelIndex parent;
-            bool isFound = commonModel_->findItem(parentinner, parent);
-            if(!isFound){
-                return;
-            }
-
-            fastonosql::FastoCommonItem* par = NULL;
-            if(!parent.isValid()){
-                par = static_cast<fastonosql::FastoCommonItem*>(commonModel_->root());
-            }
-            else{
-                par = common::utils_qt::item<fastonosql::FastoCommonItem*>(parent);
-            }
-
-            DCHECK(par);
-            if(!par){
-                return;
-            }
-
-            std::string inputArgs = command->inputArgs();
-
-            fastonosql::FastoCommonItem* comChild = createItem(par, getFirstWordFromLine(inputArgs), command->isReadOnly(), child);
-            commonModel_->insertItem(parent, comChild);
-        }
-        else{
-            FastoObjectArray* arr = dynamic_cast<FastoObjectArray*>(child->parent());
-            if(arr){
-                QModelIndex parent;
-                bool isFound = commonModel_->findItem(arr, parent);
-                if(!isFound){
-                    return;
-                }
-
-                fastonosql::FastoCommonItem* par = NULL;
-                if(!parent.isValid()){
-                    par = static_cast<fastonosql::FastoCommonItem*>(commonModel_->root());
-                }
-                else{
-                    par = common::utils_qt::item<fastonosql::FastoCommonItem*>(parent);
-                }
-
-                DCHECK(par);
-                if(!par){
-                    return;
-                }
-
-                fastonosql::FastoCommonItem* comChild = createItem(par, std::string(), true, child);
-                commonModel_->insertItem(parent, comChild);
-            }
-            else{
-                NOTREACHED();
-            }
-        }
+        commonModel_->appendObjects(childrens);
     }
 
-    void OutputWidget::itemUpdate(FastoObject* item, common::Value *newValue)
+    void OutputWidget::itemUpdate(FastoObject* item)
     {
-        QModelIndex index;
-        bool isFound = commonModel_->findItem(item, index);
-        if(!isFound){
-            return;
-        }
-
-        fastonosql::FastoCommonItem* it = common::utils_qt::item<fastonosql::FastoCommonItem*>(index);
-        if(!it){
-            return;
-        }
-
-        DCHECK(item->value() == newValue);
-
-        NValue nval = common::make_value(newValue->deepCopy());
-        it->setValue(nval);
-        commonModel_->updateItem(index.parent(), index);
+        commonModel_->updateObject(item);
     }
 
     void OutputWidget::executeCommand(CommandKeySPtr cmd)
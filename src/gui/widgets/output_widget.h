@@ -39,8 +39,8 @@ namespace fastonosql
         void startExecuteCommand(const EventsInfo::CommandRequest& req);
         void finishExecuteCommand(const EventsInfo::CommandResponce& res);
 
-        void addChild(FastoObject* child);
-        void itemUpdate(FastoObject* item, common::Value* newValue);
+        void addChildren(const FastoObject::child_batch_type& childrens);
+        void itemUpdate(FastoObject* item);
 
     private Q_SLOTS:
         void executeCommand(CommandKeySPtr cmd);
@@ -62,5 +62,6 @@ namespace fastonosql
         FastoTableView* tableView_;
         FastoTextView* textView_;
         IServerSPtr server_;
+        FastoObjectIPtr root_;
     };
 }
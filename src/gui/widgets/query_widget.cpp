@@ -18,7 +18,7 @@ namespace fastonosql
         VERIFY(connect(shellWidget_, &BaseShellWidget::rootCreated, outputWidget_, &OutputWidget::rootCreate));
         VERIFY(connect(shellWidget_, &BaseShellWidget::rootCompleated, outputWidget_, &OutputWidget::rootCompleate));
 
-        VERIFY(connect(shellWidget_, &BaseShellWidget::addedChild, outputWidget_, &OutputWidget::addChild));
+        VERIFY(connect(shellWidget_, &BaseShellWidget::childrenAdded, outputWidget_, &OutputWidget::addChildren));
         VERIFY(connect(shellWidget_, &BaseShellWidget::itemUpdated, outputWidget_, &OutputWidget::itemUpdate));
 
         QSplitter* splitter = new QSplitter;
@@ -57,7 +57,7 @@ namespace fastonosql
         VERIFY(connect(server_.get(), &IServer::startedLoadDiscoveryInfo, this, &BaseShellWidget::startLoadDiscoveryInfo));
         VERIFY(connect(server_.get(), &IServer::finishedLoadDiscoveryInfo, this, &BaseShellWidget::finishLoadDiscoveryInfo));
 
-        VERIFY(connect(server_.get(), &IServer::addedChild, this, &BaseShellWidget::addedChild));
+        VERIFY(connect(server_.get(), &IServer::childrenAdded, this, &BaseShellWidget::childrenAdded));
         VERIFY(connect(server_.get(), &IServer::itemUpdated, this, &BaseShellWidget::itemUpdated, Qt::UniqueConnection));
 
         QVBoxLayout* mainlayout = new QVBoxLayout;
@@ -41,8 +41,8 @@ namespace fastonosql
         void rootCreated(const EventsInfo::CommandRootCreatedInfo& res);
         void rootCompleated(const EventsInfo::CommandRootCompleatedInfo& res);
 
-        void addedChild(FastoObject* child);
-        void itemUpdated(FastoObject* item, common::Value* value);
+        void childrenAdded(const FastoObject::child_batch_type& childrens);
+        void itemUpdated(FastoObject* item);
 
     public Q_SLOTS:
         void setText(const QString& text);
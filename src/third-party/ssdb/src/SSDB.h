@@ -10,6 +10,10 @@
 #include <vector>
 #include <map>
 
+#ifdef FASTO
+class Bytes;
+#endif
+
 namespace ssdb{
 
 /**
@@ -59,6 +63,20 @@ private:
 	std::string code_;
 };
 
+#ifdef FASTO
+/**
+ * Consumer of pipelined responses, called in request order.
+ * resp[0] is the response code; all views point into the link input
+ * buffer and are valid only during the call.
+ */
+class PipelineHandler{
+public:
+	virtual ~PipelineHandler(){};
+	/// Return false to ignore the rest of responses, they are still drained.
+	virtual bool handle(size_t index, const std::vector<Bytes> &resp) = 0;
+};
+#endif
+
 /**
  * The SSDB client used to connect to SSDB server.
  */
@@ -240,6 +258,12 @@ public:
 	virtual Status qclear(const std::string &name, int64_t *ret=NULL) = 0;
 #ifdef FASTO
     virtual Status info(const std::string &args, std::vector<std::string> *ret) = 0;
+    /**
+     * Sends requests without waiting for each response, responses are
+     * passed to handler without copying.
+     * Returns error only if the link failed.
+     */
+    virtual Status pipeline(const std::vector<std::vector<std::string> > &reqs, PipelineHandler *handler) = 0;
 #endif
 private:
 	// No copying allowed
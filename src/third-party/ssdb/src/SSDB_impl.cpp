@@ -1,6 +1,9 @@
 #include "SSDB_impl.h"
 #include "util/strings.h"
 #include <signal.h>
+#ifdef FASTO
+#include <algorithm>
+#endif
 
 namespace ssdb{
 
@@ -581,6 +584,36 @@ Status ClientImpl::qclear(const std::string &name, int64_t *ret){
         }
         return s;
     }
+
+    // requests in flight before responses are read back,
+    // keeps both socket buffers from filling up on blocking link
+    #define PIPELINE_WINDOW 256
+
+    Status ClientImpl::pipeline(const std::vector<std::vector<std::string> > &reqs, PipelineHandler *handler)
+    {
+        bool consume = handler != NULL;
+        for(size_t offset = 0; offset < reqs.size(); offset += PIPELINE_WINDOW){
+            size_t end = std::min<size_t>(offset + PIPELINE_WINDOW, reqs.size());
+            for(size_t i = offset; i < end; i++){
+                if(link->send(reqs[i]) == -1){
+                    return Status("error");
+                }
+            }
+            if(link->flush() == -1){
+                return Status("error");
+            }
+            for(size_t i = offset; i < end; i++){
+                const std::vector<Bytes> *packet = link->response();
+                if(packet == NULL || packet->empty()){
+                    return Status("error");
+                }
+                if(consume){
+                    consume = handler->handle(i, *packet);
+                }
+            }
+        }
+        return Status("ok");
+    }
 #endif
 
 }; // namespace ssdb
@@ -99,6 +99,7 @@ public:
 	virtual Status qclear(const std::string &name, int64_t *ret=NULL);
 #ifdef FASTO
     virtual Status info(const std::string &args, std::vector<std::string> *ret);
+    virtual Status pipeline(const std::vector<std::vector<std::string> > &reqs, PipelineHandler *handler);
 #endif
 };
 
@@ -106,6 +106,7 @@ namespace fastonosql
 
         const QString trLoadAndExecuteFile = QObject::tr("Load and execute file");
         const QString trLoadContOfDataBases = QObject::tr("Load content of database");
+        const QString trSearchValues = QObject::tr("Search values");
         const QString trCreateKey = QObject::tr("Create key");
         const QString trViewKeysDialog = QObject::tr("View keys dialog");
         const QString trEncodeDecode = QObject::tr("Encode/Decode");
@@ -114,5 +115,21 @@ namespace fastonosql
         const QString trConnectionDiagnostic = QObject::tr("Connection diagnostic");
         const QString trConnectionDiscovery = QObject::tr("Connection discovery");
         const QString trKeyCountOnThePage = QObject::tr("Key count on the page");
+        const QString trSize = QObject::tr("Size");
+        const QString trLoadNextPage = QObject::tr("Load next page");
+        const QString trLoadFullValue = QObject::tr("Load full value");
+        const QString trDashboard = QObject::tr("Dashboard");
+        const QString trState = QObject::tr("State");
+        const QString trOpsPerSec = QObject::tr("Ops/sec");
+        const QString trMemory = QObject::tr("Memory");
+        const QString trHitRate = QObject::tr("Hit rate");
+        const QString trClients = QObject::tr("Clients");
+        const QString trReplicationLag = QObject::tr("Replication lag");
+        const QString trRefreshInterval = QObject::tr("Refresh interval");
+        const QString trBenchmark = QObject::tr("Benchmark");
+        const QString trMonitor = QObject::tr("Monitor");
+        const QString trPubSub = QObject::tr("Pub/Sub");
+        const QString trSlowLog = QObject::tr("Slow log");
+        const QString trKeyspaceEvents = QObject::tr("Keyspace events");
     }
 }
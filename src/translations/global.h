@@ -106,6 +106,7 @@ namespace fastonosql
 
         extern const QString trLoadAndExecuteFile;
         extern const QString trLoadContOfDataBases;
+        extern const QString trSearchValues;
         extern const QString trCreateKey;
         extern const QString trViewKeysDialog;
         extern const QString trEncodeDecode;
@@ -114,5 +115,21 @@ namespace fastonosql
         extern const QString trConnectionDiagnostic;
         extern const QString trConnectionDiscovery;
         extern const QString trKeyCountOnThePage;
+        extern const QString trSize;
+        extern const QString trLoadNextPage;
+        extern const QString trLoadFullValue;
+        extern const QString trDashboard;
+        extern const QString trState;
+        extern const QString trOpsPerSec;
+        extern const QString trMemory;
+        extern const QString trHitRate;
+        extern const QString trClients;
+        extern const QString trReplicationLag;
+        extern const QString trRefreshInterval;
+        extern const QString trBenchmark;
+        extern const QString trMonitor;
+        extern const QString trPubSub;
+        extern const QString trSlowLog;
+        extern const QString trKeyspaceEvents;
     }
 }
@@ -17,7 +17,124 @@ TEST(FastoObject, LifeTimeScope)
     common::StringValue* obj = common::Value::createStringValue("Sasha");
     {
         FastoObjectIPtr root = FastoObject::createRoot("root");
-        FastoObject* ptr(new FastoObject(root.get(), obj));
+        FastoObject* ptr(new(root.get()) FastoObject(root.get(), obj));
         root->addChildren(ptr);
     }
 }
+
+TEST(StreamValue, Columns)
+{
+    fastonosql::StreamValue stream;
+    stream.appendEntry("1-0", 3);
+    stream.appendField("name", 4, "Sasha", 5);
+    stream.appendField("age", 3, "30", 2);
+    stream.appendEntry("1-1", 3);
+    stream.appendField("name", 4, "Alex", 4);
+
+    ASSERT_EQ(2u, stream.size());
+    ASSERT_EQ("1-1", stream.lastId());
+    ASSERT_EQ(2u, stream.fieldsCount(0));
+    ASSERT_EQ(1u, stream.fieldsCount(1));
+    ASSERT_EQ("age", stream.field(0, 1));
+    ASSERT_EQ("name", stream.field(1, 0));
+    ASSERT_EQ("Alex", stream.value(1, 0));
+    ASSERT_EQ("1-0 name Sasha age 30 1-1 name Alex", stream.toString());
+
+    common::scoped_ptr<fastonosql::StreamValue> copy(stream.deepCopy());
+    ASSERT_TRUE(stream.equals(copy.get()));
+}
+
+TEST(StreamValue, Type)
+{
+    ASSERT_EQ("stream", fastonosql::typeToString(fastonosql::TYPE_STREAM));
+    ASSERT_EQ(common::Value::toString(common::Value::TYPE_HASH), fastonosql::typeToString(common::Value::TYPE_HASH));
+
+    common::scoped_ptr<common::Value> empty(fastonosql::createEmptyValueFromType(fastonosql::TYPE_STREAM));
+    ASSERT_EQ(fastonosql::TYPE_STREAM, empty->type());
+    ASSERT_TRUE(dynamic_cast<fastonosql::StreamValue*>(empty.get()) != NULL);
+}
+
+TEST(FastoObject, ArenaTree)
+{
+    fastonosql::FastoObjectIPtr root = fastonosql::FastoObject::createRoot("root");
+    ASSERT_TRUE(root->arena() != NULL);
+
+    for(int i = 0; i < 10000; ++i){
+        common::StringValue* val = common::Value::createStringValue("value");
+        fastonosql::FastoObject* child = new(root.get()) fastonosql::FastoObject(root.get(), val, "\n");
+        root->addChildren(child);
+    }
+
+    const fastonosql::FastoObject::child_container_type& childrens = root->childrens();
+    ASSERT_EQ(10000u, childrens.size());
+    ASSERT_EQ(root->arena(), childrens[0]->arena());
+    ASSERT_EQ(&childrens[0]->delemitr(), &childrens[9999]->delemitr());
+    ASSERT_EQ("value", childrens[9999]->toString());
+
+    common::StringValue* val = common::Value::createStringValue("heap");
+    fastonosql::FastoObjectIPtr heap(new fastonosql::FastoObject(NULL, val, "\n"));
+    ASSERT_TRUE(heap->arena() != NULL);
+    ASSERT_TRUE(heap->arena() != root->arena());
+    ASSERT_EQ("\n", heap->delemitr());
+}
+
+TEST(FastoObject, InlineValues)
+{
+    fastonosql::FastoObjectIPtr root = fastonosql::FastoObject::createRoot("root");
+
+    fastonosql::FastoObject* str = new(root.get()) fastonosql::FastoObject(root.get(), common::Value::TYPE_STRING, "Sasha", 5, "\n");
+    root->addChildren(str);
+    fastonosql::FastoObject* integer = new(root.get()) fastonosql::FastoObject(root.get(), 1LL << 40, "\n");
+    root->addChildren(integer);
+
+    ASSERT_TRUE(str->value() == NULL);
+    ASSERT_EQ(common::Value::TYPE_STRING, str->type());
+    ASSERT_EQ("Sasha", str->toString());
+    ASSERT_EQ(common::Value::TYPE_INTEGER, integer->type());
+    ASSERT_EQ("1099511627776", integer->toString());
+
+    int small = 0;
+    ASSERT_FALSE(str->getAsInteger(&small));
+
+    // a heap value replaces the inline one and goes with the arena
+    integer->setValue(common::Value::createIntegerValue(7));
+    ASSERT_TRUE(integer->getAsInteger(&small));
+    ASSERT_EQ(7, small);
+}
+
+TEST(FastoObject, ArrayElements)
+{
+    fastonosql::FastoObjectIPtr root = fastonosql::FastoObject::createRoot("root");
+
+    fastonosql::FastoObjectArray* array = new(root.get()) fastonosql::FastoObjectArray(root.get(), " ");
+    array->reserve(3);
+    array->append(common::Value::TYPE_STRING, "a", 1);
+    array->appendInteger(2);
+    for(int i = 0; i < 1000; ++i){
+        array->append(common::Value::TYPE_STRING, "b", 1);
+    }
+    fastonosql::FastoObjectArray* nested = new(array) fastonosql::FastoObjectArray(array, " ");
+    array->addChildren(nested);
+    root->addChildren(array);
+
+    ASSERT_EQ(common::Value::TYPE_ARRAY, array->type());
+    ASSERT_EQ(1002u, array->size());
+    ASSERT_EQ(common::Value::TYPE_INTEGER, array->elementType(1));
+
+    std::string str;
+    ASSERT_TRUE(array->getString(0, &str));
+    ASSERT_EQ("a", str);
+    ASSERT_FALSE(array->getString(1, &str));
+    ASSERT_FALSE(array->getString(1002, &str));
+    ASSERT_EQ("2", array->elementToString(1));
+    ASSERT_EQ("a 2 b", array->valueString(" ").substr(0, 5));
+    ASSERT_EQ(1u, array->childrens().size());
+
+    common::ArrayValue* ar = common::Value::createArrayValue();
+    ar->append(common::Value::createStringValue("x"));
+    ar->append(common::Value::createIntegerValue(3));
+    fastonosql::FastoObjectArray* converted = new(root.get()) fastonosql::FastoObjectArray(root.get(), ar, " ");
+    root->addChildren(converted);
+    ASSERT_EQ(2u, converted->size());
+    ASSERT_EQ("x 3", converted->toString());
+}
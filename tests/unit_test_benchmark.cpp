@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+
+#include "core/benchmark.h"
+
+using namespace fastonosql;
+
+namespace
+{
+    BenchmarkResult makeResult()
+    {
+        BenchmarkResult res;
+        res.server_ = "127.0.0.1:6379";
+        res.type_ = SSDB;
+        res.start_ = 1476000000123;
+        res.elapsed_ = 2500;
+        res.config_.clients_ = 8;
+        res.config_.requests_ = 200000;
+        res.config_.pipeline_ = 16;
+        res.config_.keySpace_ = 50000;
+        res.config_.valueMinSize_ = 10;
+        res.config_.valueMaxSize_ = 100;
+        res.config_.readPercent_ = 80;
+        res.config_.removeKeys_ = false;
+        res.errors_ = 3;
+        res.reads_.count_ = 159997;
+        res.reads_.mean_ = 120.5;
+        res.reads_.p50_ = 100;
+        res.reads_.p99_ = 450.25;
+        res.reads_.p999_ = 900;
+        res.reads_.max_ = 12000;
+        res.writes_.count_ = 40000;
+        res.writes_.mean_ = 140.75;
+        res.writes_.p50_ = 130;
+        res.writes_.p99_ = 500;
+        res.writes_.p999_ = 1100.5;
+        res.writes_.max_ = 15000;
+        return res;
+    }
+
+    void assertLatencyEq(const BenchmarkLatency& expected, const BenchmarkLatency& actual)
+    {
+        ASSERT_EQ(expected.count_, actual.count_);
+        ASSERT_DOUBLE_EQ(expected.mean_, actual.mean_);
+        ASSERT_DOUBLE_EQ(expected.p50_, actual.p50_);
+        ASSERT_DOUBLE_EQ(expected.p99_, actual.p99_);
+        ASSERT_DOUBLE_EQ(expected.p999_, actual.p999_);
+        ASSERT_DOUBLE_EQ(expected.max_, actual.max_);
+    }
+
+    std::string replaceVersion(const std::string& json, const std::string& version)
+    {
+        const std::string label = "\"version\": ";
+        size_t pos = json.find(label);
+        if(pos == std::string::npos){
+            return json;
+        }
+
+        pos += label.size();
+        const size_t end = json.find_first_of(",\n}", pos);
+        return json.substr(0, pos) + version + json.substr(end);
+    }
+}
+
+TEST(BenchmarkResult, roundTrip)
+{
+    const BenchmarkResult res = makeResult();
+    BenchmarkResult loaded;
+    ASSERT_TRUE(BenchmarkResult::fromJson(res.toJson(), &loaded));
+
+    ASSERT_EQ(res.server_, loaded.server_);
+    ASSERT_EQ(res.type_, loaded.type_);
+    ASSERT_EQ(res.start_, loaded.start_);
+    ASSERT_EQ(res.elapsed_, loaded.elapsed_);
+    ASSERT_EQ(res.errors_, loaded.errors_);
+    ASSERT_DOUBLE_EQ(res.throughput(), loaded.throughput());
+
+    ASSERT_EQ(res.config_.clients_, loaded.config_.clients_);
+    ASSERT_EQ(res.config_.requests_, loaded.config_.requests_);
+    ASSERT_EQ(res.config_.pipeline_, loaded.config_.pipeline_);
+    ASSERT_EQ(res.config_.keySpace_, loaded.config_.keySpace_);
+    ASSERT_EQ(res.config_.valueMinSize_, loaded.config_.valueMinSize_);
+    ASSERT_EQ(res.config_.valueMaxSize_, loaded.config_.valueMaxSize_);
+    ASSERT_EQ(res.config_.readPercent_, loaded.config_.readPercent_);
+    ASSERT_EQ(res.config_.removeKeys_, loaded.config_.removeKeys_);
+
+    assertLatencyEq(res.reads_, loaded.reads_);
+    assertLatencyEq(res.writes_, loaded.writes_);
+
+    // a second trip gives the same document
+    ASSERT_EQ(res.toJson(), loaded.toJson());
+}
+
+TEST(BenchmarkResult, version)
+{
+    const std::string json = makeResult().toJson();
+    BenchmarkResult loaded;
+    ASSERT_TRUE(BenchmarkResult::fromJson(replaceVersion(json, "1"), &loaded));
+
+    // other versions and a missing one are rejected
+    ASSERT_FALSE(BenchmarkResult::fromJson(replaceVersion(json, "2"), &loaded));
+    ASSERT_FALSE(BenchmarkResult::fromJson(replaceVersion(json, "0"), &loaded));
+    ASSERT_FALSE(BenchmarkResult::fromJson(replaceVersion(json, "\"1\""), &loaded));
+    ASSERT_FALSE(BenchmarkResult::fromJson("{\"server\": \"127.0.0.1:6379\"}", &loaded));
+}
+
+TEST(BenchmarkResult, malformed)
+{
+    BenchmarkResult loaded;
+    ASSERT_FALSE(BenchmarkResult::fromJson("", &loaded));
+    ASSERT_FALSE(BenchmarkResult::fromJson("[1, 2]", &loaded));
+    ASSERT_FALSE(BenchmarkResult::fromJson("{\"version\": 1", &loaded));
+}
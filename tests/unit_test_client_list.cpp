@@ -0,0 +1,93 @@
+#include "gtest/gtest.h"
+
+#include "core/client_list.h"
+
+using namespace fastonosql;
+
+namespace
+{
+    std::string str(const InfoSlice& slice)
+    {
+        return std::string(slice.data_, slice.size_);
+    }
+}
+
+TEST(ClientList, fields)
+{
+    ClientList list("id=3 addr=127.0.0.1:52555 fd=8 name=worker age=855 idle=2 flags=N db=5 sub=0 psub=0 multi=-1 "
+                    "qbuf=26 qbuf-free=32742 obl=1 oll=2 omem=300 events=r cmd=client\n");
+    ASSERT_EQ(1u, list.clients().size());
+
+    const ClientInfo& client = list.clients()[0];
+    ASSERT_EQ(3u, client.id_);
+    ASSERT_EQ("127.0.0.1:52555", list.fieldString(client.addr_));
+    ASSERT_EQ("127.0.0.1", str(list.host(client)));
+    ASSERT_EQ("worker", list.fieldString(client.name_));
+    ASSERT_EQ(855u, client.age_);
+    ASSERT_EQ(2u, client.idle_);
+    ASSERT_EQ("N", list.fieldString(client.flags_));
+    ASSERT_EQ(5, client.db_);
+    // qbuf-free is a field of its own, not qbuf
+    ASSERT_EQ(26u, client.qbuf_);
+    ASSERT_EQ(1u, client.obl_);
+    ASSERT_EQ(2u, client.oll_);
+    ASSERT_EQ(300u, client.omem_);
+    ASSERT_EQ("client", list.fieldString(client.cmd_));
+}
+
+TEST(ClientList, flags)
+{
+    ClientList list("id=1 addr=10.0.0.1:1 name= flags=SM cmd=replconf\r\n"
+                    "id=2 addr=10.0.0.2:2 name= flags=PxO cmd=subscribe\r\n");
+    ASSERT_EQ(2u, list.clients().size());
+    ASSERT_EQ("SM", list.fieldString(list.clients()[0].flags_));
+    ASSERT_EQ("PxO", list.fieldString(list.clients()[1].flags_));
+    // an empty value is an empty field
+    ASSERT_EQ("", list.fieldString(list.clients()[0].name_));
+}
+
+TEST(ClientList, lines)
+{
+    ClientList list("id=1 addr=10.0.0.1:1 idle=0 cmd=get\n"
+                    "\n"
+                    "id=2 addr=[::1]:6380 idle=70 cmd=set\n"
+                    "id=3 addr=10.0.0.1:3 idle=4000 cmd=get");
+    ASSERT_EQ(3u, list.clients().size());
+    ASSERT_EQ(1u, list.clients()[0].id_);
+    ASSERT_EQ(2u, list.clients()[1].id_);
+    ASSERT_EQ(3u, list.clients()[2].id_);
+    ASSERT_EQ("[::1]", str(list.host(list.clients()[1])));
+    ASSERT_EQ("get", list.fieldString(list.clients()[2].cmd_));
+
+    // fields stay valid in a copy
+    ClientList copy = list;
+    ASSERT_EQ("set", copy.fieldString(copy.clients()[1].cmd_));
+
+    ClientListStats stats(list);
+    const size_t* idle = stats.idleBuckets();
+    ASSERT_EQ(1u, idle[0]);
+    ASSERT_EQ(1u, idle[3]);
+    ASSERT_EQ(1u, idle[5]);
+
+    std::vector<ClientGroup> groups = stats.groups(CLIENTS_BY_COMMAND);
+    ASSERT_EQ(2u, groups.size());
+    ASSERT_EQ("get", groups[0].key_);
+    ASSERT_EQ(2u, groups[0].count_);
+    ASSERT_EQ(4000u, groups[0].maxIdle_);
+}
+
+TEST(ClientList, malformed)
+{
+    // tokens without '=', unknown labels and doubled spaces are skipped
+    ClientList list("garbage id=7  unknown=1 =x addr= db=notanumber cmd=ping \n");
+    ASSERT_EQ(1u, list.clients().size());
+
+    const ClientInfo& client = list.clients()[0];
+    ASSERT_EQ(7u, client.id_);
+    ASSERT_EQ("", list.fieldString(client.addr_));
+    ASSERT_EQ("", str(list.host(client)));
+    ASSERT_EQ("ping", list.fieldString(client.cmd_));
+
+    ASSERT_TRUE(ClientList("").clients().empty());
+    ASSERT_TRUE(ClientList("\r\n\n").clients().empty());
+}
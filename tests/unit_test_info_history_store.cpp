@@ -0,0 +1,235 @@
+#include "gtest/gtest.h"
+
+#include <math.h>
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "core/info_history_store.h"
+
+using namespace fastonosql;
+
+namespace
+{
+    const common::time64_t minute = 60 * 1000;
+    const common::time64_t hour = 60 * minute;
+
+    std::vector< std::vector<Field> > testFields()
+    {
+        std::vector<Field> fields;
+        fields.push_back(Field("counter", common::Value::TYPE_UINTEGER));
+        fields.push_back(Field("gauge", common::Value::TYPE_UINTEGER));
+        fields.push_back(Field("sparse", common::Value::TYPE_UINTEGER));
+        return std::vector< std::vector<Field> >(1, fields);
+    }
+
+    // regular samples with jitter, so deltas of deltas are both signs
+    common::time64_t sampleTime(int i)
+    {
+        return 1000000 + i * 1000 + (i % 3 == 1 ? 7 : 0);
+    }
+
+    std::vector<double> sampleValues(int i)
+    {
+        std::vector<double> values;
+        values.push_back((i * i) % 1000 - 500);
+        values.push_back(i * 0.1 + 1.0 / 3);
+        values.push_back(i % 3 ? i : NAN);
+        return values;
+    }
+
+    void appendSamples(InfoHistoryStore* store, int from, int to)
+    {
+        for(int i = from; i < to; ++i){
+            common::Error er = store->append(sampleTime(i), sampleValues(i));
+            ASSERT_FALSE(er && er->isError());
+        }
+    }
+
+    InfoHistoryStore::points_container_type readField(InfoHistoryStore* store, unsigned char field,
+                                                      InfoHistoryStore::Stat stat = InfoHistoryStore::STAT_AVG,
+                                                      size_t maxPoints = 0, common::time64_t* resolution = NULL)
+    {
+        InfoHistoryStore::points_container_type out;
+        common::time64_t res = -1;
+        common::Error er = store->read(0, field, stat, 0, 0, maxPoints, &out, &res);
+        EXPECT_FALSE(er && er->isError());
+        if(resolution){
+            *resolution = res;
+        }
+        return out;
+    }
+
+    void checkSamples(InfoHistoryStore* store, int count)
+    {
+        for(unsigned char field = 0; field < 3; ++field){
+            InfoHistoryStore::points_container_type points = readField(store, field);
+            size_t pos = 0;
+            for(int i = 0; i < count; ++i){
+                double v = sampleValues(i)[field];
+                if(v != v){
+                    continue;
+                }
+
+                ASSERT_LT(pos, points.size());
+                ASSERT_EQ(sampleTime(i), points[pos].first);
+                ASSERT_EQ(v, points[pos].second);
+                ++pos;
+            }
+            ASSERT_EQ(pos, points.size());
+        }
+    }
+
+    qint64 journalSize(const QTemporaryDir& dir)
+    {
+        return QFile(QDir(dir.path()).filePath("head.jrn")).size();
+    }
+}
+
+TEST(InfoHistoryStore, roundTrip)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const std::string path = dir.path().toStdString();
+
+    // a sealed segment of 3600 samples and a journal of the rest
+    {
+        InfoHistoryStore store(path, testFields(), 0);
+        appendSamples(&store, 0, 3700);
+        checkSamples(&store, 3700);
+    }
+    ASSERT_EQ(1, QDir(dir.path()).entryList(QStringList() << "*.seg", QDir::Files).size());
+
+    InfoHistoryStore store(path, testFields(), 0);
+    checkSamples(&store, 3700);
+
+    common::time64_t first = 0, last = 0;
+    common::Error er = store.bounds(&first, &last);
+    ASSERT_FALSE(er && er->isError());
+    ASSERT_EQ(sampleTime(0), first);
+    ASSERT_EQ(sampleTime(3699), last);
+
+    // columns the store doesn't have read as empty
+    ASSERT_TRUE(readField(&store, 7).empty());
+    // older samples are rejected
+    er = store.append(sampleTime(10), sampleValues(10));
+    ASSERT_TRUE(er && er->isError());
+}
+
+TEST(InfoHistoryStore, summedFields)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    InfoHistoryStore store(dir.path().toStdString(), testFields(), 0);
+    appendSamples(&store, 0, 100);
+
+    std::vector<unsigned char> fields;
+    fields.push_back(0);
+    fields.push_back(2);
+    InfoHistoryStore::points_container_type out;
+    common::time64_t res = -1;
+    common::Error er = store.read(0, fields, InfoHistoryStore::STAT_AVG, 0, 0, 0, &out, &res);
+    ASSERT_FALSE(er && er->isError());
+
+    // samples missing in one of the fields are left out
+    size_t pos = 0;
+    for(int i = 0; i < 100; ++i){
+        std::vector<double> values = sampleValues(i);
+        if(values[2] != values[2]){
+            continue;
+        }
+
+        ASSERT_LT(pos, out.size());
+        ASSERT_EQ(sampleTime(i), out[pos].first);
+        ASSERT_EQ(values[0] + values[2], out[pos].second);
+        ++pos;
+    }
+    ASSERT_EQ(pos, out.size());
+}
+
+TEST(InfoHistoryStore, tornJournalRow)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const std::string path = dir.path().toStdString();
+    {
+        InfoHistoryStore store(path, testFields(), 0);
+        appendSamples(&store, 0, 10);
+    }
+
+    const qint64 size = journalSize(dir);
+    {
+        QFile journal(QDir(dir.path()).filePath("head.jrn"));
+        ASSERT_TRUE(journal.open(QIODevice::WriteOnly | QIODevice::Append));
+        ASSERT_EQ(5, journal.write("\x20\x00\x00\x00\x01", 5));
+    }
+
+    // the torn row is cut off, so the next one follows the intact rows
+    {
+        InfoHistoryStore store(path, testFields(), 0);
+        checkSamples(&store, 10);
+        appendSamples(&store, 10, 11);
+    }
+    ASSERT_LT(size, journalSize(dir));
+
+    InfoHistoryStore store(path, testFields(), 0);
+    checkSamples(&store, 11);
+}
+
+TEST(InfoHistoryStore, truncatedJournal)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const std::string path = dir.path().toStdString();
+    {
+        InfoHistoryStore store(path, testFields(), 0);
+        appendSamples(&store, 0, 10);
+    }
+
+    ASSERT_TRUE(QFile::resize(QDir(dir.path()).filePath("head.jrn"), journalSize(dir) - 3));
+
+    InfoHistoryStore store(path, testFields(), 0);
+    checkSamples(&store, 9);
+    appendSamples(&store, 9, 12);
+    checkSamples(&store, 12);
+}
+
+TEST(InfoHistoryStore, openRollupAfterRestart)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const std::string path = dir.path().toStdString();
+
+    // a sample a minute from 10:30, the raw journal is sealed at 11:30 in
+    // the middle of the 11:00 bucket and the store restarts at 11:45
+    const common::time64_t start = 10 * hour + 30 * minute;
+    {
+        InfoHistoryStore store(path, testFields(), 0);
+        for(int k = 0; k <= 75; ++k){
+            common::Error er = store.append(start + k * minute, std::vector<double>(3, k));
+            ASSERT_FALSE(er && er->isError());
+        }
+    }
+
+    InfoHistoryStore store(path, testFields(), 0);
+    common::Error er = store.append(start + 90 * minute, std::vector<double>(3, 90));
+    ASSERT_FALSE(er && er->isError());
+
+    common::time64_t resolution = 0;
+    InfoHistoryStore::points_container_type avg = readField(&store, 0, InfoHistoryStore::STAT_AVG, 1, &resolution);
+    ASSERT_EQ(hour, resolution);
+    ASSERT_EQ(2u, avg.size());
+    ASSERT_EQ(start, avg[0].first);
+    ASSERT_EQ(14.5, avg[0].second);
+    ASSERT_EQ(start + 30 * minute, avg[1].first);
+    ASSERT_EQ(52.5, avg[1].second);
+
+    InfoHistoryStore::points_container_type min = readField(&store, 1, InfoHistoryStore::STAT_MIN, 1);
+    InfoHistoryStore::points_container_type max = readField(&store, 2, InfoHistoryStore::STAT_MAX, 1);
+    ASSERT_EQ(2u, min.size());
+    ASSERT_EQ(2u, max.size());
+    ASSERT_EQ(30, min[1].second);
+    ASSERT_EQ(75, max[1].second);
+}
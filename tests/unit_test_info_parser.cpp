@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+
+#include <string.h>
+
+#include "core/info_parser.h"
+
+using namespace fastonosql;
+
+namespace
+{
+    InfoSlice slice(const char* str)
+    {
+        return InfoSlice(str, strlen(str));
+    }
+
+    std::string str(const InfoSlice& slice)
+    {
+        std::string res;
+        slice.assignTo(&res);
+        return res;
+    }
+
+    struct TestSection
+    {
+        TestSection()
+            : uptime_(0), version_(), others_(0)
+        {
+
+        }
+
+        void parseField(uint32_t hash, const InfoSlice& field, const InfoSlice& value)
+        {
+            switch(hash){
+            INFO_FIELD_CASE(field, "uptime_in_seconds")
+                uptime_ = infoToUInt64(value);
+                return;
+            INFO_FIELD_CASE(field, "redis_version")
+                value.assignTo(&version_);
+                return;
+            default:
+                break;
+            }
+            ++others_;
+        }
+
+        uint64_t uptime_;
+        std::string version_;
+        int others_;
+    };
+}
+
+TEST(InfoLineReader, lines)
+{
+    const std::string text = "# Server\r\nredis_version:3.0.7\r\n\nuptime:12\nlast";
+    InfoLineReader reader(text.data(), text.size());
+    InfoSlice line;
+    ASSERT_TRUE(reader.next(&line));
+    ASSERT_EQ("# Server", str(line));
+    ASSERT_TRUE(reader.next(&line));
+    ASSERT_EQ("redis_version:3.0.7", str(line));
+    ASSERT_TRUE(reader.next(&line));
+    ASSERT_EQ("", str(line));
+    ASSERT_TRUE(reader.next(&line));
+    ASSERT_EQ("uptime:12", str(line));
+    ASSERT_TRUE(reader.next(&line));
+    ASSERT_EQ("last", str(line));
+    ASSERT_FALSE(reader.next(&line));
+
+    InfoLineReader empty(text.data(), 0);
+    ASSERT_FALSE(empty.next(&line));
+}
+
+TEST(splitInfoLine, fields)
+{
+    InfoSlice field, value;
+    ASSERT_TRUE(splitInfoLine(slice("db0:keys=1,expires=0"), &field, &value));
+    ASSERT_EQ("db0", str(field));
+    ASSERT_EQ("keys=1,expires=0", str(value));
+
+    // the value keeps every ':' after the first one
+    ASSERT_TRUE(splitInfoLine(slice("executable:C:\\redis"), &field, &value));
+    ASSERT_EQ("executable", str(field));
+    ASSERT_EQ("C:\\redis", str(value));
+
+    ASSERT_TRUE(splitInfoLine(slice("empty:"), &field, &value));
+    ASSERT_EQ("", str(value));
+
+    ASSERT_FALSE(splitInfoLine(slice("# Keyspace"), &field, &value));
+    ASSERT_FALSE(splitInfoLine(slice(""), &field, &value));
+    ASSERT_FALSE(splitInfoLine(slice("no delimiter"), &field, &value));
+    ASSERT_TRUE(isInfoHeader(slice("# Stats")));
+    ASSERT_FALSE(isInfoHeader(slice("stats:1")));
+}
+
+TEST(infoNumbers, conversions)
+{
+    ASSERT_EQ(0u, infoToUInt32(slice("")));
+    ASSERT_EQ(42u, infoToUInt32(slice("42")));
+    // digits up to the first other character, as with "1024K"
+    ASSERT_EQ(1024u, infoToUInt32(slice("1024K")));
+    ASSERT_EQ(18446744073709551615ULL, infoToUInt64(slice("18446744073709551615")));
+    ASSERT_EQ(5000000000ULL, infoToUInt64(slice("5000000000")));
+    ASSERT_EQ(-17, infoToInt(slice("-17")));
+    ASSERT_EQ(17, infoToInt(slice("17")));
+    ASSERT_FLOAT_EQ(1.5f, infoToFloat(slice("1.50")));
+    ASSERT_FLOAT_EQ(0.25f, infoToFloat(slice("0.25\r\nnext:1")));
+}
+
+TEST(infoFieldHash, matchesLabels)
+{
+    ASSERT_EQ(infoLabelHash("used_memory"), infoFieldHash(slice("used_memory")));
+    ASSERT_NE(infoLabelHash("used_memory"), infoFieldHash(slice("used_memory_rss")));
+    ASSERT_EQ(2166136261U, infoFieldHash(slice("")));
+}
+
+TEST(parseInfoSection, dispatch)
+{
+    TestSection section;
+    parseInfoSection("# Server\r\nredis_version:3.0.7\r\nuptime_in_seconds:3600\r\nredis_mode:standalone\r\n", &section);
+    ASSERT_EQ("3.0.7", section.version_);
+    ASSERT_EQ(3600u, section.uptime_);
+    ASSERT_EQ(1, section.others_);
+}
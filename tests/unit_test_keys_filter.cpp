@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+
+#include <string.h>
+
+#include "core/keys_filter.h"
+
+using namespace fastonosql;
+
+namespace
+{
+    bool glob(const char* pattern, const char* str)
+    {
+        return globMatch(pattern, strlen(pattern), str, strlen(str));
+    }
+}
+
+TEST(globMatch, wildcards)
+{
+    ASSERT_TRUE(glob("*", ""));
+    ASSERT_TRUE(glob("*", "key"));
+    ASSERT_TRUE(glob("h?llo", "hello"));
+    ASSERT_FALSE(glob("h?llo", "hllo"));
+    ASSERT_TRUE(glob("h*llo", "hllo"));
+    ASSERT_TRUE(glob("h*llo", "heeeello"));
+    ASSERT_FALSE(glob("h*llo", "hellox"));
+    ASSERT_TRUE(glob("a*b*c", "axxbyyc"));
+    ASSERT_FALSE(glob("a*b*c", "axxcyyb"));
+    ASSERT_TRUE(glob("user:**", "user:"));
+}
+
+TEST(globMatch, classes)
+{
+    ASSERT_TRUE(glob("h[ae]llo", "hello"));
+    ASSERT_TRUE(glob("h[ae]llo", "hallo"));
+    ASSERT_FALSE(glob("h[ae]llo", "hillo"));
+    ASSERT_TRUE(glob("h[^e]llo", "hallo"));
+    ASSERT_FALSE(glob("h[^e]llo", "hello"));
+    ASSERT_TRUE(glob("h[a-b]llo", "hbllo"));
+    ASSERT_FALSE(glob("h[a-b]llo", "hcllo"));
+    // reversed ranges are taken as written the other way, like Redis does
+    ASSERT_TRUE(glob("[z-a]", "m"));
+    ASSERT_TRUE(glob("[\\]]", "]"));
+    ASSERT_TRUE(glob("[a-]", "-"));
+}
+
+TEST(globMatch, escapes)
+{
+    ASSERT_TRUE(glob("h\\*llo", "h*llo"));
+    ASSERT_FALSE(glob("h\\*llo", "hello"));
+    ASSERT_TRUE(glob("\\[a]", "[a]"));
+    ASSERT_FALSE(glob("\\[a]", "a"));
+}
+
+TEST(KeysFilter, globPrefix)
+{
+    ASSERT_EQ("user:", KeysFilter("user:*").prefix());
+    ASSERT_EQ("us", KeysFilter("us?r").prefix());
+    ASSERT_EQ("", KeysFilter("[ab]x").prefix());
+    ASSERT_EQ("user*x", KeysFilter("user\\*x*").prefix());
+    ASSERT_EQ("user:*", KeysFilter("user:*").glob());
+    ASSERT_TRUE(KeysFilter("**").isMatchAll());
+    ASSERT_FALSE(KeysFilter("a*").isMatchAll());
+}
+
+TEST(KeysFilter, regexPrefix)
+{
+    ASSERT_EQ("user:", KeysFilter("^user:\\d+", KeysFilter::REGEX).prefix());
+    ASSERT_EQ("user:*", KeysFilter("^user:\\d+", KeysFilter::REGEX).glob());
+    // the last literal before ?, * or {n,m} may be missing
+    ASSERT_EQ("ab", KeysFilter("^abc?", KeysFilter::REGEX).prefix());
+    ASSERT_EQ("a", KeysFilter("^ab*", KeysFilter::REGEX).prefix());
+    ASSERT_EQ("a", KeysFilter("^ab{0,2}", KeysFilter::REGEX).prefix());
+    // only anchored regexes without alternatives have a prefix
+    ASSERT_EQ("", KeysFilter("abc", KeysFilter::REGEX).prefix());
+    ASSERT_EQ("", KeysFilter("^ab|cd", KeysFilter::REGEX).prefix());
+    ASSERT_EQ("*", KeysFilter("abc", KeysFilter::REGEX).glob());
+    ASSERT_TRUE(KeysFilter("^.*$", KeysFilter::REGEX).isMatchAll());
+}
+
+TEST(KeysFilter, prefixEnd)
+{
+    ASSERT_EQ("abd", KeysFilter("abc*").prefixEnd());
+    ASSERT_EQ("ac", KeysFilter("ab\xff*").prefixEnd());
+    ASSERT_EQ("b", KeysFilter("a\xff\xff*").prefixEnd());
+    // nothing follows a prefix of 0xff bytes only
+    ASSERT_EQ("", KeysFilter("\xff\xff*").prefixEnd());
+    ASSERT_EQ("", KeysFilter("*").prefixEnd());
+}
+
+TEST(KeysFilter, match)
+{
+    KeysFilter glob("user:*");
+    ASSERT_TRUE(glob.match("user:1"));
+    ASSERT_FALSE(glob.match("usr:1"));
+
+    KeysFilter regex("^user:\\d+$", KeysFilter::REGEX);
+    ASSERT_TRUE(regex.isValid());
+    ASSERT_TRUE(regex.match("user:12"));
+    ASSERT_FALSE(regex.match("user:ab"));
+    ASSERT_FALSE(KeysFilter("^user:(", KeysFilter::REGEX).isValid());
+
+    std::vector<std::string> keys;
+    keys.push_back("user:1");
+    keys.push_back("order:1");
+    keys.push_back("user:x");
+    regex.filter(&keys);
+    ASSERT_EQ(1u, keys.size());
+    ASSERT_EQ("user:1", keys[0]);
+}
@@ -0,0 +1,143 @@
+#include "gtest/gtest.h"
+
+#include "common/convert2string.h"
+
+#include "core/keyspace_analyzer.h"
+
+using namespace fastonosql;
+
+namespace
+{
+    KeyspaceEvent event(const std::string& type, const std::string& key, int db = 0)
+    {
+        KeyspaceEvent res;
+        res.db_ = db;
+        res.type_ = type;
+        res.key_ = key;
+        return res;
+    }
+}
+
+TEST(KeyspaceAnalyzer, parseKeyspace)
+{
+    KeyspaceEvent ev;
+    ASSERT_TRUE(parseKeyspaceEvent("__keyspace@0__:user:1", "set", &ev));
+    ASSERT_EQ(0, ev.db_);
+    ASSERT_EQ("set", ev.type_);
+    ASSERT_EQ("user:1", ev.key_);
+
+    // keys may hold the delimiter themselves
+    ASSERT_TRUE(parseKeyspaceEvent("__keyspace@12__:a__:b", "expired", &ev));
+    ASSERT_EQ(12, ev.db_);
+    ASSERT_EQ("expired", ev.type_);
+    ASSERT_EQ("a__:b", ev.key_);
+}
+
+TEST(KeyspaceAnalyzer, parseKeyevent)
+{
+    KeyspaceEvent ev;
+    ASSERT_TRUE(parseKeyspaceEvent("__keyevent@3__:del", "session:9", &ev));
+    ASSERT_EQ(3, ev.db_);
+    ASSERT_EQ("del", ev.type_);
+    ASSERT_EQ("session:9", ev.key_);
+
+    ASSERT_TRUE(parseKeyspaceEvent("__keyevent@0__:evicted", "", &ev));
+    ASSERT_EQ("evicted", ev.type_);
+    ASSERT_EQ("", ev.key_);
+}
+
+TEST(KeyspaceAnalyzer, parseOtherChannels)
+{
+    KeyspaceEvent ev;
+    ASSERT_FALSE(parseKeyspaceEvent("news", "set", &ev));
+    ASSERT_FALSE(parseKeyspaceEvent("", "set", &ev));
+    ASSERT_FALSE(parseKeyspaceEvent("__keyspace@", "set", &ev));
+    ASSERT_FALSE(parseKeyspaceEvent("__keyspace@0", "set", &ev));
+    // no database
+    ASSERT_FALSE(parseKeyspaceEvent("__keyspace@__:key", "set", &ev));
+    ASSERT_FALSE(parseKeyspaceEvent("__keysp", "set", &ev));
+    ASSERT_FALSE(parseKeyspaceEvent("__keyother@0__:key", "set", &ev));
+}
+
+TEST(KeyspaceAnalyzer, removals)
+{
+    ASSERT_TRUE(isKeyspaceRemoval("del"));
+    ASSERT_TRUE(isKeyspaceRemoval("expired"));
+    ASSERT_TRUE(isKeyspaceRemoval("evicted"));
+    ASSERT_TRUE(isKeyspaceRemoval("rename_from"));
+    ASSERT_FALSE(isKeyspaceRemoval("rename_to"));
+    ASSERT_FALSE(isKeyspaceRemoval("set"));
+    ASSERT_FALSE(isKeyspaceRemoval("expire"));
+}
+
+TEST(KeyspaceAnalyzer, rates)
+{
+    KeyspaceAnalyzer analyzer;
+    analyzer.add(event("set", "a"));
+    analyzer.add(event("set", "a"));
+    analyzer.add(event("expired", "b"));
+
+    // no rates without a previous snapshot
+    KeyspaceSnapShot shot = analyzer.snapShot(1000, 10);
+    ASSERT_EQ(3u, shot.total_);
+    ASSERT_EQ(0, shot.eventsPerSec_);
+    ASSERT_EQ(2u, shot.events_.size());
+    ASSERT_EQ("set", shot.events_[0].type_);
+    ASSERT_EQ(2u, shot.events_[0].total_);
+    ASSERT_EQ("a", shot.keys_[0].key_);
+    ASSERT_EQ(2u, shot.keys_[0].count_);
+
+    for(int i = 0; i < 4; ++i){
+        analyzer.add(event("expired", "k" + common::convertToString(i)));
+    }
+    analyzer.add(event("evicted", "c"));
+    analyzer.add(event("set", "a"));
+    shot = analyzer.snapShot(3000, 10);
+    ASSERT_EQ(9u, shot.total_);
+    ASSERT_DOUBLE_EQ(3.0, shot.eventsPerSec_);
+    ASSERT_DOUBLE_EQ(2.0, shot.expiredPerSec_);
+    ASSERT_DOUBLE_EQ(0.5, shot.evictedPerSec_);
+    ASSERT_EQ("expired", shot.events_[0].type_);
+    ASSERT_EQ(5u, shot.events_[0].total_);
+    ASSERT_EQ(9u, analyzer.total());
+}
+
+TEST(KeyspaceAnalyzer, removedKeys)
+{
+    KeyspaceAnalyzer analyzer;
+    analyzer.add(event("set", "a"));
+    analyzer.add(event("del", "a", 2));
+    analyzer.add(event("rename_to", "c"));
+    analyzer.add(event("rename_from", "b"));
+
+    KeyspaceSnapShot shot = analyzer.snapShot(1000, 10);
+    ASSERT_EQ(2u, shot.removed_.size());
+    ASSERT_EQ("a", shot.removed_[0].key_);
+    ASSERT_EQ(2, shot.removed_[0].db_);
+    ASSERT_EQ("b", shot.removed_[1].key_);
+
+    // handed over once
+    shot = analyzer.snapShot(2000, 10);
+    ASSERT_TRUE(shot.removed_.empty());
+}
+
+TEST(KeyspaceAnalyzer, removedCap)
+{
+    KeyspaceAnalyzer analyzer;
+    for(int i = 0; i < 1500; ++i){
+        analyzer.add(event("expired", "k" + common::convertToString(i)));
+    }
+
+    // the first ones are kept, all of them are counted
+    KeyspaceSnapShot shot = analyzer.snapShot(1000, 10);
+    ASSERT_EQ(1000u, shot.removed_.size());
+    ASSERT_EQ("k0", shot.removed_[0].key_);
+    ASSERT_EQ("k999", shot.removed_.back().key_);
+    ASSERT_EQ(1500u, shot.total_);
+    ASSERT_EQ(1500u, shot.events_[0].total_);
+
+    // the cap is per snapshot
+    analyzer.add(event("del", "x"));
+    shot = analyzer.snapShot(2000, 10);
+    ASSERT_EQ(1u, shot.removed_.size());
+}
@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+#include "core/info_history_store.h"
+
+using namespace fastonosql;
+
+namespace
+{
+    InfoHistoryStore::points_container_type line(size_t count)
+    {
+        InfoHistoryStore::points_container_type points;
+        for(size_t i = 0; i < count; ++i){
+            points.push_back(std::make_pair(static_cast<common::time64_t>(i * 1000), 1.0));
+        }
+        return points;
+    }
+}
+
+TEST(largestTriangleThreeBuckets, keepsSmallInputs)
+{
+    InfoHistoryStore::points_container_type points = line(10);
+    ASSERT_EQ(points, largestTriangleThreeBuckets(points, 10));
+    ASSERT_EQ(points, largestTriangleThreeBuckets(points, 20));
+    // fewer than three points can't keep both ends and a bucket
+    ASSERT_EQ(points, largestTriangleThreeBuckets(points, 2));
+    ASSERT_TRUE(largestTriangleThreeBuckets(InfoHistoryStore::points_container_type(), 5).empty());
+}
+
+TEST(largestTriangleThreeBuckets, keepsEndsAndOrder)
+{
+    InfoHistoryStore::points_container_type points = line(1000);
+    for(size_t i = 0; i < points.size(); ++i){
+        points[i].second = (i * 37) % 101;
+    }
+
+    InfoHistoryStore::points_container_type result = largestTriangleThreeBuckets(points, 50);
+    ASSERT_EQ(50u, result.size());
+    ASSERT_EQ(points.front(), result.front());
+    ASSERT_EQ(points.back(), result.back());
+    for(size_t i = 1; i < result.size(); ++i){
+        ASSERT_LT(result[i - 1].first, result[i].first);
+    }
+}
+
+TEST(largestTriangleThreeBuckets, keepsSpikes)
+{
+    InfoHistoryStore::points_container_type points = line(100);
+    points[37].second = 100;
+    points[71].second = -100;
+
+    InfoHistoryStore::points_container_type result = largestTriangleThreeBuckets(points, 10);
+    ASSERT_EQ(10u, result.size());
+    ASSERT_NE(result.end(), std::find(result.begin(), result.end(), points[37]));
+    ASSERT_NE(result.end(), std::find(result.begin(), result.end(), points[71]));
+}
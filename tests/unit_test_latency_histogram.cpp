@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+
+#include "core/latency_histogram.h"
+
+using namespace fastonosql;
+
+namespace
+{
+    // highest value of the bucket nsec falls into, min and max around it keep
+    // the percentile from being clamped
+    uint64_t bucketOf(uint64_t nsec)
+    {
+        LatencyHistogram hist;
+        hist.record(0);
+        for(int i = 0; i < 98; ++i){
+            hist.record(nsec);
+        }
+        hist.record(1ULL << 39);
+        return hist.valueAtPercentile(50);
+    }
+}
+
+TEST(LatencyHistogram, exactSmallValues)
+{
+    for(uint64_t v = 0; v < 256; ++v){
+        ASSERT_EQ(v, bucketOf(v));
+    }
+}
+
+TEST(LatencyHistogram, bucketBoundaries)
+{
+    // from 256 on a power of two is cut in 128 buckets
+    ASSERT_EQ(257u, bucketOf(256));
+    ASSERT_EQ(257u, bucketOf(257));
+    ASSERT_EQ(259u, bucketOf(258));
+    ASSERT_EQ(511u, bucketOf(510));
+    ASSERT_EQ(511u, bucketOf(511));
+    ASSERT_EQ(515u, bucketOf(512));
+    ASSERT_EQ(515u, bucketOf(515));
+    ASSERT_EQ(519u, bucketOf(516));
+    ASSERT_EQ(1023u, bucketOf(1023));
+    ASSERT_EQ(1031u, bucketOf(1024));
+    ASSERT_EQ((1ULL << 30) + (1ULL << 23) - 1, bucketOf(1ULL << 30));
+}
+
+TEST(LatencyHistogram, relativeError)
+{
+    for(uint64_t v = 256; v < (1ULL << 38); v = v * 3 / 2 + 1){
+        const uint64_t b = bucketOf(v);
+        ASSERT_GE(b, v);
+        ASSERT_LT(static_cast<double>(b - v) / v, 0.01);
+    }
+}
+
+TEST(LatencyHistogram, percentiles)
+{
+    LatencyHistogram hist;
+    ASSERT_EQ(0u, hist.valueAtPercentile(50));
+    ASSERT_EQ(0, hist.mean());
+
+    for(uint64_t v = 1; v <= 100; ++v){
+        hist.record(v);
+    }
+    ASSERT_EQ(100u, hist.count());
+    ASSERT_EQ(1u, hist.min());
+    ASSERT_EQ(100u, hist.max());
+    ASSERT_EQ(50.5, hist.mean());
+    ASSERT_EQ(1u, hist.valueAtPercentile(0));
+    ASSERT_EQ(50u, hist.valueAtPercentile(50));
+    ASSERT_EQ(99u, hist.valueAtPercentile(99));
+    ASSERT_EQ(100u, hist.valueAtPercentile(100));
+
+    // a bucket's top is clamped to the largest recorded value
+    LatencyHistogram one;
+    one.record(1000);
+    ASSERT_EQ(1000u, one.valueAtPercentile(99.9));
+}
+
+TEST(LatencyHistogram, limitAddAndReset)
+{
+    LatencyHistogram hist;
+    hist.record(1ULL << 45);
+    ASSERT_EQ((1ULL << 40) - 1, hist.max());
+
+    LatencyHistogram other;
+    other.record(5);
+    other.record(7);
+    hist.add(other);
+    hist.add(LatencyHistogram());
+    ASSERT_EQ(3u, hist.count());
+    ASSERT_EQ(5u, hist.min());
+    ASSERT_EQ((1ULL << 40) - 1, hist.max());
+    ASSERT_EQ(5u, hist.valueAtPercentile(10));
+
+    hist.reset();
+    ASSERT_EQ(0u, hist.count());
+    ASSERT_EQ(0u, hist.max());
+    ASSERT_EQ(0u, hist.valueAtPercentile(50));
+}
+
+TEST(LatencyHistogram, historyValues)
+{
+    LatencyHistogram hist;
+    hist.record(2000);
+    hist.record(4000);
+
+    std::vector<double> values = latencyHistoryValues(hist);
+    ASSERT_EQ(latencyHistoryFields()[0].size(), values.size());
+    ASSERT_EQ(2, values[0]);
+    ASSERT_EQ(2, values[1]);
+    ASSERT_EQ(4, values[5]);
+    ASSERT_EQ(3, values[6]);
+}
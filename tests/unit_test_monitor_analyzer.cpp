@@ -0,0 +1,150 @@
+#include "gtest/gtest.h"
+
+#include <string.h>
+
+#include "common/convert2string.h"
+
+#include "core/monitor_analyzer.h"
+
+using namespace fastonosql;
+
+namespace
+{
+    bool parse(const std::string& line, MonitorEntry* entry)
+    {
+        return parseMonitorLine(line.c_str(), line.size(), entry);
+    }
+}
+
+TEST(parseMonitorLine, plain)
+{
+    MonitorEntry entry;
+    const std::string line = "1339518083.107412 [0 127.0.0.1:60866] \"SET\" \"key\" \"value\"";
+    ASSERT_TRUE(parse(line, &entry));
+    ASSERT_DOUBLE_EQ(1339518083.107412, entry.time_);
+    ASSERT_EQ(0, entry.db_);
+    ASSERT_EQ("127.0.0.1:60866", entry.client_);
+    ASSERT_EQ("set", entry.command_);
+    ASSERT_EQ("key", entry.key_);
+    ASSERT_EQ(line, entry.line_);
+}
+
+TEST(parseMonitorLine, quotedArguments)
+{
+    MonitorEntry entry;
+    ASSERT_TRUE(parse("1.5 [3 unix:/tmp/redis.sock] \"get\" \"user:\\\"1\\\" a\\\\b\\n\"", &entry));
+    ASSERT_EQ(3, entry.db_);
+    ASSERT_EQ("unix:/tmp/redis.sock", entry.client_);
+    ASSERT_EQ("user:\"1\" a\\b\n", entry.key_);
+
+    ASSERT_TRUE(parse("1.5 [0 lua] \"hget\" \"a key with spaces\" \"field\"", &entry));
+    ASSERT_EQ("lua", entry.client_);
+    ASSERT_EQ("a key with spaces", entry.key_);
+
+    ASSERT_TRUE(parse("1.5 [0 lua] \"del\" \"\\xff\\x00k\\t\"", &entry));
+    ASSERT_EQ(std::string("\xff\0k\t", 4), entry.key_);
+
+    // the previous entry's arguments don't leak into the next one
+    ASSERT_TRUE(parse("1.5 [0 lua] \"ping\"", &entry));
+    ASSERT_EQ("ping", entry.command_);
+    ASSERT_EQ("", entry.key_);
+}
+
+TEST(parseMonitorLine, keylessAndInvalid)
+{
+    MonitorEntry entry;
+    ASSERT_TRUE(parse("1.5 [0 127.0.0.1:1] \"CONFIG\" \"get\" \"maxmemory\"", &entry));
+    ASSERT_EQ("config", entry.command_);
+    ASSERT_EQ("", entry.key_);
+    ASSERT_TRUE(isKeylessCommand("publish"));
+    ASSERT_FALSE(isKeylessCommand("set"));
+
+    ASSERT_FALSE(parse("OK", &entry));
+    ASSERT_FALSE(parse("1.5 [0 127.0.0.1:1", &entry));
+    ASSERT_FALSE(parse("1.5 [0 127.0.0.1:1]", &entry));
+}
+
+TEST(monitorKeyPrefix, separators)
+{
+    ASSERT_EQ("user:", monitorKeyPrefix("user:1"));
+    ASSERT_EQ("a:b.", monitorKeyPrefix("a:b.c"));
+    ASSERT_EQ("plain", monitorKeyPrefix("plain"));
+}
+
+TEST(TopK, exactUnderCapacity)
+{
+    TopK top(10);
+    for(int i = 0; i < 5; ++i){
+        top.add("a");
+    }
+    top.add("b", 3);
+    top.add("c");
+    ASSERT_EQ(9u, top.total());
+
+    std::vector<TopKItem> items = top.top(2);
+    ASSERT_EQ(2u, items.size());
+    ASSERT_EQ("a", items[0].key_);
+    ASSERT_EQ(5u, items[0].count_);
+    ASSERT_EQ(0u, items[0].error_);
+    ASSERT_EQ("b", items[1].key_);
+    ASSERT_EQ(3u, items[1].count_);
+    ASSERT_EQ(3u, top.top(100).size());
+
+    top.clear();
+    ASSERT_EQ(0u, top.total());
+    ASSERT_TRUE(top.top(10).empty());
+}
+
+TEST(TopK, evictsSmallestCounter)
+{
+    TopK top(2);
+    top.add("a", 5);
+    top.add("b", 3);
+    top.add("c");
+
+    // c takes over b's counter, b's count is its possible overestimate
+    std::vector<TopKItem> items = top.top(2);
+    ASSERT_EQ("a", items[0].key_);
+    ASSERT_EQ("c", items[1].key_);
+    ASSERT_EQ(4u, items[1].count_);
+    ASSERT_EQ(3u, items[1].error_);
+}
+
+TEST(TopK, evictsAfterUpdates)
+{
+    TopK top(3);
+    top.add("a", 5);
+    top.add("b", 3);
+    top.add("c", 4);
+    // b grows past the others, c is the smallest now
+    top.add("b", 10);
+    top.add("d");
+    top.add("a", 2);
+    // d took over c's counter with 5, below a's 7
+    top.add("e");
+
+    std::vector<TopKItem> items = top.top(3);
+    ASSERT_EQ(3u, items.size());
+    ASSERT_EQ("b", items[0].key_);
+    ASSERT_EQ(13u, items[0].count_);
+    ASSERT_EQ("a", items[1].key_);
+    ASSERT_EQ(7u, items[1].count_);
+    ASSERT_EQ("e", items[2].key_);
+    ASSERT_EQ(6u, items[2].count_);
+    ASSERT_EQ(5u, items[2].error_);
+    ASSERT_EQ(26u, top.total());
+}
+
+TEST(TopK, keepsHeavyHitters)
+{
+    TopK top(10);
+    for(int i = 0; i < 1000; ++i){
+        top.add("hot");
+        top.add("cold" + common::convertToString(i));
+    }
+
+    std::vector<TopKItem> items = top.top(1);
+    ASSERT_EQ("hot", items[0].key_);
+    ASSERT_LE(1000u, items[0].count_);
+    ASSERT_LE(items[0].count_ - items[0].error_, 1000u);
+}
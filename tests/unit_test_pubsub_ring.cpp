@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+
+#include "common/convert2string.h"
+
+#include "core/pubsub_ring.h"
+
+using namespace fastonosql;
+
+namespace
+{
+    PubSubMessage message(const std::string& channel, const std::string& payload)
+    {
+        PubSubMessage msg;
+        msg.channel_ = channel;
+        msg.payload_ = payload;
+        return msg;
+    }
+}
+
+TEST(PubSubRing, empty)
+{
+    PubSubRing ring(4);
+    std::vector<PubSubMessage> out;
+    ASSERT_EQ(0u, ring.pop(&out, 10));
+    ASSERT_TRUE(out.empty());
+    ASSERT_EQ(0, ring.dropped());
+
+    ASSERT_TRUE(ring.push(message("a", "1")));
+    ASSERT_EQ(1u, ring.pop(&out, 10));
+    ASSERT_EQ(0u, ring.pop(&out, 10));
+    ASSERT_EQ(1u, out.size());
+}
+
+TEST(PubSubRing, full)
+{
+    PubSubRing ring(3);
+    ASSERT_TRUE(ring.push(message("a", "1")));
+    ASSERT_TRUE(ring.push(message("a", "2")));
+    ASSERT_TRUE(ring.push(message("a", "3")));
+    // the new message is the one dropped
+    ASSERT_FALSE(ring.push(message("a", "4")));
+    ASSERT_FALSE(ring.push(message("a", "5")));
+    ASSERT_EQ(2, ring.dropped());
+
+    std::vector<PubSubMessage> out;
+    ASSERT_EQ(3u, ring.pop(&out, 10));
+    ASSERT_EQ("1", out[0].payload_);
+    ASSERT_EQ("3", out[2].payload_);
+
+    // room again after a pop
+    ASSERT_TRUE(ring.push(message("a", "6")));
+    ASSERT_EQ(2, ring.dropped());
+
+    // a capacity below one still holds a message
+    PubSubRing tiny(0);
+    ASSERT_TRUE(tiny.push(message("b", "1")));
+    ASSERT_FALSE(tiny.push(message("b", "2")));
+}
+
+TEST(PubSubRing, wrapAround)
+{
+    PubSubRing ring(4);
+    std::vector<PubSubMessage> out;
+    int pushed = 0;
+    for(int round = 0; round < 10; ++round){
+        for(int i = 0; i < 3; ++i){
+            ASSERT_TRUE(ring.push(message("c", common::convertToString(pushed++))));
+        }
+
+        // popped in parts, appended to what out has
+        ASSERT_EQ(2u, ring.pop(&out, 2));
+        ASSERT_EQ(1u, ring.pop(&out, 2));
+    }
+
+    ASSERT_EQ(30u, out.size());
+    for(int i = 0; i < 30; ++i){
+        ASSERT_EQ(common::convertToString(i), out[i].payload_);
+    }
+    ASSERT_EQ(0, ring.dropped());
+}
+
+TEST(PubSubChannelStats, rates)
+{
+    PubSubChannelStats stats;
+    stats.add(message("news", "1"));
+    stats.add(message("news", "2"));
+    stats.add(message("chat", "1"));
+
+    // no rate before a previous tick
+    std::vector<PubSubChannelRate> rates = stats.tick(1000);
+    ASSERT_EQ(2u, rates.size());
+    ASSERT_EQ("news", rates[0].channel_);
+    ASSERT_EQ(2u, rates[0].total_);
+    ASSERT_EQ(0, rates[0].perSec_);
+
+    for(int i = 0; i < 4; ++i){
+        stats.add(message("chat", "x"));
+    }
+    stats.add(message("news", "3"));
+    rates = stats.tick(3000);
+    ASSERT_EQ("chat", rates[0].channel_);
+    ASSERT_EQ(5u, rates[0].total_);
+    ASSERT_DOUBLE_EQ(2.0, rates[0].perSec_);
+    ASSERT_DOUBLE_EQ(0.5, rates[1].perSec_);
+
+    stats.clear();
+    ASSERT_TRUE(stats.tick(4000).empty());
+}
@@ -0,0 +1,213 @@
+#include "gtest/gtest.h"
+
+#include <string.h>
+
+#include <hiredis/hiredis.h>
+
+#include "core/redis/redis_latency.h"
+
+using namespace fastonosql;
+
+namespace
+{
+    // reply trees as hiredis builds them, freed with the test
+    class Replies
+    {
+    public:
+        ~Replies()
+        {
+            for(size_t i = 0; i < replies_.size(); ++i){
+                delete [] replies_[i]->str;
+                delete [] replies_[i]->element;
+                delete replies_[i];
+            }
+        }
+
+        redisReply* integer(long long value)
+        {
+            redisReply* r = create(REDIS_REPLY_INTEGER);
+            r->integer = value;
+            return r;
+        }
+
+        redisReply* string(const std::string& str, int type = REDIS_REPLY_STRING)
+        {
+            redisReply* r = create(type);
+            r->len = str.size();
+            r->str = new char[str.size() + 1];
+            memcpy(r->str, str.c_str(), str.size() + 1);
+            return r;
+        }
+
+        redisReply* array(const std::vector<redisReply*>& elements)
+        {
+            redisReply* r = create(REDIS_REPLY_ARRAY);
+            r->elements = elements.size();
+            r->element = new redisReply*[elements.size() + 1];
+            std::copy(elements.begin(), elements.end(), r->element);
+            return r;
+        }
+
+        // arguments are split on spaces
+        redisReply* slowLogItem(long long id, long long time, long long usec, const std::string& line, const char* client = NULL)
+        {
+            std::vector<redisReply*> args;
+            size_t pos = 0;
+            while(pos < line.size()){
+                size_t space = line.find(' ', pos);
+                if(space == std::string::npos){
+                    space = line.size();
+                }
+                args.push_back(string(line.substr(pos, space - pos)));
+                pos = space + 1;
+            }
+
+            std::vector<redisReply*> item;
+            item.push_back(integer(id));
+            item.push_back(integer(time));
+            item.push_back(integer(usec));
+            item.push_back(array(args));
+            if(client){
+                item.push_back(string(client));
+            }
+            return array(item);
+        }
+
+        redisReply* latencyEvent(const std::string& name, long long latest, long long max)
+        {
+            std::vector<redisReply*> ev;
+            ev.push_back(string(name));
+            ev.push_back(integer(1405067976));
+            ev.push_back(integer(latest));
+            ev.push_back(integer(max));
+            return array(ev);
+        }
+
+    private:
+        redisReply* create(int type)
+        {
+            redisReply* r = new redisReply;
+            memset(r, 0, sizeof(*r));
+            r->type = type;
+            replies_.push_back(r);
+            return r;
+        }
+
+        std::vector<redisReply*> replies_;
+    };
+}
+
+TEST(RedisLatency, latencyLatest)
+{
+    Replies replies;
+    std::vector<redisReply*> events;
+    events.push_back(replies.latencyEvent("command", 251, 1002));
+    // malformed events are skipped
+    events.push_back(replies.integer(7));
+    events.push_back(replies.array(std::vector<redisReply*>(1, replies.string("fork"))));
+    events.push_back(replies.latencyEvent("fast-command", 3, 12));
+
+    std::vector<RedisLatencyEvent> res = parseLatencyLatest(replies.array(events));
+    ASSERT_EQ(2u, res.size());
+    ASSERT_EQ("command", res[0].name_);
+    ASSERT_EQ(251, res[0].latest_);
+    ASSERT_EQ(1002, res[0].max_);
+    ASSERT_EQ("fast-command", res[1].name_);
+    ASSERT_EQ(12, res[1].max_);
+
+    ASSERT_TRUE(parseLatencyLatest(replies.string("ERR disabled", REDIS_REPLY_ERROR)).empty());
+    ASSERT_TRUE(parseLatencyLatest(replies.array(std::vector<redisReply*>())).empty());
+}
+
+TEST(RedisLatency, slowLogSummary)
+{
+    Replies replies;
+    std::vector<redisReply*> items;
+    items.push_back(replies.slowLogItem(12, 1500000000, 15000, "GET user:1"));
+    items.push_back(replies.slowLogItem(11, 1500000000, 42000, "KEYS *"));
+    items.push_back(replies.slowLogItem(10, 1500000000, 42000, "SMEMBERS big"));
+
+    RedisSlowLogSummary summary;
+    ASSERT_TRUE(parseSlowLogSummary(replies.array(items), &summary));
+    ASSERT_EQ(3u, summary.entries_);
+    // the first of equally slow entries, the newest one
+    ASSERT_EQ(42000, summary.slowest_);
+    ASSERT_EQ("KEYS", summary.command_);
+
+    ASSERT_TRUE(parseSlowLogSummary(replies.array(std::vector<redisReply*>()), &summary));
+    ASSERT_EQ(0u, summary.entries_);
+    ASSERT_EQ(0, summary.slowest_);
+    ASSERT_EQ("", summary.command_);
+
+    ASSERT_FALSE(parseSlowLogSummary(replies.string("ERR", REDIS_REPLY_ERROR), &summary));
+}
+
+TEST(RedisLatency, slowLogEntries)
+{
+    Replies replies;
+    std::vector<redisReply*> items;
+    items.push_back(replies.slowLogItem(7, 1500000030, 300, "PING", "10.0.0.1:5000"));
+    items.push_back(replies.slowLogItem(6, 1500000020, 200, "HGETALL user:42"));
+    items.push_back(replies.integer(1));
+    items.push_back(replies.slowLogItem(5, 1500000010, 100, "SET a b"));
+    redisReply* reply = replies.array(items);
+
+    // newer than 5, oldest first
+    std::vector<SlowLogEntry> entries;
+    parseSlowLogEntries(reply, 5, &entries);
+    ASSERT_EQ(2u, entries.size());
+    ASSERT_EQ(6, entries[0].id_);
+    ASSERT_EQ(1500000020, entries[0].time_);
+    ASSERT_EQ(200u, entries[0].usec_);
+    ASSERT_EQ("hgetall", entries[0].command_);
+    ASSERT_EQ("user:42", entries[0].key_);
+    ASSERT_EQ("HGETALL user:42", entries[0].args_);
+    ASSERT_EQ("", entries[0].client_);
+    ASSERT_EQ(7, entries[1].id_);
+    ASSERT_EQ("ping", entries[1].command_);
+    ASSERT_EQ("", entries[1].key_);
+    ASSERT_EQ("10.0.0.1:5000", entries[1].client_);
+
+    entries.clear();
+    parseSlowLogEntries(reply, 7, &entries);
+    ASSERT_TRUE(entries.empty());
+
+    // the newest id below the last seen one, the ids started over
+    entries.clear();
+    parseSlowLogEntries(reply, 100, &entries);
+    ASSERT_EQ(3u, entries.size());
+    ASSERT_EQ(5, entries[0].id_);
+    ASSERT_EQ("a", entries[0].key_);
+}
+
+TEST(RedisLatency, slowLogShrunk)
+{
+    ASSERT_TRUE(isSlowLogShrunk(0, 128));
+    ASSERT_TRUE(isSlowLogShrunk(5, 6));
+    ASSERT_FALSE(isSlowLogShrunk(6, 6));
+    ASSERT_FALSE(isSlowLogShrunk(7, 6));
+    // nothing to compare with on the first poll
+    ASSERT_FALSE(isSlowLogShrunk(0, -1));
+}
+
+TEST(RedisLatency, serverUsecPerCall)
+{
+    const redis_command_stats_t before = makeRedisCommandStats("# Commandstats\r\n"
+                                                               "cmdstat_get:calls=10,usec=100,usec_per_call=10.00\r\n"
+                                                               "cmdstat_set:calls=5,usec=500,usec_per_call=100.00\r\n");
+    const redis_command_stats_t after = makeRedisCommandStats("# Commandstats\r\n"
+                                                              "cmdstat_get:calls=20,usec=300,usec_per_call=15.00\r\n"
+                                                              "cmdstat_set:calls=5,usec=500,usec_per_call=100.00\r\n"
+                                                              "cmdstat_ping:calls=10,usec=20,usec_per_call=2.00\r\n");
+    ASSERT_EQ(3u, after.size());
+    ASSERT_EQ(20u, after.find("get")->second.calls_);
+    ASSERT_EQ(300u, after.find("get")->second.usec_);
+
+    ASSERT_DOUBLE_EQ(20.0, serverUsecPerCall(before, after, "get"));
+    // a command first seen in after counts from zero
+    ASSERT_DOUBLE_EQ(2.0, serverUsecPerCall(before, after, "ping"));
+    ASSERT_DOUBLE_EQ(11.0, serverUsecPerCall(before, after, std::string()));
+    ASSERT_EQ(-1, serverUsecPerCall(before, after, "set"));
+    // counters which went back (CONFIG RESETSTAT) are left out
+    ASSERT_EQ(-1, serverUsecPerCall(after, before, "get"));
+}
@@ -0,0 +1,148 @@
+#include "gtest/gtest.h"
+
+#include "core/slowlog_analyzer.h"
+
+using namespace fastonosql;
+
+namespace
+{
+    SlowLogEntry entry(int64_t id, const std::string& command, const std::string& key, uint64_t usec)
+    {
+        SlowLogEntry res;
+        res.id_ = id;
+        res.command_ = command;
+        res.key_ = key;
+        res.usec_ = usec;
+        return res;
+    }
+
+    command_stats_t stats(const std::string& command, uint64_t calls, uint64_t usec)
+    {
+        CommandStat stat;
+        stat.calls_ = calls;
+        stat.usec_ = usec;
+        command_stats_t res;
+        res[command] = stat;
+        return res;
+    }
+}
+
+TEST(SlowLogAnalyzer, keyPattern)
+{
+    ASSERT_EQ("user:*:name", slowLogKeyPattern("user:42:name"));
+    ASSERT_EQ("session:*", slowLogKeyPattern("session:2016"));
+    ASSERT_EQ("*a*b*", slowLogKeyPattern("1a22b333"));
+    ASSERT_EQ("plain", slowLogKeyPattern("plain"));
+    ASSERT_EQ("", slowLogKeyPattern(""));
+}
+
+TEST(SlowLogAnalyzer, lastId)
+{
+    SlowLogAnalyzer analyzer;
+    ASSERT_EQ(-1, analyzer.lastId());
+
+    std::vector<SlowLogEntry> entries;
+    entries.push_back(entry(10, "get", "a", 100));
+    entries.push_back(entry(11, "get", "b", 200));
+    analyzer.addEntries(entries);
+    ASSERT_EQ(11, analyzer.lastId());
+    ASSERT_EQ(2u, analyzer.entries().size());
+
+    // nothing new keeps the last id
+    analyzer.addEntries(std::vector<SlowLogEntry>());
+    ASSERT_EQ(11, analyzer.lastId());
+
+    // a reset log starts its ids over
+    analyzer.addEntries(std::vector<SlowLogEntry>(1, entry(0, "set", "c", 300)));
+    ASSERT_EQ(0, analyzer.lastId());
+    ASSERT_EQ(3u, analyzer.entries().size());
+
+    analyzer.clear();
+    ASSERT_EQ(-1, analyzer.lastId());
+    ASSERT_TRUE(analyzer.entries().empty());
+}
+
+TEST(SlowLogAnalyzer, storeBound)
+{
+    SlowLogAnalyzer analyzer;
+    std::vector<SlowLogEntry> entries;
+    for(int i = 0; i < 10050; ++i){
+        entries.push_back(entry(i, "get", "k", 10));
+    }
+    analyzer.addEntries(entries);
+
+    // the oldest ones go
+    ASSERT_EQ(10000u, analyzer.entries().size());
+    ASSERT_EQ(50, analyzer.entries().front().id_);
+    ASSERT_EQ(10049, analyzer.entries().back().id_);
+}
+
+TEST(SlowLogAnalyzer, groups)
+{
+    SlowLogAnalyzer analyzer;
+    std::vector<SlowLogEntry> entries;
+    for(int i = 1; i <= 100; ++i){
+        entries.push_back(entry(i, "hgetall", "user:" + std::string(1, '0' + i % 10), i * 10));
+    }
+    entries.push_back(entry(101, "keys", "", 50000));
+    entries.push_back(entry(102, "get", "user:1", 10));
+    analyzer.addEntries(entries);
+
+    analyzer.addCommandStats(1000, stats("hgetall", 100, 1000));
+    analyzer.addCommandStats(3000, stats("hgetall", 300, 5000));
+
+    std::vector<SlowLogGroup> groups = analyzer.groups();
+    ASSERT_EQ(3u, groups.size());
+    // the most total time first
+    ASSERT_EQ("hgetall", groups[0].command_);
+    ASSERT_EQ("user:*", groups[0].pattern_);
+    ASSERT_EQ(100u, groups[0].count_);
+    ASSERT_EQ(50500u, groups[0].totalUsec_);
+    ASSERT_EQ(1000u, groups[0].maxUsec_);
+    ASSERT_EQ(500u, groups[0].p50Usec_);
+    ASSERT_EQ(990u, groups[0].p99Usec_);
+    ASSERT_DOUBLE_EQ(100.0, groups[0].callsPerSec_);
+    ASSERT_DOUBLE_EQ(20.0, groups[0].usecPerCall_);
+
+    ASSERT_EQ("keys", groups[1].command_);
+    ASSERT_EQ("", groups[1].pattern_);
+    ASSERT_EQ(50000u, groups[1].p50Usec_);
+    // no stats for the command
+    ASSERT_EQ(-1, groups[1].callsPerSec_);
+
+    ASSERT_EQ("get", groups[2].command_);
+}
+
+TEST(SlowLogAnalyzer, trends)
+{
+    SlowLogAnalyzer analyzer;
+    ASSERT_TRUE(analyzer.trends().empty());
+
+    command_stats_t first = stats("get", 1000, 2000);
+    first["set"] = stats("set", 100, 1000)["set"];
+    analyzer.addCommandStats(0, first);
+    ASSERT_TRUE(analyzer.trends().empty());
+
+    command_stats_t second = stats("get", 2000, 4000);
+    second["set"] = stats("set", 300, 3000)["set"];
+    analyzer.addCommandStats(1000, second);
+
+    command_stats_t third = stats("get", 5000, 16000);
+    third["set"] = stats("set", 400, 4000)["set"];
+    analyzer.addCommandStats(2000, third);
+
+    std::vector<CommandTrend> trends = analyzer.trends();
+    ASSERT_EQ(2u, trends.size());
+    // the busiest first, rates of the last interval
+    ASSERT_EQ("get", trends[0].command_);
+    ASSERT_DOUBLE_EQ(3000.0, trends[0].callsPerSec_);
+    ASSERT_DOUBLE_EQ(4.0, trends[0].usecPerCall_);
+    // the window is all the kept samples
+    ASSERT_DOUBLE_EQ(14000.0 / 4000, trends[0].windowUsecPerCall_);
+    ASSERT_EQ("set", trends[1].command_);
+    ASSERT_DOUBLE_EQ(100.0, trends[1].callsPerSec_);
+
+    // counters going back (CONFIG RESETSTAT) leave the command out
+    analyzer.addCommandStats(3000, stats("get", 10, 10));
+    ASSERT_TRUE(analyzer.trends().empty());
+}
@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+
+#include <string.h>
+
+#include "core/value_matcher.h"
+
+using namespace fastonosql;
+
+namespace
+{
+    std::string literal(const std::string& pattern)
+    {
+        return ValueMatcher(pattern, ValueMatcher::REGEX).literal();
+    }
+}
+
+TEST(ValueMatcher, substringLiteral)
+{
+    ValueMatcher matcher("needle");
+    ASSERT_EQ("needle", matcher.literal());
+    ASSERT_TRUE(matcher.match("hay needle hay"));
+    ASSERT_FALSE(matcher.match("hay needl hay"));
+}
+
+TEST(ValueMatcher, regexLiteral)
+{
+    ASSERT_EQ("user:", literal("user:\\d+"));
+    ASSERT_EQ(":session", literal("id\\d+:session"));
+    ASSERT_EQ("ab.cd", literal("ab\\.cd"));
+    // the last character before a quantifier is optional
+    ASSERT_EQ("colo", literal("colou?r"));
+    ASSERT_EQ("a", literal("ab{2}c"));
+    // groups and alternatives aren't required
+    ASSERT_EQ("x", literal("x(abc)y"));
+    ASSERT_EQ("", literal("abc|def"));
+    ASSERT_EQ("", literal("(?i)abc"));
+    ASSERT_EQ("", literal("\\Qa.b\\E"));
+}
+
+TEST(ValueMatcher, regexLiteralEscapeOperands)
+{
+    ASSERT_EQ("bc", literal("\\x41bc"));
+    ASSERT_EQ("zz", literal("\\x{41}zz"));
+    ASSERT_EQ("xy", literal("\\101xy"));
+    ASSERT_EQ("7ab", literal("\\0127ab"));
+    ASSERT_EQ("cfg", literal("\\xabcfg"));
+    ASSERT_EQ("", literal("(a)\\1"));
+    ASSERT_EQ("abc", literal("\\p{Lu}abc"));
+    ASSERT_EQ("bc", literal("\\pLbc"));
+    ASSERT_EQ("ab", literal("\\cAab"));
+    ASSERT_EQ("ab", literal("(a)\\g{-1}ab"));
+
+    ValueMatcher matcher("\\x41BC", ValueMatcher::REGEX);
+    ASSERT_TRUE(matcher.isValid());
+    ASSERT_TRUE(matcher.match("ABC"));
+    ASSERT_FALSE(matcher.match("41BC"));
+}
+
+TEST(findLiteral, search)
+{
+    const char data[] = "hello world";
+    const size_t size = sizeof(data) - 1;
+    ASSERT_EQ(data + 6, findLiteral(data, size, "world", 5));
+    ASSERT_EQ(data, findLiteral(data, size, "", 0));
+    ASSERT_TRUE(findLiteral(data, size, "word", 4) == NULL);
+    ASSERT_TRUE(findLiteral(data, 3, "hello", 5) == NULL);
+
+    const char repeated[] = "aaab";
+    ASSERT_EQ(repeated + 2, findLiteral(repeated, 4, "ab", 2));
+    ASSERT_TRUE(findLiteral(repeated, 3, "ab", 2) == NULL);
+}